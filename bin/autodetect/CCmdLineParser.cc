@@ -49,7 +49,11 @@ bool CCmdLineParser::parse(int argc,
                            std::string& persistFileName,
                            bool& isPersistFileNamedPipe,
                            bool& isPersistInForeground,
+                           bool& isPersistBinaryState,
                            std::size_t& maxAnomalyRecords,
+                           std::size_t& numberResultsThreads,
+                           std::size_t& numberForecastThreads,
+                           std::size_t& numberCategorizationThreads,
                            bool& memoryUsage,
                            bool& validElasticLicenseKeyConfirmed) {
     try {
@@ -95,10 +99,17 @@ bool CCmdLineParser::parse(int argc,
                     "Optional file to persist state to - not present means no state persistence")
             ("persistIsPipe", "Specified persist file is a named pipe")
             ("persistInForeground", "Persistence occurs in the foreground. Defaults to background persistence.")
+            ("persistBinaryState", "Persist model state in a compact binary format. Defaults to JSON. State in either format can be restored.")
             ("bucketPersistInterval", boost::program_options::value<std::size_t>(),
                     "Optional number of buckets after which to periodically persist model state.")
             ("maxAnomalyRecords", boost::program_options::value<std::size_t>(),
                     "The maximum number of records to be outputted for each bucket. Defaults to 100, a value 0 removes the limit.")
+            ("numberResultsThreads", boost::program_options::value<std::size_t>(),
+                    "Optional number of threads to use to compute the results of the detectors at the end of each bucket. Defaults to 1.")
+            ("numberForecastThreads", boost::program_options::value<std::size_t>(),
+                    "Optional number of threads to use to forecast the models of each forecast request. Defaults to 1.")
+            ("numberCategorizationThreads", boost::program_options::value<std::size_t>(),
+                    "Optional number of threads to use to categorize the records of different partitions when using per-partition categorization. Defaults to 1.")
             ("memoryUsage",
                     "Log the model memory usage at the end of the job")
             ("validElasticLicenseKeyConfirmed", boost::program_options::value<bool>(),
@@ -191,9 +202,21 @@ bool CCmdLineParser::parse(int argc,
         if (vm.count("persistInForeground") > 0) {
             isPersistInForeground = true;
         }
+        if (vm.count("persistBinaryState") > 0) {
+            isPersistBinaryState = true;
+        }
         if (vm.count("maxAnomalyRecords") > 0) {
             maxAnomalyRecords = vm["maxAnomalyRecords"].as<std::size_t>();
         }
+        if (vm.count("numberResultsThreads") > 0) {
+            numberResultsThreads = vm["numberResultsThreads"].as<std::size_t>();
+        }
+        if (vm.count("numberForecastThreads") > 0) {
+            numberForecastThreads = vm["numberForecastThreads"].as<std::size_t>();
+        }
+        if (vm.count("numberCategorizationThreads") > 0) {
+            numberCategorizationThreads = vm["numberCategorizationThreads"].as<std::size_t>();
+        }
         if (vm.count("memoryUsage") > 0) {
             memoryUsage = true;
         }
@@ -61,7 +61,11 @@ public:
                       std::string& persistFileName,
                       bool& isPersistFileNamedPipe,
                       bool& isPersistInForeground,
+                      bool& isPersistBinaryState,
                       std::size_t& maxAnomalyRecords,
+                      std::size_t& numberResultsThreads,
+                      std::size_t& numberForecastThreads,
+                      std::size_t& numberCategorizationThreads,
                       bool& memoryUsage,
                       bool& validElasticLicenseKeyConfirmed);
 
@@ -25,7 +25,9 @@
 #include <core/CLogger.h>
 #include <core/CProcessPriority.h>
 #include <core/CProgramCounters.h>
+#include <core/CStopWatch.h>
 #include <core/CStringUtils.h>
+#include <core/Concurrency.h>
 #include <core/CoreTypes.h>
 
 #include <ver/CBuildInfo.h>
@@ -52,6 +54,7 @@
 
 #include "CCmdLineParser.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
@@ -83,7 +86,10 @@ int main(int argc, char** argv) {
         ml::counter_t::E_TSADNumberMemoryLimitModelCreationFailures,
         ml::counter_t::E_TSADNumberPrunedItems,
         ml::counter_t::E_TSADAssignmentMemoryBasis,
-        ml::counter_t::E_TSADOutputMemoryAllocatorUsage};
+        ml::counter_t::E_TSADOutputMemoryAllocatorUsage,
+        ml::counter_t::E_TSADNumberSeasonalityTests,
+        ml::counter_t::E_TSADNumberCalendarTests,
+        ml::counter_t::E_TSADNumberChangePointTests};
 
     ml::core::CProgramCounters::registerProgramCounterTypes(counters);
 
@@ -113,7 +119,11 @@ int main(int argc, char** argv) {
     std::string persistFileName;
     bool isPersistFileNamedPipe{false};
     bool isPersistInForeground{false};
+    bool isPersistBinaryState{false};
     std::size_t maxAnomalyRecords{100};
+    std::size_t numberResultsThreads{1};
+    std::size_t numberForecastThreads{1};
+    std::size_t numberCategorizationThreads{1};
     bool memoryUsage{false};
     bool validElasticLicenseKeyConfirmed{false};
     if (ml::autodetect::CCmdLineParser::parse(
@@ -123,7 +133,9 @@ int main(int argc, char** argv) {
             namedPipeConnectTimeout, inputFileName, isInputFileNamedPipe, outputFileName,
             isOutputFileNamedPipe, restoreFileName, isRestoreFileNamedPipe,
             persistFileName, isPersistFileNamedPipe, isPersistInForeground,
-            maxAnomalyRecords, memoryUsage, validElasticLicenseKeyConfirmed) == false) {
+            isPersistBinaryState, maxAnomalyRecords, numberResultsThreads,
+            numberForecastThreads, numberCategorizationThreads, memoryUsage,
+            validElasticLicenseKeyConfirmed) == false) {
         return EXIT_FAILURE;
     }
 
@@ -176,6 +188,8 @@ int main(int argc, char** argv) {
     // hence is done before reducing CPU priority.
     ml::core::CProcessPriority::reduceCpuPriority();
 
+    ml::core::CStopWatch startupWatch{true};
+
     ml::api::CAnomalyJobConfig jobConfig;
     if (jobConfig.initFromFiles(configFile, filtersConfigFile, eventsConfigFile) == false) {
         LOG_FATAL(<< "JSON config could not be interpreted");
@@ -209,6 +223,7 @@ int main(int argc, char** argv) {
     modelConfig.configureModelPlot(modelPlotConfig.enabled(),
                                    modelPlotConfig.annotationsEnabled(),
                                    modelPlotConfig.terms());
+    modelConfig.modelPlotBoundsCadence(modelPlotConfig.boundsCadence());
 
     using TDataSearcherUPtr = std::unique_ptr<ml::core::CDataSearcher>;
     const TDataSearcherUPtr restoreSearcher{[isRestoreFileNamedPipe, &ioMgr]() -> TDataSearcherUPtr {
@@ -283,6 +298,21 @@ int main(int argc, char** argv) {
                              timeFormat,
                              maxAnomalyRecords};
 
+    std::size_t numberThreads{
+        std::max({numberResultsThreads, numberForecastThreads, numberCategorizationThreads})};
+    if (numberThreads > 1) {
+        ml::core::startDefaultAsyncExecutor(numberThreads);
+    }
+    if (numberResultsThreads > 1) {
+        job.computeDetectorResultsConcurrently(true);
+    }
+    if (numberForecastThreads > 1) {
+        job.numberForecastThreads(numberForecastThreads);
+    }
+    if (isPersistBinaryState) {
+        job.persistBinaryState(true);
+    }
+
     if (!quantilesStateFile.empty()) {
         if (job.initNormalizer(quantilesStateFile) == false) {
             LOG_FATAL(<< "Failed to restore quantiles and initialize normalizer");
@@ -304,6 +334,12 @@ int main(int argc, char** argv) {
         wrappedOutputStream,
         persistenceManager.get(),
         analysisConfig.perPartitionCategorizationStopOnWarn()};
+    if (numberCategorizationThreads > 1) {
+        categorizer.concurrentCategorizationBatchSize(
+            ml::api::CFieldDataCategorizer::DEFAULT_CONCURRENT_CATEGORIZATION_BATCH_SIZE);
+    }
+
+    LOG_DEBUG(<< "Configured job in " << startupWatch.stop() << "ms");
 
     ml::api::CDataProcessor* firstProcessor{nullptr};
     if (doingCategorization) {
@@ -38,6 +38,7 @@ bool CCmdLineParser::parse(int argc,
                            bool& isRestoreFileNamedPipe,
                            std::string& persistFileName,
                            bool& isPersistFileNamedPipe,
+                           bool& workStealing,
                            bool& validElasticLicenseKeyConfirmed) {
     try {
         boost::program_options::options_description desc(DESCRIPTION);
@@ -68,6 +69,7 @@ bool CCmdLineParser::parse(int argc,
             ("persist", boost::program_options::value<std::string>(),
                     "File to persist state to - not present means no state persistence")
             ("persistIsPipe", "Specified persist file is a named pipe")
+            ("workStealing", "Load balance work between threads by work stealing - default is round-robin")
             ("validElasticLicenseKeyConfirmed", boost::program_options::value<bool>(),
              "Confirmation that a valid Elastic license key is in use.")
         ;
@@ -128,6 +130,9 @@ bool CCmdLineParser::parse(int argc,
         if (vm.count("persistIsPipe") > 0) {
             isPersistFileNamedPipe = true;
         }
+        if (vm.count("workStealing") > 0) {
+            workStealing = true;
+        }
         if (vm.count("validElasticLicenseKeyConfirmed") > 0) {
             validElasticLicenseKeyConfirmed =
                 vm["validElasticLicenseKeyConfirmed"].as<bool>();
@@ -47,6 +47,7 @@ public:
                       bool& isRestoreFileNamedPipe,
                       std::string& persistFileName,
                       bool& isPersistFileNamedPipe,
+                      bool& workStealing,
                       bool& validElasticLicenseKeyConfirmed);
 
 private:
@@ -89,7 +89,9 @@ int main(int argc, char** argv) {
         ml::counter_t::E_DFTPMEstimatedPeakMemoryUsage,
         ml::counter_t::E_DFTPMPeakMemoryUsage,
         ml::counter_t::E_DFTPMTimeToTrain,
-        ml::counter_t::E_DFTPMTrainedForestNumberTrees};
+        ml::counter_t::E_DFTPMTrainedForestNumberTrees,
+        ml::counter_t::E_TPNumberTasksStolen,
+        ml::counter_t::E_TPNumberIdleWaits};
     ml::core::CProgramCounters::registerProgramCounterTypes(counters);
 
     // Read command line options
@@ -108,13 +110,14 @@ int main(int argc, char** argv) {
     bool isRestoreFileNamedPipe{false};
     std::string persistFileName;
     bool isPersistFileNamedPipe{false};
+    bool workStealing{false};
     bool validElasticLicenseKeyConfirmed{false};
     if (ml::data_frame_analyzer::CCmdLineParser::parse(
             argc, argv, configFile, memoryUsageEstimationOnly, logProperties,
             logPipe, lengthEncodedInput, namedPipeConnectTimeout, inputFileName,
             isInputFileNamedPipe, outputFileName, isOutputFileNamedPipe,
             restoreFileName, isRestoreFileNamedPipe, persistFileName,
-            isPersistFileNamedPipe, validElasticLicenseKeyConfirmed) == false) {
+            isPersistFileNamedPipe, workStealing, validElasticLicenseKeyConfirmed) == false) {
         return EXIT_FAILURE;
     }
 
@@ -229,7 +232,10 @@ int main(int argc, char** argv) {
     CCleanUpOnExit::add(frameAndDirectory.second);
 
     if (analysisSpecification->numberThreads() > 1) {
-        ml::core::startDefaultAsyncExecutor(analysisSpecification->numberThreads());
+        ml::core::startDefaultAsyncExecutor(
+            analysisSpecification->numberThreads(), 50, 0,
+            workStealing ? ml::core::CExecutor::E_WorkStealing
+                         : ml::core::CExecutor::E_RoundRobin);
     }
 
     ml::api::CDataFrameAnalyzer dataFrameAnalyzer{std::move(analysisSpecification),
@@ -238,7 +244,11 @@ int main(int argc, char** argv) {
 
     auto inputParser{[lengthEncodedInput, &ioMgr]() -> TInputParserUPtr {
         if (lengthEncodedInput) {
-            return std::make_unique<ml::api::CLengthEncodedInputParser>(ioMgr.inputStream());
+            auto parser = std::make_unique<ml::api::CLengthEncodedInputParser>(
+                ioMgr.inputStream());
+            // This only has an effect if we're running multiple threads.
+            parser->parseInParallel();
+            return parser;
         }
         return std::make_unique<ml::api::CCsvInputParser>(ioMgr.inputStream());
     }()};
@@ -41,7 +41,8 @@ bool CCmdLineParser::parse(int argc,
                            std::size_t& cacheMemorylimitBytes,
                            bool& validElasticLicenseKeyConfirmed,
                            bool& lowPriority,
-                           bool& useImmediateExecutor) {
+                           bool& useImmediateExecutor,
+                           bool& optimizeForInference) {
     try {
         boost::program_options::options_description desc(DESCRIPTION);
         // clang-format off
@@ -75,6 +76,7 @@ bool CCmdLineParser::parse(int argc,
             ("lowPriority", "Execute process in low priority")
             ("useImmediateExecutor", "Execute requests on the main thread. This mode should only used for "
             "benchmarking purposes to ensure requests are processed in order)")
+            ("optimizeForInference", "Freeze the model and apply inference graph optimizations after loading")
         ;
         // clang-format on
 
@@ -148,6 +150,9 @@ bool CCmdLineParser::parse(int argc,
                 return false;
             }
         }
+        if (vm.count("optimizeForInference") > 0) {
+            optimizeForInference = true;
+        }
     } catch (std::exception& e) {
         std::cerr << "Error processing command line: " << e.what() << std::endl;
         return false;
@@ -52,7 +52,8 @@ public:
                       std::size_t& cacheMemorylimitBytes,
                       bool& validElasticLicenseKeyConfirmed,
                       bool& lowPriority,
-                      bool& useImmediateExecutor);
+                      bool& useImmediateExecutor,
+                      bool& optimizeForInference);
 
 private:
     static const std::string DESCRIPTION;
@@ -16,6 +16,7 @@
 
 #include <boost/json.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <istream>
 #include <sstream>
@@ -77,7 +78,8 @@ bool CCommandParser::ioLoop(const TRequestHandlerFunc& requestHandler,
             LOG_TRACE(<< "Inference command: " << doc);
 
             assert(doc.is_object());
-            json::object obj = doc.as_object();
+            // Take a reference: copying the object would deep copy every token.
+            const json::object& obj = doc.as_object();
             switch (validateJson(obj, errorHandler)) {
             case EMessageType::E_InferenceRequest:
                 if (requestHandler(*m_RequestCache, jsonToInferenceRequest(obj)) == false) {
@@ -285,7 +287,7 @@ CCommandParser::SControlMessage CCommandParser::jsonToControlMessage(const json:
 }
 
 CCommandParser::CRequestCache::CRequestCache(std::size_t memoryLimitBytes)
-    : m_Impl{memoryLimitBytes, std::chrono::milliseconds{100},
+    : m_Impl{numberShards(memoryLimitBytes), memoryLimitBytes, std::chrono::milliseconds{100},
              [](const auto& dictionary, const auto& request) {
                  auto translator = dictionary.translator();
                  translator.add(request.s_NumberInputTokens);
@@ -297,5 +299,13 @@ CCommandParser::CRequestCache::CRequestCache(std::size_t memoryLimitBytes)
                  return translator.word();
              }} {
 }
+
+std::size_t CCommandParser::CRequestCache::numberShards(std::size_t memoryLimitBytes) {
+    // Each inference thread can contend for the cache lock so we shard it.
+    // However, we don't want shards so small that they can only hold a few
+    // responses.
+    return std::clamp(memoryLimitBytes / MINIMUM_SHARD_MEMORY_BYTES, std::size_t{1},
+                      MAXIMUM_NUMBER_SHARDS);
+}
 }
 }
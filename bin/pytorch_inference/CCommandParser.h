@@ -91,7 +91,15 @@ public:
         void clear() override { m_Impl.clear(); }
 
     private:
-        using TConcurrentLfuCache = core::CConcurrentCompressedLfuCache<SRequest, std::string>;
+        using TConcurrentLfuCache =
+            core::CShardedConcurrentCompressedLfuCache<SRequest, std::string>;
+
+    private:
+        static constexpr std::size_t MINIMUM_SHARD_MEMORY_BYTES{1024 * 1024};
+        static constexpr std::size_t MAXIMUM_NUMBER_SHARDS{16};
+
+    private:
+        static std::size_t numberShards(std::size_t memoryLimitBytes);
 
     private:
         TConcurrentLfuCache m_Impl;
@@ -163,13 +163,15 @@ int main(int argc, char** argv) {
     bool validElasticLicenseKeyConfirmed{false};
     bool lowPriority{false};
     bool useImmediateExecutor{false};
+    bool optimizeForInference{false};
 
     if (ml::torch::CCmdLineParser::parse(
             argc, argv, modelId, namedPipeConnectTimeout, inputFileName,
             isInputFileNamedPipe, outputFileName, isOutputFileNamedPipe,
             restoreFileName, isRestoreFileNamedPipe, logFileName, logProperties,
             numThreadsPerAllocation, numAllocations, cacheMemorylimitBytes,
-            validElasticLicenseKeyConfirmed, lowPriority, useImmediateExecutor) == false) {
+            validElasticLicenseKeyConfirmed, lowPriority, useImmediateExecutor,
+            optimizeForInference) == false) {
         return EXIT_FAILURE;
     }
 
@@ -276,6 +278,13 @@ int main(int argc, char** argv) {
         }
         module_ = torch::jit::load(std::move(readAdapter));
         module_.eval();
+        if (optimizeForInference) {
+            // This freezes the module, i.e. inlines its parameters as constants,
+            // and then runs graph passes such as constant folding and operator
+            // fusion. It can't be undone so is only done on request.
+            module_ = torch::jit::optimize_for_inference(module_);
+            LOG_DEBUG(<< "model optimized for inference");
+        }
 
         LOG_DEBUG(<< "model loaded");
     } catch (const c10::Error& e) {
@@ -0,0 +1,265 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+//! \brief
+//! Summarise the size of model state without restoring it.
+//!
+//! DESCRIPTION:\n
+//! Utility to take a persisted model snapshot, in the same format that
+//! model_extractor reads, decompress it and report the number of times
+//! each state tag occurs and the number of bytes of JSON under it, down
+//! to a maximum nesting depth. For example, this shows how much of a large
+//! snapshot is taken up by each detector's models, residual priors and
+//! trend decompositions when investigating memory usage.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! Standalone dev program, not shipped with the product.
+//!
+//! The decompressed state is scanned a character at a time and never held
+//! in memory, so this works for snapshots too large to restore. Only JSON
+//! state is supported.
+//!
+//! Decompression is single threaded. CCompressOStream writes each snapshot
+//! as a sequence of independent gzip members, so it could be parallelised,
+//! but the compressed length of each member isn't recorded. Finding member
+//! boundaries would mean scanning for gzip headers, which can match inside
+//! compressed data, or changing the format. Neither seems worthwhile for
+//! an offline tool.
+//!
+#include <core/CBinaryStateRestoreTraverser.h>
+#include <core/CLogger.h>
+#include <core/CStateDecompressor.h>
+#include <core/CStringUtils.h>
+
+#include <api/CSingleStreamSearcher.h>
+#include <api/CStateRestoreStreamFilter.h>
+
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+const std::size_t DEFAULT_MAX_DEPTH{3};
+
+//! \brief The occurrences and total size of one state tag path.
+struct SStatistics {
+    std::size_t s_Count{0};
+    std::size_t s_TotalBytes{0};
+    std::size_t s_MaxBytes{0};
+};
+
+using TStrStatisticsMap = std::map<std::string, SStatistics>;
+
+//! \brief Accumulates the size of the values of each tag path in a stream
+//! of JSON one character at a time.
+//!
+//! The state JSON repeats tags within an object, for example once per
+//! detector, so values are aggregated by their path of tags rather than
+//! reported individually. Arrays contribute "[]" to the path of the values
+//! they contain.
+class CStateScanner {
+public:
+    explicit CStateScanner(std::size_t maxDepth) : m_MaxDepth{maxDepth} {}
+
+    void add(char c) {
+        if (m_InString) {
+            if (m_Escaped) {
+                m_Escaped = false;
+            } else if (c == '\\') {
+                m_Escaped = true;
+            } else if (c == '"') {
+                m_InString = false;
+            } else if (m_ReadingKey) {
+                m_Key += c;
+            }
+            ++m_Offset;
+            return;
+        }
+
+        switch (c) {
+        case '"':
+            m_InString = true;
+            m_ReadingKey = this->expectingKey();
+            if (m_ReadingKey) {
+                m_Key.clear();
+            }
+            break;
+        case ':':
+            if (m_ReadingKey && m_Frames.empty() == false) {
+                m_Frames.back().s_Key = std::move(m_Key);
+                m_Frames.back().s_ValueStart = m_Offset + 1;
+                m_Frames.back().s_InValue = true;
+                m_ReadingKey = false;
+            }
+            break;
+        case ',':
+            this->endValue();
+            break;
+        case '{':
+        case '[':
+            m_Frames.push_back(SFrame{c == '{', this->childPath(c == '[')});
+            break;
+        case '}':
+        case ']':
+            this->endValue();
+            if (m_Frames.empty() == false) {
+                m_Frames.pop_back();
+            }
+            break;
+        default:
+            break;
+        }
+        ++m_Offset;
+    }
+
+    std::size_t bytes() const { return m_Offset; }
+
+    const TStrStatisticsMap& statistics() const { return m_Statistics; }
+
+private:
+    //! \brief The state of an object or array being scanned.
+    struct SFrame {
+        SFrame(bool isObject, std::string path)
+            : s_IsObject{isObject}, s_Path{std::move(path)} {}
+
+        bool s_IsObject;
+        std::string s_Path;
+        std::string s_Key;
+        std::size_t s_ValueStart{0};
+        bool s_InValue{false};
+    };
+
+private:
+    bool expectingKey() const {
+        return m_Frames.empty() == false && m_Frames.back().s_IsObject &&
+               m_Frames.back().s_InValue == false;
+    }
+
+    std::string childPath(bool isArray) const {
+        std::string path;
+        if (m_Frames.empty() == false) {
+            const SFrame& parent{m_Frames.back()};
+            path = parent.s_Path;
+            if (parent.s_IsObject) {
+                path += '/' + parent.s_Key;
+            }
+        }
+        return isArray ? path + "[]" : path;
+    }
+
+    void endValue() {
+        if (m_Frames.empty() || m_Frames.back().s_InValue == false) {
+            return;
+        }
+        SFrame& frame{m_Frames.back()};
+        if (m_Frames.size() <= m_MaxDepth) {
+            std::size_t bytes{m_Offset - frame.s_ValueStart};
+            SStatistics& statistics{m_Statistics[frame.s_Path + '/' + frame.s_Key]};
+            ++statistics.s_Count;
+            statistics.s_TotalBytes += bytes;
+            statistics.s_MaxBytes = std::max(statistics.s_MaxBytes, bytes);
+        }
+        frame.s_InValue = false;
+    }
+
+private:
+    std::size_t m_MaxDepth;
+    std::size_t m_Offset{0};
+    bool m_InString{false};
+    bool m_Escaped{false};
+    bool m_ReadingKey{false};
+    std::string m_Key;
+    std::vector<SFrame> m_Frames;
+    TStrStatisticsMap m_Statistics;
+};
+
+void printStatistics(const CStateScanner& scanner) {
+    std::cout << "Total decompressed state: " << scanner.bytes() << " bytes\n\n"
+              << std::setw(12) << "count" << std::setw(16) << "total bytes"
+              << std::setw(14) << "max bytes"
+              << "  tag path\n";
+    for (const auto& path : scanner.statistics()) {
+        std::cout << std::setw(12) << path.second.s_Count << std::setw(16)
+                  << path.second.s_TotalBytes << std::setw(14)
+                  << path.second.s_MaxBytes << "  " << path.first << '\n';
+    }
+    std::cout << std::endl;
+}
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Utility to summarise the number of occurrences and size\n"
+                     "of each tag in a persisted model snapshot without restoring\n"
+                     "the models. The input is in the same format model_extractor\n"
+                     "reads and the default maximum depth is "
+                  << DEFAULT_MAX_DEPTH << ".\n";
+        std::cerr << "Usage: " << argv[0] << " <input file> [<max depth>]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::size_t maxDepth{DEFAULT_MAX_DEPTH};
+    if (argc == 3 && ml::core::CStringUtils::stringToType(argv[2], maxDepth) == false) {
+        LOG_ERROR(<< "Invalid maximum depth " << argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    LOG_INFO(<< "Opening input file: " << argv[1]);
+    std::ifstream inputFile(argv[1]);
+    if (inputFile.is_open() == false) {
+        LOG_ERROR(<< "Could not open input file " << argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    // Apply the same filter as model_extractor so we can read a persistence dump.
+    auto input = std::make_shared<boost::iostreams::filtering_istream>();
+    input->push(ml::api::CStateRestoreStreamFilter());
+    input->push(inputFile);
+    ml::api::CSingleStreamSearcher restoreSearcher{input};
+
+    // Each search returns the decompressed state of the next snapshot in the
+    // input until we run out.
+    for (std::size_t snapshot = 1; /**/; ++snapshot) {
+        ml::core::CStateDecompressor decompressor{restoreSearcher};
+        ml::core::CDataSearcher::TIStreamP strm{decompressor.search(1, 1)};
+        if (strm == nullptr || strm->bad() || strm->fail()) {
+            break;
+        }
+
+        if (ml::core::CBinaryStateRestoreTraverser::isBinaryState(*strm)) {
+            LOG_ERROR(<< "Snapshot " << snapshot << " is in the binary state format"
+                      << " which isn't supported");
+            return EXIT_FAILURE;
+        }
+
+        CStateScanner scanner{maxDepth};
+        std::for_each(std::istreambuf_iterator<char>{*strm},
+                      std::istreambuf_iterator<char>{},
+                      [&scanner](char c) { scanner.add(c); });
+        if (scanner.bytes() == 0) {
+            break;
+        }
+
+        std::cout << "Snapshot " << snapshot << '\n';
+        printStatistics(scanner);
+    }
+
+    return inputFile.bad() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -115,8 +115,15 @@ public:
     using TKeyCRefAnomalyDetectorPtrPr =
         std::pair<model::CSearchKey::TStrCRefKeyCRefPr, TAnomalyDetectorPtr>;
     using TKeyCRefAnomalyDetectorPtrPrVec = std::vector<TKeyCRefAnomalyDetectorPtrPr>;
+    using TStrAnomalyDetectorPtrCPtrUMap =
+        boost::unordered_map<std::string, const TAnomalyDetectorPtr*>;
+    using TStrAnomalyDetectorPtrCPtrUMapVec = std::vector<TStrAnomalyDetectorPtrCPtrUMap>;
     using TModelPlotDataVec = model::CAnomalyDetector::TModelPlotDataVec;
     using TAnnotationVec = model::CAnomalyDetector::TAnnotationVec;
+    using TWordVec = model::CAnomalyDetector::TWordVec;
+    using TWord = TWordVec::value_type;
+    using TStrCPtrWordPr = std::pair<const std::string*, TWord>;
+    using TStrCPtrWordPrVec = std::vector<TStrCPtrWordPr>;
 
     struct API_EXPORT SRestoredStateDetail {
         ERestoreStateStatus s_RestoredStateStatus{E_Uninitialised};
@@ -164,6 +171,11 @@ public:
     //! with any required modifications
     bool handleRecord(const TStrStrUMap& dataRowFields, TOptionalTime time) override;
 
+    //! Receive a batch of records to be processed.  This is equivalent to
+    //! calling handleRecord() for each record, but the fields each detector
+    //! needs are looked up once per batch.
+    bool handleRecords(const CRecordBatch& batch) override;
+
     //! Perform any final processing once all input data has been seen.
     void finalise() override;
 
@@ -191,6 +203,24 @@ public:
                             core_t::TTime timestamp,
                             const std::string& outputFormat);
 
+    //! Set whether to compute the results of the detectors concurrently on
+    //! the default async executor at the end of each bucket.
+    //!
+    //! The models are still sampled in a fixed order and the results are
+    //! merged in detector order, so the output doesn't depend on this.
+    void computeDetectorResultsConcurrently(bool enabled);
+
+    //! Set the number of threads to use to forecast the models of each
+    //! forecast request on the default async executor.
+    void numberForecastThreads(std::size_t numberThreads);
+
+    //! Set whether to persist state in the binary format written by
+    //! core::CBinaryStatePersistInserter rather than JSON. State in either
+    //! format can be restored.
+    //!
+    //! \note This must be set before any state is persisted.
+    void persistBinaryState(bool enabled);
+
     //! Initialise normalizer from quantiles state
     virtual bool initNormalizer(const std::string& quantilesStateFile);
 
@@ -233,6 +263,14 @@ private:
     //! Write out the results for the bucket starting at \p bucketStartTime.
     void outputResults(core_t::TTime bucketStartTime);
 
+    //! Build the results of \p detectors for the bucket starting at
+    //! \p bucketStartTime computing each detector's results concurrently.
+    void buildResultsConcurrently(core_t::TTime bucketStartTime,
+                                  const TKeyCRefAnomalyDetectorPtrPrVec& detectors,
+                                  model::CHierarchicalResults& results,
+                                  TModelPlotDataVec& modelPlotData,
+                                  TAnnotationVec& annotations);
+
     //! Write out interim results for the bucket starting at \p bucketStartTime.
     void outputInterimResults(core_t::TTime bucketStartTime);
 
@@ -388,12 +426,28 @@ private:
     //! Extract the field called \p fieldName from \p dataRowFields.
     const std::string* fieldValue(const std::string& fieldName, const TStrStrUMap& dataRowFields);
 
+    //! Get the dictionary word of the record field value \p value.
+    //!
+    //! The words are cached for the current record so each field value
+    //! is hashed once however many detectors use it.
+    const TWord& fieldWord(const std::string& value);
+
     //! Extract the required fields from \p dataRowFields
     //! and add the new record to \p detector
     void addRecord(const TAnomalyDetectorPtr detector,
                    core_t::TTime time,
                    const TStrStrUMap& dataRowFields);
 
+    //! Add a record with time \p time to every detector.  This is the part of
+    //! handling a record which is common to handleRecord() and handleRecords().
+    //! \p partitionFieldValue gets the partition field value for the i'th key
+    //! and \p addRecord adds the record to a detector.
+    template<typename PRINT_RECORD, typename PARTITION_FIELD_VALUE, typename ADD_RECORD>
+    void addRecordToDetectors(core_t::TTime time,
+                              const PRINT_RECORD& printRecord,
+                              const PARTITION_FIELD_VALUE& partitionFieldValue,
+                              const ADD_RECORD& addRecord);
+
     //! Parses a control message requesting that model state be persisted.
     //! Extracts optional arguments to be used for persistence.
     static bool parsePersistControlMessageArgs(const std::string& controlMessageArgs,
@@ -422,6 +476,16 @@ protected:
                                               const std::string& partitionFieldValue,
                                               model::CResourceMonitor& resourceMonitor);
 
+    //! Get a reference to the detector for the key at \p keyIndex in the
+    //! detector keys and \p partitionFieldValue.
+    //!
+    //! \note This avoids hashing and comparing the search key so is used
+    //! when adding records.
+    const TAnomalyDetectorPtr& detectorForKeyIndex(std::size_t keyIndex,
+                                                   core_t::TTime time,
+                                                   const std::string& partitionFieldValue,
+                                                   model::CResourceMonitor& resourceMonitor);
+
     //! Prune all the models that exceed \p buckets in age
     //! A value of 0 for \buckets indicates that only 'obsolete' models will
     //! be pruned, i.e. those which are so old as to be effectively dead.
@@ -462,6 +526,10 @@ private:
     //! Map of objects to provide the inner workings
     TKeyAnomalyDetectorPtrUMap m_Detectors;
 
+    //! The entries of m_Detectors indexed by the position of their key in
+    //! m_DetectorKeys and then by partition field value.
+    TStrAnomalyDetectorPtrCPtrUMapVec m_DetectorsByKeyIndex;
+
     //! The end time of the last bucket out of latency window we've seen
     core_t::TTime m_LastFinalisedBucketEndTime;
 
@@ -507,6 +575,12 @@ private:
     //! Flag indicating whether or not a flush control message should trigger a refresh of the datafeed
     bool m_RefreshRequired{true};
 
+    //! Should the results of the detectors be computed concurrently?
+    bool m_ComputeDetectorResultsConcurrently{false};
+
+    //! Should state be persisted in the binary format?
+    bool m_PersistBinaryState{false};
+
     //! Introduced in version 8.6
     //! The initial value of the end time of the last bucket
     //! out of latency window we've seen, i.e. this member records
@@ -520,6 +594,9 @@ private:
     //! restoration.
     core_t::TTime m_InitialLastFinalisedBucketEndTime{0};
 
+    //! The dictionary words of the current record's field values.
+    TStrCPtrWordPrVec m_RecordWords;
+
     // Test case access
     friend struct CAnomalyJobTest::testParsePersistControlMessageArgs;
 
@@ -402,6 +402,7 @@ public:
     class API_EXPORT CModelPlotConfig {
     public:
         static const std::string ANNOTATIONS_ENABLED;
+        static const std::string BOUNDS_CADENCE;
         static const std::string ENABLED;
         static const std::string TERMS;
 
@@ -414,6 +415,9 @@ public:
         bool annotationsEnabled() const { return m_AnnotationsEnabled; }
         bool enabled() const { return m_Enabled; }
 
+        //! The number of buckets between recomputing each series' bounds.
+        std::size_t boundsCadence() const { return m_BoundsCadence; }
+
         // The terms string is a comma separated list of partition or
         // by field values, but with no form of escaping.
         // TODO improve this to be a more robust format
@@ -422,6 +426,7 @@ public:
     private:
         bool m_AnnotationsEnabled{false};
         bool m_Enabled{false};
+        std::size_t m_BoundsCadence{1};
         std::string m_Terms;
     };
 
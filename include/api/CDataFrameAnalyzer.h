@@ -79,9 +79,15 @@ public:
     //! Get pointer to the analysis runner.
     const CDataFrameAnalysisRunner* runner() const;
 
+private:
+    using TStrVecVec = std::vector<TStrVec>;
+
 private:
     static const std::ptrdiff_t FIELD_UNSET;
     static const std::ptrdiff_t FIELD_MISSING;
+    //! The number of rows which are parsed together when the default async
+    //! executor has more than one thread.
+    static const std::size_t ROW_BLOCK_SIZE;
 
 private:
     bool sufficientFieldValues(const TStrVec& fieldValues) const;
@@ -93,6 +99,7 @@ private:
     void initializeDataFrameColumnMap(TStrVec columnNames);
     void validateCategoricalColumnsMatch() const;
     void addRowToDataFrame(const TStrVec& fieldValues);
+    void addBufferedRowsToDataFrame();
     void writeResultsOf(const CDataFrameAnalysisRunner& analysis,
                         core::CBoostJsonConcurrentLineWriter& writer) const;
     void writeInferenceModel(const CDataFrameAnalysisRunner& analysis,
@@ -112,6 +119,9 @@ private:
     TDataFrameAnalysisSpecificationUPtr m_AnalysisSpecification;
     TDataFrameUPtr m_DataFrame;
     TPtrdiffVecUPtr m_DataFrameColumnMap;
+    //! Rows waiting to be parsed in parallel.
+    TStrVecVec m_BufferedRows;
+    std::size_t m_NumberBufferedRows{0};
     TTemporaryDirectoryPtr m_DataFrameDirectory;
     TJsonOutputStreamWrapperUPtrSupplier m_ResultsStreamSupplier;
 };
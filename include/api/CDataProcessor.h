@@ -17,7 +17,9 @@
 
 #include <boost/unordered_map.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
@@ -28,6 +30,7 @@ class CDataAdder;
 class CDataSearcher;
 }
 namespace api {
+class CRecordBatch;
 
 //! \brief
 //! Abstract interface for classes that process data records
@@ -54,6 +57,7 @@ public:
     using TStrStrUMapCItr = TStrStrUMap::const_iterator;
 
     using TOptionalTime = std::optional<core_t::TTime>;
+    using TOptionalSize = std::optional<std::size_t>;
 
 public:
     CDataProcessor() = default;
@@ -73,6 +77,12 @@ public:
     //! with any required modifications
     virtual bool handleRecord(const TStrStrUMap& dataRowFields, TOptionalTime time) = 0;
 
+    //! Receive a batch of records to be processed.  The default passes each
+    //! record to handleRecord() in turn, registering the batch's mutable fields
+    //! whenever its fields change.  Derived classes can override this to look
+    //! up the fields they need once per batch.
+    virtual bool handleRecords(const CRecordBatch& batch);
+
     //! Perform any final processing once all input data has been seen.
     virtual void finalise() = 0;
 
@@ -100,10 +110,32 @@ public:
     //! called for every record as a matter of course.
     static std::string debugPrintRecord(const TStrStrUMap& dataRowFields);
 
+    //! Create debug for the \p record'th record of \p batch.
+    static std::string debugPrintRecord(const CRecordBatch& batch, std::size_t record);
+
     //! Parse the time from an input record.
     //! \return An empty optional on failure.
     TOptionalTime parseTime(const TStrStrUMap& dataRowFields) const;
 
+    //! Get the index of the time field of the records in \p batch.
+    TOptionalSize timeField(const CRecordBatch& batch) const;
+
+    //! Parse the time of the \p record'th record of \p batch, where
+    //! \p timeField is the result of calling timeField() for the batch.
+    //! \return An empty optional on failure.
+    TOptionalTime parseTime(const CRecordBatch& batch,
+                            std::size_t record,
+                            const TOptionalSize& timeField) const;
+
+private:
+    using TStrRef = std::reference_wrapper<std::string>;
+    using TStrRefVec = std::vector<TStrRef>;
+
+private:
+    //! Parse \p timeValue, which is null if the record has no time field.
+    template<typename PRINT_RECORD>
+    TOptionalTime parseTime(const std::string* timeValue, const PRINT_RECORD& printRecord) const;
+
 private:
     //! Name of field holding the time.  An empty string, indicates the input
     //! contains no timestamp.  This may not be valid for some data processors,
@@ -114,6 +146,16 @@ private:
     //! time field can be converted to a time_t by simply converting the
     //! string to a number.
     std::string m_TimeFieldFormat;
+
+    //! The fields of the last batch passed to handleRecords().
+    TStrVec m_BatchFieldNames;
+
+    //! The record passed on by handleRecords().
+    TStrStrUMap m_BatchRecord;
+
+    //! References to the values of m_BatchRecord in the order of the
+    //! fields of the batch.
+    TStrRefVec m_BatchRecordValues;
 };
 }
 }
@@ -87,6 +87,10 @@ public:
     //! The current state version
     static const std::string STATE_VERSION;
 
+    //! The number of records to buffer when categorizing partitions
+    //! concurrently.
+    static const std::size_t DEFAULT_CONCURRENT_CATEGORIZATION_BATCH_SIZE;
+
 public:
     // A type of token list data categorizer that DOESN'T exclude fields from
     // its analysis
@@ -155,6 +159,24 @@ public:
     //! How many records did we handle?
     std::uint64_t numRecordsHandled() const override;
 
+    //! Set the number of records to buffer so the records of different
+    //! partitions can be categorized concurrently on the default async
+    //! executor.
+    //!
+    //! Each partition's records are still categorized in their original order
+    //! and the records are passed down the chain in their original order, so
+    //! the categories are the same as categorizing serially.  However, changed
+    //! category definitions and memory usage are only updated once the whole
+    //! batch has been categorized, so fewer intermediate category definitions
+    //! are written and the memory limit is checked less often.  Also, state
+    //! persisted by a processor further down the chain may include the
+    //! categorization of records in the batch it hasn't yet seen.
+    //!
+    //! This has no effect without per-partition categorization or if the
+    //! default async executor has only one thread.  Zero, the default,
+    //! categorizes each record as it is handled.
+    void concurrentCategorizationBatchSize(std::size_t batchSize);
+
 private:
     using TPersistFuncVec = std::vector<CSingleFieldDataCategorizer::TPersistFunc>;
 
@@ -164,6 +186,26 @@ private:
     using TStrSingleFieldDataCategorizerUPtrMap =
         std::map<std::string, TSingleFieldDataCategorizerUPtr>;
 
+    //! \brief A record waiting to be categorized concurrently.
+    struct SBufferedRecord {
+        SBufferedRecord(const TStrStrUMap& fields, const TOptionalTime& time)
+            : s_Fields{fields}, s_Time{time} {}
+
+        //! A copy of the record.
+        TStrStrUMap s_Fields;
+        //! The record time.
+        TOptionalTime s_Time;
+        //! The categorizer for the record or null if it can't be categorized.
+        CSingleFieldDataCategorizer* s_DataCategorizer = nullptr;
+        //! The category of a record which can't be categorized.
+        CGlobalCategoryId s_GlobalCategoryId;
+        //! The local category of the record.
+        model::CLocalCategoryId s_LocalCategoryId;
+        //! Does the definition of the record's category need writing?
+        bool s_Changed = false;
+    };
+    using TBufferedRecordVec = std::vector<SBufferedRecord>;
+
 private:
     //! Get the appropriate categorizer key from the given input record
     const std::string& categorizerKeyForRecord(const TStrStrUMap& dataRowFields);
@@ -178,6 +220,42 @@ private:
     //! partition field value
     CSingleFieldDataCategorizer& categorizerForKey(const std::string& partitionFieldValue);
 
+    //! Get the categorizer for a record.  If the record can't be categorized
+    //! this returns null and sets \p globalCategoryId to the category to
+    //! assign to it.
+    CSingleFieldDataCategorizer* categorizerForRecord(const TStrStrUMap& dataRowFields,
+                                                      CGlobalCategoryId& globalCategoryId);
+
+    //! Compute the local category of a record using \p dataCategorizer.  This
+    //! only touches the state of \p dataCategorizer.
+    model::CLocalCategoryId computeLocalCategory(CSingleFieldDataCategorizer& dataCategorizer,
+                                                 const TStrStrUMap& dataRowFields,
+                                                 bool& changed) const;
+
+    //! Get the global category of a local category computed by
+    //! computeLocalCategory and write any changes.
+    CGlobalCategoryId updateCategory(CSingleFieldDataCategorizer& dataCategorizer,
+                                     model::CLocalCategoryId localCategoryId,
+                                     bool changed,
+                                     const TOptionalTime& time);
+
+    //! Are records being buffered to categorize partitions concurrently?
+    bool isCategorizingConcurrently() const;
+
+    //! Buffer a record to categorize concurrently, categorizing the buffer
+    //! if it is full.
+    bool bufferRecord(const TStrStrUMap& dataRowFields, const TOptionalTime& time);
+
+    //! Categorize the buffered records and pass them down the chain.
+    bool categorizeBufferedRecords();
+
+    //! Write the category to \p outputFieldCategory and pass a record down
+    //! the chain unless it had a hard failure.
+    bool chainRecord(const CGlobalCategoryId& globalCategoryId,
+                     const TStrStrUMap& dataRowFields,
+                     const TOptionalTime& time,
+                     std::string* outputFieldCategory);
+
     bool doPersistState(const TStrVec& partitionFieldValues,
                         const TPersistFuncVec& dataCategorizerPersistFuncs,
                         std::size_t categorizerAllocationFailures,
@@ -277,6 +355,12 @@ private:
     //! on each invocation of the program if the same partition values are seen
     //! again.
     TStrUSet m_CategorizerAllocationFailedPartitions;
+
+    //! The number of records to buffer to categorize partitions concurrently.
+    std::size_t m_ConcurrentCategorizationBatchSize = 0;
+
+    //! The records waiting to be categorized concurrently.
+    TBufferedRecordVec m_BufferedRecords;
 };
 }
 }
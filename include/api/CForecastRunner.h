@@ -105,6 +105,10 @@ public:
     //! minimum time between stat updates to prevent to many updates in a short time
     static const std::uint64_t MINIMUM_TIME_ELAPSED_FOR_STATS_UPDATE = 3000ul; // 3s
 
+    //! the number of models forecast per thread in each batch when forecasting
+    //! concurrently, a batch's results are held in memory until it is written
+    static const std::size_t MODELS_PER_THREAD_PER_BATCH = 16;
+
 private:
     static const std::string ERROR_FORECAST_REQUEST_FAILED_TO_PARSE;
     static const std::string ERROR_NO_FORECAST_ID;
@@ -131,6 +135,7 @@ public:
     using TAnomalyDetectorPtrVec = std::vector<TAnomalyDetectorPtr>;
 
     using TForecastModelWrapper = model::CForecastDataSink::CForecastModelWrapper;
+    using TForecastModelWrapperVec = std::vector<TForecastModelWrapper>;
     using TForecastResultSeries = model::CForecastDataSink::SForecastResultSeries;
     using TForecastResultSeriesVec = std::vector<TForecastResultSeries>;
     using TMathsModelPtr = std::unique_ptr<maths::common::CModel>;
@@ -166,6 +171,12 @@ public:
                          const TAnomalyDetectorPtrVec& detectors,
                          const core_t::TTime lastResultsTime);
 
+    //! Set the number of threads to use to forecast a job's models.
+    //!
+    //! \note The thread pool must be started with at least this many threads
+    //! for the models to be forecast concurrently.
+    void numberThreads(std::size_t numberThreads);
+
     //! Blocks and waits until all queued forecasts are done
     void finishForecasts();
 
@@ -173,6 +184,14 @@ public:
     void deleteAllForecastJobs();
 
 private:
+    //! \brief The forecast of a single model.
+    struct SModelForecast {
+        bool s_Success{false};
+        model::CForecastDataSink::TErrorBarVec s_ErrorBars;
+        std::string s_Message;
+    };
+    using TModelForecastVec = std::vector<SModelForecast>;
+
     struct API_EXPORT SForecast {
         SForecast() = default;
 
@@ -290,6 +309,9 @@ private:
     //! indicator for worker
     std::atomic_bool m_Shutdown;
 
+    //! The number of threads to use to forecast a job's models
+    std::atomic<std::size_t> m_NumberThreads{1};
+
     //! The 'queue' of forecast jobs to be executed
     std::list<SForecast> m_ForecastJobs;
 
@@ -15,12 +15,14 @@
 
 #include <boost/unordered_map.hpp>
 
+#include <cstddef>
 #include <functional>
 #include <string>
 #include <vector>
 
 namespace ml {
 namespace api {
+class CRecordBatch;
 
 //! \brief
 //! Input parser interface
@@ -57,6 +59,14 @@ public:
     //! reader loop.  The arguments are vectors of field names and field values.
     using TVecReaderFunc = std::function<bool(const TStrVec&, const TStrVec&)>;
 
+    //! Callback function prototype that gets called for each batch of records
+    //! read from the input stream.  Return false to exit reader loop.
+    using TBatchReaderFunc = std::function<bool(const CRecordBatch&)>;
+
+public:
+    //! The default maximum number of records in a batch.
+    static constexpr std::size_t DEFAULT_MAX_BATCH_SIZE{256};
+
 public:
     CInputParser(TStrVec mutableFieldNames);
     virtual ~CInputParser() = default;
@@ -94,7 +104,25 @@ public:
     virtual bool readStreamIntoVecs(const TVecReaderFunc& readerFunc,
                                     const TRegisterMutableFieldFunc& registerFunc) = 0;
 
+    //! Read records from the stream in batches of up to \p maxBatchSize
+    //! records with the same fields.  The supplied reader function is called
+    //! once per batch.  If it returns false, reading will stop.  A batch is
+    //! passed on early if it contains a control message or if the next record
+    //! isn't already buffered, so reading never blocks while records which
+    //! have been read are waiting to be processed.  The return value is as
+    //! for readStreamIntoVecs.
+    //!
+    //! \note Mutable fields are included in the batch's fields. Consumers
+    //! should register the batch's mutable fields themselves.
+    bool readStreamIntoBatches(const TBatchReaderFunc& readerFunc,
+                               std::size_t maxBatchSize = DEFAULT_MAX_BATCH_SIZE);
+
 protected:
+    //! Check if the next record can be parsed without reading from the stream.
+    //! The default is false which means every record is passed on immediately
+    //! by readStreamIntoBatches.
+    virtual bool isNextRecordBuffered() const;
+
     //! Add any mutable fields to the map that will be passed to the reader
     //! function, calling the registration function for each one.
     void registerMutableFields(const TRegisterMutableFieldFunc& registerFunc,
@@ -109,6 +137,9 @@ protected:
     //! Writable access to the field names for derived classes only
     TStrVec& fieldNames();
 
+    //! Get the names of the mutable fields.
+    const TStrVec& mutableFieldNames() const;
+
 private:
     //! Field names parsed from the input
     TStrVec m_FieldNames;
@@ -100,17 +100,6 @@ namespace api {
 //!
 class API_EXPORT CJsonOutputWriter {
 public:
-    using TDocumentPtr = std::shared_ptr<json::object>;
-    using TDocumentWeakPtr = std::weak_ptr<json::object>;
-    using TDocumentWeakPtrVec = std::vector<TDocumentWeakPtr>;
-    using TDocumentWeakPtrVecItr = TDocumentWeakPtrVec::iterator;
-    using TDocumentWeakPtrVecCItr = TDocumentWeakPtrVec::const_iterator;
-
-    using TDocumentWeakPtrIntPr = std::pair<TDocumentWeakPtr, int>;
-    using TDocumentWeakPtrIntPrVec = std::vector<TDocumentWeakPtrIntPr>;
-    using TDocumentWeakPtrIntPrVecItr = TDocumentWeakPtrIntPrVec::iterator;
-    using TStrDocumentPtrVecMap = std::map<std::string, TDocumentWeakPtrVec>;
-
     using TStrVec = std::vector<std::string>;
     using TStr1Vec = core::CSmallVector<std::string, 1>;
     using TTimeVec = std::vector<core_t::TTime>;
@@ -127,6 +116,26 @@ public:
 
     using TAnomalyScoreExplanation = CHierarchicalResultsWriter::TAnomalyScoreExplanation;
 
+    //! \brief A record or influencer which has been serialised but not yet
+    //! written.
+    //!
+    //! DESCRIPTION:\n
+    //! Documents are serialised when they are accepted, rather than being
+    //! built up as JSON DOM values, and the fields which are the same for
+    //! every document in a bucket are only added when the bucket is written.
+    struct SSerialisedDocument {
+        //! The probability of a record or the score of an influencer. This
+        //! is used to choose which documents to write and their order.
+        double s_SortValue;
+
+        //! The index of the detector which produced a record.
+        int s_DetectorIndex;
+
+        //! The document serialised as a JSON object.
+        std::string s_Json;
+    };
+    using TSerialisedDocumentVec = std::vector<SSerialisedDocument>;
+
     //! Structure to buffer up information about each bucket that we have
     //! unwritten results for
     struct SBucketData {
@@ -145,15 +154,14 @@ public:
         //! The bucketspan of this bucket
         core_t::TTime s_BucketSpan;
 
-        //! The result record documents to be written, in a vector keyed on
-        //! detector index
-        TDocumentWeakPtrIntPrVec s_DocumentsToWrite;
+        //! The result record documents to be written
+        TSerialisedDocumentVec s_DocumentsToWrite;
 
         //! Bucket Influencer documents
-        TDocumentWeakPtrVec s_BucketInfluencerDocuments;
+        TSerialisedDocumentVec s_BucketInfluencerDocuments;
 
         //! Influencer documents
-        TDocumentWeakPtrVec s_InfluencerDocuments;
+        TSerialisedDocumentVec s_InfluencerDocuments;
 
         // The highest probability of all the records stored
         // in the s_DocumentsToWrite array. Used for filtering
@@ -290,34 +298,46 @@ private:
                      SBucketData& bucketData,
                      std::uint64_t bucketProcessingTime);
 
+    //! Get an empty buffer, reusing the storage of a previous document
+    //! if possible.
+    std::string acquireBuffer();
+
+    //! Return the storage of \p buffer to the pool for reuse.
+    void recycleBuffer(std::string& buffer);
+
+    //! Return the storage of all documents in \p documents to the pool.
+    void recycleBuffers(TSerialisedDocumentVec& documents);
+
+    //! Return the storage of the nested documents to the pool.
+    void recycleNestedDocs();
+
+    //! Start serialising a JSON object to \p buffer.
+    void beginDocument(std::string& buffer);
+
+    //! Finish serialising the JSON object started in beginDocument.
+    void endDocument(std::string& buffer);
+
     //! Add the fields for a metric detector
-    void addMetricFields(const CHierarchicalResultsWriter::TResults& results,
-                         TDocumentWeakPtr weakDoc);
+    void addMetricFields(const CHierarchicalResultsWriter::TResults& results);
 
     //! Write the fields for a population detector
-    void addPopulationFields(const CHierarchicalResultsWriter::TResults& results,
-                             TDocumentWeakPtr weakDoc);
+    void addPopulationFields(const CHierarchicalResultsWriter::TResults& results);
 
     //! Write the fields for a population detector cause
-    void addPopulationCauseFields(const CHierarchicalResultsWriter::TResults& results,
-                                  TDocumentWeakPtr weakDoc);
+    void addPopulationCauseFields(const CHierarchicalResultsWriter::TResults& results);
 
     //! Write the fields for an event rate detector
-    void addEventRateFields(const CHierarchicalResultsWriter::TResults& results,
-                            TDocumentWeakPtr weakDoc);
+    void addEventRateFields(const CHierarchicalResultsWriter::TResults& results);
 
     //! Add the influencer fields to the doc
     void addInfluencerFields(bool isBucketInfluencer,
-                             const model::CHierarchicalResults::TNode& node,
-                             TDocumentWeakPtr weakDoc);
+                             const model::CHierarchicalResults::TNode& node);
 
     //! Write the influence results.
-    void addInfluences(const CHierarchicalResultsWriter::TOptionalStrOptionalStrPrDoublePrVec& influenceResults,
-                       TDocumentWeakPtr weakDoc);
+    void addInfluences(const CHierarchicalResultsWriter::TOptionalStrOptionalStrPrDoublePrVec& influenceResults);
 
     //! Write anomaly score explanation object.
-    void writeAnomalyScoreExplanationObject(const CHierarchicalResultsWriter::TResults& results,
-                                            json::object& anomalyScoreExplanation);
+    void writeAnomalyScoreExplanationObject(const CHierarchicalResultsWriter::TResults& results);
 
 private:
     //! The job ID
@@ -335,16 +355,17 @@ private:
     //! Max number of records to write for each bucket/detector
     std::size_t m_RecordOutputLimit;
 
-    //! Vector for building up documents representing nested sub-results.
-    //! The documents in this vector will reference memory owned by
-    //! m_JsonPoolAllocator.  (Hence this is declared after the memory pool
-    //! so that it's destroyed first when the destructor runs.)
-    TDocumentWeakPtrVec m_NestedDocs;
+    //! Serialises records and influencers to their buffers.
+    core::CStringBufWriter m_DocumentWriter;
+
+    //! Buffers of documents which have been written, which are reused to
+    //! avoid allocating for every document of every bucket.
+    TStrVec m_BufferPool;
+
+    //! Serialised documents representing nested sub-results.
+    TStrVec m_NestedDocs;
 
     //! Bucket data waiting to be written.  The map is keyed on bucket time.
-    //! The documents in this map will reference memory owned by
-    //! m_JsonPoolAllocator.  (Hence this is declared after the memory pool
-    //! so that it's destroyed first when the destructor runs.)
     TTimeBucketDataMap m_BucketDataByTime;
 };
 }
@@ -16,6 +16,7 @@
 
 #include <boost/scoped_array.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <iosfwd>
 #include <string>
@@ -75,7 +76,17 @@ namespace api {
 //! interfacing with Java (which doesn't have built-in unsigned
 //! types) easier.
 //!
+//! Parallel parsing can be enabled for large bulk loads.  Then the
+//! reading thread only walks the length prefixes to split the input
+//! into chunks of whole records, which are converted to strings by the
+//! threads of the default async executor.  Records are still passed
+//! to the reader function in order on the reading thread.
+//!
 class API_EXPORT CLengthEncodedInputParser : public CInputParser {
+public:
+    //! The default size of the chunks which are parsed in parallel.
+    static constexpr std::size_t DEFAULT_PARALLEL_CHUNK_SIZE{1048576}; // 1MB
+
 public:
     //! Construct with an input stream to be parsed.  Once a stream is
     //! passed to this constructor, no other object should read from it.
@@ -96,6 +107,11 @@ public:
     //! As above but also provide some mutable field names
     CLengthEncodedInputParser(TStrVec mutableFieldNames, std::istream& strmIn);
 
+    //! Convert chunks of about \p chunkSize bytes of records to strings in
+    //! parallel using the default async executor.  This has no effect unless
+    //! the default async executor has more than one thread.
+    void parseInParallel(std::size_t chunkSize = DEFAULT_PARALLEL_CHUNK_SIZE);
+
     //! Read records from the stream.  The supplied reader function is called
     //! once per record.  If the supplied reader function returns false, reading
     //! will stop.  This method keeps reading until it reaches the end of the
@@ -116,6 +132,10 @@ public:
     using CInputParser::readStreamIntoMaps;
     using CInputParser::readStreamIntoVecs;
 
+protected:
+    //! Check if the whole of the next record is in the working buffer.
+    bool isNextRecordBuffered() const override;
+
 private:
     //! Attempt to parse a single length encoded record that contains the field
     //! names for the rest of the stream.
@@ -127,6 +147,18 @@ private:
     template<typename READER_FUNC>
     bool parseRecordLoop(const READER_FUNC& readerFunc, TStrRefVec& workSpace);
 
+    //! As parseRecordLoop but the records are split into chunks which are
+    //! converted to strings in parallel.
+    template<typename READER_FUNC>
+    bool parallelParseRecordLoop(const READER_FUNC& readerFunc, TStrRefVec& workSpace);
+
+    //! Advance \p recordsEnd past the whole records with \p numFields fields
+    //! in \p buffer.
+    //! \return False if the records are corrupt.
+    static bool findRecordsEnd(const std::string& buffer,
+                               std::size_t numFields,
+                               std::size_t& recordsEnd);
+
     //! Attempt to parse a single length encoded record from the stream into
     //! the strings in the vector provided.  The vector is a template
     //! argument so that it may be a vector of std::reference_wrappers
@@ -167,6 +199,10 @@ private:
     const char* m_WorkBufferPtr = nullptr;
     const char* m_WorkBufferEnd = nullptr;
     bool m_NoMoreRecords = false;
+
+    //! The size of the chunks of records to parse in parallel or zero
+    //! to parse serially.
+    std::size_t m_ParallelChunkSize = 0;
 };
 }
 }
@@ -65,6 +65,9 @@ protected:
     //! changed.
     void resetBuffer();
 
+    //! Check if there is a complete line in the working buffer.
+    bool isNextRecordBuffered() const override;
+
 private:
     //! Allocate this much memory for the working buffer
     static const std::size_t WORK_BUFFER_SIZE;
@@ -14,10 +14,17 @@
 #include <api/CNdInputParser.h>
 #include <api/ImportExport.h>
 
+#include <core/BoostJsonConstants.h>
+
 #include <boost/json.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <string>
+#include <string_view>
+#include <vector>
+
 namespace json = boost::json;
 namespace ml {
 namespace api {
@@ -36,8 +43,12 @@ namespace api {
 //! for processing.
 //!
 //! IMPLEMENTATION DECISIONS:\n
-//! Using the boost::json library to do the heavy lifting, but copying output
-//! to standard STL/Boost data structures.
+//! Using the boost::json SAX parser to do the heavy lifting. No document
+//! object is built: the handler writes each value straight into the string
+//! for its field in the record, i.e. the strings which are registered as
+//! mutable fields and which are reused for every record. The value strings
+//! are the same as serializing the parsed value with the double quotes
+//! removed, so nested objects and arrays are flattened to text.
 //!
 //! It is possible to tell the parser that all documents have exactly the
 //! same structure, i.e. the same field names in the same order.  In
@@ -82,38 +93,108 @@ public:
     using CInputParser::readStreamIntoVecs;
 
 private:
-    //! Attempt to parse the current working record into data fields.
-    bool parseDocument(char* begin, std::size_t length, json::value& document);
-
-    bool decodeDocumentWithCommonFields(const TRegisterMutableFieldFunc& registerFunc,
-                                        const json::value& document,
-                                        TStrVec& fieldNames,
-                                        TStrRefVec& fieldValRefs,
-                                        TStrStrUMap& recordFields);
-
-    bool decodeDocumentWithCommonFields(const TRegisterMutableFieldFunc& registerFunc,
-                                        const json::value& document,
-                                        TStrVec& fieldNames,
-                                        TStrVec& fieldValues);
-
-    bool decodeDocumentWithArbitraryFields(const TRegisterMutableFieldFunc& registerFunc,
-                                           const json::value& document,
-                                           TStrVec& fieldNames,
-                                           TStrStrUMap& recordFields);
-
-    bool decodeDocumentWithArbitraryFields(const TRegisterMutableFieldFunc& registerFunc,
-                                           const json::value& document,
-                                           TStrVec& fieldNames,
-                                           TStrVec& fieldValues);
-
-    static bool jsonValueToString(const std::string& fieldName,
-                                  const json::value& jsonValue,
-                                  std::string& fieldValueStr);
+    //! \brief
+    //! <a href="https://www.boost.org/doc/libs/1_83_0/libs/json/doc/html/json/ref/boost__json__basic_parser.html#json.ref.boost__json__basic_parser.handler0">Handler</a>
+    //! which writes the fields of a document into a record.
+    struct SRecordHandler final {
+        //! How the fields of the current document are stored.
+        enum EMode {
+            //! Add the field names and set their values in a map.
+            E_ArbitraryMap,
+            //! Add the field names and values to vectors.
+            E_ArbitraryVecs,
+            //! Set the values of the existing fields by position.
+            E_CommonFields
+        };
+
+        static constexpr std::size_t max_array_size = core::boost_json_constants::MAX_ARRAY_SIZE;
+        static constexpr std::size_t max_object_size = core::boost_json_constants::MAX_OBJECT_SIZE;
+        static constexpr std::size_t max_string_size = core::boost_json_constants::MAX_STRING_SIZE;
+        static constexpr std::size_t max_key_size = core::boost_json_constants::MAX_KEY_SIZE;
+
+        bool on_document_begin(json::error_code& ec);
+        bool on_document_end(json::error_code& ec);
+        bool on_array_begin(json::error_code& ec);
+        bool on_array_end(std::size_t n, json::error_code& ec);
+        bool on_object_begin(json::error_code& ec);
+        bool on_object_end(std::size_t n, json::error_code& ec);
+        bool on_string_part(std::string_view s, std::size_t n, json::error_code& ec);
+        bool on_string(std::string_view s, std::size_t n, json::error_code& ec);
+        bool on_key_part(std::string_view s, std::size_t n, json::error_code& ec);
+        bool on_key(std::string_view s, std::size_t n, json::error_code& ec);
+        bool on_number_part(std::string_view s, json::error_code& ec);
+        bool on_int64(std::int64_t i, std::string_view s, json::error_code& ec);
+        bool on_uint64(std::uint64_t u, std::string_view s, json::error_code& ec);
+        bool on_double(double d, std::string_view s, json::error_code& ec);
+        bool on_bool(bool b, json::error_code& ec);
+        bool on_null(json::error_code& ec);
+        bool on_comment_part(std::string_view s, json::error_code& ec);
+        bool on_comment(std::string_view s, json::error_code& ec);
+
+        //! Check a value can be written and add any separator it needs.
+        bool beginValue(json::error_code& ec);
+
+        //! Append \p s escaped as by json::serialize but without quotes.
+        void appendEscaped(std::string_view s);
+
+        //! Record \p error and fail the parse.
+        bool fail(const char* error, json::error_code& ec);
+
+        //! How the fields are stored.
+        EMode s_Mode{E_ArbitraryMap};
+        //! The field names, which are appended to unless in common fields mode.
+        TStrVec* s_FieldNames{nullptr};
+        //! The map of field values if reading into maps.
+        TStrStrUMap* s_RecordFields{nullptr};
+        //! The field values if reading into vectors.
+        TStrVec* s_FieldValues{nullptr};
+        //! The field value references in common fields mode when reading
+        //! into maps.
+        TStrRefVec* s_FieldValueRefs{nullptr};
+        //! The number of fields read from the current document.
+        std::size_t s_NumberFields{0};
+        //! The value being written.
+        std::string* s_Value{nullptr};
+        //! The characters of the current key.
+        std::string s_Key;
+        //! Have we seen some, but not all, of a string value?
+        bool s_InString{false};
+        //! The number of open objects and arrays.
+        std::size_t s_Depth{0};
+        //! For each open nested object or array whether it is an array.
+        std::vector<bool> s_IsArray;
+        //! For each open nested object or array whether it has any elements.
+        std::vector<bool> s_HasElements;
+        //! The reason the handler failed the parse, if it did.
+        const char* s_Error{nullptr};
+    };
+
+private:
+    //! Parse the document in [\p begin, \p begin + \p length) writing its
+    //! fields as configured in the handler.
+    bool parseDocument(const char* begin, std::size_t length);
+
+    //! Prepare the handler to read a document's fields into a map.
+    void startArbitraryDocument(TStrVec& fieldNames, TStrStrUMap& recordFields);
+
+    //! Prepare the handler to read a document's fields into vectors.
+    void startArbitraryDocument(TStrVec& fieldNames, TStrVec& fieldValues);
+
+    //! Prepare the handler to read a document's values in order into the
+    //! strings referenced by \p fieldValueRefs.
+    void startCommonDocument(TStrRefVec& fieldValueRefs);
+
+    //! Prepare the handler to read a document's values in order into
+    //! \p fieldValues.
+    void startCommonDocument(TStrVec& fieldValues);
 
 private:
     //! Are all JSON documents expected to contain the same fields in the
     //! same order?
     bool m_AllDocsSameStructure;
+
+    //! The parser.
+    json::basic_parser<SRecordHandler> m_Parser;
 };
 }
 }
@@ -0,0 +1,101 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+#ifndef INCLUDED_ml_api_CRecordBatch_h
+#define INCLUDED_ml_api_CRecordBatch_h
+
+#include <api/ImportExport.h>
+
+#include <boost/unordered_map.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ml {
+namespace api {
+
+//! \brief
+//! A batch of input records which all have the same fields.
+//!
+//! DESCRIPTION:\n
+//! The values are stored by column, i.e. there is a vector of the values
+//! of each field for every record in the batch. This lets consumers look
+//! up the index of each field they need once per batch rather than once
+//! per record.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! Clearing the batch keeps the storage of the value strings so filling
+//! a batch doesn't allocate once it has reached its typical size.
+//!
+//! The batch also records the names of any mutable fields. These are
+//! included in the field names and are the fields for which a consumer
+//! of the batch should call CDataProcessor::registerMutableField.
+class API_EXPORT CRecordBatch {
+public:
+    using TStrVec = std::vector<std::string>;
+    using TStrVecVec = std::vector<TStrVec>;
+    using TStrStrUMap = boost::unordered_map<std::string, std::string>;
+    using TOptionalSize = std::optional<std::size_t>;
+
+public:
+    //! Remove all records and set the fields of the records in the batch.
+    void reset(const TStrVec& fieldNames, const TStrVec& mutableFieldNames);
+
+    //! Remove all records but keep the fields.
+    void clear();
+
+    //! Add a record whose values are in the same order as fieldNames().
+    void add(const TStrVec& fieldValues);
+
+    //! Get the number of records in the batch.
+    std::size_t size() const;
+
+    //! Check if the batch has no records.
+    bool empty() const;
+
+    //! Get the names of the fields of every record.
+    const TStrVec& fieldNames() const;
+
+    //! Get the names of the mutable fields.
+    const TStrVec& mutableFieldNames() const;
+
+    //! Get the column of the field called \p fieldName if there is one.
+    //!
+    //! \note If a name is repeated this is its last column which is the
+    //! value a map of the record's fields would hold.
+    TOptionalSize fieldIndex(const std::string& fieldName) const;
+
+    //! Get the value of the \p field'th field of the \p record'th record.
+    const std::string& value(std::size_t field, std::size_t record) const {
+        return m_Columns[field][record];
+    }
+
+    //! Write the \p record'th record to \p fields.
+    void record(std::size_t record, TStrStrUMap& fields) const;
+
+private:
+    //! The field names.
+    TStrVec m_FieldNames;
+
+    //! The mutable field names.
+    TStrVec m_MutableFieldNames;
+
+    //! The values of each field.
+    TStrVecVec m_Columns;
+
+    //! The number of records in the batch.
+    std::size_t m_Size{0};
+};
+}
+}
+
+#endif // INCLUDED_ml_api_CRecordBatch_h
@@ -156,14 +156,14 @@ protected:
         throw std::runtime_error{"Field '" + tag + "' is missing."};
     }
 
-    static auto getAsObjectFrom(const json::value& value) {
+    static const json::object& getAsObjectFrom(const json::value& value) {
         if (value.is_object()) {
             return value.as_object();
         }
         throw std::runtime_error{"is not an object"};
     }
 
-    static auto getAsArrayFrom(const json::value& value) {
+    static const json::array& getAsArrayFrom(const json::value& value) {
         if (value.is_array()) {
             return value.as_array();
         }
@@ -77,6 +77,27 @@ public:
                              model::CResourceMonitor& resourceMonitor,
                              CJsonOutputWriter& jsonOutputWriter);
 
+    //! The first step of computeAndUpdateCategory.  This computes the local
+    //! category of a string and updates that category's examples and reverse
+    //! search.  It only reads the resource monitor and otherwise only touches
+    //! the state of this object, so different objects can do this concurrently.
+    //! \p changed is set if the category definition needs to be written.
+    model::CLocalCategoryId
+    computeLocalCategory(bool isDryRun,
+                         const model::CDataCategorizer::TStrStrUMap& fields,
+                         const std::string& messageToCategorize,
+                         const std::string& rawMessage,
+                         bool& changed);
+
+    //! The second step of computeAndUpdateCategory.  This maps a local category
+    //! computed by computeLocalCategory to its global category and, if it
+    //! \p changed, writes its definition and refreshes the resource monitor.
+    CGlobalCategoryId updateCategory(model::CLocalCategoryId localCategoryId,
+                                     bool changed,
+                                     const TOptionalTime& messageTime,
+                                     model::CResourceMonitor& resourceMonitor,
+                                     CJsonOutputWriter& jsonOutputWriter);
+
     //! Make a function that can be called later to persist state in the
     //! foreground, i.e. in the knowledge that no other thread will be
     //! accessing the data structures this method accesses.
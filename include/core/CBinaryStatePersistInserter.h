@@ -0,0 +1,158 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+#ifndef INCLUDED_ml_core_CBinaryStatePersistInserter_h
+#define INCLUDED_ml_core_CBinaryStatePersistInserter_h
+
+#include <core/CStatePersistInserter.h>
+#include <core/ImportExport.h>
+
+#include <boost/unordered_map.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ml {
+namespace core {
+
+//! \brief
+//! For persisting state in a compact binary format.
+//!
+//! DESCRIPTION:\n
+//! Concrete implementation of the CStatePersistInserter interface
+//! that persists state in a binary format which is much smaller and
+//! faster to restore than JSON.
+//!
+//! The document comprises:
+//!   -# The marker MARKER followed by a single byte VERSION.
+//!   -# A dictionary of the distinct names, as a varint count followed
+//!      by each name as a varint length and its characters.
+//!   -# The body as a varint length and then a sequence of elements.
+//!
+//! Each element starts with a varint header which holds the index of
+//! its name in the dictionary shifted left by three bits, with the
+//! element type in the low three bits. String values and sub-levels
+//! are followed by a varint length and their content. Floating point
+//! values are written as their raw little endian IEEE754 bits and the
+//! element type records the precision with which to restore them.
+//! Collections of single precision values are written as a varint
+//! count followed by the raw little endian bits of each float.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! Length prefixing sub-levels means restore can skip those which are
+//! not of interest without decoding them. The price of this is that
+//! the document must be buffered in memory until the destructor, or
+//! flush, writes it to the output stream.
+//!
+//! Floating point numbers are restored exactly by doubleValue and
+//! floatValues, which RESTORE_BUILT_IN uses. If they're read as strings
+//! they're formatted with the same precision CStringUtils uses for JSON.
+class CORE_EXPORT CBinaryStatePersistInserter : public CStatePersistInserter {
+public:
+    //! Marks the start of a binary state document. The first character
+    //! can never start a JSON or XML document.
+    static const std::string MARKER;
+
+    //! The current version of the format.
+    static const std::uint8_t VERSION;
+
+    //! The element types.
+    enum EType {
+        E_String = 0,
+        E_Level = 1,
+        E_HalfPrecisionDouble = 2,
+        E_SinglePrecisionDouble = 3,
+        E_DoublePrecisionDouble = 4,
+        E_SinglePrecisionArray = 5
+    };
+
+    //! The number of bits used for the element type in its header.
+    static const std::size_t TYPE_BITS;
+
+public:
+    explicit CBinaryStatePersistInserter(std::ostream& outputStream);
+
+    //! Destructor flushes
+    ~CBinaryStatePersistInserter() override;
+
+    //! Store a name/value
+    void insertValue(const std::string& name, const std::string& value) override;
+
+    //! Store the raw bits of a floating point number
+    void insertValue(const std::string& name,
+                     double value,
+                     CIEEE754::EPrecision precision) override;
+
+    //! Store the raw bits of a collection of floats
+    void insertValue(const std::string& name, const TFloatStorageVec& values) override;
+
+    // Bring extra base class overloads into scope
+    using CStatePersistInserter::insertValue;
+
+    //! Write the document to the output stream.
+    //!
+    //! \note Nothing more can be inserted after this is called.
+    void flush();
+
+    //! Append \p value to \p buffer as a varint.
+    static void appendVarint(std::uint64_t value, std::string& buffer);
+
+protected:
+    //! Start a new level with the given name
+    void newLevel(const std::string& name) override;
+
+    //! End the current level
+    void endLevel() override;
+
+private:
+    using TStrSizeUMap = boost::unordered_map<std::string, std::size_t>;
+    using TStrVec = std::vector<std::string>;
+    using TSizeVec = std::vector<std::size_t>;
+
+private:
+    //! Get the dictionary index of \p name adding it if necessary.
+    std::size_t nameIndex(const std::string& name);
+
+    //! Append an element header to the current level.
+    void appendHeader(const std::string& name, EType type);
+
+    //! Get the buffer for the current level.
+    std::string& currentLevel() { return m_Levels[m_Depth]; }
+
+private:
+    //! The stream to which the document is written.
+    std::ostream& m_WriteStream;
+
+    //! Have we written the document?
+    bool m_Flushed{false};
+
+    //! The index of each distinct name.
+    TStrSizeUMap m_NameIndices;
+
+    //! The distinct names in order of first use.
+    TStrVec m_Names;
+
+    //! The encoded content of each open level. The buffers are reused by
+    //! subsequent levels at the same depth to avoid reallocating.
+    TStrVec m_Levels;
+
+    //! The name indices of the open levels.
+    TSizeVec m_LevelNames;
+
+    //! The current depth.
+    std::size_t m_Depth{0};
+};
+}
+}
+
+#endif // INCLUDED_ml_core_CBinaryStatePersistInserter_h
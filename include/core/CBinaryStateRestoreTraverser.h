@@ -0,0 +1,175 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+#ifndef INCLUDED_ml_core_CBinaryStateRestoreTraverser_h
+#define INCLUDED_ml_core_CBinaryStateRestoreTraverser_h
+
+#include <core/CStateRestoreTraverser.h>
+#include <core/ImportExport.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ml {
+namespace core {
+
+//! \brief
+//! For restoring state in the format written by CBinaryStatePersistInserter.
+//!
+//! DESCRIPTION:\n
+//! Concrete implementation of the CStateRestoreTraverser interface
+//! that restores state in the binary format.
+//!
+//! Use isBinaryState to check which traverser to use for a stream.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! The body of the document is read from the stream as it is traversed
+//! and only the value of the current element is held in memory. Since
+//! the stream is only read forwards a sub-level can't be traversed more
+//! than once. Sub-levels which aren't traversed are skipped using their
+//! length. Only a single document is read so several may be concatenated
+//! in a stream.
+//!
+//! Floating point numbers are returned exactly as they were persisted by
+//! doubleValue and floatValues. value() formats them with the precision
+//! used for JSON.
+class CORE_EXPORT CBinaryStateRestoreTraverser : public CStateRestoreTraverser {
+public:
+    explicit CBinaryStateRestoreTraverser(std::istream& inputStream);
+
+    //! Check if \p inputStream contains binary state. This doesn't
+    //! extract any characters from the stream.
+    static bool isBinaryState(std::istream& inputStream);
+
+    //! Navigate to the next element at the current level, or return false
+    //! if there isn't one
+    bool next() override;
+
+    //! Does the current element have a sub-level?
+    bool hasSubLevel() const override;
+
+    //! Get the name of the current element - the returned reference is only
+    //! valid for as long as the traverser is pointing at the same element
+    const std::string& name() const override;
+
+    //! Get the value of the current element - the returned reference is
+    //! only valid for as long as the traverser is pointing at the same
+    //! element
+    const std::string& value() const override;
+
+    //! Get the value of the current element as a collection of floats.
+    //! If it was stored as raw floats these are copied directly.
+    bool floatValues(TFloatStorageVec& result) const override;
+
+    //! Get the value of the current element as a double. If it was stored
+    //! as a raw double it is returned directly.
+    bool doubleValue(double& result) const override;
+
+    //! Is the traverser at the end of the inputstream?
+    bool isEof() const override;
+
+protected:
+    //! Navigate to the start of the sub-level of the current element, or
+    //! return false if there isn't one
+    bool descend() override;
+
+    //! Navigate to the element of the level above from which descend() was
+    //! called, or return false if there isn't a level above
+    bool ascend() override;
+
+private:
+    //! \brief The location of an element in the document body.
+    struct SElement {
+        //! Is this a real element? This is false for empty levels.
+        bool s_Valid{false};
+        //! The index of the element's name.
+        std::size_t s_Name{0};
+        //! The element type.
+        std::uint64_t s_Type{0};
+        //! The number of values in a collection.
+        std::size_t s_Count{0};
+        //! The offset of the start of the element's value in the body.
+        std::size_t s_ValueBegin{0};
+        //! The offset of the end of the element's value in the body.
+        std::size_t s_ValueEnd{0};
+    };
+
+    using TStrVec = std::vector<std::string>;
+    using TElementSizePr = std::pair<SElement, std::size_t>;
+    using TElementSizePrVec = std::vector<TElementSizePr>;
+
+private:
+    //! Read the document header and go to the first element.
+    bool start();
+
+    //! Read the element at the current position in to m_Current.
+    bool readElement();
+
+    //! Discard the body up to the offset \p end.
+    bool skipTo(std::size_t end);
+
+    //! Read \p length bytes of the body in to \p result.
+    bool readBytes(std::uint64_t length, std::string& result);
+
+    //! Read a varint from the input stream, reading no more than \p limit
+    //! bytes.
+    bool readVarint(std::uint64_t& value, std::size_t limit);
+
+    //! Read the double stored in the current value.
+    double readDouble() const;
+
+    //! Read the float stored at \p position in the current value.
+    float readFloat(std::size_t position) const;
+
+    //! Log \p error and set the bad state flag.
+    bool fail(const std::string& error);
+
+private:
+    //! The stream from which the document is read.
+    std::istream& m_ReadStream;
+
+    //! Have we read the document header?
+    bool m_Started{false};
+
+    //! The dictionary of names.
+    TStrVec m_Names;
+
+    //! The length of the document body.
+    std::size_t m_BodyLength{0};
+
+    //! The offset in the body of the next byte to read from the stream.
+    std::size_t m_Position{0};
+
+    //! The current element.
+    SElement m_Current;
+
+    //! The encoded value of the current element unless it's a sub-level.
+    std::string m_Value;
+
+    //! The end of the current level.
+    std::size_t m_LevelEnd{0};
+
+    //! The element and level end to which to return on each ascend.
+    TElementSizePrVec m_Levels;
+
+    //! The value of the current element.
+    mutable std::string m_CachedValue;
+
+    //! Is m_CachedValue valid?
+    mutable bool m_IsValueCacheValid{false};
+};
+}
+}
+
+#endif // INCLUDED_ml_core_CBinaryStateRestoreTraverser_h
@@ -28,6 +28,7 @@
 #include <numeric>
 #include <regex>
 #include <stack>
+#include <string_view>
 
 namespace json = boost::json;
 
@@ -208,6 +209,21 @@ public:
         return true;
     }
 
+    //! Write pre-serialised members, i.e. comma separated "key":value pairs,
+    //! of the current object.
+    virtual bool onRawMembers(const std::string_view& members) {
+        if (this->isObject() == false) {
+            return false;
+        }
+        if (members.empty()) {
+            return true;
+        }
+        this->append((isComplete() ? "" : ","));
+        this->append(members);
+        m_Levels.top()++;
+        return true;
+    }
+
     virtual bool onDocumentBegin() {
         this->append("{");
         m_Levels.push(0);
@@ -377,7 +393,10 @@ public:
             d = 0.0;
         }
         m_Levels.top()++;
-        this->append(CStringUtils::typeToStringPrecise(d, CIEEE754::E_DoublePrecision));
+        char buffer[CStringUtils::PRECISE_DOUBLE_BUFFER_SIZE];
+        std::size_t length{CStringUtils::typeToStringPrecise(
+            d, CIEEE754::E_DoublePrecision, buffer)};
+        this->append(std::string_view{buffer, length});
         return true;
     }
 
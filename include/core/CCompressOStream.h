@@ -16,6 +16,14 @@
 #include <core/CThread.h>
 #include <core/ImportExport.h>
 
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
 namespace ml {
 namespace core {
 
@@ -33,10 +41,25 @@ namespace core {
 //! manages the buffering of data between the client thread and
 //! the upload thread.
 //!
+//! The data are split into blocks which are gzip compressed independently
+//! on the default async executor and written downstream in order. This is
+//! a valid multi-member gzip stream so CStateDecompressor restores it with
+//! no changes. Blocks which haven't been picked up by the executor by the
+//! time they are needed are compressed on the upload thread so we never
+//! depend on executor threads being available to make progress.
+//!
 class CORE_EXPORT CCompressOStream : public std::ostream {
+public:
+    using TCompressBlockFunc = std::function<void(const std::string&, std::string&)>;
+
 public:
     //! Constructor
-    CCompressOStream(CStateCompressor::CChunkFilter& filter);
+    //!
+    //! \param[in] filter The sink for the compressed data.
+    //! \param[in] compressBlock Compresses one block of input into the output
+    //! string. This must produce a gzip member and is only replaced in tests.
+    CCompressOStream(CStateCompressor::CChunkFilter& filter,
+                     TCompressBlockFunc compressBlock = gzipBlock);
 
     //! Destructor will close the stream
     ~CCompressOStream() override;
@@ -44,18 +67,55 @@ public:
     //! Close the stream
     void close();
 
+    //! Gzip compress \p input appending to \p output.
+    static void gzipBlock(const std::string& input, std::string& output);
+
 private:
     class CCompressThread : public CThread {
     public:
         CCompressThread(CCompressOStream& stream,
                         CDualThreadStreamBuf& streamBuf,
-                        CStateCompressor::CChunkFilter& filter);
+                        CStateCompressor::CChunkFilter& filter,
+                        TCompressBlockFunc compressBlock);
+
+        //! Did compressing any block fail?
+        //!
+        //! \note This is only safe to call once the thread has stopped.
+        bool hasFailed() const;
 
     protected:
         //! Implementation of inherited interface
         void run() override;
         void shutdown() override;
 
+    private:
+        //! \brief A block of data to compress.
+        struct SBlock {
+            SBlock(std::string input, TCompressBlockFunc compressBlock)
+                : s_Input{std::move(input)}, s_CompressBlock{std::move(compressBlock)} {}
+
+            //! Compress the block if no other thread has claimed it. Any
+            //! exception is passed to the waiter through s_Compressed.
+            //!
+            //! \return True if this call claimed the block.
+            bool compress();
+
+            std::string s_Input;
+            TCompressBlockFunc s_CompressBlock;
+            std::string s_Output;
+            std::atomic_bool s_Claimed{false};
+            std::promise<void> s_Compressed;
+        };
+        using TBlockPtr = std::shared_ptr<SBlock>;
+        using TBlockPtrDeque = std::deque<TBlockPtr>;
+
+    private:
+        //! Start compressing \p input in the background.
+        void compressInBackground(std::string input);
+
+        //! Write the oldest block pending compression downstream.
+        void writeOldestBlock();
+
     public:
         //! Reference to the owning stream
         CCompressOStream& m_Stream;
@@ -68,8 +128,18 @@ private:
         //! downstream writing to datastore
         CStateCompressor::CChunkFilter& m_FilterSink;
 
-        //! The gzip filter to live within the new thread
+        //! The base64 encoding filter to live within the new thread
         CStateCompressor::TFilteredOutput m_OutFilter;
+
+        //! Compresses each block.
+        TCompressBlockFunc m_CompressBlock;
+
+        //! The blocks which have been scheduled for compression in the order
+        //! they must be written.
+        TBlockPtrDeque m_Blocks;
+
+        //! Set if compressing any block failed.
+        bool m_Failed{false};
     };
 
 private:
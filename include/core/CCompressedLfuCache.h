@@ -35,6 +35,7 @@
 #include <shared_mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace ml {
 namespace core {
@@ -86,7 +87,7 @@ public:
             this->computeMemoryParameters();
 
             // Ensure the cache is consuming no more than the current memory limit.
-            while (this->memoryUsage() > m_MaximumMemory) {
+            while (this->unguardedMemoryUsage() > m_MaximumMemory) {
                 auto itemToEvict = m_ItemStats.begin();
                 m_RemovedCount += itemToEvict->count();
                 this->removeFromCache(itemToEvict);
@@ -122,8 +123,17 @@ public:
     bool lookup(KEY key,
                 const TComputeValueCallback& computeValue,
                 const TReadValueCallback& readValue) {
+        auto compressedKey = this->compressKey(key);
+        return this->lookup(compressedKey, std::move(key), computeValue, readValue);
+    }
 
-        auto compressedKey = m_CompressKey(m_Dictionary, key);
+    //! Overload of lookup for callers which have already compressed \p key.
+    //!
+    //! \warning \p compressedKey must equal compressKey(\p key).
+    bool lookup(const TCompressedKey& compressedKey,
+                KEY key,
+                const TComputeValueCallback& computeValue,
+                const TReadValueCallback& readValue) {
 
         if (this->guardRead(TIME_OUT, [&] {
                 ++m_NumberLookups;
@@ -202,6 +212,19 @@ public:
         });
     }
 
+    //! Compress \p key.
+    //!
+    //! \note This doesn't take any locks.
+    TCompressedKey compressKey(const KEY& key) const {
+        return m_CompressKey(m_Dictionary, key);
+    }
+
+    //! Get the number of lookups.
+    std::uint64_t numberLookups() const { return m_NumberLookups.load(); }
+
+    //! Get the number of lookups which resulted in a hit.
+    std::uint64_t numberHits() const { return m_NumberHits.load(); }
+
     //! Get the proportion of requests which result in a hit.
     double hitFraction() const {
         return std::min(static_cast<double>(m_NumberHits.load()) /
@@ -707,6 +730,189 @@ private:
     mutable std::shared_timed_mutex m_Mutex;
 };
 
+//! \brief A thread safe memory limited least frequently used cache which is
+//! split into independently locked shards.
+//!
+//! DESCRIPTION:\n
+//! This has the same interface and behaviour as CConcurrentCompressedLfuCache
+//! except that items are assigned to one of a fixed number of shards by their
+//! compressed key. Each shard is a CConcurrentCompressedLfuCache with an equal
+//! share of the memory budget. This should be preferred if many threads use
+//! the cache concurrently since a hit takes a write lock to update the item
+//! frequency and so lookups on a single cache serialise.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! Frequencies are maintained per shard so the least frequently used item is
+//! evicted from the shard being written rather than globally. For uniformly
+//! distributed keys this makes little difference, but it does mean items must
+//! be small compared to the memory budget of one shard.
+//!
+//! \see compressed_lfu_cache_detail::CCompressedLfuCache.
+template<typename KEY, typename VALUE, std::size_t COMPRESSED_KEY_BITS = 128>
+class CShardedConcurrentCompressedLfuCache final {
+public:
+    using TShard = CConcurrentCompressedLfuCache<KEY, VALUE, COMPRESSED_KEY_BITS>;
+    using TDictionary = typename TShard::TDictionary;
+    using TCompressKey = typename TShard::TCompressKey;
+    using TComputeValueCallback = typename TShard::TComputeValueCallback;
+    using TReadValueCallback = typename TShard::TReadValueCallback;
+
+public:
+    //! \param[in] numberShards The number of shards into which to split the cache.
+    //! \param[in] maximumMemory The maximum memory the cache will consume in bytes.
+    //! \param[in] maximumWait The maximum time to wait at a critical section.
+    //! \param[in] compressKey Compresses the key. \see CCompressedDictionary for
+    //! details.
+    CShardedConcurrentCompressedLfuCache(std::size_t numberShards,
+                                         std::size_t maximumMemory,
+                                         std::chrono::milliseconds maximumWait,
+                                         const TCompressKey& compressKey) {
+        numberShards = std::max(numberShards, std::size_t{1});
+        m_Shards.reserve(numberShards);
+        for (std::size_t i = 0; i < numberShards; ++i) {
+            m_Shards.push_back(std::make_unique<TShard>(maximumMemory / numberShards,
+                                                        maximumWait, compressKey));
+        }
+    }
+
+    //! Resize the cache so that it uses no more than \p maximumMemory.
+    void resize(std::size_t maximumMemory) {
+        for (auto& shard : m_Shards) {
+            shard->resize(maximumMemory / m_Shards.size());
+        }
+    }
+
+    //! Lookup an item with \p key in the cache or else fall back to computing.
+    //!
+    //! \see CConcurrentCompressedLfuCache::lookup for details.
+    bool lookup(KEY key,
+                const TComputeValueCallback& computeValue,
+                const TReadValueCallback& readValue) {
+        // All shards use the same dictionary so any can compress the key.
+        auto compressedKey = m_Shards[0]->compressKey(key);
+        return this->shard(compressedKey)
+            .lookup(compressedKey, std::move(key), computeValue, readValue);
+    }
+
+    void clear() {
+        for (auto& shard : m_Shards) {
+            shard->clear();
+        }
+    }
+
+    //! Get the proportion of requests which result in a hit.
+    double hitFraction() const {
+        std::uint64_t numberLookups{0};
+        std::uint64_t numberHits{0};
+        for (const auto& shard : m_Shards) {
+            numberLookups += shard->numberLookups();
+            numberHits += shard->numberHits();
+        }
+        return std::min(static_cast<double>(numberHits) /
+                            static_cast<double>(numberLookups),
+                        1.0);
+    }
+
+    //! Get the number of items currently stored in the cache.
+    std::size_t size() const {
+        std::size_t result{0};
+        for (const auto& shard : m_Shards) {
+            result += shard->size();
+        }
+        return result;
+    }
+
+    //! Get the number of shards.
+    std::size_t numberShards() const { return m_Shards.size(); }
+
+    //! Get the stats for item with \p key.
+    //!
+    //! \return (memory usage, hit count).
+    //! \note Returns (0, 0) if the item is not in the cache.
+    std::pair<std::size_t, std::uint64_t> stats(const KEY& key) const {
+        return this->shard(m_Shards[0]->compressKey(key)).stats(key);
+    }
+
+    //! Get the amount of memory the cache is consuming.
+    std::size_t memoryUsage() const {
+        std::size_t result{0};
+        for (const auto& shard : m_Shards) {
+            result += shard->memoryUsage();
+        }
+        return result;
+    }
+
+    //! Check cache invariants.
+    //!
+    //! \return True if all cache invariants hold.
+    bool checkInvariants() const {
+        bool result{true};
+        for (const auto& shard : m_Shards) {
+            result = shard->checkInvariants() && result;
+        }
+        return result;
+    }
+
+    //! Persist by passing information to \p inserter.
+    void acceptPersistInserter(CStatePersistInserter& inserter) const {
+        inserter.insertValue(NUMBER_SHARDS_TAG, m_Shards.size());
+        for (const auto& shard : m_Shards) {
+            inserter.insertLevel(SHARD_TAG, [&shard](CStatePersistInserter& inserter_) {
+                shard->acceptPersistInserter(inserter_);
+            });
+        }
+    }
+
+    //! Populate the object from serialized data.
+    //!
+    //! \warning This is not thread safe since we expect to restore before the
+    //! cache is being used.
+    bool acceptRestoreTraverser(CStateRestoreTraverser& traverser) {
+        std::size_t numberShards{0};
+        std::size_t shard{0};
+        do {
+            const std::string& name{traverser.name()};
+            RESTORE_BUILT_IN(NUMBER_SHARDS_TAG, numberShards)
+            RESTORE(SHARD_TAG, shard < m_Shards.size() &&
+                                   traverser.traverseSubLevel([&](auto& traverser_) {
+                                       return m_Shards[shard++]->acceptRestoreTraverser(traverser_);
+                                   }))
+        } while (traverser.next());
+
+        if (numberShards != m_Shards.size() || shard != m_Shards.size()) {
+            LOG_ERROR(<< "Shard count mismatch: expected " << m_Shards.size()
+                      << " got " << numberShards << " and restored " << shard);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    using TShardUPtr = std::unique_ptr<TShard>;
+    using TShardUPtrVec = std::vector<TShardUPtr>;
+    using TCompressedKey = typename TDictionary::CWord;
+
+private:
+    static const std::string NUMBER_SHARDS_TAG;
+    static const std::string SHARD_TAG;
+
+private:
+    TShard& shard(const TCompressedKey& compressedKey) const {
+        // Use the high bits since the low bits select the shard's hash bucket.
+        return *m_Shards[(compressedKey.hash() >> 32) % m_Shards.size()];
+    }
+
+private:
+    TShardUPtrVec m_Shards;
+};
+
+// clang-format off
+template<typename KEY, typename VALUE, std::size_t COMPRESSED_KEY_BITS>
+const std::string CShardedConcurrentCompressedLfuCache<KEY, VALUE, COMPRESSED_KEY_BITS>::NUMBER_SHARDS_TAG{"number_shards"};
+template<typename KEY, typename VALUE, std::size_t COMPRESSED_KEY_BITS>
+const std::string CShardedConcurrentCompressedLfuCache<KEY, VALUE, COMPRESSED_KEY_BITS>::SHARD_TAG{"shard"};
+// clang-format on
+
 //! \brief A memory limited least frequently used cache.
 //!
 //! DESCRIPTION:\n
@@ -30,7 +30,9 @@ namespace core {
 //! See https://channel9.msdn.com/Shows/Going+Deep/C-and-Beyond-2012-Herb-Sutter-Concurrency-and-Parallelism
 //!
 //! @tparam T the wrapped object
-template<typename T>
+//! @tparam QUEUE the queue of tasks, for example CConcurrentQueue or
+//! CLockFreeConcurrentQueue
+template<typename T, template<typename> class QUEUE = CConcurrentQueue>
 class CConcurrentWrapper final : private CNonCopyable {
 public:
     //! Wrap and return the wrapped object
@@ -72,7 +74,7 @@ public:
 
 private:
     //! Queue for the tasks
-    mutable CConcurrentQueue<std::function<void()>> m_Queue;
+    mutable QUEUE<std::function<void()>> m_Queue;
 
     //! The wrapped resource
     T& m_Resource;
@@ -237,6 +237,8 @@ public:
     using TStrVec = std::vector<std::string>;
     using TStrVecVec = std::vector<TStrVec>;
     using TStrCRng = CVectorRange<const TStrVec>;
+    using TStrCRngVec = std::vector<TStrCRng>;
+    using TStrCPtrVec = std::vector<const std::string*>;
     using TFloatVec = std::vector<CFloatStorage, CAlignedAllocator<CFloatStorage>>;
     using TFloatVecItr = TFloatVec::iterator;
     using TInt32Vec = std::vector<std::int32_t>;
@@ -483,6 +485,21 @@ public:
                           const TPtrdiffVec* columnMap = nullptr,
                           const std::string* hash = nullptr);
 
+    //! Parses the strings of a block of rows using the default async executor
+    //! and writes them in order via writeRow.
+    //!
+    //! This gives the same result as calling parseAndWriteRow for each row in
+    //! turn. Each categorical column is parsed by a single task so categories
+    //! are numbered in the order they first appear.
+    //!
+    //! \param[in] rows The column values of each row.
+    //! \param[in] columnMap If non-null defines a map between the column values
+    //! and their position in the data frame. Negative values denote missing columns.
+    //! \param[in] hashes If non-null the hashes which identify the row documents.
+    void parseAndWriteRows(const TStrCRngVec& rows,
+                           const TPtrdiffVec* columnMap = nullptr,
+                           const TStrCPtrVec* hashes = nullptr);
+
     //! This writes a single row of the data frame via a callback.
     //!
     //! If asynchronous read and write to store was selected in the constructor
@@ -599,6 +616,13 @@ private:
 private:
     void fillCategoricalColumnValueLookup();
 
+    CFloatStorage parseValue(bool isCategorical,
+                             TStrSizeUMap& categoryLookup,
+                             TStrVec& categories,
+                             const std::string& columnValue,
+                             std::uint64_t& missingValueCount,
+                             std::uint64_t& badValueCount) const;
+
     bool parallelApplyToAllRows(std::size_t beginRows,
                                 std::size_t endRows,
                                 TRowFuncVec& funcs,
@@ -616,6 +640,10 @@ private:
                                const TOptionalPopMaskedRow& popMaskedRow,
                                const CDataFrameRowSliceHandle& slice) const;
 
+    //! Hint that \p slice will be read next if it is before \p end and the
+    //! data frame is stored out of core.
+    void prefetchSlice(TRowSlicePtrVecCItr slice, TRowSlicePtrVecCItr end) const;
+
     TRowSlicePtrVecCItr beginSlices(std::size_t beginRows) const;
     TRowSlicePtrVecCItr endSlices(std::size_t endRows) const;
 
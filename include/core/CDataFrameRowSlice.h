@@ -104,6 +104,11 @@ public:
     virtual CDataFrameRowSliceHandle read() = 0;
     //! Write the slice.
     virtual void write(const TFloatVec& rows, const TInt32Vec& docHashes) = 0;
+    //! Hint that the slice will be read soon.
+    //!
+    //! This must not block and must be safe to call concurrently with reading
+    //! or writing the slice. It is a no-op unless reading the slice is slow.
+    virtual void prefetch() const {}
     //! The static size of this object.
     virtual std::size_t staticSize() const = 0;
     //! The heap memory used by this object.
@@ -177,10 +182,14 @@ private:
 //!
 //! The slices are stored in binary format to maximize the read and write speed.
 //! We cache the number of bytes so we can read the file directory into a pre
-//! allocated vector. Note that these files are intended to be short lived and
-//! stay on the machine (or in the container) where the analysis action is being
-//! performed. So we have no architecture related issues with interpreting the
-//! stored bytes as floating point values.
+//! allocated vector. Files are read via a memory mapping, advising the kernel
+//! that access is sequential, and prefetch asks it to start reading a slice's
+//! file in the background so a pass over the data frame can overlap the disk
+//! reads of one slice with processing of the previous one. Note that these
+//! files are intended to be short lived and stay on the machine (or in the
+//! container) where the analysis action is being performed. So we have no
+//! architecture related issues with interpreting the stored bytes as floating
+//! point values.
 class CORE_EXPORT COnDiskDataFrameRowSlice final : public CDataFrameRowSlice {
 public:
     using TTemporaryDirectoryPtr = std::shared_ptr<CTemporaryDirectory>;
@@ -196,6 +205,7 @@ public:
     std::size_t indexOfLastRow(std::size_t rowCapacity) const override;
     CDataFrameRowSliceHandle read() override;
     void write(const TFloatVec& rows, const TInt32Vec& docHashes) override;
+    void prefetch() const override;
     std::size_t staticSize() const override;
     std::size_t memoryUsage() const override;
     std::uint64_t checksum() const override;
@@ -110,6 +110,11 @@ public:
             //! Get the offset.
             std::uint32_t b() const;
 
+            //! Check if two hash functions are identical.
+            bool operator==(const CUInt32UnrestrictedHash& rhs) const {
+                return m_A == rhs.m_A && m_B == rhs.m_B;
+            }
+
             //! \note This is implemented inline in contravention to
             //! the coding standards because we definitely don't want
             //! the cost of a function call here.
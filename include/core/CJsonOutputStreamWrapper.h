@@ -12,8 +12,8 @@
 #define INCLUDED_ml_core_CJsonOutputStreamWrapper_h
 
 #include <core/CBoostJsonLineWriter.h>
-#include <core/CConcurrentQueue.h>
 #include <core/CConcurrentWrapper.h>
+#include <core/CLockFreeConcurrentQueue.h>
 #include <core/CMemoryUsage.h>
 #include <core/CNonCopyable.h>
 #include <core/ImportExport.h>
@@ -36,6 +36,9 @@ namespace core {
 //!
 //! IMPLEMENTATION DECISIONS:\n
 //! Pool and buffer sizes are hardcoded.
+//!
+//! The buffer pool and the writer use lock free queues because many threads
+//! can be writing results concurrently.
 class CORE_EXPORT CJsonOutputStreamWrapper final : CNonCopyable {
 private:
     //! Number of buffers in the pool.
@@ -52,7 +55,8 @@ private:
     static const char JSON_ARRAY_DELIMITER;
 
 public:
-    using TOStreamConcurrentWrapper = core::CConcurrentWrapper<std::ostream>;
+    using TOStreamConcurrentWrapper =
+        core::CConcurrentWrapper<std::ostream, core::CLockFreeConcurrentQueue>;
     using TGenericLineWriter = core::CBoostJsonLineWriter<std::string>;
 
 public:
@@ -99,7 +103,7 @@ private:
     std::string m_StringBuffers[BUFFER_POOL_SIZE];
 
     //! the pool of available buffers
-    CConcurrentQueue<std::string*> m_StringBufferQueue;
+    CLockFreeConcurrentQueue<std::string*> m_StringBufferQueue;
 
     //! the stream object wrapped by CConcurrentWrapper
     TOStreamConcurrentWrapper m_ConcurrentOutputStream;
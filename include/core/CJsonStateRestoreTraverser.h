@@ -21,6 +21,7 @@
 
 #include <iosfwd>
 #include <string_view>
+#include <vector>
 
 namespace json = boost::json;
 
@@ -38,6 +39,12 @@ namespace core {
 //! Input is streaming rather than building up an in-memory JSON
 //! document.
 //!
+//! The parser is fed a buffer at a time and the handler queues the
+//! tokens it generates. The characters of names and values are stored
+//! in a single arena which is reset whenever the queue is drained, so
+//! restoring doesn't allocate per token once the arena has grown to
+//! the size of a buffer's worth of tokens.
+//!
 //! Unlike the CRapidXmlStatePersistInserter, there is no possibility
 //! of including attributes on the root node (because JSON does not
 //! have attributes).  This may complicate code that needs to be 100%
@@ -84,7 +91,7 @@ protected:
     void debug() const;
 
 private:
-    static const std::size_t BUFFER_SIZE{256};
+    static const std::size_t BUFFER_SIZE{16384};
 
 private:
     //! Accessors for alternating state variables
@@ -304,9 +311,47 @@ private:
         size_t s_NextIndex;
 
         bool s_RememberValue;
-        bool m_NewToken{true};
 
-        bool s_HaveCompleteToken{false};
+        //! \brief A token generated by the parser.
+        struct SToken {
+            ETokenType s_Type;
+            //! The start of the token's characters in the arena.
+            std::size_t s_Begin;
+            //! The end of the token's characters in the arena.
+            std::size_t s_End;
+        };
+        using TTokenVec = std::vector<SToken>;
+
+        //! Add a token of type \p type whose characters start at \p begin
+        //! and run to the end of the arena.
+        void pushToken(ETokenType type, std::size_t begin);
+
+        //! Add the characters of a string or key which may be split over
+        //! several parser callbacks.
+        void appendPart(std::string_view s);
+
+        //! Update the current and next element with the oldest queued
+        //! token, or return false if the queue is empty.
+        bool popToken();
+
+        //! Discard the queued tokens and reset the arena keeping any
+        //! partial string or key.
+        void resetArena();
+
+        //! Tokens waiting to be processed.
+        TTokenVec s_Tokens;
+
+        //! The next token in s_Tokens to process.
+        std::size_t s_NextToken{0};
+
+        //! The characters of the queued tokens.
+        std::string s_Arena;
+
+        //! Are we part way through a string or key?
+        bool s_InPart{false};
+
+        //! The start of the current partial string or key in the arena.
+        std::size_t s_PartBegin{0};
     };
 
     //! JSON reader istream wrapper
@@ -0,0 +1,338 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+#ifndef INCLUDED_ml_core_CLockFreeConcurrentQueue_h
+#define INCLUDED_ml_core_CLockFreeConcurrentQueue_h
+
+#include <core/CMemoryUsage.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace ml {
+namespace core {
+
+//! \brief
+//! A bounded multiple producer multiple consumer queue which doesn't use a
+//! lock to push or pop.
+//!
+//! DESCRIPTION:\n
+//! This has the same interface as CConcurrentQueue so can be used in its place
+//! where contention on the queue's mutex is a problem. Users which are templated
+//! on the queue type can choose the implementation by template parameter.
+//!
+//! The queue is a ring buffer of cells each with a sequence number, following
+//! Vyukov's bounded MPMC queue. Producers claim a position with a single CAS and
+//! publish the item by advancing its cell's sequence number, so they never wait
+//! for one another or for consumers unless the queue is full.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! To support popping conditionally a consumer reserves the cell at the head of
+//! the queue before inspecting its item and either takes the item or releases
+//! the cell unchanged. The head cell is therefore held by one consumer for the
+//! duration of the predicate and a move of T. Producers are never blocked by
+//! this.
+//!
+//! The queue needs at least two cells: with one the sequence number of a full
+//! cell would equal that of the empty cell for the next position, so producers
+//! would overwrite unconsumed items. Smaller capacities are rounded up to two.
+//!
+//! Blocking calls spin briefly, then yield and finally park on a condition
+//! variable. The mutex is only touched once a thread has parked, so when the
+//! queue is busy pushing and popping is lock free.
+//!
+//! @tparam T the objects of the queue
+template<typename T>
+class CLockFreeConcurrentQueue final {
+public:
+    using TOptional = std::optional<T>;
+
+    //! The smallest capacity the queue supports.
+    static constexpr std::size_t MINIMUM_CAPACITY{2};
+
+public:
+    //! \param[in] queueCapacity The queue capacity. This is rounded up to
+    //! MINIMUM_CAPACITY if it is smaller.
+    //! \param[in] notifyCapacity Unused, accepted for compatibility with
+    //! CConcurrentQueue. Parked producers are woken as soon as there is space.
+    CLockFreeConcurrentQueue(std::size_t queueCapacity, std::size_t /*notifyCapacity*/)
+        : m_QueueCapacity{std::max(queueCapacity, MINIMUM_CAPACITY)},
+          m_Cells(m_QueueCapacity) {
+        for (std::size_t i = 0; i < m_Cells.size(); ++i) {
+            m_Cells[i].s_Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    explicit CLockFreeConcurrentQueue(std::size_t queueCapacity)
+        : CLockFreeConcurrentQueue(queueCapacity, queueCapacity) {}
+
+    CLockFreeConcurrentQueue(const CLockFreeConcurrentQueue&) = delete;
+    CLockFreeConcurrentQueue& operator=(const CLockFreeConcurrentQueue&) = delete;
+    CLockFreeConcurrentQueue(CLockFreeConcurrentQueue&&) = delete;
+    CLockFreeConcurrentQueue& operator=(CLockFreeConcurrentQueue&&) = delete;
+
+    //! Pop an item out of the queue, this blocks until an item is available
+    T pop() {
+        TOptional result;
+        this->wait(m_ConsumerState,
+                   [&] {
+                       result = this->tryPop();
+                       return result != std::nullopt;
+                   },
+                   [this] { return this->size() > 0; });
+        return std::move(*result);
+    }
+
+    //! Pop an item out of the queue, this returns none if an item isn't available
+    //! or the pop isn't allowed
+    template<typename PREDICATE>
+    TOptional tryPop(PREDICATE allowed) {
+        std::uint64_t position{m_DequeuePosition.load(std::memory_order_relaxed)};
+        for (;;) {
+            SCell& cell{this->cell(position)};
+            std::uint64_t sequence{cell.s_Sequence.load(std::memory_order_acquire)};
+            std::int64_t difference{static_cast<std::int64_t>(sequence - (position + 1))};
+            if (difference == 0) {
+                if (cell.s_Sequence.compare_exchange_weak(sequence, RESERVED,
+                                                          std::memory_order_acquire,
+                                                          std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (sequence == RESERVED) {
+                // Another consumer is inspecting the head item.
+                std::this_thread::yield();
+            } else if (difference < 0) {
+                // Empty.
+                return std::nullopt;
+            }
+            position = m_DequeuePosition.load(std::memory_order_relaxed);
+        }
+
+        // We hold the head cell: no one else can consume position until we
+        // release it so m_DequeuePosition must equal position here.
+        SCell& cell{this->cell(position)};
+        if (allowed(*cell.s_Item) == false) {
+            cell.s_Sequence.store(position + 1, std::memory_order_release);
+            return std::nullopt;
+        }
+        TOptional result{std::move(cell.s_Item)};
+        cell.s_Item.reset();
+        m_DequeuePosition.store(position + 1, std::memory_order_relaxed);
+        cell.s_Sequence.store(position + m_QueueCapacity, std::memory_order_release);
+
+        this->notify(m_ProducerState);
+        return result;
+    }
+
+    //! Pop an item out of the queue, this returns none if an item isn't available
+    TOptional tryPop() { return this->tryPop(always); }
+
+    //! Pop an item out of the queue, this blocks for at most \p timeout for an
+    //! item to become available and returns none if one doesn't
+    template<typename REP, typename PERIOD>
+    TOptional tryPopFor(const std::chrono::duration<REP, PERIOD>& timeout) {
+        TOptional result;
+        this->waitUntil(m_ConsumerState, std::chrono::steady_clock::now() + timeout,
+                        [&] {
+                            result = this->tryPop();
+                            return result != std::nullopt;
+                        },
+                        [this] { return this->size() > 0; });
+        return result;
+    }
+
+    //! Push a copy of \p item onto the queue, this blocks if the queue is full which
+    //! means it can deadlock if no one consumes items (implementor's responsibility)
+    void push(const T& item) {
+        this->wait(m_ProducerState, [&] { return this->tryEmplace(item); },
+                   [this] { return this->size() < m_QueueCapacity; });
+    }
+
+    //! Forward \p item to the queue, this blocks if the queue is full which means
+    //! it can deadlock if no one consumes items (implementor's responsibility)
+    void push(T&& item) {
+        this->wait(m_ProducerState, [&] { return this->tryEmplace(std::move(item)); },
+                   [this] { return this->size() < m_QueueCapacity; });
+    }
+
+    //! Forward \p item to the queue, if the queue is full this fails and returns false
+    bool tryPush(T&& item) { return this->tryEmplace(std::move(item)); }
+
+    //! Debug the memory used by this component.
+    void debugMemoryUsage(const CMemoryUsage::TMemoryUsagePtr& mem) const {
+        mem->setName("CLockFreeConcurrentQueue");
+        mem->addItem("m_Cells", this->memoryUsage());
+    }
+
+    //! Get the memory used by this component.
+    std::size_t memoryUsage() const { return m_Cells.capacity() * sizeof(SCell); }
+
+    //! Return the number of items currently in the queue
+    //!
+    //! \note This is only approximate if other threads are accessing the queue.
+    std::size_t size() const {
+        std::uint64_t dequeuePosition{m_DequeuePosition.load(std::memory_order_relaxed)};
+        std::uint64_t enqueuePosition{m_EnqueuePosition.load(std::memory_order_relaxed)};
+        return enqueuePosition > dequeuePosition
+                   ? static_cast<std::size_t>(enqueuePosition - dequeuePosition)
+                   : 0;
+    }
+
+private:
+    //! The sequence number of a cell whose item is being inspected by a consumer.
+    static constexpr std::uint64_t RESERVED{~std::uint64_t{0}};
+    //! The number of times to check the queue before yielding.
+    static constexpr std::size_t SPIN_ITERATIONS{64};
+    //! The number of times to yield before parking.
+    static constexpr std::size_t YIELD_ITERATIONS{16};
+
+    //! \brief A slot in the ring buffer.
+    struct SCell {
+        //! Equal to the position for which the cell can be written if it
+        //! is empty and one more than the position if it is full.
+        std::atomic<std::uint64_t> s_Sequence{0};
+        std::optional<T> s_Item;
+    };
+    using TCellVec = std::vector<SCell>;
+
+    //! \brief The state needed to park threads waiting on the queue.
+    struct SParkingState {
+        std::atomic<std::size_t> s_Parked{0};
+        std::mutex s_Mutex;
+        std::condition_variable s_Condition;
+    };
+
+private:
+    template<typename U>
+    bool tryEmplace(U&& item) {
+        std::uint64_t position{m_EnqueuePosition.load(std::memory_order_relaxed)};
+        for (;;) {
+            SCell& cell{this->cell(position)};
+            std::uint64_t sequence{cell.s_Sequence.load(std::memory_order_acquire)};
+            std::int64_t difference{static_cast<std::int64_t>(sequence - position)};
+            if (difference == 0) {
+                if (m_EnqueuePosition.compare_exchange_weak(position, position + 1,
+                                                            std::memory_order_relaxed)) {
+                    cell.s_Item.emplace(std::forward<U>(item));
+                    cell.s_Sequence.store(position + 1, std::memory_order_release);
+                    this->notify(m_ConsumerState);
+                    return true;
+                }
+            } else if (difference < 0) {
+                // Full, unless the cell is reserved and our position is stale.
+                std::uint64_t current{m_EnqueuePosition.load(std::memory_order_relaxed)};
+                if (sequence != RESERVED || current == position) {
+                    return false;
+                }
+                position = current;
+            } else {
+                position = m_EnqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    SCell& cell(std::uint64_t position) {
+        return m_Cells[static_cast<std::size_t>(position % m_QueueCapacity)];
+    }
+
+    //! Repeat \p attempt until it succeeds spinning, then yielding, then parking
+    //! until \p ready.
+    //!
+    //! \note The attempt is never made holding the mutex since it can notify
+    //! threads parked on the other state.
+    template<typename ATTEMPT, typename READY>
+    void wait(SParkingState& state, ATTEMPT attempt, READY ready) {
+        while (spin(attempt) == false) {
+            std::unique_lock<std::mutex> lock{state.s_Mutex};
+            ++state.s_Parked;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            state.s_Condition.wait(lock, ready);
+            --state.s_Parked;
+        }
+    }
+
+    //! Repeat \p attempt until it succeeds or \p deadline passes.
+    template<typename TIME_POINT, typename ATTEMPT, typename READY>
+    bool waitUntil(SParkingState& state, const TIME_POINT& deadline, ATTEMPT attempt, READY ready) {
+        while (spin(attempt) == false) {
+            std::unique_lock<std::mutex> lock{state.s_Mutex};
+            ++state.s_Parked;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool timedOut{state.s_Condition.wait_until(lock, deadline, ready) == false};
+            --state.s_Parked;
+            if (timedOut) {
+                lock.unlock();
+                return attempt();
+            }
+        }
+        return true;
+    }
+
+    template<typename ATTEMPT>
+    static bool spin(ATTEMPT& attempt) {
+        for (std::size_t i = 0; i < SPIN_ITERATIONS; ++i) {
+            if (attempt()) {
+                return true;
+            }
+        }
+        for (std::size_t i = 0; i < YIELD_ITERATIONS; ++i) {
+            std::this_thread::yield();
+            if (attempt()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //! Wake any threads parked on \p state.
+    static void notify(SParkingState& state) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (state.s_Parked.load(std::memory_order_relaxed) > 0) {
+            // Taking the lock ensures a thread which has just parked is
+            // waiting on the condition and so is woken.
+            std::unique_lock<std::mutex> lock{state.s_Mutex};
+            lock.unlock();
+            state.s_Condition.notify_all();
+        }
+    }
+
+    static bool always(const T&) { return true; }
+
+private:
+    //! Fixed queue capacity
+    std::size_t m_QueueCapacity;
+
+    //! The ring buffer
+    TCellVec m_Cells;
+
+    //! The position of the next item to push
+    alignas(64) std::atomic<std::uint64_t> m_EnqueuePosition{0};
+
+    //! The position of the next item to pop
+    alignas(64) std::atomic<std::uint64_t> m_DequeuePosition{0};
+
+    //! For parking consumers
+    alignas(64) SParkingState m_ConsumerState;
+
+    //! For parking producers
+    alignas(64) SParkingState m_ProducerState;
+};
+}
+}
+
+#endif // INCLUDED_ml_core_CLockFreeConcurrentQueue_h
@@ -0,0 +1,139 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#ifndef INCLUDED_ml_core_CMonotonicArena_h
+#define INCLUDED_ml_core_CMonotonicArena_h
+
+#include <core/CNonCopyable.h>
+#include <core/ImportExport.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ml {
+namespace core {
+
+//! \brief A memory arena which only ever grows until it is released.
+//!
+//! DESCRIPTION:\n
+//! Allocations are carved sequentially out of large blocks and individual
+//! deallocations are ignored. All the memory is returned in one go when the
+//! arena is released or destroyed. This suits collections of short-lived
+//! objects which are built up and then discarded together, when allocating
+//! and freeing each object on the heap would dominate the cost of using them.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! The block size doubles, up to a maximum, each time a new block is needed
+//! so the number of blocks is logarithmic in the total memory requested.
+//! Requests larger than the current block size get a block of their own.
+//!
+//! This class is not thread safe. Each arena should be used by one thread
+//! at a time.
+class CORE_EXPORT CMonotonicArena : private CNonCopyable {
+public:
+    //! The default size of the first block.
+    static constexpr std::size_t DEFAULT_INITIAL_BLOCK_SIZE{4096};
+    //! The maximum size to which the block size grows.
+    static constexpr std::size_t MAXIMUM_BLOCK_SIZE{1048576};
+
+public:
+    explicit CMonotonicArena(std::size_t initialBlockSize = DEFAULT_INITIAL_BLOCK_SIZE);
+
+    //! Get \p bytes of memory aligned to \p alignment.
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    //! Free all the memory allocated by the arena.
+    //!
+    //! \warning Any objects created in the arena must have been destroyed.
+    void release();
+
+    //! Get the total number of bytes in blocks held by the arena.
+    std::size_t capacity() const;
+
+    //! Get the memory used by this object.
+    std::size_t memoryUsage() const;
+
+private:
+    using TByteArrayPtr = std::unique_ptr<unsigned char[]>;
+    using TByteArrayPtrVec = std::vector<TByteArrayPtr>;
+
+private:
+    //! Add a block with space for at least \p bytes.
+    void newBlock(std::size_t bytes);
+
+private:
+    //! The size of the first block.
+    std::size_t m_InitialBlockSize;
+    //! The size of the next block to allocate.
+    std::size_t m_NextBlockSize;
+    //! The total size of the blocks.
+    std::size_t m_Capacity{0};
+    //! The blocks.
+    TByteArrayPtrVec m_Blocks;
+    //! The start of the free space in the current block.
+    void* m_Free{nullptr};
+    //! The number of free bytes in the current block.
+    std::size_t m_FreeBytes{0};
+};
+
+//! \brief A standard library allocator which uses a CMonotonicArena.
+//!
+//! DESCRIPTION:\n
+//! Containers using this allocator take their memory from the arena and
+//! their deallocations are no-ops. The arena must outlive all containers
+//! which use it. Allocators compare equal only if they use the same arena
+//! and they are not propagated, so moving or swapping elements between
+//! containers using different arenas copies them.
+template<typename T>
+class CMonotonicArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+
+    template<typename U>
+    struct rebind {
+        using other = CMonotonicArenaAllocator<U>;
+    };
+
+public:
+    explicit CMonotonicArenaAllocator(CMonotonicArena& arena) : m_Arena{&arena} {}
+
+    template<typename U>
+    CMonotonicArenaAllocator(const CMonotonicArenaAllocator<U>& other)
+        : m_Arena{other.arena()} {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(m_Arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) {}
+
+    CMonotonicArena* arena() const { return m_Arena; }
+
+    template<typename U>
+    bool operator==(const CMonotonicArenaAllocator<U>& rhs) const {
+        return m_Arena == rhs.arena();
+    }
+    template<typename U>
+    bool operator!=(const CMonotonicArenaAllocator<U>& rhs) const {
+        return m_Arena != rhs.arena();
+    }
+
+private:
+    CMonotonicArena* m_Arena;
+};
+}
+}
+
+#endif // INCLUDED_ml_core_CMonotonicArena_h
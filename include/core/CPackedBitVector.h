@@ -53,6 +53,10 @@ namespace core {
 //! In practice we store one extra bit, the vector parity to allow us to extend the
 //! vector efficiently.
 //!
+//! Norms only need to scan the runs of one vector and bitwise operations and inner
+//! products with a vector comprising a single run, such as an all ones mask, are
+//! computed without a line scan.
+//!
 //! \warning Since it allows a more efficient implementation and covers our use cases
 //! this only supports vectors up to length 2^30.
 // clang-format off
@@ -236,6 +240,15 @@ protected:
     static std::size_t popRunLength(TUInt8VecCItr& runLengthBytes);
     static void writeRunLength(std::size_t runLength, TUInt8VecItr runLengthBytes);
 
+private:
+    //! Check if all the components of this vector are equal.
+    bool isConstant() const {
+        return m_RunLengthBytes.size() == static_cast<std::size_t>(m_LastRunBytes);
+    }
+
+    //! Count the one bits in this vector.
+    std::size_t countOneBits() const;
+
 private:
     //! The dimension of the vector.
     std::size_t m_Dimension = 0;
@@ -16,6 +16,8 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <iosfwd>
 #include <set>
@@ -29,6 +31,7 @@ struct testUnknownCounter;
 struct testMissingCounter;
 struct testCacheCounters;
 struct testPersist;
+struct testHistograms;
 }
 
 namespace ml {
@@ -112,6 +115,15 @@ enum ECounterTypes {
     //! The memory currently used by the allocators to output JSON documents, in bytes.
     E_TSADOutputMemoryAllocatorUsage = 30,
 
+    //! The number of seasonality tests run on time series decompositions
+    E_TSADNumberSeasonalityTests = 33,
+
+    //! The number of calendar tests run on time series decompositions
+    E_TSADNumberCalendarTests = 34,
+
+    //! The number of change point tests run on time series decompositions
+    E_TSADNumberChangePointTests = 35,
+
     // Data Frame Outlier Detection
 
     //! The estimated peak memory usage for outlier detection in bytes
@@ -143,15 +155,60 @@ enum ECounterTypes {
     //! The trained forest total number of trees
     E_DFTPMTrainedForestNumberTrees = 27,
 
+    //! The time in ms to encode, select features and initialise hyperparameters
+    E_DFTPMTimeToPrepare = 36,
+
+    //! The time in ms spent in the hyperparameter optimisation loop
+    E_DFTPMTimeToTuneHyperparameters = 37,
+
+    //! The time in ms to train the final forest on all the training data
+    E_DFTPMTimeToTrainFinalForest = 38,
+
+    //! The time in ms to compute predictions
+    E_DFTPMTimeToPredict = 39,
+
+    // Thread Pool
+
+    //! The number of tasks thread pool workers took from other workers
+    E_TPNumberTasksStolen = 31,
+
+    //! The number of times a thread pool worker found no work and waited
+    E_TPNumberIdleWaits = 32,
+
     // Add any new values here
 
     //! This MUST be last, increment the value for every new enum added
-    E_LastEnumCounter = 31
+    E_LastEnumCounter = 40
 };
 
 static constexpr std::size_t NUM_COUNTERS = static_cast<std::size_t>(E_LastEnumCounter);
 
 using TCounterTypeSet = std::set<ECounterTypes>;
+
+//! The same rules apply as for ECounterTypes. Times are in microseconds.
+//! Don't forget to also add a description of the new enum value to m_HistogramDefinitions.
+enum EHistogramTypes {
+    // Time Series Anomaly Detection
+
+    //! The time to handle each input record
+    E_TSADHandleRecordTime = 0,
+
+    //! The time to output the results for each bucket
+    E_TSADOutputResultsTime = 1,
+
+    //! The time to normalize the results for each bucket
+    E_TSADNormalizeResultsTime = 2,
+
+    //! The time to persist the model state
+    E_TSADPersistStateTime = 3,
+
+    // Add any new values here
+
+    //! This MUST be last, increment the value for every new enum added
+    E_LastEnumHistogram = 4
+};
+
+static constexpr std::size_t NUM_HISTOGRAMS = static_cast<std::size_t>(E_LastEnumHistogram);
 }
 
 namespace core {
@@ -165,6 +222,12 @@ struct SCounterDefinition {
     std::string s_Description;
 };
 
+struct SHistogramDefinition {
+    counter_t::EHistogramTypes s_Type;
+    std::string s_Name;
+    std::string s_Description;
+};
+
 //! \brief
 //! A collection of runtime global counters
 //!
@@ -183,6 +246,10 @@ struct SCounterDefinition {
 //! used in separate applications, e.g. \c TSAD is used for the Time Series Anomaly Detection
 //! counters.
 //!
+//! There is also a collection of histograms, for example of operation latencies,
+//! which are added to the counters output as their count and percentiles. These
+//! describe the current process so they aren't persisted.
+//!
 //! IMPLEMENTATION DECISIONS:\n
 //! A singleton class: there should only be one collection of global counters
 //!
@@ -195,6 +262,69 @@ public:
         ~CCacheManager();
     };
 
+    //! \brief
+    //! A lock free histogram of non-negative integer values.
+    //!
+    //! DESCRIPTION:\n
+    //! Values less than 2^SUB_BUCKET_BITS have their own bucket. Larger values
+    //! are bucketed by their most significant SUB_BUCKET_BITS + 1 bits, in the
+    //! style of an HDR histogram, so percentiles have a relative error of at
+    //! most 2^-SUB_BUCKET_BITS for any value.
+    //!
+    //! IMPLEMENTATION DECISIONS:\n
+    //! Each bucket is a relaxed atomic so adding a value is wait free and
+    //! can be done concurrently from any thread. Reading percentiles while
+    //! values are being added gives an approximate snapshot.
+    class CORE_EXPORT CHistogram {
+    public:
+        static constexpr std::size_t SUB_BUCKET_BITS{4};
+        static constexpr std::size_t SUB_BUCKETS{std::size_t{1} << SUB_BUCKET_BITS};
+        static constexpr std::size_t NUM_BUCKETS{SUB_BUCKETS * (64 - SUB_BUCKET_BITS + 1)};
+
+    public:
+        //! Add \p value.
+        void add(std::uint64_t value);
+
+        //! Get the number of values added.
+        std::uint64_t count() const;
+
+        //! Get the largest value added.
+        std::uint64_t max() const;
+
+        //! Get an upper bound for the \p percentile'th percentile of the values
+        //! added, where \p percentile is in the range [0, 100].
+        std::uint64_t percentile(double percentile) const;
+
+        //! Remove all values.
+        void clear();
+
+        //! Get the bucket of \p value.
+        static std::size_t bucket(std::uint64_t value);
+
+        //! Get the smallest value in \p bucket.
+        static std::uint64_t bucketLowerBound(std::size_t bucket);
+
+    private:
+        using TAtomicUInt64Array = std::array<std::atomic_uint_fast64_t, NUM_BUCKETS>;
+
+    private:
+        TAtomicUInt64Array m_Counts{};
+        std::atomic_uint_fast64_t m_Max{0};
+    };
+
+    //! \brief
+    //! Adds the time in microseconds between its construction and destruction
+    //! to a histogram.
+    class CORE_EXPORT CScopedHistogramTimer : private CNonCopyable {
+    public:
+        explicit CScopedHistogramTimer(counter_t::EHistogramTypes histogramType);
+        ~CScopedHistogramTimer();
+
+    private:
+        CHistogram& m_Histogram;
+        std::chrono::steady_clock::time_point m_Start;
+    };
+
 private:
     //! \brief
     //! An atomic counter object
@@ -260,6 +390,9 @@ private:
     using TCounter = CCounter;
     using TCounterArray = std::array<TCounter, counter_t::NUM_COUNTERS>;
     using TCounterDefinitionArray = std::array<SCounterDefinition, counter_t::NUM_COUNTERS>;
+    using THistogramArray = std::array<CHistogram, counter_t::NUM_HISTOGRAMS>;
+    using THistogramDefinitionArray =
+        std::array<SHistogramDefinition, counter_t::NUM_HISTOGRAMS>;
     using TUInt64Vec = std::vector<std::uint64_t>;
 
 public:
@@ -271,6 +404,9 @@ public:
     static TCounter& counter(counter_t::ECounterTypes counterType);
     static TCounter& counter(std::size_t index);
 
+    //! Provide access to the relevant histogram from the collection
+    static CHistogram& histogram(counter_t::EHistogramTypes histogramType);
+
     //! Copy the collection of live counters to a cache
     static void cacheCounters();
 
@@ -303,6 +439,9 @@ private:
     //! Collection of counters
     TCounterArray m_Counters;
 
+    //! Collection of histograms
+    THistogramArray m_Histograms;
+
     //! A dummy counter used if ever an attempt is made to restore an unknown counter type
     TCounter m_DummyCounter;
 
@@ -370,7 +509,36 @@ private:
           "The peak memory training the predictive model used"},
          {counter_t::E_DFTPMTimeToTrain, "E_DFTPMTimeToTrain", "The time it took to train the predictive model"},
          {counter_t::E_DFTPMTrainedForestNumberTrees, "E_DFTPMTrainedForestNumberTrees",
-          "The total number of trees in the trained forest"}}};
+          "The total number of trees in the trained forest"},
+         {counter_t::E_DFTPMTimeToPrepare, "E_DFTPMTimeToPrepare",
+          "The time it took to encode, select features and initialise hyperparameters"},
+         {counter_t::E_DFTPMTimeToTuneHyperparameters, "E_DFTPMTimeToTuneHyperparameters",
+          "The time it took to optimise hyperparameters"},
+         {counter_t::E_DFTPMTimeToTrainFinalForest, "E_DFTPMTimeToTrainFinalForest",
+          "The time it took to train the final forest"},
+         {counter_t::E_DFTPMTimeToPredict, "E_DFTPMTimeToPredict",
+          "The time it took to compute predictions"},
+         {counter_t::E_TPNumberTasksStolen, "E_TPNumberTasksStolen",
+          "The number of tasks thread pool workers took from other workers"},
+         {counter_t::E_TPNumberIdleWaits, "E_TPNumberIdleWaits",
+          "The number of times a thread pool worker found no work and waited"},
+         {counter_t::E_TSADNumberSeasonalityTests, "E_TSADNumberSeasonalityTests",
+          "The number of seasonality tests run on time series decompositions"},
+         {counter_t::E_TSADNumberCalendarTests, "E_TSADNumberCalendarTests",
+          "The number of calendar tests run on time series decompositions"},
+         {counter_t::E_TSADNumberChangePointTests, "E_TSADNumberChangePointTests",
+          "The number of change point tests run on time series decompositions"}}};
+
+    //! Descriptions of the histograms. For use when printing the values.
+    THistogramDefinitionArray m_HistogramDefinitions{
+        {{counter_t::E_TSADHandleRecordTime, "E_TSADHandleRecordTime",
+          "The time in microseconds to handle each input record"},
+         {counter_t::E_TSADOutputResultsTime, "E_TSADOutputResultsTime",
+          "The time in microseconds to output the results for each bucket"},
+         {counter_t::E_TSADNormalizeResultsTime, "E_TSADNormalizeResultsTime",
+          "The time in microseconds to normalize the results for each bucket"},
+         {counter_t::E_TSADPersistStateTime, "E_TSADPersistStateTime",
+          "The time in microseconds to persist the model state"}}};
 
     //! Enabling printing out the current counters.
     friend CORE_EXPORT std::ostream& operator<<(std::ostream& o,
@@ -384,6 +552,7 @@ private:
     friend struct CProgramCountersTest::testMissingCounter;
     friend struct CProgramCountersTest::testCacheCounters;
     friend struct CProgramCountersTest::testPersist;
+    friend struct CProgramCountersTest::testHistograms;
 };
 
 } // core
@@ -11,12 +11,14 @@
 #ifndef INCLUDED_ml_core_CStatePersistInserter_h
 #define INCLUDED_ml_core_CStatePersistInserter_h
 
+#include <core/CFloatStorage.h>
 #include <core/CNonCopyable.h>
 #include <core/CStringUtils.h>
 #include <core/ImportExport.h>
 
 #include <ostream>
 #include <string>
+#include <vector>
 
 namespace ml {
 namespace core {
@@ -116,6 +118,9 @@ using TPersistenceTag = CPersistenceTag;
 //! All values are stored as strings.
 //!
 class CORE_EXPORT CStatePersistInserter : private CNonCopyable {
+public:
+    using TFloatStorageVec = std::vector<CFloatStorage>;
+
 public:
     //! Virtual destructor for abstract class
     virtual ~CStatePersistInserter();
@@ -142,7 +147,12 @@ public:
     }
 
     //! Store a floating point number with a given level of precision
-    void insertValue(const std::string& name, double value, CIEEE754::EPrecision precision);
+    //!
+    //! \note By default this is converted to a string, but formats which can
+    //! represent floating point numbers directly should override this.
+    virtual void insertValue(const std::string& name,
+                             double value,
+                             CIEEE754::EPrecision precision);
 
     //! Store a floating point number with a given level of precision
     //! with choice of tag format
@@ -150,6 +160,19 @@ public:
         this->insertValue(name.name(this->readableTags()), value, precision);
     }
 
+    //! Store a collection of single precision floating point numbers
+    //!
+    //! \note By default this is converted to a delimited string, which can
+    //! be restored with CPersistUtils::fromString, but formats which can
+    //! represent floating point numbers directly should override this.
+    virtual void insertValue(const std::string& name, const TFloatStorageVec& values);
+
+    //! Store a collection of single precision floating point numbers
+    //! with choice of tag format
+    void insertValue(const TPersistenceTag& name, const TFloatStorageVec& values) {
+        this->insertValue(name.name(this->readableTags()), values);
+    }
+
     //! Store a nested level of state, to be populated by the supplied
     //! function or function object
     template<typename FUNC>
@@ -11,12 +11,15 @@
 #ifndef INCLUDED_ml_core_CStateRestoreTraverser_h
 #define INCLUDED_ml_core_CStateRestoreTraverser_h
 
+#include <core/CFloatStorage.h>
 #include <core/CLogger.h>
+#include <core/CStringUtils.h>
 
 #include <core/ImportExport.h>
 
 #include <exception>
 #include <string>
+#include <vector>
 
 namespace ml {
 namespace core {
@@ -40,9 +43,14 @@ namespace core {
 //! that the next() method returns false when the end of a particular
 //! sub-level is reached.
 //!
-//! All values are returned as strings.
+//! All values are available as strings. Formats which store floating
+//! point numbers directly can also return them without formatting them
+//! as strings, see doubleValue and floatValues.
 //!
 class CORE_EXPORT CStateRestoreTraverser {
+public:
+    using TFloatStorageVec = std::vector<CFloatStorage>;
+
 public:
     CStateRestoreTraverser();
 
@@ -91,6 +99,32 @@ public:
     //! element
     virtual const std::string& value() const = 0;
 
+    //! Get the value of the current element as a collection of single
+    //! precision floating point numbers, as stored by the corresponding
+    //! CStatePersistInserter::insertValue overload.
+    //!
+    //! \note By default this parses value(), but formats which can represent
+    //! floating point numbers directly should override this.
+    virtual bool floatValues(TFloatStorageVec& result) const;
+
+    //! Get the value of the current element as a double precision floating
+    //! point number, as stored by the corresponding insertValue overload.
+    //!
+    //! \note By default this parses value(), but formats which can represent
+    //! floating point numbers directly should override this.
+    virtual bool doubleValue(double& result) const;
+
+    //! Convert the value of the current element to the built in type \p result.
+    template<typename T>
+    bool builtInValue(T& result) const {
+        return CStringUtils::stringToType(this->value(), result);
+    }
+
+    //! Get a double value without a string conversion if the format allows.
+    bool builtInValue(double& result) const {
+        return this->doubleValue(result);
+    }
+
     //! Has the end of the inputstream been reached?
     virtual bool isEof() const = 0;
 
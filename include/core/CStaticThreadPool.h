@@ -12,13 +12,16 @@
 #define INCLUDED_ml_core_CStaticThreadPool_h
 
 #include <core/CConcurrentQueue.h>
+#include <core/CWorkStealingDeque.h>
 #include <core/Concurrency.h>
 #include <core/ImportExport.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <thread>
 #include <vector>
@@ -32,12 +35,23 @@ namespace core {
 //! This purposely has very limited interface and is intended to mainly support
 //! CThreadPoolExecutor which provides the mechanism by which we expose the thread
 //! pool to the rest of the code via calls core::async.
+//!
+//! In work stealing mode each worker also owns a lock-free deque. Tasks which are
+//! scheduled from a worker are pushed onto its deque, it pops them in LIFO order
+//! and idle workers steal them from the other end. Tasks scheduled from outside
+//! the pool still go round-robin into the bounded queues so we retain the back
+//! pressure on producers. Rather than blocking on its own queue an idle worker
+//! sleeps until a task is pushed onto any queue or deque and then looks for work
+//! to steal. The number of steals and idle waits are recorded in CProgramCounters.
 class CORE_EXPORT CStaticThreadPool {
 public:
     using TTask = std::function<void()>;
+    using EScheduling = CExecutor::EScheduling;
 
 public:
-    explicit CStaticThreadPool(std::size_t size, std::size_t queueCapacity = 50);
+    explicit CStaticThreadPool(std::size_t size,
+                               std::size_t queueCapacity = 50,
+                               EScheduling scheduling = CExecutor::E_RoundRobin);
 
     ~CStaticThreadPool();
 
@@ -69,6 +83,9 @@ public:
     //! Check if the thread pool has been marked as busy.
     void busy(bool busy);
 
+    //! Get the strategy used to distribute tasks between threads.
+    EScheduling scheduling() const;
+
 private:
     using TOptionalSize = std::optional<std::size_t>;
     class CWrappedTask {
@@ -86,12 +103,20 @@ private:
     using TWrappedTaskQueue = CConcurrentQueue<CWrappedTask>;
     using TWrappedTaskQueueUPtr = std::unique_ptr<TWrappedTaskQueue>;
     using TWrappedTaskQueueUPtrVec = std::vector<TWrappedTaskQueueUPtr>;
+    using TWrappedTaskDeque = CWorkStealingDeque<CWrappedTask*>;
+    using TWrappedTaskDequeUPtr = std::unique_ptr<TWrappedTaskDeque>;
+    using TWrappedTaskDequeUPtrVec = std::vector<TWrappedTaskDequeUPtr>;
     using TThreadVec = std::vector<std::thread>;
 
 private:
     void shutdown();
     void worker(std::size_t id);
+    TOptionalTask findWork(std::size_t id, std::size_t size);
+    TOptionalTask waitForWork(std::size_t id);
+    TOptionalTask popFromDeque(std::size_t id, bool steal);
     void drainQueuesWithoutBlocking();
+    void drainDeques();
+    void notifyIdleWorkers();
 
 private:
     // This doesn't have to be atomic because it is always only set to true,
@@ -101,8 +126,18 @@ private:
     std::atomic_bool m_Busy;
     std::atomic<std::uint64_t> m_Cursor;
     std::atomic<std::size_t> m_NumberThreadsInUse;
+    EScheduling m_Scheduling;
     TWrappedTaskQueueUPtrVec m_TaskQueues;
+    TWrappedTaskDequeUPtrVec m_TaskDeques;
     TThreadVec m_Pool;
+
+    // Idle work stealing workers wait for m_WorkEpoch to change. It is only
+    // changed when m_NumberIdleWorkers is nonzero so scheduling tasks doesn't
+    // contend on m_IdleMutex while every worker is busy.
+    std::atomic<std::size_t> m_NumberIdleWorkers{0};
+    std::uint64_t m_WorkEpoch{0};
+    std::mutex m_IdleMutex;
+    std::condition_variable m_WorkAvailable;
 };
 }
 }
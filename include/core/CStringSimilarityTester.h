@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <sstream>
 #include <string>
 
@@ -211,6 +212,17 @@ public:
     //! from section 2 of Ukkonen's paper to this algorithm.
     template<typename PAIRCONTAINER>
     size_t weightedEditDistance(const PAIRCONTAINER& first, const PAIRCONTAINER& second) const {
+        return this->weightedEditDistance(first, second,
+                                          std::numeric_limits<size_t>::max());
+    }
+
+    //! As above, but stop as soon as the distance is known to be greater
+    //! than \p maxDistance.  In this case the value returned is greater
+    //! than \p maxDistance but is not necessarily the distance.
+    template<typename PAIRCONTAINER>
+    size_t weightedEditDistance(const PAIRCONTAINER& first,
+                                const PAIRCONTAINER& second,
+                                size_t maxDistance) const {
         // This is similar to the levenshteinDistanceSimple() method below,
         // but adding the concept of different costs for each element.  If
         // you are trying to understand this method, you should first make
@@ -237,12 +249,13 @@ public:
             return cost;
         }
 
-        // We need to store two columns of the matrix, but allocate both in
-        // one go for efficiency.  Then the current and previous column
-        // pointers alternate between pointing and the first and second half
-        // of the memory block.
-        TScopedSizeArray data(new size_t[(secondLen + 1) * 2]);
-        size_t* currentCol(data.get());
+        // We need to store two columns of the matrix.  This is called for
+        // every candidate category of every message categorised, so both
+        // live in a per-thread workspace rather than being allocated each
+        // time.  Then the current and previous column pointers alternate
+        // between pointing and the first and second half of the memory
+        // block.
+        size_t* currentCol(weightedEditDistanceWorkspace((secondLen + 1) * 2));
         size_t* prevCol(currentCol + (secondLen + 1));
 
         // Populate the left column
@@ -257,6 +270,7 @@ public:
             std::swap(currentCol, prevCol);
             size_t firstCost(first[acrossMinusOne].second);
             currentCol[0] = prevCol[0] + firstCost;
+            size_t minInCol(currentCol[0]);
 
             for (size_t downMinusOne = 0; downMinusOne < secondLen; ++downMinusOne) {
                 size_t secondCost(second[downMinusOne].second);
@@ -285,6 +299,13 @@ public:
 
                 // Take the cheapest option of the 3
                 currentCol[downMinusOne + 1] = std::min(std::min(option1, option2), option3);
+                minInCol = std::min(minInCol, currentCol[downMinusOne + 1]);
+            }
+
+            // Costs are non-negative so every path to the bottom right hand
+            // corner costs at least the minimum of each column it crosses
+            if (minInCol > maxDistance) {
+                return minInCol;
             }
         }
 
@@ -299,6 +320,9 @@ public:
     std::size_t memoryUsage() const;
 
 private:
+    //! Get a per-thread workspace with space for at least \p size values.
+    static size_t* weightedEditDistanceWorkspace(size_t size);
+
     //! Calculate the Levenshtein distance using the naive method of
     //! calculating the entire distance matrix.  This private method
     //! assumes that first.size() > 0 and second.size() > 0.  However,
@@ -16,6 +16,7 @@
 #include <core/ImportExport.h>
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ml {
@@ -68,9 +69,20 @@ public:
         return CStringUtils::_typeToString(type);
     }
 
+    //! The size of buffer needed to convert a double with typeToStringPrecise.
+    static constexpr std::size_t PRECISE_DOUBLE_BUFFER_SIZE{4 * sizeof(double)};
+
     //! Convert a double to a string with the specified precision
     static std::string typeToStringPrecise(double d, CIEEE754::EPrecision precision);
 
+    //! Convert a double to a string with the specified precision writing it to
+    //! \p buffer, which must hold PRECISE_DOUBLE_BUFFER_SIZE characters.
+    //!
+    //! \return The number of characters written excluding the null terminator.
+    //! \note This avoids a heap allocation when writing many values.
+    static std::size_t
+    typeToStringPrecise(double d, CIEEE754::EPrecision precision, char* buffer);
+
     //! For types other than double, default conversions are precise
     template<typename T>
     static std::string typeToStringPrecise(const T& type, CIEEE754::EPrecision /*precision*/) {
@@ -90,6 +102,20 @@ public:
         return CStringUtils::_stringToType(true, str, ret);
     }
 
+    //! Convert part of a string to a double.
+    //!
+    //! \note This doesn't allocate when \p str is a plain decimal number,
+    //! which means it's preferable to taking a substring.
+    static bool stringToType(std::string_view str, double& ret) {
+        return CStringUtils::_stringToType(false, str, ret);
+    }
+
+    //! Convert part of a string to a double, and don't print an error
+    //! message if the conversion fails.
+    static bool stringToTypeSilent(std::string_view str, double& ret) {
+        return CStringUtils::_stringToType(true, str, ret);
+    }
+
     //! Convert a string representation of a memory size (in ES format e.g. "4gb") to a whole number
     //! of bytes. Returns a default value if any error occurs, however the assumption is that the input string
     //! has already been validated by ES.
@@ -245,6 +271,7 @@ private:
     //! There's a function for double, but not float as we want to
     //! discourage the use of float.
     static bool _stringToType(bool silent, const std::string&, double&);
+    static bool _stringToType(bool silent, std::string_view, double&);
 
     static bool _stringToType(bool silent, const std::string&, char&);
 
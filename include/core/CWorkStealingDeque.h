@@ -0,0 +1,172 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#ifndef INCLUDED_ml_core_CWorkStealingDeque_h
+#define INCLUDED_ml_core_CWorkStealingDeque_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace ml {
+namespace core {
+
+//! \brief A bounded lock-free single producer multiple consumer deque.
+//!
+//! DESCRIPTION:\n
+//! This is the deque of Chase and Lev as described in "Correct and Efficient
+//! Work-Stealing for Weak Memory Models", Lê et al. The owning thread pushes
+//! and pops at the bottom of the deque and any other thread can steal from the
+//! top of the deque.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! The deque has fixed capacity and a push fails if it is full. This avoids the
+//! complexity of safely reclaiming buffers when growing. Callers are expected to
+//! fall back to some other mechanism, such as a blocking queue, in this case.
+//!
+//! The values are read and written atomically, which avoids a data race between
+//! a thief reading the top value and the owner overwriting it, so the value type
+//! must be trivially copyable. The typical usage is to store pointers.
+//!
+//! \warning Only the thread which owns the deque is allowed to call push and pop.
+//!
+//! @tparam T The type of the values in the deque. This must be trivially copyable.
+template<typename T>
+class CWorkStealingDeque final {
+public:
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "CWorkStealingDeque value type must be trivially copyable");
+
+    using TOptional = std::optional<T>;
+
+public:
+    //! \param[in] capacity The maximum number of values the deque can hold. This
+    //! is rounded up to the next power of two.
+    explicit CWorkStealingDeque(std::size_t capacity)
+        : m_Mask{roundUpToPowerOfTwo(capacity) - 1}, m_Buffer(m_Mask + 1) {}
+
+    CWorkStealingDeque(const CWorkStealingDeque&) = delete;
+    CWorkStealingDeque& operator=(const CWorkStealingDeque&) = delete;
+    CWorkStealingDeque(CWorkStealingDeque&&) = delete;
+    CWorkStealingDeque& operator=(CWorkStealingDeque&&) = delete;
+
+    //! Add \p value to the bottom of the deque.
+    //!
+    //! \return False if the deque is full.
+    //! \note This must only be called by the owning thread.
+    bool tryPush(T value) {
+        std::int64_t bottom{m_Bottom.load(std::memory_order_relaxed)};
+        std::int64_t top{m_Top.load(std::memory_order_acquire)};
+        if (bottom - top > static_cast<std::int64_t>(m_Mask)) {
+            return false;
+        }
+        m_Buffer[this->index(bottom)].store(value, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    //! Remove the value from the bottom of the deque if there is one.
+    //!
+    //! \note This must only be called by the owning thread.
+    TOptional tryPop() {
+        std::int64_t bottom{m_Bottom.load(std::memory_order_relaxed) - 1};
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top{m_Top.load(std::memory_order_relaxed)};
+
+        if (top > bottom) {
+            // Empty.
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        TOptional result{m_Buffer[this->index(bottom)].load(std::memory_order_relaxed)};
+        if (top == bottom) {
+            // This is the last value so we race any thieves for it.
+            if (m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed) == false) {
+                result = std::nullopt;
+            }
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    //! Remove the value from the top of the deque if there is one.
+    //!
+    //! \note This can be called by any thread. It can spuriously fail if it
+    //! loses a race with another thread for the top value.
+    TOptional trySteal() {
+        std::int64_t top{m_Top.load(std::memory_order_acquire)};
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t bottom{m_Bottom.load(std::memory_order_acquire)};
+
+        if (top >= bottom) {
+            return std::nullopt;
+        }
+
+        T result{m_Buffer[this->index(top)].load(std::memory_order_acquire)};
+        if (m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed) == false) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    //! Get the number of values in the deque.
+    //!
+    //! \note This is only approximate if other threads are accessing the deque.
+    std::size_t size() const {
+        std::int64_t bottom{m_Bottom.load(std::memory_order_relaxed)};
+        std::int64_t top{m_Top.load(std::memory_order_relaxed)};
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+    //! Get the maximum number of values the deque can hold.
+    std::size_t capacity() const { return m_Mask + 1; }
+
+private:
+    using TAtomicVec = std::vector<std::atomic<T>>;
+
+private:
+    static std::size_t roundUpToPowerOfTwo(std::size_t capacity) {
+        std::size_t result{1};
+        while (result < capacity) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    std::size_t index(std::int64_t position) const {
+        return static_cast<std::size_t>(position) & m_Mask;
+    }
+
+private:
+    //! The mask to convert a position to an index in the buffer.
+    std::size_t m_Mask;
+
+    //! The position of the next value to steal.
+    alignas(64) std::atomic<std::int64_t> m_Top{0};
+
+    //! The position of the next value to push.
+    alignas(64) std::atomic<std::int64_t> m_Bottom{0};
+
+    //! The value storage.
+    TAtomicVec m_Buffer;
+};
+}
+}
+
+#endif // INCLUDED_ml_core_CWorkStealingDeque_h
@@ -17,8 +17,11 @@
 #include <core/ImportExport.h>
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <future>
+#include <iterator>
+#include <optional>
 #include <thread>
 #include <type_traits>
 #include <vector>
@@ -74,6 +77,16 @@ auto bindRetrievableState(FUNCTION&& function, STATE&& state) {
 
 //! \brief The base executor hierarchy.
 class CExecutor {
+public:
+    //! The strategies for distributing tasks between threads.
+    //!
+    //! E_RoundRobin spreads tasks over per thread queues in turn and idle
+    //! threads only pull from other queues until they block. E_WorkStealing
+    //! additionally gives each thread a lock-free deque for the tasks it
+    //! schedules itself from which idle threads steal and is used to load
+    //! balance parallel_for_each dynamically.
+    enum EScheduling { E_RoundRobin, E_WorkStealing };
+
 public:
     virtual ~CExecutor() = default;
     virtual void schedule(std::function<void()>&& f) = 0;
@@ -81,6 +94,7 @@ public:
     virtual void busy(bool value) = 0;
     virtual std::size_t numberThreadsInUse() const = 0;
     virtual void numberThreadsInUse(std::size_t threads) = 0;
+    virtual EScheduling scheduling() const = 0;
 };
 
 //! Setup the global default executor for async.
@@ -96,13 +110,18 @@ public:
 //! \p fallbackThreadPoolSize is the size of the thread pool to use if
 //! std::thread::hardware_concurrency returns zero (which is possible on
 //! some platforms).
+//! \p scheduling is the strategy used to distribute tasks between threads.
+//! Note that with work stealing parallel_for_each no longer assigns a fixed
+//! set of indices to each function so any state the functions accumulate in
+//! floating point can differ in the low order bits between runs.
 //!
 //! \note This is not thread safe as the intention is that it is invoked once,
 //! usually at the beginning of main or in single threaded test code.
 CORE_EXPORT
 void startDefaultAsyncExecutor(std::size_t threadPoolSize = 0,
                                std::size_t queueCapacity = 50,
-                               std::size_t fallbackThreadPoolSize = 0);
+                               std::size_t fallbackThreadPoolSize = 0,
+                               CExecutor::EScheduling scheduling = CExecutor::E_RoundRobin);
 
 //! Shutdown the thread pool and reset the executor to sequential in the same thread.
 //!
@@ -225,12 +244,66 @@ private:
 CORE_EXPORT
 void noop(double);
 
+//! Get the number of chunks into which to divide \p size values for \p partitions
+//! tasks which dynamically balance their load.
+//!
+//! \note This is always a power of two so each chunk's progress is exact.
+CORE_EXPORT
+std::size_t numberChunks(std::size_t size, std::size_t partitions);
+
+//! Run \p functions on chunks of [0, \p size) which each task claims in turn.
+//!
+//! Since tasks which finish early simply claim more chunks this load balances
+//! well even if the cost of processing different values is very uneven. This
+//! is used when the executor is work stealing.
+template<typename FUNCTION, typename APPLY>
+void chunked_parallel_for_each(std::size_t size,
+                               std::vector<FUNCTION>& functions,
+                               const std::function<void(double)>& recordProgress,
+                               const APPLY& apply) {
+
+    std::size_t chunks{numberChunks(size, functions.size())};
+    double chunkProgress{1.0 / static_cast<double>(chunks)};
+    std::atomic<std::size_t> nextChunk{0};
+
+    std::vector<std::future<bool>> finished;
+    finished.reserve(functions.size());
+
+    for (auto& f : functions) {
+        // We always wait until all calls are finished before returning so the
+        // functions and shared state always live beyond these references.
+        finished.emplace_back(async(
+            defaultAsyncExecutor(),
+            [&f, &nextChunk, &apply, &recordProgress, size, chunks, chunkProgress] {
+                for (std::size_t chunk = nextChunk.fetch_add(1); chunk < chunks;
+                     chunk = nextChunk.fetch_add(1)) {
+                    apply(f, (chunk * size) / chunks, ((chunk + 1) * size) / chunks);
+                    recordProgress(chunkProgress);
+                }
+                return true; // So we can check for exceptions via get.
+            }));
+    }
+
+    get_conjunction_of_all(finished);
+}
+
 template<typename FUNCTION>
 void parallel_for_each(std::size_t start,
                        std::size_t end,
                        std::vector<FUNCTION>& functions,
                        const std::function<void(double)>& recordProgress) {
 
+    if (defaultAsyncExecutor().scheduling() == CExecutor::E_WorkStealing) {
+        chunked_parallel_for_each(
+            end - start, functions, recordProgress,
+            [start](FUNCTION& f, std::size_t chunkStart, std::size_t chunkEnd) {
+                for (std::size_t i = start + chunkStart; i < start + chunkEnd; ++i) {
+                    f(i);
+                }
+            });
+        return;
+    }
+
     // Threads access the indices in the following pattern:
     //   [0, m,   2*m,   ...]
     //   [1, m+1, 2*m+1, ...]
@@ -278,6 +351,20 @@ void parallel_for_each(ITR start,
                        std::vector<FUNCTION>& functions,
                        const std::function<void(double)>& recordProgress = concurrency_detail::noop) {
 
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<ITR>::iterator_category>) {
+        if (defaultAsyncExecutor().scheduling() == CExecutor::E_WorkStealing) {
+            chunked_parallel_for_each(
+                size, functions, recordProgress,
+                [start](FUNCTION& f, std::size_t chunkStart, std::size_t chunkEnd) {
+                    for (ITR i = start + chunkStart; i != start + chunkEnd; ++i) {
+                        f(*i);
+                    }
+                });
+            return;
+        }
+    }
+
     // See above for the rationale for this access pattern.
 
     std::vector<std::future<bool>> finished;
@@ -534,6 +621,131 @@ parallel_for_each(ITR start,
     return parallel_for_each(defaultAsyncThreadPoolSize(), start, end,
                              std::forward<FUNCTION>(f), recordProgress);
 }
+
+//! Compute the reduction of \p transform applied to each index in [\p start, \p end)
+//! in parallel using the default async executor.
+//!
+//! The range is split into contiguous blocks of \p grainSize indices. Each block
+//! is reduced serially and the block results are combined in block order starting
+//! from \p init. The result therefore depends only on \p grainSize and not on the
+//! number of threads or the order in which tasks are scheduled, which matters if
+//! \p reduce isn't exactly associative, for example floating point addition.
+//!
+//! \param[in] start The first index to transform.
+//! \param[in] end The end of the indices to transform.
+//! \param[in] init The initial value of the reduction.
+//! \param[in] transform A Callable equivalent to std::function<T(std::size_t)>.
+//! \param[in] reduce A Callable equivalent to std::function<T(T, T)>.
+//! \param[in] grainSize The number of indices each task reduces serially.
+//! \note transform and reduce must be thread safe.
+//! \note If transform or reduce throws this will throw.
+template<typename T, typename TRANSFORM, typename REDUCE>
+T parallel_transform_reduce(std::size_t start,
+                            std::size_t end,
+                            T init,
+                            const TRANSFORM& transform,
+                            const REDUCE& reduce,
+                            std::size_t grainSize = 1024) {
+
+    if (end <= start) {
+        return init;
+    }
+
+    grainSize = std::max(grainSize, std::size_t{1});
+    std::size_t blocks{(end - start + grainSize - 1) / grainSize};
+
+    std::vector<std::optional<T>> blockResults(blocks);
+    parallel_for_each(std::size_t{0}, blocks, [&](std::size_t block) {
+        std::size_t blockStart{start + block * grainSize};
+        std::size_t blockEnd{std::min(blockStart + grainSize, end)};
+        T result{transform(blockStart)};
+        for (std::size_t i = blockStart + 1; i < blockEnd; ++i) {
+            result = reduce(std::move(result), transform(i));
+        }
+        blockResults[block] = std::move(result);
+    });
+
+    for (auto& result : blockResults) {
+        init = reduce(std::move(init), std::move(*result));
+    }
+    return init;
+}
+
+//! Compute the reduction of the values in [\p start, \p end) in parallel using
+//! the default async executor.
+//!
+//! \see parallel_transform_reduce for details.
+template<typename ITR, typename T, typename REDUCE>
+T parallel_reduce(ITR start, ITR end, T init, const REDUCE& reduce, std::size_t grainSize = 1024) {
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<ITR>::iterator_category>,
+                  "parallel_reduce requires random access iterators");
+    return parallel_transform_reduce(
+        std::size_t{0}, static_cast<std::size_t>(std::distance(start, end)),
+        std::move(init), [start](std::size_t i) { return T(start[i]); }, reduce, grainSize);
+}
+
+//! Write the inclusive scan of [\p start, \p end) with \p reduce to the range
+//! beginning at \p result in parallel using the default async executor.
+//!
+//! This makes two passes over the values: the first scans blocks of \p grainSize
+//! values independently and the second combines each value with the reduction of
+//! all preceding blocks. As with parallel_transform_reduce the result depends only
+//! on \p grainSize. The output range may be the input range.
+//!
+//! \note reduce must be associative for the result to equal std::inclusive_scan.
+//! \note reduce must be thread safe.
+//! \note If reduce throws this will throw.
+template<typename ITR, typename OUTPUT_ITR, typename REDUCE>
+void parallel_inclusive_scan(ITR start,
+                             ITR end,
+                             OUTPUT_ITR result,
+                             const REDUCE& reduce,
+                             std::size_t grainSize = 1024) {
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<ITR>::iterator_category>,
+                  "parallel_inclusive_scan requires random access iterators");
+
+    using TValue = typename std::iterator_traits<OUTPUT_ITR>::value_type;
+
+    std::size_t size(std::distance(start, end));
+    if (size == 0) {
+        return;
+    }
+
+    grainSize = std::max(grainSize, std::size_t{1});
+    std::size_t blocks{(size + grainSize - 1) / grainSize};
+
+    parallel_for_each(std::size_t{0}, blocks, [&](std::size_t block) {
+        std::size_t blockStart{block * grainSize};
+        std::size_t blockEnd{std::min(blockStart + grainSize, size)};
+        result[blockStart] = start[blockStart];
+        for (std::size_t i = blockStart + 1; i < blockEnd; ++i) {
+            result[i] = reduce(result[i - 1], start[i]);
+        }
+    });
+
+    if (blocks < 2) {
+        return;
+    }
+
+    // The reduction of all values preceding each block after the first.
+    std::vector<TValue> carries;
+    carries.reserve(blocks - 1);
+    carries.push_back(result[grainSize - 1]);
+    for (std::size_t block = 1; block + 1 < blocks; ++block) {
+        carries.push_back(reduce(carries.back(), result[(block + 1) * grainSize - 1]));
+    }
+
+    parallel_for_each(std::size_t{1}, blocks, [&](std::size_t block) {
+        std::size_t blockStart{block * grainSize};
+        std::size_t blockEnd{std::min(blockStart + grainSize, size)};
+        const TValue& carry{carries[block - 1]};
+        for (std::size_t i = blockStart; i < blockEnd; ++i) {
+            result[i] = reduce(carry, result[i]);
+        }
+    });
+}
 }
 }
 
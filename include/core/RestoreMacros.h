@@ -57,7 +57,7 @@ namespace core {
 
 #define RESTORE_BUILT_IN(tag, target)                                                  \
     if (name == tag) {                                                                 \
-        if (core::CStringUtils::stringToType(traverser.value(), target) == false) {    \
+        if (traverser.builtInValue(target) == false) {                                 \
             if (traverser.value().empty()) {                                           \
                 LOG_ERROR(<< "Failed to restore " #tag);                               \
             } else {                                                                   \
@@ -425,6 +425,11 @@ private:
     //! Get the best forest's prediction for \p row.
     TVector predictRow(const CEncodedDataFrameRowRef& row) const;
 
+    //! Write the best forest's prediction for \p row to \p result.
+    //!
+    //! \note \p result must be sized to the prediction dimension.
+    void predictRow(const CEncodedDataFrameRowRef& row, TVector& result) const;
+
     //! Check invariants which are assumed to hold after restoring.
     void checkRestoredInvariants() const;
 
@@ -129,6 +129,17 @@ public:
             *m_Count += static_cast<double>(count);
         }
 
+        //! Add \p count, \p gradient and \p curvature.
+        //!
+        //! \note This is only valid for loss functions with one parameter. It
+        //! avoids the overhead of memory mapped vectors in the hot loop.
+        void add(std::size_t count, double gradient, double curvature) {
+            double* derivatives{m_Gradient.data()};
+            derivatives[0] += gradient;
+            derivatives[1] += curvature;
+            *m_Count += static_cast<double>(count);
+        }
+
         //! Compute the accumulation of both collections of derivatives.
         void add(const CDerivatives& rhs) {
             this->flatView() += const_cast<CDerivatives*>(&rhs)->flatView();
@@ -249,18 +260,22 @@ public:
         //! \note Copying is an expensive operation so we use an explicit function
         //! instead of operator= to avoid accidental copies.
         void copy(const CSplitsDerivatives& other) {
-            if (this->conformable(other) == false) {
-                CSplitsDerivatives tmp{other};
-                std::swap(*this, tmp);
-            } else {
-                m_PositiveDerivativesSum = other.m_PositiveDerivativesSum;
-                m_NegativeDerivativesSum = other.m_NegativeDerivativesSum;
-                m_PositiveDerivativesMax = other.m_PositiveDerivativesMax;
-                m_PositiveDerivativesMin = other.m_PositiveDerivativesMin;
-                m_NegativeDerivativesMin = other.m_NegativeDerivativesMin;
+            if (this->conformable(other)) {
                 std::copy(other.m_Storage.begin(), other.m_Storage.end(),
                           m_Storage.begin());
+            } else {
+                // Remap recycling the allocated memory where possible.
+                m_DimensionGradient = other.m_DimensionGradient;
+                for (auto& derivatives : m_Derivatives) {
+                    derivatives.clear();
+                }
+                this->copyAndMapStorage(other.m_Storage, other.m_Derivatives);
             }
+            m_PositiveDerivativesSum = other.m_PositiveDerivativesSum;
+            m_NegativeDerivativesSum = other.m_NegativeDerivativesSum;
+            m_PositiveDerivativesMax = other.m_PositiveDerivativesMax;
+            m_PositiveDerivativesMin = other.m_PositiveDerivativesMin;
+            m_NegativeDerivativesMin = other.m_NegativeDerivativesMin;
         }
 
         //! \return The aggregate count for \p feature and \p split.
@@ -356,6 +371,14 @@ public:
             m_Derivatives[feature][split].add(1, derivatives);
         }
 
+        //! Add \p gradient and \p curvature to the accumulated derivatives for
+        //! the \p split of \p feature.
+        //!
+        //! \note This is only valid for loss functions with one parameter.
+        void addDerivatives(std::size_t feature, std::size_t split, double gradient, double curvature) {
+            m_Derivatives[feature][split].add(1, gradient, curvature);
+        }
+
         //! Add \p gradient and \p curvature to the accumulated derivatives for
         //! missing values of \p feature.
         void addMissingDerivatives(std::size_t feature,
@@ -474,7 +497,7 @@ public:
             this->mapStorage(splits);
         }
 
-        void copyAndMapStorage(const TAlignedDoubleVec storage,
+        void copyAndMapStorage(const TAlignedDoubleVec& storage,
                                const TDerivativesVecVec& derivatives) {
             m_Derivatives.resize(derivatives.size());
             m_Storage.assign(storage.begin(), storage.end());
@@ -764,6 +787,11 @@ public:
     //! Get the row mask for this leaf node.
     core::CPackedBitVector& rowMask();
 
+    //! Return this leaf's derivatives to \p workspace for reuse.
+    //!
+    //! \note This should only be called when the leaf is about to be discarded.
+    void recycle(CWorkspace& workspace);
+
     //! Get the size of this object.
     virtual std::size_t staticSize() const = 0;
 
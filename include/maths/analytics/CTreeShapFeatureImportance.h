@@ -173,10 +173,14 @@ private:
 private:
     static void computeInternalNodeValues(TTree& tree, std::size_t nodeIndex);
     static std::size_t depth(const TTree& tree, std::size_t nodeIndex);
+    //! Compute the fraction of its parent's training rows which reach each node
+    //! of \p tree.
+    static TDoubleVec nodeFractions(const TTree& tree);
 
     //! Recursively traverses all pathes in the \p tree and updated SHAP values once it hits a leaf.
     //! Ref. Algorithm 2 in the paper by Lundberg et al.
     void shapRecursive(const TTree& tree,
+                       const TDoubleVec& nodeFractions,
                        const CEncodedDataFrameRowRef& encodedRow,
                        std::size_t nodeIndex,
                        double parentFractionZero,
@@ -201,6 +205,8 @@ private:
     const CDataFrameCategoryEncoder* m_Encoder;
     const TTreeVec* m_Forest;
     TStrVec m_ColumnNames;
+    TSizeVec m_InputColumnIndices;
+    TDoubleVecVec m_NodeFractions;
     TElementVecVec m_PathStorage;
     TDoubleVecVec m_ScaleStorage;
     TVectorVecVec m_PerThreadShapValues;
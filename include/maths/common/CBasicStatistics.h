@@ -771,11 +771,7 @@ public:
 
         //! Update the moments with the collection \p x.
         template<typename OTHER_POINT>
-        void add(const std::vector<OTHER_POINT>& x) {
-            for (const auto& x_ : x) {
-                this->add(x_);
-            }
-        }
+        void add(const std::vector<OTHER_POINT>& x);
 
         //! Update with a generic point \p x.
         template<typename OTHER_POINT>
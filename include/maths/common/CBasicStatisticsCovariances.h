@@ -34,6 +34,43 @@ struct SCovariancesCustomAdd {
                            CBasicStatistics::SSampleCovariances<OTHER_POINT>& covariances) {
         covariances.add(x, n, 0);
     }
+
+    //! Add the collection \p x of points with unit count.
+    //!
+    //! This computes the mean and scatter matrix of the collection with
+    //! two passes and then combines them with \p covariances once. This
+    //! needs one outer product per point rather than the two outer products
+    //! and two rescalings needed to update the statistics point by point.
+    template<typename OTHER_POINT>
+    static void add(const std::vector<POINT>& x,
+                    CBasicStatistics::SSampleCovariances<OTHER_POINT>& covariances) {
+        using TVector = typename CBasicStatistics::SSampleCovariances<OTHER_POINT>::TVector;
+        using TCoordinate = typename SCoordinate<OTHER_POINT>::Type;
+
+        if (x.empty()) {
+            return;
+        }
+
+        TCoordinate n{static_cast<TCoordinate>(x.size())};
+
+        TVector mean{las::zero(covariances.s_Mean)};
+        for (const auto& x_ : x) {
+            const TVector& xi = x_;
+            mean += xi;
+        }
+        mean /= n;
+
+        auto scatter = las::conformableZeroMatrix(mean);
+        for (const auto& x_ : x) {
+            const TVector& xi = x_;
+            TVector r{xi - mean};
+            scatter += las::outer(r);
+        }
+        scatter /= n;
+
+        covariances += CBasicStatistics::SSampleCovariances<OTHER_POINT>(
+            las::constant(mean, n), mean, scatter);
+    }
 };
 
 //! \brief Default implementation of a covariance matrix shrinkage estimator.
@@ -122,6 +159,12 @@ CBasicStatistics::SSampleCovariances<POINT>::SSampleCovariances(std::size_t dime
       s_Covariances(SConstant<TMatrix>::get(dimension, 0)) {
 }
 
+template<typename POINT>
+template<typename OTHER_POINT>
+void CBasicStatistics::SSampleCovariances<POINT>::add(const std::vector<OTHER_POINT>& x) {
+    basic_statistics_detail::SCovariancesCustomAdd<OTHER_POINT>::add(x, *this);
+}
+
 template<typename POINT>
 template<typename OTHER_POINT>
 void CBasicStatistics::SSampleCovariances<POINT>::add(const OTHER_POINT& x) {
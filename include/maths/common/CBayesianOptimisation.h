@@ -191,7 +191,7 @@ private:
     void precondition();
     TVector function() const;
     double meanErrorVariance() const;
-    TMatrix dKerneld(const TVector& a, int k) const;
+    TMatrix dKerneld(const TVector& a, const TMatrix& K, int k) const;
     TMatrix kernel(const TVector& a, double v) const;
     TVectorDoublePr kernelCovariates(const TVector& a, const TVector& x, double vx) const;
     double kernel(const TVector& a, const TVector& x, const TVector& y) const;
@@ -109,6 +109,13 @@ public:
     //! Remove a value.
     void remove(std::uint32_t value);
 
+    //! Add the values in \p other to this sketch.
+    //!
+    //! \note If both have sketched their values then this is only possible
+    //! if they use the same hash functions, for example because one was
+    //! copied from the other, and otherwise this fails.
+    bool merge(const CBjkstUniqueValues& other);
+
     //! Get an estimate of the number of unique values added.
     std::uint32_t number() const;
 
@@ -149,6 +156,9 @@ private:
         //! Remove a value.
         void remove(std::uint32_t value);
 
+        //! Add the values in \p other, which must use the same hashes.
+        void merge(std::size_t maxSize, const SSketch& other);
+
         //! Get an estimate of the number of unique values added.
         std::uint32_t number() const;
 
@@ -492,13 +492,16 @@ private:
     }
 
     //! Get the closest filtered centre to \p point.
+    //!
+    //! \note This compares squared distances since it is called for every
+    //! point and centre in each iteration and the square root is redundant.
     template<typename ITR>
     static std::size_t
     closest(const TPointVec& centres, ITR filter, ITR end, const POINT& point) {
         std::size_t result = *filter;
-        double d = las::distance(point, centres[result]);
+        double d = las::distanceSquared(point, centres[result]);
         for (++filter; filter != end; ++filter) {
-            double di = las::distance(point, centres[*filter]);
+            double di = las::distanceSquared(point, centres[*filter]);
             if (di < d) {
                 result = *filter;
                 d = di;
@@ -577,8 +580,8 @@ private:
     void updateDistances(const POINT& selected, ITR beginPoints, ITR endPoints) const {
         std::size_t j{0};
         for (ITR point = beginPoints; point != endPoints; ++j, ++point) {
-            m_Distances[j] = std::min(
-                m_Distances[j], CTools::pow2(las::distance(*point, selected)));
+            m_Distances[j] = std::min(m_Distances[j],
+                                      static_cast<double>(las::distanceSquared(*point, selected)));
         }
     }
 
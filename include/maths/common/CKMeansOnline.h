@@ -456,7 +456,7 @@ public:
             const TDoublePoint& sample_{CBasicStatistics::mean(sample)};
             for (std::size_t j = 0; j < result.size(); ++j) {
                 if (weights[j] > 0.0) {
-                    nearest.add({las::distance(result[j], sample_), j});
+                    nearest.add({las::distanceSquared(result[j], sample_), j});
                 }
             }
             if (nearest.count() == 0) {
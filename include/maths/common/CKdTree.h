@@ -59,7 +59,7 @@ struct SEmptyNodeData {};
 //! The POINT type must have value semantics, support coordinate access,
 //! via operator(), support subtraction, via operator-, and provide a
 //! Euclidean norm, i.e. \f$\sqrt{\sum_i x_i^2}\f$. This is handled by
-//! overloading the las::distance functions.
+//! overloading the las::distance and las::distanceSquared functions.
 //!
 //! Extra node data can be supplied as a template parameter. The nodes
 //! inherit this publicly (so that the Empty Base Optimization is used
@@ -267,7 +267,8 @@ public:
         if (m_Nodes.size() > 0) {
             auto inf = std::numeric_limits<TCoordinatePrecise>::max();
             return this->nearestNeighbour(point, m_Nodes[0], distancesToHyperplanes,
-                                          0 /*split coordinate*/, nearest, inf);
+                                          TCoordinatePrecise{0}, 0 /*split coordinate*/,
+                                          nearest, inf);
         }
         return nearest;
     }
@@ -289,8 +290,6 @@ public:
                            TPoint& distancesToHyperplanes,
                            TPointVec& result) const {
 
-        result.clear();
-
         if (n > 0 && n < m_Nodes.size()) {
             auto inf = std::numeric_limits<TCoordinatePrecise>::max();
 
@@ -302,22 +301,36 @@ public:
             TCoordinatePrecisePointCRefPrVec neighbours(
                 n, {inf, std::cref(m_Nodes[0].s_Point)});
             this->nearestNeighbours(point, less, m_Nodes[0], distancesToHyperplanes,
-                                    0 /*split coordinate*/, neighbours);
+                                    TCoordinatePrecise{0}, 0 /*split coordinate*/,
+                                    neighbours);
 
-            result.reserve(n);
             std::sort_heap(neighbours.begin(), neighbours.end(), less);
-            for (const auto& neighbour : neighbours) {
-                result.push_back(neighbour.second);
+
+            // This is typically called repeatedly with the same result vector.
+            // We overwrite the existing elements where possible because, if the
+            // points own heap memory, assignment reuses it whereas copying into
+            // a cleared vector reallocates for every neighbour.
+            std::size_t i{0};
+            for (std::size_t m = std::min(result.size(), n); i < m; ++i) {
+                result[i] = neighbours[i].second.get();
+            }
+            result.erase(result.begin() + i, result.end());
+            result.reserve(n);
+            for (/**/; i < n; ++i) {
+                result.push_back(neighbours[i].second.get());
             }
         } else if (n >= m_Nodes.size()) {
+            result.clear();
             TDoubleVec distances;
             distances.reserve(m_Nodes.size());
             result.reserve(m_Nodes.size());
             for (const auto& node : m_Nodes) {
-                distances.push_back(las::distance(point, node.s_Point));
+                distances.push_back(las::distanceSquared(point, node.s_Point));
                 result.push_back(node.s_Point);
             }
             COrderings::simultaneousSort(distances, result);
+        } else {
+            result.clear();
         }
     }
 
@@ -411,15 +424,35 @@ private:
         return node;
     }
 
+    //! Get the squared norm of \p distancesToHyperplanes if we replace its
+    //! \p coordinate component with \p distanceToHyperplane.
+    static TCoordinatePrecise
+    updatedDistanceToHyperplanesSquared(const TPoint& distancesToHyperplanes,
+                                        TCoordinatePrecise distanceToHyperplanesSquared,
+                                        std::size_t coordinate,
+                                        TCoordinate distanceToHyperplane) {
+        TCoordinatePrecise previous{distancesToHyperplanes(coordinate)};
+        TCoordinatePrecise next{distanceToHyperplane};
+        return std::max(distanceToHyperplanesSquared - previous * previous + next * next,
+                        TCoordinatePrecise{0});
+    }
+
     //! Recursively find the nearest point to \p point.
+    //!
+    //! \note All distances are squared, which avoids square roots, and the
+    //! squared norm of \p distancesToHyperplanes is maintained incrementally
+    //! in \p distanceToHyperplanesSquared since only one component changes
+    //! at each level.
     const POINT* nearestNeighbour(const TPoint& point,
                                   const SNode& node,
                                   TPoint& distancesToHyperplanes,
+                                  TCoordinatePrecise distanceToHyperplanesSquared,
                                   std::size_t coordinate,
                                   const POINT* nearest,
                                   TCoordinatePrecise& distanceToNearest) const {
 
-        TCoordinatePrecise distance{las::distance(point, core::unwrap_ref(node.s_Point))};
+        TCoordinatePrecise distance{
+            las::distanceSquared(point, core::unwrap_ref(node.s_Point))};
 
         if (distance < distanceToNearest ||
             (distance == distanceToNearest && core::unwrap_ref(node.s_Point) < point)) {
@@ -442,36 +475,48 @@ private:
 
             std::size_t nextCoordinate{this->nextCoordinate(coordinate)};
             nearest = this->nearestNeighbour(point, *primary, distancesToHyperplanes,
-                                             nextCoordinate, nearest, distanceToNearest);
-            std::swap(distancesToHyperplanes(coordinate), distanceToHyperplane);
-            if (las::norm(distancesToHyperplanes) < distanceToNearest) {
-                nearest = this->nearestNeighbour(point, *secondary,
-                                                 distancesToHyperplanes, nextCoordinate,
-                                                 nearest, distanceToNearest);
+                                             distanceToHyperplanesSquared, nextCoordinate,
+                                             nearest, distanceToNearest);
+            TCoordinatePrecise secondaryDistanceToHyperplanesSquared{
+                updatedDistanceToHyperplanesSquared(
+                    distancesToHyperplanes, distanceToHyperplanesSquared,
+                    coordinate, distanceToHyperplane)};
+            if (secondaryDistanceToHyperplanesSquared < distanceToNearest) {
+                std::swap(distancesToHyperplanes(coordinate), distanceToHyperplane);
+                nearest = this->nearestNeighbour(
+                    point, *secondary, distancesToHyperplanes,
+                    secondaryDistanceToHyperplanesSquared, nextCoordinate, nearest,
+                    distanceToNearest);
+                std::swap(distancesToHyperplanes(coordinate), distanceToHyperplane);
             }
-            std::swap(distancesToHyperplanes(coordinate), distanceToHyperplane);
         } else if (primary != nullptr) {
             std::size_t nextCoordinate{this->nextCoordinate(coordinate)};
             nearest = this->nearestNeighbour(point, *primary, distancesToHyperplanes,
-                                             nextCoordinate, nearest, distanceToNearest);
+                                             distanceToHyperplanesSquared, nextCoordinate,
+                                             nearest, distanceToNearest);
         } else if (secondary != nullptr) {
             std::size_t nextCoordinate{this->nextCoordinate(coordinate)};
             nearest = this->nearestNeighbour(point, *secondary, distancesToHyperplanes,
-                                             nextCoordinate, nearest, distanceToNearest);
+                                             distanceToHyperplanesSquared, nextCoordinate,
+                                             nearest, distanceToNearest);
         }
 
         return nearest;
     }
 
-    //! Recursively find the nearest point to \p point.
+    //! Recursively find the nearest points to \p point.
+    //!
+    //! \note As for nearestNeighbour all distances are squared.
     void nearestNeighbours(const TPoint& point,
                            const COrderings::SLess& less,
                            const SNode& node,
                            TPoint& distancesToHyperplanes,
+                           TCoordinatePrecise distanceToHyperplanesSquared,
                            std::size_t coordinate,
                            TCoordinatePrecisePointCRefPrVec& nearest) const {
 
-        TCoordinatePrecise distance{las::distance(point, core::unwrap_ref(node.s_Point))};
+        TCoordinatePrecise distance{
+            las::distanceSquared(point, core::unwrap_ref(node.s_Point))};
 
         if (distance < nearest.front().first ||
             (distance == nearest.front().first && core::unwrap_ref(node.s_Point) < point)) {
@@ -496,21 +541,26 @@ private:
 
             std::size_t nextCoordinate{this->nextCoordinate(coordinate)};
             this->nearestNeighbours(point, less, *primary, distancesToHyperplanes,
-                                    nextCoordinate, nearest);
-            std::swap(distancesToHyperplanes(coordinate), distanceToHyperplane);
-            if (las::norm(distancesToHyperplanes) < nearest.front().first) {
+                                    distanceToHyperplanesSquared, nextCoordinate, nearest);
+            TCoordinatePrecise secondaryDistanceToHyperplanesSquared{
+                updatedDistanceToHyperplanesSquared(
+                    distancesToHyperplanes, distanceToHyperplanesSquared,
+                    coordinate, distanceToHyperplane)};
+            if (secondaryDistanceToHyperplanesSquared < nearest.front().first) {
+                std::swap(distancesToHyperplanes(coordinate), distanceToHyperplane);
                 this->nearestNeighbours(point, less, *secondary, distancesToHyperplanes,
+                                        secondaryDistanceToHyperplanesSquared,
                                         nextCoordinate, nearest);
+                std::swap(distancesToHyperplanes(coordinate), distanceToHyperplane);
             }
-            std::swap(distancesToHyperplanes(coordinate), distanceToHyperplane);
         } else if (primary != nullptr) {
             std::size_t nextCoordinate{this->nextCoordinate(coordinate)};
             this->nearestNeighbours(point, less, *primary, distancesToHyperplanes,
-                                    nextCoordinate, nearest);
+                                    distanceToHyperplanesSquared, nextCoordinate, nearest);
         } else if (secondary != nullptr) {
             std::size_t nextCoordinate{this->nextCoordinate(coordinate)};
             this->nearestNeighbours(point, less, *secondary, distancesToHyperplanes,
-                                    nextCoordinate, nearest);
+                                    distanceToHyperplanesSquared, nextCoordinate, nearest);
         }
     }
 
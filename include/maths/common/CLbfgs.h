@@ -12,6 +12,8 @@
 #ifndef INCLUDED_ml_maths_common_CLbfgs_h
 #define INCLUDED_ml_maths_common_CLbfgs_h
 
+#include <core/Concurrency.h>
+
 #include <maths/common/CLinearAlgebraShims.h>
 #include <maths/common/CPRNG.h>
 #include <maths/common/CSampling.h>
@@ -21,6 +23,7 @@
 #include <boost/circular_buffer.hpp>
 
 #include <cstddef>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -99,6 +102,49 @@ public:
         return {std::move(x), m_Fx};
     }
 
+    //! Minimise \p f from each of the starting points \p x0s and return the best
+    //! minimum found.
+    //!
+    //! The starts are independent and are minimised in parallel using the default
+    //! async executor. Each start uses its own copy of this object so the result
+    //! doesn't depend on the number of threads or the order in which the starts
+    //! are processed. Ties are broken in favour of the earliest start.
+    //!
+    //! \param f The function to minimise.
+    //! \param g The gradient of the function to minimise.
+    //! \param x0s The points in the domain of f from which to start the search.
+    //! \param eps The convergence tolerance, \see minimize.
+    //! \param iterations The maximum number of iterations of the main loop to
+    //! perform for each start.
+    //!
+    //! \note F and G must be copy constructible and distinct copies must be safe
+    //! to call concurrently.
+    template<typename F, typename G>
+    std::pair<VECTOR, double> multiStartMinimize(const F& f,
+                                                 const G& g,
+                                                 const std::vector<VECTOR>& x0s,
+                                                 double eps = 1e-8,
+                                                 std::size_t iterations = 50) const {
+
+        std::vector<std::pair<VECTOR, double>> minima(x0s.size());
+
+        core::parallel_for_each(0, x0s.size(), [&, f_ = f, g_ = g ](std::size_t i) mutable {
+            CLbfgs lbfgs{*this};
+            minima[i] = lbfgs.minimize(f_, g_, x0s[i], eps, iterations);
+        });
+
+        std::size_t best{0};
+        double fbest{std::numeric_limits<double>::max()};
+        for (std::size_t i = 0; i < minima.size(); ++i) {
+            if (minima[i].second < fbest) {
+                best = i;
+                fbest = minima[i].second;
+            }
+        }
+
+        return minima.empty() ? std::make_pair(VECTOR{}, fbest) : std::move(minima[best]);
+    }
+
     //! Minimize \p f in the bounding box with corners \p a and \p b.
     //!
     //! \param f The function to minimise.
@@ -219,6 +265,37 @@ public:
         return {xmin, fmin};
     }
 
+    //! Minimize \p f in the bounding box with corners \p a and \p b from each
+    //! of the starting points \p x0s.
+    //!
+    //! As with multiStartMinimize the starts are minimised in parallel and the
+    //! results don't depend on the number of threads.
+    //!
+    //! \return The minimum found for each start in the order of \p x0s.
+    //! \see constrainedMinimize for details of the other parameters.
+    //! \note F and G must be copy constructible and distinct copies must be safe
+    //! to call concurrently.
+    template<typename F, typename G>
+    std::vector<std::pair<VECTOR, double>>
+    multiStartConstrainedMinimize(const F& f,
+                                  const G& g,
+                                  const VECTOR& a,
+                                  const VECTOR& b,
+                                  const std::vector<VECTOR>& x0s,
+                                  double rho,
+                                  double eps = 1e-8,
+                                  std::size_t iterations = 50) const {
+
+        std::vector<std::pair<VECTOR, double>> minima(x0s.size());
+
+        core::parallel_for_each(0, x0s.size(), [&, f_ = f, g_ = g ](std::size_t i) mutable {
+            CLbfgs lbfgs{*this};
+            minima[i] = lbfgs.constrainedMinimize(f_, g_, a, b, x0s[i], rho, eps, iterations);
+        });
+
+        return minima;
+    }
+
 private:
     using TDoubleVec = std::vector<double>;
     using TVectorBuf = boost::circular_buffer<VECTOR>;
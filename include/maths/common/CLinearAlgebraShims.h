@@ -225,6 +225,39 @@ distance(const CAnnotatedVector<VECTOR, ANNOTATION>& x,
     return distance(static_cast<const VECTOR&>(x), static_cast<const VECTOR&>(y));
 }
 
+//! Squared Euclidean distance implementation for one of our internal vectors.
+template<typename VECTOR>
+typename SCoordinate<VECTOR>::Type distanceSquared(const VECTOR& x, const VECTOR& y) {
+    using TCoordinate = typename SPromoted<typename SCoordinate<VECTOR>::Type>::Type;
+    TCoordinate result(0);
+    for (std::size_t i = 0; i < dimension(x); ++i) {
+        TCoordinate x_(y(i) - x(i));
+        result += x_ * x_;
+    }
+    return result;
+}
+
+//! Squared Euclidean distance implementation for an Eigen dense vector.
+template<typename SCALAR>
+SCALAR distanceSquared(const CDenseVector<SCALAR>& x, const CDenseVector<SCALAR>& y) {
+    return (y - x).squaredNorm();
+}
+
+//! Squared Euclidean distance implementation for an Eigen memory mapped vector.
+template<typename SCALAR, Eigen::AlignmentType ALIGNMENT>
+SCALAR distanceSquared(const CMemoryMappedDenseVector<SCALAR, ALIGNMENT>& x,
+                       const CMemoryMappedDenseVector<SCALAR, ALIGNMENT>& y) {
+    return (y - x).squaredNorm();
+}
+
+//! Squared Euclidean distance implementation for an annotated vector.
+template<typename VECTOR, typename ANNOTATION>
+typename SCoordinate<VECTOR>::Type
+distanceSquared(const CAnnotatedVector<VECTOR, ANNOTATION>& x,
+                const CAnnotatedVector<VECTOR, ANNOTATION>& y) {
+    return distanceSquared(static_cast<const VECTOR&>(x), static_cast<const VECTOR&>(y));
+}
+
 //! Get the Euclidean norm of one of our internal vectors.
 template<typename VECTOR>
 typename SCoordinate<VECTOR>::Type norm(const VECTOR& x) {
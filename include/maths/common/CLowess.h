@@ -69,12 +69,16 @@ private:
     using TSizeVec = std::vector<std::size_t>;
     using TSizeVecVec = std::vector<TSizeVec>;
     using TSizeVecCItr = TSizeVec::const_iterator;
+    using TPolynomialVec = std::vector<TPolynomial>;
     using TMeanVarAccumulator = CBasicStatistics::SSampleMeanVar<double>::TAccumulator;
 
 private:
     void setupMasks(std::size_t numberFolds, TSizeVecVec& trainingMasks, TSizeVecVec& testingMasks) const;
-    double likelihood(TSizeVecVec& trainingMasks, TSizeVecVec& testingMasks, double k) const;
+    double likelihood(const TSizeVecVec& trainingMasks,
+                      const TSizeVecVec& testingMasks,
+                      double k) const;
     TPolynomial fit(TSizeVecCItr beginMask, TSizeVecCItr endMask, double k, double x) const;
+    void leaveOneOutFits(const TSizeVec& mask, double k, TPolynomialVec& fits) const;
     double weight(double k, double x1, double x2) const;
 
 private:
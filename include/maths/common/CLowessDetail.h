@@ -182,17 +182,13 @@ double CLowess<N>::residualVariance() const {
 
     TMeanVarAccumulator moments;
 
-    std::size_t n{m_Data.size()};
-
-    TSizeVec mask(n);
-    std::iota(mask.begin(), mask.end(), 1);
-    for (std::size_t i = 0; i < n; ++i) {
+    TPolynomialVec fits;
+    this->leaveOneOutFits(m_Mask, m_K, fits);
+    for (std::size_t i = 0; i < m_Data.size(); ++i) {
         double xi;
         double yi;
         std::tie(xi, yi) = m_Data[i];
-        auto poly = this->fit(mask.begin(), mask.begin() + n - 1, m_K, xi);
-        moments.add(yi - poly.predict(xi));
-        mask[i] -= 1;
+        moments.add(yi - fits[i].predict(xi));
     }
 
     return CBasicStatistics::variance(moments);
@@ -269,10 +265,13 @@ void CLowess<N>::setupMasks(std::size_t numberFolds,
 }
 
 template<std::size_t N>
-double CLowess<N>::likelihood(TSizeVecVec& trainingMasks, TSizeVecVec& testingMasks, double k) const {
+double CLowess<N>::likelihood(const TSizeVecVec& trainingMasks,
+                              const TSizeVecVec& testingMasks,
+                              double k) const {
 
     double result{0.0};
 
+    TPolynomialVec fits;
     CNormalMeanPrecConjugate::TDouble1Vec testResiduals;
     CNormalMeanPrecConjugate::TDoubleWeightsAry1Vec weights;
 
@@ -281,21 +280,17 @@ double CLowess<N>::likelihood(TSizeVecVec& trainingMasks, TSizeVecVec& testingMa
         CNormalMeanPrecConjugate residuals{
             CNormalMeanPrecConjugate::nonInformativePrior(maths_t::E_ContinuousData)};
 
-        std::size_t last{trainingMasks[i].size() - 1};
+        // The fit at every point excludes that point so this gives us both
+        // the leave-one-out fits at the training points and the fits at the
+        // points in the hold out set.
+        this->leaveOneOutFits(trainingMasks[i], k, fits);
 
-        for (auto& j : trainingMasks[i]) {
+        for (auto j : trainingMasks[i]) {
             double xj;
             double yj;
             std::tie(xj, yj) = m_Data[j];
-            // Here we wish to leave out the j'th fold training mask. Since this
-            // is a vector we do this efficiently by temporarily swaping to the
-            // back of the collection so we can pass the masks as a contiguous
-            // range.
-            std::swap(j, trainingMasks[i][last]);
-            auto poly = this->fit(trainingMasks[i].cbegin(),
-                                  trainingMasks[i].cbegin() + last, k, xj);
-            std::swap(j, trainingMasks[i][last]);
-            residuals.addSamples({yj - poly.predict(xj)}, maths_t::CUnitWeights::SINGLE_UNIT);
+            residuals.addSamples({yj - fits[j].predict(xj)},
+                                 maths_t::CUnitWeights::SINGLE_UNIT);
         }
         LOG_TRACE(<< "residual distribution = " << residuals.print());
 
@@ -305,9 +300,7 @@ double CLowess<N>::likelihood(TSizeVecVec& trainingMasks, TSizeVecVec& testingMa
             double xj;
             double yj;
             std::tie(xj, yj) = m_Data[j];
-            auto poly = this->fit(trainingMasks[i].cbegin(),
-                                  trainingMasks[i].cend(), k, xj);
-            testResiduals.push_back(yj - poly.predict(xj));
+            testResiduals.push_back(yj - fits[j].predict(xj));
         }
         weights.assign(testingMasks[i].size(), maths_t::CUnitWeights::UNIT);
         LOG_TRACE(<< "test residuals = " << testResiduals);
@@ -334,6 +327,46 @@ CLowess<N>::fit(TSizeVecCItr beginMask, TSizeVecCItr endMask, double k, double x
     return poly;
 }
 
+template<std::size_t N>
+void CLowess<N>::leaveOneOutFits(const TSizeVec& mask, double k, TPolynomialVec& fits) const {
+
+    // The weight function factorises as exp(-k (x2 - x1)) = exp(-k (x2 - x)) exp(-k (x - x1))
+    // for x1 <= x <= x2. Since the data are sorted, we can therefore compute the fit
+    // at every data point from the points to its left and right in two passes, ageing
+    // the statistics by the distance between consecutive points. This is O(|data|)
+    // rather than O(|data|^2) for fitting each point separately.
+
+    std::size_t n{m_Data.size()};
+
+    fits.assign(n, TPolynomial{});
+
+    TPolynomial poly;
+    for (std::size_t i = 0, j = 0; i < n; ++i) {
+        fits[i] = poly;
+        for (/**/; j < mask.size() && mask[j] <= i; ++j) {
+            if (mask[j] == i) {
+                poly.add(m_Data[i].first, m_Data[i].second);
+            }
+        }
+        if (i + 1 < n) {
+            poly.age(this->weight(k, m_Data[i].first, m_Data[i + 1].first));
+        }
+    }
+
+    poly = TPolynomial{};
+    for (std::size_t i = n, j = mask.size(); i > 0; --i) {
+        fits[i - 1] += poly;
+        for (/**/; j > 0 && mask[j - 1] >= i - 1; --j) {
+            if (mask[j - 1] == i - 1) {
+                poly.add(m_Data[i - 1].first, m_Data[i - 1].second);
+            }
+        }
+        if (i > 1) {
+            poly.age(this->weight(k, m_Data[i - 2].first, m_Data[i - 1].first));
+        }
+    }
+}
+
 template<std::size_t N>
 double CLowess<N>::weight(double k, double x1, double x2) const {
     return std::exp(-k * std::fabs(x2 - x1));
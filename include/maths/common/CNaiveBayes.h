@@ -118,6 +118,8 @@ public:
     double logValue(const TDouble1Vec& x) const override;
 
     //! Compute the density at the mode.
+    //!
+    //! \note This is cached until the density is next updated.
     double logMaximumValue() const override;
 
     //! Set the data type.
@@ -152,6 +154,10 @@ private:
 private:
     //! The density model.
     TPriorPtr m_Prior;
+
+    //! The log of the density at its mode, if it has been computed since
+    //! the density was last updated.
+    mutable std::optional<double> m_LogMaximumValue;
 };
 
 //! \brief Enables using custom feature weights in class prediction.
@@ -123,6 +123,15 @@ struct SCovariancesCustomAdd<CAnnotatedVector<POINT, SCountAndVariance>> {
         covariances += CBasicStatistics::SSampleCovariances<OTHER_POINT>(
             n, x, diag.asDiagonal());
     }
+
+    //! Add the collection \p x of spherical clusters.
+    template<typename OTHER_POINT>
+    static void add(const std::vector<CAnnotatedVector<POINT, SCountAndVariance>>& x,
+                    CBasicStatistics::SSampleCovariances<OTHER_POINT>& covariances) {
+        for (const auto& x_ : x) {
+            covariances.add(x_);
+        }
+    }
 };
 
 //! \brief Specialization of the implementation of a covariance
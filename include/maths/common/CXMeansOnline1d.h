@@ -167,6 +167,10 @@ public:
         //! Get \p numberSamples from this cluster.
         void sample(std::size_t numberSamples, double smallest, double largest, TDoubleVec& samples) const;
 
+        //! Check if enough points have been added since we last searched
+        //! for a split that it's worth searching again.
+        bool splitCheckDue() const;
+
         //! Try and find a split by a full search of the binary tree
         //! of possible optimal 2-splits of the data.
         //!
@@ -225,6 +229,9 @@ public:
 
         //! The data representing the internal structure of this cluster.
         CNaturalBreaksClassifier m_Structure;
+
+        //! The number of points added since we last searched for a split.
+        std::size_t m_NumberAddedSinceSplitCheck{0};
     };
 
     using TClusterVec = std::vector<CCluster>;
@@ -390,6 +397,10 @@ private:
     //! split a cluster.
     static const double MINIMUM_SPLIT_DISTANCE;
 
+    //! The number of points, as a fraction of a cluster's count, which
+    //! must be added to it before we search for a split again.
+    static const double SPLIT_CHECK_FRACTION;
+
     //! The maximum Kullback-Leibler divergence for which we'll
     //! merge two cluster. This is intended to introduce hysteresis
     //! in the cluster creation and deletion process and so should
@@ -96,6 +96,13 @@ public:
     //! this removes the map entry for \p category.
     void removeFromMap(std::uint32_t category);
 
+    //! Add the counts in \p other to this sketch.
+    //!
+    //! \note If both sketches have sketched their counts then this is
+    //! only possible if they use the same hash functions, for example
+    //! because one was copied from the other, and otherwise this fails.
+    bool merge(const CCountMinSketch& other);
+
     //! Age the counts forwards \p time.
     void age(double alpha);
 
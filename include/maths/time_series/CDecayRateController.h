@@ -92,6 +92,20 @@ public:
                       double learnRate,
                       double decayRate);
 
+    //! Get the decay rate multiplier to apply and update the relevant
+    //! prediction errors of a univariate time series.
+    //!
+    //! \param[in] prediction The mean prediction for the bucket.
+    //! \param[in] predictionErrors The prediction errors of each value
+    //! added in the bucket.
+    //! \note Unlike multiplier this doesn't need any heap allocation
+    //! when there is a single value per bucket.
+    double univariateMultiplier(double prediction,
+                                const TDouble1Vec& predictionErrors,
+                                core_t::TTime bucketLength,
+                                double learnRate,
+                                double decayRate);
+
     //! Get the current multiplier.
     double multiplier() const;
 
@@ -112,6 +126,15 @@ private:
 
 private:
     double count() const;
+    void addPredictionError(std::size_t d,
+                            double count,
+                            double prediction,
+                            double predictionError,
+                            double weight);
+    double updateMultiplier(double count,
+                            core_t::TTime bucketLength,
+                            double learnRate,
+                            double decayRate);
     double change(const TDouble3Ary& stats, core_t::TTime bucketLength) const;
     bool notControlling() const;
     bool increaseDecayRateErrorIncreasing(const TDouble3Ary& stats) const;
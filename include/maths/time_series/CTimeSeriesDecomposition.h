@@ -256,6 +256,14 @@ private:
     TVector2x1
     varianceScaleWeight(core_t::TTime time, double variance, double confidence, bool smooth) const;
 
+    //! Compute the variance scale weight to apply at \p time given the
+    //! mean variance \p mean.
+    TVector2x1 varianceScaleWeight(core_t::TTime time,
+                                   double variance,
+                                   double mean,
+                                   double confidence,
+                                   bool smooth) const;
+
     //! The correction to produce a smooth join between periodic
     //! repeats and partitions.
     template<typename F>
@@ -583,7 +583,9 @@ public:
         void handle(const SDetectedChangePoint& message) override;
 
         //! Maybe re-interpolate the components.
-        void interpolateForForecast(core_t::TTime time);
+        //!
+        //! \return True if the components were re-interpolated.
+        bool interpolateForForecast(core_t::TTime time);
 
         //! Set the data type.
         void dataType(maths_t::EDataType dataType);
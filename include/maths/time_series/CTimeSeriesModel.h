@@ -242,7 +242,7 @@ private:
                             const TDouble1Vec& samples);
 
     //! Compute the prediction errors for \p sample.
-    void appendPredictionErrors(double interval, double sample, TDouble1VecVec (&result)[2]);
+    void appendPredictionErrors(double interval, double sample, TDouble1Vec (&result)[2]);
 
     //! Reinitialize state after detecting a new component of the trend
     //! decomposition.
@@ -324,6 +324,7 @@ public:
 private:
     using TDoubleDoublePr = std::pair<double, double>;
     using TDoubleDoubleDoubleTr = std::tuple<double, double, double>;
+    using TDoubleVec = std::vector<double>;
     using TSizeVec = std::vector<std::size_t>;
     using TMaxAccumulator =
         common::CBasicStatistics::COrderStatisticsHeap<double, std::greater<double>>;
@@ -393,6 +394,9 @@ private:
     double m_PredictionVariance{0.0};
     TPredictor m_Predictor{[](core_t::TTime) { return 0.0; }};
     TFloatMeanAccumulatorVec m_Values;
+    //! The base predictions for each bucket of m_Values. These are used
+    //! by every test so we only evaluate the predictor once.
+    TDoubleVec m_BucketPredictions;
     // The follow are member data to avoid repeatedly reinitialising.
     mutable TFloatMeanAccumulatorVec m_ValuesMinusPredictions;
     mutable TMaxAccumulator m_Outliers;
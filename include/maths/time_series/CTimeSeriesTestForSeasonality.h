@@ -521,10 +521,13 @@ private:
 
 private:
     CSeasonalDecomposition select(TModelVec& hypotheses) const;
-    void addNotSeasonal(const TRemoveTrend& removeTrend, TModelVec& decompositions) const;
+    void addNotSeasonal(const TFloatMeanAccumulatorVec& valuesMinusTrend,
+                        const TSizeVec& modelTrendSegments,
+                        TModelVec& decompositions) const;
     void addModelled(const TRemoveTrend& removeTrend, TModelVec& decompositions) const;
     void addDiurnal(const TRemoveTrend& removeTrend, TModelVec& decompositions) const;
     void addHighestAutocorrelation(const TRemoveTrend& removeTrend,
+                                   const TFloatMeanAccumulatorVec& valuesMinusTrend,
                                    TModelVec& decompositions) const;
     void testAndAddDecomposition(const TSeasonalComponentVec& periods,
                                  const TSizeVec& modelTrendSegments,
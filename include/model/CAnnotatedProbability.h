@@ -58,6 +58,9 @@ struct MODEL_EXPORT SAttributeProbability {
     //! Restore the probability reading state from \p traverser.
     bool acceptRestoreTraverser(core::CStateRestoreTraverser& traverser);
 
+    //! Get the memory used by this object.
+    std::size_t memoryUsage() const;
+
     //! The attribute identifier.
     std::size_t s_Cid;
     //! The attribute.
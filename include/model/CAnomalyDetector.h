@@ -11,12 +11,14 @@
 #ifndef INCLUDED_ml_model_CAnomalyDetector_h
 #define INCLUDED_ml_model_CAnomalyDetector_h
 
+#include <core/CCompressedDictionary.h>
 #include <core/CMemoryUsage.h>
 #include <core/CoreTypes.h>
 
 #include <model/CAnomalyDetectorModel.h>
 #include <model/CAnomalyDetectorModelConfig.h>
 #include <model/CForecastDataSink.h>
+#include <model/CInterimResultsCache.h>
 #include <model/CModelPlotData.h>
 #include <model/CMonitoredResource.h>
 #include <model/ImportExport.h>
@@ -66,6 +68,7 @@ class MODEL_EXPORT CAnomalyDetector : public CMonitoredResource {
 public:
     using TStrVec = std::vector<std::string>;
     using TStrCPtrVec = std::vector<const std::string*>;
+    using TWordVec = std::vector<core::CCompressedDictionary<2>::CWord>;
     using TModelPlotDataVec = std::vector<CModelPlotData>;
     using TAnnotationVec = CAnomalyDetectorModel::TAnnotationVec;
     using TDataGathererPtr = std::shared_ptr<CDataGatherer>;
@@ -214,11 +217,38 @@ public:
     //! Extract and add the necessary details of an event record.
     void addRecord(core_t::TTime time, const TStrCPtrVec& fieldValues);
 
+    //! Extract and add the necessary details of an event record whose
+    //! field values have dictionary words \p fieldWords.
+    //!
+    //! The words are only used if the field values aren't modified by
+    //! preprocessing.
+    void addRecord(core_t::TTime time, const TStrCPtrVec& fieldValues, const TWordVec& fieldWords);
+
     //! Update the results with this detector model's results.
     void buildResults(core_t::TTime bucketStartTime,
                       core_t::TTime bucketEndTime,
                       CHierarchicalResults& results);
 
+    //! Sample the bucket [\p bucketStartTime, \p bucketEndTime) ready to
+    //! compute its results with computeResults().
+    //!
+    //! Calling this and then computeResults() is equivalent to calling
+    //! buildResults(). Only sampling updates state which is shared between
+    //! detectors, such as the resource monitor, so splitting the two lets
+    //! the results of different detectors be computed concurrently.
+    //!
+    //! \return False if the results of the bucket have already been built
+    //! in which case computeResults() shouldn't be called.
+    bool sampleForResults(core_t::TTime bucketStartTime, core_t::TTime bucketEndTime);
+
+    //! Update the results with this detector model's results for a bucket
+    //! which has been sampled by sampleForResults().
+    //!
+    //! \note This only modifies the state of this detector.
+    void computeResults(core_t::TTime bucketStartTime,
+                        core_t::TTime bucketEndTime,
+                        CHierarchicalResults& results);
+
     //! Update the results with this detector model's results.
     void buildInterimResults(core_t::TTime bucketStartTime,
                              core_t::TTime bucketEndTime,
@@ -226,9 +256,13 @@ public:
 
     //! Generate the model plot data for the time series identified
     //! by \p terms.
+    //!
+    //! The bounds of each time series are only recomputed once every
+    //! \p boundsCadence buckets and reused in between.
     void generateModelPlot(core_t::TTime bucketStartTime,
                            core_t::TTime bucketEndTime,
                            double boundsPercentile,
+                           std::size_t boundsCadence,
                            const TStrSet& terms,
                            TModelPlotDataVec& modelPlots) const;
 
@@ -307,6 +341,11 @@ public:
     //! Roll time forwards to \p time.
     void timeNow(core_t::TTime time);
 
+    //! Discard any cached interim results. This must be called whenever the
+    //! detection rules, filters or scheduled events change since they can
+    //! change the results of people who haven't received new data.
+    void invalidateInterimResults();
+
     //! Rolls time to \p endTime while skipping sampling the models for buckets within the gap
     //! \param[in] endTime The end of the time interval to skip sampling.
     void skipSampling(core_t::TTime endTime);
@@ -329,6 +368,7 @@ private:
                             core_t::TTime bucketEndTime,
                             SAMPLE_FUNC sampleFunc,
                             LAST_SAMPLED_BUCKET_UPDATE_FUNC lastSampledBucketUpdateFunc,
+                            CInterimResultsCache* interimResultsCache,
                             CHierarchicalResults& results);
 
     //! Updates the last sampled bucket
@@ -385,6 +425,12 @@ private:
     // The model of the data in which we are detecting anomalies.
     TModelPtr m_Model;
 
+    //! The model plot bounds which can be reused in the next few buckets.
+    mutable CModelPlotBoundsCache m_ModelPlotBoundsCache;
+
+    //! The interim results which can be reused until the bucket is sampled.
+    CInterimResultsCache m_InterimResultsCache;
+
     //! Is this a cloned detector containing the bare minimum information
     //! necessary to create a valid persisted state?
     bool m_IsForPersistence;
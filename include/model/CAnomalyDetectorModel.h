@@ -26,6 +26,7 @@
 
 #include <boost/unordered_map.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <limits>
@@ -51,6 +52,7 @@ class CAttributeFrequencyGreaterThan;
 class CDataGatherer;
 class CHierarchicalResults;
 class CInterimBucketCorrector;
+class CInterimResultsCache;
 class CMemoryUsageEstimator;
 class CModelDetailsView;
 class CPartitioningFields;
@@ -154,6 +156,7 @@ public:
     using TFeatureMathsModelSPtrPrVec = std::vector<TFeatureMathsModelSPtrPr>;
     using TMathsModelUPtr = std::unique_ptr<maths::common::CModel>;
     using TMathsModelUPtrVec = std::vector<TMathsModelUPtr>;
+    using TMathsModelSPtrVec = std::vector<TMathsModelSPtr>;
     using TMultivariatePriorSPtr = std::shared_ptr<maths::common::CMultivariatePrior>;
     using TFeatureMultivariatePriorSPtrPr = std::pair<model_t::EFeature, TMultivariatePriorSPtr>;
     using TFeatureMultivariatePriorSPtrPrVec = std::vector<TFeatureMultivariatePriorSPtrPr>;
@@ -415,6 +418,17 @@ public:
                     std::size_t numberAttributeProbabilities,
                     CHierarchicalResults& results) const;
 
+    //! Update the results with this model's probability reusing the results
+    //! in \p interimResultsCache for people who haven't received data since
+    //! they were cached.
+    //!
+    //! \note This only reuses results if \p results are interim.
+    bool addResults(core_t::TTime startTime,
+                    core_t::TTime endTime,
+                    std::size_t numberAttributeProbabilities,
+                    CInterimResultsCache& interimResultsCache,
+                    CHierarchicalResults& results) const;
+
     //! Compute the probability of seeing \p person's attribute processes
     //! so far given the population distributions.
     //!
@@ -461,6 +475,13 @@ public:
                                                       std::size_t numberAttributes,
                                                       std::size_t numberCorrelations);
 
+    //! Get the estimated change in memory usage from creating new models
+    //! since this was last called and reset it to zero.
+    //!
+    //! This lets the owner report the change to the resource monitor
+    //! without recalculating the memory used by every model.
+    std::ptrdiff_t takeMemoryUsageDelta();
+
     //! Get the static size of this object - used for virtual hierarchies
     virtual std::size_t staticSize() const = 0;
 
@@ -517,15 +538,32 @@ protected:
         //! Get the memory used by this model.
         std::size_t memoryUsage() const;
 
+        //! Get the memory used by the model of a new series.
+        std::size_t newModelMemoryUsage() const;
+
         //! Determine whether the model should be persisted or not.
         bool shouldPersist() const;
 
+        //! Get a copy of the models for persistence.
+        //!
+        //! If \p correlated is false the copy shares the models, which are
+        //! only copied if they're modified before the copy is destroyed, see
+        //! mutableModel. Correlated models are registered with their feature's
+        //! correlate models by address so are always copied.
+        SFeatureModels copyForPersistence(bool correlated) const;
+
+        //! Get the \p id'th model for modification.
+        //!
+        //! \note This copies the model if it's shared with a copy made for
+        //! persistence so all modifications must go through this.
+        maths::common::CModel* mutableModel(std::size_t id);
+
         //! The feature.
         model_t::EFeature s_Feature;
         //! A prototype model.
         TMathsModelSPtr s_NewModel;
         //! The person models.
-        TMathsModelUPtrVec s_Models;
+        TMathsModelSPtrVec s_Models;
     };
     using TFeatureModelsVec = std::vector<SFeatureModels>;
 
@@ -675,6 +713,10 @@ protected:
     //! Get the object which calculates corrections for interim buckets.
     virtual const CInterimBucketCorrector& interimValueCorrector() const = 0;
 
+    //! Check if a person's interim result only depends on their own data
+    //! in the current bucket and so can be reused until they receive more.
+    virtual bool canReuseInterimResults() const;
+
     //! Get the value of the initial count weight to apply to the model's
     //! samples, as determined by the detection rules.
     double initialCountWeight(model_t::EFeature feature,
@@ -698,6 +740,10 @@ protected:
     //! Get the non-estimated value of the the memory used by this model.
     virtual std::size_t computeMemoryUsage() const = 0;
 
+    //! Record that creating new models changed the memory usage from
+    //! \p before to \p after.
+    void recordMemoryUsageChange(std::size_t before, std::size_t after);
+
     //! Create a stub version of maths::common::CModel for use when pruning people
     //! or attributes to free memory resource.
     static maths::common::CModel* tinyModel();
@@ -706,6 +752,13 @@ private:
     using TModelParamsCRef = std::reference_wrapper<const SModelParams>;
 
 private:
+    //! Implements addResults optionally reusing cached interim results.
+    bool addResults(core_t::TTime startTime,
+                    core_t::TTime endTime,
+                    std::size_t numberAttributeProbabilities,
+                    CInterimResultsCache* interimResultsCache,
+                    CHierarchicalResults& results) const;
+
     //! Skip sampling the interval \p endTime - \p startTime.
     virtual void doSkipSampling(core_t::TTime startTime, core_t::TTime endTime) = 0;
 
@@ -730,6 +783,9 @@ private:
     //! The influence calculators to use for each feature which is being
     //! modeled.
     TFeatureInfluenceCalculatorCPtrPrVecVec m_InfluenceCalculators;
+
+    //! The change in memory usage recorded since it was last taken.
+    std::ptrdiff_t m_MemoryUsageDelta{0};
 };
 
 class CMemoryCircuitBreaker : public core::CMemoryCircuitBreaker {
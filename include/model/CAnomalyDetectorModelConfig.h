@@ -388,6 +388,16 @@ public:
     //! Get the central confidence interval for the model debug plot.
     double modelPlotBoundsPercentile() const;
 
+    //! Set the number of buckets between recomputing the model plot bounds
+    //! of each time series to \p cadence.
+    //!
+    //! The bounds are reused in the buckets in between. The default of one
+    //! recomputes the bounds of every series every bucket.
+    void modelPlotBoundsCadence(std::size_t cadence);
+
+    //! Get the number of buckets between recomputing the model plot bounds.
+    std::size_t modelPlotBoundsCadence() const;
+
     //! Is model plot enabled?
     bool modelPlotEnabled() const;
 
@@ -475,6 +485,10 @@ private:
     //! The central confidence interval for the model debug plot.
     double m_ModelPlotBoundsPercentile;
 
+    //! The number of buckets between recomputing each series' model plot
+    //! bounds.
+    std::size_t m_ModelPlotBoundsCadence{1};
+
     //! Terms (by, over, or partition field values) used to filter model
     //! debug data. Empty when no filtering applies.
     TStrSet m_ModelPlotTerms;
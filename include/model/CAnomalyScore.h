@@ -129,6 +129,48 @@ public:
             TOptionalStrCRef m_PersonFieldValue;
         };
 
+        //! \brief Caches the parts of the normalization which depend only
+        //! on the quantiles.
+        //!
+        //! DESCRIPTION:\n
+        //! When many scores are normalized against quantiles which don't
+        //! change, for example when renormalizing historic results, the
+        //! noise ceiling and the percentile score of each distinct discrete
+        //! raw score need only be computed once. The cache must be cleared
+        //! if the normalizer it is used with is modified.
+        //!
+        //! IMPLEMENTATION DECISIONS:\n
+        //! The percentile scores are stored in a small flat array sorted by
+        //! discrete score and found by binary search. The number stored is
+        //! bounded and scores which don't fit are computed on demand.
+        class MODEL_EXPORT CQuantileCache {
+        public:
+            //! The maximum number of percentile scores which are cached.
+            static constexpr std::size_t MAXIMUM_NUMBER_PERCENTILE_SCORES{256};
+
+        public:
+            //! Remove all cached values.
+            void clear();
+
+        private:
+            using TUInt32DoublePr = std::pair<std::uint32_t, double>;
+            using TUInt32DoublePrVec = std::vector<TUInt32DoublePr>;
+
+        private:
+            //! True if the noise ceiling terms have been computed.
+            bool m_HaveNoiseTerms{false};
+            //! The noise percentile discrete score.
+            std::uint32_t m_NoiseScore{0};
+            //! The normalized score at the noise percentile knot point.
+            double m_NoiseKnotPointScore{0.0};
+            //! The sum of the lower and upper bounds of the c.d.f. at zero.
+            double m_ZeroCdf{0.0};
+            //! The percentile scores sorted by discrete raw score.
+            TUInt32DoublePrVec m_PercentileScores;
+
+            friend class CNormalizer;
+        };
+
     public:
         explicit CNormalizer(const CAnomalyDetectorModelConfig& config);
 
@@ -138,8 +180,17 @@ public:
 
         //! As above but taking a single pre-aggregated \p score instead
         //! of a vector of scores to be aggregated.
+        //!
+        //! The terms which depend only on the quantiles are cached until
+        //! the normalizer is next modified.
         bool normalize(const CMaximumScoreScope& scope, double& score) const;
 
+        //! As above but reusing the terms in \p cache which depend only on
+        //! the quantiles.
+        //!
+        //! \warning \p cache must be cleared if this is modified.
+        bool normalize(const CMaximumScoreScope& scope, double& score, CQuantileCache& cache) const;
+
         //! Estimate the quantile range including the \p score.
         //!
         //! \param[in] score The score to estimate.
@@ -253,6 +304,21 @@ public:
         //! Retrieve the maximum score for a partition
         bool maxScore(const CMaximumScoreScope& scope, double& maxScore) const;
 
+        //! Compute the terms of the noise ceiling which depend only on the
+        //! quantiles.
+        void noiseTerms(std::uint32_t& noiseScore, double& noiseKnotPointScore, double& zeroCdf) const;
+
+        //! Compute the normalized score implied by the percentile of \p score.
+        double percentileScore(double score) const;
+
+        //! Normalize \p score given the terms which depend only on the quantiles.
+        void normalize(const CMaximumScoreScope& scope,
+                       std::uint32_t noiseScore,
+                       double noiseKnotPointScore,
+                       double zeroCdf,
+                       double percentileScore,
+                       double& score) const;
+
     private:
         //! The percentile defining the largest noise score.
         double m_NoisePercentile;
@@ -288,6 +354,9 @@ public:
         //! approximate HIGH_PERCENTILE percentile raw score.
         maths::common::CQDigest m_RawScoreHighQuantileSummary;
 
+        //! The terms of the normalization which depend only on the quantiles.
+        mutable CQuantileCache m_QuantileCache;
+
         //! The rate at which information is lost.
         double m_DecayRate;
         //! The time to when we next age the quantiles.
@@ -20,6 +20,7 @@
 
 #include <model/CBucketQueue.h>
 #include <model/CEventData.h>
+#include <model/CPersonAttributeFlatMap.h>
 #include <model/ImportExport.h>
 #include <model/ModelTypes.h>
 
@@ -75,17 +76,19 @@ public:
     using TSizeSizePrUInt64Pr = std::pair<TSizeSizePr, std::uint64_t>;
     using TSizeSizePrUInt64PrVec = std::vector<TSizeSizePrUInt64Pr>;
     using TDictionary = core::CCompressedDictionary<2>;
+    using TWord = TDictionary::CWord;
+    using TWordVec = std::vector<TWord>;
     using TWordSizeUMap = TDictionary::TWordTUMap<std::size_t>;
     using TWordSizeUMapItr = TWordSizeUMap::iterator;
     using TWordSizeUMapCItr = TWordSizeUMap::const_iterator;
-    using TSizeSizePrUInt64UMap = boost::unordered_map<TSizeSizePr, std::uint64_t>;
-    using TSizeSizePrUInt64UMapItr = TSizeSizePrUInt64UMap::iterator;
-    using TSizeSizePrUInt64UMapCItr = TSizeSizePrUInt64UMap::const_iterator;
-    using TSizeSizePrUInt64UMapQueue = CBucketQueue<TSizeSizePrUInt64UMap>;
-    using TTimeSizeSizePrUInt64UMapMap = std::map<core_t::TTime, TSizeSizePrUInt64UMap>;
-    using TSizeSizePrUInt64UMapQueueItr = TSizeSizePrUInt64UMapQueue::iterator;
-    using TSizeSizePrUInt64UMapQueueCItr = TSizeSizePrUInt64UMapQueue::const_iterator;
-    using TSizeSizePrUInt64UMapQueueCRItr = TSizeSizePrUInt64UMapQueue::const_reverse_iterator;
+    using TSizeSizePrUInt64FlatMap = CPersonAttributeFlatMap<std::uint64_t>;
+    using TSizeSizePrUInt64FlatMapItr = TSizeSizePrUInt64FlatMap::iterator;
+    using TSizeSizePrUInt64FlatMapCItr = TSizeSizePrUInt64FlatMap::const_iterator;
+    using TSizeSizePrUInt64FlatMapQueue = CBucketQueue<TSizeSizePrUInt64FlatMap>;
+    using TTimeSizeSizePrUInt64FlatMapMap = std::map<core_t::TTime, TSizeSizePrUInt64FlatMap>;
+    using TSizeSizePrUInt64FlatMapQueueItr = TSizeSizePrUInt64FlatMapQueue::iterator;
+    using TSizeSizePrUInt64FlatMapQueueCItr = TSizeSizePrUInt64FlatMapQueue::const_iterator;
+    using TSizeSizePrUInt64FlatMapQueueCRItr = TSizeSizePrUInt64FlatMapQueue::const_reverse_iterator;
     using TSizeSizePrUSet = boost::unordered_set<TSizeSizePr>;
     using TSizeSizePrUSetCItr = TSizeSizePrUSet::const_iterator;
     using TSizeSizePrUSetQueue = CBucketQueue<TSizeSizePrUSet>;
@@ -214,8 +217,11 @@ public:
     //! Process the specified fields.
     //!
     //! This adds people and attributes as necessary and fills out the
-    //! event data from \p fieldValues.
+    //! event data from \p fieldValues. If \p fieldWords isn't empty it
+    //! holds the dictionary words of \p fieldValues, which are used to
+    //! look up people and attributes without hashing their names again.
     virtual bool processFields(const TStrCPtrVec& fieldValues,
+                               const TWordVec& fieldWords,
                                CEventData& result,
                                CResourceMonitor& resourceMonitor) = 0;
 
@@ -301,7 +307,7 @@ public:
     //@{
     //! Get the non-zero (person, attribute) pair counts in the
     //! bucketing interval corresponding to the given time.
-    const TSizeSizePrUInt64UMap& bucketCounts(core_t::TTime time) const;
+    const TSizeSizePrUInt64FlatMap& bucketCounts(core_t::TTime time) const;
 
     //! Get the non-zero (person, attribute) pair counts for each
     //! value of influencing field.
@@ -349,6 +355,19 @@ public:
         }
     }
 
+    //! Remove the values in queue for the people or attributes
+    //! in \p toRemove.
+    template<typename F, typename T>
+    static void remove(const TSizeVec& toRemove,
+                       const F& extractId,
+                       CBucketQueue<CPersonAttributeFlatMap<T>>& queue) {
+        for (auto bucketItr = queue.begin(); bucketItr != queue.end(); ++bucketItr) {
+            bucketItr->removeIf([&](const auto& value) {
+                return std::binary_search(toRemove.begin(), toRemove.end(), extractId(value));
+            });
+        }
+    }
+
     //! Remove the values in queue for the people or attributes
     //! in \p toRemove.
     //!
@@ -444,7 +463,7 @@ private:
 
     //! The non-zero (person, attribute) pair counts in the current
     //! bucketing interval.
-    TSizeSizePrUInt64UMapQueue m_PersonAttributeCounts;
+    TSizeSizePrUInt64FlatMapQueue m_PersonAttributeCounts;
 
     //! A set per bucket that contains a (pid,cid) pair if at least
     //! one explicit null record has been seen.
@@ -104,6 +104,41 @@ public:
         this->push(item);
     }
 
+    //! Overload of push which moves \p item into the queue.
+    void push(T&& item, core_t::TTime time) {
+        if (time <= m_LatestBucketEnd) {
+            LOG_ERROR(<< "Push was called with early time = " << time
+                      << ", latest bucket end time = " << m_LatestBucketEnd);
+            return;
+        }
+        m_LatestBucketEnd += m_BucketLength;
+        m_Queue.push_front(std::move(item));
+        LOG_TRACE(<< "Queue after push -> " << *this);
+    }
+
+    //! Moves the time forward by bucket length reusing the earliest item
+    //! for the latest bucket. The item is passed to \p reset which should
+    //! return it to the state of an empty bucket. This avoids reallocating
+    //! the memory of items, such as maps, which retain their storage when
+    //! they're cleared. If the \p time is earlier than the latest bucket end,
+    //! the operation is ignored.
+    //!
+    //! \param[in] reset A function which takes the item to reuse.
+    //! \param[in] time The time to which the item corresponds.
+    template<typename RESET>
+    void recycle(RESET reset, core_t::TTime time) {
+        if (time <= m_LatestBucketEnd) {
+            LOG_ERROR(<< "Recycle was called with early time = " << time
+                      << ", latest bucket end time = " << m_LatestBucketEnd);
+            return;
+        }
+        m_LatestBucketEnd += m_BucketLength;
+        // The queue is always full so this is constant time.
+        m_Queue.rotate(m_Queue.end() - 1);
+        reset(m_Queue.front());
+        LOG_TRACE(<< "Queue after recycle -> " << *this);
+    }
+
     //! Pushes an item to the queue. This is only intended to be used
     //! internally and from clients that perform restoration of the queue.
     void push(const T& item) {
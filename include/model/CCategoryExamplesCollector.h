@@ -87,7 +87,7 @@ private:
 
     //! Truncate long examples to MAX_EXAMPLE_LENGTH bytes, appending an
     //! ellipsis to those that are truncated.
-    std::string truncateExample(std::string example);
+    std::string truncateExample(const std::string& example);
 
 private:
     //! The max number of examples that will be collected per category
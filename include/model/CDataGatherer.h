@@ -25,6 +25,7 @@
 #include <model/SModelParams.h>
 
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 
 #include <any>
 #include <cstdint>
@@ -106,14 +107,16 @@ public:
     using TStrVec = std::vector<std::string>;
     using TStrVecCItr = TStrVec::const_iterator;
     using TStrCPtrVec = std::vector<const std::string*>;
+    using TWord = CBucketGatherer::TWord;
+    using TWordVec = CBucketGatherer::TWordVec;
     using TSizeUInt64Pr = std::pair<std::size_t, std::uint64_t>;
     using TSizeUInt64PrVec = std::vector<TSizeUInt64Pr>;
     using TFeatureVec = model_t::TFeatureVec;
     using TSizeSizePr = std::pair<std::size_t, std::size_t>;
     using TSizeSizePrUInt64Pr = std::pair<TSizeSizePr, std::uint64_t>;
     using TSizeSizePrUInt64PrVec = std::vector<TSizeSizePrUInt64Pr>;
-    using TSizeSizePrUInt64UMap = boost::unordered_map<TSizeSizePr, std::uint64_t>;
-    using TSizeSizePrUInt64UMapQueue = CBucketQueue<TSizeSizePrUInt64UMap>;
+    using TSizeSizePrUInt64FlatMap = CBucketGatherer::TSizeSizePrUInt64FlatMap;
+    using TSizeSizePrUInt64FlatMapQueue = CBucketQueue<TSizeSizePrUInt64FlatMap>;
     using TSizeSizePrOptionalStrPrUInt64UMap = CBucketGatherer::TSizeSizePrOptionalStrPrUInt64UMap;
     using TSizeSizePrOptionalStrPrUInt64UMapVec = std::vector<TSizeSizePrOptionalStrPrUInt64UMap>;
     using TSizeSizePrOptionalStrPrUInt64UMapVecQueue =
@@ -125,6 +128,7 @@ public:
     using TMetricCategoryVec = std::vector<model_t::EMetricCategory>;
     using TSampleCountsPtr = std::unique_ptr<CSampleCounts>;
     using TTimeVec = std::vector<core_t::TTime>;
+    using TSizeUSet = boost::unordered_set<std::size_t>;
 
 public:
     //! The summary count indicating an explicit null record.
@@ -301,6 +305,15 @@ public:
     //! Record the arrival of \p data at \p time.
     bool addArrival(const TStrCPtrVec& fieldValues, CEventData& data, CResourceMonitor& resourceMonitor);
 
+    //! Record the arrival of \p data at \p time.
+    //!
+    //! \param[in] fieldWords The dictionary words of \p fieldValues or
+    //! empty, in which case they are computed as needed.
+    bool addArrival(const TStrCPtrVec& fieldValues,
+                    const TWordVec& fieldWords,
+                    CEventData& data,
+                    CResourceMonitor& resourceMonitor);
+
     //! Roll time to the end of the bucket that is latency after the sampled bucket.
     void sampleNow(core_t::TTime sampleBucketStart);
 
@@ -437,10 +450,26 @@ public:
     //! Check that the person is no longer being modeled.
     bool isPersonActive(std::size_t pid) const;
 
+    //! Check if the person identified by \p pid has received data since
+    //! the dirty people were last cleared.
+    bool isPersonDirty(std::size_t pid) const;
+
+    //! Mark every person as having received data.
+    void markAllPeopleDirty();
+
+    //! Mark every person as not having received data.
+    void clearDirtyPeople();
+
     //! Record a person called \p person.
     std::size_t addPerson(const std::string& person,
                           CResourceMonitor& resourceMonitor,
                           bool& addedPerson);
+
+    //! Record a person called \p person whose dictionary word is \p word.
+    std::size_t addPerson(const std::string& person,
+                          const TWord& word,
+                          CResourceMonitor& resourceMonitor,
+                          bool& addedPerson);
     //@}
 
     //! \name Attribute
@@ -548,13 +577,19 @@ public:
     std::size_t addAttribute(const std::string& attribute,
                              CResourceMonitor& resourceMonitor,
                              bool& addedAttribute);
+
+    //! Record a attribute called \p attribute whose dictionary word is \p word.
+    std::size_t addAttribute(const std::string& attribute,
+                             const TWord& word,
+                             CResourceMonitor& resourceMonitor,
+                             bool& addedAttribute);
     //@}
 
     //! \name Counts
     //@{
     //! Get the non-zero (person, attribute) pair counts in the
     //! bucketing interval corresponding to the given time.
-    const TSizeSizePrUInt64UMap& bucketCounts(core_t::TTime time) const;
+    const TSizeSizePrUInt64FlatMap& bucketCounts(core_t::TTime time) const;
 
     //! Get the non-zero (person, attribute) pair counts for each
     //! value of influencing field.
@@ -655,7 +690,7 @@ public:
     //! Helper to avoid code duplication when getting a metric value from a
     //! field.  Logs different errors for missing value and invalid value.
     bool extractMetricFromField(const std::string& fieldName,
-                                std::string fieldValue,
+                                const std::string& fieldValue,
                                 TDouble1Vec& metricValue) const;
 
     //! Returns the startTime of the earliest bucket for which data are still
@@ -742,6 +777,13 @@ private:
 
     //! The object responsible for managing sample counts.
     TSampleCountsPtr m_SampleCounts;
+
+    //! The people who have received data since the dirty people were
+    //! last cleared.
+    TSizeUSet m_DirtyPeople;
+
+    //! True if every person should be treated as having received data.
+    bool m_AllPeopleDirty{true};
 };
 }
 }
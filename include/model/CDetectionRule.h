@@ -32,10 +32,17 @@ class CAnomalyDetectorModel;
 //! The scope dictates to which series the rule applies.
 //! When conditions are present, they dictate to which results the rule applies
 //! depending the result's values. Multiple conditions are combined with a logical AND.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! The order in which the conditions are evaluated is fixed when they are added
+//! so that the cheapest are tested first: time conditions need no model values
+//! and actual values are cheaper to compute than typical ones. The values of the
+//! series are read at most once per application of the rule.
 class MODEL_EXPORT CDetectionRule {
 
 public:
     using TRuleConditionVec = std::vector<CRuleCondition>;
+    using TSizeVec = std::vector<std::size_t>;
 
     //! Rule actions can apply to skip results, skip model updates, or both.
     //! This is meant to work as a bit mask so added values should be powers of 2.
@@ -70,6 +77,9 @@ public:
 private:
     std::string printAction() const;
 
+    //! Get the relative cost of testing \p condition.
+    static int cost(const CRuleCondition& condition);
+
 private:
     //! The rule action. It works as a bit mask so its value
     //! may not match any of the declared enum values but the
@@ -81,6 +91,9 @@ private:
 
     //! The conditions that trigger the rule.
     TRuleConditionVec m_Conditions;
+
+    //! The indices of the conditions in the order they are tested.
+    TSizeVec m_ConditionOrder;
 };
 }
 }
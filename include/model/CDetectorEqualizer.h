@@ -36,10 +36,18 @@ class CModelConfig;
 //! for each detector. A corrected probability is obtained by converting
 //! raw probabilities to a rank and then reading off median probability
 //! for that rank over all detectors.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! The median probability over all detectors is tabulated for a grid of
+//! ranks so correcting a probability only needs to query the detector's
+//! own sketch. The table is recomputed when the sketches are aged, which
+//! happens once per bucket, or when their total count has grown by more
+//! than a small fraction since it was last computed.
 class MODEL_EXPORT CDetectorEqualizer {
 public:
     using TIntQuantileSketchPr = std::pair<int, maths::common::CQuantileSketch>;
     using TIntQuantileSketchPrVec = std::vector<TIntQuantileSketchPr>;
+    using TDoubleVec = std::vector<double>;
 
 public:
     //! Add \p probability to the detector's quantile sketch.
@@ -70,16 +78,37 @@ private:
     //! Get the sketch for \p detector.
     maths::common::CQuantileSketch& sketch(int detector);
 
+    //! Recompute the corrections if they're out-of-date.
+    //!
+    //! \return False if the probabilities shouldn't be corrected.
+    bool refreshCorrections();
+
+    //! Get the median minus log probability over all detectors for the
+    //! rank \p cdf.
+    double correction(double cdf) const;
+
 private:
     //! The maximum size of the quantile sketch.
     static const std::size_t SKETCH_SIZE;
     //! The minimum count in a detector's sketch for which we'll
     //! apply a correction to the probability.
     static const double MINIMUM_COUNT_FOR_CORRECTION;
+    //! The number of ranks for which we tabulate corrections.
+    static const std::size_t NUMBER_CORRECTIONS;
+    //! The fraction by which the total count can grow before the
+    //! corrections are recomputed.
+    static const double MAXIMUM_COUNT_GROWTH_FOR_CORRECTIONS;
 
 private:
     //! The sketches (one for each detector).
     TIntQuantileSketchPrVec m_Sketches;
+    //! The median minus log probability over all detectors for evenly
+    //! spaced ranks or empty if it needs to be recomputed.
+    TDoubleVec m_Corrections;
+    //! The total count in the sketches when the corrections were computed.
+    double m_CountAtCorrections{0.0};
+    //! The count added to the sketches since the corrections were computed.
+    double m_CountSinceCorrections{0.0};
 };
 }
 }
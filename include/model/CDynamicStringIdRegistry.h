@@ -39,9 +39,15 @@ class CResourceMonitor;
 //! The registry provides mapping from a registered string to its id and
 //! vice versa. In addition, the registry provides a recycling mechanism
 //! in order to reuse IDs whose mapped string is no longer relevant.
+//!
+//! Names are identified by their compressed dictionary words. These don't
+//! depend on the registry, so a record's field values can be hashed once,
+//! with word(), and looked up in every registry which needs them using the
+//! overloads which take a word.
 class MODEL_EXPORT CDynamicStringIdRegistry {
 public:
     using TDictionary = core::CCompressedDictionary<2>;
+    using TWord = TDictionary::CWord;
     using TWordSizeUMap = TDictionary::TWordTUMap<std::size_t>;
     using TWordSizeUMapItr = TWordSizeUMap::iterator;
     using TWordSizeUMapCItr = TWordSizeUMap::const_iterator;
@@ -87,6 +93,9 @@ public:
     //! \return True if the name exists and false otherwise.
     bool id(const std::string& name, std::size_t& result) const;
 
+    //! Overload of id for a name whose word, i.e. word(name), is \p word.
+    bool id(const TWord& word, std::size_t& result) const;
+
     //! Get the unique identifier of an arbitrary known name.
     //! \param[out] result Filled in with the identifier of a name
     //! \return True if a name exists and false otherwise.
@@ -108,6 +117,16 @@ public:
                         CResourceMonitor& resourceMonitor,
                         bool& addedPerson);
 
+    //! Overload of addName for a \p name whose word is \p word.
+    std::size_t addName(const std::string& name,
+                        const TWord& word,
+                        core_t::TTime time,
+                        CResourceMonitor& resourceMonitor,
+                        bool& addedPerson);
+
+    //! Get the word which identifies \p name in any registry.
+    static TWord word(const std::string& name);
+
     //! Remove all traces of names whose identifiers are greater than
     //! or equal to \p lowestNameToRemove.
     void removeNames(std::size_t lowestNameToRemove);
@@ -137,6 +156,69 @@ public:
     void acceptPersistInserter(core::CStatePersistInserter& inserter) const;
     bool acceptRestoreTraverser(core::CStateRestoreTraverser& traverser);
 
+private:
+    //! \brief An open addressing hash map from words to identifiers.
+    //!
+    //! DESCRIPTION:\n
+    //! The words and their identifiers are stored inline in a single array
+    //! using linear probing, so a lookup which hits usually reads one
+    //! cache line. The words are already good hashes so they're not hashed
+    //! again. Entries are erased by shifting back the entries which follow
+    //! them, so there are no tombstones.
+    class MODEL_EXPORT CUidMap {
+    public:
+        //! Get the identifier of \p word or INVALID_ID if it isn't present.
+        std::size_t find(const TWord& word) const;
+
+        //! Insert \p id for \p word if \p word isn't present.
+        //!
+        //! \return The identifier of \p word.
+        std::size_t emplace(const TWord& word, std::size_t id);
+
+        //! Remove \p word if it's present.
+        void erase(const TWord& word);
+
+        //! Get an arbitrary identifier or INVALID_ID if the map is empty.
+        std::size_t any() const;
+
+        //! Get all the identifiers.
+        TSizeVec ids() const;
+
+        //! Get the number of words.
+        std::size_t size() const;
+
+        //! Remove all words.
+        void clear();
+
+        //! Debug the memory used by this map.
+        void debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const;
+
+        //! Get the memory used by this map.
+        std::size_t memoryUsage() const;
+
+    private:
+        struct SSlot {
+            //! See core::CMemory.
+            static constexpr bool dynamicSizeAlwaysZero() { return true; }
+
+            TWord s_Word;
+            std::size_t s_Id{INVALID_ID};
+        };
+        using TSlotVec = std::vector<SSlot>;
+
+    private:
+        //! Get the slot containing \p word or the empty slot where it
+        //! would be inserted.
+        std::size_t slot(const TWord& word) const;
+
+        //! Double the number of slots.
+        void grow();
+
+    private:
+        TSlotVec m_Slots;
+        std::size_t m_Size{0};
+    };
+
 private:
     //! The type of the names expected to be registered.
     std::string m_NameType;
@@ -151,13 +233,10 @@ private:
     //! The statistic to be increased when an ID is recycled.
     counter_t::ECounterTypes m_RecycledCounter;
 
-    //! A compressed dictionary.
-    TDictionary m_Dictionary;
-
     //! Holds a unique identifier for each registered name which means
     //! we can use direct address tables and fast hash maps and
     //! sets keyed by names.
-    TWordSizeUMap m_Uids;
+    CUidMap m_Uids;
 
     //! Holds the name of each unique identifier.
     TStrVec m_Names;
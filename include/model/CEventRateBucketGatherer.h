@@ -216,6 +216,7 @@ public:
     //! field value. The second field should the by clause field value
     //! or a generic name if none was specified.
     bool processFields(const TStrCPtrVec& fieldValues,
+                       const TWordVec& fieldWords,
                        CEventData& result,
                        CResourceMonitor& resourceMonitor) override;
     //@}
@@ -23,9 +23,11 @@
 #include <boost/unordered_set.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace json = boost::json;
 
@@ -50,6 +52,7 @@ class MODEL_EXPORT CForecastDataSink final : private core::CNonCopyable {
 public:
     using TMathsModelPtr = std::shared_ptr<maths::common::CModel>;
     using TStrUMap = boost::unordered_set<std::string>;
+    using TErrorBarVec = std::vector<maths::common::SErrorBar>;
     struct SForecastResultSeries;
 
     //! \brief Wrapper which supports creating a forecast for a single
@@ -74,6 +77,26 @@ public:
                       CForecastDataSink& sink,
                       std::string& message) const;
 
+        //! Forecast collecting the error bars in \p errorBars rather than
+        //! writing them to a sink. This is thread safe for distinct models.
+        bool forecast(core_t::TTime startTime,
+                      core_t::TTime endTime,
+                      double boundsPercentile,
+                      TErrorBarVec& errorBars,
+                      std::string& message) const;
+
+        //! Write \p errorBars computed by forecast to \p sink.
+        void write(const SForecastResultSeries& series,
+                   const TErrorBarVec& errorBars,
+                   CForecastDataSink& sink) const;
+
+    private:
+        bool doForecast(core_t::TTime startTime,
+                        core_t::TTime endTime,
+                        double boundsPercentile,
+                        const std::function<void(maths::common::SErrorBar)>& push,
+                        std::string& message) const;
+
     private:
         model_t::EFeature m_Feature;
         std::string m_ByFieldValue;
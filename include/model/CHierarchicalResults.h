@@ -12,6 +12,7 @@
 #ifndef INCLUDED_ml_model_CHierarchicalResults_h
 #define INCLUDED_ml_model_CHierarchicalResults_h
 
+#include <core/CMonotonicArena.h>
 #include <core/CSmallVector.h>
 
 #include <maths/common/COrderings.h>
@@ -242,11 +243,17 @@ public:
     using TNode = hierarchical_results_detail::SNode;
     using TNodePtrSizeUMap = hierarchical_results_detail::SNode::TNodePtrSizeUMap;
     using TSizeNodePtrUMap = hierarchical_results_detail::SNode::TSizeNodePtrUMap;
-    using TNodeDeque = std::deque<TNode>;
+    using TNodeDeque = std::deque<TNode, core::CMonotonicArenaAllocator<TNode>>;
     using TOptionalStrOptionalStrPrNodeMap =
-        std::map<TOptionalStrOptionalStrPr, TNode, maths::common::COrderings::SLess>;
+        std::map<TOptionalStrOptionalStrPr,
+                 TNode,
+                 maths::common::COrderings::SLess,
+                 core::CMonotonicArenaAllocator<std::pair<const TOptionalStrOptionalStrPr, TNode>>>;
     using TOptionalStrNodeMap =
-        std::map<TOptionalStr, TNode, maths::common::COrderings::SLess>;
+        std::map<TOptionalStr,
+                 TNode,
+                 maths::common::COrderings::SLess,
+                 core::CMonotonicArenaAllocator<std::pair<const TOptionalStr, TNode>>>;
 
 public:
     CHierarchicalResults();
@@ -307,6 +314,14 @@ public:
     //! Add the influencer called \p name.
     void addInfluencer(const std::string& name);
 
+    //! Move the results in \p other to the end of these results.
+    //!
+    //! This is used to combine results which have been built separately,
+    //! for example by different detectors, in a fixed order.
+    //!
+    //! \note Neither set of results can have had their hierarchy built.
+    void append(CHierarchicalResults&& other);
+
     //! Build a hierarchy from the current flat node list using the
     //! default aggregation rules.
     //!
@@ -379,6 +394,14 @@ private:
     void postorderDepthFirst(const TNode* node, CHierarchicalResultsVisitor& visitor) const;
 
 private:
+    //! The arena from which the node storage is allocated. The nodes are
+    //! all created while the results are built for a bucket and destroyed
+    //! together with the results, so the storage is freed in one go rather
+    //! than node by node.
+    //!
+    //! \note This must be declared before the containers which use it.
+    core::CMonotonicArena m_Arena;
+
     //! Storage for the nodes.
     TNodeDeque m_Nodes;
 
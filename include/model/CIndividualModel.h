@@ -17,6 +17,7 @@
 #include <core/CoreTypes.h>
 
 #include <model/CAnomalyDetectorModel.h>
+#include <model/CLastBucketTimeIndex.h>
 #include <model/CMemoryUsageEstimator.h>
 #include <model/ImportExport.h>
 
@@ -49,6 +50,8 @@ class CProbabilityAndInfluenceCalculator;
 class MODEL_EXPORT CIndividualModel : public CAnomalyDetectorModel {
 public:
     using TSizeTimeUMap = boost::unordered_map<std::size_t, core_t::TTime>;
+    using TSizeTimePr = std::pair<std::size_t, core_t::TTime>;
+    using TSizeTimePrVec = std::vector<TSizeTimePr>;
     using TTimeVec = std::vector<core_t::TTime>;
     using TSizeUInt64Pr = std::pair<std::size_t, uint64_t>;
     using TSizeUInt64PrVec = std::vector<TSizeUInt64Pr>;
@@ -198,6 +201,9 @@ protected:
     //! Create the time series models for "n" newly observed people.
     void createNewModels(std::size_t n, std::size_t m) override;
 
+    //! Set the memory cost of each new person from the prototype models.
+    void initializeMarginalMemoryCosts();
+
     //! Reinitialize the time series models for recycled people.
     void updateRecycledModels() override;
 
@@ -212,6 +218,15 @@ protected:
     template<typename T>
     void currentBucketPersonIds(core_t::TTime time, const T& featureData, TSizeVec& result) const;
 
+    //! Get the last bucket times, before they're updated by sampling, of the
+    //! people which have a value in \p featureData sorted by person identifier.
+    template<typename T>
+    void lastBucketTimesBeforeSampling(const T& featureData, TSizeTimePrVec& result) const;
+
+    //! Look up the last bucket time of \p pid in \p lastBucketTimes which was
+    //! computed by lastBucketTimesBeforeSampling.
+    static core_t::TTime lastBucketTime(std::size_t pid, const TSizeTimePrVec& lastBucketTimes);
+
     //! Get the value of the \p feature of the person identified
     //! by \p pid for the bucketing interval containing \p time.
     template<typename T>
@@ -276,6 +291,9 @@ private:
     //! Get the total number of correlation models.
     std::size_t numberCorrelations() const;
 
+    //! Returns true if there are no correlation models.
+    bool canReuseInterimResults() const override;
+
     //! Returns one.
     double attributeFrequency(std::size_t cid) const override;
 
@@ -292,6 +310,9 @@ private:
     //! The last time that each person was seen.
     TTimeVec m_LastBucketTimes;
 
+    //! The people ordered by the last time they were seen.
+    CLastBucketTimeIndex m_LastBucketTimeIndex;
+
     //! The models of all the correlates for each feature.
     //!
     //! IMPORTANT this must come before m_FeatureModels in the class declaration
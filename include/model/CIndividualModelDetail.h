@@ -18,6 +18,8 @@
 
 #include <boost/unordered_set.hpp>
 
+#include <algorithm>
+
 namespace ml {
 namespace model {
 
@@ -45,6 +47,21 @@ void CIndividualModel::currentBucketPersonIds(core_t::TTime time,
     result.assign(people.begin(), people.end());
 }
 
+template<typename T>
+void CIndividualModel::lastBucketTimesBeforeSampling(const T& featureData,
+                                                     TSizeTimePrVec& result) const {
+    result.clear();
+    for (const auto& feature : featureData) {
+        for (const auto& data : feature.second) {
+            std::size_t pid{data.first};
+            result.emplace_back(pid, m_LastBucketTimes[pid]);
+        }
+    }
+    // The data for each feature are usually sorted by person so this is cheap.
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
 template<typename T>
 const T* CIndividualModel::featureData(
     model_t::EFeature feature,
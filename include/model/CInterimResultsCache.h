@@ -0,0 +1,91 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#ifndef INCLUDED_ml_model_CInterimResultsCache_h
+#define INCLUDED_ml_model_CInterimResultsCache_h
+
+#include <core/CMemoryUsage.h>
+#include <core/CoreTypes.h>
+
+#include <model/CAnnotatedProbability.h>
+#include <model/ImportExport.h>
+
+#include <boost/unordered_map.hpp>
+
+#include <cstddef>
+
+namespace ml {
+namespace model {
+
+//! \brief Caches the interim results of the people in the current bucket.
+//!
+//! DESCRIPTION:\n
+//! Interim results can be requested many times for the same bucket. Any
+//! person who hasn't received data since the last request has the same
+//! result as before, so long as the models haven't been updated and the
+//! estimated completeness of the bucket used to correct interim values
+//! hasn't changed. This lets the model reuse those people's results.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! The cache doesn't know which people have received data: that is
+//! tracked by the data gatherer. It is the owner's responsibility to
+//! clear the cache whenever the models are sampled.
+class MODEL_EXPORT CInterimResultsCache {
+public:
+    //! Prepare to add or look up the results for the bucket starting at
+    //! \p time given the bucket \p completeness. The cached results are
+    //! discarded if either has changed.
+    void bucket(core_t::TTime time, double completeness);
+
+    //! Get the cached result for \p pid if there is one.
+    //!
+    //! \param[out] computed Set to whether a probability could be computed.
+    //! \param[out] result Filled in with the cached result if \p computed.
+    //! \return False if there isn't a cached result for \p pid.
+    bool find(std::size_t pid, bool& computed, SAnnotatedProbability& result) const;
+
+    //! Cache the \p result for \p pid.
+    void add(std::size_t pid, bool computed, const SAnnotatedProbability& result);
+
+    //! Remove all cached results.
+    void clear();
+
+    //! Get the number of cached results.
+    std::size_t size() const;
+
+    //! Debug the memory used by this object.
+    void debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const;
+
+    //! Get the memory used by this object.
+    std::size_t memoryUsage() const;
+
+private:
+    //! \brief The cached result of a single person.
+    struct SResult {
+        std::size_t memoryUsage() const;
+
+        bool s_Computed;
+        SAnnotatedProbability s_Probability;
+    };
+    using TSizeResultUMap = boost::unordered_map<std::size_t, SResult>;
+
+private:
+    //! The start of the bucket for which results are cached.
+    core_t::TTime m_Time{0};
+    //! The bucket completeness for which results are cached.
+    double m_Completeness{1.0};
+    //! The cached results.
+    TSizeResultUMap m_Results;
+};
+}
+}
+
+#endif // INCLUDED_ml_model_CInterimResultsCache_h
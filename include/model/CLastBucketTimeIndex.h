@@ -0,0 +1,130 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#ifndef INCLUDED_ml_model_CLastBucketTimeIndex_h
+#define INCLUDED_ml_model_CLastBucketTimeIndex_h
+
+#include <core/CMemoryUsage.h>
+#include <core/CoreTypes.h>
+
+#include <model/ImportExport.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ml {
+namespace model {
+
+//! \brief Orders identifiers by the last bucket in which they were seen.
+//!
+//! DESCRIPTION:\n
+//! This shadows a collection of last bucket times, indexed by person or
+//! attribute identifier, so that the identifiers which haven't been seen
+//! for longer than the prune window can be found without visiting every
+//! identifier. The cost of finding expired identifiers is proportional to
+//! the number of entries which have expired since the last query.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! Bucket times are added in time order so the entries are kept in a queue
+//! sorted by time, which is a vector and the position of its front, and an
+//! identifier's old entry is left in place when it is seen again. Entries are checked against the last bucket times when they
+//! reach the front of the queue and discarded if they are out-of-date. The
+//! index is rebuilt from the last bucket times if a time is added out of
+//! order, if the times are shifted or if the out-of-date entries come to
+//! dominate the queue. It is not persisted and is rebuilt on first use.
+class MODEL_EXPORT CLastBucketTimeIndex {
+public:
+    using TSizeVec = std::vector<std::size_t>;
+    using TTimeVec = std::vector<core_t::TTime>;
+
+public:
+    //! Record that \p id was last seen in the bucket starting at \p time.
+    //!
+    //! \note This should only be called when the last bucket time of \p id
+    //! changes.
+    void add(std::size_t id, core_t::TTime time);
+
+    //! Mark the index to be rebuilt the next time it is queried.
+    void invalidate();
+
+    //! Remove the identifiers which haven't been seen for more than
+    //! \p maximumAge buckets at \p time from the index and add them to
+    //! \p result.
+    //!
+    //! \param[in] lastBucketTimes The last bucket times which the index
+    //! shadows.
+    //! \param[in] isActive Returns true if an identifier is in use.
+    template<typename ACTIVE>
+    void removeExpired(core_t::TTime time,
+                       core_t::TTime bucketLength,
+                       std::size_t maximumAge,
+                       const TTimeVec& lastBucketTimes,
+                       const ACTIVE& isActive,
+                       TSizeVec& result) {
+        if (m_Valid == false) {
+            this->rebuild(lastBucketTimes);
+        }
+        std::size_t n{result.size()};
+        for (/**/; m_Front < m_Entries.size(); ++m_Front) {
+            auto[last, id] = m_Entries[m_Front];
+            if (last >= time ||
+                static_cast<std::size_t>((time - last) / bucketLength) <= maximumAge) {
+                break;
+            }
+            if (id < lastBucketTimes.size() && lastBucketTimes[id] == last && isActive(id)) {
+                result.push_back(id);
+            }
+        }
+        this->purgeFront();
+        std::sort(result.begin() + n, result.end());
+        result.erase(std::unique(result.begin() + n, result.end()), result.end());
+    }
+
+    //! Get the number of entries in the index.
+    std::size_t size() const;
+
+    //! Debug the memory used by this object.
+    void debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const;
+
+    //! Get the memory used by this object.
+    std::size_t memoryUsage() const;
+
+private:
+    using TTimeSizePr = std::pair<core_t::TTime, std::size_t>;
+    using TTimeSizePrVec = std::vector<TTimeSizePr>;
+
+private:
+    //! The minimum number of entries before out-of-date entries are purged.
+    static const std::size_t MINIMUM_SIZE_TO_PURGE;
+
+private:
+    //! Rebuild the index from \p lastBucketTimes.
+    void rebuild(const TTimeVec& lastBucketTimes);
+
+    //! Erase the removed entries if they take up most of the queue.
+    void purgeFront();
+
+private:
+    //! The (last bucket time, identifier) pairs sorted by time.
+    TTimeSizePrVec m_Entries;
+    //! The position of the first entry which hasn't been removed.
+    std::size_t m_Front{0};
+    //! One more than the largest identifier added.
+    std::size_t m_IdBound{0};
+    //! False if the index must be rebuilt before it is next queried.
+    bool m_Valid{false};
+};
+}
+}
+
+#endif // INCLUDED_ml_model_CLastBucketTimeIndex_h
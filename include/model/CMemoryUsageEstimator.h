@@ -42,6 +42,11 @@ namespace model {
 //! forming the input matrix A, which is solved for the memory usage
 //! calculations in vector B.
 //! See http://eigen.tuxfamily.org/dox-devel/group__LeastSquares.html
+//!
+//! Until there are enough values to fit the regression, estimates are made
+//! by extrapolating from the last value using the marginal cost of each
+//! predictor, if the model has supplied these. This means only one full
+//! memory calculation is needed when a model is created or restored.
 class MODEL_EXPORT CMemoryUsageEstimator {
 public:
     //! Enumeration of the components included in the memory estimate.
@@ -53,6 +58,7 @@ public:
     };
     using TSizeArray = std::array<std::size_t, E_NumberPredictors>;
     using TOptionalSize = std::optional<std::size_t>;
+    using TOptionalSizeArray = std::array<TOptionalSize, E_NumberPredictors>;
 
 public:
     //! Constructor
@@ -70,6 +76,12 @@ public:
     //! the predictors.
     void addValue(const TSizeArray& predictors, std::size_t memory);
 
+    //! Set the memory used per unit of each predictor.
+    //!
+    //! A cost which is unset means the cost of that predictor is unknown
+    //! and estimates for a change in its value need the regression.
+    void marginalCosts(const TOptionalSizeArray& costs);
+
     //! Debug the memory used by this component.
     void debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const;
 
@@ -91,6 +103,9 @@ private:
     //! Get the maximum amount by which we'll extrapolate the memory usage.
     std::size_t maximumExtrapolation(EComponent component) const;
 
+    //! Estimate the memory usage from the last value and the marginal costs.
+    TOptionalSize estimateFromMarginalCosts(const TSizeArray& predictors) const;
+
 private:
     //! The map of memory component values -> memory usage values
     TSizeArraySizePrBuf m_Values;
@@ -98,6 +113,9 @@ private:
     //! The number of times estimate has been called since the last
     //! real value was added
     std::size_t m_NumEstimatesSinceValue;
+
+    //! The memory used per unit of each predictor, where known.
+    TOptionalSizeArray m_MarginalCosts;
 };
 
 } // model
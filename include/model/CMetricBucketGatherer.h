@@ -166,6 +166,7 @@ public:
     //! specified. The third field should contain a number corresponding
     //! to the metric value.
     bool processFields(const TStrCPtrVec& fieldValues,
+                       const TWordVec& fieldWords,
                        CEventData& result,
                        CResourceMonitor& resourceMonitor) override;
     //@}
@@ -31,6 +31,7 @@ class CModel;
 }
 namespace model {
 class CAnomalyDetectorModel;
+class CModelPlotBoundsCache;
 class CModelPlotData;
 class CEventRateModel;
 class CEventRatePopulationModel;
@@ -72,6 +73,16 @@ public:
                    const TStrSet& terms,
                    CModelPlotData& modelPlotData) const;
 
+    //! Get data for creating a model plot error bar at \p time reusing the
+    //! bounds in \p boundsCache where possible.
+    //!
+    //! \note Any bounds which are computed are added to \p boundsCache.
+    void modelPlot(core_t::TTime time,
+                   double boundsPercentile,
+                   const TStrSet& terms,
+                   CModelPlotBoundsCache& boundsCache,
+                   CModelPlotData& modelPlotData) const;
+
     //! Get the time interval from the first to last data point of \p byFieldId.
     virtual TTimeTimePr dataTimeInterval(std::size_t byFieldId) const = 0;
 
@@ -80,6 +91,13 @@ public:
                                                std::size_t byFieldId) const = 0;
 
 private:
+    //! Get the model plot data at \p time, using \p boundsCache if non-null.
+    void modelPlot(core_t::TTime time,
+                   double boundsPercentile,
+                   const TStrSet& terms,
+                   CModelPlotBoundsCache* boundsCache,
+                   CModelPlotData& modelPlotData) const;
+
     //! Add the model plot data for all by field values which match \p terms.
     void addCurrentBucketValues(core_t::TTime time,
                                 model_t::EFeature feature,
@@ -91,6 +109,7 @@ private:
                                double boundsPercentile,
                                model_t::EFeature feature,
                                std::size_t byFieldId,
+                               CModelPlotBoundsCache* boundsCache,
                                CModelPlotData& modelPlotData) const;
 
     //! Get the underlying model.
@@ -12,13 +12,17 @@
 #ifndef INCLUDED_ml_model_CModelPlotData_h
 #define INCLUDED_ml_model_CModelPlotData_h
 
+#include <core/CMemoryUsage.h>
+
 #include <model/ImportExport.h>
 
 #include <model/ModelTypes.h>
 
 #include <boost/unordered_map.hpp>
 
+#include <cstddef>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ml {
@@ -84,6 +88,92 @@ private:
     core_t::TTime m_BucketSpan;
     int m_DetectorIndex;
 };
+
+//! \brief Caches the model plot bounds of each time series.
+//!
+//! DESCRIPTION:\n
+//! Computing the model plot bounds needs quantiles of each time series'
+//! residual distribution, which dominates the cost of model plot for jobs
+//! with many series. This lets the bounds of each series be recomputed once
+//! every cadence buckets and reused in between.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! The buckets in which the series' bounds are recomputed are staggered by
+//! by field identifier so the cost is spread evenly over buckets. Entries
+//! are keyed by by field identifier and also check the by field value so
+//! bounds aren't reused if an identifier is recycled. A cadence of one, the
+//! default, recomputes every bucket and caches nothing.
+class MODEL_EXPORT CModelPlotBoundsCache {
+public:
+    using SByFieldData = CModelPlotData::SByFieldData;
+
+public:
+    explicit CModelPlotBoundsCache(core_t::TTime bucketLength);
+
+    //! Set the number of buckets between recomputing each series' bounds.
+    void cadence(std::size_t cadence);
+
+    //! Get the number of buckets between recomputing each series' bounds.
+    std::size_t cadence() const;
+
+    //! Get the bounds of \p feature for \p byFieldId in \p result if they
+    //! can be reused at \p time.
+    //!
+    //! \return False if the bounds must be recomputed.
+    bool bounds(model_t::EFeature feature,
+                std::size_t byFieldId,
+                const std::string& byFieldValue,
+                core_t::TTime time,
+                SByFieldData& result) const;
+
+    //! Cache the \p bounds of \p feature for \p byFieldId computed at \p time.
+    void add(model_t::EFeature feature,
+             std::size_t byFieldId,
+             const std::string& byFieldValue,
+             core_t::TTime time,
+             const SByFieldData& bounds);
+
+    //! Remove the bounds which can't be reused at or after \p time.
+    void prune(core_t::TTime time);
+
+    //! Remove all cached bounds.
+    void clear();
+
+    //! Get the number of cached bounds.
+    std::size_t size() const;
+
+    //! Debug the memory used by this object.
+    void debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const;
+
+    //! Get the memory used by this object.
+    std::size_t memoryUsage() const;
+
+private:
+    //! \brief The cached bounds of a single series.
+    struct SBounds {
+        std::size_t memoryUsage() const;
+
+        std::string s_ByFieldValue;
+        core_t::TTime s_Time;
+        double s_LowerBound;
+        double s_UpperBound;
+        double s_Median;
+    };
+    using TFeatureSizePr = std::pair<model_t::EFeature, std::size_t>;
+    using TFeatureSizePrBoundsUMap = boost::unordered_map<TFeatureSizePr, SBounds>;
+
+private:
+    //! Check if bounds computed at \p computed can't be reused at \p time.
+    bool stale(core_t::TTime computed, core_t::TTime time) const;
+
+private:
+    //! The bucket length.
+    core_t::TTime m_BucketLength;
+    //! The number of buckets between recomputing each series' bounds.
+    std::size_t m_Cadence{1};
+    //! The cached bounds.
+    TFeatureSizePrBoundsUMap m_Bounds;
+};
 }
 }
 
@@ -0,0 +1,226 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#ifndef INCLUDED_ml_model_CPersonAttributeFlatMap_h
+#define INCLUDED_ml_model_CPersonAttributeFlatMap_h
+
+#include <core/CContainerPrinter.h>
+#include <core/CMemoryDefStd.h>
+#include <core/CMemoryUsage.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ml {
+namespace model {
+
+//! \brief A flat map from (person, attribute) identifier pairs to values
+//! for data gathered for a single bucket.
+//!
+//! DESCRIPTION:\n
+//! The entries are stored contiguously in a vector and are located with a
+//! separate open addressing index of 32 bit positions into that vector using
+//! linear probing. Compared to a node based map this avoids an allocation
+//! per entry, keeps lookups to one or two cache lines and makes iterating
+//! the entries a scan of contiguous memory.
+//!
+//! Clearing the map keeps its capacity, so a map which is reused for each
+//! bucket stops allocating once it has reached the size of a typical bucket.
+//!
+//! The entries are iterated in insertion order. The map tracks whether this
+//! is also the order of their identifiers and sort() sorts the entries in
+//! place when it isn't. This allows clients which need the entries in
+//! identifier order to avoid sorting, or copying them to sort, every time
+//! they are read.
+//!
+//! IMPLEMENTATION DECISIONS:\n
+//! Only const iteration is supported because modifying a key would corrupt
+//! the index. Values are modified through operator[].
+//!
+//! The keys and values are kept together because every client of bucket
+//! data reads both. The index is stored separately so probing only touches
+//! the index and the entry it finally matches.
+template<typename VALUE>
+class CPersonAttributeFlatMap {
+public:
+    using TSizeSizePr = std::pair<std::size_t, std::size_t>;
+    using key_type = TSizeSizePr;
+    using mapped_type = VALUE;
+    using value_type = std::pair<TSizeSizePr, VALUE>;
+    using TValueVec = std::vector<value_type>;
+    using const_iterator = typename TValueVec::const_iterator;
+    using iterator = const_iterator;
+    using size_type = std::size_t;
+
+public:
+    //! The \p n argument is accepted for compatibility with the maps this
+    //! replaces. Storage is allocated on first insertion.
+    explicit CPersonAttributeFlatMap(std::size_t /*n*/ = 0) {}
+
+    const_iterator begin() const { return m_Entries.begin(); }
+    const_iterator end() const { return m_Entries.end(); }
+
+    std::size_t size() const { return m_Entries.size(); }
+    bool empty() const { return m_Entries.empty(); }
+
+    //! Remove all entries retaining the allocated storage.
+    void clear() {
+        m_Entries.clear();
+        std::fill(m_Index.begin(), m_Index.end(), EMPTY);
+        m_Sorted = true;
+    }
+
+    //! Ensure there is space for \p n entries without reallocating.
+    void reserve(std::size_t n) {
+        m_Entries.reserve(n);
+        if (2 * n > m_Index.size()) {
+            this->rehash(2 * n);
+        }
+    }
+
+    //! Find the entry for \p key if there is one.
+    const_iterator find(const TSizeSizePr& key) const {
+        if (m_Entries.empty()) {
+            return m_Entries.end();
+        }
+        std::size_t mask{m_Index.size() - 1};
+        for (std::size_t slot = hash(key) & mask; /**/; slot = (slot + 1) & mask) {
+            std::uint32_t position{m_Index[slot]};
+            if (position == EMPTY) {
+                return m_Entries.end();
+            }
+            if (m_Entries[position].first == key) {
+                return m_Entries.begin() + position;
+            }
+        }
+    }
+
+    //! Get the number of entries for \p key, i.e. one or zero.
+    std::size_t count(const TSizeSizePr& key) const {
+        return this->find(key) == m_Entries.end() ? 0 : 1;
+    }
+
+    //! Get the value for \p key inserting a value initialised one if there
+    //! isn't one.
+    VALUE& operator[](const TSizeSizePr& key) {
+        if (2 * (m_Entries.size() + 1) > m_Index.size()) {
+            this->rehash(std::max(2 * m_Index.size(), MINIMUM_INDEX_SIZE));
+        }
+        std::size_t mask{m_Index.size() - 1};
+        std::size_t slot{hash(key) & mask};
+        for (/**/; m_Index[slot] != EMPTY; slot = (slot + 1) & mask) {
+            value_type& entry{m_Entries[m_Index[slot]]};
+            if (entry.first == key) {
+                return entry.second;
+            }
+        }
+        if (m_Entries.empty() == false && key < m_Entries.back().first) {
+            m_Sorted = false;
+        }
+        m_Index[slot] = static_cast<std::uint32_t>(m_Entries.size());
+        m_Entries.emplace_back(key, VALUE{});
+        return m_Entries.back().second;
+    }
+
+    //! Remove the entries for which \p pred is true preserving the order
+    //! of the remaining entries.
+    template<typename PRED>
+    void removeIf(const PRED& pred) {
+        auto last = std::remove_if(m_Entries.begin(), m_Entries.end(), pred);
+        if (last != m_Entries.end()) {
+            m_Entries.erase(last, m_Entries.end());
+            this->reindex();
+        }
+    }
+
+    //! Check if the entries are iterated in identifier order.
+    bool isSorted() const { return m_Sorted; }
+
+    //! Sort the entries into identifier order if they aren't already.
+    void sort() {
+        if (m_Sorted == false) {
+            std::sort(m_Entries.begin(), m_Entries.end(),
+                      [](const value_type& lhs, const value_type& rhs) {
+                          return lhs.first < rhs.first;
+                      });
+            this->reindex();
+            m_Sorted = true;
+        }
+    }
+
+    //! Debug the memory used by this object.
+    void debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const {
+        mem->setName("CPersonAttributeFlatMap");
+        core::memory_debug::dynamicSize("m_Entries", m_Entries, mem);
+        core::memory_debug::dynamicSize("m_Index", m_Index, mem);
+    }
+
+    //! Get the memory used by this object.
+    std::size_t memoryUsage() const {
+        return core::memory::dynamicSize(m_Entries) + core::memory::dynamicSize(m_Index);
+    }
+
+    //! Print the entries.
+    std::string print() const { return core::CContainerPrinter::print(m_Entries); }
+
+private:
+    using TUInt32Vec = std::vector<std::uint32_t>;
+
+private:
+    static constexpr std::uint32_t EMPTY{0xffffffff};
+    static constexpr std::size_t MINIMUM_INDEX_SIZE{16};
+
+private:
+    static std::size_t hash(const TSizeSizePr& key) {
+        std::uint64_t result{static_cast<std::uint64_t>(key.first) * 0x9e3779b97f4a7c15ULL ^
+                             static_cast<std::uint64_t>(key.second) * 0xc2b2ae3d27d4eb4fULL};
+        return static_cast<std::size_t>(result ^ (result >> 29));
+    }
+
+    //! Resize the index to the power of two at least \p n and reindex.
+    void rehash(std::size_t n) {
+        std::size_t size{MINIMUM_INDEX_SIZE};
+        while (size < n) {
+            size *= 2;
+        }
+        m_Index.assign(size, EMPTY);
+        this->reindex();
+    }
+
+    //! Rebuild the index from the entries.
+    void reindex() {
+        std::fill(m_Index.begin(), m_Index.end(), EMPTY);
+        std::size_t mask{m_Index.size() - 1};
+        for (std::size_t i = 0; i < m_Entries.size(); ++i) {
+            std::size_t slot{hash(m_Entries[i].first) & mask};
+            while (m_Index[slot] != EMPTY) {
+                slot = (slot + 1) & mask;
+            }
+            m_Index[slot] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+private:
+    //! The entries in iteration order.
+    TValueVec m_Entries;
+    //! The open addressing index of positions in m_Entries.
+    TUInt32Vec m_Index;
+    //! True if m_Entries is in identifier order.
+    bool m_Sorted{true};
+};
+}
+}
+
+#endif // INCLUDED_ml_model_CPersonAttributeFlatMap_h
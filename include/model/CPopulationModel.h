@@ -20,6 +20,8 @@
 #include <maths/time_series/CCountMinSketch.h>
 
 #include <model/CAnomalyDetectorModel.h>
+#include <model/CLastBucketTimeIndex.h>
+#include <model/CMemoryUsageEstimator.h>
 #include <model/ImportExport.h>
 #include <model/ModelTypes.h>
 
@@ -224,6 +226,11 @@ protected:
     //! and "m" newly observed attributes.
     void createNewModels(std::size_t n, std::size_t m) override = 0;
 
+    //! Get the memory cost of each new person and attribute given the
+    //! prototype \p featureModels.
+    CMemoryUsageEstimator::TOptionalSizeArray
+    marginalMemoryCosts(const TFeatureModelsVec& featureModels) const;
+
     //! Initialize the time series models for recycled attributes
     //! and/or people.
     void updateRecycledModels() override = 0;
@@ -256,10 +263,13 @@ protected:
                       T& data) const;
 
     //! Get the people and attributes to remove if any.
+    //!
+    //! \note These are removed from the last bucket time indices so the
+    //! caller must recycle them.
     void peopleAndAttributesToRemove(core_t::TTime time,
                                      std::size_t maximumAge,
                                      TSizeVec& peopleToRemove,
-                                     TSizeVec& attributesToRemove) const;
+                                     TSizeVec& attributesToRemove);
 
     //! Remove the \p people.
     void removePeople(const TSizeVec& peopleToRemove);
@@ -280,6 +290,12 @@ private:
     //! The last time each attribute was seen.
     TTimeVec m_AttributeLastBucketTimes;
 
+    //! The people ordered by the last time they were seen.
+    CLastBucketTimeIndex m_PersonLastBucketTimeIndex;
+
+    //! The attributes ordered by the last time they were seen.
+    CLastBucketTimeIndex m_AttributeLastBucketTimeIndex;
+
     //! The initial sketch to use for estimating the number of distinct people.
     maths::common::CBjkstUniqueValues m_NewDistinctPersonCounts;
 
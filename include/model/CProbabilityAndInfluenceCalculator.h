@@ -18,6 +18,8 @@
 #include <model/ImportExport.h>
 #include <model/ModelTypes.h>
 
+#include <boost/unordered_map.hpp>
+
 #include <string>
 #include <utility>
 #include <vector>
@@ -84,6 +86,62 @@ public:
     using TOptionalStr1Vec = core::CSmallVector<TOptionalStr, 1>;
     using TAnomalyScoreExplanation = maths::common::SAnomalyScoreExplanation;
 
+    //! \brief Memoizes the probabilities computed to find the influences
+    //! on a single feature value.
+    //!
+    //! DESCRIPTION:\n
+    //! The influence of an influencer field value is found by computing the
+    //! probability of the feature value for the records with that value. The
+    //! probability of the overall feature value is computed once for every
+    //! influencer field and influencer values of different fields often have
+    //! identical statistics, for example when one field is derived from, or
+    //! determines, another. This caches the probabilities so each of these is
+    //! only computed once.
+    //!
+    //! IMPLEMENTATION DECISIONS:\n
+    //! The probability calculation parameters, times and values are flattened
+    //! into the key. This is everything which can vary between the calculations
+    //! for a single feature value of one model, so a cache must not be shared
+    //! between feature values or models.
+    class MODEL_EXPORT CInfluenceProbabilityCache {
+    public:
+        //! Lookup the probability of \p value at \p time computed using
+        //! \p params if it has been cached.
+        bool lookup(const maths::common::CModelProbabilityParams& params,
+                    const TTime2Vec1Vec& time,
+                    const TDouble2Vec1Vec& value,
+                    double& probability);
+
+        //! Cache the probability of \p value at \p time computed using
+        //! \p params.
+        void add(const maths::common::CModelProbabilityParams& params,
+                 const TTime2Vec1Vec& time,
+                 const TDouble2Vec1Vec& value,
+                 double probability);
+
+        //! Get the number of cached probabilities.
+        std::size_t size() const;
+
+        //! Remove all cached probabilities.
+        void clear();
+
+    private:
+        using TDoubleVec = std::vector<double>;
+        using TDoubleVecDoubleUMap = boost::unordered_map<TDoubleVec, double>;
+
+    private:
+        //! Fill in m_Key for \p params, \p time and \p value.
+        void key(const maths::common::CModelProbabilityParams& params,
+                 const TTime2Vec1Vec& time,
+                 const TDouble2Vec1Vec& value);
+
+    private:
+        //! A placeholder for the key of the current lookup.
+        TDoubleVec m_Key;
+        //! The cached probabilities.
+        TDoubleVecDoubleUMap m_Probabilities;
+    };
+
     //! \brief Wraps up the parameters to the influence calculation.
     struct MODEL_EXPORT SParams : private core::CNonCopyable {
         SParams(const CPartitioningFields& partitioningFields);
@@ -123,6 +181,8 @@ public:
         bool s_IncludeCutoff;
         //! Filled in with the influences of s_Value if any.
         TOptionalStrOptionalStrPrDoublePrVec s_Influences;
+        //! The probabilities computed to find the influences on s_Value.
+        CInfluenceProbabilityCache s_InfluenceProbabilities;
     };
 
     //! \brief Wraps up the parameters to the influence calculation
@@ -174,6 +234,8 @@ public:
         bool s_IncludeCutoff;
         //! Filled in with the influences of s_Values if any.
         TOptionalStrOptionalStrPrDoublePrVec s_Influences;
+        //! The probabilities computed to find the influences on s_Values.
+        CInfluenceProbabilityCache s_InfluenceProbabilities;
     };
 
 public:
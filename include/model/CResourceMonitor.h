@@ -21,11 +21,13 @@
 
 #include <boost/unordered_map.hpp>
 
+#include <cstddef>
 #include <functional>
 #include <map>
 
 namespace CResourceMonitorTest {
 class CTestFixture;
+struct testIncrementalRefresh;
 struct testMonitor;
 struct testPeakUsage;
 struct testPruning;
@@ -47,6 +49,13 @@ class CMonitoredResource;
 //!
 //! DESCRIPTION:\n
 //! Assess memory used by models and decide on further memory allocations.
+//!
+//! Calculating the memory used by a resource means visiting all its models
+//! so this is done incrementally. Resources report the estimated change in
+//! their memory when they create models and refresh only recalculates the
+//! memory of a resource every REFRESHES_PER_MEMORY_CALCULATION refreshes to
+//! correct any drift in the estimates. The forceRefresh variants always
+//! recalculate it.
 class MODEL_EXPORT CResourceMonitor {
 public:
     struct MODEL_EXPORT SModelSizeStats {
@@ -79,6 +88,8 @@ public:
     static const double DEFAULT_BYTE_LIMIT_MARGIN;
     //! The maximum value of elapsed time used to scale the byte limit margin
     static const core_t::TTime MAXIMUM_BYTE_LIMIT_MARGIN_PERIOD;
+    //! The number of refreshes of a resource between recalculating its memory
+    static const std::size_t REFRESHES_PER_MEMORY_CALCULATION;
 
 public:
     //! Default constructor
@@ -104,12 +115,19 @@ public:
     //! Register a callback to be used when the memory usage grows
     void memoryUsageReporter(const TMemoryUsageReporterFunc& reporter);
 
-    //! Recalculate the memory usage if there is a memory limit
+    //! Update the memory usage if there is a memory limit.
+    //!
+    //! This uses the changes reported by addMemoryUsageDelta and only
+    //! recalculates the memory usage of \p resource periodically.
     void refresh(CMonitoredResource& resource);
 
     //! Recalculate the memory usage regardless of whether there is a memory limit
     void forceRefresh(CMonitoredResource& resource);
 
+    //! Account for a change of \p delta bytes in the memory used by
+    //! \p resource without recalculating it.
+    void addMemoryUsageDelta(CMonitoredResource& resource, std::ptrdiff_t delta);
+
     //! Recalculate the memory usage for all monitored resources
     void forceRefreshAll();
 
@@ -178,8 +196,15 @@ public:
     void decreaseMargin(core_t::TTime elapsedTime);
 
 private:
-    using TMonitoredResourcePtrSizeUMap =
-        boost::unordered_map<CMonitoredResource*, std::size_t>;
+    //! \brief The accounted memory usage of a resource.
+    struct SResourceUsage {
+        //! The memory usage including any reported changes.
+        std::size_t s_Usage{0};
+        //! The number of refreshes since the usage was last calculated.
+        std::size_t s_RefreshesSinceCalculated{REFRESHES_PER_MEMORY_CALCULATION};
+    };
+    using TMonitoredResourcePtrResourceUsageUMap =
+        boost::unordered_map<CMonitoredResource*, SResourceUsage>;
     using TMeanVarAccumulator =
         maths::common::CBasicStatistics::SSampleMeanVar<double>::TAccumulator;
 
@@ -231,7 +256,7 @@ private:
 
 private:
     //! The registered collection of components
-    TMonitoredResourcePtrSizeUMap m_Resources;
+    TMonitoredResourcePtrResourceUsageUMap m_Resources;
 
     //! Is there enough free memory to allow creating new components
     bool m_AllowAllocations{true};
@@ -313,6 +338,7 @@ private:
     //! Test friends
     friend class CResourceLimitTest::CTestFixture;
     friend class CResourceMonitorTest::CTestFixture;
+    friend struct CResourceMonitorTest::testIncrementalRefresh;
     friend struct CResourceMonitorTest::testMonitor;
     friend struct CResourceMonitorTest::testPeakUsage;
     friend struct CResourceMonitorTest::testPruning;
@@ -12,9 +12,12 @@
 #ifndef INCLUDED_ml_model_CRuleCondition_h
 #define INCLUDED_ml_model_CRuleCondition_h
 
+#include <core/CSmallVector.h>
+
 #include <model/ImportExport.h>
 #include <model/ModelTypes.h>
 
+#include <optional>
 #include <string>
 
 namespace ml {
@@ -35,6 +38,7 @@ class CAnomalyDetectorModel;
 class MODEL_EXPORT CRuleCondition {
 public:
     using TPatternSetCRef = std::reference_wrapper<const core::CPatternSet>;
+    using TDouble1Vec = core::CSmallVector<double, 1>;
 
 public:
     enum ERuleConditionAppliesTo {
@@ -46,6 +50,44 @@ public:
 
     enum ERuleConditionOperator { E_LT, E_LTE, E_GT, E_GTE };
 
+    //! \brief The values of a series against which conditions are tested.
+    //!
+    //! DESCRIPTION:\n
+    //! The actual and typical values are read from the model the first
+    //! time a condition needs them and are then reused, so a rule with
+    //! several conditions reads each of them at most once.
+    class MODEL_EXPORT CSeriesValues {
+    public:
+        CSeriesValues(const CAnomalyDetectorModel& model,
+                      model_t::EFeature feature,
+                      const model_t::CResultType& resultType,
+                      std::size_t pid,
+                      std::size_t cid,
+                      core_t::TTime time);
+
+        //! Get the actual value of the series.
+        const TDouble1Vec& actual();
+
+        //! Get the typical value of the series.
+        const TDouble1Vec& typical();
+
+        //! Get the time of the series value.
+        core_t::TTime time() const { return m_Time; }
+
+    private:
+        using TOptionalDouble1Vec = std::optional<TDouble1Vec>;
+
+    private:
+        const CAnomalyDetectorModel& m_Model;
+        model_t::EFeature m_Feature;
+        const model_t::CResultType& m_ResultType;
+        std::size_t m_Pid;
+        std::size_t m_Cid;
+        core_t::TTime m_Time;
+        TOptionalDouble1Vec m_Actual;
+        TOptionalDouble1Vec m_Typical;
+    };
+
 public:
     //! Default constructor.
     CRuleCondition();
@@ -59,6 +101,9 @@ public:
     //! Set the condition value.
     void value(double value);
 
+    //! Get which value the condition applies to.
+    ERuleConditionAppliesTo appliesTo() const;
+
     //! Pretty-print the condition.
     std::string print() const;
 
@@ -70,6 +115,9 @@ public:
               std::size_t cid,
               core_t::TTime time) const;
 
+    //! Test the condition against the series whose values are \p values.
+    bool test(CSeriesValues& values) const;
+
 private:
     bool testValue(double value) const;
     std::string print(ERuleConditionAppliesTo appliesTo) const;
@@ -261,11 +261,15 @@ public:
             if (!influences[i]) {
                 continue;
             }
+            // Most values are for influences we've already seen in the bucket
+            // and emplace would copy the influence and make a statistic first.
             TOptionalStrStatUMap& stats = m_InfluencerBucketStats[i].get(time);
-            auto j = stats
-                         .emplace(influences[i],
-                                  CMetricStatisticWrappers::template make<STATISTIC>(m_Dimension))
-                         .first;
+            auto j = stats.find(influences[i]);
+            if (j == stats.end()) {
+                j = stats.emplace(influences[i], CMetricStatisticWrappers::template make<STATISTIC>(
+                                                     m_Dimension))
+                        .first;
+            }
             CMetricStatisticWrappers::add(statistic, count, j->second);
         }
     }
@@ -274,7 +278,7 @@ public:
     void startNewBucket(core_t::TTime time) {
         m_BucketStats.push(TMetricPartialStatistic(m_Dimension), time);
         for (auto& stats : m_InfluencerBucketStats) {
-            stats.push(TOptionalStrStatUMap(1), time);
+            stats.recycle([](TOptionalStrStatUMap& stats_) { stats_.clear(); }, time);
         }
         m_Samples.clear();
     }
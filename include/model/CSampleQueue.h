@@ -33,6 +33,7 @@
 #include <cmath>
 #include <functional>
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace ml {
@@ -241,36 +242,36 @@ public:
                 model_t::EFeature feature,
                 TSampleVec& samples) {
         core_t::TTime latencyCutoff = bucketStart + m_BucketLength - 1;
-        TOptionalSubSample combinedSubSample;
 
+        // The sub-samples are combined in place at the back of the queue so
+        // no sub-sample is copied. The earliest sub-sample holds the combined
+        // statistic and is merged into the next one while they don't yet make
+        // a sample the size of the target count.
         while (m_Queue.empty() == false && m_Queue.back().s_End <= latencyCutoff) {
-            if (combinedSubSample) {
-                *combinedSubSample += m_Queue.back();
-            } else {
-                combinedSubSample = TOptionalSubSample(m_Queue.back());
-            }
-
-            m_Queue.pop_back();
+            SSubSample& combinedSubSample = m_Queue.back();
+            SSubSample* next = m_Queue.size() > 1 ? &m_Queue[m_Queue.size() - 2] : nullptr;
 
-            double count = combinedSubSample->s_Statistic.count();
+            double count = combinedSubSample.s_Statistic.count();
             double countIncludingNext =
-                (m_Queue.empty()) ? count : count + m_Queue.back().s_Statistic.count();
+                next == nullptr ? count : count + next->s_Statistic.count();
             double countRatio = sampleCount / count;
             double countRatioIncludingNext = sampleCount / countIncludingNext;
 
             if (countIncludingNext >= sampleCount &&
                 (std::abs(1.0 - countRatio) <= std::abs(1.0 - countRatioIncludingNext))) {
-                TDouble1Vec sample = combinedSubSample->s_Statistic.value();
-                core_t::TTime sampleTime = combinedSubSample->s_Statistic.time();
+                TDouble1Vec sample = combinedSubSample.s_Statistic.value();
+                core_t::TTime sampleTime = combinedSubSample.s_Statistic.time();
                 double vs = model_t::varianceScale(feature, sampleCount, count);
                 samples.emplace_back(sampleTime, sample, vs, count);
-                combinedSubSample = TOptionalSubSample();
+                m_Queue.pop_back();
+            } else if (next != nullptr && next->s_End <= latencyCutoff) {
+                combinedSubSample += *next;
+                *next = std::move(combinedSubSample);
+                m_Queue.pop_back();
+            } else {
+                break;
             }
         }
-
-        if (combinedSubSample) {
-            m_Queue.push_back(*combinedSubSample);
-        }
     }
 
     void resetBucket(core_t::TTime bucketStart) {
@@ -328,7 +329,7 @@ public:
                     return false;
                 }
                 this->resizeIfFull();
-                m_Queue.push_front(subSample);
+                m_Queue.push_front(std::move(subSample));
             }
         } while (traverser.next());
 
@@ -362,14 +363,14 @@ private:
         this->resizeIfFull();
         SSubSample newSubSample(m_Dimension, time);
         newSubSample.s_Statistic.add(measurement, time, count);
-        m_Queue.push_front(newSubSample);
+        m_Queue.push_front(std::move(newSubSample));
     }
 
     void pushBackNewSubSample(const TDouble1Vec& measurement, core_t::TTime time, unsigned int count) {
         this->resizeIfFull();
         SSubSample newSubSample(m_Dimension, time);
         newSubSample.s_Statistic.add(measurement, time, count);
-        m_Queue.push_back(newSubSample);
+        m_Queue.push_back(std::move(newSubSample));
     }
 
     void insertNewSubSample(iterator pos,
@@ -379,7 +380,7 @@ private:
         this->resizeIfFull();
         SSubSample newSubSample(m_Dimension, time);
         newSubSample.s_Statistic.add(measurement, time, count);
-        m_Queue.insert(pos, newSubSample);
+        m_Queue.insert(pos, std::move(newSubSample));
     }
 
     void resizeIfFull() {
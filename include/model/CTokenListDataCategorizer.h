@@ -21,6 +21,8 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <limits>
 #include <string>
 
 namespace ml {
@@ -183,13 +185,21 @@ protected:
     double similarity(const TSizeSizePrVec& left,
                       std::size_t leftWeight,
                       const TSizeSizePrVec& right,
-                      std::size_t rightWeight) const override {
+                      std::size_t rightWeight,
+                      double lowerBound) const override {
         double similarity(1.0);
 
         std::size_t maxWeight(std::max(leftWeight, rightWeight));
         if (maxWeight > 0) {
-            std::size_t diff(DO_WARPING ? m_SimilarityTester.weightedEditDistance(left, right)
-                                        : this->compareNoWarp(left, right));
+            // Any difference greater than this gives a similarity less than
+            // the lower bound.
+            std::size_t maxDiff(lowerBound > 0.0
+                                    ? static_cast<std::size_t>(std::floor(
+                                          (1.0 - lowerBound) * double(maxWeight)))
+                                    : std::numeric_limits<std::size_t>::max());
+            std::size_t diff(DO_WARPING
+                                 ? m_SimilarityTester.weightedEditDistance(left, right, maxDiff)
+                                 : this->compareNoWarp(left, right));
 
             similarity = 1.0 - double(diff) / double(maxWeight);
         }
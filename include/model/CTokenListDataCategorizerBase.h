@@ -88,6 +88,10 @@ public:
     //! Used for storing distinct token IDs
     using TSizeSizeMap = std::map<std::size_t, std::size_t>;
 
+    //! Used for indexing categories by token ID
+    using TSizeVec = std::vector<std::size_t>;
+    using TSizeVecVec = std::vector<TSizeVec>;
+
     //! Used for stream output of token IDs translated back to the original
     //! tokens
     struct MODEL_EXPORT SIdTranslater {
@@ -234,11 +238,14 @@ protected:
 
     virtual void reset() = 0;
 
-    //! Compute similarity between two vectors
+    //! Compute similarity between two vectors.  If the similarity is less
+    //! than \p lowerBound the calculation may stop early and return any
+    //! value less than \p lowerBound.
     virtual double similarity(const TSizeSizePrVec& left,
                               std::size_t leftWeight,
                               const TSizeSizePrVec& right,
-                              std::size_t rightWeight) const = 0;
+                              std::size_t rightWeight,
+                              double lowerBound) const = 0;
 
     //! Add a match to an existing category
     void addCategoryMatch(bool isDryRun,
@@ -353,6 +360,25 @@ private:
                                std::size_t& minReweightedTotalWeight,
                                std::size_t& maxReweightedTotalWeight);
 
+    //! Find the ranks in m_CategoriesByCount of the categories that could
+    //! match the current work tokens, in ascending order, in
+    //! m_WorkCandidateRanks.
+    //!
+    //! A category which shares no tokens with a string has similarity at
+    //! most zero to it and can only match its search if the category has
+    //! no common tokens.  So it suffices to consider the categories which
+    //! share a token with the string together with those whose common
+    //! tokens have zero weight.
+    //!
+    //! \return False if all categories must be considered.
+    bool findCandidateCategories(std::size_t workWeight);
+
+    //! Add the category at \p index to the token index.
+    void indexCategory(std::size_t index);
+
+    //! Rebuild the token index and category ranks from the categories.
+    void reindexCategories();
+
     //! Get the categories that will never be detected again because the
     //! specified category will always be returned instead.  This overload
     //! is only O(N), whereas the public usurpedCategories method is O(N^2).
@@ -383,6 +409,27 @@ private:
     //! not a category ID.
     TSizeSizePrVec m_CategoriesByCount;
 
+    //! The position in m_CategoriesByCount of each category.
+    TSizeVec m_CategoryRanks;
+
+    //! The indices of the categories whose base tokens include each token ID.
+    TSizeVecVec m_TokenCategories;
+
+    //! The indices of the categories whose common unique tokens have zero
+    //! weight.  These can match strings with which they share no tokens.
+    TSizeVec m_UnindexedCategories;
+
+    //! The last candidate search in which each category was found.  Used to
+    //! deduplicate candidates without clearing state for every string.
+    TSizeVec m_CategoryLastCandidateSearch;
+
+    //! The number of candidate searches.
+    std::size_t m_CandidateSearch = 0;
+
+    //! Vector to use to build up the ranks of candidate categories for a
+    //! string.  This is a member to save repeated reallocations.
+    TSizeVec m_WorkCandidateRanks;
+
     //! Sum of all category counts.  Equal to the sum of .first for all elements
     //! of m_CategoriesByCount.
     std::size_t m_TotalCount = 0;
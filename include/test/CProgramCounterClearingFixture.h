@@ -18,7 +18,7 @@ namespace test {
 
 //! \brief
 //! Test fixture that resets all program counters to zero
-//! between tests.
+//! and clears all program histograms between tests.
 //!
 //! DESCRIPTION:\n
 //! Program counters are implemented as a singleton object,
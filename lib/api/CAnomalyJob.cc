@@ -10,6 +10,8 @@
  */
 #include <api/CAnomalyJob.h>
 
+#include <core/CBinaryStatePersistInserter.h>
+#include <core/CBinaryStateRestoreTraverser.h>
 #include <core/CDataAdder.h>
 #include <core/CDataSearcher.h>
 #include <core/CJsonStatePersistInserter.h>
@@ -24,11 +26,13 @@
 #include <core/CStopWatch.h>
 #include <core/CStringUtils.h>
 #include <core/CTimeUtils.h>
+#include <core/Concurrency.h>
 #include <core/UnwrapRef.h>
 
 #include <maths/common/CIntegerTools.h>
 #include <maths/common/COrderings.h>
 
+#include <model/CDynamicStringIdRegistry.h>
 #include <model/CHierarchicalResultsAggregator.h>
 #include <model/CHierarchicalResultsPopulator.h>
 #include <model/CHierarchicalResultsProbabilityFinalizer.h>
@@ -44,9 +48,13 @@
 #include <api/CJsonOutputWriter.h>
 #include <api/CModelPlotDataJsonWriter.h>
 #include <api/CPersistenceManager.h>
+#include <api/CRecordBatch.h>
 
 #include <algorithm>
 #include <fstream>
+#include <limits>
+#include <optional>
+#include <sstream>
 #include <string>
 
 namespace ml {
@@ -55,6 +63,12 @@ namespace api {
 // We use short field names to reduce the state size
 namespace {
 using TStrCRef = std::reference_wrapper<const std::string>;
+using TSizeVec = std::vector<std::size_t>;
+using TOptionalSizeVec = std::vector<std::optional<std::size_t>>;
+
+//! Markers for the columns of the fields of interest which aren't in a batch.
+const std::size_t EMPTY_FIELD_NAME{std::numeric_limits<std::size_t>::max()};
+const std::size_t MISSING_FIELD{EMPTY_FIELD_NAME - 1};
 
 //! Convert a (string, key) pair to something readable.
 template<typename T>
@@ -164,6 +178,8 @@ bool CAnomalyJob::handleRecord(const TStrStrUMap& dataRowFields, TOptionalTime t
         return this->handleControlMessage(iter->second);
     }
 
+    core::CProgramCounters::CScopedHistogramTimer timer{counter_t::E_TSADHandleRecordTime};
+
     // Time may have been parsed already further back along the chain
     if (time == std::nullopt) {
         time = this->parseTime(dataRowFields);
@@ -174,56 +190,111 @@ bool CAnomalyJob::handleRecord(const TStrStrUMap& dataRowFields, TOptionalTime t
         }
     }
 
-    // This record must be within the specified latency. If latency
-    // is zero, then it should be after the current bucket end. If
-    // latency is non-zero, then it should be after the current bucket
-    // end minus the latency.
-    if (*time < m_LastFinalisedBucketEndTime) {
-        ++core::CProgramCounters::counter(counter_t::E_TSADNumberTimeOrderErrors);
-        std::ostringstream ss;
-        ss << "Records must be in ascending time order. "
-           << "Record '" << this->debugPrintRecord(dataRowFields) << "' time "
-           << *time << " is before bucket time " << m_LastFinalisedBucketEndTime;
-        LOG_ERROR(<< ss.str());
-        return true;
-    }
+    m_RecordWords.clear();
+    this->addRecordToDetectors(
+        *time, [&] { return this->debugPrintRecord(dataRowFields); },
+        [&](std::size_t i) -> const std::string& {
+            const std::string& partitionFieldName(m_DetectorKeys[i].partitionFieldName());
 
-    LOG_TRACE(<< "Handling record " << this->debugPrintRecord(dataRowFields));
+            // An empty partitionFieldName means no partitioning
+            TStrStrUMapCItr itr = partitionFieldName.empty()
+                                      ? dataRowFields.end()
+                                      : dataRowFields.find(partitionFieldName);
+            return itr == dataRowFields.end() ? EMPTY_STRING : itr->second;
+        },
+        [&](const TAnomalyDetectorPtr& detector) {
+            this->addRecord(detector, *time, dataRowFields);
+        });
 
-    this->outputBucketResultsUntil(*time);
+    return true;
+}
 
-    if (m_DetectorKeys.empty()) {
-        this->populateDetectorKeys(m_JobConfig, m_DetectorKeys);
+bool CAnomalyJob::handleRecords(const CRecordBatch& batch) {
+    if (batch.empty()) {
+        return true;
     }
 
-    for (std::size_t i = 0; i < m_DetectorKeys.size(); ++i) {
-        const std::string& partitionFieldName(m_DetectorKeys[i].partitionFieldName());
+    TOptionalSize controlField{batch.fieldIndex(CONTROL_FIELD_NAME)};
+    TOptionalSize timeField{this->timeField(batch)};
 
-        // An empty partitionFieldName means no partitioning
-        TStrStrUMapCItr itr = partitionFieldName.empty()
-                                  ? dataRowFields.end()
-                                  : dataRowFields.find(partitionFieldName);
-        const std::string& partitionFieldValue(
-            itr == dataRowFields.end() ? EMPTY_STRING : itr->second);
+    // The batch's columns are looked up lazily because the detector keys
+    // are only populated when the first record is handled.
+    TOptionalSizeVec partitionFields;
+    boost::unordered_map<const model::CAnomalyDetector*, TSizeVec> fieldsOfInterest;
+    model::CAnomalyDetector::TStrCPtrVec fieldValues;
+    TWordVec fieldWords;
+
+    auto columns = [&](const model::CAnomalyDetector& detector) -> const TSizeVec& {
+        auto[itr, inserted] = fieldsOfInterest.emplace(&detector, TSizeVec{});
+        if (inserted) {
+            const TStrVec& fieldNames{detector.fieldsOfInterest()};
+            itr->second.reserve(fieldNames.size());
+            for (const auto& fieldName : fieldNames) {
+                itr->second.push_back(fieldName.empty()
+                                          ? EMPTY_FIELD_NAME
+                                          : batch.fieldIndex(fieldName).value_or(MISSING_FIELD));
+            }
+        }
+        return itr->second;
+    };
+
+    for (std::size_t record = 0; record < batch.size(); ++record) {
+        // Non-empty control fields take precedence over everything else
+        if (controlField != std::nullopt &&
+            batch.value(*controlField, record).empty() == false) {
+            if (this->handleControlMessage(batch.value(*controlField, record)) == false) {
+                return false;
+            }
+            continue;
+        }
 
-        // TODO - should usenull apply to the partition field too?
+        core::CProgramCounters::CScopedHistogramTimer timer{counter_t::E_TSADHandleRecordTime};
 
-        const TAnomalyDetectorPtr& detector = this->detectorForKey(
-            false, // not restoring
-            *time, m_DetectorKeys[i], partitionFieldValue, m_Limits.resourceMonitor());
-        if (detector == nullptr) {
-            // There wasn't enough memory to create the detector
+        TOptionalTime time{this->parseTime(batch, record, timeField)};
+        if (time == std::nullopt) {
+            // Time is compulsory for anomaly detection - the base class will
+            // have logged the parse error
             continue;
         }
 
-        this->addRecord(detector, *time, dataRowFields);
+        m_RecordWords.clear();
+        this->addRecordToDetectors(
+            *time, [&] { return this->debugPrintRecord(batch, record); },
+            [&](std::size_t i) -> const std::string& {
+                if (partitionFields.size() != m_DetectorKeys.size()) {
+                    partitionFields.clear();
+                    for (const auto& key : m_DetectorKeys) {
+                        // An empty partitionFieldName means no partitioning
+                        const std::string& partitionFieldName(key.partitionFieldName());
+                        partitionFields.push_back(partitionFieldName.empty()
+                                                      ? TOptionalSize{}
+                                                      : batch.fieldIndex(partitionFieldName));
+                    }
+                }
+                return partitionFields[i] == std::nullopt
+                           ? EMPTY_STRING
+                           : batch.value(*partitionFields[i], record);
+            },
+            [&](const TAnomalyDetectorPtr& detector) {
+                // This must match fieldValue().
+                fieldValues.clear();
+                fieldWords.clear();
+                for (auto field : columns(*detector)) {
+                    const std::string* value{nullptr};
+                    if (field == EMPTY_FIELD_NAME) {
+                        value = &EMPTY_STRING;
+                    } else if (field != MISSING_FIELD &&
+                               batch.value(field, record).empty() == false) {
+                        value = &batch.value(field, record);
+                    }
+                    fieldValues.push_back(value);
+                    fieldWords.push_back(value != nullptr ? this->fieldWord(*value)
+                                                          : TWord{});
+                }
+                detector->addRecord(*time, fieldValues, fieldWords);
+            });
     }
 
-    ++core::CProgramCounters::counter(counter_t::E_TSADNumberApiRecordsHandled);
-
-    ++m_NumRecordsHandled;
-    m_LatestRecordTime = std::max(m_LatestRecordTime, *time);
-
     return true;
 }
 
@@ -248,6 +319,18 @@ void CAnomalyJob::finalise() {
     m_JsonOutputWriter.finalise();
 }
 
+void CAnomalyJob::computeDetectorResultsConcurrently(bool enabled) {
+    m_ComputeDetectorResultsConcurrently = enabled;
+}
+
+void CAnomalyJob::numberForecastThreads(std::size_t numberThreads) {
+    m_ForecastRunner.numberThreads(numberThreads);
+}
+
+void CAnomalyJob::persistBinaryState(bool enabled) {
+    m_PersistBinaryState = enabled;
+}
+
 bool CAnomalyJob::initNormalizer(const std::string& quantilesStateFile) {
     std::ifstream inputStream(quantilesStateFile.c_str());
     return m_Normalizer.fromJsonStream(inputStream) ==
@@ -476,6 +559,14 @@ void CAnomalyJob::updateConfig(const std::string& config) {
     }
     const std::string& analysisConfig = m_JobConfig.analysisConfig().getAnalysisConfig();
     m_JobConfig.analysisConfig().reparseDetectorsFromStoredConfig(analysisConfig);
+
+    // Rules, filters and scheduled events affect the results of people who
+    // haven't received any data since the last interim results.
+    for (auto& detector : m_Detectors) {
+        if (detector.second != nullptr) {
+            detector.second->invalidateInterimResults();
+        }
+    }
 }
 
 void CAnomalyJob::advanceTime(const std::string& time_) {
@@ -663,6 +754,8 @@ void CAnomalyJob::doForecast(const std::string& controlMessage) {
 
 void CAnomalyJob::outputResults(core_t::TTime bucketStartTime) {
     core::CStopWatch timer(true);
+    core::CProgramCounters::CScopedHistogramTimer histogramTimer{
+        counter_t::E_TSADOutputResultsTime};
 
     core_t::TTime bucketLength = m_ModelConfig.bucketLength();
 
@@ -673,20 +766,26 @@ void CAnomalyJob::outputResults(core_t::TTime bucketStartTime) {
     TKeyCRefAnomalyDetectorPtrPrVec detectors;
     this->sortedDetectors(detectors);
 
-    for (const auto& detector_ : detectors) {
-        model::CAnomalyDetector* detector(detector_.second.get());
-        if (detector == nullptr) {
-            LOG_ERROR(<< "Unexpected NULL pointer for key '"
-                      << pairDebug(detector_.first) << '\'');
-            continue;
-        }
-        detector->buildResults(bucketStartTime, bucketStartTime + bucketLength, results);
-        detector->releaseMemory(bucketStartTime - m_ModelConfig.samplingAgeCutoff());
+    if (m_ComputeDetectorResultsConcurrently && detectors.size() > 1 &&
+        core::defaultAsyncThreadPoolSize() > 1) {
+        this->buildResultsConcurrently(bucketStartTime, detectors, results,
+                                       modelPlotData, annotations);
+    } else {
+        for (const auto& detector_ : detectors) {
+            model::CAnomalyDetector* detector(detector_.second.get());
+            if (detector == nullptr) {
+                LOG_ERROR(<< "Unexpected NULL pointer for key '"
+                          << pairDebug(detector_.first) << '\'');
+                continue;
+            }
+            detector->buildResults(bucketStartTime, bucketStartTime + bucketLength, results);
+            detector->releaseMemory(bucketStartTime - m_ModelConfig.samplingAgeCutoff());
 
-        this->generateModelPlot(bucketStartTime, bucketStartTime + bucketLength,
-                                *detector, modelPlotData);
-        detector->generateAnnotations(bucketStartTime,
-                                      bucketStartTime + bucketLength, annotations);
+            this->generateModelPlot(bucketStartTime, bucketStartTime + bucketLength,
+                                    *detector, modelPlotData);
+            detector->generateAnnotations(bucketStartTime,
+                                          bucketStartTime + bucketLength, annotations);
+        }
     }
 
     if (!results.empty()) {
@@ -728,6 +827,61 @@ void CAnomalyJob::outputResults(core_t::TTime bucketStartTime) {
     m_Limits.resourceMonitor().pruneIfRequired(bucketStartTime);
 }
 
+void CAnomalyJob::buildResultsConcurrently(core_t::TTime bucketStartTime,
+                                           const TKeyCRefAnomalyDetectorPtrPrVec& detectors,
+                                           model::CHierarchicalResults& results,
+                                           TModelPlotDataVec& modelPlotData,
+                                           TAnnotationVec& annotations) {
+    using TAnomalyDetectorRawPtrVec = std::vector<model::CAnomalyDetector*>;
+    using TBoolVec = std::vector<bool>;
+    using THierarchicalResultsVec = std::vector<model::CHierarchicalResults>;
+
+    core_t::TTime bucketEndTime{bucketStartTime + m_ModelConfig.bucketLength()};
+
+    TAnomalyDetectorRawPtrVec validDetectors;
+    validDetectors.reserve(detectors.size());
+    for (const auto& detector : detectors) {
+        if (detector.second == nullptr) {
+            LOG_ERROR(<< "Unexpected NULL pointer for key '"
+                      << pairDebug(detector.first) << '\'');
+            continue;
+        }
+        validDetectors.push_back(detector.second.get());
+    }
+
+    // Sampling updates the resource monitor, which is shared by all detectors
+    // and whose allocation decisions depend on the order in which they sample,
+    // so this is done serially in detector order. Each detector releases memory
+    // before the next one samples, as in the serial path, so the monitor makes
+    // the same decisions. This only removes population gatherers which have no
+    // data in the latency window, so doesn't affect the bucket's results.
+    TBoolVec sampled(validDetectors.size(), false);
+    for (std::size_t i = 0; i < validDetectors.size(); ++i) {
+        sampled[i] = validDetectors[i]->sampleForResults(bucketStartTime, bucketEndTime);
+        validDetectors[i]->releaseMemory(bucketStartTime - m_ModelConfig.samplingAgeCutoff());
+    }
+
+    // Computing results only touches each detector's own state. Each detector
+    // gets its own results which are merged in detector order so the output is
+    // the same as building them serially.
+    THierarchicalResultsVec detectorResults(validDetectors.size());
+    core::parallel_for_each(validDetectors.size(), 0, validDetectors.size(),
+                            [&](std::size_t i) {
+                                if (sampled[i]) {
+                                    validDetectors[i]->computeResults(
+                                        bucketStartTime, bucketEndTime,
+                                        detectorResults[i]);
+                                }
+                            });
+
+    for (std::size_t i = 0; i < validDetectors.size(); ++i) {
+        model::CAnomalyDetector& detector{*validDetectors[i]};
+        results.append(std::move(detectorResults[i]));
+        this->generateModelPlot(bucketStartTime, bucketEndTime, detector, modelPlotData);
+        detector.generateAnnotations(bucketStartTime, bucketEndTime, annotations);
+    }
+}
+
 void CAnomalyJob::outputInterimResults(core_t::TTime bucketStartTime) {
     core::CStopWatch timer(true);
 
@@ -876,11 +1030,18 @@ bool CAnomalyJob::restoreState(core::CDataSearcher& restoreSearcher,
             return false;
         }
 
-        // We're dealing with streaming JSON state
-        core::CJsonStateRestoreTraverser traverser(*strm);
+        // We're dealing with streaming state which is either JSON or, if it
+        // starts with the binary marker, the binary format
+        using TStateRestoreTraverserUPtr = std::unique_ptr<core::CStateRestoreTraverser>;
+        TStateRestoreTraverserUPtr traverser{[&strm]() -> TStateRestoreTraverserUPtr {
+            if (core::CBinaryStateRestoreTraverser::isBinaryState(*strm)) {
+                return std::make_unique<core::CBinaryStateRestoreTraverser>(*strm);
+            }
+            return std::make_unique<core::CJsonStateRestoreTraverser>(*strm);
+        }()};
 
-        if (this->restoreState(traverser, completeToTime, numDetectors) == false ||
-            traverser.haveBadState()) {
+        if (this->restoreState(*traverser, completeToTime, numDetectors) == false ||
+            traverser->haveBadState()) {
             LOG_ERROR(<< "Failed to restore detectors");
             return false;
         }
@@ -1314,6 +1475,10 @@ bool CAnomalyJob::persistCopiedState(const std::string& description,
     // unnecessary at first, but there are occasions when the simple count detector does not exist,
     // e.g. when no data is seen but time is advanced.
     core::CProgramCounters::CCacheManager cacheMgr;
+    core::CProgramCounters::CScopedHistogramTimer timer{counter_t::E_TSADPersistStateTime};
+
+    // This is set before any state is persisted so is safe to read here.
+    bool persistBinaryState{m_PersistBinaryState};
 
     // Persist state for each detector separately by streaming
     try {
@@ -1328,8 +1493,15 @@ bool CAnomalyJob::persistCopiedState(const std::string& description,
             // values can change.  There should be no use of m_ variables in the
             // following code block.
             {
-                // The JSON inserter must be destructed before the stream is complete
-                core::CJsonStatePersistInserter inserter(*strm);
+                // The inserter must be destructed before the stream is complete
+                using TStatePersistInserterUPtr = std::unique_ptr<core::CStatePersistInserter>;
+                TStatePersistInserterUPtr inserter_{[persistBinaryState, &strm]() -> TStatePersistInserterUPtr {
+                    if (persistBinaryState) {
+                        return std::make_unique<core::CBinaryStatePersistInserter>(*strm);
+                    }
+                    return std::make_unique<core::CJsonStatePersistInserter>(*strm);
+                }()};
+                core::CStatePersistInserter& inserter{*inserter_};
                 inserter.insertValue(TIME_TAG, time);
                 inserter.insertValue(VERSION_TAG, model::CAnomalyDetector::STATE_VERSION);
                 inserter.insertLevel(
@@ -1452,6 +1624,7 @@ void CAnomalyJob::updateAggregatorAndAggregate(bool isInterim,
 
 void CAnomalyJob::updateNormalizerAndNormalizeResults(bool isInterim,
                                                       model::CHierarchicalResults& results) {
+    core::CProgramCounters::CScopedHistogramTimer timer{counter_t::E_TSADNormalizeResultsTime};
     m_Normalizer.setJob(model::CHierarchicalResultsNormalizer::E_RefreshSettings);
     results.bottomUpBreadthFirst(m_Normalizer);
     results.pivotsBottomUpBreadthFirst(m_Normalizer);
@@ -1509,6 +1682,7 @@ void CAnomalyJob::generateModelPlot(core_t::TTime startTime,
         LOG_TRACE(<< "Generating model debug data at " << startTime);
         detector.generateModelPlot(startTime, endTime,
                                    m_ModelConfig.modelPlotBoundsPercentile(),
+                                   m_ModelConfig.modelPlotBoundsCadence(),
                                    m_ModelConfig.modelPlotTerms(), modelPlotData);
     }
 }
@@ -1634,6 +1808,34 @@ CAnomalyJob::detectorForKey(bool isRestoring,
     return itr->second;
 }
 
+const CAnomalyJob::TAnomalyDetectorPtr&
+CAnomalyJob::detectorForKeyIndex(std::size_t keyIndex,
+                                 core_t::TTime time,
+                                 const std::string& partitionFieldValue,
+                                 model::CResourceMonitor& resourceMonitor) {
+    const model::CSearchKey& key{m_DetectorKeys[keyIndex]};
+    const std::string& partition = key.isSimpleCount() ? EMPTY_STRING : partitionFieldValue;
+
+    if (m_DetectorsByKeyIndex.size() != m_DetectorKeys.size()) {
+        m_DetectorsByKeyIndex.resize(m_DetectorKeys.size());
+    }
+    auto& detectors = m_DetectorsByKeyIndex[keyIndex];
+    auto itr = detectors.find(partition);
+    if (itr != detectors.end()) {
+        return *itr->second;
+    }
+
+    // Detectors are never removed from m_Detectors and its elements are
+    // stable so we can hold on to a pointer to the entry.
+    const TAnomalyDetectorPtr& detector = this->detectorForKey(
+        false, // not restoring
+        time, key, partition, resourceMonitor);
+    if (detector != nullptr) {
+        detectors.emplace(partition, &detector);
+    }
+    return detector;
+}
+
 void CAnomalyJob::pruneAllModels(std::size_t buckets) {
     if (buckets == 0) {
         LOG_INFO(<< "Pruning obsolete models");
@@ -1690,17 +1892,79 @@ const std::string* CAnomalyJob::fieldValue(const std::string& fieldName,
     return !fieldName.empty() && fieldValue.empty() ? nullptr : &fieldValue;
 }
 
+template<typename PRINT_RECORD, typename PARTITION_FIELD_VALUE, typename ADD_RECORD>
+void CAnomalyJob::addRecordToDetectors(core_t::TTime time,
+                                       const PRINT_RECORD& printRecord,
+                                       const PARTITION_FIELD_VALUE& partitionFieldValue,
+                                       const ADD_RECORD& addRecord) {
+    // This record must be within the specified latency. If latency
+    // is zero, then it should be after the current bucket end. If
+    // latency is non-zero, then it should be after the current bucket
+    // end minus the latency.
+    if (time < m_LastFinalisedBucketEndTime) {
+        ++core::CProgramCounters::counter(counter_t::E_TSADNumberTimeOrderErrors);
+        std::ostringstream ss;
+        ss << "Records must be in ascending time order. "
+           << "Record '" << printRecord() << "' time " << time
+           << " is before bucket time " << m_LastFinalisedBucketEndTime;
+        LOG_ERROR(<< ss.str());
+        return;
+    }
+
+    LOG_TRACE(<< "Handling record " << printRecord());
+
+    this->outputBucketResultsUntil(time);
+
+    if (m_DetectorKeys.empty()) {
+        this->populateDetectorKeys(m_JobConfig, m_DetectorKeys);
+    }
+
+    for (std::size_t i = 0; i < m_DetectorKeys.size(); ++i) {
+        // TODO - should usenull apply to the partition field too?
+
+        const TAnomalyDetectorPtr& detector = this->detectorForKeyIndex(
+            i, time, partitionFieldValue(i), m_Limits.resourceMonitor());
+        if (detector == nullptr) {
+            // There wasn't enough memory to create the detector
+            continue;
+        }
+
+        addRecord(detector);
+    }
+
+    ++core::CProgramCounters::counter(counter_t::E_TSADNumberApiRecordsHandled);
+
+    ++m_NumRecordsHandled;
+    m_LatestRecordTime = std::max(m_LatestRecordTime, time);
+}
+
 void CAnomalyJob::addRecord(const TAnomalyDetectorPtr detector,
                             core_t::TTime time,
                             const TStrStrUMap& dataRowFields) {
     model::CAnomalyDetector::TStrCPtrVec fieldValues;
+    TWordVec fieldWords;
     const TStrVec& fieldNames = detector->fieldsOfInterest();
     fieldValues.reserve(fieldNames.size());
+    fieldWords.reserve(fieldNames.size());
     for (std::size_t i = 0; i < fieldNames.size(); ++i) {
-        fieldValues.push_back(fieldValue(fieldNames[i], dataRowFields));
+        const std::string* value{fieldValue(fieldNames[i], dataRowFields)};
+        fieldValues.push_back(value);
+        fieldWords.push_back(value != nullptr ? this->fieldWord(*value) : TWord{});
     }
 
-    detector->addRecord(time, fieldValues);
+    detector->addRecord(time, fieldValues, fieldWords);
+}
+
+const CAnomalyJob::TWord& CAnomalyJob::fieldWord(const std::string& value) {
+    // Records have few distinct field values so a linear search on the
+    // value's address is cheaper than hashing it.
+    for (const auto& word : m_RecordWords) {
+        if (word.first == &value) {
+            return word.second;
+        }
+    }
+    m_RecordWords.emplace_back(&value, model::CDynamicStringIdRegistry::word(value));
+    return m_RecordWords.back().second;
 }
 
 CAnomalyJob::SBackgroundPersistArgs::SBackgroundPersistArgs(
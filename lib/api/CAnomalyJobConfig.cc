@@ -196,6 +196,7 @@ const std::string
     CAnomalyJobConfig::CAnalysisConfig::CDetectorConfig::FUNCTION_SUM_VELOCITY("sum_velocity");
 
 const std::string CAnomalyJobConfig::CModelPlotConfig::ANNOTATIONS_ENABLED{"annotations_enabled"};
+const std::string CAnomalyJobConfig::CModelPlotConfig::BOUNDS_CADENCE{"bounds_cadence"};
 const std::string CAnomalyJobConfig::CModelPlotConfig::ENABLED{"enabled"};
 const std::string CAnomalyJobConfig::CModelPlotConfig::TERMS{"terms"};
 
@@ -333,6 +334,8 @@ const CAnomalyJobConfigReader MODEL_PLOT_CONFIG_READER{[] {
     CAnomalyJobConfigReader theReader;
     theReader.addParameter(CAnomalyJobConfig::CModelPlotConfig::ANNOTATIONS_ENABLED,
                            CAnomalyJobConfigReader::E_OptionalParameter);
+    theReader.addParameter(CAnomalyJobConfig::CModelPlotConfig::BOUNDS_CADENCE,
+                           CAnomalyJobConfigReader::E_OptionalParameter);
     theReader.addParameter(CAnomalyJobConfig::CModelPlotConfig::ENABLED,
                            CAnomalyJobConfigReader::E_OptionalParameter);
     theReader.addParameter(CAnomalyJobConfig::CModelPlotConfig::TERMS,
@@ -644,6 +647,7 @@ void CAnomalyJobConfig::CModelPlotConfig::parse(const json::value& modelPlotConf
 
     m_AnnotationsEnabled = parameters[ANNOTATIONS_ENABLED].fallback(false);
     m_Enabled = parameters[ENABLED].fallback(false);
+    m_BoundsCadence = parameters[BOUNDS_CADENCE].fallback(std::size_t{1});
     m_Terms = parameters[TERMS].fallback(EMPTY_STRING);
 }
 
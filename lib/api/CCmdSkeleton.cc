@@ -14,11 +14,13 @@
 #include <core/CDataSearcher.h>
 #include <core/CLogger.h>
 #include <core/CProgramCounters.h>
+#include <core/CStopWatch.h>
 
 #include <model/ModelTypes.h>
 
 #include <api/CDataProcessor.h>
 #include <api/CInputParser.h>
+#include <api/CRecordBatch.h>
 
 #include <functional>
 
@@ -44,21 +46,18 @@ bool CCmdSkeleton::ioLoop() {
         core::CProgramCounters::counter(counter_t::E_TSADAssignmentMemoryBasis) =
             static_cast<std::uint64_t>(model_t::E_AssignmentBasisModelMemoryLimit);
     } else {
+        core::CStopWatch restoreWatch{true};
         core_t::TTime completeToTime(0);
         if (m_Processor.restoreState(*m_RestoreSearcher, completeToTime) == false) {
             LOG_FATAL(<< "Failed to restore state");
             return false;
         }
+        LOG_INFO(<< "Restored state in " << restoreWatch.stop() << "ms");
     }
 
-    if (m_InputParser.readStreamIntoMaps(
-            [this](const CDataProcessor::TStrStrUMap& dataRowFields) {
-                return m_Processor.handleRecord(dataRowFields,
-                                                CDataProcessor::TOptionalTime{});
-            },
-            [this](const std::string& fieldName, std::string& fieldValue) {
-                m_Processor.registerMutableField(fieldName, fieldValue);
-            }) == false) {
+    if (m_InputParser.readStreamIntoBatches([this](const CRecordBatch& batch) {
+            return m_Processor.handleRecords(batch);
+        }) == false) {
         LOG_FATAL(<< "Failed to handle all input data");
         return false;
     }
@@ -57,6 +57,7 @@ bool CConfigUpdater::update(const std::string& json) {
         m_ModelConfig.configureModelPlot(modelPlotConfig.enabled(),
                                          modelPlotConfig.annotationsEnabled(),
                                          modelPlotConfig.terms());
+        m_ModelConfig.modelPlotBoundsCadence(modelPlotConfig.boundsCadence());
     } else if (obj.contains(CAnomalyJobConfig::FILTERS)) {
         if (m_JobConfig.parseFilterConfig(json) == false) {
             LOG_ERROR(<< "Failed to parse filter config update: " << json);
@@ -18,6 +18,7 @@
 #include <core/CLogger.h>
 #include <core/CStopWatch.h>
 #include <core/CVectorRange.h>
+#include <core/Concurrency.h>
 
 #include <maths/common/CBasicStatistics.h>
 #include <maths/common/COrderings.h>
@@ -112,6 +113,7 @@ bool CDataFrameAnalyzer::handleRecord(const TStrVec& fieldNames, const TStrVec&
 
 void CDataFrameAnalyzer::receivedAllRows() {
     if (m_DataFrame != nullptr) {
+        this->addBufferedRowsToDataFrame();
         m_DataFrame->finishWritingRows();
         LOG_DEBUG(<< "Received " << m_DataFrame->numberRows() << " rows");
     }
@@ -329,6 +331,20 @@ void CDataFrameAnalyzer::addRowToDataFrame(const TStrVec& fieldValues) {
     if (m_DataFrame == nullptr) {
         return;
     }
+
+    // With more than one thread we convert the field values of blocks of
+    // rows in parallel.
+    if (core::defaultAsyncThreadPoolSize() > 1) {
+        if (m_NumberBufferedRows == m_BufferedRows.size()) {
+            m_BufferedRows.emplace_back();
+        }
+        m_BufferedRows[m_NumberBufferedRows++] = fieldValues;
+        if (m_NumberBufferedRows == ROW_BLOCK_SIZE) {
+            this->addBufferedRowsToDataFrame();
+        }
+        return;
+    }
+
     auto columnValues = core::make_range(fieldValues, m_BeginDataFieldValues,
                                          m_EndDataFieldValues);
     m_DataFrame->parseAndWriteRow(columnValues, m_DataFrameColumnMap.get(),
@@ -337,6 +353,27 @@ void CDataFrameAnalyzer::addRowToDataFrame(const TStrVec& fieldValues) {
                                       : nullptr);
 }
 
+void CDataFrameAnalyzer::addBufferedRowsToDataFrame() {
+    if (m_NumberBufferedRows == 0) {
+        return;
+    }
+
+    core::CDataFrame::TStrCRngVec rows;
+    core::CDataFrame::TStrCPtrVec hashes;
+    rows.reserve(m_NumberBufferedRows);
+    hashes.reserve(m_NumberBufferedRows);
+    for (std::size_t i = 0; i < m_NumberBufferedRows; ++i) {
+        const TStrVec& fieldValues{m_BufferedRows[i]};
+        rows.push_back(core::make_range(fieldValues, m_BeginDataFieldValues,
+                                        m_EndDataFieldValues));
+        hashes.push_back(m_DocHashFieldIndex != FIELD_MISSING
+                             ? &fieldValues[m_DocHashFieldIndex]
+                             : nullptr);
+    }
+    m_DataFrame->parseAndWriteRows(rows, m_DataFrameColumnMap.get(), &hashes);
+    m_NumberBufferedRows = 0;
+}
+
 void CDataFrameAnalyzer::writeInferenceModel(const CDataFrameAnalysisRunner& analysis,
                                              core::CBoostJsonConcurrentLineWriter& writer) const {
     // Write the resulting model for inference.
@@ -421,5 +458,6 @@ const CDataFrameAnalysisRunner* CDataFrameAnalyzer::runner() const {
 const std::string CDataFrameAnalyzer::CONTROL_MESSAGE_FIELD_NAME{"."};
 const std::ptrdiff_t CDataFrameAnalyzer::FIELD_UNSET{-2};
 const std::ptrdiff_t CDataFrameAnalyzer::FIELD_MISSING{-1};
+const std::size_t CDataFrameAnalyzer::ROW_BLOCK_SIZE{8192};
 }
 }
@@ -470,14 +470,22 @@ void CDataFrameTrainBoostedTreeRunner::runImpl(core::CDataFrame& frame) {
                        ? std::move(boostedTree)
                        : m_BoostedTreeFactory->buildForTrain(frame, dependentVariableColumn);
         }();
+        core::CProgramCounters::counter(counter_t::E_DFTPMTimeToPrepare) = watch.lap();
         m_BoostedTree->train();
+        std::uint64_t trainedTime{watch.lap()};
         m_BoostedTree->predict();
+        core::CProgramCounters::counter(counter_t::E_DFTPMTimeToPredict) =
+            watch.lap() - trainedTime;
     } break;
-    case api_t::E_Update:
+    case api_t::E_Update: {
         m_BoostedTree = m_BoostedTreeFactory->buildForTrainIncremental(frame, dependentVariableColumn);
+        core::CProgramCounters::counter(counter_t::E_DFTPMTimeToPrepare) = watch.lap();
         m_BoostedTree->trainIncremental();
+        std::uint64_t trainedTime{watch.lap()};
         m_BoostedTree->predict(true /*new data only*/);
-        break;
+        core::CProgramCounters::counter(counter_t::E_DFTPMTimeToPredict) =
+            watch.lap() - trainedTime;
+    } break;
     case api_t::E_Predict:
         m_BoostedTree = m_BoostedTreeFactory->buildForPredict(frame, dependentVariableColumn);
         // Prediction occurs in buildForPredict.
@@ -15,6 +15,8 @@
 #include <core/CStringUtils.h>
 #include <core/CTimeUtils.h>
 
+#include <api/CRecordBatch.h>
+
 namespace ml {
 namespace api {
 
@@ -57,41 +59,93 @@ std::string CDataProcessor::debugPrintRecord(const TStrStrUMap& dataRowFields) {
     return result.str();
 }
 
-CDataProcessor::TOptionalTime CDataProcessor::parseTime(const TStrStrUMap& dataRowFields) const {
-    if (m_TimeFieldName.empty()) {
-        // No error message here - it's intentional there's no time
-        return TOptionalTime{};
+bool CDataProcessor::handleRecords(const CRecordBatch& batch) {
+    if (batch.fieldNames() != m_BatchFieldNames) {
+        m_BatchFieldNames = batch.fieldNames();
+        m_BatchRecord.clear();
+        m_BatchRecordValues.clear();
+        m_BatchRecordValues.reserve(m_BatchFieldNames.size());
+        for (const auto& fieldName : m_BatchFieldNames) {
+            m_BatchRecordValues.emplace_back(m_BatchRecord[fieldName]);
+        }
+        for (const auto& fieldName : batch.mutableFieldNames()) {
+            this->registerMutableField(fieldName, m_BatchRecord[fieldName]);
+        }
     }
-    auto iter = dataRowFields.find(m_TimeFieldName);
-    if (iter == dataRowFields.end()) {
+
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        for (std::size_t j = 0; j < m_BatchRecordValues.size(); ++j) {
+            m_BatchRecordValues[j].get() = batch.value(j, i);
+        }
+        if (this->handleRecord(m_BatchRecord, TOptionalTime{}) == false) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string CDataProcessor::debugPrintRecord(const CRecordBatch& batch, std::size_t record) {
+    TStrStrUMap dataRowFields;
+    batch.record(record, dataRowFields);
+    return debugPrintRecord(dataRowFields);
+}
+
+template<typename PRINT_RECORD>
+CDataProcessor::TOptionalTime
+CDataProcessor::parseTime(const std::string* timeValue, const PRINT_RECORD& printRecord) const {
+    if (timeValue == nullptr) {
         ++core::CProgramCounters::counter(counter_t::E_TSADNumberRecordsNoTimeField);
-        LOG_ERROR(<< "Found record with no " << m_TimeFieldName << " field:"
-                  << core_t::LINE_ENDING << this->debugPrintRecord(dataRowFields));
+        LOG_ERROR(<< "Found record with no " << m_TimeFieldName
+                  << " field:" << core_t::LINE_ENDING << printRecord());
         return TOptionalTime{};
     }
     core_t::TTime time{0};
     if (m_TimeFieldFormat.empty()) {
-        if (core::CStringUtils::stringToType(iter->second, time) == false) {
+        if (core::CStringUtils::stringToType(*timeValue, time) == false) {
             ++core::CProgramCounters::counter(counter_t::E_TSADNumberTimeFieldConversionErrors);
             LOG_ERROR(<< "Cannot interpret " << m_TimeFieldName
-                      << " field in record:" << core_t::LINE_ENDING
-                      << this->debugPrintRecord(dataRowFields));
+                      << " field in record:" << core_t::LINE_ENDING << printRecord());
             return TOptionalTime{};
         }
     } else {
         // Use this library function instead of raw strptime() as it works
         // around many operating system specific issues.
-        if (core::CTimeUtils::strptime(m_TimeFieldFormat, iter->second, time) == false) {
+        if (core::CTimeUtils::strptime(m_TimeFieldFormat, *timeValue, time) == false) {
             ++core::CProgramCounters::counter(counter_t::E_TSADNumberTimeFieldConversionErrors);
             LOG_ERROR(<< "Cannot interpret " << m_TimeFieldName << " field using format "
                       << m_TimeFieldFormat << " in record:" << core_t::LINE_ENDING
-                      << this->debugPrintRecord(dataRowFields));
+                      << printRecord());
             return TOptionalTime{};
         }
     }
     return time;
 }
 
+CDataProcessor::TOptionalTime CDataProcessor::parseTime(const TStrStrUMap& dataRowFields) const {
+    if (m_TimeFieldName.empty()) {
+        // No error message here - it's intentional there's no time
+        return TOptionalTime{};
+    }
+    auto iter = dataRowFields.find(m_TimeFieldName);
+    return this->parseTime(iter == dataRowFields.end() ? nullptr : &iter->second,
+                           [&] { return debugPrintRecord(dataRowFields); });
+}
+
+CDataProcessor::TOptionalSize CDataProcessor::timeField(const CRecordBatch& batch) const {
+    return m_TimeFieldName.empty() ? TOptionalSize{} : batch.fieldIndex(m_TimeFieldName);
+}
+
+CDataProcessor::TOptionalTime CDataProcessor::parseTime(const CRecordBatch& batch,
+                                                        std::size_t record,
+                                                        const TOptionalSize& timeField) const {
+    if (m_TimeFieldName.empty()) {
+        // No error message here - it's intentional there's no time
+        return TOptionalTime{};
+    }
+    return this->parseTime(timeField == std::nullopt ? nullptr : &batch.value(*timeField, record),
+                           [&] { return debugPrintRecord(batch, record); });
+}
+
 bool CDataProcessor::periodicPersistStateInBackground() {
     // No-op
     return true;
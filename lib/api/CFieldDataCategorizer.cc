@@ -22,6 +22,7 @@
 #include <core/CStateDecompressor.h>
 #include <core/CStateRestoreTraverser.h>
 #include <core/CStringUtils.h>
+#include <core/Concurrency.h>
 
 #include <model/CTokenListReverseSearchCreator.h>
 
@@ -30,6 +31,8 @@
 #include <api/CPerPartitionCategoryIdMapper.h>
 #include <api/CPersistenceManager.h>
 
+#include <boost/unordered_map.hpp>
+
 #include <memory>
 #include <sstream>
 
@@ -52,6 +55,7 @@ const std::string CFieldDataCategorizer::MLCATEGORY_NAME{"mlcategory"};
 const double CFieldDataCategorizer::SIMILARITY_THRESHOLD{0.7};
 const std::string CFieldDataCategorizer::STATE_TYPE{"categorizer_state"};
 const std::string CFieldDataCategorizer::STATE_VERSION{"1"};
+const std::size_t CFieldDataCategorizer::DEFAULT_CONCURRENT_CATEGORIZATION_BATCH_SIZE{1000};
 
 CFieldDataCategorizer::CFieldDataCategorizer(std::string jobId,
                                              const CAnomalyJobConfig::CAnalysisConfig& analysisConfig,
@@ -96,6 +100,10 @@ bool CFieldDataCategorizer::handleRecord(const TStrStrUMap& dataRowFields, TOpti
     // Non-empty control fields take precedence over everything else
     auto iter = dataRowFields.find(CONTROL_FIELD_NAME);
     if (iter != dataRowFields.end() && !iter->second.empty()) {
+        // Records received before the control message must be handled first
+        if (this->categorizeBufferedRecords() == false) {
+            return false;
+        }
         // Always handle control messages, but signal completion of handling ONLY if we are the last handler
         // e.g. flush requests are acknowledged here if this is the last handler
         bool msgHandled{this->handleControlMessage(iter->second, m_ChainedProcessor == nullptr)};
@@ -109,17 +117,13 @@ bool CFieldDataCategorizer::handleRecord(const TStrStrUMap& dataRowFields, TOpti
         time = this->parseTime(dataRowFields);
     }
 
+    if (this->isCategorizingConcurrently()) {
+        return this->bufferRecord(dataRowFields, time);
+    }
+
     CGlobalCategoryId globalCategoryId{this->computeAndUpdateCategory(dataRowFields, time)};
-    if (globalCategoryId.isHardFailure() == false) {
-        if (m_OutputFieldCategory != nullptr) {
-            *m_OutputFieldCategory =
-                core::CStringUtils::typeToString(globalCategoryId.globalId());
-        }
-        if (m_ChainedProcessor != nullptr &&
-            m_ChainedProcessor->handleRecord(dataRowFields, time) == false) {
-            return false;
-        }
-        ++m_NumRecordsHandled;
+    if (this->chainRecord(globalCategoryId, dataRowFields, time, m_OutputFieldCategory) == false) {
+        return false;
     }
 
     if (m_PersistenceManager != nullptr) {
@@ -133,6 +137,9 @@ bool CFieldDataCategorizer::handleRecord(const TStrStrUMap& dataRowFields, TOpti
 
 void CFieldDataCategorizer::finalise() {
 
+    // Handle any records still waiting to be categorized concurrently
+    this->categorizeBufferedRecords();
+
     // Make sure model size stats are up to date
     for (const auto& dataCategorizerEntry : m_DataCategorizers) {
         dataCategorizerEntry.second->forceResourceRefresh(m_Limits.resourceMonitor());
@@ -158,17 +165,34 @@ std::uint64_t CFieldDataCategorizer::numRecordsHandled() const {
     return m_NumRecordsHandled;
 }
 
+void CFieldDataCategorizer::concurrentCategorizationBatchSize(std::size_t batchSize) {
+    m_ConcurrentCategorizationBatchSize = batchSize;
+}
+
 CGlobalCategoryId
 CFieldDataCategorizer::computeAndUpdateCategory(const TStrStrUMap& dataRowFields,
                                                 const TOptionalTime& time) {
     CGlobalCategoryId globalCategoryId;
+    CSingleFieldDataCategorizer* dataCategorizer{
+        this->categorizerForRecord(dataRowFields, globalCategoryId)};
+    if (dataCategorizer == nullptr) {
+        return globalCategoryId;
+    }
+    bool changed{false};
+    model::CLocalCategoryId localCategoryId{
+        this->computeLocalCategory(*dataCategorizer, dataRowFields, changed)};
+    return this->updateCategory(*dataCategorizer, localCategoryId, changed, time);
+}
 
+CSingleFieldDataCategorizer*
+CFieldDataCategorizer::categorizerForRecord(const TStrStrUMap& dataRowFields,
+                                            CGlobalCategoryId& globalCategoryId) {
     auto fieldIter = dataRowFields.find(m_CategorizationFieldName);
     if (fieldIter == dataRowFields.end()) {
         LOG_WARN(<< "Assigning ML category " << globalCategoryId << " to record with no "
                  << m_CategorizationFieldName << " field:" << core_t::LINE_ENDING
                  << this->debugPrintRecord(dataRowFields));
-        return globalCategoryId;
+        return nullptr;
     }
 
     const std::string& fieldValue{fieldIter->second};
@@ -176,7 +200,7 @@ CFieldDataCategorizer::computeAndUpdateCategory(const TStrStrUMap& dataRowFields
         LOG_WARN(<< "Assigning ML category " << globalCategoryId << " to record with blank "
                  << m_CategorizationFieldName << " field:" << core_t::LINE_ENDING
                  << this->debugPrintRecord(dataRowFields));
-        return globalCategoryId;
+        return nullptr;
     }
 
     const std::string& partitionFieldValue{this->categorizerKeyForRecord(dataRowFields)};
@@ -197,30 +221,148 @@ CFieldDataCategorizer::computeAndUpdateCategory(const TStrStrUMap& dataRowFields
             }
         }
         m_Limits.resourceMonitor().categorizerAllocationFailures(m_CategorizerAllocationFailures);
-        return CGlobalCategoryId::hardFailure();
+        globalCategoryId = CGlobalCategoryId::hardFailure();
+        return nullptr;
     }
     if (m_StopCategorizationOnWarnStatus &&
         dataCategorizer->categorizationStatus() == model_t::E_CategorizationStatusWarn) {
         LOG_TRACE(<< "Ignoring input record as its categorizer has a 'warn' status:"
                   << core_t::LINE_ENDING << this->debugPrintRecord(dataRowFields));
-        return CGlobalCategoryId::hardFailure();
+        globalCategoryId = CGlobalCategoryId::hardFailure();
+        return nullptr;
     }
+    return dataCategorizer;
+}
+
+model::CLocalCategoryId
+CFieldDataCategorizer::computeLocalCategory(CSingleFieldDataCategorizer& dataCategorizer,
+                                            const TStrStrUMap& dataRowFields,
+                                            bool& changed) const {
+    // The caller has checked the record has a categorization field
+    const std::string& fieldValue{dataRowFields.find(m_CategorizationFieldName)->second};
     if (m_CategorizationFilter.empty()) {
-        globalCategoryId = dataCategorizer->computeAndUpdateCategory(
-            false, dataRowFields, time, fieldValue, fieldValue,
-            m_Limits.resourceMonitor(), m_JsonOutputWriter);
-    } else {
-        std::string filtered{m_CategorizationFilter.apply(fieldValue)};
-        globalCategoryId = dataCategorizer->computeAndUpdateCategory(
-            false, dataRowFields, time, filtered, fieldValue,
-            m_Limits.resourceMonitor(), m_JsonOutputWriter);
+        return dataCategorizer.computeLocalCategory(false, dataRowFields, fieldValue,
+                                                    fieldValue, changed);
     }
+    std::string filtered{m_CategorizationFilter.apply(fieldValue)};
+    return dataCategorizer.computeLocalCategory(false, dataRowFields, filtered,
+                                                fieldValue, changed);
+}
+
+CGlobalCategoryId
+CFieldDataCategorizer::updateCategory(CSingleFieldDataCategorizer& dataCategorizer,
+                                      model::CLocalCategoryId localCategoryId,
+                                      bool changed,
+                                      const TOptionalTime& time) {
+    CGlobalCategoryId globalCategoryId{dataCategorizer.updateCategory(
+        localCategoryId, changed, time, m_Limits.resourceMonitor(), m_JsonOutputWriter)};
     if (globalCategoryId.isValid()) {
-        dataCategorizer->writeStatsIfUrgent(m_JsonOutputWriter, m_AnnotationJsonWriter);
+        dataCategorizer.writeStatsIfUrgent(m_JsonOutputWriter, m_AnnotationJsonWriter);
     }
     return globalCategoryId;
 }
 
+bool CFieldDataCategorizer::isCategorizingConcurrently() const {
+    return m_ConcurrentCategorizationBatchSize > 1 &&
+           m_PartitionFieldName.empty() == false && core::defaultAsyncThreadPoolSize() > 1;
+}
+
+bool CFieldDataCategorizer::bufferRecord(const TStrStrUMap& dataRowFields,
+                                         const TOptionalTime& time) {
+    m_BufferedRecords.emplace_back(dataRowFields, time);
+    SBufferedRecord& record{m_BufferedRecords.back()};
+    record.s_DataCategorizer =
+        this->categorizerForRecord(record.s_Fields, record.s_GlobalCategoryId);
+    if (m_BufferedRecords.size() >= m_ConcurrentCategorizationBatchSize) {
+        return this->categorizeBufferedRecords();
+    }
+    return true;
+}
+
+bool CFieldDataCategorizer::categorizeBufferedRecords() {
+    if (m_BufferedRecords.empty()) {
+        return true;
+    }
+
+    using TSizeVec = std::vector<std::size_t>;
+    using TSizeVecVec = std::vector<TSizeVec>;
+    using TCategorizerCPtrSizeUMap =
+        boost::unordered_map<const CSingleFieldDataCategorizer*, std::size_t>;
+
+    // Group the records by categorizer preserving their order
+    TCategorizerCPtrSizeUMap partitionIndices;
+    TSizeVecVec partitions;
+    for (std::size_t i = 0; i < m_BufferedRecords.size(); ++i) {
+        const CSingleFieldDataCategorizer* dataCategorizer{m_BufferedRecords[i].s_DataCategorizer};
+        if (dataCategorizer != nullptr) {
+            auto partitionIndex = partitionIndices.emplace(dataCategorizer, partitions.size());
+            if (partitionIndex.second) {
+                partitions.emplace_back();
+            }
+            partitions[partitionIndex.first->second].push_back(i);
+        }
+    }
+
+    // Computing the local categories only touches each categorizer's own
+    // state, so each partition's records are categorized in order on one
+    // thread and the partitions are categorized concurrently.
+    core::parallel_for_each(0, partitions.size(), [this, &partitions](std::size_t i) {
+        for (auto j : partitions[i]) {
+            SBufferedRecord& record{m_BufferedRecords[j]};
+            record.s_LocalCategoryId = this->computeLocalCategory(
+                *record.s_DataCategorizer, record.s_Fields, record.s_Changed);
+        }
+    });
+
+    // Everything else uses shared state: the global category IDs, the output
+    // and the resource monitor.  So this is done serially in record order.
+    bool result{true};
+    for (auto& record : m_BufferedRecords) {
+        CGlobalCategoryId globalCategoryId{record.s_GlobalCategoryId};
+        if (record.s_DataCategorizer != nullptr) {
+            globalCategoryId = this->updateCategory(*record.s_DataCategorizer,
+                                                    record.s_LocalCategoryId,
+                                                    record.s_Changed, record.s_Time);
+        }
+        std::string* outputFieldCategory{nullptr};
+        if (m_OutputFieldCategory != nullptr) {
+            auto outputFieldIter = record.s_Fields.find(MLCATEGORY_NAME);
+            if (outputFieldIter != record.s_Fields.end()) {
+                outputFieldCategory = &outputFieldIter->second;
+            }
+        }
+        if (this->chainRecord(globalCategoryId, record.s_Fields, record.s_Time,
+                              outputFieldCategory) == false) {
+            result = false;
+            break;
+        }
+    }
+    m_BufferedRecords.clear();
+
+    if (result && m_PersistenceManager != nullptr) {
+        m_PersistenceManager->startPersistIfAppropriate();
+    }
+
+    return result;
+}
+
+bool CFieldDataCategorizer::chainRecord(const CGlobalCategoryId& globalCategoryId,
+                                        const TStrStrUMap& dataRowFields,
+                                        const TOptionalTime& time,
+                                        std::string* outputFieldCategory) {
+    if (globalCategoryId.isHardFailure() == false) {
+        if (outputFieldCategory != nullptr) {
+            *outputFieldCategory = core::CStringUtils::typeToString(globalCategoryId.globalId());
+        }
+        if (m_ChainedProcessor != nullptr &&
+            m_ChainedProcessor->handleRecord(dataRowFields, time) == false) {
+            return false;
+        }
+        ++m_NumRecordsHandled;
+    }
+    return true;
+}
+
 const std::string& CFieldDataCategorizer::categorizerKeyForRecord(const TStrStrUMap& dataRowFields) {
     if (m_PartitionFieldName.empty()) {
         return EMPTY_STRING;
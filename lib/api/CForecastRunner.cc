@@ -14,6 +14,7 @@
 #include <core/CLogger.h>
 #include <core/CStopWatch.h>
 #include <core/CTimeUtils.h>
+#include <core/Concurrency.h>
 
 #include <model/CForecastDataSink.h>
 #include <model/CForecastModelPersist.h>
@@ -23,6 +24,7 @@
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <algorithm>
 #include <sstream>
 
 namespace ml {
@@ -95,6 +97,10 @@ CForecastRunner::~CForecastRunner() {
     m_Worker.join();
 }
 
+void CForecastRunner::numberThreads(std::size_t numberThreads) {
+    m_NumberThreads.store(std::max(numberThreads, std::size_t{1}));
+}
+
 void CForecastRunner::finishForecasts() {
     std::unique_lock<std::mutex> lock(m_Mutex);
     // note: forecast could still be active
@@ -122,8 +128,6 @@ void CForecastRunner::forecastWorker() {
                 forecastJob.forecastEnd(), forecastJob.s_ExpiryTime,
                 forecastJob.s_MemoryUsage, m_ConcurrentOutputStream);
 
-            std::string message;
-
             // collecting the runtime messages first and sending it in 1 go
             TStrUSet messages(forecastJob.s_Messages);
             double processedModels = 0;
@@ -145,8 +149,23 @@ void CForecastRunner::forecastWorker() {
                 }
 
                 while (series.s_ToForecast.empty() == false || modelRestore != nullptr) {
-                    // check if we should backfill from persistence
-                    if (series.s_ToForecast.empty()) {
+                    // Gather the next batch of models, backfilling from persistence
+                    // as necessary.
+                    std::size_t numberThreads{m_NumberThreads.load()};
+                    std::size_t batchSize{numberThreads > 1 ? numberThreads * MODELS_PER_THREAD_PER_BATCH
+                                                            : 1};
+                    TForecastModelWrapperVec batch;
+                    batch.reserve(batchSize);
+                    while (batch.size() < batchSize) {
+                        if (series.s_ToForecast.empty() == false) {
+                            batch.push_back(std::move(series.s_ToForecast.back()));
+                            series.s_ToForecast.pop_back();
+                            continue;
+                        }
+                        if (modelRestore == nullptr) {
+                            break;
+                        }
+
                         TMathsModelPtr model;
                         core_t::TTime firstDataTime;
                         core_t::TTime lastDataTime;
@@ -155,42 +174,61 @@ void CForecastRunner::forecastWorker() {
 
                         if (modelRestore->nextModel(model, firstDataTime, lastDataTime,
                                                     feature, byFieldValue)) {
-                            series.s_ToForecast.emplace_back(
-                                feature, byFieldValue, std::move(model),
-                                firstDataTime, lastDataTime);
+                            batch.emplace_back(feature, byFieldValue, std::move(model),
+                                               firstDataTime, lastDataTime);
                         } else {
                             // restorer exhausted, no need for further restoring
                             modelRestore.reset();
-                            break;
                         }
                     }
-
-                    const TForecastModelWrapper& model{series.s_ToForecast.back()};
-                    bool success{model.forecast(
-                        series, forecastJob.s_StartTime, forecastJob.forecastEnd(),
-                        forecastJob.s_BoundsPercentile, sink, message)};
-                    series.s_ToForecast.pop_back();
-
-                    if (success == false) {
-                        LOG_DEBUG(<< "Detector " << series.s_DetectorIndex
-                                  << " failed to forecast");
-                        ++failedForecasts;
+                    if (batch.empty()) {
+                        break;
                     }
 
-                    if (message.empty() == false) {
-                        messages.insert("Detector[" + std::to_string(series.s_DetectorIndex) +
-                                        "]: " + message);
-                        message.clear();
+                    // Forecast the batch. If there is more than one model they're
+                    // forecast concurrently and the results are written in order
+                    // afterwards so the output doesn't depend on the thread count.
+                    TModelForecastVec forecasts(batch.size());
+                    if (batch.size() == 1) {
+                        forecasts[0].s_Success = batch[0].forecast(
+                            series, forecastJob.s_StartTime, forecastJob.forecastEnd(),
+                            forecastJob.s_BoundsPercentile, sink, forecasts[0].s_Message);
+                    } else {
+                        core::parallel_for_each(
+                            std::min(numberThreads, batch.size()), 0, batch.size(),
+                            [&](std::size_t i) {
+                                forecasts[i].s_Success = batch[i].forecast(
+                                    forecastJob.s_StartTime, forecastJob.forecastEnd(),
+                                    forecastJob.s_BoundsPercentile,
+                                    forecasts[i].s_ErrorBars, forecasts[i].s_Message);
+                            });
+                        for (std::size_t i = 0; i < batch.size(); ++i) {
+                            batch[i].write(series, forecasts[i].s_ErrorBars, sink);
+                        }
                     }
+                    batch.clear();
+
+                    for (auto& forecast : forecasts) {
+                        if (forecast.s_Success == false) {
+                            LOG_DEBUG(<< "Detector " << series.s_DetectorIndex
+                                      << " failed to forecast");
+                            ++failedForecasts;
+                        }
+
+                        if (forecast.s_Message.empty() == false) {
+                            messages.insert("Detector[" + std::to_string(series.s_DetectorIndex) +
+                                            "]: " + forecast.s_Message);
+                        }
 
-                    ++processedModels;
+                        ++processedModels;
 
-                    if (processedModels != totalNumberOfForecastableModels) {
-                        std::uint64_t elapsedTime = timer.lap();
-                        if (elapsedTime - lastStatsUpdate > MINIMUM_TIME_ELAPSED_FOR_STATS_UPDATE) {
-                            sink.writeStats(processedModels / totalNumberOfForecastableModels,
-                                            elapsedTime, forecastJob.s_Messages);
-                            lastStatsUpdate = elapsedTime;
+                        if (processedModels != totalNumberOfForecastableModels) {
+                            std::uint64_t elapsedTime = timer.lap();
+                            if (elapsedTime - lastStatsUpdate > MINIMUM_TIME_ELAPSED_FOR_STATS_UPDATE) {
+                                sink.writeStats(processedModels / totalNumberOfForecastableModels,
+                                                elapsedTime, forecastJob.s_Messages);
+                                lastStatsUpdate = elapsedTime;
+                            }
                         }
                     }
                 }
@@ -10,6 +10,9 @@
  */
 #include <api/CInputParser.h>
 
+#include <api/CDataProcessor.h>
+#include <api/CRecordBatch.h>
+
 #include <algorithm>
 
 namespace ml {
@@ -55,6 +58,57 @@ void CInputParser::registerMutableFields(const TRegisterMutableFieldFunc& regist
     }
 }
 
+bool CInputParser::readStreamIntoBatches(const TBatchReaderFunc& readerFunc,
+                                         std::size_t maxBatchSize) {
+
+    maxBatchSize = std::max(maxBatchSize, std::size_t{1});
+
+    CRecordBatch batch;
+    bool readerFailed{false};
+
+    auto flush = [&] {
+        if (batch.empty() == false) {
+            readerFailed = (readerFunc(batch) == false);
+            batch.clear();
+        }
+        return readerFailed == false;
+    };
+
+    bool result{this->readStreamIntoVecs(
+        [&](const TStrVec& fieldNames, const TStrVec& fieldValues) {
+            if (fieldNames != batch.fieldNames()) {
+                if (flush() == false) {
+                    return false;
+                }
+                batch.reset(fieldNames, m_MutableFieldNames);
+            }
+            batch.add(fieldValues);
+
+            // Control messages often ask for a response, so we must not
+            // sit on them waiting for more records.
+            auto controlField = std::find(fieldNames.begin(), fieldNames.end(),
+                                          CDataProcessor::CONTROL_FIELD_NAME);
+            bool isControlMessage{controlField != fieldNames.end() &&
+                                  fieldValues[controlField - fieldNames.begin()].empty() == false};
+
+            if (isControlMessage || batch.size() >= maxBatchSize ||
+                this->isNextRecordBuffered() == false) {
+                return flush();
+            }
+            return true;
+        },
+        TRegisterMutableFieldFunc{})};
+
+    if (readerFailed) {
+        return false;
+    }
+    return flush() && result;
+}
+
+bool CInputParser::isNextRecordBuffered() const {
+    return false;
+}
+
 const CInputParser::TStrVec& CInputParser::fieldNames() const {
     return m_FieldNames;
 }
@@ -62,5 +116,9 @@ const CInputParser::TStrVec& CInputParser::fieldNames() const {
 CInputParser::TStrVec& CInputParser::fieldNames() {
     return m_FieldNames;
 }
+
+const CInputParser::TStrVec& CInputParser::mutableFieldNames() const {
+    return m_MutableFieldNames;
+}
 }
 }
@@ -22,7 +22,10 @@
 #include <boost/unordered_map.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <iomanip>
 #include <sstream>
+#include <string_view>
 
 namespace ml {
 namespace api {
@@ -100,42 +103,26 @@ const std::string MULTIMODAL_DISTRIBUTION("multimodal_distribution");
 const std::string BY_FIELD_FIRST_OCCURRENCE("by_field_first_occurrence");
 const std::string BY_FIELD_RELATIVE_RARITY("by_field_relative_rarity");
 
-//! Get a numeric field from a JSON document.
-//! Assumes the document contains the field.
-//! The caller is responsible for ensuring this, and a
-//! program crash is likely if this requirement is not met.
-double doubleFromDocument(const CJsonOutputWriter::TDocumentWeakPtr& weakDoc,
-                          const std::string& field) {
-    CJsonOutputWriter::TDocumentPtr docPtr = weakDoc.lock();
-    if (!docPtr) {
-        LOG_ERROR(<< "Inconsistent program state. JSON document unavailable.");
-        return 0.0;
-    }
-    return (*docPtr)[field].to_number<double>();
-}
+using TSerialisedDocument = CJsonOutputWriter::SSerialisedDocument;
 
-//! Sort json documents by the probability lowest to highest
+//! Sort documents by the probability lowest to highest
 class CProbabilityLess {
 public:
-    bool operator()(const CJsonOutputWriter::TDocumentWeakPtrIntPr& lhs,
-                    const CJsonOutputWriter::TDocumentWeakPtrIntPr& rhs) const {
-        return doubleFromDocument(lhs.first, PROBABILITY) <
-               doubleFromDocument(rhs.first, PROBABILITY);
+    bool operator()(const TSerialisedDocument& lhs, const TSerialisedDocument& rhs) const {
+        return lhs.s_SortValue < rhs.s_SortValue;
     }
 };
 
 const CProbabilityLess PROBABILITY_LESS = CProbabilityLess();
 
-//! Sort json documents by detector name first then probability lowest to highest
+//! Sort documents by detector name first then probability lowest to highest
 class CDetectorThenProbabilityLess {
 public:
-    bool operator()(const CJsonOutputWriter::TDocumentWeakPtrIntPr& lhs,
-                    const CJsonOutputWriter::TDocumentWeakPtrIntPr& rhs) const {
-        if (lhs.second == rhs.second) {
-            return doubleFromDocument(lhs.first, PROBABILITY) <
-                   doubleFromDocument(rhs.first, PROBABILITY);
+    bool operator()(const TSerialisedDocument& lhs, const TSerialisedDocument& rhs) const {
+        if (lhs.s_DetectorIndex == rhs.s_DetectorIndex) {
+            return lhs.s_SortValue < rhs.s_SortValue;
         }
-        return lhs.second < rhs.second;
+        return lhs.s_DetectorIndex < rhs.s_DetectorIndex;
     }
 };
 
@@ -155,19 +142,66 @@ const CInfluencesLess INFLUENCE_LESS = CInfluencesLess();
 //! Sort influencer from highest to lowest by score
 class CInfluencerGreater {
 public:
-    CInfluencerGreater(const std::string& field) : m_Field(field) {}
+    bool operator()(const TSerialisedDocument& lhs, const TSerialisedDocument& rhs) const {
+        return lhs.s_SortValue > rhs.s_SortValue;
+    }
+};
+
+const CInfluencerGreater INFLUENCER_GREATER = CInfluencerGreater();
 
-    bool operator()(const CJsonOutputWriter::TDocumentWeakPtr& lhs,
-                    const CJsonOutputWriter::TDocumentWeakPtr& rhs) const {
-        return doubleFromDocument(lhs, m_Field) > doubleFromDocument(rhs, m_Field);
+//! Get the members of the serialised JSON object \p object.
+std::string_view members(const std::string& object) {
+    return std::string_view{object}.substr(1, object.size() - 2);
+}
+
+//! Write a string field. Empty strings are only written if \p allowEmptyString
+//! is true.
+void writeStringField(core::CStringBufWriter& writer,
+                      const std::string& name,
+                      const std::string& value,
+                      bool allowEmptyString = false) {
+    if (allowEmptyString || value.empty() == false) {
+        writer.onKey(name);
+        writer.onString(value);
     }
+}
 
-private:
-    const std::string& m_Field;
-};
+//! Write a double field. Values which aren't finite are written as zero.
+void writeDoubleField(core::CStringBufWriter& writer, const std::string& name, double value) {
+    if (std::isfinite(value) == false) {
+        LOG_ERROR(<< "Adding " << value << " to the \"" << name << "\" field of a JSON document");
+    }
+    writer.onKey(name);
+    writer.onDouble(value);
+}
 
-const CInfluencerGreater INFLUENCER_GREATER = CInfluencerGreater(INITIAL_INFLUENCER_SCORE);
-const CInfluencerGreater BUCKET_INFLUENCER_GREATER = CInfluencerGreater(INITIAL_SCORE);
+//! Write an array of doubles. Values which aren't finite are written as zero.
+template<typename VALUES>
+void writeDoubleArrayField(core::CStringBufWriter& writer,
+                           const std::string& name,
+                           const VALUES& values) {
+    writer.onKey(name);
+    writer.onArrayBegin();
+    bool considerLogging{true};
+    for (double value : values) {
+        if (considerLogging && std::isfinite(value) == false) {
+            LOG_ERROR(<< "Adding " << value << " to the \"" << name
+                      << "\" array in a JSON document");
+            considerLogging = false;
+        }
+        writer.onDouble(value);
+    }
+    writer.onArrayEnd();
+}
+
+//! Format a geo point as "latitude,longitude".
+template<typename POINT>
+std::string geoPointToString(const POINT& point) {
+    std::ostringstream result;
+    // We don't want scientific notation and geo points only have precision up to 12 digits
+    result << std::fixed << std::setprecision(12) << point[0] << "," << point[1];
+    return result.str();
+}
 }
 
 CJsonOutputWriter::CJsonOutputWriter(const std::string& jobId,
@@ -212,66 +246,71 @@ bool CJsonOutputWriter::acceptResult(const CHierarchicalResultsWriter::TResults&
         return true;
     }
 
-    std::weak_ptr<json::object> newDoc;
     if (!results.s_IsOverallResult) {
-        newDoc = m_Writer.makeStorableDoc();
-        this->addPopulationCauseFields(results, newDoc);
-        m_NestedDocs.push_back(newDoc);
+        std::string nestedDoc{this->acquireBuffer()};
+        this->beginDocument(nestedDoc);
+        this->addPopulationCauseFields(results);
+        this->endDocument(nestedDoc);
+        m_NestedDocs.push_back(std::move(nestedDoc));
 
         return true;
     }
 
     ++bucketData.s_RecordCount;
 
-    TDocumentWeakPtrIntPrVec& detectorDocumentsToWrite = bucketData.s_DocumentsToWrite;
+    TSerialisedDocumentVec& detectorDocumentsToWrite = bucketData.s_DocumentsToWrite;
 
-    bool makeHeap(false);
     // If a max number of records to output has not been set or we haven't
     // reached that limit yet just append the new document to the array
     if (m_RecordOutputLimit == 0 || bucketData.s_RecordCount <= m_RecordOutputLimit) {
-        newDoc = m_Writer.makeStorableDoc();
-        detectorDocumentsToWrite.push_back(TDocumentWeakPtrIntPr(newDoc, results.s_Identifier));
-
-        // the document array is now full, make a max heap
-        makeHeap = bucketData.s_RecordCount == m_RecordOutputLimit;
+        detectorDocumentsToWrite.push_back(
+            {results.s_Probability, results.s_Identifier, this->acquireBuffer()});
     } else {
         // Have reached the limit of records to write so compare the new doc
         // to the highest probability anomaly doc and replace if more anomalous
         if (results.s_Probability >= bucketData.s_HighestProbability) {
             // Discard any associated nested docs
-            m_NestedDocs.clear();
+            this->recycleNestedDocs();
             return true;
         }
 
-        newDoc = m_Writer.makeStorableDoc();
-        // remove the highest prob doc and insert new one
+        // Move the highest prob doc to the back and reuse its buffer for the
+        // new one
         std::pop_heap(detectorDocumentsToWrite.begin(),
                       detectorDocumentsToWrite.end(), PROBABILITY_LESS);
-        detectorDocumentsToWrite.pop_back();
-
-        detectorDocumentsToWrite.push_back(TDocumentWeakPtrIntPr(newDoc, results.s_Identifier));
-
-        makeHeap = true;
+        SSerialisedDocument& replaced = detectorDocumentsToWrite.back();
+        replaced.s_SortValue = results.s_Probability;
+        replaced.s_DetectorIndex = results.s_Identifier;
+        replaced.s_Json.clear();
     }
 
+    std::string& newDoc = detectorDocumentsToWrite.back().s_Json;
+    this->beginDocument(newDoc);
+
     // The check for population results must come first because some population
     // results are also metrics
     if (results.s_ResultType == CHierarchicalResultsWriter::E_PopulationResult) {
-        this->addPopulationFields(results, newDoc);
+        this->addPopulationFields(results);
     } else if (results.s_IsMetric) {
-        this->addMetricFields(results, newDoc);
+        this->addMetricFields(results);
     } else {
-        this->addEventRateFields(results, newDoc);
+        this->addEventRateFields(results);
     }
 
-    this->addInfluences(results.s_Influences, newDoc);
+    this->addInfluences(results.s_Influences);
 
-    if (makeHeap) {
-        std::make_heap(detectorDocumentsToWrite.begin(),
-                       detectorDocumentsToWrite.end(), PROBABILITY_LESS);
+    this->endDocument(newDoc);
 
-        bucketData.s_HighestProbability =
-            doubleFromDocument(detectorDocumentsToWrite.front().first, PROBABILITY);
+    if (m_RecordOutputLimit > 0 && bucketData.s_RecordCount >= m_RecordOutputLimit) {
+        if (bucketData.s_RecordCount == m_RecordOutputLimit) {
+            // the document array is now full, make a max heap
+            std::make_heap(detectorDocumentsToWrite.begin(),
+                           detectorDocumentsToWrite.end(), PROBABILITY_LESS);
+        } else {
+            std::push_heap(detectorDocumentsToWrite.begin(),
+                           detectorDocumentsToWrite.end(), PROBABILITY_LESS);
+        }
+        bucketData.s_HighestProbability = detectorDocumentsToWrite.front().s_SortValue;
     }
 
     return true;
@@ -280,14 +319,14 @@ bool CJsonOutputWriter::acceptResult(const CHierarchicalResultsWriter::TResults&
 bool CJsonOutputWriter::acceptInfluencer(core_t::TTime time,
                                          const model::CHierarchicalResults::TNode& node,
                                          bool isBucketInfluencer) {
-    TDocumentWeakPtr newDoc = m_Writer.makeStorableDoc();
     SBucketData& bucketData = m_BucketDataByTime[time];
-    TDocumentWeakPtrVec& documents = (isBucketInfluencer)
-                                         ? bucketData.s_BucketInfluencerDocuments
-                                         : bucketData.s_InfluencerDocuments;
+    TSerialisedDocumentVec& documents = (isBucketInfluencer)
+                                            ? bucketData.s_BucketInfluencerDocuments
+                                            : bucketData.s_InfluencerDocuments;
 
     bool isLimitedWrite(m_RecordOutputLimit > 0);
 
+    std::string newDoc;
     if (isLimitedWrite && documents.size() == m_RecordOutputLimit) {
         double& lowestScore = (isBucketInfluencer)
                                   ? bucketData.s_LowestBucketInfluencerScore
@@ -298,18 +337,23 @@ bool CJsonOutputWriter::acceptInfluencer(core_t::TTime time,
             return true;
         }
 
-        // need to remove the lowest score record
+        // need to remove the lowest score record, but we can reuse its buffer
+        newDoc = std::move(documents.back().s_Json);
+        newDoc.clear();
         documents.pop_back();
+    } else {
+        newDoc = this->acquireBuffer();
     }
 
-    this->addInfluencerFields(isBucketInfluencer, node, newDoc);
-    documents.push_back(newDoc);
+    this->beginDocument(newDoc);
+    this->addInfluencerFields(isBucketInfluencer, node);
+    this->endDocument(newDoc);
+    documents.push_back({node.s_NormalizedAnomalyScore, 0, std::move(newDoc)});
 
     bool sortVectorAfterWritingDoc = isLimitedWrite && documents.size() >= m_RecordOutputLimit;
 
     if (sortVectorAfterWritingDoc) {
-        std::sort(documents.begin(), documents.end(),
-                  isBucketInfluencer ? BUCKET_INFLUENCER_GREATER : INFLUENCER_GREATER);
+        std::sort(documents.begin(), documents.end(), INFLUENCER_GREATER);
     }
 
     if (isBucketInfluencer) {
@@ -317,13 +361,11 @@ bool CJsonOutputWriter::acceptInfluencer(core_t::TTime time,
             std::max(bucketData.s_MaxBucketInfluencerNormalizedAnomalyScore,
                      node.s_NormalizedAnomalyScore);
 
-        bucketData.s_LowestBucketInfluencerScore =
-            std::min(bucketData.s_LowestBucketInfluencerScore,
-                     doubleFromDocument(documents.back(), INITIAL_SCORE));
+        bucketData.s_LowestBucketInfluencerScore = std::min(
+            bucketData.s_LowestBucketInfluencerScore, documents.back().s_SortValue);
     } else {
         bucketData.s_LowestInfluencerScore =
-            std::min(bucketData.s_LowestInfluencerScore,
-                     doubleFromDocument(documents.back(), INITIAL_INFLUENCER_SCORE));
+            std::min(bucketData.s_LowestInfluencerScore, documents.back().s_SortValue);
     }
 
     return true;
@@ -338,21 +380,19 @@ void CJsonOutputWriter::acceptBucketTimeInfluencer(core_t::TTime time,
         return;
     }
 
-    TDocumentWeakPtr doc = m_Writer.makeStorableDoc();
-    TDocumentPtr newDoc = doc.lock();
-    if (!newDoc) {
-        LOG_ERROR(<< "Failed to create new JSON document");
-        return;
-    }
-    m_Writer.addStringFieldCopyToObj(INFLUENCER_FIELD_NAME, TIME_INFLUENCER, *newDoc);
-    m_Writer.addDoubleFieldToObj(PROBABILITY, probability, *newDoc);
-    m_Writer.addDoubleFieldToObj(RAW_ANOMALY_SCORE, rawAnomalyScore, *newDoc);
-    m_Writer.addDoubleFieldToObj(INITIAL_SCORE, normalizedAnomalyScore, *newDoc);
-    m_Writer.addDoubleFieldToObj(ANOMALY_SCORE, normalizedAnomalyScore, *newDoc);
+    std::string newDoc{this->acquireBuffer()};
+    this->beginDocument(newDoc);
+    writeStringField(m_DocumentWriter, INFLUENCER_FIELD_NAME, TIME_INFLUENCER);
+    writeDoubleField(m_DocumentWriter, PROBABILITY, probability);
+    writeDoubleField(m_DocumentWriter, RAW_ANOMALY_SCORE, rawAnomalyScore);
+    writeDoubleField(m_DocumentWriter, INITIAL_SCORE, normalizedAnomalyScore);
+    writeDoubleField(m_DocumentWriter, ANOMALY_SCORE, normalizedAnomalyScore);
+    this->endDocument(newDoc);
 
     bucketData.s_MaxBucketInfluencerNormalizedAnomalyScore = std::max(
         bucketData.s_MaxBucketInfluencerNormalizedAnomalyScore, normalizedAnomalyScore);
-    bucketData.s_BucketInfluencerDocuments.push_back(doc);
+    bucketData.s_BucketInfluencerDocuments.push_back(
+        {normalizedAnomalyScore, 0, std::move(newDoc)});
 }
 
 bool CJsonOutputWriter::endOutputBatch(bool isInterim, std::uint64_t bucketProcessingTime) {
@@ -365,9 +405,14 @@ bool CJsonOutputWriter::endOutputBatch(bool isInterim, std::uint64_t bucketProce
     }
 
     // After writing the buckets clear all the bucket data so that we don't
-    // accumulate memory.
+    // accumulate memory, but keep the document buffers for the next batch.
+    for (auto& bucketData : m_BucketDataByTime) {
+        this->recycleBuffers(bucketData.second.s_DocumentsToWrite);
+        this->recycleBuffers(bucketData.second.s_BucketInfluencerDocuments);
+        this->recycleBuffers(bucketData.second.s_InfluencerDocuments);
+    }
     m_BucketDataByTime.clear();
-    m_NestedDocs.clear();
+    this->recycleNestedDocs();
 
     return true;
 }
@@ -388,27 +433,22 @@ void CJsonOutputWriter::writeBucket(bool isInterim,
         m_Writer.onArrayBegin();
 
         // Iterate over the different detectors that we have results for
-        for (TDocumentWeakPtrIntPrVecItr detectorIter =
-                 bucketData.s_DocumentsToWrite.begin();
-             detectorIter != bucketData.s_DocumentsToWrite.end(); ++detectorIter) {
+        for (const auto& document : bucketData.s_DocumentsToWrite) {
             // Write the document, adding some extra fields as we go
-            int detectorIndex = detectorIter->second;
-            TDocumentWeakPtr weakDoc = detectorIter->first;
-            TDocumentPtr docPtr = weakDoc.lock();
-            if (!docPtr) {
-                LOG_ERROR(<< "Inconsistent program state. JSON document unavailable.");
-                continue;
-            }
-
-            m_Writer.addIntFieldToObj(DETECTOR_INDEX, detectorIndex, *docPtr);
-            m_Writer.addIntFieldToObj(BUCKET_SPAN, bucketData.s_BucketSpan, *docPtr);
-            m_Writer.addStringFieldCopyToObj(JOB_ID, m_JobId, *docPtr);
-            m_Writer.addTimeFieldToObj(TIMESTAMP, bucketTime, *docPtr);
-
+            m_Writer.onObjectBegin();
+            m_Writer.onRawMembers(members(document.s_Json));
+            m_Writer.onKey(DETECTOR_INDEX);
+            m_Writer.onInt64(document.s_DetectorIndex);
+            m_Writer.onKey(BUCKET_SPAN);
+            m_Writer.onInt64(bucketData.s_BucketSpan);
+            writeStringField(m_Writer, JOB_ID, m_JobId);
+            m_Writer.onKey(TIMESTAMP);
+            m_Writer.onTime(bucketTime);
             if (isInterim) {
-                m_Writer.addBoolFieldToObj(IS_INTERIM, isInterim, *docPtr);
+                m_Writer.onKey(IS_INTERIM);
+                m_Writer.onBool(isInterim);
             }
-            m_Writer.write(*docPtr);
+            m_Writer.onObjectEnd();
         }
         m_Writer.onArrayEnd();
         m_Writer.onObjectEnd();
@@ -419,23 +459,19 @@ void CJsonOutputWriter::writeBucket(bool isInterim,
         m_Writer.onObjectBegin();
         m_Writer.onKey(INFLUENCERS);
         m_Writer.onArrayBegin();
-        for (TDocumentWeakPtrVecItr influencerIter =
-                 bucketData.s_InfluencerDocuments.begin();
-             influencerIter != bucketData.s_InfluencerDocuments.end(); ++influencerIter) {
-            TDocumentWeakPtr weakDoc = *influencerIter;
-            TDocumentPtr docPtr = weakDoc.lock();
-            if (!docPtr) {
-                LOG_ERROR(<< "Inconsistent program state. JSON document unavailable.");
-                continue;
-            }
-
-            m_Writer.addStringFieldCopyToObj(JOB_ID, m_JobId, *docPtr);
-            m_Writer.addTimeFieldToObj(TIMESTAMP, bucketTime, *docPtr);
+        for (const auto& document : bucketData.s_InfluencerDocuments) {
+            m_Writer.onObjectBegin();
+            m_Writer.onRawMembers(members(document.s_Json));
+            writeStringField(m_Writer, JOB_ID, m_JobId);
+            m_Writer.onKey(TIMESTAMP);
+            m_Writer.onTime(bucketTime);
             if (isInterim) {
-                m_Writer.addBoolFieldToObj(IS_INTERIM, isInterim, *docPtr);
+                m_Writer.onKey(IS_INTERIM);
+                m_Writer.onBool(isInterim);
             }
-            m_Writer.addIntFieldToObj(BUCKET_SPAN, bucketData.s_BucketSpan, *docPtr);
-            m_Writer.write(*docPtr);
+            m_Writer.onKey(BUCKET_SPAN);
+            m_Writer.onInt64(bucketData.s_BucketSpan);
+            m_Writer.onObjectEnd();
         }
         m_Writer.onArrayEnd();
         m_Writer.onObjectEnd();
@@ -468,24 +504,19 @@ void CJsonOutputWriter::writeBucket(bool isInterim,
         // Write the array of influencers
         m_Writer.onKey(BUCKET_INFLUENCERS);
         m_Writer.onArrayBegin();
-        for (TDocumentWeakPtrVecItr influencerIter =
-                 bucketData.s_BucketInfluencerDocuments.begin();
-             influencerIter != bucketData.s_BucketInfluencerDocuments.end();
-             ++influencerIter) {
-            TDocumentWeakPtr weakDoc = *influencerIter;
-            TDocumentPtr docPtr = weakDoc.lock();
-            if (!docPtr) {
-                LOG_ERROR(<< "Inconsistent program state. JSON document unavailable.");
-                continue;
-            }
-
-            m_Writer.addStringFieldCopyToObj(JOB_ID, m_JobId, *docPtr);
-            m_Writer.addTimeFieldToObj(TIMESTAMP, bucketTime, *docPtr);
-            m_Writer.addIntFieldToObj(BUCKET_SPAN, bucketData.s_BucketSpan, *docPtr);
+        for (const auto& document : bucketData.s_BucketInfluencerDocuments) {
+            m_Writer.onObjectBegin();
+            m_Writer.onRawMembers(members(document.s_Json));
+            writeStringField(m_Writer, JOB_ID, m_JobId);
+            m_Writer.onKey(TIMESTAMP);
+            m_Writer.onTime(bucketTime);
+            m_Writer.onKey(BUCKET_SPAN);
+            m_Writer.onInt64(bucketData.s_BucketSpan);
             if (isInterim) {
-                m_Writer.addBoolFieldToObj(IS_INTERIM, isInterim, *docPtr);
+                m_Writer.onKey(IS_INTERIM);
+                m_Writer.onBool(isInterim);
             }
-            m_Writer.write(*docPtr);
+            m_Writer.onObjectEnd();
         }
         m_Writer.onArrayEnd();
     }
@@ -506,207 +537,189 @@ void CJsonOutputWriter::writeBucket(bool isInterim,
     m_Writer.onObjectEnd();
 }
 
-void CJsonOutputWriter::addMetricFields(const CHierarchicalResultsWriter::TResults& results,
-                                        TDocumentWeakPtr weakDoc) {
-    TDocumentPtr docPtr = weakDoc.lock();
-    if (!docPtr) {
-        LOG_ERROR(<< "Inconsistent program state. JSON document unavailable.");
-        return;
+std::string CJsonOutputWriter::acquireBuffer() {
+    if (m_BufferPool.empty()) {
+        return {};
     }
+    std::string buffer{std::move(m_BufferPool.back())};
+    m_BufferPool.pop_back();
+    return buffer;
+}
+
+void CJsonOutputWriter::recycleBuffer(std::string& buffer) {
+    buffer.clear();
+    m_BufferPool.push_back(std::move(buffer));
+}
 
+void CJsonOutputWriter::recycleBuffers(TSerialisedDocumentVec& documents) {
+    for (auto& document : documents) {
+        this->recycleBuffer(document.s_Json);
+    }
+    documents.clear();
+}
+
+void CJsonOutputWriter::recycleNestedDocs() {
+    for (auto& nestedDoc : m_NestedDocs) {
+        this->recycleBuffer(nestedDoc);
+    }
+    m_NestedDocs.clear();
+}
+
+void CJsonOutputWriter::beginDocument(std::string& buffer) {
+    m_DocumentWriter.reset(buffer);
+    m_DocumentWriter.onObjectBegin();
+}
+
+void CJsonOutputWriter::endDocument(std::string& buffer) {
+    m_DocumentWriter.onObjectEnd();
+    // The line writer terminates each top level object with a newline.
+    if (buffer.empty() == false && buffer.back() == '\n') {
+        buffer.pop_back();
+    }
+}
+
+void CJsonOutputWriter::addMetricFields(const CHierarchicalResultsWriter::TResults& results) {
     // record_score, probability, fieldName, byFieldName, byFieldValue, partitionFieldName,
     // partitionFieldValue, function, typical, actual. influences?
-    m_Writer.addDoubleFieldToObj(INITIAL_RECORD_SCORE,
-                                 results.s_NormalizedAnomalyScore, *docPtr);
-    m_Writer.addDoubleFieldToObj(RECORD_SCORE, results.s_NormalizedAnomalyScore, *docPtr);
-    m_Writer.addDoubleFieldToObj(PROBABILITY, results.s_Probability, *docPtr);
+    writeDoubleField(m_DocumentWriter, INITIAL_RECORD_SCORE, results.s_NormalizedAnomalyScore);
+    writeDoubleField(m_DocumentWriter, RECORD_SCORE, results.s_NormalizedAnomalyScore);
+    writeDoubleField(m_DocumentWriter, PROBABILITY, results.s_Probability);
 
-    json::object anomalyScoreExplanation = m_Writer.makeObject();
-    this->writeAnomalyScoreExplanationObject(results, anomalyScoreExplanation);
-    m_Writer.addMember(ANOMALY_SCORE_EXPLANATION, anomalyScoreExplanation, *docPtr);
+    m_DocumentWriter.onKey(ANOMALY_SCORE_EXPLANATION);
+    this->writeAnomalyScoreExplanationObject(results);
 
-    m_Writer.addDoubleFieldToObj(MULTI_BUCKET_IMPACT, results.s_MultiBucketImpact, *docPtr);
-    m_Writer.addStringFieldCopyToObj(FIELD_NAME, results.s_MetricValueField, *docPtr);
+    writeDoubleField(m_DocumentWriter, MULTI_BUCKET_IMPACT, results.s_MultiBucketImpact);
+    writeStringField(m_DocumentWriter, FIELD_NAME, results.s_MetricValueField);
     if (!results.s_ByFieldName.empty()) {
-        m_Writer.addStringFieldCopyToObj(BY_FIELD_NAME, results.s_ByFieldName, *docPtr);
+        writeStringField(m_DocumentWriter, BY_FIELD_NAME, results.s_ByFieldName);
         // If name is present then force output of value too, even when empty
-        m_Writer.addStringFieldCopyToObj(BY_FIELD_VALUE, results.s_ByFieldValue,
-                                         *docPtr, true);
+        writeStringField(m_DocumentWriter, BY_FIELD_VALUE, results.s_ByFieldValue, true);
         // But allow correlatedByFieldValue to be unset if blank
-        m_Writer.addStringFieldCopyToObj(CORRELATED_BY_FIELD_VALUE,
-                                         results.s_CorrelatedByFieldValue, *docPtr);
+        writeStringField(m_DocumentWriter, CORRELATED_BY_FIELD_VALUE,
+                         results.s_CorrelatedByFieldValue);
     }
     if (!results.s_PartitionFieldName.empty()) {
-        m_Writer.addStringFieldCopyToObj(PARTITION_FIELD_NAME,
-                                         results.s_PartitionFieldName, *docPtr);
+        writeStringField(m_DocumentWriter, PARTITION_FIELD_NAME, results.s_PartitionFieldName);
         // If name is present then force output of value too, even when empty
-        m_Writer.addStringFieldCopyToObj(
-            PARTITION_FIELD_VALUE, results.s_PartitionFieldValue, *docPtr, true);
+        writeStringField(m_DocumentWriter, PARTITION_FIELD_VALUE,
+                         results.s_PartitionFieldValue, true);
     }
-    m_Writer.addStringFieldCopyToObj(FUNCTION, results.s_FunctionName, *docPtr);
-    m_Writer.addStringFieldCopyToObj(FUNCTION_DESCRIPTION,
-                                     results.s_FunctionDescription, *docPtr);
-    m_Writer.addDoubleArrayFieldToObj(TYPICAL, results.s_BaselineMean, *docPtr);
-    m_Writer.addDoubleArrayFieldToObj(ACTUAL, results.s_CurrentMean, *docPtr);
+    writeStringField(m_DocumentWriter, FUNCTION, results.s_FunctionName);
+    writeStringField(m_DocumentWriter, FUNCTION_DESCRIPTION, results.s_FunctionDescription);
+    writeDoubleArrayField(m_DocumentWriter, TYPICAL, results.s_BaselineMean);
+    writeDoubleArrayField(m_DocumentWriter, ACTUAL, results.s_CurrentMean);
     if (results.s_FunctionName ==
         CAnomalyJobConfig::CAnalysisConfig::CDetectorConfig::FUNCTION_LAT_LONG) {
-        json::object geoResults = m_Writer.makeObject();
-        auto geoPointToString = [](const auto& point) -> std::string {
-            std::ostringstream result;
-            // We don't want scientific notation and geo points only have precision up to 12 digits
-            result << std::fixed << std::setprecision(12) << point[0] << "," << point[1];
-            return result.str();
-        };
+        m_DocumentWriter.onKey(GEO_RESULTS);
+        m_DocumentWriter.onObjectBegin();
         if (results.s_BaselineMean.size() == 2) {
-            m_Writer.addStringFieldCopyToObj(
-                TYPICAL_POINT, geoPointToString(results.s_BaselineMean), geoResults);
+            writeStringField(m_DocumentWriter, TYPICAL_POINT,
+                             geoPointToString(results.s_BaselineMean));
         }
         if (results.s_CurrentMean.size() == 2) {
-            m_Writer.addStringFieldCopyToObj(
-                ACTUAL_POINT, geoPointToString(results.s_CurrentMean), geoResults);
+            writeStringField(m_DocumentWriter, ACTUAL_POINT,
+                             geoPointToString(results.s_CurrentMean));
         }
-        m_Writer.addMember(GEO_RESULTS, geoResults, *docPtr);
+        m_DocumentWriter.onObjectEnd();
     }
 }
 
-void CJsonOutputWriter::addPopulationFields(const CHierarchicalResultsWriter::TResults& results,
-                                            TDocumentWeakPtr weakDoc) {
-    TDocumentPtr docPtr = weakDoc.lock();
-    if (!docPtr) {
-        LOG_ERROR(<< "Inconsistent program state. JSON document unavailable.");
-        return;
-    }
-
+void CJsonOutputWriter::addPopulationFields(const CHierarchicalResultsWriter::TResults& results) {
     // record_score, probability, fieldName, byFieldName,
     // overFieldName, overFieldValue, partitionFieldName, partitionFieldValue,
     // function, causes, influences?
-    m_Writer.addDoubleFieldToObj(INITIAL_RECORD_SCORE,
-                                 results.s_NormalizedAnomalyScore, *docPtr);
-    m_Writer.addDoubleFieldToObj(RECORD_SCORE, results.s_NormalizedAnomalyScore, *docPtr);
-    m_Writer.addDoubleFieldToObj(PROBABILITY, results.s_Probability, *docPtr);
-    m_Writer.addStringFieldCopyToObj(FIELD_NAME, results.s_MetricValueField, *docPtr);
+    writeDoubleField(m_DocumentWriter, INITIAL_RECORD_SCORE, results.s_NormalizedAnomalyScore);
+    writeDoubleField(m_DocumentWriter, RECORD_SCORE, results.s_NormalizedAnomalyScore);
+    writeDoubleField(m_DocumentWriter, PROBABILITY, results.s_Probability);
+    writeStringField(m_DocumentWriter, FIELD_NAME, results.s_MetricValueField);
     // There are no by field values at this level for population
     // results - they're in the "causes" object
-    m_Writer.addStringFieldCopyToObj(BY_FIELD_NAME, results.s_ByFieldName, *docPtr);
+    writeStringField(m_DocumentWriter, BY_FIELD_NAME, results.s_ByFieldName);
     if (!results.s_OverFieldName.empty()) {
-        m_Writer.addStringFieldCopyToObj(OVER_FIELD_NAME, results.s_OverFieldName, *docPtr);
+        writeStringField(m_DocumentWriter, OVER_FIELD_NAME, results.s_OverFieldName);
         // If name is present then force output of value too, even when empty
-        m_Writer.addStringFieldCopyToObj(OVER_FIELD_VALUE,
-                                         results.s_OverFieldValue, *docPtr, true);
+        writeStringField(m_DocumentWriter, OVER_FIELD_VALUE, results.s_OverFieldValue, true);
     }
     if (!results.s_PartitionFieldName.empty()) {
-        m_Writer.addStringFieldCopyToObj(PARTITION_FIELD_NAME,
-                                         results.s_PartitionFieldName, *docPtr);
+        writeStringField(m_DocumentWriter, PARTITION_FIELD_NAME, results.s_PartitionFieldName);
         // If name is present then force output of value too, even when empty
-        m_Writer.addStringFieldCopyToObj(
-            PARTITION_FIELD_VALUE, results.s_PartitionFieldValue, *docPtr, true);
+        writeStringField(m_DocumentWriter, PARTITION_FIELD_VALUE,
+                         results.s_PartitionFieldValue, true);
     }
-    m_Writer.addStringFieldCopyToObj(FUNCTION, results.s_FunctionName, *docPtr);
-    m_Writer.addStringFieldCopyToObj(FUNCTION_DESCRIPTION,
-                                     results.s_FunctionDescription, *docPtr);
+    writeStringField(m_DocumentWriter, FUNCTION, results.s_FunctionName);
+    writeStringField(m_DocumentWriter, FUNCTION_DESCRIPTION, results.s_FunctionDescription);
 
     // Add nested causes
     if (m_NestedDocs.size() > 0) {
-        json::value causeArray = m_Writer.makeArray(m_NestedDocs.size());
-        for (std::size_t index = 0; index < m_NestedDocs.size(); ++index) {
-            TDocumentWeakPtr nwDocPtr = m_NestedDocs[index];
-            TDocumentPtr nDocPtr = nwDocPtr.lock();
-            if (!nDocPtr) {
-                LOG_ERROR(<< "Inconsistent program state. JSON document unavailable.");
-                continue;
-            }
-            json::object& docAsValue = *nDocPtr;
-
-            m_Writer.pushBack(docAsValue, causeArray);
+        m_DocumentWriter.onKey(CAUSES);
+        m_DocumentWriter.onArrayBegin();
+        for (const auto& nestedDoc : m_NestedDocs) {
+            m_DocumentWriter.onRawString(nestedDoc);
         }
-        m_Writer.addMember(CAUSES, causeArray, *docPtr);
+        m_DocumentWriter.onArrayEnd();
 
-        m_NestedDocs.clear();
+        this->recycleNestedDocs();
     } else {
         LOG_WARN(<< "Expected some causes for a population anomaly but got none");
     }
 }
 
-void CJsonOutputWriter::addPopulationCauseFields(const CHierarchicalResultsWriter::TResults& results,
-                                                 TDocumentWeakPtr weakDoc) {
-    TDocumentPtr docPtr = weakDoc.lock();
-    if (!docPtr) {
-        LOG_ERROR(<< "Inconsistent program state. JSON document unavailable.");
-        return;
-    }
-
+void CJsonOutputWriter::addPopulationCauseFields(const CHierarchicalResultsWriter::TResults& results) {
     // probability, fieldName, byFieldName, byFieldValue,
     // overFieldName, overFieldValue, partitionFieldName, partitionFieldValue,
     // function, typical, actual, influences
-    m_Writer.addDoubleFieldToObj(PROBABILITY, results.s_Probability, *docPtr);
-    m_Writer.addStringFieldCopyToObj(FIELD_NAME, results.s_MetricValueField, *docPtr);
+    writeDoubleField(m_DocumentWriter, PROBABILITY, results.s_Probability);
+    writeStringField(m_DocumentWriter, FIELD_NAME, results.s_MetricValueField);
     if (!results.s_ByFieldName.empty()) {
-        m_Writer.addStringFieldCopyToObj(BY_FIELD_NAME, results.s_ByFieldName, *docPtr);
+        writeStringField(m_DocumentWriter, BY_FIELD_NAME, results.s_ByFieldName);
         // If name is present then force output of value too, even when empty
-        m_Writer.addStringFieldCopyToObj(BY_FIELD_VALUE, results.s_ByFieldValue,
-                                         *docPtr, true);
+        writeStringField(m_DocumentWriter, BY_FIELD_VALUE, results.s_ByFieldValue, true);
         // But allow correlatedByFieldValue to be unset if blank
-        m_Writer.addStringFieldCopyToObj(CORRELATED_BY_FIELD_VALUE,
-                                         results.s_CorrelatedByFieldValue, *docPtr);
+        writeStringField(m_DocumentWriter, CORRELATED_BY_FIELD_VALUE,
+                         results.s_CorrelatedByFieldValue);
     }
     if (!results.s_OverFieldName.empty()) {
-        m_Writer.addStringFieldCopyToObj(OVER_FIELD_NAME, results.s_OverFieldName, *docPtr);
+        writeStringField(m_DocumentWriter, OVER_FIELD_NAME, results.s_OverFieldName);
         // If name is present then force output of value too, even when empty
-        m_Writer.addStringFieldCopyToObj(OVER_FIELD_VALUE,
-                                         results.s_OverFieldValue, *docPtr, true);
+        writeStringField(m_DocumentWriter, OVER_FIELD_VALUE, results.s_OverFieldValue, true);
     }
     if (!results.s_PartitionFieldName.empty()) {
-        m_Writer.addStringFieldCopyToObj(PARTITION_FIELD_NAME,
-                                         results.s_PartitionFieldName, *docPtr);
+        writeStringField(m_DocumentWriter, PARTITION_FIELD_NAME, results.s_PartitionFieldName);
         // If name is present then force output of value too, even when empty
-        m_Writer.addStringFieldCopyToObj(
-            PARTITION_FIELD_VALUE, results.s_PartitionFieldValue, *docPtr, true);
+        writeStringField(m_DocumentWriter, PARTITION_FIELD_VALUE,
+                         results.s_PartitionFieldValue, true);
     }
-    m_Writer.addStringFieldCopyToObj(FUNCTION, results.s_FunctionName, *docPtr);
-    m_Writer.addStringFieldCopyToObj(FUNCTION_DESCRIPTION,
-                                     results.s_FunctionDescription, *docPtr);
-    m_Writer.addDoubleArrayFieldToObj(TYPICAL, results.s_PopulationAverage, *docPtr);
-    m_Writer.addDoubleArrayFieldToObj(ACTUAL, results.s_FunctionValue, *docPtr);
+    writeStringField(m_DocumentWriter, FUNCTION, results.s_FunctionName);
+    writeStringField(m_DocumentWriter, FUNCTION_DESCRIPTION, results.s_FunctionDescription);
+    writeDoubleArrayField(m_DocumentWriter, TYPICAL, results.s_PopulationAverage);
+    writeDoubleArrayField(m_DocumentWriter, ACTUAL, results.s_FunctionValue);
     if (results.s_FunctionName ==
         CAnomalyJobConfig::CAnalysisConfig::CDetectorConfig::FUNCTION_LAT_LONG) {
-        json::object geoResults = m_Writer.makeObject();
-        auto geoPointToString = [](const auto& point) -> std::string {
-            std::ostringstream result;
-            // We don't want scientific notation and geo points only have precision up to 12 digits
-            result << std::fixed << std::setprecision(12) << point[0] << "," << point[1];
-            return result.str();
-        };
+        m_DocumentWriter.onKey(GEO_RESULTS);
+        m_DocumentWriter.onObjectBegin();
         if (results.s_BaselineMean.size() == 2) {
-            m_Writer.addStringFieldCopyToObj(
-                TYPICAL_POINT, geoPointToString(results.s_PopulationAverage), geoResults);
+            writeStringField(m_DocumentWriter, TYPICAL_POINT,
+                             geoPointToString(results.s_PopulationAverage));
         }
         if (results.s_FunctionValue.size() == 2) {
-            m_Writer.addStringFieldCopyToObj(
-                ACTUAL_POINT, geoPointToString(results.s_FunctionValue), geoResults);
+            writeStringField(m_DocumentWriter, ACTUAL_POINT,
+                             geoPointToString(results.s_FunctionValue));
         }
-        m_Writer.addMember(GEO_RESULTS, geoResults, *docPtr);
+        m_DocumentWriter.onObjectEnd();
     }
 }
 
-void CJsonOutputWriter::addInfluences(const CHierarchicalResultsWriter::TOptionalStrOptionalStrPrDoublePrVec& influenceResults,
-                                      TDocumentWeakPtr weakDoc) {
+void CJsonOutputWriter::addInfluences(const CHierarchicalResultsWriter::TOptionalStrOptionalStrPrDoublePrVec& influenceResults) {
     if (influenceResults.empty()) {
         return;
     }
 
-    TDocumentPtr docPtr = weakDoc.lock();
-    if (!docPtr) {
-        LOG_ERROR(<< "Inconsistent program state. JSON document unavailable.");
-        return;
-    }
-
     //! This function takes the raw c_str pointers of the string objects in
     //! influenceResults. These strings must exist up to the time the results
     //! are written
 
     using TCharPtrDoublePr = std::pair<const char*, double>;
     using TCharPtrDoublePrVec = std::vector<TCharPtrDoublePr>;
-    using TCharPtrDoublePrVecIter = TCharPtrDoublePrVec::iterator;
     using TCharPtrCharPtrDoublePrVecPr = std::pair<const char*, TCharPtrDoublePrVec>;
     using TStrCharPtrCharPtrDoublePrVecPrUMap =
         boost::unordered_map<std::string, TCharPtrCharPtrDoublePrVecPr>;
@@ -730,94 +743,74 @@ void CJsonOutputWriter::addInfluences(const CHierarchicalResultsWriter::TOptiona
         std::sort(iter->second.second.begin(), iter->second.second.end(), INFLUENCE_LESS);
     }
 
-    json::value influencesDoc = m_Writer.makeArray(influences.size());
-
-    for (TStrCharPtrCharPtrDoublePrVecPrUMapIter iter = influences.begin();
-         iter != influences.end(); ++iter) {
-        json::object influenceDoc;
-
-        json::array values = m_Writer.makeArray(influences.size());
-        for (TCharPtrDoublePrVecIter arrayIter = iter->second.second.begin();
-             arrayIter != iter->second.second.end(); ++arrayIter) {
-            m_Writer.pushBack(arrayIter->first, values);
+    // Note influences are written using the field name "influencers"
+    m_DocumentWriter.onKey(INFLUENCERS);
+    m_DocumentWriter.onArrayBegin();
+    for (const auto& influence : influences) {
+        m_DocumentWriter.onObjectBegin();
+        m_DocumentWriter.onKey(INFLUENCER_FIELD_NAME);
+        m_DocumentWriter.onString(std::string_view{influence.second.first});
+        m_DocumentWriter.onKey(INFLUENCER_FIELD_VALUES);
+        m_DocumentWriter.onArrayBegin();
+        for (const auto& value : influence.second.second) {
+            m_DocumentWriter.onString(std::string_view{value.first});
         }
-        m_Writer.addMember(INFLUENCER_FIELD_NAME, json::value(iter->second.first), influenceDoc);
-        m_Writer.addMember(INFLUENCER_FIELD_VALUES, values, influenceDoc);
-        m_Writer.pushBack(influenceDoc, influencesDoc);
+        m_DocumentWriter.onArrayEnd();
+        m_DocumentWriter.onObjectEnd();
     }
-
-    // Note influences are written using the field name "influencers"
-    m_Writer.addMember(INFLUENCERS, influencesDoc, *docPtr);
+    m_DocumentWriter.onArrayEnd();
 }
 
-void CJsonOutputWriter::addEventRateFields(const CHierarchicalResultsWriter::TResults& results,
-                                           TDocumentWeakPtr weakDoc) {
-    TDocumentPtr docPtr = weakDoc.lock();
-    if (!docPtr) {
-        LOG_ERROR(<< "Inconsistent program state. JSON document unavailable.");
-        return;
-    }
-
+void CJsonOutputWriter::addEventRateFields(const CHierarchicalResultsWriter::TResults& results) {
     // record_score, probability, fieldName, byFieldName, byFieldValue, partitionFieldName,
     // partitionFieldValue, functionName, typical, actual, influences?
 
-    m_Writer.addDoubleFieldToObj(INITIAL_RECORD_SCORE,
-                                 results.s_NormalizedAnomalyScore, *docPtr);
-    m_Writer.addDoubleFieldToObj(RECORD_SCORE, results.s_NormalizedAnomalyScore, *docPtr);
-    m_Writer.addDoubleFieldToObj(PROBABILITY, results.s_Probability, *docPtr);
+    writeDoubleField(m_DocumentWriter, INITIAL_RECORD_SCORE, results.s_NormalizedAnomalyScore);
+    writeDoubleField(m_DocumentWriter, RECORD_SCORE, results.s_NormalizedAnomalyScore);
+    writeDoubleField(m_DocumentWriter, PROBABILITY, results.s_Probability);
 
-    json::object anomalyScoreExplanation = m_Writer.makeObject();
-    this->writeAnomalyScoreExplanationObject(results, anomalyScoreExplanation);
-    m_Writer.addMember(ANOMALY_SCORE_EXPLANATION, anomalyScoreExplanation, *docPtr);
+    m_DocumentWriter.onKey(ANOMALY_SCORE_EXPLANATION);
+    this->writeAnomalyScoreExplanationObject(results);
 
-    m_Writer.addDoubleFieldToObj(MULTI_BUCKET_IMPACT, results.s_MultiBucketImpact, *docPtr);
-    m_Writer.addStringFieldCopyToObj(FIELD_NAME, results.s_MetricValueField, *docPtr);
+    writeDoubleField(m_DocumentWriter, MULTI_BUCKET_IMPACT, results.s_MultiBucketImpact);
+    writeStringField(m_DocumentWriter, FIELD_NAME, results.s_MetricValueField);
     if (!results.s_ByFieldName.empty()) {
-        m_Writer.addStringFieldCopyToObj(BY_FIELD_NAME, results.s_ByFieldName, *docPtr);
+        writeStringField(m_DocumentWriter, BY_FIELD_NAME, results.s_ByFieldName);
         // If name is present then force output of value too, even when empty
-        m_Writer.addStringFieldCopyToObj(BY_FIELD_VALUE, results.s_ByFieldValue,
-                                         *docPtr, true);
+        writeStringField(m_DocumentWriter, BY_FIELD_VALUE, results.s_ByFieldValue, true);
         // But allow correlatedByFieldValue to be unset if blank
-        m_Writer.addStringFieldCopyToObj(CORRELATED_BY_FIELD_VALUE,
-                                         results.s_CorrelatedByFieldValue, *docPtr);
+        writeStringField(m_DocumentWriter, CORRELATED_BY_FIELD_VALUE,
+                         results.s_CorrelatedByFieldValue);
     }
     if (!results.s_PartitionFieldName.empty()) {
-        m_Writer.addStringFieldCopyToObj(PARTITION_FIELD_NAME,
-                                         results.s_PartitionFieldName, *docPtr);
+        writeStringField(m_DocumentWriter, PARTITION_FIELD_NAME, results.s_PartitionFieldName);
         // If name is present then force output of value too, even when empty
-        m_Writer.addStringFieldCopyToObj(
-            PARTITION_FIELD_VALUE, results.s_PartitionFieldValue, *docPtr, true);
+        writeStringField(m_DocumentWriter, PARTITION_FIELD_VALUE,
+                         results.s_PartitionFieldValue, true);
     }
-    m_Writer.addStringFieldCopyToObj(FUNCTION, results.s_FunctionName, *docPtr);
-    m_Writer.addStringFieldCopyToObj(FUNCTION_DESCRIPTION,
-                                     results.s_FunctionDescription, *docPtr);
-    m_Writer.addDoubleArrayFieldToObj(TYPICAL, results.s_BaselineMean, *docPtr);
-    m_Writer.addDoubleArrayFieldToObj(ACTUAL, results.s_CurrentMean, *docPtr);
+    writeStringField(m_DocumentWriter, FUNCTION, results.s_FunctionName);
+    writeStringField(m_DocumentWriter, FUNCTION_DESCRIPTION, results.s_FunctionDescription);
+    writeDoubleArrayField(m_DocumentWriter, TYPICAL, results.s_BaselineMean);
+    writeDoubleArrayField(m_DocumentWriter, ACTUAL, results.s_CurrentMean);
 }
 
 void CJsonOutputWriter::addInfluencerFields(bool isBucketInfluencer,
-                                            const model::CHierarchicalResults::TNode& node,
-                                            TDocumentWeakPtr weakDoc) {
-    TDocumentPtr docPtr = weakDoc.lock();
-    if (!docPtr) {
-        LOG_ERROR(<< "Inconsistent program state. JSON document unavailable.");
-        return;
-    }
-
-    m_Writer.addDoubleFieldToObj(PROBABILITY, node.probability(), *docPtr);
-    m_Writer.addDoubleFieldToObj(isBucketInfluencer ? INITIAL_SCORE : INITIAL_INFLUENCER_SCORE,
-                                 node.s_NormalizedAnomalyScore, *docPtr);
-    m_Writer.addDoubleFieldToObj(isBucketInfluencer ? ANOMALY_SCORE : INFLUENCER_SCORE,
-                                 node.s_NormalizedAnomalyScore, *docPtr);
+                                            const model::CHierarchicalResults::TNode& node) {
+    writeDoubleField(m_DocumentWriter, PROBABILITY, node.probability());
+    writeDoubleField(m_DocumentWriter,
+                     isBucketInfluencer ? INITIAL_SCORE : INITIAL_INFLUENCER_SCORE,
+                     node.s_NormalizedAnomalyScore);
+    writeDoubleField(m_DocumentWriter, isBucketInfluencer ? ANOMALY_SCORE : INFLUENCER_SCORE,
+                     node.s_NormalizedAnomalyScore);
     const std::string& personFieldName = *node.s_Spec.s_PersonFieldName;
-    m_Writer.addStringFieldCopyToObj(INFLUENCER_FIELD_NAME, personFieldName, *docPtr);
+    writeStringField(m_DocumentWriter, INFLUENCER_FIELD_NAME, personFieldName);
     if (isBucketInfluencer) {
-        m_Writer.addDoubleFieldToObj(RAW_ANOMALY_SCORE, node.s_RawAnomalyScore, *docPtr);
+        writeDoubleField(m_DocumentWriter, RAW_ANOMALY_SCORE, node.s_RawAnomalyScore);
     } else {
         if (!personFieldName.empty()) {
             // If name is present then force output of value too, even when empty
-            m_Writer.addStringFieldCopyToObj(
-                INFLUENCER_FIELD_VALUE, *node.s_Spec.s_PersonFieldValue, *docPtr, true);
+            writeStringField(m_DocumentWriter, INFLUENCER_FIELD_VALUE,
+                             *node.s_Spec.s_PersonFieldValue, true);
         }
     }
 }
@@ -957,74 +950,62 @@ CJsonOutputWriter::SBucketData::SBucketData()
 }
 
 void CJsonOutputWriter::writeAnomalyScoreExplanationObject(
-    const CHierarchicalResultsWriter::TResults& results,
-    json::object& anomalyScoreExplanation) {
+    const CHierarchicalResultsWriter::TResults& results) {
+    m_DocumentWriter.onObjectBegin();
     switch (results.s_AnomalyScoreExplanation.s_AnomalyType) {
     case TAnomalyScoreExplanation::E_DIP:
-        m_Writer.addStringFieldCopyToObj(ANOMALY_TYPE, ANOMALY_TYPE_DIP, anomalyScoreExplanation);
+        writeStringField(m_DocumentWriter, ANOMALY_TYPE, ANOMALY_TYPE_DIP);
         break;
     case TAnomalyScoreExplanation::E_SPIKE:
-        m_Writer.addStringFieldCopyToObj(ANOMALY_TYPE, ANOMALY_TYPE_SPIKE,
-                                         anomalyScoreExplanation);
+        writeStringField(m_DocumentWriter, ANOMALY_TYPE, ANOMALY_TYPE_SPIKE);
         break;
     case TAnomalyScoreExplanation::E_UNKNOWN:
         break;
     }
     if (results.s_AnomalyScoreExplanation.s_AnomalyLength > 0) {
-        m_Writer.addUIntFieldToObj(ANOMALY_LENGTH,
-                                   results.s_AnomalyScoreExplanation.s_AnomalyLength,
-                                   anomalyScoreExplanation);
+        m_DocumentWriter.onKey(ANOMALY_LENGTH);
+        m_DocumentWriter.onUint64(results.s_AnomalyScoreExplanation.s_AnomalyLength);
     }
     if (results.s_AnomalyScoreExplanation.s_SingleBucketImpact != 0) {
-        m_Writer.addIntFieldToObj(SINGLE_BUCKET_IMPACT,
-                                  results.s_AnomalyScoreExplanation.s_SingleBucketImpact,
-                                  anomalyScoreExplanation);
+        m_DocumentWriter.onKey(SINGLE_BUCKET_IMPACT);
+        m_DocumentWriter.onInt64(results.s_AnomalyScoreExplanation.s_SingleBucketImpact);
     }
     if (results.s_AnomalyScoreExplanation.s_MultiBucketImpact != 0) {
-        m_Writer.addIntFieldToObj(MULTI_BUCKET_IMPACT,
-                                  results.s_AnomalyScoreExplanation.s_MultiBucketImpact,
-                                  anomalyScoreExplanation);
+        m_DocumentWriter.onKey(MULTI_BUCKET_IMPACT);
+        m_DocumentWriter.onInt64(results.s_AnomalyScoreExplanation.s_MultiBucketImpact);
     }
     if (results.s_AnomalyScoreExplanation.s_AnomalyCharacteristicsImpact != 0) {
-        m_Writer.addIntFieldToObj(ANOMALY_CHARACTERISTICS_IMPACT,
-                                  results.s_AnomalyScoreExplanation.s_AnomalyCharacteristicsImpact,
-                                  anomalyScoreExplanation);
+        m_DocumentWriter.onKey(ANOMALY_CHARACTERISTICS_IMPACT);
+        m_DocumentWriter.onInt64(results.s_AnomalyScoreExplanation.s_AnomalyCharacteristicsImpact);
     }
     if (std::isnan(results.s_AnomalyScoreExplanation.s_LowerConfidenceBound) == false) {
-        m_Writer.addDoubleFieldToObj(LOWER_CONFIDENCE_BOUND,
-                                     results.s_AnomalyScoreExplanation.s_LowerConfidenceBound,
-                                     anomalyScoreExplanation);
+        writeDoubleField(m_DocumentWriter, LOWER_CONFIDENCE_BOUND,
+                         results.s_AnomalyScoreExplanation.s_LowerConfidenceBound);
     }
     if (std::isnan(results.s_AnomalyScoreExplanation.s_TypicalValue) == false) {
-        m_Writer.addDoubleFieldToObj(TYPICAL_VALUE,
-                                     results.s_AnomalyScoreExplanation.s_TypicalValue,
-                                     anomalyScoreExplanation);
+        writeDoubleField(m_DocumentWriter, TYPICAL_VALUE,
+                         results.s_AnomalyScoreExplanation.s_TypicalValue);
     }
     if (std::isnan(results.s_AnomalyScoreExplanation.s_UpperConfidenceBound) == false) {
-        m_Writer.addDoubleFieldToObj(UPPER_CONFIDENCE_BOUND,
-                                     results.s_AnomalyScoreExplanation.s_UpperConfidenceBound,
-                                     anomalyScoreExplanation);
+        writeDoubleField(m_DocumentWriter, UPPER_CONFIDENCE_BOUND,
+                         results.s_AnomalyScoreExplanation.s_UpperConfidenceBound);
     }
     if (results.s_AnomalyScoreExplanation.s_HighVariancePenalty) {
-        m_Writer.addBoolFieldToObj(HIGH_VARIANCE_PENALTY,
-                                   results.s_AnomalyScoreExplanation.s_HighVariancePenalty,
-                                   anomalyScoreExplanation);
+        m_DocumentWriter.onKey(HIGH_VARIANCE_PENALTY);
+        m_DocumentWriter.onBool(results.s_AnomalyScoreExplanation.s_HighVariancePenalty);
     }
     if (results.s_AnomalyScoreExplanation.s_IncompleteBucketPenalty) {
-        m_Writer.addBoolFieldToObj(INCOMPLETE_BUCKET_PENALTY,
-                                   results.s_AnomalyScoreExplanation.s_IncompleteBucketPenalty,
-                                   anomalyScoreExplanation);
+        m_DocumentWriter.onKey(INCOMPLETE_BUCKET_PENALTY);
+        m_DocumentWriter.onBool(results.s_AnomalyScoreExplanation.s_IncompleteBucketPenalty);
     }
     if (results.s_AnomalyScoreExplanation.s_MultimodalDistribution) {
-        m_Writer.addBoolFieldToObj(MULTIMODAL_DISTRIBUTION,
-                                   results.s_AnomalyScoreExplanation.s_MultimodalDistribution,
-                                   anomalyScoreExplanation);
+        m_DocumentWriter.onKey(MULTIMODAL_DISTRIBUTION);
+        m_DocumentWriter.onBool(results.s_AnomalyScoreExplanation.s_MultimodalDistribution);
     }
 
     if (results.s_AnomalyScoreExplanation.s_ByFieldFirstOccurrence) {
-        m_Writer.addBoolFieldToObj(BY_FIELD_FIRST_OCCURRENCE,
-                                   results.s_AnomalyScoreExplanation.s_ByFieldFirstOccurrence,
-                                   anomalyScoreExplanation);
+        m_DocumentWriter.onKey(BY_FIELD_FIRST_OCCURRENCE);
+        m_DocumentWriter.onBool(results.s_AnomalyScoreExplanation.s_ByFieldFirstOccurrence);
     }
 
     if (results.s_AnomalyScoreExplanation.s_ByFieldActualConcentration > 0.0 &&
@@ -1032,9 +1013,9 @@ void CJsonOutputWriter::writeAnomalyScoreExplanationObject(
         double byFieldRelativeRarity{
             results.s_AnomalyScoreExplanation.s_ByFieldTypicalConcentration /
             results.s_AnomalyScoreExplanation.s_ByFieldActualConcentration};
-        m_Writer.addDoubleFieldToObj(BY_FIELD_RELATIVE_RARITY, byFieldRelativeRarity,
-                                     anomalyScoreExplanation);
+        writeDoubleField(m_DocumentWriter, BY_FIELD_RELATIVE_RARITY, byFieldRelativeRarity);
     }
+    m_DocumentWriter.onObjectEnd();
 }
 }
 }
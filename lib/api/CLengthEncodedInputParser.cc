@@ -12,10 +12,14 @@
 
 #include <core/CLogger.h>
 #include <core/CSetMode.h>
+#include <core/Concurrency.h>
 
 #include <algorithm>
 #include <cstring>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <type_traits>
 
@@ -28,6 +32,47 @@
 
 namespace ml {
 namespace api {
+namespace {
+
+// If the stream gets corrupted then we may end up parsing string data
+// into a length.  If this happens it's highly likely that the high byte
+// of the length will be non-zero, as zero bytes are unlikely to occur in
+// strings.  Also, a length where the high byte is non-zero implies a field
+// of 16MB or more, which is unlikely, so assume corruption in this case.
+// See bug 1040 in Bugzilla for more details.
+const std::uint32_t HIGH_BYTE_MASK{0xFF000000};
+
+//! \brief A chunk of whole records and their field values.
+struct SChunk {
+    std::string s_Records;
+    CLengthEncodedInputParser::TStrVec s_Values;
+};
+using TChunkPtr = std::shared_ptr<SChunk>;
+using TChunkPtrFutureDeque = std::deque<std::future<TChunkPtr>>;
+
+//! Read a 32 bit integer in network byte order.
+std::uint32_t readUInt32(const char* ptr) {
+    std::uint32_t netNum{0};
+    std::memcpy(&netNum, ptr, sizeof(std::uint32_t));
+    return ntohl(netNum);
+}
+
+//! Extract the field values of the records in \p chunk, which have been
+//! checked by findRecordsEnd.
+void parseChunk(SChunk& chunk, std::size_t numFields) {
+    const char* ptr{chunk.s_Records.data()};
+    const char* end{ptr + chunk.s_Records.size()};
+    while (ptr < end) {
+        ptr += sizeof(std::uint32_t);
+        for (std::size_t i = 0; i < numFields; ++i) {
+            std::uint32_t length{readUInt32(ptr)};
+            ptr += sizeof(std::uint32_t);
+            chunk.s_Values.emplace_back(ptr, length);
+            ptr += length;
+        }
+    }
+}
+}
 
 // Initialise statics
 
@@ -58,6 +103,10 @@ CLengthEncodedInputParser::CLengthEncodedInputParser(TStrVec mutableFieldNames,
     }
 }
 
+void CLengthEncodedInputParser::parseInParallel(std::size_t chunkSize) {
+    m_ParallelChunkSize = std::max(chunkSize, WORK_BUFFER_SIZE);
+}
+
 bool CLengthEncodedInputParser::readStreamIntoMaps(const TMapReaderFunc& readerFunc,
                                                    const TRegisterMutableFieldFunc& registerFunc) {
 
@@ -133,6 +182,10 @@ bool CLengthEncodedInputParser::readFieldNames() {
 template<typename READER_FUNC>
 bool CLengthEncodedInputParser::parseRecordLoop(const READER_FUNC& readerFunc,
                                                 TStrRefVec& workSpace) {
+    if (m_ParallelChunkSize > 0 && core::defaultAsyncThreadPoolSize() > 1) {
+        return this->parallelParseRecordLoop(readerFunc, workSpace);
+    }
+
     while (m_NoMoreRecords == false) {
         if (this->parseRecordFromStream<false>(workSpace) == false) {
             LOG_ERROR(<< "Failed to parse length encoded data record from stream");
@@ -152,6 +205,134 @@ bool CLengthEncodedInputParser::parseRecordLoop(const READER_FUNC& readerFunc,
     return true;
 }
 
+template<typename READER_FUNC>
+bool CLengthEncodedInputParser::parallelParseRecordLoop(const READER_FUNC& readerFunc,
+                                                        TStrRefVec& workSpace) {
+    std::size_t numFields{workSpace.size()};
+    std::size_t maxPendingChunks{2 * core::defaultAsyncThreadPoolSize()};
+
+    // Start with whatever followed the field names in the working buffer.
+    std::string buffer{m_WorkBufferPtr, m_WorkBufferEnd};
+    m_WorkBufferPtr = m_WorkBufferEnd;
+    std::size_t recordsEnd{0};
+    TChunkPtrFutureDeque pendingChunks;
+
+    auto dispatch = [&] {
+        if (recordsEnd > 0) {
+            auto chunk = std::make_shared<SChunk>();
+            chunk->s_Records.assign(buffer, 0, recordsEnd);
+            buffer.erase(0, recordsEnd);
+            recordsEnd = 0;
+            pendingChunks.push_back(core::async(core::defaultAsyncExecutor(), [chunk, numFields] {
+                parseChunk(*chunk, numFields);
+                return chunk;
+            }));
+        }
+    };
+    auto deliver = [&](std::size_t maxPending) {
+        while (pendingChunks.size() > maxPending) {
+            TChunkPtr chunk{pendingChunks.front().get()};
+            pendingChunks.pop_front();
+            TStrVec& values{chunk->s_Values};
+            for (std::size_t i = 0; i < values.size(); i += numFields) {
+                for (std::size_t j = 0; j < numFields; ++j) {
+                    workSpace[j].get().swap(values[i + j]);
+                }
+                if (readerFunc() == false) {
+                    LOG_ERROR(<< "Record handler function forced exit");
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    for (bool endOfStream = m_StrmIn.eof(); /**/; /**/) {
+        if (findRecordsEnd(buffer, numFields, recordsEnd) == false) {
+            dispatch();
+            if (deliver(0)) {
+                LOG_ERROR(<< "Failed to parse length encoded data record from stream");
+            }
+            return false;
+        }
+
+        // Only read from the stream in a way which might block once every
+        // record we've read has been passed on, as the sender may be waiting
+        // for a response to one of them.
+        std::streamsize available{endOfStream ? 0 : m_StrmIn.rdbuf()->in_avail()};
+        bool mightBlock{available <= 0};
+        if (recordsEnd >= m_ParallelChunkSize || mightBlock) {
+            dispatch();
+        }
+        if (deliver(mightBlock ? 0 : maxPendingChunks) == false) {
+            return false;
+        }
+        if (endOfStream) {
+            break;
+        }
+
+        std::size_t readSize{mightBlock ? WORK_BUFFER_SIZE
+                                        : std::min(static_cast<std::size_t>(available),
+                                                   m_ParallelChunkSize)};
+        std::size_t size{buffer.size()};
+        buffer.resize(size + readSize);
+        m_StrmIn.read(&buffer[size], static_cast<std::streamsize>(readSize));
+        if (m_StrmIn.bad()) {
+            LOG_ERROR(<< "Input stream is bad");
+        }
+        buffer.resize(size + static_cast<std::size_t>(m_StrmIn.gcount()));
+        endOfStream = m_StrmIn.good() == false;
+    }
+
+    // As for serial parsing, fewer bytes than a field count at the end of
+    // the stream are ignored.
+    if (buffer.size() >= sizeof(std::uint32_t)) {
+        LOG_ERROR(<< "Unable to read field data from input stream");
+        LOG_ERROR(<< "Failed to parse length encoded data record from stream");
+        return false;
+    }
+    m_NoMoreRecords = true;
+
+    return true;
+}
+
+bool CLengthEncodedInputParser::findRecordsEnd(const std::string& buffer,
+                                               std::size_t numFields,
+                                               std::size_t& recordsEnd) {
+    const char* data{buffer.data()};
+    std::size_t size{buffer.size()};
+    for (;;) {
+        std::size_t pos{recordsEnd};
+        if (size - pos < sizeof(std::uint32_t)) {
+            return true;
+        }
+        std::uint32_t numRecordFields{readUInt32(data + pos)};
+        pos += sizeof(std::uint32_t);
+        if (numRecordFields != numFields) {
+            LOG_ERROR(<< "Incorrect number of fields in input stream record: expected "
+                      << numFields << " but got " << numRecordFields);
+            return false;
+        }
+        for (std::size_t i = 0; i < numFields; ++i) {
+            if (size - pos < sizeof(std::uint32_t)) {
+                return true;
+            }
+            std::uint32_t length{readUInt32(data + pos)};
+            pos += sizeof(std::uint32_t);
+            if ((length & HIGH_BYTE_MASK) != 0u) {
+                LOG_ERROR(<< "Parsed field length " << length
+                          << " is suspiciously large - assuming corrupt input stream");
+                return false;
+            }
+            if (size - pos < length) {
+                return true;
+            }
+            pos += length;
+        }
+        recordsEnd = pos;
+    }
+}
+
 template<bool RESIZE_ALLOWED, typename STR_VEC>
 bool CLengthEncodedInputParser::parseRecordFromStream(STR_VEC& values) {
     // For maximum performance, read the stream in large chunks that can be
@@ -210,14 +391,7 @@ bool CLengthEncodedInputParser::parseRecordFromStream(STR_VEC& values) {
             return false;
         }
 
-        // If the stream gets corrupted then we may end up parsing string data
-        // into the length variable.  If this happens it's highly likely that
-        // the high byte of the length variable will be non-zero, as zero bytes
-        // are unlikely to occur in strings.  Also, a length where the high byte
-        // of the length variable is non-zero implies a field of 16MB or more,
-        // which is unlikely, so assume corruption in this case.  See bug 1040
-        // in Bugzilla for more details.
-        static const std::uint32_t HIGH_BYTE_MASK{0xFF000000};
+        // See HIGH_BYTE_MASK for why we check this.
         if ((length & HIGH_BYTE_MASK) != 0u) {
             LOG_ERROR(<< "Parsed field length " << length
                       << " is suspiciously large - assuming corrupt input stream");
@@ -233,6 +407,36 @@ bool CLengthEncodedInputParser::parseRecordFromStream(STR_VEC& values) {
     return true;
 }
 
+bool CLengthEncodedInputParser::isNextRecordBuffered() const {
+    if (m_WorkBufferPtr == nullptr) {
+        return false;
+    }
+
+    const char* ptr{m_WorkBufferPtr};
+    auto parseUInt32 = [&](std::uint32_t& num) {
+        if (m_WorkBufferEnd - ptr < static_cast<std::ptrdiff_t>(sizeof(std::uint32_t))) {
+            return false;
+        }
+        num = readUInt32(ptr);
+        ptr += sizeof(std::uint32_t);
+        return true;
+    };
+
+    std::uint32_t numFields{0};
+    if (parseUInt32(numFields) == false) {
+        return false;
+    }
+    for (std::uint32_t index = 0; index < numFields; ++index) {
+        std::uint32_t length{0};
+        if (parseUInt32(length) == false ||
+            m_WorkBufferEnd - ptr < static_cast<std::ptrdiff_t>(length)) {
+            return false;
+        }
+        ptr += length;
+    }
+    return true;
+}
+
 bool CLengthEncodedInputParser::parseUInt32FromStream(std::uint32_t& num) {
     std::ptrdiff_t avail{m_WorkBufferEnd - m_WorkBufferPtr};
     if (avail < static_cast<std::ptrdiff_t>(sizeof(std::uint32_t))) {
@@ -242,13 +446,10 @@ bool CLengthEncodedInputParser::parseUInt32FromStream(std::uint32_t& num) {
         }
     }
 
-    std::uint32_t netNum{0};
-    std::memcpy(&netNum, m_WorkBufferPtr, sizeof(std::uint32_t));
-    m_WorkBufferPtr += sizeof(std::uint32_t);
-
     // Integers are encoded in network byte order, so convert to host byte order
     // before interpreting
-    num = ntohl(netNum);
+    num = readUInt32(m_WorkBufferPtr);
+    m_WorkBufferPtr += sizeof(std::uint32_t);
 
     return true;
 }
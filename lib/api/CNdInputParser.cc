@@ -95,5 +95,10 @@ CNdInputParser::TCharPSizePr CNdInputParser::parseLine() {
 void CNdInputParser::resetBuffer() {
     m_WorkBufferEnd = m_WorkBufferPtr;
 }
+
+bool CNdInputParser::isNextRecordBuffered() const {
+    std::size_t avail(m_WorkBufferEnd - m_WorkBufferPtr);
+    return avail > 0 && std::memchr(m_WorkBufferPtr, LINE_END, avail) != nullptr;
+}
 }
 }
@@ -10,19 +10,26 @@
  */
 #include <api/CNdJsonInputParser.h>
 
-#include <core/CBoostJsonParser.h>
 #include <core/CLogger.h>
-#include <core/CStringUtils.h>
+
+// The implementation of basic_parser is only included here since this is the
+// only place we use this specialisation. See the Boost.JSON documentation on
+// using basic_parser to implement a parser.
+#include <boost/json/basic_parser_impl.hpp>
+
+#include <charconv>
 
 namespace ml {
 namespace api {
 
 CNdJsonInputParser::CNdJsonInputParser(std::istream& strmIn, bool allDocsSameStructure)
-    : CNdInputParser{TStrVec{}, strmIn}, m_AllDocsSameStructure{allDocsSameStructure} {
+    : CNdInputParser{TStrVec{}, strmIn}, m_AllDocsSameStructure{allDocsSameStructure},
+      m_Parser{json::parse_options{}} {
 }
 
 CNdJsonInputParser::CNdJsonInputParser(TStrVec mutableFieldNames, std::istream& strmIn, bool allDocsSameStructure)
-    : CNdInputParser{std::move(mutableFieldNames), strmIn}, m_AllDocsSameStructure{allDocsSameStructure} {
+    : CNdInputParser{std::move(mutableFieldNames), strmIn}, m_AllDocsSameStructure{allDocsSameStructure},
+      m_Parser{json::parse_options{}} {
 }
 
 bool CNdJsonInputParser::readStreamIntoMaps(const TMapReaderFunc& readerFunc,
@@ -40,23 +47,29 @@ bool CNdJsonInputParser::readStreamIntoMaps(const TMapReaderFunc& readerFunc,
     std::size_t length;
     std::tie(begin, length) = this->parseLine();
     while (begin != nullptr && length > 0) {
-        json::value document;
-        if (this->parseDocument(begin, length, document) == false) {
-            LOG_ERROR(<< "Failed to parse JSON document");
+        bool decodeAllFields{m_AllDocsSameStructure == false || fieldValRefs.empty()};
+        if (decodeAllFields) {
+            // The major drawback of having self-describing messages is that we can't
+            // make assumptions about what fields exist or what order they're in
+            this->startArbitraryDocument(fieldNames, recordFields);
+        } else {
+            this->startCommonDocument(fieldValRefs);
+        }
+
+        if (this->parseDocument(begin, length) == false) {
+            LOG_ERROR(<< "Failed to decode JSON document");
             return false;
         }
 
-        if (m_AllDocsSameStructure) {
-            if (this->decodeDocumentWithCommonFields(registerFunc, document, fieldNames,
-                                                     fieldValRefs, recordFields) == false) {
-                LOG_ERROR(<< "Failed to decode JSON document");
-                return false;
-            }
-        } else {
-            if (this->decodeDocumentWithArbitraryFields(
-                    registerFunc, document, fieldNames, recordFields) == false) {
-                LOG_ERROR(<< "Failed to decode JSON document");
-                return false;
+        if (decodeAllFields) {
+            this->registerMutableFields(registerFunc, recordFields);
+            if (m_AllDocsSameStructure) {
+                // Cache references to the strings in the map corresponding to
+                // each field name for next time
+                fieldValRefs.reserve(fieldNames.size());
+                for (const auto& fieldName : fieldNames) {
+                    fieldValRefs.emplace_back(recordFields[fieldName]);
+                }
             }
         }
 
@@ -85,24 +98,20 @@ bool CNdJsonInputParser::readStreamIntoVecs(const TVecReaderFunc& readerFunc,
     std::size_t length;
     std::tie(begin, length) = this->parseLine();
     while (begin != nullptr && length > 0) {
-        json::value document;
-        if (this->parseDocument(begin, length, document) == false) {
-            LOG_ERROR(<< "Failed to parse JSON document");
+        bool decodeAllFields{m_AllDocsSameStructure == false || fieldValues.empty()};
+        if (decodeAllFields) {
+            this->startArbitraryDocument(fieldNames, fieldValues);
+        } else {
+            this->startCommonDocument(fieldValues);
+        }
+
+        if (this->parseDocument(begin, length) == false) {
+            LOG_ERROR(<< "Failed to decode JSON document");
             return false;
         }
 
-        if (m_AllDocsSameStructure) {
-            if (this->decodeDocumentWithCommonFields(
-                    registerFunc, document, fieldNames, fieldValues) == false) {
-                LOG_ERROR(<< "Failed to decode JSON document");
-                return false;
-            }
-        } else {
-            if (this->decodeDocumentWithArbitraryFields(
-                    registerFunc, document, fieldNames, fieldValues) == false) {
-                LOG_ERROR(<< "Failed to decode JSON document");
-                return false;
-            }
+        if (decodeAllFields) {
+            this->registerMutableFields(registerFunc, fieldNames, fieldValues);
         }
 
         if (readerFunc(fieldNames, fieldValues) == false) {
@@ -116,146 +125,326 @@ bool CNdJsonInputParser::readStreamIntoVecs(const TVecReaderFunc& readerFunc,
     return true;
 }
 
-bool CNdJsonInputParser::parseDocument(char* begin, std::size_t length, json::value& document) {
-    // Parse JSON string
-    json::error_code ec = core::CBoostJsonParser::parse(begin, length, document);
+bool CNdJsonInputParser::parseDocument(const char* begin, std::size_t length) {
+    SRecordHandler& handler{m_Parser.handler()};
+    json::error_code ec;
+    m_Parser.reset();
+    std::size_t parsed{m_Parser.write_some(false, begin, length, ec)};
     if (ec) {
-        LOG_ERROR(<< "JSON parse error: " << ec.message());
+        if (handler.s_Error != nullptr) {
+            LOG_ERROR(<< handler.s_Error);
+        } else {
+            LOG_ERROR(<< "JSON parse error: " << ec.message());
+        }
         return false;
     }
-
-    if (document.is_object() == false) {
-        LOG_ERROR(<< "Top level of JSON document must be an object: "
-                  << document.kind());
+    if (parsed < length) {
+        LOG_ERROR(<< "JSON parse error: unexpected characters after document: "
+                  << std::string_view(begin + parsed, length - parsed));
         return false;
     }
+    return true;
+}
+
+void CNdJsonInputParser::startArbitraryDocument(TStrVec& fieldNames, TStrStrUMap& recordFields) {
+    fieldNames.clear();
+    recordFields.clear();
+    SRecordHandler& handler{m_Parser.handler()};
+    handler.s_Mode = SRecordHandler::E_ArbitraryMap;
+    handler.s_FieldNames = &fieldNames;
+    handler.s_RecordFields = &recordFields;
+}
+
+void CNdJsonInputParser::startArbitraryDocument(TStrVec& fieldNames, TStrVec& fieldValues) {
+    fieldNames.clear();
+    fieldValues.clear();
+    SRecordHandler& handler{m_Parser.handler()};
+    handler.s_Mode = SRecordHandler::E_ArbitraryVecs;
+    handler.s_FieldNames = &fieldNames;
+    handler.s_FieldValues = &fieldValues;
+}
 
+void CNdJsonInputParser::startCommonDocument(TStrRefVec& fieldValueRefs) {
+    SRecordHandler& handler{m_Parser.handler()};
+    handler.s_Mode = SRecordHandler::E_CommonFields;
+    handler.s_FieldValueRefs = &fieldValueRefs;
+    handler.s_FieldValues = nullptr;
+}
+
+void CNdJsonInputParser::startCommonDocument(TStrVec& fieldValues) {
+    SRecordHandler& handler{m_Parser.handler()};
+    handler.s_Mode = SRecordHandler::E_CommonFields;
+    handler.s_FieldValueRefs = nullptr;
+    handler.s_FieldValues = &fieldValues;
+}
+
+bool CNdJsonInputParser::SRecordHandler::on_document_begin(json::error_code& /*ec*/) {
+    s_NumberFields = 0;
+    s_Value = nullptr;
+    s_Key.clear();
+    s_InString = false;
+    s_Depth = 0;
+    s_IsArray.clear();
+    s_HasElements.clear();
+    s_Error = nullptr;
     return true;
 }
 
-bool CNdJsonInputParser::decodeDocumentWithCommonFields(const TRegisterMutableFieldFunc& registerFunc,
-                                                        const json::value& document,
-                                                        TStrVec& fieldNames,
-                                                        TStrRefVec& fieldValRefs,
-                                                        TStrStrUMap& recordFields) {
-    if (fieldValRefs.empty()) {
-        // We haven't yet decoded any documents, so decode the first one long-hand
-        if (this->decodeDocumentWithArbitraryFields(registerFunc, document, fieldNames,
-                                                    recordFields) == false) {
-            return false;
-        }
+bool CNdJsonInputParser::SRecordHandler::on_document_end(json::error_code& /*ec*/) {
+    return true;
+}
 
-        // Cache references to the strings in the map corresponding to each field
-        // name for next time
-        fieldValRefs.reserve(fieldNames.size());
-        for (const auto& fieldName : fieldNames) {
-            fieldValRefs.emplace_back(recordFields[fieldName]);
-        }
+bool CNdJsonInputParser::SRecordHandler::on_array_begin(json::error_code& ec) {
+    if (this->beginValue(ec) == false) {
+        return false;
+    }
+    s_Value->push_back('[');
+    s_IsArray.push_back(true);
+    s_HasElements.push_back(false);
+    ++s_Depth;
+    return true;
+}
 
+bool CNdJsonInputParser::SRecordHandler::on_array_end(std::size_t /*n*/,
+                                                      json::error_code& /*ec*/) {
+    s_Value->push_back(']');
+    s_IsArray.pop_back();
+    s_HasElements.pop_back();
+    --s_Depth;
+    return true;
+}
+
+bool CNdJsonInputParser::SRecordHandler::on_object_begin(json::error_code& ec) {
+    if (s_Depth == 0) {
+        s_Depth = 1;
         return true;
     }
+    if (this->beginValue(ec) == false) {
+        return false;
+    }
+    s_Value->push_back('{');
+    s_IsArray.push_back(false);
+    s_HasElements.push_back(false);
+    ++s_Depth;
+    return true;
+}
 
-    auto nameIter = fieldNames.begin();
-    auto refIter = fieldValRefs.begin();
-    for (auto iter = document.as_object().begin();
-         iter != document.as_object().end(); ++iter, ++refIter) {
-        if (nameIter == fieldNames.end() || refIter == fieldValRefs.end()) {
-            LOG_ERROR(<< "More fields than field references");
-            return false;
-        }
+bool CNdJsonInputParser::SRecordHandler::on_object_end(std::size_t /*n*/,
+                                                       json::error_code& /*ec*/) {
+    if (--s_Depth > 0) {
+        s_Value->push_back('}');
+        s_IsArray.pop_back();
+        s_HasElements.pop_back();
+    }
+    return true;
+}
 
-        if (this->jsonValueToString(*nameIter, iter->value(), *refIter) == false) {
+bool CNdJsonInputParser::SRecordHandler::on_string_part(std::string_view s,
+                                                        std::size_t /*n*/,
+                                                        json::error_code& ec) {
+    // Only the first part of a string is the start of a value.
+    if (s_InString == false) {
+        if (this->beginValue(ec) == false) {
             return false;
         }
+        s_InString = true;
     }
+    this->appendEscaped(s);
+    return true;
+}
 
+bool CNdJsonInputParser::SRecordHandler::on_string(std::string_view s,
+                                                   std::size_t /*n*/,
+                                                   json::error_code& ec) {
+    if (s_InString == false && this->beginValue(ec) == false) {
+        return false;
+    }
+    s_InString = false;
+    this->appendEscaped(s);
     return true;
 }
 
-bool CNdJsonInputParser::decodeDocumentWithCommonFields(const TRegisterMutableFieldFunc& registerFunc,
-                                                        const json::value& document,
+bool CNdJsonInputParser::SRecordHandler::on_key_part(std::string_view s,
+                                                     std::size_t /*n*/,
+                                                     json::error_code& /*ec*/) {
+    s_Key.append(s);
+    return true;
+}
 
-                                                        TStrVec& fieldNames,
-                                                        TStrVec& fieldValues) {
-    if (fieldValues.empty()) {
-        // We haven't yet decoded any documents, so decode the first one long-hand
-        return this->decodeDocumentWithArbitraryFields(registerFunc, document,
-                                                       fieldNames, fieldValues);
-    }
+bool CNdJsonInputParser::SRecordHandler::on_key(std::string_view s,
+                                                std::size_t /*n*/,
+                                                json::error_code& ec) {
+    s_Key.append(s);
 
-    auto nameIter = fieldNames.begin();
-    auto valueIter = fieldValues.begin();
-    for (auto iter = document.as_object().begin();
-         iter != document.as_object().end(); ++iter, ++nameIter, ++valueIter) {
-        if (nameIter == fieldNames.end() || valueIter == fieldValues.end()) {
-            LOG_ERROR(<< "More fields in document than common fields");
-            return false;
+    if (s_Depth > 1) {
+        // A key of a nested object which is part of the value.
+        if (s_HasElements.back()) {
+            s_Value->push_back(',');
         }
+        s_HasElements.back() = true;
+        this->appendEscaped(s_Key);
+        s_Value->push_back(':');
+        s_Key.clear();
+        return true;
+    }
 
-        if (this->jsonValueToString(*nameIter, iter->value(), *valueIter) == false) {
-            return false;
+    switch (s_Mode) {
+    case E_ArbitraryMap:
+        s_FieldNames->emplace_back(s_Key);
+        s_Value = &(*s_RecordFields)[s_FieldNames->back()];
+        break;
+    case E_ArbitraryVecs:
+        s_FieldNames->emplace_back(s_Key);
+        s_FieldValues->emplace_back();
+        s_Value = &s_FieldValues->back();
+        break;
+    case E_CommonFields:
+        if (s_FieldValueRefs != nullptr) {
+            if (s_NumberFields >= s_FieldValueRefs->size()) {
+                return this->fail("More fields than field references", ec);
+            }
+            s_Value = &(*s_FieldValueRefs)[s_NumberFields].get();
+        } else {
+            if (s_NumberFields >= s_FieldValues->size()) {
+                return this->fail("More fields in document than common fields", ec);
+            }
+            s_Value = &(*s_FieldValues)[s_NumberFields];
         }
+        break;
     }
-
+    s_Value->clear();
+    ++s_NumberFields;
+    s_Key.clear();
     return true;
 }
 
-bool CNdJsonInputParser::decodeDocumentWithArbitraryFields(const TRegisterMutableFieldFunc& registerFunc,
-                                                           const json::value& document,
-                                                           TStrVec& fieldNames,
-                                                           TStrStrUMap& recordFields) {
-    // The major drawback of having self-describing messages is that we can't
-    // make assumptions about what fields exist or what order they're in
-    fieldNames.clear();
-    recordFields.clear();
+bool CNdJsonInputParser::SRecordHandler::on_number_part(std::string_view /*s*/,
+                                                        json::error_code& /*ec*/) {
+    // We write the parsed number to match a serialized value.
+    return true;
+}
 
-    for (auto iter = document.as_object().begin();
-         iter != document.as_object().end(); ++iter) {
-        fieldNames.emplace_back(iter->key());
-        const std::string& fieldName = fieldNames.back();
-        if (this->jsonValueToString(fieldName, iter->value(), recordFields[fieldName]) == false) {
-            return false;
-        }
+bool CNdJsonInputParser::SRecordHandler::on_int64(std::int64_t i,
+                                                  std::string_view /*s*/,
+                                                  json::error_code& ec) {
+    if (this->beginValue(ec) == false) {
+        return false;
     }
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), i);
+    s_Value->append(buffer, result.ptr);
+    return true;
+}
 
-    this->registerMutableFields(registerFunc, recordFields);
+bool CNdJsonInputParser::SRecordHandler::on_uint64(std::uint64_t u,
+                                                   std::string_view /*s*/,
+                                                   json::error_code& ec) {
+    if (this->beginValue(ec) == false) {
+        return false;
+    }
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), u);
+    s_Value->append(buffer, result.ptr);
+    return true;
+}
 
+bool CNdJsonInputParser::SRecordHandler::on_double(double d,
+                                                   std::string_view /*s*/,
+                                                   json::error_code& ec) {
+    if (this->beginValue(ec) == false) {
+        return false;
+    }
+    s_Value->append(json::serialize(json::value(d)));
     return true;
 }
 
-bool CNdJsonInputParser::decodeDocumentWithArbitraryFields(const TRegisterMutableFieldFunc& registerFunc,
-                                                           const json::value& document,
-                                                           TStrVec& fieldNames,
-                                                           TStrVec& fieldValues) {
-    // The major drawback of having self-describing messages is that we can't
-    // make assumptions about what fields exist or what order they're in
-    fieldNames.clear();
-    fieldValues.clear();
+bool CNdJsonInputParser::SRecordHandler::on_bool(bool b, json::error_code& ec) {
+    if (this->beginValue(ec) == false) {
+        return false;
+    }
+    s_Value->append(b ? "true" : "false");
+    return true;
+}
 
-    for (auto iter = document.as_object().begin();
-         iter != document.as_object().end(); ++iter) {
-        fieldNames.emplace_back(iter->key(), iter->key().size());
-        fieldValues.emplace_back();
-        const std::string& fieldName = fieldNames.back();
-        std::string& fieldValue = fieldValues.back();
-        if (this->jsonValueToString(fieldName, iter->value(), fieldValue) == false) {
-            return false;
-        }
+bool CNdJsonInputParser::SRecordHandler::on_null(json::error_code& ec) {
+    if (this->beginValue(ec) == false) {
+        return false;
     }
+    s_Value->append("null");
+    return true;
+}
 
-    this->registerMutableFields(registerFunc, fieldNames, fieldValues);
+bool CNdJsonInputParser::SRecordHandler::on_comment_part(std::string_view /*s*/,
+                                                         json::error_code& /*ec*/) {
+    return true;
+}
 
+bool CNdJsonInputParser::SRecordHandler::on_comment(std::string_view /*s*/,
+                                                    json::error_code& /*ec*/) {
     return true;
 }
 
-bool CNdJsonInputParser::jsonValueToString(const std::string& /*fieldName*/,
-                                           const json::value& jsonValue,
-                                           std::string& fieldValueStr) {
-    fieldValueStr = json::serialize(jsonValue);
-    // serialize surrounds string values with double quotes, strip them off.
-    fieldValueStr.erase(std::remove(fieldValueStr.begin(), fieldValueStr.end(), '\"'),
-                        fieldValueStr.end());
+bool CNdJsonInputParser::SRecordHandler::beginValue(json::error_code& ec) {
+    if (s_Depth == 0) {
+        return this->fail("Top level of JSON document must be an object", ec);
+    }
+    if (s_Depth > 1 && s_IsArray.back()) {
+        if (s_HasElements.back()) {
+            s_Value->push_back(',');
+        }
+        s_HasElements.back() = true;
+    }
     return true;
 }
+
+void CNdJsonInputParser::SRecordHandler::appendEscaped(std::string_view s) {
+    // This matches the escaping of json::serialize except that double quotes
+    // are dropped, so an escaped double quote is left as a backslash.
+    static const char HEX[]{"0123456789abcdef"};
+    std::size_t start{0};
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        auto c = static_cast<unsigned char>(s[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        s_Value->append(s.data() + start, i - start);
+        start = i + 1;
+        s_Value->push_back('\\');
+        switch (c) {
+        case '"':
+            break;
+        case '\\':
+            s_Value->push_back('\\');
+            break;
+        case '\b':
+            s_Value->push_back('b');
+            break;
+        case '\f':
+            s_Value->push_back('f');
+            break;
+        case '\n':
+            s_Value->push_back('n');
+            break;
+        case '\r':
+            s_Value->push_back('r');
+            break;
+        case '\t':
+            s_Value->push_back('t');
+            break;
+        default:
+            s_Value->append("u00");
+            s_Value->push_back(HEX[c >> 4]);
+            s_Value->push_back(HEX[c & 0xF]);
+            break;
+        }
+    }
+    s_Value->append(s.data() + start, s.size() - start);
+}
+
+bool CNdJsonInputParser::SRecordHandler::fail(const char* error, json::error_code& ec) {
+    s_Error = error;
+    ec = json::error::syntax;
+    return false;
+}
 }
 }
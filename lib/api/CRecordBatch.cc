@@ -0,0 +1,78 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+#include <api/CRecordBatch.h>
+
+#include <core/CLogger.h>
+
+namespace ml {
+namespace api {
+
+void CRecordBatch::reset(const TStrVec& fieldNames, const TStrVec& mutableFieldNames) {
+    m_FieldNames = fieldNames;
+    m_MutableFieldNames = mutableFieldNames;
+    m_Columns.resize(m_FieldNames.size());
+    m_Size = 0;
+}
+
+void CRecordBatch::clear() {
+    m_Size = 0;
+}
+
+void CRecordBatch::add(const TStrVec& fieldValues) {
+    if (fieldValues.size() != m_FieldNames.size()) {
+        LOG_ERROR(<< "Inconsistency - record has " << fieldValues.size()
+                  << " values but batch has " << m_FieldNames.size() << " fields");
+        return;
+    }
+    for (std::size_t i = 0; i < fieldValues.size(); ++i) {
+        TStrVec& column{m_Columns[i]};
+        if (m_Size < column.size()) {
+            column[m_Size] = fieldValues[i];
+        } else {
+            column.push_back(fieldValues[i]);
+        }
+    }
+    ++m_Size;
+}
+
+std::size_t CRecordBatch::size() const {
+    return m_Size;
+}
+
+bool CRecordBatch::empty() const {
+    return m_Size == 0;
+}
+
+const CRecordBatch::TStrVec& CRecordBatch::fieldNames() const {
+    return m_FieldNames;
+}
+
+const CRecordBatch::TStrVec& CRecordBatch::mutableFieldNames() const {
+    return m_MutableFieldNames;
+}
+
+CRecordBatch::TOptionalSize CRecordBatch::fieldIndex(const std::string& fieldName) const {
+    for (std::size_t i = m_FieldNames.size(); i > 0; --i) {
+        if (m_FieldNames[i - 1] == fieldName) {
+            return i - 1;
+        }
+    }
+    return std::nullopt;
+}
+
+void CRecordBatch::record(std::size_t record, TStrStrUMap& fields) const {
+    fields.clear();
+    for (std::size_t i = 0; i < m_FieldNames.size(); ++i) {
+        fields[m_FieldNames[i]] = m_Columns[i][record];
+    }
+}
+}
+}
@@ -393,23 +393,26 @@ CRetrainableModelJsonReader::doBestForestFromJsonStream(std::istream& istream,
 
     LOG_TRACE(<< "doc: " << doc);
 
-    auto inferenceModel = ifExists(CInferenceModelDefinition::JSON_TRAINED_MODEL_TAG,
-                                   getAsObjectFrom, doc.as_object());
-    auto ensemble = ifExists(CEnsemble::JSON_ENSEMBLE_TAG, getAsObjectFrom, inferenceModel);
-    auto trainedModels = ifExists(CEnsemble::JSON_TRAINED_MODELS_TAG, getAsArrayFrom, ensemble);
+    const auto& inferenceModel = ifExists(CInferenceModelDefinition::JSON_TRAINED_MODEL_TAG,
+                                          getAsObjectFrom, doc.as_object());
+    const auto& ensemble = ifExists(CEnsemble::JSON_ENSEMBLE_TAG, getAsObjectFrom,
+                                    inferenceModel);
+    const auto& trainedModels =
+        ifExists(CEnsemble::JSON_TRAINED_MODELS_TAG, getAsArrayFrom, ensemble);
     auto forest = std::make_unique<TNodeVecVec>();
     forest->reserve(trainedModels.size());
     TStrVec featureNames;
     TNodeVec nodes;
     for (const auto& trainedModel : trainedModels) {
-        auto tree = ifExists(CTree::JSON_TREE_TAG, getAsObjectFrom,
-                             trainedModel.as_object());
+        const auto& tree = ifExists(CTree::JSON_TREE_TAG, getAsObjectFrom,
+                                    trainedModel.as_object());
         featureNames.clear();
         for (const auto& name :
              ifExists(CTree::JSON_FEATURE_NAMES_TAG, getAsArrayFrom, tree)) {
             featureNames.emplace_back(getAsStringFrom(name));
         }
-        auto treeNodes = ifExists(CTree::JSON_TREE_STRUCTURE_TAG, getAsArrayFrom, tree);
+        const auto& treeNodes =
+            ifExists(CTree::JSON_TREE_STRUCTURE_TAG, getAsArrayFrom, tree);
         nodes.clear();
         nodes.reserve(treeNodes.size());
         nodes.emplace_back(); // Add the root.
@@ -422,7 +425,7 @@ CRetrainableModelJsonReader::doBestForestFromJsonStream(std::istream& istream,
             if (node.as_object().contains(CTree::CTreeNode::JSON_LEAF_VALUE_TAG)) {
                 // Add a leaf node.
                 if (node.as_object().at(CTree::CTreeNode::JSON_LEAF_VALUE_TAG).is_array()) {
-                    auto leafValueArray = getAsArrayFrom(
+                    const auto& leafValueArray = getAsArrayFrom(
                         node.as_object().at(CTree::CTreeNode::JSON_LEAF_VALUE_TAG));
                     maths::analytics::CBoostedTreeNode::TVector nodeValue(
                         leafValueArray.size());
@@ -30,6 +30,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace json = boost::json;
 namespace ml {
@@ -68,6 +69,86 @@ void consumeSpace(std::istream& stream) {
 
 const std::string JSON_DOC_NUM_TAG{"doc_num"};
 const std::string JSON_EOS_TAG{"eos"};
+
+//! \brief Writes compressed encoded state as chunked documents as it is produced.
+//!
+//! DESCRIPTION:\n
+//! A document is only written once we know more data follows it, so we can mark
+//! the last one with "eos". At most one document plus one stream buffer is ever
+//! held in memory.
+class CChunkedDocumentWriter {
+public:
+    using TBoostJsonWriter = CSerializableToCompressedChunkedJson::TBoostJsonWriter;
+
+public:
+    CChunkedDocumentWriter(const std::string& compressedDocTag,
+                           const std::string& payloadTag,
+                           std::size_t maxDocumentSize,
+                           TBoostJsonWriter& writer)
+        : m_CompressedDocTag{compressedDocTag}, m_PayloadTag{payloadTag},
+          m_MaxDocumentSize{maxDocumentSize}, m_Writer{writer} {
+        m_Buffer.reserve(m_MaxDocumentSize);
+    }
+
+    void write(const char* data, std::size_t n) {
+        m_Buffer.insert(m_Buffer.end(), data, data + n);
+        while (m_Buffer.size() > m_MaxDocumentSize) {
+            this->writeDocument(m_MaxDocumentSize, false);
+        }
+    }
+
+    void finish() {
+        if (m_Buffer.empty() == false) {
+            this->writeDocument(m_Buffer.size(), true);
+        }
+    }
+
+private:
+    void writeDocument(std::size_t bytesToWrite, bool eos) {
+        m_Writer.onObjectBegin();
+        m_Writer.onKey(m_CompressedDocTag);
+        m_Writer.onObjectBegin();
+        m_Writer.onKey(JSON_DOC_NUM_TAG);
+        m_Writer.onUint64(m_DocNum);
+        m_Writer.onKey(m_PayloadTag);
+        m_Writer.onString(std::string(m_Buffer.data(), bytesToWrite));
+        if (eos) {
+            m_Writer.onKey(JSON_EOS_TAG);
+            m_Writer.onBool(true);
+        }
+        m_Writer.onObjectEnd();
+        m_Writer.onObjectEnd();
+        m_Buffer.erase(m_Buffer.begin(), m_Buffer.begin() + bytesToWrite);
+        ++m_DocNum;
+    }
+
+private:
+    const std::string& m_CompressedDocTag;
+    const std::string& m_PayloadTag;
+    std::size_t m_MaxDocumentSize;
+    TBoostJsonWriter& m_Writer;
+    std::vector<char> m_Buffer;
+    std::size_t m_DocNum{0};
+};
+
+//! \brief A Boost.Iostreams sink which forwards to a CChunkedDocumentWriter.
+class CChunkedDocumentSink {
+public:
+    using char_type = char;
+    using category = io::sink_tag;
+
+public:
+    explicit CChunkedDocumentSink(CChunkedDocumentWriter& writer)
+        : m_Writer{&writer} {}
+
+    std::streamsize write(const char* data, std::streamsize n) {
+        m_Writer->write(data, static_cast<std::size_t>(n));
+        return n;
+    }
+
+private:
+    CChunkedDocumentWriter* m_Writer;
+};
 }
 
 std::string CSerializableToJsonStream::jsonString() const {
@@ -94,33 +175,15 @@ void CSerializableToCompressedChunkedJson::addCompressedToJsonStream(
     const std::string& payloadTag,
     TBoostJsonWriter& writer) const {
 
-    using TCharVec = std::vector<char>;
-
-    TCharVec buffer;
-    buffer.reserve(m_MaxDocumentSize);
-    io::stream<io::back_insert_device<TCharVec>> bufferStream{io::back_inserter(buffer)};
-    compressAndEncode(this->callableAddToJsonStream(), bufferStream);
-
-    std::size_t docNum{0};
-    for (std::size_t i = 0; i < buffer.size(); i += m_MaxDocumentSize) {
-        std::size_t bytesToWrite = std::min(m_MaxDocumentSize, buffer.size() - i);
-
-        writer.onObjectBegin();
-        writer.onKey(compressedDocTag);
-        writer.onObjectBegin();
-        writer.onKey(JSON_DOC_NUM_TAG);
-        writer.onUint64(docNum);
-        writer.onKey(payloadTag);
-        writer.onString(std::string(&buffer[i], bytesToWrite));
-        if (i + bytesToWrite == buffer.size()) {
-            writer.onKey(JSON_EOS_TAG);
-            writer.onBool(true);
-        }
-        writer.onObjectEnd();
-        writer.onObjectEnd();
-
-        ++docNum;
+    // We stream the compressed encoded state straight into documents rather than
+    // materialising it since it can be very large, e.g. for data summarization.
+    CChunkedDocumentWriter chunkWriter{compressedDocTag, payloadTag, m_MaxDocumentSize, writer};
+    {
+        io::stream<CChunkedDocumentSink> sinkStream{CChunkedDocumentSink{chunkWriter}};
+        compressAndEncode(this->callableAddToJsonStream(), sinkStream);
+        sinkStream.flush();
     }
+    chunkWriter.finish();
 }
 
 CSerializableFromCompressedChunkedJson::TIStreamPtr
@@ -146,7 +209,7 @@ CSerializableFromCompressedChunkedJson::rawJsonStream(const std::string& compres
                 assertNoParseError(ec);
                 assertIsJsonObject(doc);
 
-                auto chunk = ifExists(compressedDocTag, getAsObjectFrom, doc.as_object());
+                const auto& chunk = ifExists(compressedDocTag, getAsObjectFrom, doc.as_object());
                 buffer.write(ifExists(payloadTag, getAsStringFrom, chunk),
                              ifExists(payloadTag, getStringLengthFrom, chunk));
                 done = chunk.contains(JSON_EOS_TAG);
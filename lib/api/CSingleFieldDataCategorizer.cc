@@ -60,8 +60,38 @@ CGlobalCategoryId CSingleFieldDataCategorizer::computeAndUpdateCategory(
     const std::string& rawMessage,
     model::CResourceMonitor& resourceMonitor,
     CJsonOutputWriter& jsonOutputWriter) {
+    bool changed{false};
+    model::CLocalCategoryId localCategoryId{this->computeLocalCategory(
+        isDryRun, fields, messageToCategorize, rawMessage, changed)};
+    return this->updateCategory(localCategoryId, changed, messageTime,
+                                resourceMonitor, jsonOutputWriter);
+}
+
+model::CLocalCategoryId CSingleFieldDataCategorizer::computeLocalCategory(
+    bool isDryRun,
+    const model::CDataCategorizer::TStrStrUMap& fields,
+    const std::string& messageToCategorize,
+    const std::string& rawMessage,
+    bool& changed) {
+    changed = false;
     model::CLocalCategoryId localCategoryId{m_DataCategorizer->computeCategory(
         isDryRun, fields, messageToCategorize, rawMessage.length())};
+    if (localCategoryId.isValid() == false) {
+        return localCategoryId;
+    }
+
+    bool exampleAdded{m_DataCategorizer->addExample(localCategoryId, rawMessage)};
+    bool searchTermsChanged{m_DataCategorizer->cacheReverseSearch(localCategoryId)};
+    changed = exampleAdded || searchTermsChanged;
+    return localCategoryId;
+}
+
+CGlobalCategoryId
+CSingleFieldDataCategorizer::updateCategory(model::CLocalCategoryId localCategoryId,
+                                            bool changed,
+                                            const TOptionalTime& messageTime,
+                                            model::CResourceMonitor& resourceMonitor,
+                                            CJsonOutputWriter& jsonOutputWriter) {
     CGlobalCategoryId globalCategoryId{m_CategoryIdMapper->map(localCategoryId)};
     if (globalCategoryId.isValid() == false) {
         return globalCategoryId;
@@ -70,9 +100,7 @@ CGlobalCategoryId CSingleFieldDataCategorizer::computeAndUpdateCategory(
     if (messageTime.has_value()) {
         m_LastMessageTime = messageTime;
     }
-    bool exampleAdded{m_DataCategorizer->addExample(localCategoryId, rawMessage)};
-    bool searchTermsChanged{m_DataCategorizer->cacheReverseSearch(localCategoryId)};
-    if (exampleAdded || searchTermsChanged) {
+    if (changed) {
         // In this case we are certain that there will have been a change, as
         // the count of the chosen category will have been incremented
         m_DataCategorizer->writeCategoryIfChanged(
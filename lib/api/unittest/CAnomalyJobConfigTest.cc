@@ -248,6 +248,7 @@ BOOST_AUTO_TEST_CASE(testParse) {
         const TModelPlotConfig& modelPlotConfig = jobConfig.modelPlotConfig();
         BOOST_REQUIRE_EQUAL(true, modelPlotConfig.enabled());
         BOOST_REQUIRE_EQUAL(true, modelPlotConfig.annotationsEnabled());
+        BOOST_REQUIRE_EQUAL(1, modelPlotConfig.boundsCadence());
         BOOST_REQUIRE_EQUAL("customer_id", modelPlotConfig.terms());
     }
     {
@@ -256,7 +257,7 @@ BOOST_AUTO_TEST_CASE(testParse) {
             "\"description\":\"\",\"analysis_config\":{\"bucket_span\":\"30m\",\"model_prune_window\":\"24h\",\"summary_count_field_name\":\"doc_count\","
             "\"detectors\":[{\"detector_description\":\"count\",\"function\":\"count\",\"exclude_frequent\":\"all\",\"by_field_name\":\"customer_id\",\"detector_index\":0}],\"influencers\":[]},"
             "\"analysis_limits\":{\"model_memory_limit\":\"4195304b\",\"categorization_examples_limit\":4},\"data_description\":{\"time_field\":\"timestamp\",\"time_format\":\"epoch_ms\"},"
-            "\"model_plot_config\":{\"enabled\":false,\"annotations_enabled\":true,\"terms\":\"customer_id\"},\"model_snapshot_retention_days\":10,"
+            "\"model_plot_config\":{\"enabled\":false,\"annotations_enabled\":true,\"terms\":\"customer_id\",\"bounds_cadence\":4},\"model_snapshot_retention_days\":10,"
             "\"daily_model_snapshot_retention_after_days\":1,\"results_index_name\":\"shared\",\"allow_lazy_open\":false}"};
 
         ml::api::CAnomalyJobConfig jobConfig;
@@ -315,6 +316,7 @@ BOOST_AUTO_TEST_CASE(testParse) {
         const TModelPlotConfig& modelPlotConfig = jobConfig.modelPlotConfig();
         BOOST_REQUIRE_EQUAL(false, modelPlotConfig.enabled());
         BOOST_REQUIRE_EQUAL(true, modelPlotConfig.annotationsEnabled());
+        BOOST_REQUIRE_EQUAL(4, modelPlotConfig.boundsCadence());
         BOOST_REQUIRE_EQUAL("customer_id", modelPlotConfig.terms());
     }
     {
@@ -14,6 +14,7 @@
 #include <core/CLogger.h>
 #include <core/COsFileFuncs.h>
 #include <core/CRegex.h>
+#include <core/Concurrency.h>
 
 #include <model/CAnomalyDetectorModelConfig.h>
 #include <model/CDataGatherer.h>
@@ -23,6 +24,7 @@
 #include <api/CCsvInputParser.h>
 #include <api/CHierarchicalResultsWriter.h>
 #include <api/CNdJsonInputParser.h>
+#include <api/CRecordBatch.h>
 #include <api/CSingleStreamDataAdder.h>
 #include <api/CSingleStreamSearcher.h>
 #include <api/CStateRestoreStreamFilter.h>
@@ -36,6 +38,8 @@
 #include <cstdio>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <regex>
 #include <sstream>
 
 BOOST_TEST_DONT_PRINT_LOG_VALUE(json::array::const_iterator)
@@ -596,6 +600,263 @@ BOOST_AUTO_TEST_CASE(testSkipTimeControlMessage) {
     BOOST_REQUIRE_EQUAL(11, countBuckets("bucket", outputStrm.str() + "]"));
 }
 
+BOOST_AUTO_TEST_CASE(testHandleRecords) {
+
+    // Check that handling records in batches gives the same results as
+    // handling them one at a time.
+
+    using TStrVec = std::vector<std::string>;
+
+    TStrVec fieldNames{"time", "value", "greenhouse", "."};
+    std::vector<TStrVec> records;
+    core_t::TTime time{3600};
+    for (std::size_t i = 0; i < 200; ++i, time += 600) {
+        std::string value{std::to_string(i == 150 ? 100.0 : 1.0 + static_cast<double>(i % 3))};
+        records.push_back({std::to_string(time), value, i % 2 == 0 ? "rhubarb" : "sprouts", ""});
+        if (i == 20) {
+            // Missing value
+            records.push_back({std::to_string(time), "", "rhubarb", ""});
+        } else if (i == 70) {
+            // Bad time
+            records.push_back({"hello", "1.0", "rhubarb", ""});
+        } else if (i == 100) {
+            // Out of order
+            records.push_back({"3600", "1.0", "rhubarb", ""});
+        } else if (i == 120) {
+            // Control message
+            records.push_back({"", "", "", "f1"});
+        }
+    }
+
+    auto output = [&](bool batched) {
+        model::CLimits limits;
+        api::CAnomalyJobConfig jobConfig = CTestAnomalyJob::makeSimpleJobConfig(
+            "mean", "value", "", "", "greenhouse", {"greenhouse"});
+        model::CAnomalyDetectorModelConfig modelConfig =
+            model::CAnomalyDetectorModelConfig::defaultConfig(BUCKET_SIZE);
+        std::stringstream outputStrm;
+        {
+            core::CJsonOutputStreamWrapper wrappedOutputStream(outputStrm);
+            CTestAnomalyJob job("job", limits, jobConfig, modelConfig, wrappedOutputStream);
+
+            if (batched) {
+                api::CRecordBatch batch;
+                batch.reset(fieldNames, {});
+                for (std::size_t i = 0; i < records.size(); ++i) {
+                    batch.add(records[i]);
+                    if (batch.size() == 7 || i + 1 == records.size()) {
+                        BOOST_TEST_REQUIRE(job.handleRecords(batch));
+                        batch.clear();
+                    }
+                }
+            } else {
+                CTestAnomalyJob::TStrStrUMap dataRows;
+                for (const auto& record : records) {
+                    for (std::size_t i = 0; i < fieldNames.size(); ++i) {
+                        dataRows[fieldNames[i]] = record[i];
+                    }
+                    BOOST_TEST_REQUIRE(job.handleRecord(dataRows));
+                }
+            }
+            // The record with a missing value is counted as handled.
+            BOOST_REQUIRE_EQUAL(201, job.numRecordsHandled());
+        }
+        // Remove the timings which will differ between runs.
+        return std::regex_replace(
+            outputStrm.str(), std::regex{"\"(processing_time_ms|log_time)\":[0-9]+"}, "");
+    };
+
+    std::string expected{output(false)};
+    BOOST_TEST_REQUIRE(expected.find("\"flush\"") != std::string::npos);
+    BOOST_REQUIRE_EQUAL(expected, output(true));
+}
+
+BOOST_AUTO_TEST_CASE(testInterimResultsAfterRulesUpdate) {
+
+    // Check that updating the detection rules mid-bucket affects the next
+    // interim results even for people who haven't received data since the
+    // previous interim results were computed.
+
+    auto numberRecords = [](bool updateRules) {
+        model::CLimits limits;
+        api::CAnomalyJobConfig jobConfig =
+            CTestAnomalyJob::makeSimpleJobConfig("mean", "value", "greenhouse", "", "");
+        model::CAnomalyDetectorModelConfig modelConfig =
+            model::CAnomalyDetectorModelConfig::defaultConfig(BUCKET_SIZE);
+        std::stringstream outputStrm;
+        {
+            core::CJsonOutputStreamWrapper wrappedOutputStream(outputStrm);
+            CTestAnomalyJob job("job", limits, jobConfig, modelConfig, wrappedOutputStream);
+
+            CTestAnomalyJob::TStrStrUMap dataRows;
+            core_t::TTime time{3600};
+            for (std::size_t i = 0; i < 300; ++i, time += BUCKET_SIZE) {
+                for (std::size_t j = 0; j < 2; ++j) {
+                    dataRows["time"] = std::to_string(time);
+                    dataRows["value"] = std::to_string(1 + (i + j) % 3);
+                    dataRows["greenhouse"] = "g" + std::to_string(j);
+                    BOOST_TEST_REQUIRE(job.handleRecord(dataRows));
+                }
+            }
+            dataRows["time"] = std::to_string(time);
+            dataRows["value"] = "100";
+            dataRows["greenhouse"] = "g0";
+            BOOST_TEST_REQUIRE(job.handleRecord(dataRows));
+
+            CTestAnomalyJob::TStrStrUMap controlRows;
+            controlRows["."] = "i";
+            BOOST_TEST_REQUIRE(job.handleRecord(controlRows));
+            if (updateRules) {
+                controlRows["."] = "u{\"detector_rules\":{\"detector_index\":0,"
+                                   "\"custom_rules\":[{\"actions\":[\"skip_result\"],"
+                                   "\"conditions\":[{\"applies_to\":\"actual\","
+                                   "\"operator\":\"gt\",\"value\":0.0}]}]}}";
+                BOOST_TEST_REQUIRE(job.handleRecord(controlRows));
+            }
+            controlRows["."] = "i";
+            BOOST_TEST_REQUIRE(job.handleRecord(controlRows));
+        }
+        std::string output{outputStrm.str()};
+        std::size_t result{0};
+        for (std::size_t pos = output.find("\"records\""); pos != std::string::npos;
+             pos = output.find("\"records\"", pos + 1)) {
+            ++result;
+        }
+        return result;
+    };
+
+    std::size_t withoutUpdate{numberRecords(false)};
+    std::size_t withUpdate{numberRecords(true)};
+    LOG_DEBUG(<< "records without update = " << withoutUpdate
+              << ", with update = " << withUpdate);
+    BOOST_TEST_REQUIRE(withoutUpdate > 0);
+    BOOST_TEST_REQUIRE(withUpdate < withoutUpdate);
+}
+
+BOOST_AUTO_TEST_CASE(testComputeDetectorResultsConcurrently) {
+
+    // Check that computing the detectors' results concurrently gives the
+    // same results as computing them serially, including when the resource
+    // monitor is limiting allocations.
+
+    using TStrVec = std::vector<std::string>;
+
+    core::startDefaultAsyncExecutor(4);
+
+    TStrVec greenhouses{"rhubarb", "sprouts", "leeks", "kale", "chard", "beets"};
+
+    auto output = [&](bool concurrently, const std::string& overFieldName,
+                      std::size_t memoryLimit) {
+        model::CLimits limits;
+        if (memoryLimit > 0) {
+            limits.resourceMonitor().memoryLimit(memoryLimit);
+        }
+        api::CAnomalyJobConfig jobConfig = CTestAnomalyJob::makeSimpleJobConfig(
+            "mean", "value", "", overFieldName, "greenhouse", {"greenhouse"});
+        model::CAnomalyDetectorModelConfig modelConfig =
+            model::CAnomalyDetectorModelConfig::defaultConfig(BUCKET_SIZE);
+        std::stringstream outputStrm;
+        {
+            core::CJsonOutputStreamWrapper wrappedOutputStream(outputStrm);
+            CTestAnomalyJob job("job", limits, jobConfig, modelConfig, wrappedOutputStream);
+            job.computeDetectorResultsConcurrently(concurrently);
+
+            CTestAnomalyJob::TStrStrUMap dataRows;
+            core_t::TTime time{3600};
+            for (std::size_t i = 0; i < 600; ++i, time += 600) {
+                for (std::size_t j = 0; j < greenhouses.size(); ++j) {
+                    double value{i == 500 && j == 2
+                                     ? 100.0
+                                     : 1.0 + static_cast<double>((i + j) % 3)};
+                    dataRows["time"] = std::to_string(time);
+                    dataRows["value"] = std::to_string(value);
+                    dataRows["greenhouse"] = greenhouses[j];
+                    if (overFieldName.empty() == false) {
+                        // Each bucket has new over field values so memory is
+                        // both released and limited.
+                        dataRows[overFieldName] = "p" + std::to_string(i * 7 + j);
+                    }
+                    BOOST_TEST_REQUIRE(job.handleRecord(dataRows));
+                }
+            }
+        }
+        // Remove the timings which will differ between runs.
+        return std::regex_replace(
+            outputStrm.str(), std::regex{"\"(processing_time_ms|log_time)\":[0-9]+"}, "");
+    };
+
+    std::string expected{output(false, "", 0)};
+    BOOST_TEST_REQUIRE(expected.find("\"records\"") != std::string::npos);
+    BOOST_REQUIRE_EQUAL(expected, output(true, "", 0));
+
+    expected = output(false, "plant", 1 /*MB*/);
+    BOOST_TEST_REQUIRE(expected.find("\"records\"") != std::string::npos);
+    BOOST_REQUIRE_EQUAL(expected, output(true, "plant", 1 /*MB*/));
+
+    core::stopDefaultAsyncExecutor();
+}
+
+BOOST_AUTO_TEST_CASE(testPersistBinaryState) {
+
+    // Check that a job restored from binary state has the same state as the
+    // job which persisted it.
+
+    using TStrVec = std::vector<std::string>;
+
+    TStrVec greenhouses{"rhubarb", "sprouts", "leeks", "kale", "chard", "beets"};
+
+    model::CLimits limits;
+    api::CAnomalyJobConfig jobConfig = CTestAnomalyJob::makeSimpleJobConfig(
+        "mean", "value", "", "", "greenhouse", {"greenhouse"});
+    model::CAnomalyDetectorModelConfig modelConfig =
+        model::CAnomalyDetectorModelConfig::defaultConfig(BUCKET_SIZE);
+    std::stringstream outputStrm;
+    core::CJsonOutputStreamWrapper wrappedOutputStream(outputStrm);
+
+    auto persist = [](CTestAnomalyJob& job) {
+        std::ostringstream* strm{nullptr};
+        api::CSingleStreamDataAdder::TOStreamP ptr{strm = new std::ostringstream()};
+        api::CSingleStreamDataAdder persister{ptr};
+        BOOST_TEST_REQUIRE(job.doPersistStateInForeground(persister, "", "snapshot", 0));
+        return strm->str();
+    };
+    auto restore = [&](const std::string& state) {
+        auto strm = std::make_shared<boost::iostreams::filtering_istream>();
+        strm->push(api::CStateRestoreStreamFilter());
+        std::istringstream stateStrm{state};
+        strm->push(stateStrm);
+        auto job = std::make_unique<CTestAnomalyJob>("job", limits, jobConfig,
+                                                     modelConfig, wrappedOutputStream);
+        core_t::TTime completeToTime{0};
+        api::CSingleStreamSearcher searcher{strm};
+        BOOST_TEST_REQUIRE(job->restoreState(searcher, completeToTime));
+        BOOST_TEST_REQUIRE(completeToTime > 0);
+        return job;
+    };
+
+    CTestAnomalyJob job("job", limits, jobConfig, modelConfig, wrappedOutputStream);
+
+    CTestAnomalyJob::TStrStrUMap dataRows;
+    core_t::TTime time{3600};
+    for (std::size_t i = 0; i < 300; ++i, time += 600) {
+        for (std::size_t j = 0; j < greenhouses.size(); ++j) {
+            dataRows["time"] = std::to_string(time);
+            dataRows["value"] = std::to_string(1.0 + static_cast<double>((i + j) % 3));
+            dataRows["greenhouse"] = greenhouses[j];
+            BOOST_TEST_REQUIRE(job.handleRecord(dataRows));
+        }
+    }
+
+    std::string expected{persist(job)};
+    job.persistBinaryState(true);
+    std::string binary{persist(job)};
+    BOOST_TEST_REQUIRE(binary != expected);
+
+    // The restored job persists JSON by default.
+    BOOST_REQUIRE_EQUAL(expected, persist(*restore(binary)));
+    BOOST_REQUIRE_EQUAL(expected, persist(*restore(expected)));
+}
+
 BOOST_AUTO_TEST_CASE(testIsPersistenceNeeded) {
 
     model::CLimits limits;
@@ -14,6 +14,7 @@
 #include <core/CDataSearcher.h>
 #include <core/CJsonOutputStreamWrapper.h>
 #include <core/CStringUtils.h>
+#include <core/Concurrency.h>
 
 #include <model/CLimits.h>
 
@@ -28,6 +29,7 @@
 #include <set>
 #include <sstream>
 #include <tuple>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE(CFieldDataCategorizerTest)
 
@@ -53,6 +55,7 @@ public:
 class CTestChainedProcessor : public CDataProcessor {
 public:
     using TIntSet = std::set<int>;
+    using TIntVec = std::vector<int>;
 
 public:
     void finalise() override { m_Finalised = true; }
@@ -76,6 +79,7 @@ public:
             categoryId > 0) {
             m_CategoryIdsHandled.insert(categoryId);
         }
+        m_CategoryIdSequence.push_back(categoryId);
         ++m_NumRecordsHandled;
         return true;
     }
@@ -104,6 +108,8 @@ public:
 
     const TIntSet& categoryIdsHandled() const { return m_CategoryIdsHandled; }
 
+    const TIntVec& categoryIdSequence() const { return m_CategoryIdSequence; }
+
 private:
     bool m_Finalised = false;
 
@@ -111,6 +117,7 @@ private:
     std::uint64_t m_NumControlMessages = 0;
 
     TIntSet m_CategoryIdsHandled;
+    TIntVec m_CategoryIdSequence;
 };
 
 class CTestDataSearcher : public core::CDataSearcher {
@@ -427,6 +434,80 @@ BOOST_AUTO_TEST_CASE(testWithPerPartitionCategorization) {
     BOOST_REQUIRE_EQUAL(origJson, newJson);
 }
 
+BOOST_AUTO_TEST_CASE(testConcurrentPerPartitionCategorization) {
+
+    // Check that categorizing partitions concurrently assigns the same
+    // categories, in the same order, and ends in the same state as
+    // categorizing serially.
+
+    using TStrVec = std::vector<std::string>;
+
+    core::startDefaultAsyncExecutor(3);
+
+    CAnomalyJobConfig config;
+    BOOST_TEST_REQUIRE(config.initFromFile("testfiles/new_persist_per_partition_categorization.json"));
+
+    TStrVec partitions{"elasticsearch", "kibana", "logstash", "beats", "apm"};
+    TStrVec messages{"Node {} started",
+                     "Node {} stopped",
+                     "Shard {} of index {} relocated to node {}",
+                     "User {} logged in from {}",
+                     "GC overhead {} percent",
+                     "Connection refused to host {}"};
+
+    auto categorize = [&](std::size_t batchSize, std::string& state) {
+        model::CLimits limits;
+        CTestChainedProcessor testChainedProcessor;
+        std::ostringstream outputStrm;
+        {
+            core::CJsonOutputStreamWrapper wrappedOutputStream{outputStrm};
+            CTestFieldDataCategorizer categorizer{"job", config.analysisConfig(), limits,
+                                                  &testChainedProcessor, wrappedOutputStream};
+            categorizer.concurrentCategorizationBatchSize(batchSize);
+
+            CFieldDataCategorizer::TStrStrUMap dataRowFields;
+            categorizer.registerMutableField(
+                CFieldDataCategorizer::MLCATEGORY_NAME,
+                dataRowFields[CFieldDataCategorizer::MLCATEGORY_NAME]);
+            for (std::size_t i = 0; i < 500; ++i) {
+                std::string message{messages[(i * i + i / 7) % messages.size()]};
+                for (std::size_t pos = message.find("{}"); pos != std::string::npos;
+                     pos = message.find("{}")) {
+                    message.replace(pos, 2, std::to_string(i % 13));
+                }
+                dataRowFields["message"] = message;
+                dataRowFields["event.dataset"] = partitions[(i / 3) % partitions.size()];
+                BOOST_TEST_REQUIRE(categorizer.handleRecord(dataRowFields));
+                if (i == 250) {
+                    CFieldDataCategorizer::TStrStrUMap control;
+                    control["."] = "f1";
+                    BOOST_TEST_REQUIRE(categorizer.handleRecord(control));
+                    BOOST_REQUIRE_EQUAL(i + 1, testChainedProcessor.numRecordsHandled());
+                }
+            }
+            categorizer.finalise();
+            BOOST_REQUIRE_EQUAL(500, categorizer.numRecordsHandled());
+
+            CTestDataAdder adder;
+            categorizer.persistStateInForeground(adder, "");
+            state = dynamic_cast<std::ostringstream&>(*adder.getStream()).str();
+        }
+        return testChainedProcessor.categoryIdSequence();
+    };
+
+    std::string serialState;
+    auto serialCategories = categorize(0, serialState);
+    std::string concurrentState;
+    auto concurrentCategories = categorize(17, concurrentState);
+
+    core::stopDefaultAsyncExecutor();
+
+    BOOST_REQUIRE_EQUAL(500, serialCategories.size());
+    BOOST_REQUIRE_EQUAL(core::CContainerPrinter::print(serialCategories),
+                        core::CContainerPrinter::print(concurrentCategories));
+    BOOST_REQUIRE_EQUAL(serialState, concurrentState);
+}
+
 BOOST_AUTO_TEST_CASE(testNodeReverseSearch) {
     model::CLimits limits;
     CAnomalyJobConfig config;
@@ -11,6 +11,7 @@
 
 #include <core/CJsonOutputStreamWrapper.h>
 #include <core/CLogger.h>
+#include <core/Concurrency.h>
 #include <core/Constants.h>
 
 #include <model/CAnomalyDetectorModelConfig.h>
@@ -25,6 +26,7 @@
 #include <cmath>
 #include <memory>
 #include <string>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE(CForecastRunnerTest)
 
@@ -58,6 +60,15 @@ void generatePopulationRecord(ml::core_t::TTime time, CTestAnomalyJob::TStrStrUM
     dataRows["person"] = "jill";
 }
 
+void generateRecordWithManyPeople(ml::core_t::TTime time,
+                                  CTestAnomalyJob::TStrStrUMap& dataRows) {
+    double x = static_cast<double>(time - START_TIME) / BUCKET_LENGTH;
+    dataRows["time"] = ml::core::CStringUtils::typeToString(time);
+    dataRows["person"] = "person" + std::to_string((time / (BUCKET_LENGTH / 2)) % 20);
+    dataRows["value"] = ml::core::CStringUtils::typeToString(
+        100.0 + 20.0 * std::sin(x / 4.0) + static_cast<double>(time % 7));
+}
+
 void populateJob(TGenerateRecord generateRecord, CTestAnomalyJob& job, std::size_t buckets = 1000) {
     ml::core_t::TTime time = START_TIME;
     CTestAnomalyJob::TStrStrUMap dataRows;
@@ -149,6 +160,58 @@ BOOST_AUTO_TEST_CASE(testSummaryCount) {
         forecastStats.at("forecast_expiry_timestamp").to_number<std::int64_t>());
 }
 
+BOOST_AUTO_TEST_CASE(testConcurrentForecastMatchesSerial) {
+
+    // Check that forecasting the models concurrently writes the same forecast
+    // documents, in the same order, as forecasting them serially.
+
+    auto forecast = [](std::size_t numberThreads) {
+        std::stringstream outputStrm;
+        {
+            ml::core::CJsonOutputStreamWrapper streamWrapper(outputStrm);
+            ml::model::CLimits limits;
+            ml::api::CAnomalyJobConfig jobConfig = CTestAnomalyJob::makeSimpleJobConfig(
+                "mean", "value", "person", "", "");
+
+            ml::model::CAnomalyDetectorModelConfig modelConfig =
+                ml::model::CAnomalyDetectorModelConfig::defaultConfig(BUCKET_LENGTH);
+
+            CTestAnomalyJob job("job", limits, jobConfig, modelConfig, streamWrapper);
+            job.numberForecastThreads(numberThreads);
+            populateJob(generateRecordWithManyPeople, job, 20 * 200);
+
+            CTestAnomalyJob::TStrStrUMap dataRows;
+            dataRows["."] = "p{\"duration\":" + std::to_string(13 * BUCKET_LENGTH) +
+                            ",\"forecast_id\": \"42\"" +
+                            ",\"create_time\": \"1511370819\"" + " }";
+            BOOST_TEST_REQUIRE(job.handleRecord(dataRows));
+        }
+
+        json::error_code ec;
+        json::value doc = json::parse(outputStrm.str(), ec);
+        BOOST_TEST_REQUIRE(ec.failed() == false);
+        std::vector<std::string> result;
+        for (const auto& m : doc.as_array()) {
+            if (m.as_object().contains("model_forecast")) {
+                result.push_back(json::serialize(m));
+            }
+        }
+        return result;
+    };
+
+    auto serial = forecast(1);
+
+    ml::core::startDefaultAsyncExecutor(4);
+    auto concurrent = forecast(4);
+    ml::core::stopDefaultAsyncExecutor();
+
+    BOOST_TEST_REQUIRE(serial.size() >= 20 * 13);
+    BOOST_REQUIRE_EQUAL(serial.size(), concurrent.size());
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(serial[i], concurrent[i]);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testPopulation) {
     std::stringstream outputStrm;
     {
@@ -1564,6 +1564,77 @@ BOOST_AUTO_TEST_CASE(testWriteInfluencersWithLimit) {
         1.0, binf3.at("raw_anomaly_score").to_number<double>(), 0.001);
 }
 
+BOOST_AUTO_TEST_CASE(testWriteLimitedRecordsAcrossBatches) {
+    // Check the records of later batches are written correctly when they
+    // reuse the buffers of earlier batches' records.
+
+    std::ostringstream sstream;
+
+    {
+        ml::core::CJsonOutputStreamWrapper outputStream(sstream);
+        ml::api::CJsonOutputWriter writer("job", outputStream);
+        writer.limitNumberRecords(2);
+
+        std::string pfn("partition_field_name");
+        std::string pfv("partition_field_value");
+        std::string bfn("by_field_name");
+        std::string fun("function");
+        std::string fund("function_description");
+        std::string fn("field_name");
+        std::string emptyStr;
+        ml::api::CHierarchicalResultsWriter::TOptionalStrOptionalStrPrDoublePrVec influences;
+
+        for (ml::core_t::TTime time = 0; time < 300; time += 100) {
+            for (std::size_t i = 0; i < 4; ++i) {
+                std::string bfv("value_" + std::to_string(time + i));
+                double probability{0.1 * static_cast<double>((i + 2) % 4 + 1)};
+                ml::api::CHierarchicalResultsWriter::SResults result(
+                    ml::api::CHierarchicalResultsWriter::E_Result, pfn, pfv,
+                    bfn, bfv, emptyStr, time, fun, fund, 42.0, 79,
+                    TDouble1Vec(1, 6953.0), TDouble1Vec(1, 10090.0), 0.0, 0.1,
+                    probability, -5.0, fn, influences, false, true, 1, 100,
+                    EMPTY_STRING_LIST, {});
+                BOOST_TEST_REQUIRE(writer.acceptResult(result));
+            }
+            BOOST_TEST_REQUIRE(writer.endOutputBatch(false, 1U));
+        }
+    }
+
+    json::error_code ec;
+    json::value doc_ = json::parse(sstream.str(), ec);
+    BOOST_TEST_REQUIRE(ec.failed() == false);
+    BOOST_TEST_REQUIRE(doc_.is_array());
+    const json::array& doc = doc_.as_array();
+
+    LOG_DEBUG(<< "limited records across batches:\n" << doc);
+
+    // Each batch writes a records object followed by a bucket object.
+    BOOST_REQUIRE_EQUAL(std::size_t(6), doc.size());
+    for (std::size_t i = 0; i < 3; ++i) {
+        const json::object& records_ = doc.at(2 * i).as_object();
+        BOOST_TEST_REQUIRE(records_.contains("records"));
+        const json::array& records = records_.at("records").as_array();
+        BOOST_REQUIRE_EQUAL(std::size_t(2), records.size());
+
+        std::int64_t time{static_cast<std::int64_t>(100 * i)};
+        const std::string expectedValues[]{"value_" + std::to_string(time + 2),
+                                           "value_" + std::to_string(time + 3)};
+        const double expectedProbabilities[]{0.1, 0.2};
+        for (std::size_t j = 0; j < 2; ++j) {
+            const json::object& record = records.at(j).as_object();
+            BOOST_REQUIRE_CLOSE_ABSOLUTE(expectedProbabilities[j],
+                                         record.at("probability").to_number<double>(), 0.001);
+            BOOST_REQUIRE_EQUAL(expectedValues[j], record.at("by_field_value").as_string());
+            BOOST_REQUIRE_EQUAL(1, record.at("detector_index").to_number<std::int64_t>());
+            BOOST_REQUIRE_EQUAL(100, record.at("bucket_span").to_number<std::int64_t>());
+            BOOST_REQUIRE_EQUAL("job", record.at("job_id").as_string());
+            BOOST_REQUIRE_EQUAL(time * 1000, record.at("timestamp").to_number<std::int64_t>());
+            BOOST_TEST_REQUIRE(record.contains("is_interim") == false);
+        }
+        BOOST_TEST_REQUIRE(doc.at(2 * i + 1).as_object().contains("bucket"));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testWriteWithInfluences) {
     std::ostringstream sstream;
 
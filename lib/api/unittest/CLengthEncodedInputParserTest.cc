@@ -12,16 +12,20 @@
 #include <core/CLogger.h>
 #include <core/CStringUtils.h>
 #include <core/CTimeUtils.h>
+#include <core/Concurrency.h>
 
 #include <api/CCsvInputParser.h>
 #include <api/CLengthEncodedInputParser.h>
+#include <api/CRecordBatch.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <ios>
 #include <sstream>
+#include <vector>
 
 // For htonl
 #ifdef Windows
@@ -99,6 +103,23 @@ private:
     std::string m_EncodedDataBlock;
 };
 
+//! Length encode \p records.
+std::string encode(const std::vector<ml::api::CCsvInputParser::TStrVec>& records) {
+    std::string result;
+    auto appendNumber = [&](std::size_t num) {
+        std::uint32_t netNum(htonl(static_cast<std::uint32_t>(num)));
+        result.append(reinterpret_cast<char*>(&netNum), sizeof(netNum));
+    };
+    for (const auto& record : records) {
+        appendNumber(record.size());
+        for (const auto& field : record) {
+            appendNumber(field.length());
+            result += field;
+        }
+    }
+    return result;
+}
+
 class CVisitor {
 public:
     CVisitor() : m_Fast(true), m_RecordCount(0) {}
@@ -281,6 +302,138 @@ BOOST_AUTO_TEST_CASE(testThroughput) {
              << (end - start) << " seconds");
 }
 
+BOOST_AUTO_TEST_CASE(testReadStreamIntoBatches) {
+    std::ifstream ifs("testfiles/simple.txt");
+    BOOST_TEST_REQUIRE(ifs.is_open());
+
+    CSetupVisitor setupVisitor;
+    ml::api::CCsvInputParser setupParser(ifs);
+    BOOST_TEST_REQUIRE(setupParser.readStreamIntoVecs(std::ref(setupVisitor)));
+
+    using TStrVec = ml::api::CCsvInputParser::TStrVec;
+    using TStrVecVec = std::vector<TStrVec>;
+    using TSizeVec = std::vector<std::size_t>;
+
+    // Check the batches contain the same records as reading to vectors.
+    {
+        TStrVecVec expectedRecords;
+        {
+            std::istringstream input(setupVisitor.input(1), std::ios::in | std::ios::binary);
+            ml::api::CLengthEncodedInputParser parser(TStrVec{"mlcategory"}, input);
+            BOOST_TEST_REQUIRE(parser.readStreamIntoVecs(
+                [&](const TStrVec& fieldNames, const TStrVec& fieldValues) {
+                    BOOST_REQUIRE_EQUAL("mlcategory", fieldNames.back());
+                    expectedRecords.push_back(fieldValues);
+                    return true;
+                }));
+        }
+
+        std::istringstream input(setupVisitor.input(1), std::ios::in | std::ios::binary);
+        ml::api::CLengthEncodedInputParser parser(TStrVec{"mlcategory"}, input);
+        TStrVecVec records;
+        TSizeVec batchSizes;
+        BOOST_TEST_REQUIRE(parser.readStreamIntoBatches(
+            [&](const ml::api::CRecordBatch& batch) {
+                BOOST_REQUIRE_EQUAL(27, batch.fieldNames().size());
+                BOOST_REQUIRE_EQUAL(1, batch.mutableFieldNames().size());
+                BOOST_REQUIRE_EQUAL(batch.fieldNames().size() - 1,
+                                    *batch.fieldIndex("mlcategory"));
+                for (std::size_t i = 0; i < batch.size(); ++i) {
+                    records.emplace_back();
+                    for (std::size_t j = 0; j < batch.fieldNames().size(); ++j) {
+                        records.back().push_back(batch.value(j, i));
+                    }
+                }
+                batchSizes.push_back(batch.size());
+                return true;
+            },
+            4));
+
+        BOOST_REQUIRE_EQUAL(15, records.size());
+        BOOST_TEST_REQUIRE(records == expectedRecords);
+        // Batches are also passed on when the next record isn't in the parser's
+        // buffer so only check they're not too large.
+        BOOST_TEST_REQUIRE(batchSizes.size() < records.size());
+        BOOST_TEST_REQUIRE(*std::max_element(batchSizes.begin(), batchSizes.end()) <= 4);
+    }
+
+    // Check control messages are passed on immediately.
+    {
+        std::istringstream input(encode({{"value", "."},
+                                         {"1", ""},
+                                         {"2", ""},
+                                         {"3", "f1"},
+                                         {"4", ""}}),
+                                 std::ios::in | std::ios::binary);
+        ml::api::CLengthEncodedInputParser parser(input);
+        TStrVecVec batches;
+        BOOST_TEST_REQUIRE(parser.readStreamIntoBatches([&](const ml::api::CRecordBatch& batch) {
+            batches.emplace_back();
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                batches.back().push_back(batch.value(0, i));
+            }
+            return true;
+        }));
+        BOOST_TEST_REQUIRE((batches == TStrVecVec{{"1", "2", "3"}, {"4"}}));
+    }
+
+    // Check the reader can stop reading.
+    {
+        std::istringstream input(setupVisitor.input(1), std::ios::in | std::ios::binary);
+        ml::api::CLengthEncodedInputParser parser(input);
+        std::size_t numberBatches{0};
+        BOOST_TEST_REQUIRE(!parser.readStreamIntoBatches(
+            [&](const ml::api::CRecordBatch&) { return ++numberBatches < 2; }, 4));
+        BOOST_REQUIRE_EQUAL(2, numberBatches);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testParallelParsing) {
+    std::ifstream ifs("testfiles/simple.txt");
+    BOOST_TEST_REQUIRE(ifs.is_open());
+
+    CSetupVisitor setupVisitor;
+    ml::api::CCsvInputParser setupParser(ifs);
+    BOOST_TEST_REQUIRE(setupParser.readStreamIntoVecs(std::ref(setupVisitor)));
+
+    using TStrVec = ml::api::CCsvInputParser::TStrVec;
+    using TStrVecVec = std::vector<TStrVec>;
+
+    auto read = [&](std::string input, bool parallel) {
+        std::istringstream strm(input, std::ios::in | std::ios::binary);
+        ml::api::CLengthEncodedInputParser parser(TStrVec{"mlcategory"}, strm);
+        if (parallel) {
+            // Use small chunks so records straddle many chunk boundaries.
+            parser.parseInParallel(4096);
+        }
+        TStrVecVec records;
+        bool result{parser.readStreamIntoVecs([&](const TStrVec&, const TStrVec& fieldValues) {
+            records.push_back(fieldValues);
+            return true;
+        })};
+        return std::make_pair(result, records);
+    };
+
+    ml::core::startDefaultAsyncExecutor(4);
+
+    std::string input{setupVisitor.input(1000)};
+
+    auto expected = read(input, false);
+    auto actual = read(input, true);
+    BOOST_TEST_REQUIRE(expected.first);
+    BOOST_TEST_REQUIRE(actual.first);
+    BOOST_REQUIRE_EQUAL(15000, actual.second.size());
+    BOOST_TEST_REQUIRE(expected.second == actual.second);
+
+    // Check corrupt input is still detected after the good records are read.
+    input.append(1000, 'a');
+    actual = read(input, true);
+    BOOST_TEST_REQUIRE(actual.first == false);
+    BOOST_REQUIRE_EQUAL(15000, actual.second.size());
+
+    ml::core::stopDefaultAsyncExecutor();
+}
+
 BOOST_AUTO_TEST_CASE(testCorruptStreamDetection) {
     std::uint32_t numFields(1);
     std::uint32_t numFieldsNet(htonl(numFields));
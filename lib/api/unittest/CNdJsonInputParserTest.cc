@@ -9,6 +9,7 @@
  * limitation.
  */
 
+#include <core/CContainerPrinter.h>
 #include <core/CLogger.h>
 #include <core/CTimeUtils.h>
 
@@ -21,6 +22,7 @@
 #include <fstream>
 #include <functional>
 #include <sstream>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE(CNdJsonInputParserTest)
 
@@ -147,4 +149,68 @@ BOOST_AUTO_TEST_CASE(testThroughputCommonVecHandler) {
     runTest(true, true);
 }
 
+BOOST_AUTO_TEST_CASE(testFieldValues) {
+
+    // Check the field values are the serialized JSON values without quotes.
+
+    std::string input{"{\"a\":\"x\\\"y\\n\",\"b\":{\"c\":[1,true,null,\"s\"],\"d\":{}},"
+                      "\"e\":-5,\"f\":2.5}\n"
+                      "{\"a\":\"p\",\"b\":\"q\",\"e\":7,\"f\":false}\n"};
+    std::string f{json::serialize(json::value(2.5))};
+
+    for (bool allDocsSameStructure : {false, true}) {
+        std::istringstream strm{input};
+        ml::api::CNdJsonInputParser parser{strm, allDocsSameStructure};
+
+        std::vector<ml::api::CNdJsonInputParser::TStrStrUMap> records;
+        BOOST_TEST_REQUIRE(parser.readStreamIntoMaps(
+            [&](const ml::api::CNdJsonInputParser::TStrStrUMap& fields) {
+                records.push_back(fields);
+                return true;
+            }));
+        BOOST_REQUIRE_EQUAL(2, records.size());
+        BOOST_REQUIRE_EQUAL("x\\y\\n", records[0]["a"]);
+        BOOST_REQUIRE_EQUAL("{c:[1,true,null,s],d:{}}", records[0]["b"]);
+        BOOST_REQUIRE_EQUAL("-5", records[0]["e"]);
+        BOOST_REQUIRE_EQUAL(f, records[0]["f"]);
+        BOOST_REQUIRE_EQUAL("p", records[1]["a"]);
+        BOOST_REQUIRE_EQUAL("q", records[1]["b"]);
+        BOOST_REQUIRE_EQUAL("7", records[1]["e"]);
+        BOOST_REQUIRE_EQUAL("false", records[1]["f"]);
+
+        strm.clear();
+        strm.str(input);
+        std::vector<ml::api::CNdJsonInputParser::TStrVec> values;
+        BOOST_TEST_REQUIRE(parser.readStreamIntoVecs(
+            [&](const ml::api::CNdJsonInputParser::TStrVec& fieldNames,
+                const ml::api::CNdJsonInputParser::TStrVec& fieldValues) {
+                BOOST_REQUIRE_EQUAL("[a, b, e, f]",
+                                    ml::core::CContainerPrinter::print(fieldNames));
+                values.push_back(fieldValues);
+                return true;
+            }));
+        BOOST_REQUIRE_EQUAL(2, values.size());
+        BOOST_REQUIRE_EQUAL("[p, q, 7, false]", ml::core::CContainerPrinter::print(values[1]));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testInvalidDocuments) {
+    for (const auto& input :
+         {std::string{"[1, 2]\n"}, std::string{"\"a\"\n"}, std::string{"{\"a\":1\n"},
+          std::string{"{\"a\":1} x\n"}}) {
+        std::istringstream strm{input};
+        ml::api::CNdJsonInputParser parser{strm};
+        CVisitor visitor;
+        BOOST_TEST_REQUIRE(parser.readStreamIntoMaps(std::ref(visitor)) == false);
+        BOOST_REQUIRE_EQUAL(0, visitor.recordCount());
+    }
+
+    // More fields than the first document when all have the same structure.
+    std::istringstream strm{"{\"a\":1}\n{\"a\":1,\"b\":2}\n"};
+    ml::api::CNdJsonInputParser parser{strm, true};
+    CVisitor visitor;
+    BOOST_TEST_REQUIRE(parser.readStreamIntoVecs(std::ref(visitor)) == false);
+    BOOST_REQUIRE_EQUAL(1, visitor.recordCount());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
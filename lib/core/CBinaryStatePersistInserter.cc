@@ -0,0 +1,144 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+#include <core/CBinaryStatePersistInserter.h>
+
+#include <core/CIEEE754.h>
+#include <core/CLogger.h>
+
+#include <cstring>
+
+namespace ml {
+namespace core {
+
+const std::string CBinaryStatePersistInserter::MARKER{"\xB1"
+                                                      "MLB"};
+const std::uint8_t CBinaryStatePersistInserter::VERSION{1};
+const std::size_t CBinaryStatePersistInserter::TYPE_BITS{3};
+
+CBinaryStatePersistInserter::CBinaryStatePersistInserter(std::ostream& outputStream)
+    : m_WriteStream(outputStream), m_Levels(1) {
+}
+
+CBinaryStatePersistInserter::~CBinaryStatePersistInserter() {
+    this->flush();
+}
+
+void CBinaryStatePersistInserter::insertValue(const std::string& name,
+                                              const std::string& value) {
+    this->appendHeader(name, E_String);
+    std::string& buffer{this->currentLevel()};
+    appendVarint(value.size(), buffer);
+    buffer.append(value);
+}
+
+void CBinaryStatePersistInserter::insertValue(const std::string& name,
+                                              double value,
+                                              CIEEE754::EPrecision precision) {
+    switch (precision) {
+    case CIEEE754::E_HalfPrecision:
+        this->appendHeader(name, E_HalfPrecisionDouble);
+        break;
+    case CIEEE754::E_SinglePrecision:
+        this->appendHeader(name, E_SinglePrecisionDouble);
+        break;
+    case CIEEE754::E_DoublePrecision:
+        this->appendHeader(name, E_DoublePrecisionDouble);
+        break;
+    }
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    std::string& buffer{this->currentLevel()};
+    for (std::size_t i = 0; i < sizeof(bits); ++i, bits >>= 8) {
+        buffer.push_back(static_cast<char>(bits & 0xFF));
+    }
+}
+
+void CBinaryStatePersistInserter::insertValue(const std::string& name,
+                                              const TFloatStorageVec& values) {
+    this->appendHeader(name, E_SinglePrecisionArray);
+    std::string& buffer{this->currentLevel()};
+    appendVarint(values.size(), buffer);
+    buffer.reserve(buffer.size() + sizeof(float) * values.size());
+    for (const auto& value : values) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value.cstorage(), sizeof(bits));
+        for (std::size_t i = 0; i < sizeof(bits); ++i, bits >>= 8) {
+            buffer.push_back(static_cast<char>(bits & 0xFF));
+        }
+    }
+}
+
+void CBinaryStatePersistInserter::flush() {
+    if (m_Flushed) {
+        return;
+    }
+    if (m_Depth > 0) {
+        LOG_ERROR(<< "Inconsistency - writing state with " << m_Depth << " unclosed levels");
+    }
+    m_Flushed = true;
+
+    std::string header{MARKER};
+    header.push_back(static_cast<char>(VERSION));
+    appendVarint(m_Names.size(), header);
+    for (const auto& name : m_Names) {
+        appendVarint(name.size(), header);
+        header.append(name);
+    }
+    appendVarint(m_Levels[0].size(), header);
+
+    m_WriteStream.write(header.data(), static_cast<std::streamsize>(header.size()));
+    m_WriteStream.write(m_Levels[0].data(),
+                        static_cast<std::streamsize>(m_Levels[0].size()));
+    m_WriteStream.flush();
+}
+
+void CBinaryStatePersistInserter::appendVarint(std::uint64_t value, std::string& buffer) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+void CBinaryStatePersistInserter::newLevel(const std::string& name) {
+    m_LevelNames.push_back(this->nameIndex(name));
+    if (++m_Depth == m_Levels.size()) {
+        m_Levels.emplace_back();
+    }
+    m_Levels[m_Depth].clear();
+}
+
+void CBinaryStatePersistInserter::endLevel() {
+    if (m_Depth == 0) {
+        LOG_ERROR(<< "Inconsistency - ending a level which was never started");
+        return;
+    }
+    const std::string& level{m_Levels[m_Depth]};
+    std::string& parent{m_Levels[--m_Depth]};
+    appendVarint((m_LevelNames.back() << TYPE_BITS) | E_Level, parent);
+    appendVarint(level.size(), parent);
+    parent.append(level);
+    m_LevelNames.pop_back();
+}
+
+std::size_t CBinaryStatePersistInserter::nameIndex(const std::string& name) {
+    auto[i, inserted] = m_NameIndices.emplace(name, m_Names.size());
+    if (inserted) {
+        m_Names.push_back(name);
+    }
+    return i->second;
+}
+
+void CBinaryStatePersistInserter::appendHeader(const std::string& name, EType type) {
+    appendVarint((this->nameIndex(name) << TYPE_BITS) | type, this->currentLevel());
+}
+}
+}
@@ -0,0 +1,388 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+#include <core/CBinaryStateRestoreTraverser.h>
+
+#include <core/CBinaryStatePersistInserter.h>
+#include <core/CIEEE754.h>
+#include <core/CLogger.h>
+#include <core/CPersistUtils.h>
+#include <core/CStringUtils.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <tuple>
+
+namespace ml {
+namespace core {
+
+namespace {
+using TInserter = CBinaryStatePersistInserter;
+
+const std::string EMPTY_STRING;
+
+//! The largest chunk we read from the stream at once. This stops us
+//! allocating huge amounts of memory if a length is corrupt.
+const std::size_t READ_CHUNK_SIZE{1024 * 1024};
+
+//! The maximum number of bytes in a 64 bit varint.
+const std::size_t MAX_VARINT_BYTES{10};
+
+//! Used to read varints outside the document body.
+const std::size_t NO_LIMIT{std::numeric_limits<std::size_t>::max()};
+
+//! The number of bytes in a persisted double.
+const std::size_t DOUBLE_BYTES{8};
+
+//! The number of bytes in a persisted float.
+const std::size_t FLOAT_BYTES{4};
+}
+
+CBinaryStateRestoreTraverser::CBinaryStateRestoreTraverser(std::istream& inputStream)
+    : m_ReadStream(inputStream) {
+}
+
+bool CBinaryStateRestoreTraverser::isBinaryState(std::istream& inputStream) {
+    return inputStream.peek() ==
+           std::char_traits<char>::to_int_type(TInserter::MARKER[0]);
+}
+
+bool CBinaryStateRestoreTraverser::next() {
+    if (m_Started == false && this->start() == false) {
+        return false;
+    }
+    if (this->haveBadState() || m_Current.s_Valid == false) {
+        return false;
+    }
+    if (m_Current.s_ValueEnd >= m_LevelEnd) {
+        // Consume the rest of the document at the end of the top level
+        // so the stream is positioned at any document which follows.
+        if (m_Levels.empty()) {
+            this->skipTo(m_BodyLength);
+        }
+        return false;
+    }
+    return this->skipTo(m_Current.s_ValueEnd) && this->readElement();
+}
+
+bool CBinaryStateRestoreTraverser::hasSubLevel() const {
+    if (m_Started == false &&
+        const_cast<CBinaryStateRestoreTraverser*>(this)->start() == false) {
+        return false;
+    }
+    return this->haveBadState() == false && m_Current.s_Valid &&
+           m_Current.s_Type == TInserter::E_Level;
+}
+
+const std::string& CBinaryStateRestoreTraverser::name() const {
+    if (m_Started == false &&
+        const_cast<CBinaryStateRestoreTraverser*>(this)->start() == false) {
+        return EMPTY_STRING;
+    }
+    if (this->haveBadState() || m_Current.s_Valid == false) {
+        return EMPTY_STRING;
+    }
+    return m_Names[m_Current.s_Name];
+}
+
+const std::string& CBinaryStateRestoreTraverser::value() const {
+    if (m_Started == false &&
+        const_cast<CBinaryStateRestoreTraverser*>(this)->start() == false) {
+        return EMPTY_STRING;
+    }
+    if (this->haveBadState() || m_Current.s_Valid == false) {
+        return EMPTY_STRING;
+    }
+    if (m_IsValueCacheValid) {
+        return m_CachedValue;
+    }
+
+    switch (m_Current.s_Type) {
+    case TInserter::E_String:
+        m_CachedValue = m_Value;
+        break;
+    case TInserter::E_Level:
+        m_CachedValue.clear();
+        break;
+    case TInserter::E_HalfPrecisionDouble:
+        m_CachedValue = CStringUtils::typeToStringPrecise(this->readDouble(),
+                                                          CIEEE754::E_HalfPrecision);
+        break;
+    case TInserter::E_SinglePrecisionDouble:
+        m_CachedValue = CStringUtils::typeToStringPrecise(
+            this->readDouble(), CIEEE754::E_SinglePrecision);
+        break;
+    case TInserter::E_DoublePrecisionDouble:
+        m_CachedValue = CStringUtils::typeToStringPrecise(
+            this->readDouble(), CIEEE754::E_DoublePrecision);
+        break;
+    case TInserter::E_SinglePrecisionArray: {
+        // This matches the string CPersistUtils::toString creates.
+        m_CachedValue.clear();
+        for (std::size_t i = 0; i < m_Current.s_Count; ++i) {
+            if (i > 0) {
+                m_CachedValue += CPersistUtils::DELIMITER;
+            }
+            m_CachedValue += CFloatStorage{this->readFloat(i * FLOAT_BYTES)}.toString();
+        }
+        break;
+    }
+    default:
+        m_CachedValue.clear();
+        break;
+    }
+    m_IsValueCacheValid = true;
+    return m_CachedValue;
+}
+
+bool CBinaryStateRestoreTraverser::floatValues(TFloatStorageVec& result) const {
+    if (m_Started == false &&
+        const_cast<CBinaryStateRestoreTraverser*>(this)->start() == false) {
+        return false;
+    }
+    if (this->haveBadState() || m_Current.s_Valid == false) {
+        return false;
+    }
+    if (m_Current.s_Type != TInserter::E_SinglePrecisionArray) {
+        return this->CStateRestoreTraverser::floatValues(result);
+    }
+    result.resize(m_Current.s_Count);
+    for (std::size_t i = 0; i < m_Current.s_Count; ++i) {
+        result[i] = this->readFloat(i * FLOAT_BYTES);
+    }
+    return true;
+}
+
+bool CBinaryStateRestoreTraverser::doubleValue(double& result) const {
+    if (m_Started == false &&
+        const_cast<CBinaryStateRestoreTraverser*>(this)->start() == false) {
+        return false;
+    }
+    if (this->haveBadState() || m_Current.s_Valid == false) {
+        return false;
+    }
+    switch (m_Current.s_Type) {
+    case TInserter::E_HalfPrecisionDouble:
+    case TInserter::E_SinglePrecisionDouble:
+    case TInserter::E_DoublePrecisionDouble:
+        result = this->readDouble();
+        return true;
+    default:
+        break;
+    }
+    return this->CStateRestoreTraverser::doubleValue(result);
+}
+
+bool CBinaryStateRestoreTraverser::isEof() const {
+    return m_ReadStream.peek() == std::char_traits<char>::eof();
+}
+
+bool CBinaryStateRestoreTraverser::descend() {
+    if (this->hasSubLevel() == false) {
+        return false;
+    }
+    if (m_Position != m_Current.s_ValueBegin) {
+        // The stream can't be rewound to read the sub-level again.
+        return this->fail("Can't traverse '" + m_Names[m_Current.s_Name] + "' twice");
+    }
+    m_Levels.emplace_back(m_Current, m_LevelEnd);
+    m_LevelEnd = m_Current.s_ValueEnd;
+    if (m_Current.s_ValueBegin == m_Current.s_ValueEnd) {
+        // Set the current element to be empty so the sub-level traverser
+        // will find nothing and then ascend.
+        m_Current = SElement{};
+        m_IsValueCacheValid = false;
+        return true;
+    }
+    return this->readElement();
+}
+
+bool CBinaryStateRestoreTraverser::ascend() {
+    if (m_Levels.empty()) {
+        return false;
+    }
+    // Any of the sub-level which wasn't read is skipped by the next call
+    // to next().
+    std::tie(m_Current, m_LevelEnd) = m_Levels.back();
+    m_Levels.pop_back();
+    m_Value.clear();
+    m_IsValueCacheValid = false;
+    return this->haveBadState() == false;
+}
+
+bool CBinaryStateRestoreTraverser::start() {
+    m_Started = true;
+
+    std::string marker(TInserter::MARKER.size(), '\0');
+    m_ReadStream.read(&marker[0], static_cast<std::streamsize>(marker.size()));
+    if (m_ReadStream.gcount() != static_cast<std::streamsize>(marker.size()) ||
+        marker != TInserter::MARKER) {
+        return this->fail("Missing binary state marker");
+    }
+    int version{m_ReadStream.get()};
+    if (version != TInserter::VERSION) {
+        return this->fail("Unsupported binary state version " +
+                          CStringUtils::typeToString(version));
+    }
+
+    std::uint64_t numberNames;
+    if (this->readVarint(numberNames, NO_LIMIT) == false) {
+        return this->fail("Failed to read number of names");
+    }
+    m_Names.clear();
+    for (std::uint64_t i = 0; i < numberNames; ++i) {
+        std::uint64_t length;
+        m_Names.emplace_back();
+        if (this->readVarint(length, NO_LIMIT) == false ||
+            this->readBytes(length, m_Names.back()) == false) {
+            return this->fail("Failed to read name " + CStringUtils::typeToString(i));
+        }
+    }
+
+    std::uint64_t bodyLength;
+    if (this->readVarint(bodyLength, NO_LIMIT) == false ||
+        bodyLength > static_cast<std::uint64_t>(NO_LIMIT)) {
+        return this->fail("Failed to read state body length");
+    }
+    LOG_TRACE(<< "Read " << m_Names.size() << " names for " << bodyLength << " bytes");
+
+    m_BodyLength = static_cast<std::size_t>(bodyLength);
+    m_Position = 0;
+    m_LevelEnd = m_BodyLength;
+    return m_BodyLength == 0 || this->readElement();
+}
+
+bool CBinaryStateRestoreTraverser::readElement() {
+    m_IsValueCacheValid = false;
+    m_Value.clear();
+
+    std::uint64_t header;
+    if (this->readVarint(header, m_LevelEnd - m_Position) == false) {
+        return this->fail("Failed to read element header");
+    }
+    m_Current.s_Valid = true;
+    m_Current.s_Name = static_cast<std::size_t>(header >> TInserter::TYPE_BITS);
+    m_Current.s_Type = header & ((1 << TInserter::TYPE_BITS) - 1);
+    if (m_Current.s_Name >= m_Names.size()) {
+        return this->fail("Bad name index " + CStringUtils::typeToString(m_Current.s_Name));
+    }
+
+    std::uint64_t length{0};
+    m_Current.s_Count = 0;
+    switch (m_Current.s_Type) {
+    case TInserter::E_String:
+    case TInserter::E_Level:
+        if (this->readVarint(length, m_LevelEnd - m_Position) == false) {
+            return this->fail("Failed to read length of '" + m_Names[m_Current.s_Name] + "'");
+        }
+        break;
+    case TInserter::E_HalfPrecisionDouble:
+    case TInserter::E_SinglePrecisionDouble:
+    case TInserter::E_DoublePrecisionDouble:
+        length = DOUBLE_BYTES;
+        break;
+    case TInserter::E_SinglePrecisionArray:
+        if (this->readVarint(length, m_LevelEnd - m_Position) == false ||
+            length > (m_LevelEnd - m_Position) / FLOAT_BYTES) {
+            return this->fail("Failed to read count of '" + m_Names[m_Current.s_Name] + "'");
+        }
+        m_Current.s_Count = static_cast<std::size_t>(length);
+        length *= FLOAT_BYTES;
+        break;
+    default:
+        return this->fail("Bad type " + CStringUtils::typeToString(m_Current.s_Type) +
+                          " for '" + m_Names[m_Current.s_Name] + "'");
+    }
+    if (length > m_LevelEnd - m_Position) {
+        return this->fail("Value of '" + m_Names[m_Current.s_Name] + "' overruns its level");
+    }
+    m_Current.s_ValueBegin = m_Position;
+    m_Current.s_ValueEnd = m_Position + static_cast<std::size_t>(length);
+
+    // Sub-levels are read as they're traversed.
+    if (m_Current.s_Type != TInserter::E_Level && this->readBytes(length, m_Value) == false) {
+        return this->fail("Failed to read value of '" + m_Names[m_Current.s_Name] + "'");
+    }
+    return true;
+}
+
+bool CBinaryStateRestoreTraverser::skipTo(std::size_t end) {
+    while (m_Position < end) {
+        std::size_t chunk{std::min(end - m_Position, READ_CHUNK_SIZE)};
+        m_ReadStream.ignore(static_cast<std::streamsize>(chunk));
+        m_Position += static_cast<std::size_t>(m_ReadStream.gcount());
+        if (m_ReadStream.good() == false) {
+            return m_Position >= end || this->fail("State body is truncated");
+        }
+    }
+    return true;
+}
+
+bool CBinaryStateRestoreTraverser::readBytes(std::uint64_t length, std::string& result) {
+    result.clear();
+    while (result.size() < length && m_ReadStream.good()) {
+        std::size_t offset{result.size()};
+        std::size_t chunk{static_cast<std::size_t>(
+            std::min(length - offset, static_cast<std::uint64_t>(READ_CHUNK_SIZE)))};
+        result.resize(offset + chunk);
+        m_ReadStream.read(&result[offset], static_cast<std::streamsize>(chunk));
+        std::size_t count{static_cast<std::size_t>(m_ReadStream.gcount())};
+        result.resize(offset + count);
+        m_Position += count;
+    }
+    return result.size() == length;
+}
+
+bool CBinaryStateRestoreTraverser::readVarint(std::uint64_t& value, std::size_t limit) {
+    value = 0;
+    for (std::size_t i = 0; i < std::min(MAX_VARINT_BYTES, limit); ++i) {
+        int byte{m_ReadStream.get()};
+        if (byte == std::char_traits<char>::eof()) {
+            return false;
+        }
+        ++m_Position;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+double CBinaryStateRestoreTraverser::readDouble() const {
+    std::uint64_t bits{0};
+    for (std::size_t i = DOUBLE_BYTES; i > 0; --i) {
+        bits = (bits << 8) | static_cast<unsigned char>(m_Value[i - 1]);
+    }
+    double result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+float CBinaryStateRestoreTraverser::readFloat(std::size_t position) const {
+    std::uint32_t bits{0};
+    for (std::size_t i = FLOAT_BYTES; i > 0; --i) {
+        bits = (bits << 8) | static_cast<unsigned char>(m_Value[position + i - 1]);
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+bool CBinaryStateRestoreTraverser::fail(const std::string& error) {
+    LOG_ERROR(<< "Restoration failed: " << error);
+    m_Current = SElement{};
+    m_Value.clear();
+    this->setBadState();
+    return false;
+}
+}
+}
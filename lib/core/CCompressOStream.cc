@@ -13,16 +13,33 @@
 
 #include <core/CBase64Filter.h>
 #include <core/CLoggerTrace.h>
+#include <core/Concurrency.h>
 
+#include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 
+#include <exception>
 #include <iostream>
 
 namespace ml {
 namespace core {
+namespace {
+//! The size of the blocks which are compressed independently. This is large
+//! compared to the deflate window so there is minimal loss of compression.
+const std::size_t BLOCK_SIZE{1024 * 1024};
 
-CCompressOStream::CCompressOStream(CStateCompressor::CChunkFilter& filter)
-    : std::ostream(&m_StreamBuf), m_UploadThread(*this, m_StreamBuf, filter) {
+//! The size of the buffer in front of the chunk filter. Each write to the
+//! filter becomes one string in the compressed array of the current document
+//! so we coalesce the encoder's small writes to reduce framing and the number
+//! of writes to the downstream store. This must be smaller than the chunk
+//! buffer of CStateDecompressor.
+const std::streamsize CHUNK_FILTER_BUFFER_SIZE{256 * 1024};
+}
+
+CCompressOStream::CCompressOStream(CStateCompressor::CChunkFilter& filter,
+                                   TCompressBlockFunc compressBlock)
+    : std::ostream(&m_StreamBuf),
+      m_UploadThread(*this, m_StreamBuf, filter, std::move(compressBlock)) {
 
     if (m_UploadThread.start() == false) {
         this->setstate(std::ios_base::failbit | std::ios_base::badbit);
@@ -36,44 +53,121 @@ CCompressOStream::~CCompressOStream() {
 void CCompressOStream::close() {
     if (m_UploadThread.isStarted()) {
         LOG_TRACE(<< "Thread has been started, so stopping it");
-        if (m_UploadThread.stop() == false) {
+        if (m_UploadThread.stop() == false || m_UploadThread.hasFailed()) {
             this->setstate(std::ios_base::failbit | std::ios_base::badbit);
         }
     }
 }
 
+void CCompressOStream::gzipBlock(const std::string& input, std::string& output) {
+    boost::iostreams::filtering_ostream compressor;
+    compressor.push(boost::iostreams::gzip_compressor());
+    compressor.push(boost::iostreams::back_inserter(output));
+    compressor.write(input.data(), input.size());
+    boost::iostreams::close(compressor);
+}
+
 CCompressOStream::CCompressThread::CCompressThread(CCompressOStream& stream,
                                                    CDualThreadStreamBuf& streamBuf,
-                                                   CStateCompressor::CChunkFilter& filter)
-    : m_Stream(stream), m_StreamBuf(streamBuf), m_FilterSink(filter), m_OutFilter() {
-    m_OutFilter.push(boost::iostreams::gzip_compressor());
+                                                   CStateCompressor::CChunkFilter& filter,
+                                                   TCompressBlockFunc compressBlock)
+    : m_Stream(stream), m_StreamBuf(streamBuf), m_FilterSink(filter),
+      m_OutFilter(), m_CompressBlock(std::move(compressBlock)) {
     m_OutFilter.push(CBase64Encoder());
-    m_OutFilter.push(boost::ref(m_FilterSink));
+    m_OutFilter.push(boost::ref(m_FilterSink), CHUNK_FILTER_BUFFER_SIZE);
 }
 
 void CCompressOStream::CCompressThread::run() {
     LOG_TRACE(<< "CompressThread run");
 
+    // Bound the memory used by blocks waiting to be written.
+    std::size_t maximumBlocksInFlight{defaultAsyncExecutor().numberThreadsInUse() + 1};
+
     char buf[4096];
     std::size_t bytesDone = 0;
+    std::string block;
+    block.reserve(BLOCK_SIZE);
     bool closeMe = false;
     while (closeMe == false) {
         std::streamsize n = m_StreamBuf.sgetn(buf, 4096);
         LOG_TRACE(<< "Read from in stream: " << n);
         if (n != -1) {
             bytesDone += n;
-            m_OutFilter.write(buf, n);
+            block.append(buf, n);
+        }
+
+        if (block.size() >= BLOCK_SIZE) {
+            if (m_Blocks.size() >= maximumBlocksInFlight) {
+                this->writeOldestBlock();
+            }
+            this->compressInBackground(std::move(block));
+            block.clear();
+            block.reserve(BLOCK_SIZE);
         }
 
         if (m_StreamBuf.endOfFile() && (m_StreamBuf.in_avail() == 0)) {
             closeMe = true;
         }
     }
+
+    // We always write at least one block so empty input produces a valid
+    // gzip stream.
+    if (block.empty() == false || m_Blocks.empty()) {
+        this->compressInBackground(std::move(block));
+    }
+    while (m_Blocks.empty() == false) {
+        this->writeOldestBlock();
+    }
+
     LOG_TRACE(<< "CompressThread complete, written: " << bytesDone << ", bytes");
     SUPPRESS_USAGE_WARNING(bytesDone);
     boost::iostreams::close(m_OutFilter);
 }
 
+void CCompressOStream::CCompressThread::compressInBackground(std::string input) {
+    auto block = std::make_shared<SBlock>(std::move(input), m_CompressBlock);
+    m_Blocks.push_back(block);
+    defaultAsyncExecutor().schedule([block]() { block->compress(); });
+}
+
+bool CCompressOStream::CCompressThread::hasFailed() const {
+    return m_Failed;
+}
+
+void CCompressOStream::CCompressThread::writeOldestBlock() {
+    auto block = std::move(m_Blocks.front());
+    m_Blocks.pop_front();
+    block->compress();
+    try {
+        // This rethrows any exception compressing the block.
+        block->s_Compressed.get_future().get();
+    } catch (const std::exception& e) {
+        LOG_ERROR(<< "Failed to compress state: " << e.what());
+        m_Failed = true;
+    }
+    // We have to keep consuming the input so the writer doesn't block, but
+    // we stop writing at the first failure because the output is corrupt.
+    if (m_Failed == false) {
+        m_OutFilter.write(block->s_Output.data(), block->s_Output.size());
+    }
+}
+
+bool CCompressOStream::CCompressThread::SBlock::compress() {
+    if (s_Claimed.exchange(true)) {
+        return false;
+    }
+    try {
+        s_CompressBlock(s_Input, s_Output);
+        s_Input.clear();
+        s_Input.shrink_to_fit();
+        s_Compressed.set_value();
+    } catch (...) {
+        // Otherwise writeOldestBlock would wait forever for the block.
+        s_Compressed.set_exception(std::current_exception());
+    }
+    return true;
+}
+
 void CCompressOStream::CCompressThread::shutdown() {
     m_StreamBuf.signalEndOfFile();
     LOG_TRACE(<< "CompressThread shutdown called");
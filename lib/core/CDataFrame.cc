@@ -287,53 +287,6 @@ void CDataFrame::parseAndWriteRow(const TStrCRng& columnValues,
                                   const TPtrdiffVec* columnMap,
                                   const std::string* hash) {
 
-    auto stringToValue = [this](bool isCategorical, TStrSizeUMap& categoryLookup,
-                                TStrVec& categories, const std::string& columnValue) {
-        if (columnValue == m_MissingString) {
-            ++m_MissingValueCount;
-            return core::CFloatStorage{valueOfMissing()};
-        }
-
-        if (isCategorical) {
-            // This encodes in a format suitable for efficient storage. The
-            // actual encoding approach is chosen when the analysis runs.
-            std::size_t id;
-            if (categories.size() == MAX_CATEGORICAL_CARDINALITY) {
-                auto itr = categoryLookup.find(columnValue);
-                id = itr != categoryLookup.end()
-                         ? itr->second
-                         : static_cast<std::int64_t>(MAX_CATEGORICAL_CARDINALITY);
-            } else {
-                // We can represent up to float mantissa bits - 1 distinct
-                // categories so can faithfully store categorical fields with
-                // up to around 17M distinct values. For higher cardinalities
-                // one would need to use some form of dimension reduction such
-                // as hashing anyway.
-                std::size_t newId{categories.size()};
-                id = categoryLookup.emplace(columnValue, newId).first->second;
-                if (id == newId) {
-                    categories.push_back(columnValue);
-                }
-            }
-            return core::CFloatStorage{static_cast<double>(id)};
-        }
-
-        // Use NaN to indicate missing or bad values in the data frame. This
-        // needs handling with care from an analysis perspective. If analyses
-        // can deal with missing values they need to treat NaNs as missing
-        // otherwise we must impute or exit with failure.
-
-        double value;
-        if (core::CStringUtils::stringToTypeSilent(columnValue, value) == false) {
-            ++m_BadValueCount;
-            return core::CFloatStorage{valueOfMissing()};
-        }
-
-        // Tuncation is very unlikely since the values will typically be
-        // standardised.
-        return truncateToFloatRange(value);
-    };
-
     // This is only used when writing rows so is resized lazily.
     if (m_CategoricalColumnValueLookup.size() != m_NumberColumns) {
         this->fillCategoricalColumnValueLookup();
@@ -343,16 +296,18 @@ void CDataFrame::parseAndWriteRow(const TStrCRng& columnValues,
         if (columnMap != nullptr) {
             for (std::size_t i = 0; i < columnMap->size(); ++i, ++columns) {
                 std::ptrdiff_t j{(*columnMap)[i]};
-                *columns = stringToValue(m_ColumnIsCategorical[i],
-                                         m_CategoricalColumnValueLookup[i],
-                                         m_CategoricalColumnValues[i],
-                                         j >= 0 ? columnValues[j] : m_MissingString);
+                *columns = this->parseValue(
+                    m_ColumnIsCategorical[i], m_CategoricalColumnValueLookup[i],
+                    m_CategoricalColumnValues[i],
+                    j >= 0 ? columnValues[j] : m_MissingString,
+                    m_MissingValueCount, m_BadValueCount);
             }
         } else {
             for (std::size_t i = 0; i < columnValues.size(); ++i, ++columns) {
-                *columns = stringToValue(
+                *columns = this->parseValue(
                     m_ColumnIsCategorical[i], m_CategoricalColumnValueLookup[i],
-                    m_CategoricalColumnValues[i], columnValues[i]);
+                    m_CategoricalColumnValues[i], columnValues[i],
+                    m_MissingValueCount, m_BadValueCount);
             }
         }
         docHash = 0;
@@ -363,6 +318,97 @@ void CDataFrame::parseAndWriteRow(const TStrCRng& columnValues,
     });
 }
 
+void CDataFrame::parseAndWriteRows(const TStrCRngVec& rows,
+                                   const TPtrdiffVec* columnMap,
+                                   const TStrCPtrVec* hashes) {
+
+    std::size_t numberThreads{defaultAsyncThreadPoolSize()};
+    if (numberThreads < 2 || rows.size() < 2 * numberThreads) {
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            this->parseAndWriteRow(rows[i], columnMap,
+                                   hashes != nullptr ? (*hashes)[i] : nullptr);
+        }
+        return;
+    }
+
+    // This is only used when writing rows so is resized lazily.
+    if (m_CategoricalColumnValueLookup.size() != m_NumberColumns) {
+        this->fillCategoricalColumnValueLookup();
+    }
+
+    std::size_t numberColumns{columnMap != nullptr ? columnMap->size()
+                                                   : rows[0].size()};
+    auto columnValue = [&](std::size_t row, std::size_t column) -> const std::string& {
+        if (columnMap != nullptr) {
+            std::ptrdiff_t j{(*columnMap)[column]};
+            return j >= 0 ? rows[row][j] : m_MissingString;
+        }
+        return rows[row][column];
+    };
+
+    TSizeVec categoricalColumns;
+    for (std::size_t i = 0; i < numberColumns; ++i) {
+        if (m_ColumnIsCategorical[i]) {
+            categoricalColumns.push_back(i);
+        }
+    }
+
+    // Tasks [0, # categorical columns) each parse one categorical column and
+    // the remaining tasks each parse the other columns of a range of rows.
+    std::size_t numberRowRanges{numberThreads};
+    std::size_t numberTasks{categoricalColumns.size() + numberRowRanges};
+    TFloatVec values(rows.size() * numberColumns);
+
+    using TUInt64UInt64Pr = std::pair<std::uint64_t, std::uint64_t>;
+    auto results = parallel_for_each(
+        0, numberTasks,
+        bindRetrievableState(
+            [&](TUInt64UInt64Pr& counts, std::size_t task) {
+                if (task < categoricalColumns.size()) {
+                    std::size_t i{categoricalColumns[task]};
+                    for (std::size_t row = 0; row < rows.size(); ++row) {
+                        values[row * numberColumns + i] = this->parseValue(
+                            true, m_CategoricalColumnValueLookup[i],
+                            m_CategoricalColumnValues[i], columnValue(row, i),
+                            counts.first, counts.second);
+                    }
+                    return;
+                }
+                std::size_t range{task - categoricalColumns.size()};
+                std::size_t beginRows{range * rows.size() / numberRowRanges};
+                std::size_t endRows{(range + 1) * rows.size() / numberRowRanges};
+                for (std::size_t row = beginRows; row < endRows; ++row) {
+                    for (std::size_t i = 0; i < numberColumns; ++i) {
+                        if (m_ColumnIsCategorical[i] == false) {
+                            // The lookup and categories aren't used for
+                            // metric columns.
+                            values[row * numberColumns + i] = this->parseValue(
+                                false, m_CategoricalColumnValueLookup[i],
+                                m_CategoricalColumnValues[i], columnValue(row, i),
+                                counts.first, counts.second);
+                        }
+                    }
+                }
+            },
+            TUInt64UInt64Pr{0, 0}));
+
+    for (const auto& result : results) {
+        m_MissingValueCount += result.s_FunctionState.first;
+        m_BadValueCount += result.s_FunctionState.second;
+    }
+
+    for (std::size_t row = 0; row < rows.size(); ++row) {
+        this->writeRow([&](TFloatVecItr columns, std::int32_t& docHash) {
+            std::copy_n(values.begin() + row * numberColumns, numberColumns, columns);
+            docHash = 0;
+            if (hashes != nullptr && (*hashes)[row] != nullptr &&
+                core::CStringUtils::stringToTypeSilent(*(*hashes)[row], docHash) == false) {
+                ++m_BadDocHashCount;
+            }
+        });
+    }
+}
+
 void CDataFrame::writeRow(const TWriteFunc& writeRow) {
     if (m_Writer == nullptr) {
         m_Writer = std::make_unique<CDataFrameRowSliceWriter>(
@@ -514,6 +560,57 @@ std::size_t CDataFrame::estimateMemoryUsage(bool inMainMemory,
     return estimatedMemoryUsage + additionalMemory;
 }
 
+CFloatStorage CDataFrame::parseValue(bool isCategorical,
+                                     TStrSizeUMap& categoryLookup,
+                                     TStrVec& categories,
+                                     const std::string& columnValue,
+                                     std::uint64_t& missingValueCount,
+                                     std::uint64_t& badValueCount) const {
+    if (columnValue == m_MissingString) {
+        ++missingValueCount;
+        return CFloatStorage{valueOfMissing()};
+    }
+
+    if (isCategorical) {
+        // This encodes in a format suitable for efficient storage. The
+        // actual encoding approach is chosen when the analysis runs.
+        std::size_t id;
+        if (categories.size() == MAX_CATEGORICAL_CARDINALITY) {
+            auto itr = categoryLookup.find(columnValue);
+            id = itr != categoryLookup.end()
+                     ? itr->second
+                     : static_cast<std::int64_t>(MAX_CATEGORICAL_CARDINALITY);
+        } else {
+            // We can represent up to float mantissa bits - 1 distinct
+            // categories so can faithfully store categorical fields with
+            // up to around 17M distinct values. For higher cardinalities
+            // one would need to use some form of dimension reduction such
+            // as hashing anyway.
+            std::size_t newId{categories.size()};
+            id = categoryLookup.emplace(columnValue, newId).first->second;
+            if (id == newId) {
+                categories.push_back(columnValue);
+            }
+        }
+        return CFloatStorage{static_cast<double>(id)};
+    }
+
+    // Use NaN to indicate missing or bad values in the data frame. This
+    // needs handling with care from an analysis perspective. If analyses
+    // can deal with missing values they need to treat NaNs as missing
+    // otherwise we must impute or exit with failure.
+
+    double value;
+    if (CStringUtils::stringToTypeSilent(columnValue, value) == false) {
+        ++badValueCount;
+        return CFloatStorage{valueOfMissing()};
+    }
+
+    // Tuncation is very unlikely since the values will typically be
+    // standardised.
+    return truncateToFloatRange(value);
+}
+
 void CDataFrame::fillCategoricalColumnValueLookup() {
     m_CategoricalColumnValueLookup.clear();
     m_CategoricalColumnValueLookup.resize(m_NumberColumns);
@@ -545,6 +642,7 @@ bool CDataFrame::parallelApplyToAllRows(std::size_t beginRows,
 
     std::atomic_bool successful{true};
     CDataFrameRowSliceHandle readSlice;
+    auto endSlices = this->endSlices(endRows);
 
     TSliceFuncVec sliceFuncs;
     sliceFuncs.reserve(funcs.size());
@@ -571,6 +669,9 @@ bool CDataFrame::parallelApplyToAllRows(std::size_t beginRows,
                 return;
             }
 
+            // Slices are always passed by reference to elements of m_Slices.
+            this->prefetchSlice(m_Slices.begin() + (&slice - m_Slices.data()) + 1, endSlices);
+
             TOptionalPopMaskedRow popMaskedRow;
             if (rowMask != nullptr) {
                 beginSliceRows = *maskedRow;
@@ -585,7 +686,7 @@ bool CDataFrame::parallelApplyToAllRows(std::size_t beginRows,
         });
     }
 
-    parallel_for_each(this->beginSlices(beginRows), this->endSlices(endRows), sliceFuncs);
+    parallel_for_each(this->beginSlices(beginRows), endSlices, sliceFuncs);
 
     return successful.load();
 }
@@ -633,6 +734,7 @@ bool CDataFrame::sequentialApplyToAllRows(std::size_t beginRows,
             if (readSlice.bad()) {
                 return false;
             }
+            this->prefetchSlice(slice + 1, endSlices);
 
             // We wait here so at most one slice is copied into memory.
             wait_for_valid(backgroundApply);
@@ -675,6 +777,7 @@ bool CDataFrame::sequentialApplyToAllRows(std::size_t beginRows,
             if (readSlice.bad()) {
                 return false;
             }
+            this->prefetchSlice(slice + 1, endSlices);
 
             TOptionalPopMaskedRow popMaskedRow;
             if (rowMask != nullptr) {
@@ -718,6 +821,12 @@ void CDataFrame::applyToRowsOfOneSlice(TRowFunc& func,
                       slice.beginDocHashes() + offsetOfEndRowsToRead, popMaskedRow});
 }
 
+void CDataFrame::prefetchSlice(TRowSlicePtrVecCItr slice, TRowSlicePtrVecCItr end) const {
+    if (m_InMainMemory == false && slice < end) {
+        (*slice)->prefetch();
+    }
+}
+
 CDataFrame::TRowSlicePtrVecCItr CDataFrame::beginSlices(std::size_t beginRows) const {
     return std::upper_bound(m_Slices.begin(), m_Slices.end(), beginRows,
                             [](std::size_t row, const TRowSlicePtr& slice) {
@@ -19,11 +19,18 @@
 #include <core/CompressUtils.h>
 
 #include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 
+#include <cerrno>
+#include <cstring>
 #include <fstream>
 #include <memory>
 #include <vector>
 
+#ifndef Windows
+#include <sys/mman.h>
+#endif
+
 namespace ml {
 namespace core {
 using TFloatVec = std::vector<CFloatStorage, CAlignedAllocator<CFloatStorage>>;
@@ -377,6 +384,29 @@ void COnDiskDataFrameRowSlice::write(const TFloatVec& rows, const TInt32Vec& doc
     this->writeToDisk(rows, docHashes);
 }
 
+void COnDiskDataFrameRowSlice::prefetch() const {
+#ifndef Windows
+    // Advising the kernel that a file mapping will be needed only initiates
+    // the read, which it performs asynchronously, so this doesn't block the
+    // calling thread. The pages stay in the page cache after we unmap. Note
+    // that we map the whole file because the slice may be being written
+    // concurrently, so its capacities aren't safe to read here.
+    boost::iostreams::mapped_file_source file;
+    try {
+        file.open(m_FileName.string());
+    } catch (const std::exception& e) {
+        LOG_DEBUG(<< "Failed to map " << m_FileName << " for prefetch: '"
+                  << e.what() << "'");
+        return;
+    }
+    if (file.is_open() && file.size() > 0 &&
+        ::madvise(const_cast<char*>(file.data()), file.size(), MADV_WILLNEED) == -1) {
+        LOG_DEBUG(<< "Failed to prefetch " << m_FileName << ": '"
+                  << std::strerror(errno) << "'");
+    }
+#endif
+}
+
 std::size_t COnDiskDataFrameRowSlice::staticSize() const {
     return sizeof(*this);
 }
@@ -416,10 +446,39 @@ bool COnDiskDataFrameRowSlice::readFromDisk(TFloatVec& rows, TInt32Vec& docHashe
     LOG_TRACE(<< "rows bytes = " << rowsBytes);
     LOG_TRACE(<< "doc hashes bytes = " << docHashesBytes);
 
-    std::ifstream file{m_FileName.string(), std::ios_base::binary};
-    file.read(reinterpret_cast<char*>(rows.data()), rowsBytes);
-    file.read(reinterpret_cast<char*>(docHashes.data()), docHashesBytes);
-    return file.bad() == false;
+    if (rowsBytes + docHashesBytes == 0) {
+        return true;
+    }
+
+    // Mapping the file avoids an intermediate copy through the stream buffer
+    // and lets the kernel read ahead aggressively. We map the whole file so a
+    // truncated file is detected here rather than faulting when we copy past
+    // its end.
+    boost::iostreams::mapped_file_source file;
+    try {
+        file.open(m_FileName.string());
+    } catch (const std::exception& e) {
+        LOG_ERROR(<< "Failed to map " << m_FileName << ": '" << e.what() << "'");
+        return false;
+    }
+    if (file.is_open() == false) {
+        return false;
+    }
+    if (file.size() < rowsBytes + docHashesBytes) {
+        LOG_ERROR(<< "Expected " << rowsBytes + docHashesBytes << " bytes in "
+                  << m_FileName << " but only found " << file.size());
+        return false;
+    }
+
+#ifndef Windows
+    if (::madvise(const_cast<char*>(file.data()), file.size(), MADV_SEQUENTIAL) == -1) {
+        LOG_DEBUG(<< "Failed to advise sequential access to " << m_FileName
+                  << ": '" << std::strerror(errno) << "'");
+    }
+#endif
+    std::memcpy(rows.data(), file.data(), rowsBytes);
+    std::memcpy(docHashes.data(), file.data() + rowsBytes, docHashesBytes);
+    return true;
 }
 }
 }
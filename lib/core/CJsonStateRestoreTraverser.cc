@@ -19,6 +19,8 @@
 // using basic_parser to implement a parser.
 #include <boost/json/basic_parser_impl.hpp>
 
+#include <algorithm>
+
 namespace json = boost::json;
 
 namespace ml {
@@ -229,10 +231,9 @@ const std::string& CJsonStateRestoreTraverser::nextValue() const {
 }
 
 bool CJsonStateRestoreTraverser::parseNext(bool remember) {
-    bool ret{true};
-    m_Handler.s_HaveCompleteToken = false;
-    do {
-        m_Handler.s_RememberValue = remember;
+    m_Handler.s_RememberValue = remember;
+    while (m_Handler.popToken() == false) {
+        m_Handler.resetArena();
 
         if (m_BytesRemaining == 0) {
             ::memset(m_Buffer, '\0', BUFFER_SIZE);
@@ -250,18 +251,20 @@ bool CJsonStateRestoreTraverser::parseNext(bool remember) {
         }
 
         json::error_code ec;
-        char c = *m_BufferPtr;
-        std::size_t written = m_Reader.write_some(true, &c, 1, ec);
+        std::size_t written = m_Reader.write_some(true, m_BufferPtr, m_BytesRemaining, ec);
         if (ec) {
             this->logError();
-            ret = false;
-            break;
+            return false;
+        }
+        if (written == 0) {
+            // The document is complete so skip any trailing characters.
+            m_BytesRemaining = 0;
         }
-        m_BytesRemaining -= written;
-        m_BufferPtr++;
-    } while (m_Handler.s_HaveCompleteToken == false);
+        m_BytesRemaining -= std::min(written, m_BytesRemaining);
+        m_BufferPtr += written;
+    }
 
-    return ret;
+    return true;
 }
 
 bool CJsonStateRestoreTraverser::skipArray() {
@@ -363,108 +366,157 @@ CJsonStateRestoreTraverser::SBoostJsonHandler::SBoostJsonHandler()
     s_IsEndOfLevel[1] = false;
 }
 
+void CJsonStateRestoreTraverser::SBoostJsonHandler::pushToken(ETokenType type,
+                                                              std::size_t begin) {
+    s_Tokens.push_back(SToken{type, begin, s_Arena.size()});
+}
+
+void CJsonStateRestoreTraverser::SBoostJsonHandler::appendPart(std::string_view s) {
+    if (s_InPart == false) {
+        s_InPart = true;
+        s_PartBegin = s_Arena.size();
+    }
+    s_Arena.append(s);
+}
+
+bool CJsonStateRestoreTraverser::SBoostJsonHandler::popToken() {
+    if (s_NextToken == s_Tokens.size()) {
+        return false;
+    }
+
+    const SToken& token{s_Tokens[s_NextToken++]};
+    std::string_view chars{s_Arena.data() + token.s_Begin, token.s_End - token.s_Begin};
+    s_Type = token.s_Type;
+
+    if (s_RememberValue) {
+        switch (s_Type) {
+        case E_TokenBool:
+        case E_TokenInt64:
+        case E_TokenUInt64:
+        case E_TokenDouble:
+        case E_TokenString:
+            s_Value[s_NextIndex].assign(chars);
+            break;
+        case E_TokenObjectStart:
+            ++s_Level[s_NextIndex];
+            s_Value[s_NextIndex].clear();
+            break;
+        case E_TokenKey:
+            s_NextIndex = 1 - s_NextIndex;
+            s_Name[s_NextIndex].assign(chars);
+            s_Level[s_NextIndex] = s_Level[1 - s_NextIndex];
+            s_IsEndOfLevel[s_NextIndex] = false;
+            break;
+        case E_TokenObjectEnd:
+            s_NextIndex = 1 - s_NextIndex;
+            s_Level[s_NextIndex] = s_Level[1 - s_NextIndex] - 1;
+            s_IsEndOfLevel[s_NextIndex] = true;
+            s_Name[s_NextIndex].clear();
+            s_Value[s_NextIndex].clear();
+            break;
+        case E_TokenNull:
+        case E_TokenArrayStart:
+        case E_TokenArrayEnd:
+        case E_TokenKeyPart:
+        case E_TokenStringPart:
+            break;
+        }
+    }
+
+    return true;
+}
+
+void CJsonStateRestoreTraverser::SBoostJsonHandler::resetArena() {
+    s_Tokens.clear();
+    s_NextToken = 0;
+    if (s_InPart) {
+        s_Arena.erase(0, s_PartBegin);
+        s_PartBegin = 0;
+    } else {
+        s_Arena.clear();
+    }
+}
+
 bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_null(json::error_code& ec) {
-    s_Type = E_TokenNull;
     if (ec) {
         LOG_ERROR(<< "on_null: ERROR: " << ec.to_string());
         return false;
     }
-    s_HaveCompleteToken = true;
+    this->pushToken(E_TokenNull, s_Arena.size());
     return true;
 }
 
 bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_bool(bool b, json::error_code& ec) {
-    s_Type = E_TokenBool;
     if (ec) {
         LOG_ERROR(<< "on_bool: ERROR: b: " << b << ". " << ec.to_string());
         return false;
     }
-    s_HaveCompleteToken = true;
-    if (s_RememberValue) {
-        s_Value[s_NextIndex].assign(CStringUtils::typeToString(b));
-    }
-
+    std::size_t begin{s_Arena.size()};
+    s_Arena.append(CStringUtils::typeToString(b));
+    this->pushToken(E_TokenBool, begin);
     return true;
 }
 
 bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_int64(std::int64_t i,
                                                              std::string_view s,
                                                              json::error_code& ec) {
-    s_Type = E_TokenInt64;
     if (ec) {
         LOG_ERROR(<< "on_int64: ERROR: i: " << i << ", s: '" << s << "'. "
                   << ec.to_string());
         return false;
     }
-    s_HaveCompleteToken = true;
-    if (s_RememberValue) {
-        // Frustratingly, the string_view passed to this handler points to characters
-        // beyond those used to parse the number value. Hence we need to convert the
-        // number _back_ to a string.
-        s_Value[s_NextIndex].assign(CStringUtils::typeToString(i));
-    }
-
+    // Frustratingly, the string_view passed to this handler points to characters
+    // beyond those used to parse the number value. Hence we need to convert the
+    // number _back_ to a string.
+    std::size_t begin{s_Arena.size()};
+    s_Arena.append(CStringUtils::typeToString(i));
+    this->pushToken(E_TokenInt64, begin);
     return true;
 }
 
 bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_uint64(std::uint64_t u,
                                                               std::string_view s,
                                                               json::error_code& ec) {
-    s_Type = E_TokenUInt64;
     if (ec) {
         LOG_ERROR(<< "on_uint64: ERROR: u: " << u << ", s: '" << s << "'. "
                   << ec.to_string());
         return false;
     }
-    s_HaveCompleteToken = true;
-    if (s_RememberValue) {
-        // Frustratingly, the string_view passed to this handler points to characters
-        // beyond those used to parse the number value. Hence we need to convert the
-        // number _back_ to a string.
-        s_Value[s_NextIndex].assign(CStringUtils::typeToString(u));
-    }
-
+    // Frustratingly, the string_view passed to this handler points to characters
+    // beyond those used to parse the number value. Hence we need to convert the
+    // number _back_ to a string.
+    std::size_t begin{s_Arena.size()};
+    s_Arena.append(CStringUtils::typeToString(u));
+    this->pushToken(E_TokenUInt64, begin);
     return true;
 }
 
 bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_double(double d,
                                                               std::string_view s,
                                                               json::error_code& ec) {
-    s_Type = E_TokenDouble;
     if (ec) {
         LOG_ERROR(<< "on_double: ERROR: d: " << d << ", s: '" << s << "'. "
                   << ec.to_string());
         return false;
     }
-    s_HaveCompleteToken = true;
-    if (s_RememberValue) {
-        // Frustratingly, the string_view passed to this handler points to characters
-        // beyond those used to parse the number value. Hence we need to convert the
-        // number _back_ to a string.
-        s_Value[s_NextIndex].assign(CStringUtils::typeToString(d));
-    }
-
+    // Frustratingly, the string_view passed to this handler points to characters
+    // beyond those used to parse the number value. Hence we need to convert the
+    // number _back_ to a string.
+    std::size_t begin{s_Arena.size()};
+    s_Arena.append(CStringUtils::typeToString(d));
+    this->pushToken(E_TokenDouble, begin);
     return true;
 }
 
 bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_string_part(std::string_view s,
                                                                    std::size_t n,
                                                                    json::error_code& ec) {
-    s_Type = E_TokenStringPart;
     if (ec) {
         LOG_ERROR(<< "on_string_part: ERROR: s: '" << s << "', n: " << n << ". "
                   << ec.to_string());
         return false;
     }
-
-    if (s_RememberValue) {
-        if (m_NewToken) {
-            s_Value[s_NextIndex].clear();
-            m_NewToken = false;
-        }
-        s_Value[s_NextIndex].append(s);
-    }
-
+    this->appendPart(s);
     return true;
 }
 
@@ -476,19 +528,9 @@ bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_string(std::string_view s
                   << ec.to_string());
         return false;
     }
-
-    if (s_Type != E_TokenStringPart && s.front() == '"') { // Empty string
-        s_Value[s_NextIndex].clear();
-    }
-
-    s_Type = E_TokenString;
-    s_HaveCompleteToken = true;
-    if (s_RememberValue) {
-        if (s.front() != '"') {
-            s_Value[s_NextIndex].append(s);
-        }
-        m_NewToken = true;
-    }
+    this->appendPart(s);
+    s_InPart = false;
+    this->pushToken(E_TokenString, s_PartBegin);
     return true;
 }
 
@@ -503,101 +545,61 @@ bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_object_begin(json::error_
     if (ec) {
         return false;
     }
-
-    s_Type = E_TokenObjectStart;
-    s_HaveCompleteToken = true;
-
-    if (s_RememberValue) {
-        ++s_Level[s_NextIndex];
-        s_Value[s_NextIndex].clear();
-    }
+    this->pushToken(E_TokenObjectStart, s_Arena.size());
     return true;
 }
 
 bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_key_part(std::string_view s,
                                                                 std::size_t n,
                                                                 json::error_code& ec) {
-    s_Type = E_TokenKeyPart;
     if (ec) {
         LOG_ERROR(<< "on_key_part: ERROR: s: '" << s << "', n: " << n << ". "
                   << ec.to_string());
         return false;
     }
-
-    if (s_RememberValue) {
-        if (m_NewToken) {
-            m_NewToken = false;
-            s_NextIndex = 1 - s_NextIndex;
-            s_Name[s_NextIndex].clear();
-        }
-        s_Name[s_NextIndex].append(s);
-    }
+    this->appendPart(s);
     return true;
 }
 
 bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_key(std::string_view s,
                                                            std::size_t n,
                                                            json::error_code& ec) {
-    s_Type = E_TokenKey;
     if (ec) {
         LOG_ERROR(<< "on_key: ERROR: s: '" << s << "', n: " << n << ". " << ec.to_string());
         return false;
     }
-    s_HaveCompleteToken = true;
-    if (s_RememberValue) {
-        if (s.front() != '"') {
-            s_Name[s_NextIndex].append(s);
-        }
-        s_Level[s_NextIndex] = s_Level[1 - s_NextIndex];
-        s_IsEndOfLevel[s_NextIndex] = false;
-        m_NewToken = true;
-    }
-
+    this->appendPart(s);
+    s_InPart = false;
+    this->pushToken(E_TokenKey, s_PartBegin);
     return true;
 }
 
 bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_object_end(std::size_t n,
                                                                   json::error_code& ec) {
-    s_Type = E_TokenObjectEnd;
     if (ec) {
         LOG_ERROR(<< "on_object_end: ERROR: n: " << n << ". " << ec.to_string());
         return false;
     }
-
-    s_HaveCompleteToken = true;
-
-    if (s_RememberValue) {
-        s_NextIndex = 1 - s_NextIndex;
-        s_Level[s_NextIndex] = s_Level[1 - s_NextIndex] - 1;
-        s_IsEndOfLevel[s_NextIndex] = true;
-        s_Name[s_NextIndex].clear();
-        s_Value[s_NextIndex].clear();
-    }
-
+    this->pushToken(E_TokenObjectEnd, s_Arena.size());
     return true;
 }
 
 bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_array_begin(json::error_code& ec) {
-    s_Type = E_TokenArrayStart;
     if (ec) {
         LOG_ERROR(<< "on_array_begin: ERROR: " << ec.to_string());
         return false;
     }
-
-    s_HaveCompleteToken = true;
-
+    this->pushToken(E_TokenArrayStart, s_Arena.size());
     return true;
 }
 
 bool CJsonStateRestoreTraverser::SBoostJsonHandler::on_array_end(std::size_t n,
                                                                  json::error_code& ec) {
-    s_Type = E_TokenArrayEnd;
     if (ec) {
         LOG_ERROR(<< "on_array_end: ERROR: n: " << n << ". " << ec.to_string());
         return false;
     }
-    s_HaveCompleteToken = true;
-
+    this->pushToken(E_TokenArrayEnd, s_Arena.size());
     return true;
 }
 
@@ -350,6 +350,9 @@ bool CLogger::reconfigureLogJson() {
     // Need a shared_ptr to std::cerr that will NOT delete it
     backend->add_stream(TOStreamPtr(&std::cerr, boost::null_deleter()));
 
+    // This must be synchronous. An asynchronous sink starts a feeding thread
+    // and the programs reconfigure logging before installing the system call
+    // filter, which only applies to the thread that installs it.
     auto sinkPtr{boost::make_shared<TTextOStreamSynchronousSink>(backend)};
 
     CJsonLogLayout jsonLogLayout;
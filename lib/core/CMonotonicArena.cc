@@ -0,0 +1,61 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#include <core/CMonotonicArena.h>
+
+#include <algorithm>
+
+namespace ml {
+namespace core {
+
+CMonotonicArena::CMonotonicArena(std::size_t initialBlockSize)
+    : m_InitialBlockSize{std::max(initialBlockSize, std::size_t{64})},
+      m_NextBlockSize{m_InitialBlockSize} {
+}
+
+void* CMonotonicArena::allocate(std::size_t bytes, std::size_t alignment) {
+    bytes = std::max(bytes, std::size_t{1});
+    if (std::align(alignment, bytes, m_Free, m_FreeBytes) == nullptr) {
+        this->newBlock(bytes + alignment);
+        std::align(alignment, bytes, m_Free, m_FreeBytes);
+    }
+    void* result{m_Free};
+    m_Free = static_cast<unsigned char*>(m_Free) + bytes;
+    m_FreeBytes -= bytes;
+    return result;
+}
+
+void CMonotonicArena::release() {
+    m_Blocks.clear();
+    m_Capacity = 0;
+    m_NextBlockSize = m_InitialBlockSize;
+    m_Free = nullptr;
+    m_FreeBytes = 0;
+}
+
+std::size_t CMonotonicArena::capacity() const {
+    return m_Capacity;
+}
+
+std::size_t CMonotonicArena::memoryUsage() const {
+    return m_Capacity + m_Blocks.capacity() * sizeof(TByteArrayPtr);
+}
+
+void CMonotonicArena::newBlock(std::size_t bytes) {
+    std::size_t size{std::max(bytes, m_NextBlockSize)};
+    m_Blocks.emplace_back(new unsigned char[size]);
+    m_Capacity += size;
+    m_NextBlockSize = std::min(2 * m_NextBlockSize, MAXIMUM_BLOCK_SIZE);
+    m_Free = m_Blocks.back().get();
+    m_FreeBytes = size;
+}
+}
+}
@@ -18,6 +18,7 @@
 #include <boost/throw_exception.hpp>
 
 #include <errno.h>
+#include <fcntl.h>
 #include <paths.h>
 #include <signal.h>
 #include <stdlib.h>
@@ -51,6 +52,16 @@ bool ignoreSigPipe() {
 
 const bool SIGPIPE_IGNORED{ignoreSigPipe()};
 
+//! The kernel capacity we ask for on Linux. State and results can be written
+//! at a high rate and the default 64KB capacity means the reader has to be
+//! woken very frequently. Requests above /proc/sys/fs/pipe-max-size, which is
+//! 1MB by default, fail for unprivileged processes so we don't ask for more.
+const int PIPE_CAPACITY{1024 * 1024};
+
+//! The stream buffer size for reading. Reads return whatever is available so
+//! a larger buffer only means fewer system calls when data is arriving fast.
+const std::streamsize READ_BUFFER_SIZE{64 * 1024};
+
 //! \brief
 //! Replacement for boost::iostreams::file_descriptor_sink that retries on EINTR.
 //!
@@ -122,7 +133,8 @@ CNamedPipeFactory::openPipeStreamRead(const std::string& fileName,
     using TFileDescriptorSourceStream =
         boost::iostreams::stream<boost::iostreams::file_descriptor_source>;
     return TIStreamP{new TFileDescriptorSourceStream(
-        boost::iostreams::file_descriptor_source(fd, boost::iostreams::close_handle))};
+        boost::iostreams::file_descriptor_source(fd, boost::iostreams::close_handle),
+        READ_BUFFER_SIZE)};
 }
 
 CNamedPipeFactory::TOStreamP
@@ -260,6 +272,14 @@ CNamedPipeFactory::initPipeHandle(const std::string& fileName,
                       << ::strerror(errno));
         }
     } else {
+#ifdef F_SETPIPE_SZ
+        // This is only an optimisation so failure isn't an error.
+        if (::fcntl(fd, F_SETPIPE_SZ, PIPE_CAPACITY) == -1) {
+            LOG_DEBUG(<< "Unable to increase capacity of named pipe " << fileName
+                      << ": " << ::strerror(errno));
+        }
+#endif
+
         // Write a test character to the pipe - this is really only necessary on
         // Windows, but doing it on *nix too will mean the inability of the Java
         // code to tolerate the test character will be discovered sooner.
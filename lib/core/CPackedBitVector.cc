@@ -248,6 +248,33 @@ bool CPackedBitVector::operator()(std::size_t i) const {
 }
 
 double CPackedBitVector::inner(const CPackedBitVector& covector, EOperation op) const {
+
+    if (m_Dimension == covector.m_Dimension) {
+        // Handle the cases which don't need a line scan.
+        if (&covector == this) {
+            return op == E_XOR ? 0.0 : static_cast<double>(this->countOneBits());
+        }
+        const CPackedBitVector* constant{this->isConstant() ? this : nullptr};
+        const CPackedBitVector* other{&covector};
+        if (constant == nullptr && covector.isConstant()) {
+            constant = &covector;
+            other = this;
+        }
+        if (constant != nullptr) {
+            bool bit{constant->m_First};
+            switch (op) {
+            case E_AND:
+                return bit ? static_cast<double>(other->countOneBits()) : 0.0;
+            case E_OR:
+                return bit ? static_cast<double>(m_Dimension)
+                           : static_cast<double>(other->countOneBits());
+            case E_XOR:
+                return static_cast<double>(bit ? m_Dimension - other->countOneBits()
+                                               : other->countOneBits());
+            }
+        }
+    }
+
     std::size_t result{0};
     switch (op) {
     case E_AND:
@@ -297,6 +324,16 @@ std::uint64_t CPackedBitVector::checksum() const {
         static_cast<int>(sizeof(std::uint8_t) * m_RunLengthBytes.size()), seed);
 }
 
+std::size_t CPackedBitVector::countOneBits() const {
+    std::size_t result{0};
+    bool one{m_First};
+    for (auto itr = m_RunLengthBytes.begin(); itr != m_RunLengthBytes.end(); one = !one) {
+        std::size_t run{popRunLength(itr)};
+        result += one ? run : 0;
+    }
+    return result;
+}
+
 void CPackedBitVector::debugMemoryUsage(const CMemoryUsage::TMemoryUsagePtr& mem) const {
     mem->setName("CPackedBitVector");
     memory_debug::dynamicSize("m_RunLengths", m_RunLengthBytes, mem);
@@ -309,6 +346,25 @@ std::size_t CPackedBitVector::memoryUsage() const {
 template<typename RUN_OP>
 void CPackedBitVector::bitwise(RUN_OP op, const CPackedBitVector& other) {
 
+    if (m_Dimension > 0 && m_Dimension == other.m_Dimension &&
+        (this->isConstant() || other.isConstant())) {
+        // If one operand is constant the result is either constant, the other
+        // operand or its complement.
+        bool thisIsConstant{this->isConstant()};
+        int bit{static_cast<int>(thisIsConstant ? m_First : other.m_First)};
+        bool zero{op(bit, 0) != 0};
+        bool one{op(bit, 1) != 0};
+        if (zero == one) {
+            *this = CPackedBitVector{m_Dimension, zero};
+        } else if (thisIsConstant) {
+            *this = other;
+            m_First = (m_First == one);
+        } else {
+            m_First = (m_First == one);
+        }
+        return;
+    }
+
     bool first(op(m_First, other.m_First));
     bool parity{true};
     std::uint8_t lastRunBytes{0};
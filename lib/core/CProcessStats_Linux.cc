@@ -56,7 +56,7 @@ bool readFromSystemFile(const std::string& fileName, std::string& content) {
 
 std::size_t CProcessStats::residentSetSize() {
     std::string statm;
-    std::size_t rss;
+    std::size_t rss{0};
 
     if (readFromSystemFile("/proc/self/statm", statm) == true) {
         std::vector<std::string> tokens;
@@ -20,8 +20,11 @@
 #include <core/CStreamWriter.h>
 #include <core/CStringUtils.h>
 
+#include <algorithm>
+#include <cmath>
 #include <ostream>
 #include <string>
+#include <utility>
 
 namespace ml {
 namespace core {
@@ -33,6 +36,8 @@ using TGenericLineWriter = CStreamWriter;
 const std::string NAME_TYPE("name");
 const std::string DESCRIPTION_TYPE("description");
 const std::string COUNTER_TYPE("value");
+const std::string MAX_TYPE("max");
+const std::pair<std::string, double> PERCENTILES[]{{"p50", 50.0}, {"p90", 90.0}, {"p99", 99.0}};
 
 //! Persistence tags
 const std::string KEY_TAG("a");
@@ -56,6 +61,33 @@ void addStringInt(CBoostJsonConcurrentLineWriter& writer,
 
     writer.onObjectEnd();
 }
+
+//! Helper function to add a histogram's count and percentiles to JSON writer
+void addHistogram(CBoostJsonConcurrentLineWriter& writer,
+                  const std::string& name,
+                  const std::string& description,
+                  const CProgramCounters::CHistogram& histogram) {
+    writer.onObjectBegin();
+
+    writer.onKey(NAME_TYPE);
+    writer.onString(name);
+
+    writer.onKey(DESCRIPTION_TYPE);
+    writer.onString(description);
+
+    writer.onKey(COUNTER_TYPE);
+    writer.onUint64(histogram.count());
+
+    for (const auto & [ key, percentile ] : PERCENTILES) {
+        writer.onKey(key);
+        writer.onUint64(histogram.percentile(percentile));
+    }
+
+    writer.onKey(MAX_TYPE);
+    writer.onUint64(histogram.max());
+
+    writer.onObjectEnd();
+}
 }
 
 CProgramCounters::CCacheManager::~CCacheManager() {
@@ -83,6 +115,11 @@ CProgramCounters::TCounter& CProgramCounters::counter(std::size_t index) {
     return ms_Instance.m_Counters[index];
 }
 
+CProgramCounters::CHistogram&
+CProgramCounters::histogram(counter_t::EHistogramTypes histogramType) {
+    return ms_Instance.m_Histograms[static_cast<std::size_t>(histogramType)];
+}
+
 void CProgramCounters::cacheCounters() {
     if (ms_Instance.m_Cache.size() != 0) {
         // The cache should only exist for a very brief period of time,
@@ -224,11 +261,104 @@ std::ostream& operator<<(std::ostream& o, const CProgramCounters& counters) {
         }
     }
 
+    // Histograms are only printed if they have any values.
+    for (const auto& histogram : counters.m_HistogramDefinitions) {
+        const auto& values = counters.m_Histograms[histogram.s_Type];
+        if (values.count() != 0) {
+            addHistogram(writer, histogram.s_Name, histogram.s_Description, values);
+        }
+    }
+
     writer.onArrayEnd();
     writeStream.flush();
 
     return o;
 }
 
+void CProgramCounters::CHistogram::add(std::uint64_t value) {
+    m_Counts[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+    std::uint64_t previousMax{m_Max.load(std::memory_order_relaxed)};
+    while (previousMax < value &&
+           m_Max.compare_exchange_weak(previousMax, value, std::memory_order_relaxed) == false) {
+    }
+}
+
+std::uint64_t CProgramCounters::CHistogram::count() const {
+    std::uint64_t result{0};
+    for (const auto& count : m_Counts) {
+        result += count.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+std::uint64_t CProgramCounters::CHistogram::max() const {
+    return m_Max.load(std::memory_order_relaxed);
+}
+
+std::uint64_t CProgramCounters::CHistogram::percentile(double percentile) const {
+    std::uint64_t count{this->count()};
+    if (count == 0) {
+        return 0;
+    }
+    std::uint64_t rank{static_cast<std::uint64_t>(
+        std::ceil(std::clamp(percentile, 0.0, 100.0) * static_cast<double>(count) / 100.0))};
+    rank = std::max(rank, std::uint64_t{1});
+
+    std::uint64_t cumulative{0};
+    for (std::size_t i = 0; i < m_Counts.size(); ++i) {
+        cumulative += m_Counts[i].load(std::memory_order_relaxed);
+        if (cumulative >= rank) {
+            std::uint64_t upperBound{i + 1 < NUM_BUCKETS ? bucketLowerBound(i + 1) - 1
+                                                         : ~std::uint64_t{0}};
+            return std::min(upperBound, this->max());
+        }
+    }
+    return this->max();
+}
+
+void CProgramCounters::CHistogram::clear() {
+    for (auto& count : m_Counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    m_Max.store(0, std::memory_order_relaxed);
+}
+
+std::size_t CProgramCounters::CHistogram::bucket(std::uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return static_cast<std::size_t>(value);
+    }
+    std::size_t msb{0};
+    for (std::size_t shift = 32; shift > 0; shift /= 2) {
+        if ((value >> (msb + shift)) != 0) {
+            msb += shift;
+        }
+    }
+    std::size_t magnitude{msb - SUB_BUCKET_BITS + 1};
+    std::size_t subBucket{static_cast<std::size_t>(value >> (msb - SUB_BUCKET_BITS)) -
+                          SUB_BUCKETS};
+    return magnitude * SUB_BUCKETS + subBucket;
+}
+
+std::uint64_t CProgramCounters::CHistogram::bucketLowerBound(std::size_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    std::size_t magnitude{bucket / SUB_BUCKETS};
+    std::uint64_t subBucket{bucket % SUB_BUCKETS};
+    return (SUB_BUCKETS + subBucket) << (magnitude - 1);
+}
+
+CProgramCounters::CScopedHistogramTimer::CScopedHistogramTimer(
+    counter_t::EHistogramTypes histogramType)
+    : m_Histogram{CProgramCounters::histogram(histogramType)},
+      m_Start{std::chrono::steady_clock::now()} {
+}
+
+CProgramCounters::CScopedHistogramTimer::~CScopedHistogramTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - m_Start;
+    m_Histogram.add(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+}
+
 } // core
 } // ml
@@ -10,6 +10,8 @@
  */
 #include <core/CStatePersistInserter.h>
 
+#include <core/CPersistUtils.h>
+
 namespace ml {
 namespace core {
 
@@ -22,6 +24,11 @@ void CStatePersistInserter::insertValue(const std::string& name,
     this->insertValue(name, CStringUtils::typeToStringPrecise(value, precision));
 }
 
+void CStatePersistInserter::insertValue(const std::string& name,
+                                        const TFloatStorageVec& values) {
+    this->insertValue(name, CPersistUtils::toString(values));
+}
+
 bool operator==(const std::string& lhs, const CPersistenceTag& rhs) {
     return lhs == rhs.m_ShortTag || lhs == rhs.m_LongTag;
 }
@@ -11,6 +11,7 @@
 #include <core/CStateRestoreTraverser.h>
 
 #include <core/CLogger.h>
+#include <core/CPersistUtils.h>
 
 namespace ml {
 namespace core {
@@ -28,6 +29,14 @@ void CStateRestoreTraverser::setBadState() {
     m_BadState = true;
 }
 
+bool CStateRestoreTraverser::floatValues(TFloatStorageVec& result) const {
+    return CPersistUtils::fromString(this->value(), result);
+}
+
+bool CStateRestoreTraverser::doubleValue(double& result) const {
+    return CStringUtils::stringToType(this->value(), result);
+}
+
 CStateRestoreTraverser::CAutoLevel::CAutoLevel(CStateRestoreTraverser& traverser)
     : m_Traverser{traverser}, m_Descended{traverser.descend()} {
 }
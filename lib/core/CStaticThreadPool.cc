@@ -10,11 +10,21 @@
  */
 
 #include <core/CStaticThreadPool.h>
+
+#include <core/CProgramCounters.h>
+
 #include <memory>
 
 namespace ml {
 namespace core {
 namespace {
+//! The maximum number of tasks which can be held in each worker's deque.
+const std::size_t DEQUE_CAPACITY{1024};
+
+//! The pool, if any, and worker to which the current thread belongs.
+thread_local const CStaticThreadPool* currentPool{nullptr};
+thread_local std::size_t currentWorker{0};
+
 std::size_t computeSize(std::size_t hint) {
     std::size_t bound{std::thread::hardware_concurrency()};
     std::size_t size{bound > 0 ? std::min(hint, bound) : hint};
@@ -22,8 +32,10 @@ std::size_t computeSize(std::size_t hint) {
 }
 }
 
-CStaticThreadPool::CStaticThreadPool(std::size_t size, std::size_t queueCapacity)
-    : m_Busy{false}, m_Cursor{0} {
+CStaticThreadPool::CStaticThreadPool(std::size_t size,
+                                     std::size_t queueCapacity,
+                                     EScheduling scheduling)
+    : m_Busy{false}, m_Cursor{0}, m_Scheduling{scheduling} {
 
     std::size_t poolSize{computeSize(size)};
     m_Pool.reserve(poolSize);
@@ -31,6 +43,11 @@ CStaticThreadPool::CStaticThreadPool(std::size_t size, std::size_t queueCapacity
     for (std::size_t id = 0; id < poolSize; ++id) {
         m_TaskQueues.push_back(std::make_unique<TWrappedTaskQueue>(queueCapacity));
     }
+    if (m_Scheduling == CExecutor::E_WorkStealing) {
+        for (std::size_t id = 0; id < poolSize; ++id) {
+            m_TaskDeques.push_back(std::make_unique<TWrappedTaskDeque>(DEQUE_CAPACITY));
+        }
+    }
     m_NumberThreadsInUse.store(poolSize);
 
     for (std::size_t id = 0; id < poolSize; ++id) {
@@ -57,11 +74,24 @@ void CStaticThreadPool::numberThreadsInUse(std::size_t threads) {
 }
 
 void CStaticThreadPool::schedule(TTask&& task_) {
+    CWrappedTask task{std::forward<TTask>(task_)};
+
+    // If we're work stealing and a worker schedules a task we push it onto its
+    // deque. It will pick it up next unless another worker is idle and steals it.
+    if (currentPool == this && m_Scheduling == CExecutor::E_WorkStealing) {
+        auto stealable = std::make_unique<CWrappedTask>(std::move(task));
+        if (m_TaskDeques[currentWorker]->tryPush(stealable.get())) {
+            stealable.release();
+            this->notifyIdleWorkers();
+            return;
+        }
+        task = std::move(*stealable);
+    }
+
     // Only block if every queue is full.
     std::size_t size{m_NumberThreadsInUse.load()};
     std::size_t i{m_Cursor.load()};
     std::size_t end{i + size};
-    CWrappedTask task{std::forward<TTask>(task_)};
     for (/**/; i < end; ++i) {
         if (m_TaskQueues[i % size]->tryPush(std::move(task))) {
             break;
@@ -82,6 +112,10 @@ void CStaticThreadPool::schedule(TTask&& task_) {
     // safely add and remove elements at different ends of a queue of length greater
     // than one.
     m_Cursor.store(i + 1);
+
+    if (m_Scheduling == CExecutor::E_WorkStealing) {
+        this->notifyIdleWorkers();
+    }
 }
 
 bool CStaticThreadPool::busy() const {
@@ -92,6 +126,10 @@ void CStaticThreadPool::busy(bool busy) {
     m_Busy.store(busy);
 }
 
+CStaticThreadPool::EScheduling CStaticThreadPool::scheduling() const {
+    return m_Scheduling;
+}
+
 void CStaticThreadPool::shutdown() {
 
     // Drain the queues before starting to shut down in order to maximise throughput.
@@ -103,6 +141,7 @@ void CStaticThreadPool::shutdown() {
         TTask done{[this] { m_Done = true; }};
         m_TaskQueues[id]->push(CWrappedTask{std::move(done), id});
     }
+    this->notifyIdleWorkers();
 
     for (auto& thread : m_Pool) {
         if (thread.joinable()) {
@@ -110,12 +149,20 @@ void CStaticThreadPool::shutdown() {
         }
     }
 
+    // A worker can exit as soon as any shutdown task has run so there may still
+    // be tasks in the deques.
+    this->drainDeques();
+
     m_TaskQueues.clear();
+    m_TaskDeques.clear();
     m_Pool.clear();
 }
 
 void CStaticThreadPool::worker(std::size_t id) {
 
+    currentPool = this;
+    currentWorker = id;
+
     auto ifAllowed = [id](const CWrappedTask& task) {
         return task.executableOnThread(id);
     };
@@ -123,6 +170,16 @@ void CStaticThreadPool::worker(std::size_t id) {
     TOptionalTask task;
 
     while (m_Done == false) {
+        if (m_Scheduling == CExecutor::E_WorkStealing) {
+            task = this->findWork(id, m_NumberThreadsInUse.load());
+            if (task == std::nullopt) {
+                ++CProgramCounters::counter(counter_t::E_TPNumberIdleWaits);
+                task = this->waitForWork(id);
+            }
+            (*task)();
+            continue;
+        }
+
         // We maintain "worker count" queues and each worker has an affinity to a
         // different queue. We don't immediately block if the worker's "queue" is
         // empty because different tasks can have different duration and we could
@@ -164,6 +221,101 @@ void CStaticThreadPool::worker(std::size_t id) {
     }
 }
 
+CStaticThreadPool::TOptionalTask CStaticThreadPool::findWork(std::size_t id, std::size_t size) {
+
+    // We prefer the most recent task we scheduled ourselves since its data are
+    // the most likely to be in cache and then tasks on our own queue.
+    TOptionalTask task{this->popFromDeque(id, false)};
+    if (task != std::nullopt) {
+        return task;
+    }
+    task = m_TaskQueues[id]->tryPop();
+    if (task != std::nullopt || id >= size) {
+        return task;
+    }
+
+    // Steal the oldest tasks from the other workers' deques. These are the most
+    // likely to generate further work. Note that we check every deque because a
+    // worker which is no longer in use may still be adding tasks to its deque.
+    auto ifAllowed = [id](const CWrappedTask& task_) {
+        return task_.executableOnThread(id);
+    };
+    for (std::size_t i = 1; i < m_TaskDeques.size(); ++i) {
+        task = this->popFromDeque((id + i) % m_TaskDeques.size(), true);
+        if (task != std::nullopt) {
+            ++CProgramCounters::counter(counter_t::E_TPNumberTasksStolen);
+            return task;
+        }
+    }
+    for (std::size_t i = 1; i < size; ++i) {
+        task = m_TaskQueues[(id + i) % size]->tryPop(ifAllowed);
+        if (task != std::nullopt) {
+            ++CProgramCounters::counter(counter_t::E_TPNumberTasksStolen);
+            return task;
+        }
+    }
+    return std::nullopt;
+}
+
+CStaticThreadPool::TOptionalTask CStaticThreadPool::waitForWork(std::size_t id) {
+
+    // Tasks can be pushed onto any queue or deque so we can't simply block on
+    // our own queue. Instead we register as idle and sleep until a task is
+    // pushed anywhere. We read the epoch before looking for work so a push
+    // after we look, which must see us as idle, always wakes us.
+    ++m_NumberIdleWorkers;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    TOptionalTask task;
+    while (task == std::nullopt) {
+        std::uint64_t epoch;
+        {
+            std::lock_guard<std::mutex> lock{m_IdleMutex};
+            epoch = m_WorkEpoch;
+        }
+        task = this->findWork(id, m_NumberThreadsInUse.load());
+        if (task == std::nullopt) {
+            std::unique_lock<std::mutex> lock{m_IdleMutex};
+            m_WorkAvailable.wait(lock, [&] { return m_WorkEpoch != epoch; });
+        }
+    }
+    --m_NumberIdleWorkers;
+    return task;
+}
+
+void CStaticThreadPool::notifyIdleWorkers() {
+    // This pairs with the fence in waitForWork: either the idle worker sees
+    // the task we just pushed or we see that it is idle.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_NumberIdleWorkers.load() > 0) {
+        {
+            std::lock_guard<std::mutex> lock{m_IdleMutex};
+            ++m_WorkEpoch;
+        }
+        // A task may only be executable by some workers, for example if it is
+        // on the queue of a worker which is in use, so we wake them all.
+        m_WorkAvailable.notify_all();
+    }
+}
+
+CStaticThreadPool::TOptionalTask CStaticThreadPool::popFromDeque(std::size_t id, bool steal) {
+    auto& deque = *m_TaskDeques[id];
+    auto task = steal ? deque.trySteal() : deque.tryPop();
+    if (task == std::nullopt) {
+        return std::nullopt;
+    }
+    std::unique_ptr<CWrappedTask> owned{*task};
+    return std::move(*owned);
+}
+
+void CStaticThreadPool::drainDeques() {
+    for (std::size_t id = 0; id < m_TaskDeques.size(); ++id) {
+        for (auto task = this->popFromDeque(id, true); task != std::nullopt;
+             task = this->popFromDeque(id, true)) {
+            (*task)();
+        }
+    }
+}
+
 void CStaticThreadPool::drainQueuesWithoutBlocking() {
     TOptionalTask task;
     auto popTask = [&] {
@@ -13,9 +13,13 @@
 #include <core/CMemoryDef.h>
 
 #include <limits>
+#include <vector>
 
 namespace ml {
 namespace core {
+namespace {
+thread_local std::vector<std::size_t> weightedEditDistanceColumns;
+}
 
 const int CStringSimilarityTester::MINUS_INFINITE_INT(std::numeric_limits<int>::min());
 
@@ -139,6 +143,13 @@ int** CStringSimilarityTester::setupBerghelRoachMatrix(int maxDist,
     return matrix;
 }
 
+std::size_t* CStringSimilarityTester::weightedEditDistanceWorkspace(std::size_t size) {
+    if (weightedEditDistanceColumns.size() < size) {
+        weightedEditDistanceColumns.resize(size);
+    }
+    return weightedEditDistanceColumns.data();
+}
+
 void CStringSimilarityTester::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const {
     mem->setName("CStringSimilarityTester");
     core::memory_debug::dynamicSize("m_Compressor", m_Compressor, mem);
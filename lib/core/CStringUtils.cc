@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <locale>
 
@@ -62,6 +63,148 @@ const char MEGABYTES{'m'};
 const char GIGABYTES{'g'};
 const char TERABYTES{'t'};
 const char PETABYTES{'p'};
+
+//! The powers of ten which are exactly representable as doubles.
+const double EXACT_POWERS_OF_TEN[]{1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                   1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                   1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+const int MAX_EXACT_POWER_OF_TEN{22};
+const std::uint64_t MAX_EXACT_MANTISSA{std::uint64_t{1} << 53};
+const int MAX_SIGNIFICANT_DIGITS{19};
+
+//! The longest string converted to a double without allocating if we
+//! fall back to ::strtod.
+const std::size_t MAX_UNALLOCATED_LENGTH{64};
+
+//! Convert a plain decimal number, i.e. one matching [+-]?d*(.d*)?([eE][+-]?d+)?,
+//! to a double when this can be done exactly using double arithmetic.
+//!
+//! If the significand is at most 2^53 and the power of ten is at most 22 in
+//! magnitude then the significand and power of ten are both exactly
+//! representable as doubles and a single IEEE multiplication or division
+//! gives the correctly rounded result. This is the same value ::strtod
+//! computes, but without its locale handling.
+//!
+//! \return False if \p str isn't handled, which includes every string which
+//! isn't a valid number, in which case \p result is unchanged.
+bool fastStringToDouble(std::string_view str, double& result) {
+    const char* current{str.data()};
+    const char* end{current + str.size()};
+
+    bool negative{false};
+    if (current != end && (*current == '-' || *current == '+')) {
+        negative = *current == '-';
+        ++current;
+    }
+
+    std::uint64_t significand{0};
+    int numberSignificantDigits{0};
+    int numberDigits{0};
+    int exponent{0};
+    auto readDigits = [&](int exponentPerDigit) {
+        for (/**/; current != end && *current >= '0' && *current <= '9'; ++current) {
+            int digit{*current - '0'};
+            ++numberDigits;
+            exponent += exponentPerDigit;
+            if (significand == 0 && digit == 0) {
+                continue;
+            }
+            if (numberSignificantDigits == MAX_SIGNIFICANT_DIGITS) {
+                return false;
+            }
+            significand = 10 * significand + static_cast<std::uint64_t>(digit);
+            ++numberSignificantDigits;
+        }
+        return true;
+    };
+
+    if (readDigits(0) == false) {
+        return false;
+    }
+    if (current != end && *current == '.') {
+        ++current;
+        if (readDigits(-1) == false) {
+            return false;
+        }
+    }
+    if (numberDigits == 0) {
+        return false;
+    }
+
+    if (current != end && (*current == 'e' || *current == 'E')) {
+        ++current;
+        bool negativeExponent{false};
+        if (current != end && (*current == '-' || *current == '+')) {
+            negativeExponent = *current == '-';
+            ++current;
+        }
+        if (current == end) {
+            return false;
+        }
+        int explicitExponent{0};
+        for (/**/; current != end && *current >= '0' && *current <= '9'; ++current) {
+            if (explicitExponent > 10 * MAX_EXACT_POWER_OF_TEN) {
+                return false;
+            }
+            explicitExponent = 10 * explicitExponent + (*current - '0');
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    if (current != end) {
+        return false;
+    }
+
+    if (significand == 0) {
+        result = negative ? -0.0 : 0.0;
+        return true;
+    }
+    if (significand > MAX_EXACT_MANTISSA || exponent < -MAX_EXACT_POWER_OF_TEN ||
+        exponent > MAX_EXACT_POWER_OF_TEN) {
+        return false;
+    }
+
+    double value{static_cast<double>(significand)};
+    value = exponent < 0 ? value / EXACT_POWERS_OF_TEN[-exponent]
+                         : value * EXACT_POWERS_OF_TEN[exponent];
+    result = negative ? -value : value;
+    return true;
+}
+
+//! Convert a null terminated string to a double using ::strtod.
+bool strtodWithChecks(bool silent, const char* str, double& d) {
+    char* endPtr(nullptr);
+    errno = 0;
+    double ret(::strtod(str, &endPtr));
+
+    if (ret == 0 && errno == EINVAL) {
+        if (!silent) {
+            LOG_ERROR(<< "Unable to convert string '" << str
+                      << "' to double: " << ::strerror(errno));
+        }
+        return false;
+    }
+
+    if ((ret == HUGE_VAL || ret == -HUGE_VAL) && errno == ERANGE) {
+        if (!silent) {
+            LOG_ERROR(<< "Unable to convert string '" << str
+                      << "' to double: " << ::strerror(errno));
+        }
+        return false;
+    }
+
+    if (endPtr != nullptr && *endPtr != '\0') {
+        if (!silent) {
+            LOG_ERROR(<< "Unable to convert string '" << str
+                      << "' to double: first invalid character " << endPtr);
+        }
+        return false;
+    }
+
+    d = ret;
+
+    return true;
+}
 }
 
 namespace ml {
@@ -388,9 +531,15 @@ std::string CStringUtils::typeToStringPretty(double d) {
 }
 
 std::string CStringUtils::typeToStringPrecise(double d, CIEEE754::EPrecision precision) {
-    // Just use a large enough buffer to hold maximum precision.
-    char buf[4 * sizeof(double)];
-    ::memset(buf, 0, sizeof(buf));
+    char buf[PRECISE_DOUBLE_BUFFER_SIZE];
+    std::size_t length{typeToStringPrecise(d, precision, buf)};
+    return {buf, length};
+}
+
+std::size_t
+CStringUtils::typeToStringPrecise(double d, CIEEE754::EPrecision precision, char* buf) {
+    // The caller supplies a large enough buffer to hold maximum precision.
+    ::memset(buf, 0, PRECISE_DOUBLE_BUFFER_SIZE);
 
     // Floats need higher precision to precisely round trip to decimal than
     // considering their effective precision base 10. There's a good discussion
@@ -451,21 +600,25 @@ std::string CStringUtils::typeToStringPrecise(double d, CIEEE754::EPrecision pre
             }
 
             if (edit) {
-                std::string adjResult;
-                adjResult.reserve(ret - 1);
-                // mantissa
-                adjResult.assign(buf, bwd + 1);
+                // The edited string is never longer than the original so we
+                // can rewrite it in place.
+                char* out{bwd + 1};
                 if (::isdigit(static_cast<unsigned char>(*fwd))) {
-                    adjResult.append(minus ? "e-" : "e");
-                    // exponent
-                    adjResult.append(fwd);
+                    *out++ = 'e';
+                    if (minus) {
+                        *out++ = '-';
+                    }
+                    std::size_t exponentLength{static_cast<std::size_t>(buf + ret - fwd)};
+                    ::memmove(out, fwd, exponentLength);
+                    out += exponentLength;
                 }
-                return adjResult;
+                *out = '\0';
+                return static_cast<std::size_t>(out - buf);
             }
         }
     }
 
-    return buf;
+    return static_cast<std::size_t>(ret);
 }
 
 CStringUtils::TSizeBoolPr
@@ -861,37 +1014,33 @@ bool CStringUtils::_stringToType(bool silent, const std::string& str, double& d)
         return false;
     }
 
-    char* endPtr(nullptr);
-    errno = 0;
-    double ret(::strtod(str.c_str(), &endPtr));
-
-    if (ret == 0 && errno == EINVAL) {
-        if (!silent) {
-            LOG_ERROR(<< "Unable to convert string '" << str
-                      << "' to double: " << ::strerror(errno));
-        }
-        return false;
+    if (fastStringToDouble(str, d)) {
+        return true;
     }
 
-    if ((ret == HUGE_VAL || ret == -HUGE_VAL) && errno == ERANGE) {
-        if (!silent) {
-            LOG_ERROR(<< "Unable to convert string '" << str
-                      << "' to double: " << ::strerror(errno));
-        }
-        return false;
-    }
+    return strtodWithChecks(silent, str.c_str(), d);
+}
 
-    if (endPtr != nullptr && *endPtr != '\0') {
+bool CStringUtils::_stringToType(bool silent, std::string_view str, double& d) {
+    if (str.empty()) {
         if (!silent) {
-            LOG_ERROR(<< "Unable to convert string '" << str
-                      << "' to double: first invalid character " << endPtr);
+            LOG_ERROR(<< "Unable to convert empty string to double");
         }
         return false;
     }
 
-    d = ret;
+    if (fastStringToDouble(str, d)) {
+        return true;
+    }
 
-    return true;
+    // Fall back to ::strtod which needs a null terminated string.
+    if (str.size() < MAX_UNALLOCATED_LENGTH) {
+        char buffer[MAX_UNALLOCATED_LENGTH];
+        std::copy(str.begin(), str.end(), buffer);
+        buffer[str.size()] = '\0';
+        return strtodWithChecks(silent, buffer, d);
+    }
+    return strtodWithChecks(silent, std::string{str}.c_str(), d);
 }
 
 bool CStringUtils::_stringToType(bool silent, const std::string& str, char& c) {
@@ -14,6 +14,10 @@
 #include <core/CScopedFastLock.h>
 #include <core/CSetEnv.h>
 
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
 #include <errno.h>
 #include <string.h>
 
@@ -23,6 +27,22 @@ namespace {
 // course, the instance may already be constructed before this if another static
 // object has used it.
 const ml::core::CTimezone& DO_NOT_USE_THIS_VARIABLE = ml::core::CTimezone::instance();
+
+const ml::core_t::TTime SECONDS_PER_DAY{86400};
+
+//! Incremented whenever the timezone changes to invalidate cached conversions.
+std::atomic<std::uint64_t> timezoneGeneration{0};
+
+//! The local date fields of the last day converted on this thread. Calendar
+//! features ask for the date fields of many times in the same day so this
+//! saves most calls to localtime_r.
+struct SCachedDay {
+    std::uint64_t s_Generation{std::numeric_limits<std::uint64_t>::max()};
+    ml::core_t::TTime s_Start{0};
+    ml::core_t::TTime s_End{0};
+    struct tm s_Fields {};
+};
+thread_local SCachedDay cachedDay;
 }
 
 namespace ml {
@@ -56,6 +76,7 @@ bool CTimezone::timezoneName(const std::string& name) {
     }
 
     ::tzset();
+    ++timezoneGeneration;
 
     m_Name = name;
 
@@ -103,21 +124,50 @@ bool CTimezone::dateFields(core_t::TTime utcTime,
     yearsSince1900 = -1;
     secondsSinceMidnight = -1;
 
-    struct tm result;
-
-    // core_t::TTime holds an epoch time (UTC)
-    if (this->utcToLocal(utcTime, result)) {
-        daysSinceSunday = result.tm_wday;
-        dayOfMonth = result.tm_mday;
-        monthsSinceJanuary = result.tm_mon;
-        daysSinceJanuary1st = result.tm_yday;
-        yearsSince1900 = result.tm_year;
-        secondsSinceMidnight = 3600 * result.tm_hour + 60 * result.tm_min +
-                               result.tm_sec;
-        return true;
+    SCachedDay& day{cachedDay};
+    std::uint64_t generation{timezoneGeneration.load()};
+
+    if (day.s_Generation != generation || utcTime < day.s_Start || utcTime >= day.s_End) {
+        struct tm result;
+
+        // core_t::TTime holds an epoch time (UTC)
+        if (this->utcToLocal(utcTime, result) == false) {
+            return false;
+        }
+
+        // We can only cache days whose UTC offset doesn't change, i.e. which
+        // don't contain a daylight saving transition.
+        core_t::TTime start{utcTime - (3600 * result.tm_hour + 60 * result.tm_min +
+                                       result.tm_sec)};
+        struct tm startOfDay;
+        struct tm endOfDay;
+        if (this->utcToLocal(start, startOfDay) == false ||
+            this->utcToLocal(start + SECONDS_PER_DAY - 1, endOfDay) == false ||
+            startOfDay.tm_gmtoff != result.tm_gmtoff ||
+            endOfDay.tm_gmtoff != result.tm_gmtoff) {
+            daysSinceSunday = result.tm_wday;
+            dayOfMonth = result.tm_mday;
+            monthsSinceJanuary = result.tm_mon;
+            daysSinceJanuary1st = result.tm_yday;
+            yearsSince1900 = result.tm_year;
+            secondsSinceMidnight = 3600 * result.tm_hour + 60 * result.tm_min +
+                                   result.tm_sec;
+            return true;
+        }
+
+        day.s_Generation = generation;
+        day.s_Start = start;
+        day.s_End = start + SECONDS_PER_DAY;
+        day.s_Fields = startOfDay;
     }
 
-    return false;
+    daysSinceSunday = day.s_Fields.tm_wday;
+    dayOfMonth = day.s_Fields.tm_mday;
+    monthsSinceJanuary = day.s_Fields.tm_mon;
+    daysSinceJanuary1st = day.s_Fields.tm_yday;
+    yearsSince1900 = day.s_Fields.tm_year;
+    secondsSinceMidnight = static_cast<int>(utcTime - day.s_Start);
+    return true;
 }
 }
 }
@@ -30,13 +30,14 @@ public:
     void busy(bool) override {}
     std::size_t numberThreadsInUse() const override { return 1; }
     void numberThreadsInUse(std::size_t) override {}
+    EScheduling scheduling() const override { return E_RoundRobin; }
 };
 
 //! \brief Executes a function in a thread pool.
 class CThreadPoolExecutor final : public CExecutor {
 public:
-    explicit CThreadPoolExecutor(std::size_t size, std::size_t queueCapacity)
-        : m_ThreadPool{size, queueCapacity} {}
+    CThreadPoolExecutor(std::size_t size, std::size_t queueCapacity, EScheduling scheduling)
+        : m_ThreadPool{size, queueCapacity, scheduling} {}
 
     void schedule(std::function<void()>&& f) override {
         m_ThreadPool.schedule(std::forward<std::function<void()>>(f));
@@ -55,6 +56,10 @@ public:
         m_ThreadPool.numberThreadsInUse(threads);
     }
 
+    EScheduling scheduling() const override {
+        return m_ThreadPool.scheduling();
+    }
+
 private:
     CStaticThreadPool m_ThreadPool;
 };
@@ -66,7 +71,8 @@ public:
 
     static CExecutorHolder makeThreadPool(std::size_t threadPoolSize,
                                           std::size_t queueCapacity,
-                                          std::size_t fallbackThreadPoolSize) {
+                                          std::size_t fallbackThreadPoolSize,
+                                          CExecutor::EScheduling scheduling) {
         if (threadPoolSize == 0) {
             threadPoolSize = std::thread::hardware_concurrency();
         }
@@ -77,7 +83,7 @@ public:
 
         if (threadPoolSize > 0) {
             try {
-                return CExecutorHolder{threadPoolSize, queueCapacity};
+                return CExecutorHolder{threadPoolSize, queueCapacity, scheduling};
             } catch (const std::exception& e) {
                 LOG_ERROR(<< "Failed to create thread pool with '" << e.what()
                           << "'. Falling back to running single threaded");
@@ -96,9 +102,13 @@ public:
     std::size_t threadPoolSize() const { return m_ThreadPoolSize; }
 
 private:
-    CExecutorHolder(std::size_t threadPoolSize, std::size_t queueCapacity)
+    CExecutorHolder(std::size_t threadPoolSize,
+                    std::size_t queueCapacity,
+                    CExecutor::EScheduling scheduling)
         : m_ThreadPoolSize{threadPoolSize},
-          m_Executor(std::make_unique<CThreadPoolExecutor>(threadPoolSize, queueCapacity)) {}
+          m_Executor(std::make_unique<CThreadPoolExecutor>(threadPoolSize,
+                                                           queueCapacity,
+                                                           scheduling)) {}
 
 private:
     std::size_t m_ThreadPoolSize;
@@ -110,12 +120,13 @@ CExecutorHolder singletonExecutor;
 
 void startDefaultAsyncExecutor(std::size_t threadPoolSize,
                                std::size_t queueCapacity,
-                               std::size_t fallbackThreadPoolSize) {
+                               std::size_t fallbackThreadPoolSize,
+                               CExecutor::EScheduling scheduling) {
     // This is purposely not thread safe. This is only meant to be called once from
     // the main thread, typically from main of an executable or in single threaded
     // test code.
-    singletonExecutor = CExecutorHolder::makeThreadPool(threadPoolSize, queueCapacity,
-                                                        fallbackThreadPoolSize);
+    singletonExecutor = CExecutorHolder::makeThreadPool(
+        threadPoolSize, queueCapacity, fallbackThreadPoolSize, scheduling);
 }
 
 void stopDefaultAsyncExecutor() {
@@ -177,6 +188,18 @@ bool CDefaultAsyncExecutorBusyForScope::wasBusy() const {
 
 void noop(double) {
 }
+
+std::size_t numberChunks(std::size_t size, std::size_t partitions) {
+    // We want enough chunks that the tail of the loop, where some tasks have run
+    // out of work, is short compared to its duration but not so many that the
+    // overhead of claiming them is significant.
+    std::size_t target{std::min(8 * partitions, size)};
+    std::size_t chunks{1};
+    while (2 * chunks <= target) {
+        chunks *= 2;
+    }
+    return chunks;
+}
 }
 }
 }
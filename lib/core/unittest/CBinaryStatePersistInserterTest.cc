@@ -0,0 +1,96 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#include <core/CBinaryStatePersistInserter.h>
+#include <core/CIEEE754.h>
+#include <core/CLogger.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <sstream>
+
+BOOST_AUTO_TEST_SUITE(CBinaryStatePersistInserterTest)
+
+namespace {
+void insert2ndLevel(ml::core::CStatePersistInserter& inserter) {
+    inserter.insertValue("level2A", 3.14, ml::core::CIEEE754::E_SinglePrecision);
+    inserter.insertValue("level2B", 'z');
+}
+}
+
+BOOST_AUTO_TEST_CASE(testPersist) {
+    std::ostringstream strm;
+    {
+        ml::core::CBinaryStatePersistInserter inserter(strm);
+        inserter.insertValue("level1A", "a");
+        inserter.insertLevel("level1B", &insert2ndLevel);
+        inserter.insertValue("level1A", 25);
+    }
+
+    std::string expected{ml::core::CBinaryStatePersistInserter::MARKER};
+    expected.push_back(static_cast<char>(ml::core::CBinaryStatePersistInserter::VERSION));
+    // The dictionary.
+    expected.append("\x04");
+    expected.append("\x07"
+                    "level1A");
+    expected.append("\x07"
+                    "level1B");
+    expected.append("\x07"
+                    "level2A");
+    expected.append("\x07"
+                    "level2B");
+    // The body length.
+    expected.append("\x15");
+    // level1A: "a"
+    expected.append("\x00\x01"
+                    "a",
+                    3);
+    // level1B: { level2A: 3.14, level2B: "z" }
+    expected.append("\x09\x0c");
+    expected.append("\x13");
+    double pi{3.14};
+    std::uint64_t bits;
+    std::memcpy(&bits, &pi, sizeof(bits));
+    for (std::size_t i = 0; i < 8; ++i, bits >>= 8) {
+        expected.push_back(static_cast<char>(bits & 0xFF));
+    }
+    expected.append("\x18\x01"
+                    "z");
+    // level1A: "25"
+    expected.append("\x00\x02"
+                    "25",
+                    4);
+
+    BOOST_REQUIRE_EQUAL(expected.size(), strm.str().size());
+    BOOST_TEST_REQUIRE(expected == strm.str());
+}
+
+BOOST_AUTO_TEST_CASE(testVarint) {
+    for (std::uint64_t value : {std::uint64_t{0}, std::uint64_t{1}, std::uint64_t{127},
+                                std::uint64_t{128}, std::uint64_t{300},
+                                std::uint64_t{1} << 63}) {
+        std::string buffer;
+        ml::core::CBinaryStatePersistInserter::appendVarint(value, buffer);
+        LOG_DEBUG(<< value << " -> " << buffer.size() << " bytes");
+
+        std::uint64_t decoded{0};
+        for (std::size_t i = 0; i < buffer.size(); ++i) {
+            auto byte = static_cast<unsigned char>(buffer[i]);
+            BOOST_REQUIRE_EQUAL(i + 1 < buffer.size(), (byte & 0x80) != 0);
+            decoded |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * i);
+        }
+        BOOST_REQUIRE_EQUAL(value, decoded);
+        BOOST_REQUIRE_EQUAL(value < 128 ? 1 : (value < 16384 ? 2 : 10), buffer.size());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,253 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#include <core/CBinaryStatePersistInserter.h>
+#include <core/CBinaryStateRestoreTraverser.h>
+#include <core/CIEEE754.h>
+#include <core/CPersistUtils.h>
+#include <core/CStringUtils.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+BOOST_AUTO_TEST_SUITE(CBinaryStateRestoreTraverserTest)
+
+namespace {
+
+void insert2ndLevel(ml::core::CStatePersistInserter& inserter) {
+    inserter.insertValue("level2A", 3.14, ml::core::CIEEE754::E_SinglePrecision);
+    inserter.insertValue("level2B", 'z');
+}
+
+void insert1stLevel(ml::core::CStatePersistInserter& inserter) {
+    inserter.insertValue("level1A", "a");
+    inserter.insertValue("level1B", 25);
+    inserter.insertLevel("level1C", &insert2ndLevel);
+    inserter.insertLevel("level1D", [](ml::core::CStatePersistInserter&) {});
+    inserter.insertValue("level1E", 1.0 / 3.0, ml::core::CIEEE754::E_DoublePrecision);
+}
+
+std::string persist() {
+    std::ostringstream strm;
+    {
+        ml::core::CBinaryStatePersistInserter inserter(strm);
+        inserter.insertLevel("_source", &insert1stLevel);
+    }
+    return strm.str();
+}
+
+bool traverse2ndLevel(ml::core::CStateRestoreTraverser& traverser) {
+    BOOST_REQUIRE_EQUAL(std::string("level2A"), traverser.name());
+    BOOST_REQUIRE_EQUAL(ml::core::CStringUtils::typeToStringPrecise(
+                            3.14, ml::core::CIEEE754::E_SinglePrecision),
+                        traverser.value());
+    BOOST_TEST_REQUIRE(!traverser.hasSubLevel());
+    BOOST_TEST_REQUIRE(traverser.next());
+    BOOST_REQUIRE_EQUAL(std::string("level2B"), traverser.name());
+    BOOST_REQUIRE_EQUAL(std::string("z"), traverser.value());
+    BOOST_TEST_REQUIRE(!traverser.hasSubLevel());
+    BOOST_TEST_REQUIRE(!traverser.next());
+    return true;
+}
+
+bool traverse2ndLevelEmpty(ml::core::CStateRestoreTraverser& traverser) {
+    BOOST_TEST_REQUIRE(traverser.name().empty());
+    BOOST_TEST_REQUIRE(traverser.value().empty());
+    BOOST_TEST_REQUIRE(!traverser.hasSubLevel());
+    BOOST_TEST_REQUIRE(!traverser.next());
+    return true;
+}
+
+bool traverse1stLevel(ml::core::CStateRestoreTraverser& traverser) {
+    BOOST_REQUIRE_EQUAL(std::string("level1A"), traverser.name());
+    BOOST_REQUIRE_EQUAL(std::string("a"), traverser.value());
+    BOOST_TEST_REQUIRE(!traverser.hasSubLevel());
+    BOOST_TEST_REQUIRE(traverser.next());
+    BOOST_REQUIRE_EQUAL(std::string("level1B"), traverser.name());
+    BOOST_REQUIRE_EQUAL(std::string("25"), traverser.value());
+    BOOST_TEST_REQUIRE(traverser.next());
+    BOOST_REQUIRE_EQUAL(std::string("level1C"), traverser.name());
+    BOOST_TEST_REQUIRE(traverser.hasSubLevel());
+    BOOST_TEST_REQUIRE(traverser.traverseSubLevel(&traverse2ndLevel));
+    BOOST_REQUIRE_EQUAL(std::string("level1C"), traverser.name());
+    BOOST_TEST_REQUIRE(traverser.next());
+    BOOST_REQUIRE_EQUAL(std::string("level1D"), traverser.name());
+    BOOST_TEST_REQUIRE(traverser.hasSubLevel());
+    BOOST_TEST_REQUIRE(traverser.traverseSubLevel(&traverse2ndLevelEmpty));
+    BOOST_TEST_REQUIRE(traverser.next());
+    BOOST_REQUIRE_EQUAL(std::string("level1E"), traverser.name());
+    double value;
+    BOOST_TEST_REQUIRE(ml::core::CStringUtils::stringToType(traverser.value(), value));
+    BOOST_REQUIRE_EQUAL(1.0 / 3.0, value);
+    BOOST_TEST_REQUIRE(!traverser.next());
+    return true;
+}
+
+bool traverseAll(ml::core::CStateRestoreTraverser& traverser) {
+    do {
+        if (traverser.hasSubLevel() && traverser.traverseSubLevel(&traverseAll) == false) {
+            return false;
+        }
+    } while (traverser.next());
+    return traverser.haveBadState() == false;
+}
+
+bool skip1stLevel(ml::core::CStateRestoreTraverser& traverser) {
+    // Only descend into the last sub-level.
+    do {
+        if (traverser.name() == "level1D") {
+            BOOST_TEST_REQUIRE(traverser.traverseSubLevel(&traverse2ndLevelEmpty));
+        }
+    } while (traverser.next());
+    BOOST_REQUIRE_EQUAL(std::string("level1E"), traverser.name());
+    return true;
+}
+}
+
+BOOST_AUTO_TEST_CASE(testRestore) {
+    std::istringstream strm(persist());
+
+    BOOST_TEST_REQUIRE(ml::core::CBinaryStateRestoreTraverser::isBinaryState(strm));
+
+    ml::core::CBinaryStateRestoreTraverser traverser(strm);
+    BOOST_REQUIRE_EQUAL(std::string("_source"), traverser.name());
+    BOOST_TEST_REQUIRE(traverser.hasSubLevel());
+    BOOST_TEST_REQUIRE(traverser.traverseSubLevel(&traverse1stLevel));
+    BOOST_TEST_REQUIRE(!traverser.next());
+    BOOST_TEST_REQUIRE(traverser.isEof());
+    BOOST_TEST_REQUIRE(!traverser.haveBadState());
+}
+
+BOOST_AUTO_TEST_CASE(testSkipping) {
+    std::istringstream strm(persist());
+
+    ml::core::CBinaryStateRestoreTraverser traverser(strm);
+    BOOST_TEST_REQUIRE(traverser.traverseSubLevel(&skip1stLevel));
+    BOOST_TEST_REQUIRE(!traverser.haveBadState());
+}
+
+BOOST_AUTO_TEST_CASE(testMultipleDocuments) {
+    std::istringstream strm(persist() + persist());
+
+    for (std::size_t i = 0; i < 2; ++i) {
+        BOOST_TEST_REQUIRE(!strm.eof());
+        ml::core::CBinaryStateRestoreTraverser traverser(strm);
+        BOOST_TEST_REQUIRE(traverser.traverseSubLevel(&traverse1stLevel));
+        BOOST_REQUIRE_EQUAL(i == 1, traverser.isEof());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testFloatValues) {
+    using TFloatStorageVec = ml::core::CStatePersistInserter::TFloatStorageVec;
+
+    TFloatStorageVec expected{1.0, -0.1, 3.14159, 1e-20, 2.5e10};
+
+    std::ostringstream ostrm;
+    {
+        ml::core::CBinaryStatePersistInserter inserter(ostrm);
+        inserter.insertLevel("_source", [&](ml::core::CStatePersistInserter& inserter_) {
+            inserter_.insertValue("floats", expected);
+            inserter_.insertValue("empty", TFloatStorageVec{});
+        });
+    }
+
+    std::istringstream istrm(ostrm.str());
+    ml::core::CBinaryStateRestoreTraverser traverser(istrm);
+    BOOST_TEST_REQUIRE(traverser.traverseSubLevel([&](ml::core::CStateRestoreTraverser& traverser_) {
+        BOOST_REQUIRE_EQUAL(std::string("floats"), traverser_.name());
+        // The string value should match the delimited format.
+        BOOST_REQUIRE_EQUAL(ml::core::CPersistUtils::toString(expected), traverser_.value());
+        TFloatStorageVec actual;
+        BOOST_TEST_REQUIRE(traverser_.floatValues(actual));
+        BOOST_REQUIRE_EQUAL(ml::core::CPersistUtils::toString(expected),
+                            ml::core::CPersistUtils::toString(actual));
+        BOOST_TEST_REQUIRE(traverser_.next());
+        BOOST_REQUIRE_EQUAL(std::string("empty"), traverser_.name());
+        BOOST_TEST_REQUIRE(traverser_.value().empty());
+        BOOST_TEST_REQUIRE(traverser_.floatValues(actual));
+        BOOST_TEST_REQUIRE(actual.empty());
+        return true;
+    }));
+    BOOST_TEST_REQUIRE(!traverser.haveBadState());
+}
+
+BOOST_AUTO_TEST_CASE(testDoubleValues) {
+    std::ostringstream ostrm;
+    {
+        ml::core::CBinaryStatePersistInserter inserter(ostrm);
+        inserter.insertLevel("_source", [](ml::core::CStatePersistInserter& inserter_) {
+            inserter_.insertValue("single", 1.0 / 3.0, ml::core::CIEEE754::E_SinglePrecision);
+            inserter_.insertValue("double", 1.0 / 7.0, ml::core::CIEEE754::E_DoublePrecision);
+            inserter_.insertValue("string", "0.25");
+        });
+    }
+
+    // Doubles are restored exactly without being converted to strings.
+    std::istringstream istrm(ostrm.str());
+    ml::core::CBinaryStateRestoreTraverser traverser(istrm);
+    BOOST_TEST_REQUIRE(traverser.traverseSubLevel([](ml::core::CStateRestoreTraverser& traverser_) {
+        double value{0.0};
+        BOOST_REQUIRE_EQUAL(std::string("single"), traverser_.name());
+        BOOST_TEST_REQUIRE(traverser_.builtInValue(value));
+        BOOST_REQUIRE_EQUAL(1.0 / 3.0, value);
+        BOOST_TEST_REQUIRE(traverser_.next());
+        BOOST_REQUIRE_EQUAL(std::string("double"), traverser_.name());
+        BOOST_TEST_REQUIRE(traverser_.doubleValue(value));
+        BOOST_REQUIRE_EQUAL(1.0 / 7.0, value);
+        BOOST_TEST_REQUIRE(traverser_.next());
+        BOOST_REQUIRE_EQUAL(std::string("string"), traverser_.name());
+        BOOST_TEST_REQUIRE(traverser_.doubleValue(value));
+        BOOST_REQUIRE_EQUAL(0.25, value);
+        return true;
+    }));
+    BOOST_TEST_REQUIRE(!traverser.haveBadState());
+}
+
+BOOST_AUTO_TEST_CASE(testBadState) {
+    {
+        // Not binary.
+        std::istringstream strm("{\"_source\":{}}");
+        BOOST_TEST_REQUIRE(!ml::core::CBinaryStateRestoreTraverser::isBinaryState(strm));
+        ml::core::CBinaryStateRestoreTraverser traverser(strm);
+        BOOST_TEST_REQUIRE(!traverser.traverseSubLevel(&traverse1stLevel));
+        BOOST_TEST_REQUIRE(traverser.haveBadState());
+    }
+    {
+        // Unsupported version.
+        std::string state{persist()};
+        state[ml::core::CBinaryStatePersistInserter::MARKER.size()] += 1;
+        std::istringstream strm(state);
+        ml::core::CBinaryStateRestoreTraverser traverser(strm);
+        BOOST_TEST_REQUIRE(!traverser.traverseSubLevel(&traverse1stLevel));
+        BOOST_TEST_REQUIRE(traverser.haveBadState());
+    }
+    {
+        // Truncated. The body is read as it's traversed so this is only
+        // detected when we reach the missing values.
+        std::string state{persist()};
+        state.resize(state.size() - 5);
+        std::istringstream strm(state);
+        ml::core::CBinaryStateRestoreTraverser traverser(strm);
+        BOOST_TEST_REQUIRE(!traverser.traverseSubLevel(&traverseAll));
+        BOOST_TEST_REQUIRE(traverser.haveBadState());
+    }
+    {
+        // The stream can't be rewound to traverse a sub-level again.
+        std::istringstream strm(persist());
+        ml::core::CBinaryStateRestoreTraverser traverser(strm);
+        BOOST_TEST_REQUIRE(traverser.traverseSubLevel(&traverse1stLevel));
+        BOOST_TEST_REQUIRE(!traverser.traverseSubLevel(&traverseAll));
+        BOOST_TEST_REQUIRE(traverser.haveBadState());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -53,6 +53,7 @@ private:
 using TDoubleVecStrCache = core::CCompressedLfuCache<TDoubleVec, std::string>;
 using TStrStrCache = core::CCompressedLfuCache<std::string, std::string>;
 using TConcurrentStrStrCache = core::CConcurrentCompressedLfuCache<std::string, std::string>;
+using TShardedStrStrCache = core::CShardedConcurrentCompressedLfuCache<std::string, std::string>;
 using TStrTestValueCache = core::CCompressedLfuCache<std::string, CTestValue>;
 }
 
@@ -628,4 +629,155 @@ BOOST_AUTO_TEST_CASE(testComputeValueReturnsNullOpt) {
     BOOST_REQUIRE_EQUAL(false, valueRead);
 }
 
+BOOST_AUTO_TEST_CASE(testShardedLookup) {
+
+    // Check that items are spread over the shards, we get the same results
+    // as an unsharded cache and that the memory limit is respected.
+
+    TShardedStrStrCache cache{
+        4, 64 * core::constants::BYTES_IN_KILOBYTES, std::chrono::milliseconds{50},
+        [](const TShardedStrStrCache::TDictionary& dictionary,
+           const std::string& key) { return dictionary.word(key); }};
+    BOOST_REQUIRE_EQUAL(4, cache.numberShards());
+
+    for (std::size_t i = 0; i < 100; ++i) {
+        std::string key{"key_" + std::to_string(i)};
+        BOOST_REQUIRE_EQUAL(
+            false, cache.lookup(key, [](std::string key_) { return key_; },
+                                [&](const std::string& value, bool isCacheHit) {
+                                    BOOST_REQUIRE_EQUAL(key, value);
+                                    BOOST_REQUIRE_EQUAL(false, isCacheHit);
+                                }));
+    }
+    BOOST_REQUIRE_EQUAL(100, cache.size());
+    BOOST_REQUIRE_EQUAL(0.0, cache.hitFraction());
+
+    for (std::size_t i = 0; i < 100; ++i) {
+        std::string key{"key_" + std::to_string(i)};
+        BOOST_REQUIRE_EQUAL(
+            true, cache.lookup(key, [](std::string) { return std::nullopt; },
+                               [&](const std::string& value, bool isCacheHit) {
+                                   BOOST_REQUIRE_EQUAL(key, value);
+                                   BOOST_REQUIRE_EQUAL(true, isCacheHit);
+                               }));
+        BOOST_REQUIRE_EQUAL(2, cache.stats(key).second);
+    }
+    BOOST_REQUIRE_EQUAL(0.5, cache.hitFraction());
+    BOOST_TEST_REQUIRE(cache.checkInvariants());
+
+    for (std::size_t i = 100; i < 10000; ++i) {
+        cache.lookup("key_" + std::to_string(i), [](std::string key_) { return key_; },
+                     [](const std::string&, bool) {});
+    }
+    LOG_DEBUG(<< "size = " << cache.size() << " memory = " << cache.memoryUsage());
+    BOOST_TEST_REQUIRE(cache.memoryUsage() <= 64 * core::constants::BYTES_IN_KILOBYTES);
+    BOOST_TEST_REQUIRE(cache.checkInvariants());
+
+    cache.resize(32 * core::constants::BYTES_IN_KILOBYTES);
+    BOOST_TEST_REQUIRE(cache.memoryUsage() <= 32 * core::constants::BYTES_IN_KILOBYTES);
+    BOOST_TEST_REQUIRE(cache.checkInvariants());
+
+    cache.clear();
+    BOOST_REQUIRE_EQUAL(0, cache.size());
+    BOOST_TEST_REQUIRE(cache.checkInvariants());
+}
+
+BOOST_AUTO_TEST_CASE(testShardedConcurrentReadsAndWrites) {
+
+    using TTaskVec = std::vector<std::function<void()>>;
+
+    TShardedStrStrCache cache{
+        8, 64 * core::constants::BYTES_IN_KILOBYTES, std::chrono::milliseconds{50},
+        [](const TShardedStrStrCache::TDictionary& dictionary,
+           const std::string& key) { return dictionary.word(key); }};
+
+    std::atomic<std::size_t> errorCount{0};
+
+    TTaskVec tasks;
+    for (std::size_t i = 0; i < 2000; ++i) {
+        std::string key{"a_long_key_" + std::to_string(i % 50)};
+        tasks.push_back([&cache, &errorCount, key] {
+            cache.lookup(key, [](std::string key_) { return key_; },
+                         [&](const std::string& value, bool) {
+                             if (value != key) {
+                                 ++errorCount;
+                             }
+                         });
+        });
+    }
+
+    {
+        core::CStaticThreadPool pool{4};
+        for (auto& task : tasks) {
+            pool.schedule(std::move(task));
+        }
+    }
+
+    BOOST_REQUIRE_EQUAL(50, cache.size());
+    BOOST_REQUIRE_EQUAL(0, errorCount.load());
+    LOG_DEBUG(<< "hit fraction = " << cache.hitFraction());
+    BOOST_TEST_REQUIRE(cache.hitFraction() > 0.9);
+    BOOST_TEST_REQUIRE(cache.checkInvariants());
+}
+
+BOOST_AUTO_TEST_CASE(testShardedPersist) {
+
+    // Check that persist and restore is idempotent and that we fail to restore
+    // into a cache with a different number of shards.
+
+    auto compressKey = [](const TShardedStrStrCache::TDictionary& dictionary,
+                          const std::string& key) { return dictionary.word(key); };
+
+    TShardedStrStrCache origCache{4, 32 * core::constants::BYTES_IN_KILOBYTES,
+                                  std::chrono::milliseconds{50}, compressKey};
+
+    for (std::size_t i = 0; i < 500; ++i) {
+        origCache.lookup("key_" + std::to_string(i),
+                         [](std::string key_) { return key_; },
+                         [&](const std::string&, bool) {});
+    }
+
+    std::stringstream origJsonStream;
+    {
+        core::CJsonStatePersistInserter inserter{origJsonStream};
+        origCache.acceptPersistInserter(inserter);
+        origJsonStream.flush();
+    }
+
+    LOG_DEBUG(<< "JSON representation is: " << origJsonStream.str());
+
+    {
+        origJsonStream.seekg(0);
+        core::CJsonStateRestoreTraverser traverser{origJsonStream};
+        TShardedStrStrCache restoredCache{4, 32 * core::constants::BYTES_IN_KILOBYTES,
+                                          std::chrono::milliseconds{50}, compressKey};
+        BOOST_TEST_REQUIRE(restoredCache.acceptRestoreTraverser(traverser));
+
+        for (std::size_t i = 0; i < 500; ++i) {
+            auto origStats = origCache.stats("key_" + std::to_string(i));
+            auto restoredStats = restoredCache.stats("key_" + std::to_string(i));
+            BOOST_REQUIRE_EQUAL(origStats.first, restoredStats.first);
+            BOOST_REQUIRE_EQUAL(origStats.second, restoredStats.second);
+        }
+        BOOST_REQUIRE_EQUAL(origCache.hitFraction(), restoredCache.hitFraction());
+
+        std::stringstream restoredJsonStream;
+        {
+            core::CJsonStatePersistInserter inserter{restoredJsonStream};
+            restoredCache.acceptPersistInserter(inserter);
+            restoredJsonStream.flush();
+        }
+        BOOST_REQUIRE_EQUAL(origJsonStream.str(), restoredJsonStream.str());
+        BOOST_TEST_REQUIRE(restoredCache.checkInvariants());
+    }
+    {
+        origJsonStream.clear();
+        origJsonStream.seekg(0);
+        core::CJsonStateRestoreTraverser traverser{origJsonStream};
+        TShardedStrStrCache restoredCache{2, 32 * core::constants::BYTES_IN_KILOBYTES,
+                                          std::chrono::milliseconds{50}, compressKey};
+        BOOST_REQUIRE_EQUAL(false, restoredCache.acceptRestoreTraverser(traverser));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -10,6 +10,7 @@
  */
 
 #include <core/CConcurrentQueue.h>
+#include <core/CContainerPrinter.h>
 #include <core/CLogger.h>
 #include <core/Concurrency.h>
 
@@ -17,9 +18,14 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <exception>
+#include <functional>
+#include <mutex>
 #include <numeric>
+#include <thread>
 #include <vector>
 
 BOOST_AUTO_TEST_SUITE(CConcurrencyTest)
@@ -408,4 +414,119 @@ BOOST_AUTO_TEST_CASE(testProgressMonitoring) {
     core::stopDefaultAsyncExecutor();
 }
 
+BOOST_AUTO_TEST_CASE(testParallelForEachWithWorkStealing) {
+
+    // Test we visit every value exactly once, get the correct results and report
+    // exactly all progress if the loop is load balanced by work stealing.
+
+    core::startDefaultAsyncExecutor(4, 50, 0, core::CExecutor::E_WorkStealing);
+    BOOST_REQUIRE_EQUAL(core::CExecutor::E_WorkStealing,
+                        core::defaultAsyncExecutor().scheduling());
+
+    double totalProgress{0.0};
+    std::mutex totalProgressMutex;
+    auto reportProgress = [&totalProgress, &totalProgressMutex](double progress) {
+        std::lock_guard<std::mutex> lock{totalProgressMutex};
+        totalProgress += progress;
+    };
+
+    for (std::size_t size : {1, 3, 100, 1001}) {
+        LOG_DEBUG(<< "size = " << size);
+
+        totalProgress = 0.0;
+        std::vector<std::atomic_int> visits(size);
+        core::parallel_for_each(std::size_t{0}, size,
+                                [&visits](std::size_t i) {
+                                    // Make the cost of each index very uneven.
+                                    if (i % 50 == 0) {
+                                        std::this_thread::sleep_for(
+                                            std::chrono::milliseconds{2});
+                                    }
+                                    ++visits[i];
+                                },
+                                reportProgress);
+        BOOST_TEST_REQUIRE(std::all_of(visits.begin(), visits.end(),
+                                       [](const auto& visit) { return visit == 1; }));
+        BOOST_REQUIRE_CLOSE_ABSOLUTE(1.0, totalProgress, 1e-14);
+
+        TIntVec values(size);
+        std::iota(values.begin(), values.end(), 0);
+        double expectedSum{static_cast<double>(size * (size - 1) / 2)};
+        BOOST_REQUIRE_EQUAL(expectedSum, parallelSum(values));
+    }
+
+    core::stopDefaultAsyncExecutor();
+}
+
+BOOST_AUTO_TEST_CASE(testParallelTransformReduce) {
+
+    // Test we get the same results as the serial algorithms and that the
+    // result doesn't depend on the number of threads for fixed grain size.
+
+    TIntVec values(10001);
+    std::iota(values.begin(), values.end(), -5000);
+
+    auto square = [&values](std::size_t i) {
+        return static_cast<double>(values[i]) * static_cast<double>(values[i]);
+    };
+    auto add = [](double lhs, double rhs) { return lhs + rhs; };
+
+    double expectedSumSquares{0.0};
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        expectedSumSquares += square(i);
+    }
+
+    std::vector<double> sums;
+    for (std::size_t threads : {1, 2, 4}) {
+        core::startDefaultAsyncExecutor(threads);
+        for (std::size_t grainSize : {1, 7, 1024, 20000}) {
+            BOOST_REQUIRE_EQUAL(expectedSumSquares,
+                                core::parallel_transform_reduce(
+                                    std::size_t{0}, values.size(), 0.0, square,
+                                    add, grainSize));
+        }
+        BOOST_REQUIRE_EQUAL(0, core::parallel_reduce(values.begin(), values.end(), 0,
+                                                     std::plus<int>{}, 100));
+        BOOST_REQUIRE_EQUAL(42, core::parallel_reduce(values.begin(), values.begin(),
+                                                      42, std::plus<int>{}));
+        sums.push_back(core::parallel_transform_reduce(
+            std::size_t{0}, values.size(), 0.0,
+            [&values](std::size_t i) { return 1.0 / (values[i] + 0.5); }, add, 64));
+        core::stopDefaultAsyncExecutor();
+    }
+    BOOST_TEST_REQUIRE(std::all_of(sums.begin(), sums.end(),
+                                   [&](double sum) { return sum == sums[0]; }));
+}
+
+BOOST_AUTO_TEST_CASE(testParallelInclusiveScan) {
+
+    // Test we get the same result as std::partial_sum, including in place.
+
+    for (std::size_t threads : {1, 4}) {
+        core::startDefaultAsyncExecutor(threads);
+        for (std::size_t size : {0, 1, 9, 1000, 1001}) {
+            TIntVec values(size);
+            std::iota(values.begin(), values.end(), 1);
+            TIntVec expected(size);
+            std::partial_sum(values.begin(), values.end(), expected.begin());
+
+            for (std::size_t grainSize : {1, 10, 2000}) {
+                LOG_TRACE(<< "size = " << size << ", grain size = " << grainSize);
+                TIntVec result(size);
+                core::parallel_inclusive_scan(values.begin(), values.end(),
+                                              result.begin(), std::plus<int>{}, grainSize);
+                BOOST_REQUIRE_EQUAL(core::CContainerPrinter::print(expected),
+                                    core::CContainerPrinter::print(result));
+
+                result = values;
+                core::parallel_inclusive_scan(result.begin(), result.end(),
+                                              result.begin(), std::plus<int>{}, grainSize);
+                BOOST_REQUIRE_EQUAL(core::CContainerPrinter::print(expected),
+                                    core::CContainerPrinter::print(result));
+            }
+        }
+        core::stopDefaultAsyncExecutor();
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
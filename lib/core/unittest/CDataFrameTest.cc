@@ -14,7 +14,9 @@
 #include <core/CDataFrame.h>
 #include <core/CDataFrameRowSlice.h>
 #include <core/CFloatStorage.h>
+#include <core/CLogger.h>
 #include <core/CPackedBitVector.h>
+#include <core/CVectorRange.h>
 #include <core/Concurrency.h>
 
 #include <test/CRandomNumbers.h>
@@ -24,8 +26,10 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/unordered_map.hpp>
 
+#include <cmath>
 #include <functional>
 #include <mutex>
+#include <string>
 #include <vector>
 
 BOOST_AUTO_TEST_SUITE(CDataFrameTest)
@@ -227,6 +231,42 @@ BOOST_FIXTURE_TEST_CASE(testOnDiskBasicReadWrite, CTestFixture) {
     BOOST_TEST_REQUIRE(passed);
 }
 
+BOOST_FIXTURE_TEST_CASE(testOnDiskTruncatedSlice, CTestFixture) {
+
+    // Check reading a slice whose file has been truncated is reported as an
+    // error rather than crashing.
+
+    std::size_t rows{2000};
+    std::size_t cols{10};
+    std::size_t capacity{1000};
+    TFloatVec components{testData(rows, cols)};
+
+    auto frameAndDirectory = core::makeDiskStorageDataFrame(
+        test::CTestTmpDir::tmpDir(), cols, rows, capacity);
+    auto frame = std::move(frameAndDirectory.first);
+
+    for (std::size_t i = 0; i < components.size(); i += cols) {
+        frame->writeRow(makeWriter(components, cols, i));
+    }
+    frame->finishWritingRows();
+
+    for (const auto& file : boost::filesystem::directory_iterator(
+             frameAndDirectory.second->name())) {
+        if (boost::filesystem::is_regular_file(file.path())) {
+            boost::filesystem::resize_file(
+                file.path(), boost::filesystem::file_size(file.path()) / 2);
+        }
+    }
+
+    std::vector<std::string> errors;
+    core::CLogger::CScopeSetFatalErrorHandler scope{
+        [&errors](std::string error) { errors.push_back(std::move(error)); }};
+
+    frame->readRows(1, [](const TRowItr&, const TRowItr&) {});
+    BOOST_TEST_REQUIRE(errors.empty() == false);
+    BOOST_TEST_REQUIRE(errors[0].find("failed to read") != std::string::npos);
+}
+
 BOOST_FIXTURE_TEST_CASE(testOnDiskParallelRead, CTestFixture) {
 
     // Check we get the rows we write to the data frame and that we get balanced
@@ -783,6 +823,102 @@ BOOST_FIXTURE_TEST_CASE(testDocHashes, CTestFixture) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testParseAndWriteRows) {
+
+    // Test parsing blocks of rows in parallel matches parsing rows one at a time.
+
+    core::startDefaultAsyncExecutor(4);
+
+    using TStrVec = core::CDataFrame::TStrVec;
+
+    std::size_t rows{5000};
+    std::size_t cols{5};
+
+    test::CRandomNumbers rng;
+    TSizeVec samples;
+    rng.generateUniformSamples(0, 100, rows * (cols + 1), samples);
+
+    // The last field is the document hash and the column map drops the
+    // first field and reverses the others.
+    std::vector<TStrVec> records(rows);
+    const auto& constRecords = records;
+    for (std::size_t i = 0, k = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j, ++k) {
+            if (samples[k] < 5) {
+                records[i].push_back(core::CDataFrame::DEFAULT_MISSING_STRING);
+            } else if (samples[k] < 8) {
+                records[i].push_back("bad");
+            } else if (j % 2 == 0) {
+                records[i].push_back("c" + std::to_string(samples[k] % 17));
+            } else {
+                records[i].push_back(std::to_string(static_cast<double>(samples[k]) / 10.0));
+            }
+        }
+        records[i].push_back(std::to_string(samples[k++]));
+    }
+    core::CDataFrame::TPtrdiffVec columnMap{4, 3, 2, 1, -1};
+
+    auto makeFrame = [&] {
+        auto frame = core::makeMainStorageDataFrame(cols, 1000).first;
+        frame->categoricalColumns(TBoolVec{true, false, true, false, true});
+        return frame;
+    };
+
+    auto expectedFrame = makeFrame();
+    for (const auto& record : constRecords) {
+        expectedFrame->parseAndWriteRow(core::make_range(record, 0, cols),
+                                        &columnMap, &record[cols]);
+    }
+    expectedFrame->finishWritingRows();
+
+    auto frame = makeFrame();
+    for (std::size_t begin = 0; begin < rows; begin += 1024) {
+        core::CDataFrame::TStrCRngVec block;
+        core::CDataFrame::TStrCPtrVec hashes;
+        for (std::size_t i = begin; i < std::min(begin + 1024, rows); ++i) {
+            block.push_back(core::make_range(constRecords[i], 0, cols));
+            hashes.push_back(&records[i][cols]);
+        }
+        frame->parseAndWriteRows(block, &columnMap, &hashes);
+    }
+    frame->finishWritingRows();
+
+    auto read = [&](const core::CDataFrame& frame_) {
+        std::vector<std::pair<TFloatVec, std::int32_t>> result;
+        frame_.readRows(1, [&](const TRowItr& beginRows, const TRowItr& endRows) {
+            for (auto row = beginRows; row != endRows; ++row) {
+                TFloatVec values(cols);
+                row->copyTo(values.begin());
+                result.emplace_back(std::move(values), row->docHash());
+            }
+        });
+        return result;
+    };
+
+    BOOST_REQUIRE_EQUAL(rows, frame->numberRows());
+    BOOST_TEST_REQUIRE(expectedFrame->categoricalColumnValues() ==
+                       frame->categoricalColumnValues());
+
+    auto expectedRows = read(*expectedFrame);
+    auto actualRows = read(*frame);
+    std::size_t numberDifferent{0};
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            double expected{expectedRows[i].first[j]};
+            double actual{actualRows[i].first[j]};
+            // Missing values are NaN.
+            numberDifferent += (expected == actual ||
+                                (std::isnan(expected) && std::isnan(actual)))
+                                   ? 0
+                                   : 1;
+        }
+        numberDifferent += expectedRows[i].second == actualRows[i].second ? 0 : 1;
+    }
+    BOOST_REQUIRE_EQUAL(0, numberDifferent);
+
+    core::stopDefaultAsyncExecutor();
+}
+
 BOOST_FIXTURE_TEST_CASE(testRowMask, CTestFixture) {
 
     // Test we read only the rows in a mask.
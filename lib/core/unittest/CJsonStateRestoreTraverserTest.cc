@@ -10,6 +10,7 @@
  */
 
 #include <core/CJsonStateRestoreTraverser.h>
+#include <core/CStringUtils.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -223,4 +224,50 @@ BOOST_AUTO_TEST_CASE(testRestore1IgnoreArraysNested) {
     BOOST_TEST_REQUIRE(!traverser.next());
 }
 
+BOOST_AUTO_TEST_CASE(testRestoreOverBufferBoundaries) {
+    // Check names and values which are split over buffer boundaries are
+    // restored correctly.
+
+    std::string longValue;
+    for (std::size_t i = 0; i < 50000; ++i) {
+        longValue += static_cast<char>('a' + i % 26);
+    }
+    std::size_t numberElements{5000};
+
+    std::string json{"{\"_source\":{\"long\":\"" + longValue + "\""};
+    for (std::size_t i = 0; i < numberElements; ++i) {
+        std::string index{ml::core::CStringUtils::typeToString(i)};
+        json += ",\"name" + index + "\":{\"value\":\"" + index + "\"}";
+    }
+    json += "}}";
+    std::istringstream strm(json);
+
+    ml::core::CJsonStateRestoreTraverser traverser(strm);
+
+    std::size_t numberRestored{0};
+    auto restoreElement = [&](ml::core::CStateRestoreTraverser& element) {
+        BOOST_REQUIRE_EQUAL(std::string("value"), element.name());
+        BOOST_REQUIRE_EQUAL(ml::core::CStringUtils::typeToString(numberRestored),
+                            element.value());
+        return element.next() == false;
+    };
+    auto restoreSource = [&](ml::core::CStateRestoreTraverser& source) {
+        BOOST_REQUIRE_EQUAL(std::string("long"), source.name());
+        BOOST_REQUIRE_EQUAL(longValue, source.value());
+        while (source.next()) {
+            BOOST_REQUIRE_EQUAL(
+                "name" + ml::core::CStringUtils::typeToString(numberRestored),
+                source.name());
+            BOOST_TEST_REQUIRE(source.traverseSubLevel(restoreElement));
+            ++numberRestored;
+        }
+        return true;
+    };
+
+    BOOST_REQUIRE_EQUAL(std::string("_source"), traverser.name());
+    BOOST_TEST_REQUIRE(traverser.traverseSubLevel(restoreSource));
+    BOOST_REQUIRE_EQUAL(numberElements, numberRestored);
+    BOOST_TEST_REQUIRE(!traverser.next());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,174 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#include <core/CConcurrentWrapper.h>
+#include <core/CLockFreeConcurrentQueue.h>
+#include <core/CLogger.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(CLockFreeConcurrentQueueTest)
+
+using namespace ml;
+
+namespace {
+using TQueue = core::CLockFreeConcurrentQueue<std::size_t>;
+}
+
+BOOST_AUTO_TEST_CASE(testSingleThreaded) {
+
+    // Test FIFO order, capacity and wrapping around the buffer.
+
+    TQueue queue{5};
+    BOOST_TEST_REQUIRE(bool{queue.tryPop() == std::nullopt});
+
+    for (std::size_t i = 0; i < 5; ++i) {
+        BOOST_TEST_REQUIRE(queue.tryPush(std::size_t{i}));
+    }
+    BOOST_REQUIRE_EQUAL(5, queue.size());
+    BOOST_TEST_REQUIRE(queue.tryPush(5) == false);
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        BOOST_REQUIRE_EQUAL(i, queue.pop());
+    }
+    for (std::size_t i = 5; i < 8; ++i) {
+        queue.push(i);
+    }
+    BOOST_TEST_REQUIRE(queue.tryPush(8) == false);
+    for (std::size_t i = 3; i < 8; ++i) {
+        BOOST_REQUIRE_EQUAL(i, *queue.tryPop());
+    }
+    BOOST_REQUIRE_EQUAL(0, queue.size());
+    BOOST_TEST_REQUIRE(bool{queue.tryPopFor(std::chrono::milliseconds(10)) == std::nullopt});
+}
+
+BOOST_AUTO_TEST_CASE(testMinimumCapacity) {
+
+    // Test a capacity of one is rounded up so items are never overwritten.
+
+    TQueue queue{1};
+    BOOST_TEST_REQUIRE(queue.tryPush(1));
+    BOOST_TEST_REQUIRE(queue.tryPush(2));
+    BOOST_TEST_REQUIRE(queue.tryPush(3) == false);
+    BOOST_REQUIRE_EQUAL(1, *queue.tryPop());
+    BOOST_REQUIRE_EQUAL(2, *queue.tryPop());
+    BOOST_TEST_REQUIRE(bool{queue.tryPop() == std::nullopt});
+}
+
+BOOST_AUTO_TEST_CASE(testConditionalPop) {
+
+    // Test a rejected item is left at the head of the queue.
+
+    TQueue queue{4};
+    queue.push(1);
+    queue.push(2);
+
+    auto ifEven = [](std::size_t value) { return value % 2 == 0; };
+    BOOST_TEST_REQUIRE(bool{queue.tryPop(ifEven) == std::nullopt});
+    BOOST_REQUIRE_EQUAL(2, queue.size());
+    BOOST_REQUIRE_EQUAL(1, *queue.tryPop());
+    BOOST_REQUIRE_EQUAL(2, *queue.tryPop(ifEven));
+    BOOST_TEST_REQUIRE(bool{queue.tryPop(ifEven) == std::nullopt});
+}
+
+BOOST_AUTO_TEST_CASE(testMoveOnly) {
+
+    core::CLockFreeConcurrentQueue<std::unique_ptr<int>> queue{2};
+    queue.push(std::make_unique<int>(1));
+    BOOST_TEST_REQUIRE(queue.tryPush(std::make_unique<int>(2)));
+    BOOST_REQUIRE_EQUAL(1, *queue.pop());
+    BOOST_REQUIRE_EQUAL(2, **queue.tryPop());
+}
+
+BOOST_AUTO_TEST_CASE(testMultipleProducersAndConsumers) {
+
+    // Test that every value is popped exactly once when the queue is much
+    // smaller than the number of values so producers and consumers block.
+
+    std::size_t numberValues{100000};
+    std::size_t numberProducers{3};
+    std::size_t numberConsumers{3};
+
+    TQueue queue{16};
+    std::vector<std::atomic_int> popped(numberValues);
+
+    std::vector<std::thread> consumers;
+    for (std::size_t i = 0; i < numberConsumers; ++i) {
+        consumers.emplace_back([&] {
+            for (;;) {
+                std::size_t value{queue.pop()};
+                if (value == numberValues) {
+                    break;
+                }
+                ++popped[value];
+            }
+        });
+    }
+    std::vector<std::thread> producers;
+    for (std::size_t i = 0; i < numberProducers; ++i) {
+        producers.emplace_back([&, i] {
+            for (std::size_t value = i; value < numberValues; value += numberProducers) {
+                if (value % 2 == 0 || queue.tryPush(std::size_t{value}) == false) {
+                    queue.push(value);
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    for (std::size_t i = 0; i < numberConsumers; ++i) {
+        queue.push(numberValues);
+    }
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+
+    std::size_t numberWrong{0};
+    for (const auto& count : popped) {
+        numberWrong += count.load() == 1 ? 0 : 1;
+    }
+    BOOST_REQUIRE_EQUAL(0, numberWrong);
+    BOOST_REQUIRE_EQUAL(0, queue.size());
+}
+
+BOOST_AUTO_TEST_CASE(testConcurrentWrapper) {
+
+    // Test the queue can be used to back a concurrent wrapper.
+
+    std::ostringstream output;
+    {
+        core::CConcurrentWrapper<std::ostringstream, core::CLockFreeConcurrentQueue> wrapper{
+            output, 8, 4};
+        std::vector<std::thread> writers;
+        for (std::size_t i = 0; i < 4; ++i) {
+            writers.emplace_back([&wrapper] {
+                for (std::size_t j = 0; j < 1000; ++j) {
+                    wrapper([](std::ostringstream& o) { o << 'x'; });
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+    }
+    BOOST_REQUIRE_EQUAL(4000, output.str().size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
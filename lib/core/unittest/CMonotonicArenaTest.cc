@@ -0,0 +1,130 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#include <core/CMonotonicArena.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(CMonotonicArenaTest)
+
+using namespace ml;
+
+BOOST_AUTO_TEST_CASE(testAllocate) {
+    core::CMonotonicArena arena{256};
+
+    // Check allocations are aligned and don't overlap.
+    std::vector<std::pair<std::uintptr_t, std::size_t>> allocations;
+    for (std::size_t i = 1; i < 200; ++i) {
+        std::size_t alignment{std::size_t{1} << (i % 5)};
+        auto* address = static_cast<unsigned char*>(arena.allocate(i, alignment));
+        BOOST_REQUIRE(address != nullptr);
+        BOOST_REQUIRE_EQUAL(0, reinterpret_cast<std::uintptr_t>(address) % alignment);
+        std::fill_n(address, i, static_cast<unsigned char>(i));
+        allocations.emplace_back(reinterpret_cast<std::uintptr_t>(address), i);
+    }
+    std::sort(allocations.begin(), allocations.end());
+    for (std::size_t i = 1; i < allocations.size(); ++i) {
+        BOOST_REQUIRE(allocations[i - 1].first + allocations[i - 1].second <=
+                      allocations[i].first);
+    }
+    for (const auto& allocation : allocations) {
+        const auto* address = reinterpret_cast<const unsigned char*>(allocation.first);
+        for (std::size_t i = 0; i < allocation.second; ++i) {
+            BOOST_REQUIRE_EQUAL(allocation.second, static_cast<std::size_t>(address[i]));
+        }
+    }
+
+    // The blocks grow geometrically so the space allocated should be a
+    // small multiple of the bytes requested.
+    std::size_t requested{199 * 200 / 2};
+    BOOST_TEST_REQUIRE(arena.capacity() >= requested);
+    BOOST_TEST_REQUIRE(arena.capacity() < 3 * requested);
+    BOOST_TEST_REQUIRE(arena.memoryUsage() >= arena.capacity());
+}
+
+BOOST_AUTO_TEST_CASE(testLargeAllocation) {
+    core::CMonotonicArena arena{256};
+
+    auto* small = static_cast<unsigned char*>(arena.allocate(8, 8));
+    auto* large = static_cast<unsigned char*>(arena.allocate(10000, 16));
+    BOOST_REQUIRE_EQUAL(0, reinterpret_cast<std::uintptr_t>(large) % 16);
+    std::fill_n(large, 10000, 1);
+    std::fill_n(small, 8, 2);
+    BOOST_REQUIRE_EQUAL(1, static_cast<int>(large[9999]));
+    BOOST_TEST_REQUIRE(arena.capacity() >= 10256);
+}
+
+BOOST_AUTO_TEST_CASE(testRelease) {
+    core::CMonotonicArena arena{256};
+
+    for (std::size_t i = 0; i < 100; ++i) {
+        arena.allocate(64, 8);
+    }
+    BOOST_TEST_REQUIRE(arena.capacity() > 0);
+
+    arena.release();
+    BOOST_REQUIRE_EQUAL(0, arena.capacity());
+
+    // The arena is usable after it has been released.
+    auto* address = static_cast<std::uint64_t*>(arena.allocate(sizeof(std::uint64_t), 8));
+    *address = 42;
+    BOOST_REQUIRE_EQUAL(42, *address);
+    BOOST_REQUIRE_EQUAL(256, arena.capacity());
+}
+
+BOOST_AUTO_TEST_CASE(testContainers) {
+    using TStrAllocator = core::CMonotonicArenaAllocator<std::string>;
+    using TStrDeque = std::deque<std::string, TStrAllocator>;
+    using TSizeStrMap =
+        std::map<std::size_t, std::string, std::less<std::size_t>,
+                 core::CMonotonicArenaAllocator<std::pair<const std::size_t, std::string>>>;
+
+    core::CMonotonicArena arena;
+    core::CMonotonicArena otherArena;
+
+    TStrDeque deque{TStrAllocator{arena}};
+    TSizeStrMap map{TSizeStrMap::allocator_type{arena}};
+    for (std::size_t i = 0; i < 1000; ++i) {
+        deque.push_back(std::to_string(i));
+        map.emplace(i, std::to_string(i));
+    }
+    deque.erase(deque.begin(), deque.begin() + 500);
+    for (std::size_t i = 0; i < 500; ++i) {
+        map.erase(i);
+    }
+    BOOST_REQUIRE_EQUAL(500, deque.size());
+    BOOST_REQUIRE_EQUAL(500, map.size());
+    for (std::size_t i = 0; i < 500; ++i) {
+        BOOST_REQUIRE_EQUAL(std::to_string(i + 500), deque[i]);
+        BOOST_REQUIRE_EQUAL(std::to_string(i + 500), map.at(i + 500));
+    }
+    BOOST_TEST_REQUIRE(otherArena.capacity() == 0);
+
+    // Moving to a container using a different arena copies the elements
+    // into that arena.
+    TStrDeque otherDeque{TStrAllocator{otherArena}};
+    otherDeque = std::move(deque);
+    BOOST_REQUIRE_EQUAL(500, otherDeque.size());
+    BOOST_REQUIRE_EQUAL(std::string{"999"}, otherDeque.back());
+    BOOST_TEST_REQUIRE(otherArena.capacity() > 0);
+    BOOST_REQUIRE(otherDeque.get_allocator() == TStrAllocator{otherArena});
+    BOOST_REQUIRE(otherDeque.get_allocator() != TStrAllocator{arena});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -532,6 +532,54 @@ BOOST_AUTO_TEST_CASE(testBitwise) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testConstantOperands) {
+
+    // Test bitwise operations and inner products where one operand is constant,
+    // which skip the line scan, match those computed from the bits.
+
+    test::CRandomNumbers rng;
+
+    TSizeVec components;
+    for (std::size_t t = 0; t < 20; ++t) {
+        rng.generateUniformSamples(0, 2, 300, components);
+        TBoolVec bits(components.begin(), components.end());
+        core::CPackedBitVector vector{bits};
+
+        for (bool bit : {false, true}) {
+            core::CPackedBitVector constant{bits.size(), bit};
+            TBoolVec expectedAnd(bits.size());
+            TBoolVec expectedOr(bits.size());
+            TBoolVec expectedXor(bits.size());
+            for (std::size_t i = 0; i < bits.size(); ++i) {
+                expectedAnd[i] = bits[i] && bit;
+                expectedOr[i] = bits[i] || bit;
+                expectedXor[i] = bits[i] != bit;
+            }
+            auto count = [](const TBoolVec& x) {
+                return static_cast<double>(std::count(x.begin(), x.end(), true));
+            };
+
+            BOOST_TEST_REQUIRE((vector & constant) == core::CPackedBitVector{expectedAnd});
+            BOOST_TEST_REQUIRE((constant & vector) == core::CPackedBitVector{expectedAnd});
+            BOOST_TEST_REQUIRE((vector | constant) == core::CPackedBitVector{expectedOr});
+            BOOST_TEST_REQUIRE((constant | vector) == core::CPackedBitVector{expectedOr});
+            BOOST_TEST_REQUIRE((vector ^ constant) == core::CPackedBitVector{expectedXor});
+            BOOST_TEST_REQUIRE((constant ^ vector) == core::CPackedBitVector{expectedXor});
+
+            BOOST_REQUIRE_EQUAL(count(expectedAnd), vector.inner(constant));
+            BOOST_REQUIRE_EQUAL(count(expectedAnd), constant.inner(vector));
+            BOOST_REQUIRE_EQUAL(count(expectedOr),
+                                vector.inner(constant, core::CPackedBitVector::E_OR));
+            BOOST_REQUIRE_EQUAL(count(expectedXor),
+                                constant.inner(vector, core::CPackedBitVector::E_XOR));
+        }
+
+        BOOST_REQUIRE_EQUAL(static_cast<double>(std::count(bits.begin(), bits.end(), true)),
+                            vector.manhattan());
+        BOOST_REQUIRE_EQUAL(0.0, vector.inner(vector, core::CPackedBitVector::E_XOR));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testOneBitIterators) {
     {
         // Empty.
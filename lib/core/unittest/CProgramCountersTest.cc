@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <fstream>
+#include <sstream>
 #include <thread>
 
 BOOST_AUTO_TEST_SUITE(CProgramCountersTest)
@@ -408,4 +409,79 @@ BOOST_FIXTURE_TEST_CASE(testMax, ml::test::CProgramCounterClearingFixture) {
     BOOST_REQUIRE_EQUAL(expected, actual);
 }
 
+BOOST_FIXTURE_TEST_CASE(testHistograms, ml::test::CProgramCounterClearingFixture) {
+    using THistogram = ml::core::CProgramCounters::CHistogram;
+
+    // Check every value maps to a bucket whose lower bound doesn't exceed it.
+    for (std::uint64_t value :
+         {std::uint64_t{0}, std::uint64_t{1}, std::uint64_t{15}, std::uint64_t{16},
+          std::uint64_t{17}, std::uint64_t{31}, std::uint64_t{32}, std::uint64_t{1000},
+          std::uint64_t{123456789}, ~std::uint64_t{0}}) {
+        std::size_t bucket{THistogram::bucket(value)};
+        BOOST_TEST_REQUIRE(bucket < THistogram::NUM_BUCKETS);
+        BOOST_TEST_REQUIRE(THistogram::bucketLowerBound(bucket) <= value);
+        if (bucket + 1 < THistogram::NUM_BUCKETS) {
+            BOOST_TEST_REQUIRE(value < THistogram::bucketLowerBound(bucket + 1));
+        }
+    }
+    for (std::size_t bucket = 0; bucket < THistogram::NUM_BUCKETS; ++bucket) {
+        BOOST_REQUIRE_EQUAL(bucket, THistogram::bucket(THistogram::bucketLowerBound(bucket)));
+    }
+
+    auto& histogram =
+        ml::core::CProgramCounters::histogram(ml::counter_t::E_TSADHandleRecordTime);
+    BOOST_REQUIRE_EQUAL(0, histogram.count());
+    BOOST_REQUIRE_EQUAL(0, histogram.percentile(50.0));
+
+    // Add the values 1, 2, ..., 10000 concurrently and check the percentiles
+    // are within the histogram's accuracy.
+    std::thread thread1{[&histogram] {
+        for (std::uint64_t value = 1; value <= 10000; value += 2) {
+            histogram.add(value);
+        }
+    }};
+    std::thread thread2{[&histogram] {
+        for (std::uint64_t value = 2; value <= 10000; value += 2) {
+            histogram.add(value);
+        }
+    }};
+    thread1.join();
+    thread2.join();
+
+    BOOST_REQUIRE_EQUAL(10000, histogram.count());
+    BOOST_REQUIRE_EQUAL(10000, histogram.max());
+    for (double percentile : {1.0, 10.0, 50.0, 90.0, 99.0, 100.0}) {
+        double expected{100.0 * percentile};
+        double actual{static_cast<double>(histogram.percentile(percentile))};
+        LOG_DEBUG(<< "p" << percentile << " expected = " << expected
+                  << ", actual = " << actual);
+        BOOST_TEST_REQUIRE(actual >= expected);
+        BOOST_TEST_REQUIRE(actual <= expected * (1.0 + 1.0 / THistogram::SUB_BUCKETS));
+    }
+
+    // Check the histogram is included in the output.
+    {
+        std::ostringstream ss;
+        ss << ml::core::CProgramCounters::instance();
+        const std::string output(ss.str());
+        LOG_DEBUG(<< output);
+        BOOST_TEST_REQUIRE(output.find("\"E_TSADHandleRecordTime\"") != std::string::npos);
+        BOOST_TEST_REQUIRE(output.find("\"p99\"") != std::string::npos);
+        BOOST_TEST_REQUIRE(output.find("\"E_TSADPersistStateTime\"") == std::string::npos);
+    }
+
+    // Check the scoped timer adds a value.
+    {
+        ml::core::CProgramCounters::CScopedHistogramTimer timer{
+            ml::counter_t::E_TSADPersistStateTime};
+    }
+    BOOST_REQUIRE_EQUAL(1, ml::core::CProgramCounters::histogram(
+                               ml::counter_t::E_TSADPersistStateTime)
+                               .count());
+
+    histogram.clear();
+    BOOST_REQUIRE_EQUAL(0, histogram.count());
+    BOOST_REQUIRE_EQUAL(0, histogram.max());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -9,6 +9,7 @@
  * limitation.
  */
 
+#include <core/CCompressOStream.h>
 #include <core/CJsonStatePersistInserter.h>
 #include <core/CJsonStateRestoreTraverser.h>
 #include <core/CLogger.h>
@@ -21,6 +22,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <iostream>
+#include <stdexcept>
 
 BOOST_AUTO_TEST_SUITE(CStateCompressorTest)
 
@@ -301,4 +303,68 @@ BOOST_AUTO_TEST_CASE(testChunking) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testMultipleBlocks) {
+    // The state is compressed in independent 1MB blocks. Check we restore
+    // it exactly when it spans several blocks, including when its size is
+    // an exact multiple of the block size.
+
+    TRandom rng(2718281828ul);
+    TGenerator generator(rng, TDistribution(0, 254));
+    TGeneratorItr randItr(&generator);
+
+    const std::size_t blockSize{1024 * 1024};
+    for (std::size_t size : {3 * blockSize - 1, 3 * blockSize, 5 * blockSize + 17}) {
+        std::string state;
+        state.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            // Use a small alphabet so the blocks compress well.
+            state += static_cast<char>('a' + *randItr++ % 8);
+        }
+
+        CMockDataAdder adder(1000000);
+        {
+            ml::core::CStateCompressor compressor(adder);
+            ml::core::CDataAdder::TOStreamP strm = compressor.addStreamed("");
+            strm->write(state.data(), static_cast<std::streamsize>(state.size()));
+            BOOST_TEST_REQUIRE(compressor.streamComplete(strm, true));
+        }
+        LOG_DEBUG(<< "Compressed " << size << " bytes into "
+                  << adder.data().size() << " documents");
+
+        std::string decompressed;
+        {
+            CMockDataSearcher searcher(adder);
+            ml::core::CStateDecompressor decompressor(searcher);
+            ml::core::CDataSearcher::TIStreamP strm = decompressor.search(1, 1);
+            std::istreambuf_iterator<char> eos;
+            decompressed.assign(std::istreambuf_iterator<char>(*strm), eos);
+        }
+        BOOST_REQUIRE_EQUAL(state.size(), decompressed.size());
+        BOOST_TEST_REQUIRE(state == decompressed);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCompressionFailure) {
+    // Check that if compressing a block fails we finish and mark the stream
+    // bad rather than waiting forever for the block.
+
+    CMockDataAdder adder(3000);
+    ml::core::CStateCompressor::CChunkFilter filter(adder);
+    std::size_t calls{0};
+    ml::core::CCompressOStream stream(filter, [&calls](const std::string& input,
+                                                       std::string& output) {
+        if (++calls == 2) {
+            throw std::runtime_error("failed to compress");
+        }
+        ml::core::CCompressOStream::gzipBlock(input, output);
+    });
+
+    std::string data(4 * 1024 * 1024 + 1, 'x');
+    stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+    stream.close();
+
+    BOOST_TEST_REQUIRE(calls >= 2);
+    BOOST_TEST_REQUIRE(stream.bad());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -10,6 +10,7 @@
  */
 
 #include <core/CContainerPrinter.h>
+#include <core/CProgramCounters.h>
 #include <core/CStaticThreadPool.h>
 #include <core/CStopWatch.h>
 
@@ -262,4 +263,59 @@ BOOST_AUTO_TEST_CASE(testNumberThreadsInUse) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testWorkStealing) {
+
+    // Check that nested tasks scheduled from a worker are all executed and are
+    // stolen by the idle workers.
+
+    std::uint64_t stolenBefore{core::CProgramCounters::counter(
+        counter_t::E_TPNumberTasksStolen)};
+
+    std::atomic_uint counter{0};
+    std::size_t numberThreads{0};
+    {
+        core::CStaticThreadPool pool{4, 50, core::CExecutor::E_WorkStealing};
+        BOOST_REQUIRE_EQUAL(core::CExecutor::E_WorkStealing, pool.scheduling());
+        numberThreads = pool.numberThreadsInUse();
+
+        // All tasks are pushed onto one worker's deque so the others must steal.
+        pool.schedule([&pool, &counter] {
+            for (std::size_t i = 0; i < 200; ++i) {
+                pool.schedule([&counter] { fastTask(counter); });
+            }
+        });
+
+        for (std::size_t i = 0; i < 1000 && counter.load() < 200; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+        BOOST_REQUIRE_EQUAL(200, counter.load());
+    }
+
+    std::uint64_t stolenAfter{core::CProgramCounters::counter(counter_t::E_TPNumberTasksStolen)};
+    LOG_DEBUG(<< "stolen = " << stolenAfter - stolenBefore);
+    // The pool size is capped by the hardware concurrency.
+    if (numberThreads > 1) {
+        BOOST_TEST_REQUIRE(stolenAfter > stolenBefore);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testWorkStealingShutdown) {
+
+    // Check we execute all the tasks in the deques if the pool is destroyed
+    // while there are still tasks to steal.
+
+    std::atomic_uint counter{0};
+    {
+        core::CStaticThreadPool pool{2, 50, core::CExecutor::E_WorkStealing};
+        for (std::size_t i = 0; i < 10; ++i) {
+            pool.schedule([&pool, &counter] {
+                for (std::size_t j = 0; j < 20; ++j) {
+                    pool.schedule([&counter] { instantTask(counter); });
+                }
+            });
+        }
+    }
+    BOOST_REQUIRE_EQUAL(200, counter.load());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
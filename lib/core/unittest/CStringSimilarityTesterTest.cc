@@ -351,6 +351,15 @@ BOOST_AUTO_TEST_CASE(testWeightedEditDistance) {
 
     BOOST_REQUIRE_EQUAL(21, sst.weightedEditDistance(serviceStart, empty));
     BOOST_REQUIRE_EQUAL(21, sst.weightedEditDistance(empty, serviceStart));
+
+    // Bounded calculations are exact if the distance doesn't exceed the bound
+    // and otherwise return something greater than the bound.
+
+    BOOST_REQUIRE_EQUAL(2, sst.weightedEditDistance(sourceShutDown1, sourceShutDown2, 2));
+    BOOST_REQUIRE_EQUAL(17, sst.weightedEditDistance(sourceShutDown1, serviceStart, 20));
+    BOOST_TEST_REQUIRE(sst.weightedEditDistance(sourceShutDown1, serviceStart, 16) > 16);
+    BOOST_TEST_REQUIRE(sst.weightedEditDistance(noImageData, serviceStart, 5) > 5);
+    BOOST_TEST_REQUIRE(sst.weightedEditDistance(serviceStart, noImageData, 0) > 0);
 }
 
 BOOST_AUTO_TEST_CASE(testPositionalWeightedEditDistance) {
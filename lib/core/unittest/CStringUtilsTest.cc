@@ -15,14 +15,18 @@
 #include <core/CStringUtils.h>
 
 #include <test/BoostTestCloseAbsolute.h>
+#include <test/CRandomNumbers.h>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <cmath>
 #include <cstdint>
 #include <set>
+#include <string_view>
 #include <vector>
 
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -492,6 +496,86 @@ BOOST_AUTO_TEST_CASE(testStringToType) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testStringToDouble) {
+
+    // Test we get exactly the same values as ::strtod for strings which are
+    // and aren't handled by the fast path, and for views of longer strings.
+
+    auto strtodValue = [](const std::string& str, double& value) {
+        char* endPtr{nullptr};
+        errno = 0;
+        value = ::strtod(str.c_str(), &endPtr);
+        // Note that ERANGE is also set for subnormal values.
+        return str.empty() == false && *endPtr == '\0' &&
+               (errno != ERANGE || std::isinf(value) == false);
+    };
+    auto same = [](double lhs, double rhs) {
+        return (std::isnan(lhs) && std::isnan(rhs)) ||
+               (lhs == rhs && std::signbit(lhs) == std::signbit(rhs));
+    };
+
+    std::vector<std::string> strings{"0",
+                                     "-0",
+                                     "+1",
+                                     "1.",
+                                     ".5",
+                                     "-.5e-3",
+                                     "00012.5000",
+                                     "0.000000000000000000000000001",
+                                     "1e22",
+                                     "1e23",
+                                     "9007199254740992",
+                                     "9007199254740993",
+                                     "1234567890123456789",
+                                     "12345678901234567890123",
+                                     "1.7976931348623157e308",
+                                     "4.9e-324",
+                                     "2.2250738585072014e-308",
+                                     " 1.5",
+                                     "0x1p3",
+                                     "inf",
+                                     "-nan"};
+
+    ml::test::CRandomNumbers rng;
+    std::vector<std::size_t> digits;
+    std::vector<std::size_t> exponents;
+    for (std::size_t i = 0; i < 10000; ++i) {
+        rng.generateUniformSamples(0, 10, 1 + i % 25, digits);
+        rng.generateUniformSamples(0, 61, 1, exponents);
+        std::string str{i % 3 == 0 ? "-" : ""};
+        for (std::size_t j = 0; j < digits.size(); ++j) {
+            str += static_cast<char>('0' + digits[j]);
+            if (j == i % 7) {
+                str += '.';
+            }
+        }
+        if (i % 2 == 0) {
+            str += 'e' + std::to_string(static_cast<int>(exponents[0]) - 30);
+        }
+        strings.push_back(std::move(str));
+    }
+
+    std::size_t numberDifferent{0};
+    for (const auto& str : strings) {
+        double expected;
+        BOOST_TEST_REQUIRE(strtodValue(str, expected));
+        double actual;
+        BOOST_TEST_REQUIRE(ml::core::CStringUtils::stringToType(str, actual));
+        numberDifferent += same(expected, actual) ? 0 : 1;
+        std::string padded{"1" + str + "1"};
+        BOOST_TEST_REQUIRE(ml::core::CStringUtils::stringToType(
+            std::string_view{padded}.substr(1, str.size()), actual));
+        numberDifferent += same(expected, actual) ? 0 : 1;
+    }
+    BOOST_REQUIRE_EQUAL(0, numberDifferent);
+
+    for (const auto& str : {"", "-", ".", "e5", "1e", "1e+", "1.5x", "1..2", "1e99999"}) {
+        double value;
+        BOOST_TEST_REQUIRE(!ml::core::CStringUtils::stringToTypeSilent(std::string{str}, value));
+        BOOST_TEST_REQUIRE(!ml::core::CStringUtils::stringToTypeSilent(std::string_view{str}, value));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testTokeniser) {
     std::string str = "sadcasd csac asdcasdc asdc asdc sadc sadc asd csdc ewwef f sdf sd f sdf  sdfsadfasdf\n"
                       "adscasdcadsc\n"
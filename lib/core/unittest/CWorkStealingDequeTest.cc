@@ -0,0 +1,118 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#include <core/CLogger.h>
+#include <core/CWorkStealingDeque.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(CWorkStealingDequeTest)
+
+using namespace ml;
+
+namespace {
+using TDeque = core::CWorkStealingDeque<std::size_t>;
+}
+
+BOOST_AUTO_TEST_CASE(testSingleThreaded) {
+
+    // Test the owner gets LIFO order and thieves get FIFO order.
+
+    TDeque deque{5};
+    BOOST_REQUIRE_EQUAL(8, deque.capacity());
+    BOOST_TEST_REQUIRE(bool{deque.tryPop() == std::nullopt});
+    BOOST_TEST_REQUIRE(bool{deque.trySteal() == std::nullopt});
+
+    for (std::size_t i = 0; i < 8; ++i) {
+        BOOST_TEST_REQUIRE(deque.tryPush(i));
+    }
+    BOOST_REQUIRE_EQUAL(8, deque.size());
+    BOOST_TEST_REQUIRE(deque.tryPush(8) == false);
+
+    BOOST_REQUIRE_EQUAL(7, *deque.tryPop());
+    BOOST_REQUIRE_EQUAL(0, *deque.trySteal());
+    BOOST_REQUIRE_EQUAL(6, *deque.tryPop());
+    BOOST_REQUIRE_EQUAL(1, *deque.trySteal());
+    BOOST_REQUIRE_EQUAL(4, deque.size());
+
+    // Check we correctly wrap around the buffer.
+    for (std::size_t i = 8; i < 12; ++i) {
+        BOOST_TEST_REQUIRE(deque.tryPush(i));
+    }
+    BOOST_TEST_REQUIRE(deque.tryPush(12) == false);
+    for (std::size_t i = 2; i < 6; ++i) {
+        BOOST_REQUIRE_EQUAL(i, *deque.trySteal());
+    }
+    for (std::size_t i = 12; i > 8; --i) {
+        BOOST_REQUIRE_EQUAL(i - 1, *deque.tryPop());
+    }
+    BOOST_REQUIRE_EQUAL(0, deque.size());
+    BOOST_TEST_REQUIRE(bool{deque.tryPop() == std::nullopt});
+    BOOST_TEST_REQUIRE(bool{deque.trySteal() == std::nullopt});
+}
+
+BOOST_AUTO_TEST_CASE(testConcurrentStealing) {
+
+    // Test that with one owner and several thieves every value is taken exactly
+    // once.
+
+    std::size_t numberValues{100000};
+    std::size_t numberThieves{3};
+
+    TDeque deque{64};
+    std::vector<std::atomic_int> taken(numberValues);
+    std::atomic_bool done{false};
+
+    std::vector<std::thread> thieves;
+    for (std::size_t i = 0; i < numberThieves; ++i) {
+        thieves.emplace_back([&] {
+            while (done.load() == false || deque.size() > 0) {
+                auto value = deque.trySteal();
+                if (value != std::nullopt) {
+                    ++taken[*value];
+                }
+            }
+        });
+    }
+
+    for (std::size_t i = 0; i < numberValues; /**/) {
+        if (deque.tryPush(i)) {
+            ++i;
+        }
+        if (i % 3 == 0) {
+            auto value = deque.tryPop();
+            if (value != std::nullopt) {
+                ++taken[*value];
+            }
+        }
+    }
+    done.store(true);
+
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+    for (auto value = deque.tryPop(); value != std::nullopt; value = deque.tryPop()) {
+        ++taken[*value];
+    }
+
+    std::size_t numberTakenOnce{0};
+    for (const auto& count : taken) {
+        numberTakenOnce += count == 1 ? 1 : 0;
+    }
+    BOOST_REQUIRE_EQUAL(numberValues, numberTakenOnce);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -58,12 +58,12 @@ CBoostedTreeNode::CBoostedTreeNode(std::size_t dimensionPrediction)
 CBoostedTreeNode::TNodeIndex CBoostedTreeNode::leafIndex(const CEncodedDataFrameRowRef& row,
                                                          const TNodeVec& tree,
                                                          TNodeIndex index) const {
-    if (this->isLeaf()) {
-        return index;
+    // This is on the critical path for inference so we walk the tree with a
+    // loop rather than recursively.
+    for (const auto* node = this; node->isLeaf() == false; node = &tree[index]) {
+        index = node->assignToLeft(row) ? *node->m_LeftChild : *node->m_RightChild;
     }
-    return this->assignToLeft(row)
-               ? tree[*m_LeftChild].leafIndex(row, tree, *m_LeftChild)
-               : tree[*m_RightChild].leafIndex(row, tree, *m_RightChild);
+    return index;
 }
 
 bool CBoostedTreeNode::assignToLeft(const CEncodedDataFrameRowRef& row) const {
@@ -76,12 +76,11 @@ CBoostedTreeNode::TNodeIndex CBoostedTreeNode::leafIndex(const TRowRef& row,
                                                          const TSizeVec& extraColumns,
                                                          const TNodeVec& tree,
                                                          TNodeIndex index) const {
-    if (this->isLeaf()) {
-        return index;
+    for (const auto* node = this; node->isLeaf() == false; node = &tree[index]) {
+        index = node->assignToLeft(row, extraColumns) ? *node->m_LeftChild
+                                                      : *node->m_RightChild;
     }
-    return this->assignToLeft(row, extraColumns)
-               ? tree[*m_LeftChild].leafIndex(row, extraColumns, tree, *m_LeftChild)
-               : tree[*m_RightChild].leafIndex(row, extraColumns, tree, *m_RightChild);
+    return index;
 }
 
 bool CBoostedTreeNode::assignToLeft(const TRowRef& row, const TSizeVec& extraColumns) const {
@@ -399,6 +399,10 @@ void CBoostedTreeImpl::train(core::CDataFrame& frame,
 
         LOG_TRACE(<< "Test loss = " << m_Hyperparameters.bestForestTestLoss());
 
+        std::uint64_t tuneHyperparametersTime{stopWatch.lap()};
+        core::CProgramCounters::counter(counter_t::E_DFTPMTimeToTuneHyperparameters) =
+            tuneHyperparametersTime;
+
         if (m_BestForest.empty()) {
             m_Hyperparameters.restoreBest();
             m_Hyperparameters.recordHyperparameters(*m_Instrumentation);
@@ -413,6 +417,8 @@ void CBoostedTreeImpl::train(core::CDataFrame& frame,
             m_BestForest = this->trainForest(frame, allTrainingRowMask,
                                              allTrainingRowMask, m_TrainingProgress)
                                .s_Forest;
+            core::CProgramCounters::counter(counter_t::E_DFTPMTimeToTrainFinalForest) =
+                stopWatch.lap() - tuneHyperparametersTime;
 
             this->recordState(recordTrainStateCallback);
         } else {
@@ -575,6 +581,10 @@ void CBoostedTreeImpl::trainIncremental(core::CDataFrame& frame,
                                  std::to_string(m_Hyperparameters.currentRound()));
     }
 
+    std::uint64_t tuneHyperparametersTime{stopWatch.lap()};
+    core::CProgramCounters::counter(counter_t::E_DFTPMTimeToTuneHyperparameters) =
+        tuneHyperparametersTime;
+
     initialLoss += m_Hyperparameters.modelSizePenalty(numberKeptNodes, retrainedNumberNodes);
 
     LOG_TRACE(<< "Incremental training finished after "
@@ -600,6 +610,8 @@ void CBoostedTreeImpl::trainIncremental(core::CDataFrame& frame,
             retrainedTrees = this->updateForest(frame, allTrainingRowMask,
                                                 allTrainingRowMask, m_TrainingProgress)
                                  .s_Forest;
+            core::CProgramCounters::counter(counter_t::E_DFTPMTimeToTrainFinalForest) =
+                stopWatch.lap() - tuneHyperparametersTime;
         }
 
         for (std::size_t i = 0; i < retrainedTrees.size(); ++i) {
@@ -644,9 +656,11 @@ void CBoostedTreeImpl::predict(const core::CPackedBitVector& rowMask,
         m_NumberThreads, 0, frame.numberRows(),
         [&](const TRowItr& beginRows, const TRowItr& endRows) {
             std::size_t dimensionPrediction{m_Loss->dimensionPrediction()};
+            TVector result{dimensionPrediction};
             for (auto row = beginRows; row != endRows; ++row) {
                 auto prediction = readPrediction(*row, m_ExtraColumns, dimensionPrediction);
-                prediction = this->predictRow(m_Encoder->encode(*row));
+                this->predictRow(m_Encoder->encode(*row), result);
+                prediction = result;
             }
         },
         &rowMask);
@@ -1767,6 +1781,7 @@ CBoostedTreeImpl::trainTree(core::CDataFrame& frame,
         scopeMemoryUsage.remove(leaf);
 
         if (leaf->gain() < MINIMUM_RELATIVE_GAIN_PER_SPLIT * totalGain) {
+            leaf->recycle(workspace);
             break;
         }
 
@@ -1834,10 +1849,16 @@ CBoostedTreeImpl::trainTree(core::CDataFrame& frame,
         while (splittableLeaves.size() + i + 1 > maximumNumberInternalNodes) {
             scopeMemoryUsage.remove(splittableLeaves.front());
             workspace.minimumGain(splittableLeaves.front()->gain());
+            splittableLeaves.front()->recycle(workspace);
             splittableLeaves.pop_front();
         }
     }
 
+    // Keep the remaining leaves' derivatives for the next tree.
+    for (auto& leaf : splittableLeaves) {
+        leaf->recycle(workspace);
+    }
+
     tree.shrink_to_fit();
 
     // Flush the maximum memory used by the leaf statistics to the callback.
@@ -2339,11 +2360,16 @@ double CBoostedTreeImpl::betweenFoldTestLossVariance() const {
 }
 
 CBoostedTreeImpl::TVector CBoostedTreeImpl::predictRow(const CEncodedDataFrameRowRef& row) const {
-    TVector result{TVector::Zero(m_Loss->dimensionPrediction())};
+    TVector result{m_Loss->dimensionPrediction()};
+    this->predictRow(row, result);
+    return result;
+}
+
+void CBoostedTreeImpl::predictRow(const CEncodedDataFrameRowRef& row, TVector& result) const {
+    result.setZero();
     for (const auto& tree : m_BestForest) {
         result += root(tree).value(row, tree);
     }
-    return result;
 }
 
 std::size_t CBoostedTreeImpl::maximumTreeSize(const core::CPackedBitVector& trainingRowMask) {
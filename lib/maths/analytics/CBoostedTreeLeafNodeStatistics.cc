@@ -34,6 +34,33 @@ namespace analytics {
 using namespace boosted_tree_detail;
 using TRowItr = core::CDataFrame::TRowItr;
 
+namespace {
+std::size_t readSplit(const core::CFloatStorage* splits, std::size_t feature) {
+    return static_cast<std::size_t>(
+        CPackedUInt8Decorator{splits[feature >> 2]}.readBytes()[feature & 0x3]);
+}
+
+void addSplitsDerivatives(const TSizeVec& featureBag,
+                          const core::CFloatStorage* splits,
+                          const TAlignedMemoryMappedFloatVector& derivatives,
+                          CBoostedTreeLeafNodeStatistics::CSplitsDerivatives& splitsDerivatives) {
+    if (derivatives.size() == 2) {
+        // Single parameter losses, such as MSE and logistic, are the common case
+        // so we read the derivatives once and add them as scalars.
+        double gradient{derivatives(0)};
+        double curvature{derivatives(1)};
+        for (auto feature : featureBag) {
+            splitsDerivatives.addDerivatives(feature, readSplit(splits, feature),
+                                             gradient, curvature);
+        }
+    } else {
+        for (auto feature : featureBag) {
+            splitsDerivatives.addDerivatives(feature, readSplit(splits, feature), derivatives);
+        }
+    }
+}
+}
+
 bool CBoostedTreeLeafNodeStatistics::operator<(const CBoostedTreeLeafNodeStatistics& rhs) const {
     return common::COrderings::lexicographicalCompare(m_BestSplit, m_Id,
                                                       rhs.m_BestSplit, rhs.m_Id);
@@ -87,6 +114,10 @@ core::CPackedBitVector& CBoostedTreeLeafNodeStatistics::rowMask() {
     return m_RowMask;
 }
 
+void CBoostedTreeLeafNodeStatistics::recycle(CWorkspace& workspace) {
+    workspace.recycle(std::move(m_Derivatives));
+}
+
 std::size_t CBoostedTreeLeafNodeStatistics::memoryUsage() const {
     return core::memory::dynamicSize(m_RowMask) + core::memory::dynamicSize(m_Derivatives);
 }
@@ -243,12 +274,8 @@ void CBoostedTreeLeafNodeStatistics::addRowDerivatives(CLookAheadBound,
         }
     }
 
-    const auto* splits = beginSplits(row, m_ExtraColumns);
-    for (auto feature : featureBag) {
-        std::size_t split{static_cast<std::size_t>(
-            CPackedUInt8Decorator{splits[feature >> 2]}.readBytes()[feature & 0x3])};
-        splitsDerivatives.addDerivatives(feature, split, derivatives);
-    }
+    addSplitsDerivatives(featureBag, beginSplits(row, m_ExtraColumns), derivatives,
+                         splitsDerivatives);
 }
 
 void CBoostedTreeLeafNodeStatistics::addRowDerivatives(CNoLookAheadBound,
@@ -258,12 +285,8 @@ void CBoostedTreeLeafNodeStatistics::addRowDerivatives(CNoLookAheadBound,
 
     auto derivatives = readLossDerivatives(row, m_ExtraColumns, m_DimensionGradient);
 
-    const auto* splits = beginSplits(row, m_ExtraColumns);
-    for (auto feature : featureBag) {
-        std::size_t split = static_cast<std::size_t>(
-            CPackedUInt8Decorator{splits[feature >> 2]}.readBytes()[feature & 0x3]);
-        splitsDerivatives.addDerivatives(feature, split, derivatives);
-    }
+    addSplitsDerivatives(featureBag, beginSplits(row, m_ExtraColumns), derivatives,
+                         splitsDerivatives);
 }
 
 CBoostedTreeLeafNodeStatistics::SSplitStatistics&
@@ -13,6 +13,7 @@
 
 #include <core/CDataFrame.h>
 #include <core/CPersistUtils.h>
+#include <core/CSmallVector.h>
 #include <core/Concurrency.h>
 
 #include <maths/analytics/CBoostedTreeUtils.h>
@@ -39,6 +40,8 @@ using namespace boosted_tree_detail;
 using TRowItr = core::CDataFrame::TRowItr;
 
 namespace {
+using TDouble32Vec = core::CSmallVector<double, 32>;
+
 const double EPSILON{100.0 * std::numeric_limits<double>::epsilon()};
 const double LOG_EPSILON{common::CTools::stableLog(EPSILON)};
 
@@ -1742,15 +1745,22 @@ void CMultinomialLogisticLoss::curvature(const TMemoryMappedFloatVector& predict
     pEps = common::CTools::stable(pEps / logZ);
     logZ = zmax + common::CTools::stableLog(logZ);
 
+    // The off-diagonal terms are p_i p_j so we compute the probabilities once
+    // rather than taking O(classes^2) exponentials. This only allocates if the
+    // number of classes exceeds the small vector's inline capacity.
+    TDouble32Vec p(prediction.size());
+    for (int i = 0; i < prediction.size(); ++i) {
+        p[i] = common::CTools::stableExp(prediction(i) - logZ);
+    }
+
     std::size_t k{0};
     for (int i = 0; i < prediction.size(); ++i) {
-        double pi{common::CTools::stableExp(prediction(i) - logZ)};
+        double pi{p[i]};
         // We have that p = 1 / (1 + eps) and the curvature is p (1 - p).
         // Use a Taylor expansion and drop terms of O(eps^2) to get:
         writer(k++, weight * (pi == 1.0 ? pEps : pi * (1.0 - pi)));
         for (int j = i + 1; j < prediction.size(); ++j) {
-            double pij{common::CTools::stableExp(prediction(i) + prediction(j) - 2.0 * logZ)};
-            writer(k++, -weight * pij);
+            writer(k++, -weight * common::CTools::stable(pi * p[j]));
         }
     }
     LOG_TRACE(<< "Wrote " << k << " curvatures");
@@ -957,12 +957,6 @@ CDataFrameUtils::TSizeDoublePrVecVecVec CDataFrameUtils::categoricalMicWithColum
     TSizeDoublePrVecVecVec encoderMics;
     encoderMics.reserve(encoderFactories.size());
 
-    TFloatVecVec samples;
-    TSizeEncoderPtrUMap encoders;
-    CMic mic;
-    samples.reserve(numberSamples);
-    mic.reserve(numberSamples);
-
     for (const auto& encoderFactory : encoderFactories) {
 
         TEncoderFactory makeEncoder;
@@ -971,11 +965,15 @@ CDataFrameUtils::TSizeDoublePrVecVecVec CDataFrameUtils::categoricalMicWithColum
 
         TSizeDoublePrVecVec mics(frame.numberColumns());
 
-        for (auto i : columnMask) {
+        // Columns are independent so we process them in parallel.
+        core::parallel_for_each(columnMask.begin(), columnMask.end(), [
+            &, samples = TFloatVecVec{}, mic = CMic{}
+        ](std::size_t i) mutable {
 
             // Sample
 
             samples.clear();
+            samples.reserve(numberSamples);
             TRowSampler sampler{numberSamples, rowFeatureSampler(i, target, samples)};
             frame.readRows(
                 1, 0, frame.numberRows(),
@@ -995,7 +993,7 @@ CDataFrameUtils::TSizeDoublePrVecVecVec CDataFrameUtils::categoricalMicWithColum
 
             // Setup encoders
 
-            encoders.clear();
+            TSizeEncoderPtrUMap encoders;
             for (const auto& sample : samples) {
                 std::size_t category{static_cast<std::size_t>(sample[0])};
                 auto encoder = makeEncoder(i, 0, category);
@@ -1003,9 +1001,10 @@ CDataFrameUtils::TSizeDoublePrVecVecVec CDataFrameUtils::categoricalMicWithColum
                 encoders.emplace(hash, std::move(encoder));
             }
 
+            mic.reserve(samples.size());
             auto target_ = [](const TFloatVec& sample) { return sample[1]; };
             mics[i] = computeEncodedCategory(mic, target_, encoders, samples);
-        }
+        });
 
         encoderMics.push_back(std::move(mics));
     }
@@ -1026,10 +1025,7 @@ CDataFrameUtils::TSizeDoublePrVecVecVec CDataFrameUtils::categoricalMicWithColum
     encoderMics.reserve(encoderFactories.size());
 
     TFloatVecVec samples;
-    TSizeEncoderPtrUMap encoders;
-    CMic mic;
     samples.reserve(numberSamples);
-    mic.reserve(numberSamples);
 
     for (const auto& encoderFactory : encoderFactories) {
 
@@ -1058,11 +1054,14 @@ CDataFrameUtils::TSizeDoublePrVecVecVec CDataFrameUtils::categoricalMicWithColum
                        &rowMask);
         LOG_TRACE(<< "# samples = " << samples.size());
 
-        for (auto i : columnMask) {
+        // Columns are independent so we process them in parallel.
+        core::parallel_for_each(columnMask.begin(), columnMask.end(), [
+            &, mic = CMic{}
+        ](std::size_t i) mutable {
 
             // Setup encoders
 
-            encoders.clear();
+            TSizeEncoderPtrUMap encoders;
             for (const auto& sample : samples) {
                 if (isMissing(sample[i])) {
                     continue;
@@ -1075,8 +1074,9 @@ CDataFrameUtils::TSizeDoublePrVecVecVec CDataFrameUtils::categoricalMicWithColum
                 }
             }
 
+            mic.reserve(samples.size());
             mics[i] = computeEncodedCategory(mic, target, encoders, samples);
-        }
+        });
 
         encoderMics.push_back(std::move(mics));
     }
@@ -1093,11 +1093,16 @@ CDataFrameUtils::metricMicWithColumnDataFrameInMemory(const CColumnValue& target
 
     TDoubleVec mics(frame.numberColumns(), 0.0);
 
-    TFloatVecVec samples;
-    samples.reserve(numberSamples);
     double numberMaskedRows{rowMask.manhattan()};
 
-    for (auto i : columnMask) {
+    // Each column is sampled and scored independently so we do them in parallel.
+    // Every sampler uses the same default seeded generator so the result doesn't
+    // depend on the number of threads.
+    core::parallel_for_each(columnMask.begin(), columnMask.end(), [
+        &, samples = TFloatVecVec{}
+    ](std::size_t i) mutable {
+
+        samples.reserve(numberSamples);
 
         // Do sampling
 
@@ -1132,7 +1137,7 @@ CDataFrameUtils::metricMicWithColumnDataFrameInMemory(const CColumnValue& target
 
         mics[i] = (1.0 - fractionMissing) * mic.compute();
         samples.clear();
-    }
+    });
 
     return mics;
 }
@@ -1181,7 +1186,7 @@ CDataFrameUtils::metricMicWithColumnDataFrameOnDisk(const CColumnValue& target,
 
     // Compute MICe
 
-    for (auto i : columnMask) {
+    core::parallel_for_each(columnMask.begin(), columnMask.end(), [&](std::size_t i) {
         CMic mic;
         mic.reserve(samples.size());
         for (const auto& sample : samples) {
@@ -1190,7 +1195,7 @@ CDataFrameUtils::metricMicWithColumnDataFrameOnDisk(const CColumnValue& target,
             }
         }
         mics[i] = (1.0 - fractionMissing[i]) * mic.compute();
-    }
+    });
 
     return mics;
 }
@@ -224,6 +224,7 @@ private:
         void proportionOfRuntimePerMethod(double proportion);
 
         void addOutlierScores(const std::vector<POINT>& points,
+                              double eps,
                               TScorerVec& scores,
                               const TMemoryUsageCallback& recordMemoryUsage) const;
 
@@ -397,8 +398,16 @@ CEnsemble<POINT>::computeOutlierScores(const std::vector<POINT>& points) const {
     TScorerVec scores(points.size());
     m_RecordMemoryUsage(core::memory::dynamicSize(scores));
 
+    // The tolerance only depends on the points so compute it once for all models.
+    TMeanAccumulator meanNorm;
+    for (const auto& point : points) {
+        meanNorm.add(common::las::norm(point));
+    }
+    double eps{COutliers::EPS * common::CBasicStatistics::mean(meanNorm)};
+    LOG_TRACE(<< "eps = " << eps);
+
     for (const auto& model : m_Models) {
-        model.addOutlierScores(points, scores, m_RecordMemoryUsage);
+        model.addOutlierScores(points, eps, scores, m_RecordMemoryUsage);
     }
     return scores;
 }
@@ -746,6 +755,7 @@ void CEnsemble<POINT>::CModel::proportionOfRuntimePerMethod(double proportion) {
 
 template<typename POINT>
 void CEnsemble<POINT>::CModel::addOutlierScores(const std::vector<POINT>& points,
+                                                double eps,
                                                 TScorerVec& scores,
                                                 const TMemoryUsageCallback& recordMemoryUsage) const {
     // This index is used for addressing an array in the cache of nearest neighbour
@@ -753,15 +763,11 @@ void CEnsemble<POINT>::CModel::addOutlierScores(const std::vector<POINT>& points
     // it doesn't overlap the indices of any of the sampled model points.
     std::size_t index{this->numberPoints()};
 
-    TPointVec points_;
-    points_.reserve(points.size());
-    TMeanAccumulator meanNorm;
-    for (std::size_t i = 0; i < points.size(); ++i, ++index) {
-        points_.emplace_back(m_Projection * points[i], index);
-        meanNorm.add(common::las::norm(points[i]));
-    }
-    double eps{COutliers::EPS * common::CBasicStatistics::mean(meanNorm)};
-    LOG_TRACE(<< "eps = " << eps);
+    // Projecting is independent for each point so we do it in parallel.
+    TPointVec points_(points.size());
+    core::parallel_for_each(0, points.size(), [&](std::size_t i) {
+        points_[i] = TPoint{m_Projection * points[i], index + i};
+    });
 
     std::int64_t pointsMemory{signedMemoryUsage(points_)};
     recordMemoryUsage(pointsMemory);
@@ -779,15 +785,17 @@ void CEnsemble<POINT>::CModel::addOutlierScores(const std::vector<POINT>& points
     recordMemoryUsage(signedMemoryUsage(m_Method) - methodMemoryAfterRun);
     std::int64_t scoresMemoryBeforeAdd{signedMemoryUsage(scores)};
 
-    // Update the scores.
-    TDouble1Vec2Vec pointScores(methodScores.size());
-    for (std::size_t i = 0; i < points_.size(); ++i) {
-        index = points_[i].annotation();
-        for (std::size_t j = 0; j < methodScores.size(); ++j) {
-            pointScores[j] = std::move(methodScores[j][index]);
-        }
-        scores[i].add(m_LogScoreMoments, pointScores);
-    }
+    // Update the scores. Each point's scorer is only touched by one task and
+    // models are still added in order so this is deterministic.
+    core::parallel_for_each(
+        0, points_.size(),
+        [&, pointScores = TDouble1Vec2Vec(methodScores.size()) ](std::size_t i) mutable {
+            std::size_t index_{points_[i].annotation()};
+            for (std::size_t j = 0; j < methodScores.size(); ++j) {
+                pointScores[j] = std::move(methodScores[j][index_]);
+            }
+            scores[i].add(m_LogScoreMoments, pointScores);
+        });
 
     recordMemoryUsage(signedMemoryUsage(scores) - scoresMemoryBeforeAdd - pointsMemory);
 }
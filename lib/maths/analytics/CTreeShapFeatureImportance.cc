@@ -50,6 +50,17 @@ CTreeShapFeatureImportance::CTreeShapFeatureImportance(std::size_t numberThreads
     }
 
     computeInternalNodeValues(forest);
+
+    // These are independent of the row so we compute them once up front rather
+    // than in every traversal.
+    m_InputColumnIndices.resize(encoder.numberEncodedColumns());
+    for (std::size_t i = 0; i < m_InputColumnIndices.size(); ++i) {
+        m_InputColumnIndices[i] = encoder.encoding(i).inputColumnIndex();
+    }
+    m_NodeFractions.reserve(forest.size());
+    for (const auto& tree : forest) {
+        m_NodeFractions.push_back(nodeFractions(tree));
+    }
 }
 
 void CTreeShapFeatureImportance::shap(const TRowRef& row, TShapWriter writer) {
@@ -58,16 +69,16 @@ void CTreeShapFeatureImportance::shap(const TRowRef& row, TShapWriter writer) {
         return;
     }
 
-    using TTreeShapVec = std::vector<std::function<void(const TTree&)>>;
+    using TTreeShapVec = std::vector<std::function<void(std::size_t)>>;
 
     auto encodedRow{m_Encoder->encode(row)};
 
     if (m_PerThreadShapValues.size() == 1) {
         m_ReducedShapValues.assign(m_Encoder->numberInputColumns(),
                                    common::las::zero((*m_Forest)[0][0].value()));
-        for (const auto& tree : *m_Forest) {
+        for (std::size_t i = 0; i < m_Forest->size(); ++i) {
             this->shapRecursive(
-                tree, encodedRow, 0, 1.0, 1.0, -1,
+                (*m_Forest)[i], m_NodeFractions[i], encodedRow, 0, 1.0, 1.0, -1,
                 CSplitPath{m_PathStorage[0].begin(), m_ScaleStorage[0].begin()},
                 0, m_ReducedShapValues);
         }
@@ -77,15 +88,16 @@ void CTreeShapFeatureImportance::shap(const TRowRef& row, TShapWriter writer) {
         for (std::size_t i = 0; i < m_PerThreadShapValues.size(); ++i) {
             m_PerThreadShapValues[i].assign(m_Encoder->numberInputColumns(),
                                             common::las::zero((*m_Forest)[0][0].value()));
-            computeTreeShap.push_back([&encodedRow, i, this](const TTree& tree) {
-                this->shapRecursive(tree, encodedRow, 0, 1.0, 1.0, -1,
+            computeTreeShap.push_back([&encodedRow, i, this](std::size_t tree) {
+                this->shapRecursive((*m_Forest)[tree], m_NodeFractions[tree],
+                                    encodedRow, 0, 1.0, 1.0, -1,
                                     CSplitPath{m_PathStorage[i].begin(),
                                                m_ScaleStorage[i].begin()},
                                     0, m_PerThreadShapValues[i]);
             });
         }
 
-        core::parallel_for_each(m_Forest->begin(), m_Forest->end(), computeTreeShap);
+        core::parallel_for_each(0, m_Forest->size(), computeTreeShap);
 
         m_ReducedShapValues = m_PerThreadShapValues[0];
         for (std::size_t i = 1; i < m_PerThreadShapValues.size(); ++i) {
@@ -174,6 +186,21 @@ void CTreeShapFeatureImportance::computeInternalNodeValues(TTree& tree, std::siz
     }
 }
 
+CTreeShapFeatureImportance::TDoubleVec
+CTreeShapFeatureImportance::nodeFractions(const TTree& tree) {
+    TDoubleVec result(tree.size(), 1.0);
+    for (const auto& node : tree) {
+        if (node.isLeaf() == false) {
+            auto numberSamples = static_cast<double>(node.numberSamples());
+            for (auto child : {node.leftChildIndex(), node.rightChildIndex()}) {
+                result[child] = static_cast<double>(tree[child].numberSamples()) /
+                                numberSamples;
+            }
+        }
+    }
+    return result;
+}
+
 std::size_t CTreeShapFeatureImportance::depth(const TTreeVec& forest) {
     std::size_t maxDepth{0};
     for (const auto& tree : forest) {
@@ -191,6 +218,7 @@ std::size_t CTreeShapFeatureImportance::depth(const TTree& tree, std::size_t nod
 }
 
 void CTreeShapFeatureImportance::shapRecursive(const TTree& tree,
+                                               const TDoubleVec& nodeFractions,
                                                const CEncodedDataFrameRowRef& encodedRow,
                                                std::size_t nodeIndex,
                                                double parentFractionZero,
@@ -206,8 +234,7 @@ void CTreeShapFeatureImportance::shapRecursive(const TTree& tree,
         const TVector& leafValue{tree[nodeIndex].value()};
         for (int i = 1; i < nextIndex; ++i) {
             double scale{sumUnwoundPath(splitPath, i, nextIndex)};
-            std::size_t inputColumnIndex{
-                m_Encoder->encoding(splitPath.featureIndex(i)).inputColumnIndex()};
+            std::size_t inputColumnIndex{m_InputColumnIndices[splitPath.featureIndex(i)]};
 
             // Consider that:
             //   1. inputColumnIndex is read by seeing what the split feature at position
@@ -249,16 +276,12 @@ void CTreeShapFeatureImportance::shapRecursive(const TTree& tree,
             unwindPath(splitPath, pathIndex, nextIndex);
         }
 
-        double hotFractionZero{incomingFractionZero *
-                               static_cast<double>(tree[hotIndex].numberSamples()) /
-                               static_cast<double>(tree[nodeIndex].numberSamples())};
-        double coldFractionZero{incomingFractionZero *
-                                static_cast<double>(tree[coldIndex].numberSamples()) /
-                                static_cast<double>(tree[nodeIndex].numberSamples())};
-        this->shapRecursive(tree, encodedRow, hotIndex, hotFractionZero, incomingFractionOne,
-                            splitFeature, splitPath, nextIndex, shap);
-        this->shapRecursive(tree, encodedRow, coldIndex, coldFractionZero, 0.0,
-                            splitFeature, splitPath, nextIndex, shap);
+        double hotFractionZero{incomingFractionZero * nodeFractions[hotIndex]};
+        double coldFractionZero{incomingFractionZero * nodeFractions[coldIndex]};
+        this->shapRecursive(tree, nodeFractions, encodedRow, hotIndex, hotFractionZero,
+                            incomingFractionOne, splitFeature, splitPath, nextIndex, shap);
+        this->shapRecursive(tree, nodeFractions, encodedRow, coldIndex, coldFractionZero,
+                            0.0, splitFeature, splitPath, nextIndex, shap);
     }
 }
 
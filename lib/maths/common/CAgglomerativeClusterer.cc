@@ -218,10 +218,11 @@ void nnCluster(TDoubleVecVec& distanceMatrix, UPDATE update, TDoubleSizeSizePrPr
     TSizeVec chain;
     chain.reserve(N);
     TDoubleVec size(N, 1.0);
-    TSizeVec rightmost;
-    rightmost.reserve(2 * N - 1);
+    // Note that new nodes are indexed N, N + 1, ..., 2N - 2 so the table
+    // must be sized for all of them up front.
+    TSizeVec rightmost(2 * N - 1);
     for (std::size_t i = 0; i < N; ++i) {
-        rightmost.push_back(i);
+        rightmost[i] = i;
     }
 
     std::size_t a = 0;
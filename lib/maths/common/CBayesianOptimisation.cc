@@ -44,6 +44,7 @@ using TMeanAccumulator = CBasicStatistics::SSampleMean<double>::TAccumulator;
 using TMeanVarAccumulator = CBasicStatistics::SSampleMeanVar<double>::TAccumulator;
 using TMinAccumulator =
     CBasicStatistics::COrderStatisticsHeap<std::pair<double, CBayesianOptimisation::TVector>>;
+using TVectorVec = std::vector<CBayesianOptimisation::TVector>;
 
 const std::string VERSION_7_5_TAG{"7.5"};
 const std::string MIN_BOUNDARY_TAG{"min_boundary"};
@@ -253,12 +254,18 @@ CBayesianOptimisation::maximumExpectedImprovement(std::size_t numberRounds,
 
         CLbfgs<TVector> lbfgs{10};
 
-        TVector xcand;
-        double fcand;
+        // The restarts are independent so we minimize them in parallel and then
+        // select the best candidate in the order of the probes.
+        TVectorVec x0s;
+        x0s.reserve(probes.count());
         for (auto& x0 : probes) {
             LOG_TRACE(<< "x0 = " << x0.second.transpose());
-            std::tie(xcand, fcand) = lbfgs.constrainedMinimize(
-                minusEI, minusEIGradient, a, b, std::move(x0.second), rho);
+            x0s.push_back(std::move(x0.second));
+        }
+        auto candidates = lbfgs.multiStartConstrainedMinimize(
+            minusEI, minusEIGradient, a, b, x0s, rho);
+
+        for (auto & [ xcand, fcand ] : candidates) {
             LOG_TRACE(<< "xcand = " << xcand.transpose() << " EI(cand) = " << fcand);
             if (-fcand > fmax + negligibleExpectedImprovement ||
                 this->dissimilarity(xcand) > this->dissimilarity(xmax)) {
@@ -513,7 +520,7 @@ CBayesianOptimisation::minusLikelihoodAndGradient() const {
             gradient(0) -= di / a(0);
         }
         for (int i = 1; i < a.size(); ++i) {
-            dKdai = this->dKerneld(a, i);
+            dKdai = this->dKerneld(a, K, i);
             for (int j = 0; j < Kinvf.size(); ++j) {
                 double di{(Kinvf(j) * Kinvf.transpose() - Kinv.row(j)) * dKdai.col(j)};
                 gradient(i) += 0.5 * di;
@@ -677,8 +684,14 @@ CBayesianOptimisation::maximumLikelihoodKernel(std::size_t numberRounds) {
             probes.add({la, std::move(a)});
         }
 
+        // The restarts are independent so we minimize them in parallel.
+        TVectorVec a0s;
+        a0s.reserve(probes.count());
         for (auto& a0 : probes) {
-            std::tie(a, la) = lbfgs.minimize(l, g, std::move(a0.second), 1e-8, 75);
+            a0s.push_back(std::move(a0.second));
+        }
+        if (a0s.empty() == false) {
+            std::tie(a, la) = lbfgs.multiStartMinimize(l, g, a0s, 1e-8, 75);
             if (COrderings::lexicographicalCompare(la, a.norm(), lmax, amax.norm())) {
                 lmax = la;
                 amax = std::move(a);
@@ -779,16 +792,18 @@ double CBayesianOptimisation::meanErrorVariance() const {
            std::min(m_ExplainedErrorVariance, 0.99 * CBasicStatistics::mean(variance));
 }
 
-CBayesianOptimisation::TMatrix CBayesianOptimisation::dKerneld(const TVector& a, int k) const {
+CBayesianOptimisation::TMatrix
+CBayesianOptimisation::dKerneld(const TVector& a, const TMatrix& K, int k) const {
+    // The kernel values don't depend on k so we read them from K rather than
+    // recomputing them for every kernel parameter.
     TMatrix result{m_FunctionMeanValues.size(), m_FunctionMeanValues.size()};
     for (std::size_t i = 0; i < m_FunctionMeanValues.size(); ++i) {
         result(i, i) = 0.0;
         const TVector& xi{m_FunctionMeanValues[i].first};
         for (std::size_t j = 0; j < i; ++j) {
             const TVector& xj{m_FunctionMeanValues[j].first};
-            result(i, j) = result(j, i) = 2.0 * a(k) *
-                                          CTools::pow2(xi(k - 1) - xj(k - 1)) *
-                                          this->kernel(a, xi, xj);
+            result(i, j) = result(j, i) =
+                2.0 * a(k) * CTools::pow2(xi(k - 1) - xj(k - 1)) * K(i, j);
         }
     }
     return result;
@@ -409,6 +409,40 @@ void CBjkstUniqueValues::remove(std::uint32_t value) {
     }
 }
 
+bool CBjkstUniqueValues::merge(const CBjkstUniqueValues& other) {
+    if (other.m_NumberHashes != m_NumberHashes || other.m_MaxSize != m_MaxSize) {
+        LOG_ERROR(<< "Can't merge sketches with different parameters");
+        return false;
+    }
+
+    const TUInt32Vec* values = std::get_if<TUInt32Vec>(&other.m_Sketch);
+    if (values != nullptr) {
+        for (auto value : *values) {
+            this->add(value);
+        }
+        return true;
+    }
+    if (std::get_if<TUInt32Vec>(&m_Sketch) != nullptr) {
+        CBjkstUniqueValues result{other};
+        result.merge(*this);
+        this->swap(result);
+        return true;
+    }
+
+    try {
+        auto& sketch = std::get<SSketch>(m_Sketch);
+        const auto& otherSketch = std::get<SSketch>(other.m_Sketch);
+        if (sketch.s_G != otherSketch.s_G || sketch.s_H != otherSketch.s_H) {
+            LOG_ERROR(<< "Can't merge sketches with different hashes");
+            return false;
+        }
+        sketch.merge(m_MaxSize, otherSketch);
+    } catch (const std::exception& e) {
+        LOG_ABORT(<< "Unexpected exception: " << e.what());
+    }
+    return true;
+}
+
 std::uint32_t CBjkstUniqueValues::number() const {
     const TUInt32Vec* values = std::get_if<TUInt32Vec>(&m_Sketch);
     if (values == nullptr) {
@@ -628,6 +662,33 @@ void CBjkstUniqueValues::SSketch::remove(std::uint32_t value) {
     }
 }
 
+void CBjkstUniqueValues::SSketch::merge(std::size_t maxSize, const SSketch& other) {
+    for (std::size_t i = 0; i < s_Z.size(); ++i) {
+        TUInt8Vec& b = s_B[i];
+        const TUInt8Vec& ob = other.s_B[i];
+        bool pruned{other.s_Z[i] > s_Z[i]};
+        s_Z[i] = std::max(s_Z[i], other.s_Z[i]);
+        if (pruned) {
+            detail::prune(b, s_Z[i]);
+        }
+        for (std::size_t j = 0; j < ob.size(); j += 3) {
+            if (ob[j + 2] >= s_Z[i]) {
+                detail::insert(b, detail::from8Bit(ob[j], ob[j + 1]), ob[j + 2]);
+            }
+        }
+        while (b.size() >= 3 * maxSize) {
+            ++s_Z[i];
+            detail::prune(b, s_Z[i]);
+        }
+        if (b.capacity() >= 3 * maxSize) {
+            TUInt8Vec shrunk;
+            shrunk.reserve(3 * maxSize);
+            shrunk.assign(b.begin(), b.end());
+            b.swap(shrunk);
+        }
+    }
+}
+
 std::uint32_t CBjkstUniqueValues::SSketch::number() const {
     // This uses the median trick to reduce the error.
     TUInt32Vec estimates;
@@ -24,7 +24,6 @@
 #include <maths/common/CLinearAlgebraPersist.h>
 #include <maths/common/COrderings.h>
 #include <maths/common/CSampling.h>
-#include <maths/common/CTools.h>
 
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/adapted/std_array.hpp>
@@ -33,6 +32,7 @@
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/unordered_set.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 
@@ -93,7 +93,9 @@ public:
         : m_Threshold(threshold), m_X(x) {}
 
     bool operator()(const TPointSizePr& y) const {
-        return CTools::pow2(bg::distance(m_X, y.first)) < m_Threshold;
+        // For the Cartesian coordinate system comparable distance is the
+        // square Euclidean distance and avoids a square root per point.
+        return bg::comparable_distance(m_X, y.first) < m_Threshold;
     }
 
 private:
@@ -522,6 +524,12 @@ void CKMostCorrelated::mostCorrelated(TCorrelationVec& result) const {
                 std::size_t X = points[i].second;
                 const TVectorPackedBitVectorPr& px = m_Projected.at(X);
 
+                // The point is px as doubles so reuse it for the predicates.
+                const TPoint& x = points[i].first;
+                TPoint minusX;
+                std::transform(x.begin(), x.end(), minusX.begin(),
+                               [](double xi) { return -xi; });
+
                 TVector width(std::sqrt(threshold));
                 nearest.clear();
                 {
@@ -529,8 +537,7 @@ void CKMostCorrelated::mostCorrelated(TCorrelationVec& result) const {
                                          (px.first + width).to<double>().toArray());
                     bgi::query(rtree,
                                bgi::within(box) && bgi::satisfies(CNotEqual(X)) &&
-                                   bgi::satisfies(CCloserThan(
-                                       threshold, px.first.to<double>().toArray())) &&
+                                   bgi::satisfies(CCloserThan(threshold, x)) &&
                                    bgi::satisfies(CPairNotIn(lookup, X)),
                                std::back_inserter(nearest));
                 }
@@ -539,8 +546,7 @@ void CKMostCorrelated::mostCorrelated(TCorrelationVec& result) const {
                                          (-px.first + width).to<double>().toArray());
                     bgi::query(rtree,
                                bgi::within(box) && bgi::satisfies(CNotEqual(X)) &&
-                                   bgi::satisfies(CCloserThan(
-                                       threshold, (-px.first).to<double>().toArray())) &&
+                                   bgi::satisfies(CCloserThan(threshold, minusX)) &&
                                    bgi::satisfies(CPairNotIn(lookup, X)),
                                std::back_inserter(nearest));
                 }
@@ -167,6 +167,7 @@ const double MINUS_INF = DERATE * std::numeric_limits<double>::lowest();
 const double INF = DERATE * std::numeric_limits<double>::max();
 const double MAXIMUM_LOG_BAYES_FACTOR = std::log(1e6);
 const double MINIMUM_SIGNIFICANT_WEIGHT = 0.01;
+const double LOG_NEGLIGIBLE_RELATIVE_WEIGHT = std::log(1e-10);
 }
 
 CMultivariateOneOfNPrior::CMultivariateOneOfNPrior(std::size_t dimension,
@@ -322,6 +323,14 @@ void CMultivariateOneOfNPrior::addSamples(const TDouble10Vec1Vec& samples,
     double m{std::max(n, 1.0)};
     double maxLogBayesFactor{-m * MAXIMUM_LOG_BAYES_FACTOR};
 
+    // A model whose weight is negligible can't be (mostly) correct and its
+    // mode is expensive to compute for the multimodal model so we don't use
+    // it to restrict the maximum Bayes Factor.
+    TMaxAccumulator maxLogWeight;
+    for (const auto& model : m_Models) {
+        maxLogWeight.add(model.first.logWeight());
+    }
+
     for (auto& model : m_Models) {
 
         double minusBic{0.0};
@@ -335,15 +344,18 @@ void CMultivariateOneOfNPrior::addSamples(const TDouble10Vec1Vec& samples,
             minusBic = 2.0 * logLikelihood -
                        model.second->unmarginalizedParameters() * CTools::fastLog(n);
 
-            double modeLogLikelihood;
-            TDouble10Vec1Vec modes;
-            modes.reserve(weights.size());
-            for (const auto& weight : weights) {
-                modes.push_back(model.second->marginalLikelihoodMode(weight));
+            if (model.first.logWeight() >= maxLogWeight[0] + LOG_NEGLIGIBLE_RELATIVE_WEIGHT) {
+                double modeLogLikelihood;
+                TDouble10Vec1Vec modes;
+                modes.reserve(weights.size());
+                for (const auto& weight : weights) {
+                    modes.push_back(model.second->marginalLikelihoodMode(weight));
+                }
+                model.second->jointLogMarginalLikelihood(modes, weights, modeLogLikelihood);
+                maxLogBayesFactor = std::max(maxLogBayesFactor,
+                                             logLikelihood - std::max(modeLogLikelihood,
+                                                                      logLikelihood));
             }
-            model.second->jointLogMarginalLikelihood(modes, weights, modeLogLikelihood);
-            maxLogBayesFactor = std::max(
-                maxLogBayesFactor, logLikelihood - std::max(modeLogLikelihood, logLikelihood));
         }
 
         minusBics.push_back((status & maths_t::E_FpOverflowed) ? MINUS_INF : minusBic);
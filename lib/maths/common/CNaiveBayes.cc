@@ -54,10 +54,13 @@ bool CNaiveBayesFeatureDensityFromPrior::improper() const {
 
 void CNaiveBayesFeatureDensityFromPrior::add(const TDouble1Vec& x) {
     m_Prior->addSamples(x, maths_t::CUnitWeights::SINGLE_UNIT);
+    m_LogMaximumValue.reset();
 }
 
 CNaiveBayesFeatureDensityFromPrior* CNaiveBayesFeatureDensityFromPrior::clone() const {
-    return new CNaiveBayesFeatureDensityFromPrior(*m_Prior);
+    auto* result = new CNaiveBayesFeatureDensityFromPrior(*m_Prior);
+    result->m_LogMaximumValue = m_LogMaximumValue;
+    return result;
 }
 
 bool CNaiveBayesFeatureDensityFromPrior::acceptRestoreTraverser(
@@ -71,6 +74,7 @@ bool CNaiveBayesFeatureDensityFromPrior::acceptRestoreTraverser(
                                }))
     } while (traverser.next());
 
+    m_LogMaximumValue.reset();
     this->checkRestoredInvariants();
 
     return true;
@@ -98,6 +102,9 @@ double CNaiveBayesFeatureDensityFromPrior::logValue(const TDouble1Vec& x) const
 }
 
 double CNaiveBayesFeatureDensityFromPrior::logMaximumValue() const {
+    if (m_LogMaximumValue != std::nullopt) {
+        return *m_LogMaximumValue;
+    }
     double result;
     if (m_Prior->jointLogMarginalLikelihood({m_Prior->marginalLikelihoodMode()},
                                             maths_t::CUnitWeights::SINGLE_UNIT,
@@ -105,15 +112,18 @@ double CNaiveBayesFeatureDensityFromPrior::logMaximumValue() const {
         LOG_ERROR(<< "Bad density value for " << m_Prior->print());
         return std::numeric_limits<double>::lowest();
     }
+    m_LogMaximumValue = result;
     return result;
 }
 
 void CNaiveBayesFeatureDensityFromPrior::dataType(maths_t::EDataType dataType) {
     m_Prior->dataType(dataType);
+    m_LogMaximumValue.reset();
 }
 
 void CNaiveBayesFeatureDensityFromPrior::propagateForwardsByTime(double time) {
     m_Prior->propagateForwardsByTime(time);
+    m_LogMaximumValue.reset();
 }
 
 void CNaiveBayesFeatureDensityFromPrior::debugMemoryUsage(
@@ -321,6 +331,7 @@ CNaiveBayes::classProbabilities(const TDouble1VecVec& x,
     double minFeatureWeight{1.0};
 
     TDoubleVec logLikelihoods;
+    logLikelihoods.reserve(m_ClassConditionalDensities.size());
     for (std::size_t i = 0; i < x.size(); ++i) {
         if (x[i].empty() == false) {
             auto& featureWeight = weightProvider();
@@ -62,12 +62,80 @@ struct SPlusWeight {
     }
 };
 
+//! \brief A sample transformed so that it is described by the joint
+//! predictive distribution.
+struct SScaledSample {
+    //! The sample with any seasonal scaling removed.
+    double s_X;
+    //! The scale of the predictive distribution for the sample.
+    double s_Scale;
+    //! The count of the sample.
+    double s_Count;
+};
+using TScaledSampleVec = core::CSmallVector<SScaledSample, 1>;
+
+//! Remove the seasonal scaling from \p samples and compute the scales of
+//! their predictive distributions, skipping any which are NaN.
+//!
+//! These don't depend on the offset at which the joint distribution is
+//! evaluated so are computed once when we integrate over the offset.
+//!
+//! \param samples The weighted samples.
+//! \param weights The weights of each sample in \p samples.
+//! \param isNonInformative True if the prior is non-informative.
+//! \param shape The shape of the marginal precision prior.
+//! \param rate The rate of the marginal precision prior.
+//! \param precision The precision of the conditional mean prior.
+//! \param predictionMean The mean of the predictive distribution.
+TScaledSampleVec scaleSamples(const TDouble1Vec& samples,
+                              const TDoubleWeightsAry1Vec& weights,
+                              bool isNonInformative,
+                              double shape,
+                              double rate,
+                              double precision,
+                              double predictionMean) {
+    TScaledSampleVec result;
+
+    if (samples.empty()) {
+        LOG_ERROR(<< "Can't compute distribution for empty sample set");
+        return result;
+    }
+
+    result.reserve(samples.size());
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        if (CMathsFuncs::isNan(samples[i]) || CMathsFuncs::isNan(weights[i])) {
+            continue;
+        }
+
+        double n = maths_t::count(weights[i]);
+        if (isNonInformative) {
+            result.push_back({samples[i], 1.0, n});
+            continue;
+        }
+
+        double seasonalScale = std::sqrt(maths_t::seasonalVarianceScale(weights[i]));
+        double countVarianceScale = maths_t::countVarianceScale(weights[i]);
+
+        double x = seasonalScale != 1.0
+                       ? predictionMean + (samples[i] - predictionMean) / seasonalScale
+                       : samples[i];
+
+        // Get the effective precision and rate of the sample.
+        double scaledPrecision = countVarianceScale * precision;
+        double scaledRate = countVarianceScale * rate;
+
+        double scale = std::sqrt((scaledPrecision + 1.0) / scaledPrecision * scaledRate / shape);
+        result.push_back({x, scale, n});
+    }
+
+    return result;
+}
+
 //! Evaluate \p func on the joint predictive distribution for \p samples
 //! (integrating over the prior for the normal mean and precision) and
 //! aggregate the results using \p aggregate.
 //!
-//! \param samples The weighted samples.
-//! \param weights The weights of each sample in \p samples.
+//! \param samples The samples computed by scaleSamples.
 //! \param func The function to evaluate.
 //! \param aggregate The function to aggregate the results of \p func.
 //! \param isNonInformative True if the prior is non-informative.
@@ -75,27 +143,20 @@ struct SPlusWeight {
 //! assumed that \p samples are distributed as Y - "offset", where Y
 //! is a normally distributed R.V.
 //! \param shape The shape of the marginal precision prior.
-//! \param rate The rate of the marginal precision prior.
 //! \param mean The mean of the conditional mean prior.
-//! \param precision The precision of the conditional mean prior.
 //! \param result Filled in with the aggregation of results of \p func.
 template<typename FUNC, typename AGGREGATOR, typename RESULT>
-bool evaluateFunctionOnJointDistribution(const TDouble1Vec& samples,
-                                         const TDoubleWeightsAry1Vec& weights,
+bool evaluateFunctionOnJointDistribution(const TScaledSampleVec& samples,
                                          FUNC func,
                                          AGGREGATOR aggregate,
                                          bool isNonInformative,
                                          double offset,
                                          double shape,
-                                         double rate,
                                          double mean,
-                                         double precision,
-                                         double predictionMean,
                                          RESULT& result) {
     result = RESULT();
 
     if (samples.empty()) {
-        LOG_ERROR(<< "Can't compute distribution for empty sample set");
         return false;
     }
 
@@ -112,21 +173,14 @@ bool evaluateFunctionOnJointDistribution(const TDouble1Vec& samples,
     //
     // This becomes increasingly accurate as the prior distribution narrows.
 
-    bool success = false;
     try {
         if (isNonInformative) {
             // The non-informative prior is improper and effectively 0 everywhere.
             // (It is acceptable to approximate all finite samples as at the median
             // of this distribution.)
-            for (std::size_t i = 0; i < samples.size(); ++i) {
-                if (CMathsFuncs::isNan(samples[i]) || CMathsFuncs::isNan(weights[i])) {
-                    continue;
-                }
-                success = true;
-
-                double x = samples[i];
-                double n = maths_t::count(weights[i]);
-                result = aggregate(result, func(CTools::SImproperDistribution(), x), n);
+            for (const auto& sample : samples) {
+                result = aggregate(result, func(CTools::SImproperDistribution(), sample.s_X),
+                                   sample.s_Count);
             }
         } else if (shape > MINIMUM_GAUSSIAN_SHAPE) {
             // For large shape the marginal likelihood is very well approximated
@@ -135,29 +189,9 @@ bool evaluateFunctionOnJointDistribution(const TDouble1Vec& samples,
             // is the shape and "b" is the rate of the prior gamma distribution,
             // and the error function is significantly cheaper to compute.
 
-            for (std::size_t i = 0; i < samples.size(); ++i) {
-                if (CMathsFuncs::isNan(samples[i]) || CMathsFuncs::isNan(weights[i])) {
-                    continue;
-                }
-                success = true;
-
-                double n = maths_t::count(weights[i]);
-                double seasonalScale =
-                    std::sqrt(maths_t::seasonalVarianceScale(weights[i]));
-                double countVarianceScale = maths_t::countVarianceScale(weights[i]);
-
-                double x = seasonalScale != 1.0
-                               ? predictionMean + (samples[i] - predictionMean) / seasonalScale
-                               : samples[i];
-
-                // Get the effective precision and rate of the sample.
-                double scaledPrecision = countVarianceScale * precision;
-                double scaledRate = countVarianceScale * rate;
-
-                double deviation = std::sqrt((scaledPrecision + 1.0) /
-                                             scaledPrecision * scaledRate / shape);
-                boost::math::normal normal(mean, deviation);
-                result = aggregate(result, func(normal, x + offset), n);
+            for (const auto& sample : samples) {
+                boost::math::normal normal(mean, sample.s_Scale);
+                result = aggregate(result, func(normal, sample.s_X + offset), sample.s_Count);
             }
         } else {
             // The marginal likelihood is a t distribution with 2*a degrees of
@@ -169,29 +203,9 @@ bool evaluateFunctionOnJointDistribution(const TDouble1Vec& samples,
 
             boost::math::students_t students(2.0 * shape);
 
-            for (std::size_t i = 0; i < samples.size(); ++i) {
-                if (CMathsFuncs::isNan(samples[i]) || CMathsFuncs::isNan(weights[i])) {
-                    continue;
-                }
-                success = true;
-
-                double n = maths_t::count(weights[i]);
-                double seasonalScale =
-                    std::sqrt(maths_t::seasonalVarianceScale(weights[i]));
-                double countVarianceScale = maths_t::countVarianceScale(weights[i]);
-
-                double x = seasonalScale != 1.0
-                               ? predictionMean + (samples[i] - predictionMean) / seasonalScale
-                               : samples[i];
-
-                // Get the effective precision and rate of the sample.
-                double scaledPrecision = countVarianceScale * precision;
-                double scaledRate = countVarianceScale * rate;
-
-                double scale = std::sqrt((scaledPrecision + 1.0) /
-                                         scaledPrecision * scaledRate / shape);
-                double sample = (x + offset - mean) / scale;
-                result = aggregate(result, func(students, sample), n);
+            for (const auto& sample : samples) {
+                double x = (sample.s_X + offset - mean) / sample.s_Scale;
+                result = aggregate(result, func(students, x), sample.s_Count);
             }
         }
     } catch (const std::exception& e) {
@@ -201,7 +215,7 @@ bool evaluateFunctionOnJointDistribution(const TDouble1Vec& samples,
 
     LOG_TRACE(<< "result = " << result);
 
-    return success;
+    return true;
 }
 
 //! Evaluates a specified function object, which must be default constructible,
@@ -221,25 +235,20 @@ public:
                        double shape,
                        double rate,
                        double predictionMean)
-        : m_Samples(samples), m_Weights(weights),
-          m_IsNonInformative(isNonInformative), m_Mean(mean), m_Precision(precision),
-          m_Shape(shape), m_Rate(rate), m_PredictionMean(predictionMean) {}
+        : m_Samples(scaleSamples(samples, weights, isNonInformative, shape, rate,
+                                 precision, predictionMean)),
+          m_IsNonInformative(isNonInformative), m_Mean(mean), m_Shape(shape) {}
 
     bool operator()(double x, double& result) const {
         return evaluateFunctionOnJointDistribution(
-            m_Samples, m_Weights, F(), SPlusWeight(), m_IsNonInformative, x,
-            m_Shape, m_Rate, m_Mean, m_Precision, m_PredictionMean, result);
+            m_Samples, F(), SPlusWeight(), m_IsNonInformative, x, m_Shape, m_Mean, result);
     }
 
 private:
-    const TDouble1Vec& m_Samples;
-    const TDoubleWeightsAry1Vec& m_Weights;
+    TScaledSampleVec m_Samples;
     bool m_IsNonInformative;
     double m_Mean;
-    double m_Precision;
     double m_Shape;
-    double m_Rate;
-    double m_PredictionMean;
 };
 
 //! Computes the probability of seeing less likely samples at a specified offset.
@@ -259,9 +268,9 @@ public:
                                     double rate,
                                     double predictionMean)
         : m_Calculation(calculation), m_Samples(samples), m_Weights(weights),
-          m_IsNonInformative(isNonInformative), m_Mean(mean),
-          m_Precision(precision), m_Shape(shape), m_Rate(rate),
-          m_PredictionMean(predictionMean), m_Tail(0) {}
+          m_ScaledSamples(scaleSamples(samples, weights, isNonInformative, shape,
+                                       rate, precision, predictionMean)),
+          m_IsNonInformative(isNonInformative), m_Mean(mean), m_Shape(shape), m_Tail(0) {}
 
     bool operator()(double x, double& result) const {
 
@@ -270,12 +279,12 @@ public:
         CTools::CProbabilityOfLessLikelySample sampleProbability{m_Calculation};
 
         if (!evaluateFunctionOnJointDistribution(
-                m_Samples, m_Weights,
+                m_ScaledSamples,
                 [&](const auto& distribution, double x_) {
                     return sampleProbability(distribution, x_, tail);
                 },
-                CJointProbabilityOfLessLikelySamples::SAddProbability(), m_IsNonInformative,
-                x, m_Shape, m_Rate, m_Mean, m_Precision, m_PredictionMean, probability) ||
+                CJointProbabilityOfLessLikelySamples::SAddProbability(),
+                m_IsNonInformative, x, m_Shape, m_Mean, probability) ||
             !probability.calculate(result)) {
             LOG_ERROR(<< "Failed to compute probability of less likely samples (samples ="
                       << m_Samples << ", weights = " << m_Weights << ")");
@@ -293,12 +302,10 @@ private:
     maths_t::EProbabilityCalculation m_Calculation;
     const TDouble1Vec& m_Samples;
     const TDoubleWeightsAry1Vec& m_Weights;
+    TScaledSampleVec m_ScaledSamples;
     bool m_IsNonInformative;
     double m_Mean;
-    double m_Precision;
     double m_Shape;
-    double m_Rate;
-    double m_PredictionMean;
     mutable int m_Tail;
 };
 
@@ -59,6 +59,7 @@ const double MAXIMUM_UNPENALISED_RELATIVE_VARIANCE_ERROR = 9.0;
 const double MINIMUM_SIGNIFICANT_WEIGHT = 0.01;
 const double MAXIMUM_RELATIVE_ERROR = 1e-3;
 const double LOG_MAXIMUM_RELATIVE_ERROR = std::log(MAXIMUM_RELATIVE_ERROR);
+const double LOG_NEGLIGIBLE_RELATIVE_WEIGHT = std::log(1e-10);
 
 const std::string VERSION_7_1_TAG("7.1");
 
@@ -385,6 +386,14 @@ void COneOfNPrior::addSamples(const TDouble1Vec& samples,
     double m{std::max(n, 1.0)};
     double maxLogBayesFactor{-m * MAXIMUM_LOG_BAYES_FACTOR};
 
+    // A model whose weight is negligible can't be (mostly) correct and its
+    // mode is relatively expensive to compute for some models so we don't
+    // use it to restrict the maximum Bayes Factor.
+    TMaxAccumulator maxLogWeight;
+    for (const auto& model : m_Models) {
+        maxLogWeight.add(model.first.logWeight());
+    }
+
     for (auto& model : m_Models) {
 
         double minusBic{0.0};
@@ -398,15 +407,18 @@ void COneOfNPrior::addSamples(const TDouble1Vec& samples,
             minusBic = 2.0 * logLikelihood -
                        model.second->unmarginalizedParameters() * CTools::fastLog(n);
 
-            double modeLogLikelihood;
-            TDouble1Vec modes;
-            modes.reserve(weights.size());
-            for (const auto& weight : weights) {
-                modes.push_back(model.second->marginalLikelihoodMode(weight));
+            if (model.first.logWeight() >= maxLogWeight[0] + LOG_NEGLIGIBLE_RELATIVE_WEIGHT) {
+                double modeLogLikelihood;
+                TDouble1Vec modes;
+                modes.reserve(weights.size());
+                for (const auto& weight : weights) {
+                    modes.push_back(model.second->marginalLikelihoodMode(weight));
+                }
+                model.second->jointLogMarginalLikelihood(modes, weights, modeLogLikelihood);
+                maxLogBayesFactor = std::max(maxLogBayesFactor,
+                                             logLikelihood - std::max(modeLogLikelihood,
+                                                                      logLikelihood));
             }
-            model.second->jointLogMarginalLikelihood(modes, weights, modeLogLikelihood);
-            maxLogBayesFactor = std::max(
-                maxLogBayesFactor, logLikelihood - std::max(modeLogLikelihood, logLikelihood));
         }
 
         minusBics.push_back((status & maths_t::E_FpOverflowed) ? MINUS_INF : minusBic);
@@ -228,8 +228,17 @@ void CQuantileSketch::acceptPersistInserter(core::CStatePersistInserter& inserte
 }
 
 const CQuantileSketch& CQuantileSketch::operator+=(const CQuantileSketch& rhs) {
+    // Both sketches' knots are mostly sorted so rather than sorting the union
+    // we only sort the unsorted tails and merge the sorted runs in linear time.
+    this->order();
+    auto sorted = static_cast<std::ptrdiff_t>(m_Knots.size());
     m_Knots.insert(m_Knots.end(), rhs.m_Knots.begin(), rhs.m_Knots.end());
-    m_Unsorted = m_Knots.size();
+    if (rhs.m_Unsorted == 0) {
+        std::inplace_merge(m_Knots.begin(), m_Knots.begin() + sorted,
+                           m_Knots.end(), COrderings::SFirstLess());
+    } else {
+        m_Unsorted = rhs.m_Knots.size();
+    }
     m_Count += rhs.m_Count;
     this->reduce(m_MaxSize + 1);
     m_Knots.shrink_to_fit();
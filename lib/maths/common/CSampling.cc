@@ -231,6 +231,58 @@ std::size_t doCategoricalSample(RNG& rng, TDoubleVec& weights) {
                     m - 1);
 }
 
+//! \brief Inverse transform sampling from a cumulative weight function.
+//!
+//! DESCRIPTION:\n
+//! This uses a guide table to narrow the search for each sample to the
+//! points of the cumulative weight function which fall in one of m equal
+//! intervals of [0, w] with w the total weight and m the number of
+//! categories. Each sample therefore takes expected constant time rather
+//! than O(log(m)). It returns exactly the same category as searching the
+//! whole cumulative weight function.
+class CGuidedInverseTransform {
+public:
+    explicit CGuidedInverseTransform(const TDoubleVec& cdf)
+        : m_Cdf{cdf}, m_Thresholds(cdf.size() + 1), m_Guide(cdf.size() + 1) {
+        std::size_t m{m_Cdf.size()};
+        double total{m_Cdf[m - 1]};
+        for (std::size_t i = 0, j = 0; i <= m; ++i) {
+            m_Thresholds[i] = i == m ? total
+                                     : total * static_cast<double>(i) /
+                                           static_cast<double>(m);
+            for (/**/; j < m && m_Cdf[j] < m_Thresholds[i]; ++j) {
+            }
+            m_Guide[i] = j;
+        }
+    }
+
+    //! Get the first category whose cumulative weight is at least \p u.
+    std::size_t operator()(double u) const {
+        std::size_t m{m_Cdf.size()};
+        double total{m_Cdf[m - 1]};
+        auto i = std::min(static_cast<std::size_t>(u / total * static_cast<double>(m)),
+                          m - 1);
+        // Guard against rounding in the bucket calculation.
+        for (/**/; i > 0 && u < m_Thresholds[i]; --i) {
+        }
+        for (/**/; i + 1 < m && u > m_Thresholds[i + 1]; ++i) {
+        }
+        // All categories before m_Guide[i] have cumulative weight less
+        // than m_Thresholds[i] <= u and m_Guide[i + 1] has cumulative
+        // weight at least m_Thresholds[i + 1] >= u.
+        auto first = m_Cdf.begin() + m_Guide[i];
+        auto last = m_Cdf.begin() + std::min(m_Guide[i + 1] + 1, m);
+        return std::min(static_cast<std::size_t>(std::lower_bound(first, last, u) -
+                                                 m_Cdf.begin()),
+                        m - 1);
+    }
+
+private:
+    const TDoubleVec& m_Cdf;
+    TDoubleVec m_Thresholds;
+    TSizeVec m_Guide;
+};
+
 //! Implementation of categorical sampling with replacement.
 template<typename RNG>
 void doCategoricalSampleWithReplacement(RNG& rng, TDoubleVec& weights, std::size_t n, TSizeVec& result) {
@@ -252,12 +304,19 @@ void doCategoricalSampleWithReplacement(RNG& rng, TDoubleVec& weights, std::size
     } else {
         result.reserve(n);
         boost::random::uniform_real_distribution<> uniform(0.0, weights[m - 1]);
-        for (std::size_t i = 0; i < n; ++i) {
-            result.push_back(std::min(
-                static_cast<std::size_t>(
-                    std::lower_bound(weights.begin(), weights.end(), uniform(rng)) -
-                    weights.begin()),
-                m - 1));
+        if (n < 8) {
+            for (std::size_t i = 0; i < n; ++i) {
+                result.push_back(std::min(
+                    static_cast<std::size_t>(
+                        std::lower_bound(weights.begin(), weights.end(), uniform(rng)) -
+                        weights.begin()),
+                    m - 1));
+            }
+        } else {
+            CGuidedInverseTransform inverseCdf{weights};
+            for (std::size_t i = 0; i < n; ++i) {
+                result.push_back(inverseCdf(uniform(rng)));
+            }
         }
     }
 }
@@ -1497,7 +1497,11 @@ namespace {
 
 namespace math_policy {
 using namespace boost::math::policies;
-using AllowOverflow = policy<overflow_error<user_error>>;
+// By default boost evaluates double precision special functions in long
+// double. This is several times slower and the extra precision is lost in
+// the result, which is already checked against the support and for
+// overflow.
+using AllowOverflow = policy<overflow_error<user_error>, promote_double<false>>;
 }
 
 inline boost::math::normal_distribution<double, math_policy::AllowOverflow>
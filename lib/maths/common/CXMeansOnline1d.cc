@@ -609,6 +609,8 @@ const core::TPersistenceTag HISTORY_LENGTH_TAG("k", "history_length");
 const core::TPersistenceTag INDEX_TAG("a", "index");
 const core::TPersistenceTag STRUCTURE_TAG("b", "structure");
 const core::TPersistenceTag PRIOR_TAG("c", "prior");
+const core::TPersistenceTag NUMBER_ADDED_SINCE_SPLIT_CHECK_TAG("d",
+                                                              "number_added_since_split_check");
 
 const std::string EMPTY_STRING;
 }
@@ -1164,6 +1166,11 @@ bool CXMeansOnline1d::maybeSplit(TClusterVecItr cluster) {
     if (cluster == m_Clusters.end()) {
         return false;
     }
+    // Searching for a split is relatively expensive and a cluster's structure
+    // changes slowly once it has a lot of points so we spread out the checks.
+    if (cluster->splitCheckDue() == false) {
+        return false;
+    }
     TDoubleDoublePr interval = this->winsorizationInterval();
     if (TOptionalClusterClusterPr split =
             cluster->split(m_AvailableDistributions, this->minimumSplitCount(),
@@ -1327,6 +1334,7 @@ bool CXMeansOnline1d::CCluster::acceptRestoreTraverser(const SDistributionRestor
         RESTORE(STRUCTURE_TAG, traverser.traverseSubLevel([&](auto& traverser_) {
             return m_Structure.acceptRestoreTraverser(params, traverser_);
         }))
+        RESTORE_BUILT_IN(NUMBER_ADDED_SINCE_SPLIT_CHECK_TAG, m_NumberAddedSinceSplitCheck)
     } while (traverser.next());
 
     return true;
@@ -1340,6 +1348,7 @@ void CXMeansOnline1d::CCluster::acceptPersistInserter(core::CStatePersistInserte
     inserter.insertLevel(STRUCTURE_TAG, [this](auto& inserter_) {
         m_Structure.acceptPersistInserter(inserter_);
     });
+    inserter.insertValue(NUMBER_ADDED_SINCE_SPLIT_CHECK_TAG, m_NumberAddedSinceSplitCheck);
 }
 
 void CXMeansOnline1d::CCluster::dataType(maths_t::EDataType dataType) {
@@ -1349,6 +1358,7 @@ void CXMeansOnline1d::CCluster::dataType(maths_t::EDataType dataType) {
 void CXMeansOnline1d::CCluster::add(double point, double count) {
     m_Prior.addSamples({point}, {maths_t::countWeight(count)});
     m_Structure.add(point, count);
+    ++m_NumberAddedSinceSplitCheck;
 }
 
 void CXMeansOnline1d::CCluster::decayRate(double decayRate) {
@@ -1408,6 +1418,11 @@ void CXMeansOnline1d::CCluster::sample(std::size_t numberSamples,
     m_Structure.sample(numberSamples, smallest, largest, samples);
 }
 
+bool CXMeansOnline1d::CCluster::splitCheckDue() const {
+    return static_cast<double>(m_NumberAddedSinceSplitCheck) >=
+           SPLIT_CHECK_FRACTION * this->count();
+}
+
 CXMeansOnline1d::TOptionalClusterClusterPr
 CXMeansOnline1d::CCluster::split(CAvailableModeDistributions distributions,
                                  double minimumCount,
@@ -1435,6 +1450,8 @@ CXMeansOnline1d::CCluster::split(CAvailableModeDistributions distributions,
         return {};
     }
 
+    m_NumberAddedSinceSplitCheck = 0;
+
     maths_t::EDataType dataType = m_Prior.dataType();
     double decayRate = m_Prior.decayRate();
 
@@ -1555,7 +1572,8 @@ const CNormalMeanPrecConjugate& CXMeansOnline1d::CCluster::prior() const {
 std::uint64_t CXMeansOnline1d::CCluster::checksum(std::uint64_t seed) const {
     seed = CChecksum::calculate(seed, m_Index);
     seed = CChecksum::calculate(seed, m_Prior);
-    return CChecksum::calculate(seed, m_Structure);
+    seed = CChecksum::calculate(seed, m_Structure);
+    return CChecksum::calculate(seed, m_NumberAddedSinceSplitCheck);
 }
 
 void CXMeansOnline1d::CCluster::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const {
@@ -1572,6 +1590,7 @@ std::size_t CXMeansOnline1d::CCluster::memoryUsage() const {
 
 const double CXMeansOnline1d::WINSORIZATION_CONFIDENCE_INTERVAL(1.0);
 const double CXMeansOnline1d::MINIMUM_SPLIT_DISTANCE(6.0);
+const double CXMeansOnline1d::SPLIT_CHECK_FRACTION(0.02);
 const double CXMeansOnline1d::MAXIMUM_MERGE_DISTANCE(2.0);
 const double CXMeansOnline1d::CLUSTER_DELETE_FRACTION(0.8);
 const std::size_t CXMeansOnline1d::STRUCTURE_SIZE(12);
@@ -1021,6 +1021,61 @@ BOOST_AUTO_TEST_CASE(testCovariances) {
         std::string delimited = sampleCovariances.toDelimited();
         BOOST_REQUIRE_EQUAL(expectedDelimited, delimited);
     }
+
+    LOG_DEBUG(<< "Batch add");
+    {
+        // Check adding a collection of points matches adding them one at a time.
+
+        using TVector4 = maths::common::CVectorNx1<double, 4>;
+        using TDenseVector = maths::common::CDenseVector<double>;
+
+        test::CRandomNumbers rng;
+
+        std::vector<double> coordinates;
+        rng.generateNormalSamples(5.0, 4.0, 400, coordinates);
+
+        std::vector<TVector4> points[2];
+        std::vector<TDenseVector> densePoints[2];
+        for (std::size_t i = 0; i < coordinates.size(); i += 4) {
+            double c[] = {coordinates[i + 0], coordinates[i + 1],
+                          coordinates[i + 2], coordinates[i + 3]};
+            points[i < 200 ? 0 : 1].emplace_back(c);
+            densePoints[i < 200 ? 0 : 1].emplace_back(4);
+            densePoints[i < 200 ? 0 : 1].back() << c[0], c[1], c[2], c[3];
+        }
+
+        maths::common::CBasicStatistics::SSampleCovariances<TVector4> expected(4);
+        maths::common::CBasicStatistics::SSampleCovariances<TVector4> actual(4);
+        maths::common::CBasicStatistics::SSampleCovariances<TDenseVector> actualDense(4);
+        for (std::size_t i = 0; i < 2; ++i) {
+            for (const auto& point : points[i]) {
+                expected.add(point);
+            }
+            actual.add(points[i]);
+            actualDense.add(densePoints[i]);
+
+            BOOST_REQUIRE_EQUAL(maths::common::CBasicStatistics::count(expected),
+                                maths::common::CBasicStatistics::count(actual));
+            BOOST_REQUIRE_EQUAL(maths::common::CBasicStatistics::count(expected),
+                                maths::common::CBasicStatistics::count(actualDense));
+            for (std::size_t j = 0; j < 4; ++j) {
+                BOOST_REQUIRE_CLOSE(maths::common::CBasicStatistics::mean(expected)(j),
+                                    maths::common::CBasicStatistics::mean(actual)(j), 1e-10);
+                BOOST_REQUIRE_CLOSE(maths::common::CBasicStatistics::mean(expected)(j),
+                                    maths::common::CBasicStatistics::mean(actualDense)(j),
+                                    1e-10);
+                for (std::size_t k = 0; k < 4; ++k) {
+                    BOOST_REQUIRE_CLOSE_ABSOLUTE(
+                        maths::common::CBasicStatistics::covariances(expected)(j, k),
+                        maths::common::CBasicStatistics::covariances(actual)(j, k), 1e-10);
+                    BOOST_REQUIRE_CLOSE_ABSOLUTE(
+                        maths::common::CBasicStatistics::covariances(expected)(j, k),
+                        maths::common::CBasicStatistics::covariances(actualDense)(j, k),
+                        1e-10);
+                }
+            }
+        }
+    }
 }
 
 BOOST_AUTO_TEST_CASE(testCovariancesLedoitWolf) {
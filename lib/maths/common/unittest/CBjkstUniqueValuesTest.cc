@@ -303,6 +303,66 @@ BOOST_AUTO_TEST_CASE(testSmall) {
     BOOST_TEST_REQUIRE(maths::common::CBasicStatistics::mean(meanRelativeError) < 0.05);
 }
 
+BOOST_AUTO_TEST_CASE(testMerge) {
+    test::CRandomNumbers rng;
+
+    TSizeVec categories;
+    rng.generateUniformSamples(0, 50000, 3000, categories);
+
+    // Test merging when neither, one or both sketches have sketched their
+    // values. The first n categories are only added to the first sketch.
+
+    for (std::size_t n : {50, 1500}) {
+        for (std::size_t m : {100, 3000}) {
+            LOG_DEBUG(<< "n = " << n << ", m = " << m);
+            maths::common::CBjkstUniqueValues sketch1(3, 100);
+            maths::common::CBjkstUniqueValues sketch2(3, 100);
+            TUInt32Set unique;
+            for (std::size_t i = 0; i < n; ++i) {
+                sketch1.add(static_cast<std::uint32_t>(categories[i]));
+                unique.insert(static_cast<std::uint32_t>(categories[i]));
+            }
+            for (std::size_t i = n; i < std::max(n, m); ++i) {
+                sketch2.add(static_cast<std::uint32_t>(categories[i]));
+                unique.insert(static_cast<std::uint32_t>(categories[i]));
+            }
+            if (n > 100 && m > 100) {
+                // Sketches with different hashes can't be merged.
+                BOOST_TEST_REQUIRE(sketch1.merge(sketch2) == false);
+                continue;
+            }
+            BOOST_TEST_REQUIRE(sketch1.merge(sketch2));
+            LOG_DEBUG(<< "exact  = " << unique.size());
+            LOG_DEBUG(<< "approx = " << sketch1.number());
+            BOOST_REQUIRE_CLOSE_ABSOLUTE(static_cast<double>(unique.size()),
+                                         static_cast<double>(sketch1.number()),
+                                         0.15 * static_cast<double>(unique.size()));
+        }
+    }
+
+    // Test merging sketches with the same hashes.
+
+    maths::common::CBjkstUniqueValues sketch1(3, 100);
+    TUInt32Set unique;
+    for (std::size_t i = 0; i < 1500; ++i) {
+        sketch1.add(static_cast<std::uint32_t>(categories[i]));
+        unique.insert(static_cast<std::uint32_t>(categories[i]));
+    }
+    maths::common::CBjkstUniqueValues sketch2{sketch1};
+    BOOST_TEST_REQUIRE(sketch1.merge(sketch2));
+    BOOST_REQUIRE_EQUAL(sketch2.number(), sketch1.number());
+    for (std::size_t i = 1500; i < categories.size(); ++i) {
+        sketch2.add(static_cast<std::uint32_t>(categories[i]));
+        unique.insert(static_cast<std::uint32_t>(categories[i]));
+    }
+    BOOST_TEST_REQUIRE(sketch1.merge(sketch2));
+    LOG_DEBUG(<< "exact  = " << unique.size());
+    LOG_DEBUG(<< "approx = " << sketch1.number());
+    BOOST_REQUIRE_CLOSE_ABSOLUTE(static_cast<double>(unique.size()),
+                                 static_cast<double>(sketch1.number()),
+                                 0.15 * static_cast<double>(unique.size()));
+}
+
 BOOST_AUTO_TEST_CASE(testPersist) {
     test::CRandomNumbers rng;
 
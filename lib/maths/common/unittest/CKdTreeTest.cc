@@ -28,6 +28,7 @@ using namespace ml;
 
 namespace {
 using TDoubleVec = std::vector<double>;
+using TSizeVec = std::vector<std::size_t>;
 using TVector2 = maths::common::CVectorNx1<double, 2>;
 using TDoubleVector2Pr = std::pair<double, TVector2>;
 using TDoubleVector2PrVec = std::vector<TDoubleVector2Pr>;
@@ -252,6 +253,38 @@ BOOST_AUTO_TEST_CASE(testNearestNeighbours) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testNearestNeighboursReusingResult) {
+
+    // Test we get the same neighbours if we reuse the result vector for queries
+    // with different numbers of neighbours.
+
+    test::CRandomNumbers rng;
+
+    TDoubleVec samples;
+    rng.generateUniformSamples(-100.0, 100.0, 5 * 300, samples);
+
+    std::vector<TVector> points;
+    for (std::size_t j = 0; j < samples.size(); j += 5) {
+        points.emplace_back(&samples[j], &samples[j + 5]);
+    }
+
+    maths::common::CKdTree<TVector> kdTree;
+    kdTree.build(points);
+
+    TSizeVec numbers;
+    rng.generateUniformSamples(0, 20, 100, numbers);
+
+    std::vector<TVector> reused;
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+        const auto& point = points[i];
+        std::vector<TVector> expected;
+        kdTree.nearestNeighbours(numbers[i], point, expected);
+        kdTree.nearestNeighbours(numbers[i], point, reused);
+        BOOST_REQUIRE_EQUAL(core::CContainerPrinter::print(expected),
+                            core::CContainerPrinter::print(reused));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testRequestingEveryPoint) {
 
     test::CRandomNumbers rng;
@@ -10,6 +10,7 @@
  */
 
 #include <core/CLogger.h>
+#include <core/Concurrency.h>
 
 #include <maths/common/CLbfgs.h>
 #include <maths/common/CLinearAlgebraEigen.h>
@@ -19,6 +20,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <limits>
 #include <vector>
 
 BOOST_AUTO_TEST_SUITE(CLbfgsTest)
@@ -284,4 +286,70 @@ BOOST_AUTO_TEST_CASE(testMinimizeWithInitialZeroGradient) {
     BOOST_TEST_REQUIRE((xmin - x).norm() < 1e-6);
 }
 
+BOOST_AUTO_TEST_CASE(testMultiStartMinimize) {
+
+    // Test that the multi-start minimum matches the best of minimizing from each
+    // start separately and doesn't depend on the number of threads.
+
+    test::CRandomNumbers rng;
+
+    // This has local minima near -1 and 1 for each coordinate.
+    auto f = [](const TVector& x) -> double {
+        double result{0.0};
+        for (int i = 0; i < x.size(); ++i) {
+            result += (x(i) * x(i) - 1.0) * (x(i) * x(i) - 1.0) + 0.2 * x(i);
+        }
+        return result;
+    };
+    auto g = [](const TVector& x) -> TVector {
+        TVector result{x.size()};
+        for (int i = 0; i < x.size(); ++i) {
+            result(i) = 4.0 * x(i) * (x(i) * x(i) - 1.0) + 0.2;
+        }
+        return result;
+    };
+
+    maths::common::CLbfgs<TVector> lbfgs{5};
+
+    for (std::size_t test = 0; test < 5; ++test) {
+        TDoubleVec samples;
+        rng.generateUniformSamples(-2.0, 2.0, 120, samples);
+
+        TVectorVec x0s(30, TVector{4});
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            x0s[i / 4](i % 4) = samples[i];
+        }
+
+        double fexpected{std::numeric_limits<double>::max()};
+        TVector xexpected;
+        for (const auto& x0 : x0s) {
+            maths::common::CLbfgs<TVector> lbfgs_{5};
+            TVector x;
+            double fx;
+            std::tie(x, fx) = lbfgs_.minimize(f, g, x0, 1e-8, 50);
+            if (fx < fexpected) {
+                std::tie(xexpected, fexpected) = std::make_pair(x, fx);
+            }
+        }
+
+        for (std::size_t threads : {0, 2, 4}) {
+            if (threads > 0) {
+                core::startDefaultAsyncExecutor(threads);
+            }
+
+            TVector x;
+            double fx;
+            std::tie(x, fx) = lbfgs.multiStartMinimize(f, g, x0s, 1e-8, 50);
+            LOG_DEBUG(<< "threads = " << threads << ", f(x) = " << fx);
+
+            BOOST_REQUIRE_EQUAL(fexpected, fx);
+            BOOST_REQUIRE_EQUAL(0.0, (xexpected - x).norm());
+
+            if (threads > 0) {
+                core::stopDefaultAsyncExecutor();
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
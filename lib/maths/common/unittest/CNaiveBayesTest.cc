@@ -281,6 +281,51 @@ BOOST_AUTO_TEST_CASE(testPropagationByTime) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testLogMaximumValueCache) {
+    // Check the cached log of the density at its mode is refreshed
+    // whenever the density changes.
+
+    test::CRandomNumbers rng;
+
+    maths::common::CNormalMeanPrecConjugate normal{
+        maths::common::CNormalMeanPrecConjugate::nonInformativePrior(
+            maths_t::E_ContinuousData, 0.05)};
+    maths::common::CNaiveBayesFeatureDensityFromPrior density{normal};
+
+    TDoubleVec samples;
+    rng.generateNormalSamples(5.0, 4.0, 100, samples);
+
+    auto expectedLogMaximumValue = [&] {
+        double result;
+        normal.jointLogMarginalLikelihood({normal.marginalLikelihoodMode()},
+                                          maths_t::CUnitWeights::SINGLE_UNIT, result);
+        return result;
+    };
+
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        density.add({samples[i]});
+        normal.addSamples({samples[i]}, maths_t::CUnitWeights::SINGLE_UNIT);
+        if (i > 2) {
+            BOOST_REQUIRE_EQUAL(expectedLogMaximumValue(), density.logMaximumValue());
+            BOOST_REQUIRE_EQUAL(expectedLogMaximumValue(), density.logMaximumValue());
+        }
+        if (i % 10 == 0) {
+            density.propagateForwardsByTime(1.0);
+            normal.propagateForwardsByTime(1.0);
+            if (i > 2) {
+                BOOST_REQUIRE_EQUAL(expectedLogMaximumValue(),
+                                    density.logMaximumValue());
+            }
+        }
+    }
+
+    std::unique_ptr<maths::common::CNaiveBayesFeatureDensity> clone{density.clone()};
+    BOOST_REQUIRE_EQUAL(density.logMaximumValue(), clone->logMaximumValue());
+    clone->add({10.0});
+    normal.addSamples({10.0}, maths_t::CUnitWeights::SINGLE_UNIT);
+    BOOST_REQUIRE_EQUAL(expectedLogMaximumValue(), clone->logMaximumValue());
+}
+
 BOOST_AUTO_TEST_CASE(testExtrapolation) {
     // Test that:
     //   1. Applying low feature weights means the conditional probabilies
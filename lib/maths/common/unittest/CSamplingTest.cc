@@ -141,6 +141,37 @@ BOOST_AUTO_TEST_CASE(testUniformSamplingWithEmptyRange) {
                                    [](auto sample) { return sample == 1.0; }));
 }
 
+BOOST_AUTO_TEST_CASE(testCategoricalSampleWithReplacement) {
+    // Check that sampling in bulk gives the same categories as sampling
+    // one at a time from the same random number stream.
+
+    test::CRandomNumbers rng;
+
+    for (std::size_t t = 1; t < 50; ++t) {
+        TDoubleVec probabilities;
+        rng.generateUniformSamples(0.0, 1.0, t, probabilities);
+        for (std::size_t i = 0; i < probabilities.size(); i += 3) {
+            probabilities[i] = 0.0;
+        }
+        probabilities.back() = 1.0;
+
+        maths::common::CPRNG::CXorOShiro128Plus rng1{t};
+        maths::common::CPRNG::CXorOShiro128Plus rng2{t};
+
+        TDoubleVec weights{probabilities};
+        TSizeVec samples;
+        maths::common::CSampling::categoricalSampleWithReplacement(rng1, weights,
+                                                                   100, samples);
+        BOOST_REQUIRE_EQUAL(100, samples.size());
+
+        for (auto sample : samples) {
+            weights = probabilities;
+            BOOST_REQUIRE_EQUAL(
+                sample, maths::common::CSampling::categoricalSample(rng2, weights));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testCategoricalSampleWithoutReplacement) {
 
     using TVector = maths::common::CVectorNx1<double, 6>;
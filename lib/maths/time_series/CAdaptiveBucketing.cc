@@ -170,10 +170,9 @@ bool CAdaptiveBucketing::acceptRestoreTraverser(core::CStateRestoreTraverser& tr
         RESTORE(LARGE_ERROR_COUNT_P_VALUES_TAG,
                 m_LargeErrorCountPValues.fromDelimited(traverser.value(), pValueFromDelimited))
         RESTORE(MEAN_WEIGHT_TAG, m_MeanWeight.fromDelimited(traverser.value()))
-        RESTORE(ENDPOINT_TAG, core::CPersistUtils::fromString(traverser.value(), m_Endpoints))
-        RESTORE(CENTRES_TAG, core::CPersistUtils::fromString(traverser.value(), m_Centres))
-        RESTORE(LARGE_ERROR_COUNTS_TAG,
-                core::CPersistUtils::fromString(traverser.value(), m_LargeErrorCounts))
+        RESTORE(ENDPOINT_TAG, traverser.floatValues(m_Endpoints))
+        RESTORE(CENTRES_TAG, traverser.floatValues(m_Centres))
+        RESTORE(LARGE_ERROR_COUNTS_TAG, traverser.floatValues(m_LargeErrorCounts))
         RESTORE(MEAN_DESIRED_DISPLACEMENT_TAG,
                 m_MeanDesiredDisplacement.fromDelimited(traverser.value()))
         RESTORE(MEAN_ABS_DESIRED_DISPLACEMENT_TAG,
@@ -216,10 +215,9 @@ void CAdaptiveBucketing::acceptPersistInserter(core::CStatePersistInserter& inse
     inserter.insertValue(LARGE_ERROR_COUNT_P_VALUES_TAG,
                          m_LargeErrorCountPValues.toDelimited(pValueToDelimited));
     inserter.insertValue(MEAN_WEIGHT_TAG, m_MeanWeight.toDelimited());
-    inserter.insertValue(ENDPOINT_TAG, core::CPersistUtils::toString(m_Endpoints));
-    inserter.insertValue(CENTRES_TAG, core::CPersistUtils::toString(m_Centres));
-    inserter.insertValue(LARGE_ERROR_COUNTS_TAG,
-                         core::CPersistUtils::toString(m_LargeErrorCounts));
+    inserter.insertValue(ENDPOINT_TAG, m_Endpoints);
+    inserter.insertValue(CENTRES_TAG, m_Centres);
+    inserter.insertValue(LARGE_ERROR_COUNTS_TAG, m_LargeErrorCounts);
     inserter.insertValue(MEAN_DESIRED_DISPLACEMENT_TAG,
                          m_MeanDesiredDisplacement.toDelimited());
     inserter.insertValue(MEAN_ABS_DESIRED_DISPLACEMENT_TAG,
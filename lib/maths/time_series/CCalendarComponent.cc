@@ -167,7 +167,9 @@ CCalendarFeatureAndTZ CCalendarComponent::feature() const {
 CCalendarComponent::TVector2x1 CCalendarComponent::value(core_t::TTime time,
                                                          double confidence) const {
     double offset{static_cast<double>(this->feature().offset(time))};
-    double n{m_Bucketing.count(time)};
+    // The count is only needed for the confidence interval and finding it
+    // requires a search for the bucket containing time.
+    double n{confidence == 0.0 ? 0.0 : m_Bucketing.count(time)};
     return this->CDecompositionComponent::value(offset, n, confidence);
 }
 
@@ -178,7 +180,7 @@ double CCalendarComponent::meanValue() const {
 CCalendarComponent::TVector2x1
 CCalendarComponent::variance(core_t::TTime time, double confidence) const {
     double offset{static_cast<double>(this->feature().offset(time))};
-    double n{m_Bucketing.count(time)};
+    double n{confidence == 0.0 ? 0.0 : m_Bucketing.count(time)};
     return this->CDecompositionComponent::variance(offset, n, confidence);
 }
 
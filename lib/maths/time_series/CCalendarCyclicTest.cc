@@ -238,6 +238,8 @@ CCalendarCyclicTest::TFeatureTimePrVec CCalendarCyclicTest::test() const {
     };
     using TFeatureStatsUMap =
         boost::unordered_map<std::pair<CCalendarFeature, core_t::TTime>, SStats, SHashAndOffsetFeature>;
+    using TUInt32UInt32PrDoubleUMap =
+        boost::unordered_map<std::pair<std::uint32_t, std::uint32_t>, double>;
 
     TErrorStatsVec errors{this->inflate()};
 
@@ -261,6 +263,24 @@ CCalendarCyclicTest::TFeatureTimePrVec CCalendarCyclicTest::test() const {
 
     TFeatureStatsUMap stats{TIME_ZONE_OFFSETS.size() * errors.size()};
 
+    // The bucket p-values only depend on the counts and buckets typically
+    // share the same counts so we compute each distinct p-value once.
+    TUInt32UInt32PrDoubleUMap pValues;
+    auto bucketPValue = [&](const SErrorStats& bucket) {
+        if (bucket.s_LargeErrorCount == 0) {
+            return 1.0;
+        }
+        auto key = std::make_pair(bucket.s_Count, bucket.s_LargeErrorCount);
+        auto pValue = pValues.find(key);
+        if (pValue == pValues.end()) {
+            double n{static_cast<double>(bucket.s_Count)};
+            double nl{static_cast<double>(bucket.s_LargeErrorCount % (1 << 17))};
+            double nv{static_cast<double>(bucket.s_LargeErrorCount / (1 << 17))};
+            pValue = pValues.emplace(key, this->errorsPValue(n, nl, nv)).first;
+        }
+        return pValue->second;
+    };
+
     // Note that the current index points to the next bucket to overwrite,
     // i.e. the earliest bucket error statistics we have. The start of
     // this bucket is WINDOW before the start time of the current partial
@@ -271,7 +291,7 @@ CCalendarCyclicTest::TFeatureTimePrVec CCalendarCyclicTest::test() const {
             double n{static_cast<double>(errors[i].s_Count)};
             double nl{static_cast<double>(errors[i].s_LargeErrorCount % (1 << 17))};
             double nv{static_cast<double>(errors[i].s_LargeErrorCount / (1 << 17))};
-            double pValue{this->errorsPValue(n, nl, nv)};
+            double pValue{bucketPValue(errors[i])};
             // It is clear that the maximum value of a set is at least as
             // large as its mean. We use this to compute a lower bound for
             // the right tail probability for the largest error.
@@ -239,6 +239,46 @@ void CCountMinSketch::removeFromMap(std::uint32_t category) {
     }
 }
 
+bool CCountMinSketch::merge(const CCountMinSketch& other) {
+    if (other.m_Rows != m_Rows || other.m_Columns != m_Columns) {
+        LOG_ERROR(<< "Can't merge sketches with different sizes: " << m_Rows << "x"
+                  << m_Columns << " and " << other.m_Rows << "x" << other.m_Columns);
+        return false;
+    }
+
+    const auto* counts = std::get_if<TUInt32FloatPrVec>(&other.m_Sketch);
+    if (counts != nullptr) {
+        for (const auto& count : *counts) {
+            this->add(count.first, count.second);
+        }
+        return true;
+    }
+    if (std::get_if<TUInt32FloatPrVec>(&m_Sketch) != nullptr) {
+        CCountMinSketch result{other};
+        result.merge(*this);
+        this->swap(result);
+        return true;
+    }
+
+    try {
+        auto& sketch = std::get<SSketch>(m_Sketch);
+        const auto& otherSketch = std::get<SSketch>(other.m_Sketch);
+        if (sketch.s_Hashes != otherSketch.s_Hashes) {
+            LOG_ERROR(<< "Can't merge sketches with different hashes");
+            return false;
+        }
+        m_TotalCount += other.m_TotalCount;
+        for (std::size_t i = 0; i < sketch.s_Counts.size(); ++i) {
+            for (std::size_t j = 0; j < sketch.s_Counts[i].size(); ++j) {
+                sketch.s_Counts[i][j] += otherSketch.s_Counts[i][j];
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG_ABORT(<< "Unexpected exception " << e.what());
+    }
+    return true;
+}
+
 void CCountMinSketch::age(double alpha) {
     auto* counts = std::get_if<TUInt32FloatPrVec>(&m_Sketch);
     if (counts != nullptr) {
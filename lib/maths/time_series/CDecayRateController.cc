@@ -179,6 +179,114 @@ double CDecayRateController::multiplier(const TDouble1Vec& prediction,
                                         core_t::TTime bucketLength,
                                         double learnRate,
                                         double decayRate) {
+    std::size_t dimension{m_PredictionMean.size()};
+    double count{this->count()};
+    double weight{learnRate / static_cast<double>(predictionErrors.size())};
+
+    for (const auto& predictionError : predictionErrors) {
+        if (predictionError.empty()) {
+            continue;
+        }
+        for (std::size_t d = 0; d < dimension; ++d) {
+            this->addPredictionError(d, count, prediction[d], predictionError[d], weight);
+        }
+    }
+
+    return this->updateMultiplier(count, bucketLength, learnRate, decayRate);
+}
+
+double CDecayRateController::univariateMultiplier(double prediction,
+                                                  const TDouble1Vec& predictionErrors,
+                                                  core_t::TTime bucketLength,
+                                                  double learnRate,
+                                                  double decayRate) {
+    double count{this->count()};
+    double weight{learnRate / static_cast<double>(predictionErrors.size())};
+
+    for (auto predictionError : predictionErrors) {
+        this->addPredictionError(0, count, prediction, predictionError, weight);
+    }
+
+    return this->updateMultiplier(count, bucketLength, learnRate, decayRate);
+}
+
+double CDecayRateController::multiplier() const {
+    return common::CBasicStatistics::mean(m_Multiplier);
+}
+
+std::size_t CDecayRateController::dimension() const {
+    return m_PredictionMean.size();
+}
+
+void CDecayRateController::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const {
+    mem->setName("CDecayRateController");
+    core::memory_debug::dynamicSize("m_PredictionMean", m_PredictionMean, mem);
+    core::memory_debug::dynamicSize("m_Bias", m_Bias, mem);
+    core::memory_debug::dynamicSize("m_RecentAbsError", m_RecentAbsError, mem);
+    core::memory_debug::dynamicSize("m_HistoricalAbsError", m_HistoricalAbsError, mem);
+}
+
+std::size_t CDecayRateController::memoryUsage() const {
+    std::size_t mem{core::memory::dynamicSize(m_PredictionMean)};
+    mem += core::memory::dynamicSize(m_Bias);
+    mem += core::memory::dynamicSize(m_RecentAbsError);
+    mem += core::memory::dynamicSize(m_HistoricalAbsError);
+    return mem;
+}
+
+std::uint64_t CDecayRateController::checksum(std::uint64_t seed) const {
+    seed = common::CChecksum::calculate(seed, m_Checks);
+    seed = common::CChecksum::calculate(seed, m_Target);
+    seed = common::CChecksum::calculate(seed, m_Multiplier);
+    seed = common::CChecksum::calculate(seed, m_Rng);
+    seed = common::CChecksum::calculate(seed, m_PredictionMean);
+    seed = common::CChecksum::calculate(seed, m_Bias);
+    seed = common::CChecksum::calculate(seed, m_RecentAbsError);
+    return common::CChecksum::calculate(seed, m_HistoricalAbsError);
+}
+
+double CDecayRateController::count() const {
+    return common::CBasicStatistics::count(m_HistoricalAbsError[0]);
+}
+
+void CDecayRateController::addPredictionError(std::size_t d,
+                                              double count,
+                                              double prediction,
+                                              double predictionError,
+                                              double weight) {
+    // Truncate the prediction error to deal with large outliers.
+    if (count > 0.0) {
+        double bias{common::CBasicStatistics::mean(m_Bias[d])};
+        double width{10.0 * common::CBasicStatistics::mean(m_HistoricalAbsError[d])};
+        predictionError = common::CTools::truncate(predictionError, bias - width,
+                                                   bias + width);
+    }
+
+    // The idea of the following is to allow the model memory length
+    // to increase whilst the prediction errors are less than some
+    // tolerance expressed in terms of the data's coefficient of
+    // variation. We achieve this by adding on noise with this magnitude
+    // with the understanding that if the prediction errors are less
+    // than this the sum will be unbiased and the error magnitudes will
+    // be uniform in time so the controller will actively decrease the
+    // decay rate.
+
+    double sd{MINIMUM_COV_TO_CONTROL *
+              std::fabs(common::CBasicStatistics::mean(m_PredictionMean[d]))};
+    double tolerance{sd > 0.0 ? common::CSampling::normalSample(m_Rng, 0.0, sd * sd) : 0.0};
+    m_PredictionMean[d].add(prediction, weight);
+    m_Bias[d].add(predictionError + tolerance, weight);
+    m_RecentAbsError[d].add(std::fabs(predictionError + tolerance), weight);
+    m_HistoricalAbsError[d].add(std::fabs(predictionError + tolerance), weight);
+    LOG_TRACE(<< "bias = " << m_Bias[d] << ", recent error = " << m_RecentAbsError[d]
+              << ", historical error = " << m_HistoricalAbsError[d]);
+    LOG_TRACE(<< "prediction = " << m_PredictionMean[d]);
+}
+
+double CDecayRateController::updateMultiplier(double count,
+                                              core_t::TTime bucketLength,
+                                              double learnRate,
+                                              double decayRate) {
     // We could estimate the, presumably non-linear, function describing
     // the dynamics of the various error quantities and minimize the bias
     // and short term absolute prediction error using the decay rate as a
@@ -190,49 +298,10 @@ double CDecayRateController::multiplier(const TDouble1Vec& prediction,
     // decay rate does this.
 
     std::size_t dimension{m_PredictionMean.size()};
-    double count{this->count()};
     TMeanAccumulator1Vec* stats_[3];
     stats_[BIAS] = &m_Bias;
     stats_[RECENT_ERROR] = &m_RecentAbsError;
     stats_[HISTORIC_ERROR] = &m_HistoricalAbsError;
-    double numberPredictionErrors{static_cast<double>(predictionErrors.size())};
-
-    for (auto predictionError : predictionErrors) {
-        if (predictionError.empty()) {
-            continue;
-        }
-
-        for (std::size_t d = 0; d < dimension; ++d) {
-            // Truncate the prediction error to deal with large outliers.
-            if (count > 0.0) {
-                double bias{common::CBasicStatistics::mean(m_Bias[d])};
-                double width{10.0 * common::CBasicStatistics::mean(m_HistoricalAbsError[d])};
-                predictionError[d] = common::CTools::truncate(
-                    predictionError[d], bias - width, bias + width);
-            }
-
-            // The idea of the following is to allow the model memory
-            // length to increase whilst the prediction errors are less
-            // than some tolerance expressed in terms of the data's
-            // coefficient of variation. We achieve this by adding on
-            // noise with this magnitude with the understanding that if
-            // the prediction errors are less than this the sum will be
-            // unbiased and the error magnitudes will be uniform in time
-            // so the controller will actively decrease the decay rate.
-
-            double weight{learnRate / numberPredictionErrors};
-            double sd{MINIMUM_COV_TO_CONTROL *
-                      std::fabs(common::CBasicStatistics::mean(m_PredictionMean[d]))};
-            double tolerance{
-                sd > 0.0 ? common::CSampling::normalSample(m_Rng, 0.0, sd * sd) : 0.0};
-            m_PredictionMean[d].add(prediction[d], weight);
-            (*stats_[BIAS])[d].add(predictionError[d] + tolerance, weight);
-            (*stats_[RECENT_ERROR])[d].add(std::fabs(predictionError[d] + tolerance), weight);
-            (*stats_[HISTORIC_ERROR])[d].add(std::fabs(predictionError[d] + tolerance), weight);
-            LOG_TRACE(<< "stats = " << stats_);
-            LOG_TRACE(<< "predictions = " << common::CBasicStatistics::mean(m_PredictionMean));
-        }
-    }
 
     if (count > 0.0) {
         TDouble3Ary factors;
@@ -283,45 +352,6 @@ double CDecayRateController::multiplier(const TDouble1Vec& prediction,
     return result;
 }
 
-double CDecayRateController::multiplier() const {
-    return common::CBasicStatistics::mean(m_Multiplier);
-}
-
-std::size_t CDecayRateController::dimension() const {
-    return m_PredictionMean.size();
-}
-
-void CDecayRateController::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const {
-    mem->setName("CDecayRateController");
-    core::memory_debug::dynamicSize("m_PredictionMean", m_PredictionMean, mem);
-    core::memory_debug::dynamicSize("m_Bias", m_Bias, mem);
-    core::memory_debug::dynamicSize("m_RecentAbsError", m_RecentAbsError, mem);
-    core::memory_debug::dynamicSize("m_HistoricalAbsError", m_HistoricalAbsError, mem);
-}
-
-std::size_t CDecayRateController::memoryUsage() const {
-    std::size_t mem{core::memory::dynamicSize(m_PredictionMean)};
-    mem += core::memory::dynamicSize(m_Bias);
-    mem += core::memory::dynamicSize(m_RecentAbsError);
-    mem += core::memory::dynamicSize(m_HistoricalAbsError);
-    return mem;
-}
-
-std::uint64_t CDecayRateController::checksum(std::uint64_t seed) const {
-    seed = common::CChecksum::calculate(seed, m_Checks);
-    seed = common::CChecksum::calculate(seed, m_Target);
-    seed = common::CChecksum::calculate(seed, m_Multiplier);
-    seed = common::CChecksum::calculate(seed, m_Rng);
-    seed = common::CChecksum::calculate(seed, m_PredictionMean);
-    seed = common::CChecksum::calculate(seed, m_Bias);
-    seed = common::CChecksum::calculate(seed, m_RecentAbsError);
-    return common::CChecksum::calculate(seed, m_HistoricalAbsError);
-}
-
-double CDecayRateController::count() const {
-    return common::CBasicStatistics::count(m_HistoricalAbsError[0]);
-}
-
 double CDecayRateController::change(const TDouble3Ary& stats, core_t::TTime bucketLength) const {
     if (this->notControlling()) {
         return 1.0;
@@ -241,20 +241,21 @@ bool CDecompositionComponent::CPackedSplines::acceptRestoreTraverser(
     common::CSplineTypes::EBoundaryCondition boundary,
     core::CStateRestoreTraverser& traverser) {
     int estimated{0};
-    TDoubleVec knots;
-    TDoubleVec values;
-    TDoubleVec variances;
+    TFloatVec knots;
+    TFloatVec values;
+    TFloatVec variances;
 
     do {
         const std::string& name{traverser.name()};
         RESTORE_BUILT_IN(ESTIMATED_TAG, estimated)
-        RESTORE(KNOTS_TAG, core::CPersistUtils::fromString(traverser.value(), knots))
-        RESTORE(VALUES_TAG, core::CPersistUtils::fromString(traverser.value(), values))
-        RESTORE(VARIANCES_TAG, core::CPersistUtils::fromString(traverser.value(), variances))
+        RESTORE(KNOTS_TAG, traverser.floatValues(knots))
+        RESTORE(VALUES_TAG, traverser.floatValues(values))
+        RESTORE(VARIANCES_TAG, traverser.floatValues(variances))
     } while (traverser.next());
 
     if (estimated == 1) {
-        this->interpolate(knots, values, variances, boundary);
+        this->interpolate({knots.begin(), knots.end()}, {values.begin(), values.end()},
+                          {variances.begin(), variances.end()}, boundary);
     }
 
     this->checkRestoredInvariants();
@@ -270,9 +271,9 @@ void CDecompositionComponent::CPackedSplines::checkRestoredInvariants() const {
 void CDecompositionComponent::CPackedSplines::acceptPersistInserter(core::CStatePersistInserter& inserter) const {
     inserter.insertValue(ESTIMATED_TAG, static_cast<int>(this->initialized()));
     if (this->initialized()) {
-        inserter.insertValue(KNOTS_TAG, core::CPersistUtils::toString(m_Knots));
-        inserter.insertValue(VALUES_TAG, core::CPersistUtils::toString(m_Values[0]));
-        inserter.insertValue(VARIANCES_TAG, core::CPersistUtils::toString(m_Values[1]));
+        inserter.insertValue(KNOTS_TAG, m_Knots);
+        inserter.insertValue(VALUES_TAG, m_Values[0]);
+        inserter.insertValue(VARIANCES_TAG, m_Values[1]);
     }
 }
 
@@ -42,6 +42,7 @@ const core::TPersistenceTag BUCKET_INDEX_TAG{"e", "bucket_index"};
 const core::TPersistenceTag WITHIN_BUCKET_VARIANCE_TAG{"f", "within_bucket_variance"};
 const core::TPersistenceTag AVERAGE_WITHIN_BUCKET_VARIANCE_TAG{"g", "average_within_bucket_variance"};
 const std::size_t MAX_BUFFER_SIZE{5};
+constexpr std::size_t BUCKET_VALUE_BYTES{sizeof(CExpandingWindow::TFloatMeanAccumulator)};
 }
 
 CExpandingWindow::CExpandingWindow(core_t::TTime sampleInterval,
@@ -263,11 +264,13 @@ void CExpandingWindow::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePt
     mem->setName("CExpandingWindow");
     core::memory_debug::dynamicSize("m_BucketValues", m_BucketValues, mem);
     core::memory_debug::dynamicSize("m_DeflatedBucketValues", m_DeflatedBucketValues, mem);
+    core::memory_debug::dynamicSize("m_BufferedValues", m_BufferedValues, mem);
 }
 
 std::size_t CExpandingWindow::memoryUsage() const {
     std::size_t mem{core::memory::dynamicSize(m_BucketValues)};
     mem += core::memory::dynamicSize(m_DeflatedBucketValues);
+    mem += core::memory::dynamicSize(m_BufferedValues);
     return mem;
 }
 
@@ -283,9 +286,20 @@ void CExpandingWindow::deflate(bool commit) const {
 
 void CExpandingWindow::doDeflate(bool commit) {
     if (commit) {
+        // We store the i'th byte of every bucket value contiguously. This groups
+        // the counts, which are often equal, and the sign and exponent bytes of
+        // the values, which vary slowly, so they compress significantly better.
+        std::size_t n{m_BucketValues.size()};
+        const auto* values = reinterpret_cast<const TByte*>(m_BucketValues.data());
+        TByteVec shuffled(n * BUCKET_VALUE_BYTES);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < BUCKET_VALUE_BYTES; ++j) {
+                shuffled[j * n + i] = values[i * BUCKET_VALUE_BYTES + j];
+            }
+        }
         bool lengthOnly{false};
         core::CDeflator compressor(lengthOnly);
-        compressor.addVector(m_BucketValues);
+        compressor.addVector(shuffled);
         compressor.finishAndTakeData(m_DeflatedBucketValues);
     }
     m_BucketValues.clear();
@@ -304,9 +318,14 @@ void CExpandingWindow::doInflate(bool commit) {
     decompressor.addVector(m_DeflatedBucketValues);
     TByteVec inflated;
     decompressor.finishAndTakeData(inflated);
-    m_BucketValues.resize(inflated.size() / sizeof(TFloatMeanAccumulator));
-    std::copy(inflated.begin(), inflated.end(),
-              reinterpret_cast<TByte*>(m_BucketValues.data()));
+    std::size_t n{inflated.size() / BUCKET_VALUE_BYTES};
+    m_BucketValues.resize(n);
+    auto* values = reinterpret_cast<TByte*>(m_BucketValues.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < BUCKET_VALUE_BYTES; ++j) {
+            values[i * BUCKET_VALUE_BYTES + j] = inflated[j * n + i];
+        }
+    }
     double factor{std::exp(-m_DecayRate * m_BufferedTimeToPropagate)};
     for (auto& value : m_BucketValues) {
         value.age(factor);
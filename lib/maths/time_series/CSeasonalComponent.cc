@@ -252,7 +252,9 @@ CSeasonalComponent::TVector2x1 CSeasonalComponent::value(core_t::TTime time,
                                                          double confidence) const {
     time += m_TotalShift;
     double offset{this->time().periodic(time)};
-    double n{m_Bucketing.count(time)};
+    // The count is only needed for the confidence interval and finding it
+    // requires a search for the bucket containing time.
+    double n{confidence == 0.0 ? 0.0 : m_Bucketing.count(time)};
     return this->CDecompositionComponent::value(offset, n, confidence);
 }
 
@@ -316,7 +318,7 @@ CSeasonalComponent::TVector2x1
 CSeasonalComponent::variance(core_t::TTime time, double confidence) const {
     time += m_TotalShift;
     double offset{this->time().periodic(time)};
-    double n{m_Bucketing.count(time)};
+    double n{confidence == 0.0 ? 0.0 : m_Bucketing.count(time)};
     return this->CDecompositionComponent::variance(offset, n, confidence);
 }
 
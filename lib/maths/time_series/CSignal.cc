@@ -66,18 +66,28 @@ void radix2fft(TComplexVec& f) {
         }
     }
 
-    // Apply the twiddle factors.
-
-    for (std::size_t stride = 1; stride < f.size(); stride <<= 1) {
-        for (std::size_t k = 0; k < stride; ++k) {
-            double t{boost::math::double_constants::pi *
-                     static_cast<double>(k) / static_cast<double>(stride)};
-            TComplex w(std::cos(t), std::sin(t));
-            for (std::size_t start = k; start + stride < f.size(); start += 2 * stride) {
-                TComplex fs{f[start]};
-                TComplex tw{w * f[start + stride]};
-                f[start] = fs + tw;
-                f[start + stride] = fs - tw;
+    // Apply the twiddle factors. We compute these once for the largest stride
+    // since the factors for stride s are every (N / 2s)'th of these. Iterating
+    // over contiguous blocks also gives much better locality for long signals.
+
+    std::size_t n{f.size()};
+    std::size_t half{n / 2};
+    TComplexVec twiddles;
+    twiddles.reserve(half);
+    for (std::size_t k = 0; k < half; ++k) {
+        double t{boost::math::double_constants::pi * static_cast<double>(k) /
+                 static_cast<double>(half)};
+        twiddles.emplace_back(std::cos(t), std::sin(t));
+    }
+
+    for (std::size_t stride = 1; stride < n; stride <<= 1) {
+        std::size_t step{half / stride};
+        for (std::size_t start = 0; start < n; start += 2 * stride) {
+            for (std::size_t k = 0; k < stride; ++k) {
+                TComplex fs{f[start + k]};
+                TComplex tw{twiddles[k * step] * f[start + k + stride]};
+                f[start + k] = fs + tw;
+                f[start + k + stride] = fs - tw;
             }
         }
     }
@@ -242,10 +252,12 @@ void CSignal::autocorrelations(const TFloatMeanAccumulatorVec& values,
         f[i] = TComplex{common::CBasicStatistics::mean(values[i]) - mean, 0.0};
     }
 
+    // The Fourier transform of the autocorrelation is the power spectrum
+    // conj(F) F = |F|^2 which we compute in-place.
     fft(f);
-    TComplexVec fConj(f);
-    conj(fConj);
-    hadamard(fConj, f);
+    for (auto& fi : f) {
+        fi = std::norm(fi);
+    }
     ifft(f);
 
     result.reserve(n);
@@ -420,8 +420,14 @@ void CTimeSeriesDecomposition::forecast(core_t::TTime startTime,
     endTime += m_TimeShift;
     endTime = startTime + common::CIntegerTools::ceil(endTime - startTime, step);
 
+    // The mean variance only changes if the components are re-interpolated
+    // and it is relatively expensive to compute so we cache it.
+    double variance{this->meanVariance()};
+
     auto forecastSeasonal = [&](core_t::TTime time) -> TDouble3Vec {
-        m_Components.interpolateForForecast(time);
+        if (m_Components.interpolateForForecast(time)) {
+            variance = this->meanVariance();
+        }
 
         TVector2x1 bounds{seasonal(time)};
 
@@ -432,9 +438,9 @@ void CTimeSeriesDecomposition::forecast(core_t::TTime startTime,
         double stretch{std::max(smoothing(1) - smoothing(0), bounds(0) - bounds(1))};
         bounds += TVector2x1{{shift - stretch / 2.0, shift + stretch / 2.0}};
 
-        double variance{this->meanVariance()};
         double boundsScale{std::sqrt(std::max(
-            minimumScale, this->varianceScaleWeight(time, variance, 0.0).mean()))};
+            minimumScale,
+            this->varianceScaleWeight(time, variance, variance, 0.0, true).mean()))};
         double prediction{(bounds(0) + bounds(1)) / 2.0};
         double interval{boundsScale * (bounds(1) - bounds(0))};
 
@@ -485,6 +491,15 @@ CTimeSeriesDecomposition::varianceScaleWeight(core_t::TTime time,
                                               double variance,
                                               double confidence,
                                               bool smooth) const {
+    return this->varianceScaleWeight(time, variance, this->meanVariance(), confidence, smooth);
+}
+
+CTimeSeriesDecomposition::TVector2x1
+CTimeSeriesDecomposition::varianceScaleWeight(core_t::TTime time,
+                                              double variance,
+                                              double mean,
+                                              double confidence,
+                                              bool smooth) const {
     if (this->initialized() == false) {
         return TVector2x1{1.0};
     }
@@ -493,7 +508,6 @@ CTimeSeriesDecomposition::varianceScaleWeight(core_t::TTime time,
         LOG_ERROR(<< "Supplied variance is " << variance << ".");
         return TVector2x1{1.0};
     }
-    double mean{this->meanVariance()};
     if (mean <= 0.0 || variance <= 0.0) {
         return TVector2x1{1.0};
     }
@@ -532,7 +546,7 @@ CTimeSeriesDecomposition::varianceScaleWeight(core_t::TTime time,
         scale += this->smooth(
             [&](core_t::TTime time_) {
                 return this->varianceScaleWeight(time_ - m_TimeShift, variance,
-                                                 confidence, false);
+                                                 mean, confidence, false);
             },
             time, E_All);
     }
@@ -15,6 +15,7 @@
 #include <core/CLogger.h>
 #include <core/CMemoryDef.h>
 #include <core/CPersistUtils.h>
+#include <core/CProgramCounters.h>
 #include <core/CStatePersistInserter.h>
 #include <core/CStateRestoreTraverser.h>
 #include <core/CTimeUtils.h>
@@ -837,6 +838,7 @@ void CTimeSeriesDecompositionDetail::CChangePointTest::testForChange(const SAddV
 
     auto change = changeTest.test();
     m_LastTestTime = time;
+    ++core::CProgramCounters::counter(counter_t::E_TSADNumberChangePointTests);
 
     if (change != nullptr && // did we detect a change at all
         change->largeEnough(this->largeError()) &&
@@ -1243,6 +1245,7 @@ void CTimeSeriesDecompositionDetail::CSeasonalityTest::test(const SAddValue& mes
                                                 makePreconditioner(), occupancy);
 
                 auto decomposition = seasonalityTest.decompose();
+                ++core::CProgramCounters::counter(counter_t::E_TSADNumberSeasonalityTests);
                 if (decomposition.componentsChanged()) {
                     this->mediator()->forward(
                         SDetectedSeasonal{time, lastTime, std::move(decomposition),
@@ -1526,6 +1529,7 @@ void CTimeSeriesDecompositionDetail::CCalendarTest::test(const SMessage& message
         switch (m_Machine.state()) {
         case CC_TEST: {
             auto result = m_Test->test();
+            ++core::CProgramCounters::counter(counter_t::E_TSADNumberCalendarTests);
             for (auto component : result) {
                 auto[feature, timeZoneOffset] = component;
                 this->mediator()->forward(SDetectedCalendar(
@@ -1928,7 +1932,7 @@ void CTimeSeriesDecompositionDetail::CComponents::handle(const SDetectedChangePo
     m_ModelAnnotationCallback("Detected " + change.print());
 }
 
-void CTimeSeriesDecompositionDetail::CComponents::interpolateForForecast(core_t::TTime time) {
+bool CTimeSeriesDecompositionDetail::CComponents::interpolateForForecast(core_t::TTime time) {
     if (this->shouldInterpolate(time)) {
         if (m_Seasonal != nullptr) {
             m_Seasonal->interpolate(time, false);
@@ -1936,7 +1940,9 @@ void CTimeSeriesDecompositionDetail::CComponents::interpolateForForecast(core_t:
         if (m_Calendar != nullptr) {
             m_Calendar->interpolate(time, true);
         }
+        return true;
     }
+    return false;
 }
 
 void CTimeSeriesDecompositionDetail::CComponents::dataType(maths_t::EDataType dataType) {
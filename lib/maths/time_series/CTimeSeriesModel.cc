@@ -1010,7 +1010,16 @@ bool CUnivariateTimeSeriesModel::uncorrelatedProbability(
         TDouble1Vec feature;
         std::tie(feature, std::ignore) = m_MultibucketFeature->value();
         if (feature.empty() == false) {
-            for (auto calculation_ : expand(calculation)) {
+            // The two one-sided probabilities of a single value sum to at least
+            // one so if the first is less than a half it is the minimum. We start
+            // with the tail on the same side of the mean as the value since this
+            // is usually the smaller.
+            TCalculation2Vec calculations(expand(calculation));
+            if (calculations.size() == 2 &&
+                feature[0] > m_MultibucketFeatureModel->marginalLikelihoodMean()) {
+                std::swap(calculations[0], calculations[1]);
+            }
+            for (auto calculation_ : calculations) {
                 maths_t::ETail dummy;
                 if (m_MultibucketFeatureModel->probabilityOfLessLikelySamples(
                         calculation_, feature,
@@ -1021,6 +1030,9 @@ bool CUnivariateTimeSeriesModel::uncorrelatedProbability(
                     return false;
                 }
                 pMultiBucket = std::min(pMultiBucket, (pl + pu) / 2.0);
+                if (feature.size() == 1 && pMultiBucket < 0.5) {
+                    break;
+                }
             }
             correlation = m_MultibucketFeature->correlationWithBucketValue();
         }
@@ -1582,10 +1594,14 @@ CUnivariateTimeSeriesModel::updateResidualModels(const common::CModelAddSamplesP
     m_ResidualModel->propagateForwardsByTime(params.propagationInterval());
 
     if (m_MultibucketFeatureModel != nullptr) {
+        // Note that weights are in value order. Samples in a bucket often share
+        // a time so we only recompute the seasonal weight when the time changes.
         TDouble2Vec seasonalWeight;
         for (std::size_t i = 0; i < valueorder.size(); ++i) {
-            core_t::TTime time{samples[i].first};
-            this->seasonalWeight(0.0, time, seasonalWeight);
+            core_t::TTime time{samples[valueorder[i]].first};
+            if (i == 0 || time != samples[valueorder[i - 1]].first) {
+                this->seasonalWeight(0.0, time, seasonalWeight);
+            }
             maths_t::setSeasonalVarianceScale(seasonalWeight[0], weights[i]);
         }
 
@@ -1614,7 +1630,7 @@ double CUnivariateTimeSeriesModel::updateDecayRates(const common::CModelAddSampl
         return multiplier;
     }
 
-    TDouble1VecVec errors[2];
+    TDouble1Vec errors[2];
     errors[0].reserve(samples.size());
     errors[1].reserve(samples.size());
     for (auto sample : samples) {
@@ -1622,8 +1638,8 @@ double CUnivariateTimeSeriesModel::updateDecayRates(const common::CModelAddSampl
     }
     {
         CDecayRateController& controller{(*m_Controllers)[E_TrendControl]};
-        TDouble1Vec trendMean{m_TrendModel->meanValue(time)};
-        multiplier = controller.multiplier(
+        double trendMean{m_TrendModel->meanValue(time)};
+        multiplier = controller.univariateMultiplier(
             trendMean, errors[E_TrendControl], this->params().bucketLength(),
             this->params().learnRate(), this->params().decayRate());
         if (multiplier != 1.0) {
@@ -1633,8 +1649,8 @@ double CUnivariateTimeSeriesModel::updateDecayRates(const common::CModelAddSampl
     }
     {
         CDecayRateController& controller{(*m_Controllers)[E_ResidualControl]};
-        TDouble1Vec residualMean{m_ResidualModel->marginalLikelihoodMean()};
-        multiplier = controller.multiplier(
+        double residualMean{m_ResidualModel->marginalLikelihoodMean()};
+        multiplier = controller.univariateMultiplier(
             residualMean, errors[E_ResidualControl], this->params().bucketLength(),
             this->params().learnRate(), this->params().decayRate());
         if (multiplier != 1.0) {
@@ -1651,15 +1667,14 @@ double CUnivariateTimeSeriesModel::updateDecayRates(const common::CModelAddSampl
 
 void CUnivariateTimeSeriesModel::appendPredictionErrors(double interval,
                                                         double sample_,
-                                                        TDouble1VecVec (&result)[2]) {
-    using TDecompositionPtr1Vec = core::CSmallVector<TDecompositionPtr, 1>;
+                                                        TDouble1Vec (&result)[2]) {
     TDouble1Vec sample{sample_};
-    TDecompositionPtr1Vec trend{m_TrendModel};
+    const TDecompositionPtr* trend{&m_TrendModel};
     if (auto error = predictionError(interval, m_ResidualModel, sample)) {
-        result[E_ResidualControl].push_back(*error);
+        result[E_ResidualControl].push_back((*error)[0]);
     }
     if (auto error = predictionError(trend, sample)) {
-        result[E_TrendControl].push_back(*error);
+        result[E_TrendControl].push_back((*error)[0]);
     }
 }
 
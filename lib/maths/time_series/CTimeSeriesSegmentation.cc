@@ -118,12 +118,21 @@ CTimeSeriesSegmentation::piecewiseLinearScaledSeasonal(const TFloatMeanAccumulat
         std::ceil(std::log2(static_cast<double>(maxSegments))))};
     LOG_TRACE(<< "max depth = " << maxDepth);
 
+    // The search evaluates the seasonality for every value several times at
+    // each level of the recursion so we compute its values once up front.
+    TDoubleVec seasonalValues(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        seasonalValues[i] = seasonality(i);
+    }
+    TSeasonality cachedSeasonality{
+        [&seasonalValues](std::size_t i) { return seasonalValues[i]; }};
+
     TSizeVec segmentation{0, values.size()};
     TDoubleDoublePrVec depthAndPValue;
     fitTopDownPiecewiseLinearScaledSeasonal(values.cbegin(), values.cend(),
                                             0, // depth
                                             0, // offset of first value in range
-                                            seasonality, maxDepth, pValueToSegment,
+                                            cachedSeasonality, maxDepth, pValueToSegment,
                                             segmentation, depthAndPValue);
 
     selectSegmentation(maxSegments, segmentation, depthAndPValue);
@@ -452,6 +452,12 @@ CTimeSeriesTestForChange::CTimeSeriesTestForChange(int testFor,
     }
     m_PredictionVariance = common::CBasicStatistics::variance(predictionMoments);
     LOG_TRACE(<< "prediction variance = " << m_PredictionVariance);
+
+    m_BucketPredictions.reserve(m_Values.size());
+    for (std::size_t i = 0; i < m_Values.size(); ++i) {
+        m_BucketPredictions.push_back(
+            bucketPredictor(m_BucketLength * static_cast<core_t::TTime>(i)));
+    }
 }
 
 CTimeSeriesTestForChange::TChangePointUPtr CTimeSeriesTestForChange::test() const {
@@ -775,10 +781,8 @@ CTimeSeriesTestForChange::timeShift(double varianceH0,
 
 CTimeSeriesTestForChange::TBucketIndexPredictor
 CTimeSeriesTestForChange::bucketIndexPredictor() const {
-    auto bucketPredictor = this->bucketPredictor();
-    return [ predictor = std::move(bucketPredictor), this ](std::size_t i) {
-        return predictor(m_BucketLength * static_cast<core_t::TTime>(i));
-    };
+    // Note that this is only ever evaluated for indices of m_Values.
+    return [this](std::size_t i) { return m_BucketPredictions[i]; };
 }
 
 CTimeSeriesTestForChange::TPredictor CTimeSeriesTestForChange::bucketPredictor() const {
@@ -591,11 +591,21 @@ CSeasonalDecomposition CTimeSeriesTestForSeasonality::decompose() const {
         TModelVec decompositions;
         decompositions.reserve(8 * std::size(removeTrendModels));
 
+        TFloatMeanAccumulatorVec valuesMinusTrend;
+        TSizeVec modelTrendSegments;
         for (const auto& removeTrend : removeTrendModels) {
-            this->addNotSeasonal(removeTrend, decompositions);
+            // The values minus the trend fitted without any seasonality are
+            // used by both the not seasonal and the highest autocorrelation
+            // hypotheses so we only compute them once.
+            bool detrended{removeTrend({}, valuesMinusTrend, modelTrendSegments)};
+            if (detrended) {
+                this->addNotSeasonal(valuesMinusTrend, modelTrendSegments, decompositions);
+            }
             this->addModelled(removeTrend, decompositions);
             this->addDiurnal(removeTrend, decompositions);
-            this->addHighestAutocorrelation(removeTrend, decompositions);
+            if (detrended) {
+                this->addHighestAutocorrelation(removeTrend, valuesMinusTrend, decompositions);
+            }
         }
 
         return this->select(decompositions);
@@ -810,16 +820,15 @@ CSeasonalDecomposition CTimeSeriesTestForSeasonality::select(TModelVec& decompos
     return result;
 }
 
-void CTimeSeriesTestForSeasonality::addNotSeasonal(const TRemoveTrend& removeTrend,
+void CTimeSeriesTestForSeasonality::addNotSeasonal(const TFloatMeanAccumulatorVec& valuesMinusTrend,
+                                                   const TSizeVec& modelTrendSegments,
                                                    TModelVec& decompositions) const {
-    if (removeTrend({}, m_ValuesMinusTrend, m_ModelTrendSegments)) {
-        decompositions.emplace_back(
-            *this, this->truncatedMoments(0.0, m_ValuesMinusTrend),
-            this->truncatedMoments(m_OutlierFraction, m_ValuesMinusTrend),
-            this->numberTrendParameters(
-                m_ModelTrendSegments.empty() ? 0 : m_ModelTrendSegments.size() - 1),
-            m_Values, THypothesisStatsVec{}, m_ModelledPeriodsTestable);
-    }
+    decompositions.emplace_back(
+        *this, this->truncatedMoments(0.0, valuesMinusTrend),
+        this->truncatedMoments(m_OutlierFraction, valuesMinusTrend),
+        this->numberTrendParameters(
+            modelTrendSegments.empty() ? 0 : modelTrendSegments.size() - 1),
+        m_Values, THypothesisStatsVec{}, m_ModelledPeriodsTestable);
 }
 
 void CTimeSeriesTestForSeasonality::addModelled(const TRemoveTrend& removeTrend,
@@ -915,24 +924,23 @@ void CTimeSeriesTestForSeasonality::addDiurnal(const TRemoveTrend& removeTrend,
     }
 }
 
-void CTimeSeriesTestForSeasonality::addHighestAutocorrelation(const TRemoveTrend& removeTrend,
-                                                              TModelVec& decompositions) const {
+void CTimeSeriesTestForSeasonality::addHighestAutocorrelation(
+    const TRemoveTrend& removeTrend,
+    const TFloatMeanAccumulatorVec& valuesMinusTrend,
+    TModelVec& decompositions) const {
     // Highest serial autocorrelation components.
-    if (removeTrend({}, m_ValuesMinusTrend, m_ModelTrendSegments)) {
-        auto diurnal = std::make_tuple(this->day(), this->week(), this->year());
-        m_CandidatePeriods = CSignal::seasonalDecomposition(
-            m_ValuesMinusTrend, m_OutlierFraction, diurnal,
-            m_StartOfWeekOverride, 0.05, m_MaximumNumberComponents);
-        this->removeIfNotTestable(m_CandidatePeriods);
-        if (removeTrend(m_CandidatePeriods, m_ValuesMinusTrend, m_ModelTrendSegments) &&
-            this->includesNewComponents(m_CandidatePeriods) &&
-            this->onlyDiurnal(m_CandidatePeriods) == false) {
-            this->testAndAddDecomposition(m_CandidatePeriods,
-                                          m_ModelTrendSegments, m_ValuesMinusTrend,
-                                          false, // Already modelled
-                                          false, // Is diurnal
-                                          decompositions);
-        }
+    auto diurnal = std::make_tuple(this->day(), this->week(), this->year());
+    m_CandidatePeriods = CSignal::seasonalDecomposition(
+        valuesMinusTrend, m_OutlierFraction, diurnal, m_StartOfWeekOverride,
+        0.05, m_MaximumNumberComponents);
+    this->removeIfNotTestable(m_CandidatePeriods);
+    if (removeTrend(m_CandidatePeriods, m_ValuesMinusTrend, m_ModelTrendSegments) &&
+        this->includesNewComponents(m_CandidatePeriods) &&
+        this->onlyDiurnal(m_CandidatePeriods) == false) {
+        this->testAndAddDecomposition(m_CandidatePeriods, m_ModelTrendSegments, m_ValuesMinusTrend,
+                                      false, // Already modelled
+                                      false, // Is diurnal
+                                      decompositions);
     }
 }
 
@@ -21,6 +21,11 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(CCountMinSketchTest)
 
 using namespace ml;
@@ -181,6 +186,71 @@ BOOST_AUTO_TEST_CASE(testSwap) {
     sketch3.swap(sketch4);
 }
 
+BOOST_AUTO_TEST_CASE(testMerge) {
+    test::CRandomNumbers rng;
+
+    TDoubleVec counts;
+    rng.generateUniformSamples(2.0, 301.0, 1500, counts);
+    for (auto& count : counts) {
+        count = std::floor(count);
+    }
+
+    // Test merging when neither, one or both sketches have sketched their
+    // counts. The first n categories are only added to the first sketch.
+
+    for (std::size_t n : {50, 1000}) {
+        for (std::size_t m : {100, 1500}) {
+            LOG_DEBUG(<< "n = " << n << ", m = " << m);
+            maths::time_series::CCountMinSketch sketch1(2, 751);
+            maths::time_series::CCountMinSketch sketch2(2, 751);
+            maths::time_series::CCountMinSketch expected(2, 751);
+            for (std::size_t i = 0; i < n; ++i) {
+                sketch1.add(static_cast<std::uint32_t>(i), counts[i]);
+                expected.add(static_cast<std::uint32_t>(i), counts[i]);
+            }
+            for (std::size_t i = n; i < std::max(n, m); ++i) {
+                sketch2.add(static_cast<std::uint32_t>(i), counts[i]);
+                expected.add(static_cast<std::uint32_t>(i), counts[i]);
+            }
+            if (sketch1.sketched() && sketch2.sketched()) {
+                // Sketches with different hashes can't be merged.
+                BOOST_TEST_REQUIRE(sketch1.merge(sketch2) == false);
+                continue;
+            }
+            BOOST_TEST_REQUIRE(sketch1.merge(sketch2));
+            BOOST_REQUIRE_EQUAL(expected.totalCount(), sketch1.totalCount());
+            if (sketch1.sketched() == false) {
+                for (std::size_t i = 0; i < std::max(n, m); ++i) {
+                    BOOST_REQUIRE_EQUAL(counts[i], sketch1.count(static_cast<std::uint32_t>(i)));
+                }
+            } else {
+                for (std::size_t i = 0; i < std::max(n, m); ++i) {
+                    BOOST_TEST_REQUIRE(sketch1.count(static_cast<std::uint32_t>(i)) >=
+                                       counts[i]);
+                }
+            }
+        }
+    }
+
+    // Test merging sketches with the same hashes.
+
+    maths::time_series::CCountMinSketch sketch1(2, 751);
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        sketch1.add(static_cast<std::uint32_t>(i), counts[i]);
+    }
+    BOOST_TEST_REQUIRE(sketch1.sketched());
+    maths::time_series::CCountMinSketch sketch2{sketch1};
+    TDoubleVec estimates;
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        estimates.push_back(sketch1.count(static_cast<std::uint32_t>(i)));
+    }
+    BOOST_TEST_REQUIRE(sketch1.merge(sketch2));
+    BOOST_REQUIRE_EQUAL(2.0 * sketch2.totalCount(), sketch1.totalCount());
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(2.0 * estimates[i], sketch1.count(static_cast<std::uint32_t>(i)));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testPersist) {
     test::CRandomNumbers rng;
 
@@ -75,6 +75,35 @@ BOOST_AUTO_TEST_CASE(testOrderedErrors) {
     BOOST_TEST_REQUIRE(decayRate <= 0.0005);
 }
 
+BOOST_AUTO_TEST_CASE(testUnivariateMultiplier) {
+    // Test univariateMultiplier makes the same decisions as multiplier.
+
+    using TDouble1VecVec = std::vector<TDouble1Vec>;
+
+    test::CRandomNumbers rng;
+
+    TDoubleVec values;
+    rng.generateUniformSamples(1000.0, 1010.0, 1000, values);
+
+    TDoubleVec errors;
+    rng.generateUniformSamples(-2.0, 6.0, 2000, errors);
+
+    int checks{maths::time_series::CDecayRateController::E_PredictionBias |
+               maths::time_series::CDecayRateController::E_PredictionErrorIncrease};
+    maths::time_series::CDecayRateController controller1{checks, 1};
+    maths::time_series::CDecayRateController controller2{checks, 1};
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        TDouble1Vec prediction{values[i]};
+        TDouble1VecVec predictionErrors{{errors[2 * i]}, {errors[2 * i + 1]}};
+        TDouble1Vec flatPredictionErrors{errors[2 * i], errors[2 * i + 1]};
+        BOOST_REQUIRE_EQUAL(
+            controller1.multiplier(prediction, predictionErrors, 3600, 1.0, 0.0005),
+            controller2.univariateMultiplier(values[i], flatPredictionErrors, 3600, 1.0, 0.0005));
+    }
+    BOOST_REQUIRE_EQUAL(controller1.checksum(), controller2.checksum());
+}
+
 BOOST_AUTO_TEST_CASE(testPersist) {
     // Test persist and restore preserves checksums.
 
@@ -12,6 +12,7 @@
 #include <model/CAnnotatedProbability.h>
 
 #include <core/CLogger.h>
+#include <core/CMemoryDef.h>
 #include <core/CPersistUtils.h>
 
 #include <maths/common/COrderings.h>
@@ -123,6 +124,15 @@ bool SAttributeProbability::acceptRestoreTraverser(core::CStateRestoreTraverser&
     return true;
 }
 
+std::size_t SAttributeProbability::memoryUsage() const {
+    std::size_t mem{core::memory::dynamicSize(s_Attribute)};
+    mem += core::memory::dynamicSize(s_CorrelatedAttributes);
+    mem += core::memory::dynamicSize(s_Correlated);
+    mem += core::memory::dynamicSize(s_CurrentBucketValue);
+    mem += core::memory::dynamicSize(s_BaselineBucketMean);
+    return mem;
+}
+
 SAnnotatedProbability::SAnnotatedProbability()
     : s_Probability(1.0), s_MultiBucketImpact(0.0),
       s_ResultType(model_t::CResultType::E_Final) {
@@ -40,6 +40,9 @@ namespace {
 
 using TModelDetailsViewUPtr = CAnomalyDetectorModel::TModelDetailsViewUPtr;
 
+// TODO make the maximum number of attributes configurable.
+const std::size_t NUMBER_ATTRIBUTE_PROBABILITIES{10};
+
 // tag 'a' was previously used for persisting first time;
 // DO NOT USE; unless it is decided to break model state BWC
 const std::string MODEL_AND_GATHERER_TAG("b");
@@ -103,7 +106,8 @@ CAnomalyDetector::CAnomalyDetector(CLimits& limits,
           maths::common::CIntegerTools::ceil(firstTime, modelConfig.bucketLength())),
       m_DataGatherer(makeDataGatherer(modelFactory, m_LastBucketEndTime, partitionFieldValue)),
       m_ModelFactory(modelFactory),
-      m_Model(makeModel(modelFactory, m_DataGatherer)), m_IsForPersistence(false) {
+      m_Model(makeModel(modelFactory, m_DataGatherer)),
+      m_ModelPlotBoundsCache(modelConfig.bucketLength()), m_IsForPersistence(false) {
     if (m_DataGatherer == nullptr) {
         LOG_ABORT(<< "Failed to construct data gatherer for detector: "
                   << this->description());
@@ -128,6 +132,7 @@ CAnomalyDetector::CAnomalyDetector(bool isForPersistence, const CAnomalyDetector
       m_ModelFactory(other.m_ModelFactory), // Shallow copy of model factory is OK
       m_Model(other.m_Model->cloneForPersistence()),
       // Empty message propagation function is fine in this case
+      m_ModelPlotBoundsCache(other.m_ModelConfig.bucketLength()),
       m_IsForPersistence(isForPersistence) {
     if (!isForPersistence) {
         LOG_ABORT(<< "This constructor only creates clones for persistence");
@@ -362,12 +367,20 @@ const CAnomalyDetector::TStrVec& CAnomalyDetector::fieldsOfInterest() const {
 }
 
 void CAnomalyDetector::addRecord(core_t::TTime time, const TStrCPtrVec& fieldValues) {
+    this->addRecord(time, fieldValues, TWordVec{});
+}
+
+void CAnomalyDetector::addRecord(core_t::TTime time,
+                                 const TStrCPtrVec& fieldValues,
+                                 const TWordVec& fieldWords) {
     const TStrCPtrVec& processedFieldValues = this->preprocessFieldValues(fieldValues);
 
     CEventData eventData;
     eventData.time(time);
 
-    m_DataGatherer->addArrival(processedFieldValues, eventData, m_Limits.resourceMonitor());
+    m_DataGatherer->addArrival(processedFieldValues,
+                               &processedFieldValues == &fieldValues ? fieldWords : TWordVec{},
+                               eventData, m_Limits.resourceMonitor());
 }
 
 const CAnomalyDetector::TStrCPtrVec&
@@ -392,7 +405,42 @@ void CAnomalyDetector::buildResults(core_t::TTime bucketStartTime,
         std::bind(&CAnomalyDetector::sample, this, std::placeholders::_1,
                   std::placeholders::_2, std::ref(m_Limits.resourceMonitor())),
         std::bind(&CAnomalyDetector::updateLastSampledBucket, this, std::placeholders::_1),
-        results);
+        nullptr, results);
+}
+
+bool CAnomalyDetector::sampleForResults(core_t::TTime bucketStartTime,
+                                        core_t::TTime bucketEndTime) {
+    core_t::TTime bucketLength = m_ModelConfig.bucketLength();
+    bucketStartTime = maths::common::CIntegerTools::floor(bucketStartTime, bucketLength);
+    bucketEndTime = maths::common::CIntegerTools::floor(bucketEndTime, bucketLength);
+    if (bucketEndTime <= m_LastBucketEndTime) {
+        return false;
+    }
+
+    m_Limits.resourceMonitor().clearExtraMemory();
+
+    LOG_TRACE(<< "sample: m_DetectorKey = '" << this->description() << "', bucketStartTime = "
+              << bucketStartTime << ", bucketEndTime = " << bucketEndTime);
+
+    this->sample(bucketStartTime, bucketEndTime, m_Limits.resourceMonitor());
+    return true;
+}
+
+void CAnomalyDetector::computeResults(core_t::TTime bucketStartTime,
+                                      core_t::TTime bucketEndTime,
+                                      CHierarchicalResults& results) {
+    core_t::TTime bucketLength = m_ModelConfig.bucketLength();
+    bucketStartTime = maths::common::CIntegerTools::floor(bucketStartTime, bucketLength);
+    bucketEndTime = maths::common::CIntegerTools::floor(bucketEndTime, bucketLength);
+
+    LOG_TRACE(<< "detect: m_DetectorKey = '" << this->description() << "'");
+
+    if (m_Model->addResults(bucketStartTime, bucketEndTime,
+                            NUMBER_ATTRIBUTE_PROBABILITIES, results)) {
+        if (bucketEndTime % bucketLength == 0) {
+            this->updateLastSampledBucket(bucketEndTime);
+        }
+    }
 }
 
 void CAnomalyDetector::sample(core_t::TTime startTime,
@@ -405,9 +453,14 @@ void CAnomalyDetector::sample(core_t::TTime startTime,
 
     core_t::TTime bucketLength = m_ModelConfig.bucketLength();
 
+    // Sampling updates the models so the interim results can't be reused.
+    m_InterimResultsCache.clear();
+    m_DataGatherer->clearDirtyPeople();
+
     for (core_t::TTime time = startTime; time < endTime; time += bucketLength) {
         m_Model->sample(time, time + bucketLength, resourceMonitor);
     }
+    resourceMonitor.addMemoryUsageDelta(*this, m_Model->takeMemoryUsageDelta());
 
     if ((endTime / bucketLength) % 10 == 0) {
         // Even if memory limiting is disabled, force a refresh every 10 buckets
@@ -432,17 +485,20 @@ void CAnomalyDetector::sampleBucketStatistics(core_t::TTime startTime,
     for (core_t::TTime time = startTime; time < endTime; time += bucketLength) {
         m_Model->sampleBucketStatistics(time, time + bucketLength, resourceMonitor);
     }
+    resourceMonitor.addMemoryUsageDelta(*this, m_Model->takeMemoryUsageDelta());
     resourceMonitor.refresh(*this);
 }
 
 void CAnomalyDetector::generateModelPlot(core_t::TTime bucketStartTime,
                                          core_t::TTime bucketEndTime,
                                          double boundsPercentile,
+                                         std::size_t boundsCadence,
                                          const TStrSet& terms,
                                          TModelPlotDataVec& modelPlots) const {
     if (bucketEndTime <= bucketStartTime) {
         return;
     }
+    m_ModelPlotBoundsCache.cadence(boundsCadence);
     if (terms.empty() || m_DataGatherer->partitionFieldValue().empty() ||
         terms.find(m_DataGatherer->partitionFieldValue()) != terms.end()) {
         const CSearchKey& key = m_DataGatherer->searchKey();
@@ -455,8 +511,10 @@ void CAnomalyDetector::generateModelPlot(core_t::TTime bucketStartTime,
                                         m_DataGatherer->partitionFieldValue(),
                                         key.overFieldName(), key.byFieldName(),
                                         bucketLength, key.detectorIndex());
-                view->modelPlot(time, boundsPercentile, terms, modelPlots.back());
+                view->modelPlot(time, boundsPercentile, terms,
+                                m_ModelPlotBoundsCache, modelPlots.back());
             }
+            m_ModelPlotBoundsCache.prune(bucketEndTime);
         }
     }
 }
@@ -594,7 +652,10 @@ void CAnomalyDetector::buildInterimResults(core_t::TTime bucketStartTime,
         std::bind(&CAnomalyDetector::sampleBucketStatistics, this, std::placeholders::_1,
                   std::placeholders::_2, std::ref(m_Limits.resourceMonitor())),
         std::bind(&CAnomalyDetector::noUpdateLastSampledBucket, this, std::placeholders::_1),
-        results);
+        &m_InterimResultsCache, results);
+
+    // The cached results are up-to-date with all the data received so far.
+    m_DataGatherer->clearDirtyPeople();
 }
 
 void CAnomalyDetector::pruneModels() {
@@ -634,10 +695,14 @@ void CAnomalyDetector::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePt
     mem->setName("Anomaly Detector Memory Usage");
     core::memory_debug::dynamicSize("m_DataGatherer", m_DataGatherer, mem);
     core::memory_debug::dynamicSize("m_Model", m_Model, mem);
+    core::memory_debug::dynamicSize("m_ModelPlotBoundsCache", m_ModelPlotBoundsCache, mem);
+    core::memory_debug::dynamicSize("m_InterimResultsCache", m_InterimResultsCache, mem);
 }
 
 std::size_t CAnomalyDetector::memoryUsage() const {
-    return core::memory::dynamicSize(m_DataGatherer) + core::memory::dynamicSize(m_Model);
+    return core::memory::dynamicSize(m_DataGatherer) + core::memory::dynamicSize(m_Model) +
+           core::memory::dynamicSize(m_ModelPlotBoundsCache) +
+           core::memory::dynamicSize(m_InterimResultsCache);
 }
 
 std::size_t CAnomalyDetector::staticSize() const {
@@ -698,7 +763,13 @@ void CAnomalyDetector::timeNow(core_t::TTime time) {
     m_DataGatherer->timeNow(time);
 }
 
+void CAnomalyDetector::invalidateInterimResults() {
+    m_InterimResultsCache.clear();
+    m_DataGatherer->markAllPeopleDirty();
+}
+
 void CAnomalyDetector::skipSampling(core_t::TTime endTime) {
+    m_InterimResultsCache.clear();
     m_Model->skipSampling(endTime);
     m_LastBucketEndTime = endTime;
 }
@@ -708,6 +779,7 @@ void CAnomalyDetector::buildResultsHelper(core_t::TTime bucketStartTime,
                                           core_t::TTime bucketEndTime,
                                           SAMPLE_FUNC sampleFunc,
                                           LAST_SAMPLED_BUCKET_UPDATE_FUNC lastSampledBucketUpdateFunc,
+                                          CInterimResultsCache* interimResultsCache,
                                           CHierarchicalResults& results) {
     core_t::TTime bucketLength = m_ModelConfig.bucketLength();
 
@@ -722,9 +794,13 @@ void CAnomalyDetector::buildResultsHelper(core_t::TTime bucketStartTime,
     CSearchKey key = m_DataGatherer->searchKey();
     LOG_TRACE(<< "OutputResults, for " << key.toCue());
 
-    if (m_Model->addResults(bucketStartTime, bucketEndTime,
-                            10, // TODO max number of attributes
-                            results)) {
+    bool added{interimResultsCache != nullptr
+                   ? m_Model->addResults(bucketStartTime, bucketEndTime,
+                                         NUMBER_ATTRIBUTE_PROBABILITIES,
+                                         *interimResultsCache, results)
+                   : m_Model->addResults(bucketStartTime, bucketEndTime,
+                                         NUMBER_ATTRIBUTE_PROBABILITIES, results)};
+    if (added) {
         if (bucketEndTime % bucketLength == 0) {
             lastSampledBucketUpdateFunc(bucketEndTime);
         }
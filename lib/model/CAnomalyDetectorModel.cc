@@ -27,6 +27,8 @@
 #include <model/CDataGatherer.h>
 #include <model/CDetectionRule.h>
 #include <model/CHierarchicalResults.h>
+#include <model/CInterimBucketCorrector.h>
+#include <model/CInterimResultsCache.h>
 #include <model/CMemoryUsageEstimator.h>
 #include <model/CPartitioningFields.h>
 #include <model/CProbabilityAndInfluenceCalculator.h>
@@ -37,6 +39,7 @@
 #include <boost/unordered_set.hpp>
 
 #include <algorithm>
+#include <atomic>
 
 namespace ml {
 namespace model {
@@ -225,6 +228,24 @@ bool CAnomalyDetectorModel::addResults(core_t::TTime startTime,
                                        core_t::TTime endTime,
                                        std::size_t numberAttributeProbabilities,
                                        CHierarchicalResults& results) const {
+    return this->addResults(startTime, endTime, numberAttributeProbabilities,
+                            static_cast<CInterimResultsCache*>(nullptr), results);
+}
+
+bool CAnomalyDetectorModel::addResults(core_t::TTime startTime,
+                                       core_t::TTime endTime,
+                                       std::size_t numberAttributeProbabilities,
+                                       CInterimResultsCache& interimResultsCache,
+                                       CHierarchicalResults& results) const {
+    return this->addResults(startTime, endTime, numberAttributeProbabilities,
+                            &interimResultsCache, results);
+}
+
+bool CAnomalyDetectorModel::addResults(core_t::TTime startTime,
+                                       core_t::TTime endTime,
+                                       std::size_t numberAttributeProbabilities,
+                                       CInterimResultsCache* interimResultsCache,
+                                       CHierarchicalResults& results) const {
     TSizeVec personIds;
     if (!this->bucketStatsAvailable(startTime)) {
         LOG_TRACE(<< "No stats available for time " << startTime);
@@ -233,6 +254,22 @@ bool CAnomalyDetectorModel::addResults(core_t::TTime startTime,
     this->currentBucketPersonIds(startTime, personIds);
     LOG_TRACE(<< "Outputting results for " << personIds.size() << " people");
 
+    if (interimResultsCache != nullptr &&
+        (results.resultType().isInterim() == false || this->canReuseInterimResults() == false)) {
+        interimResultsCache = nullptr;
+    }
+    if (interimResultsCache != nullptr) {
+        // The interim corrections only change the results of features which
+        // need them.
+        const auto& features = m_DataGatherer->features();
+        bool corrected{std::any_of(features.begin(), features.end(),
+                                   [](model_t::EFeature feature) {
+                                       return model_t::requiresInterimResultAdjustment(feature);
+                                   })};
+        interimResultsCache->bucket(
+            startTime, corrected ? this->interimValueCorrector().completeness() : 1.0);
+    }
+
     CPartitioningFields partitioningFields(m_DataGatherer->partitionFieldName(),
                                            m_DataGatherer->partitionFieldValue());
     partitioningFields.add(m_DataGatherer->personFieldName(), EMPTY);
@@ -253,8 +290,18 @@ bool CAnomalyDetectorModel::addResults(core_t::TTime startTime,
                           });
             SAnnotatedProbability annotatedProbability;
             annotatedProbability.s_ResultType = results.resultType();
-            if (this->computeProbability(pid, startTime, endTime, partitioningFields,
-                                         numberAttributeProbabilities, annotatedProbability)) {
+            bool computed{false};
+            if (interimResultsCache == nullptr || m_DataGatherer->isPersonDirty(pid) ||
+                interimResultsCache->find(pid, computed, annotatedProbability) == false) {
+                computed = this->computeProbability(pid, startTime, endTime,
+                                                    partitioningFields,
+                                                    numberAttributeProbabilities,
+                                                    annotatedProbability);
+                if (interimResultsCache != nullptr) {
+                    interimResultsCache->add(pid, computed, annotatedProbability);
+                }
+            }
+            if (computed) {
                 function_t::EFunction function{m_DataGatherer->function()};
                 results.addModelResult(
                     m_DataGatherer->searchKey().detectorIndex(),
@@ -355,6 +402,17 @@ CAnomalyDetectorModel::estimateMemoryUsageOrComputeAndUpdate(std::size_t numberP
     return computed;
 }
 
+std::ptrdiff_t CAnomalyDetectorModel::takeMemoryUsageDelta() {
+    std::ptrdiff_t result{m_MemoryUsageDelta};
+    m_MemoryUsageDelta = 0;
+    return result;
+}
+
+void CAnomalyDetectorModel::recordMemoryUsageChange(std::size_t before, std::size_t after) {
+    m_MemoryUsageDelta += static_cast<std::ptrdiff_t>(after) -
+                          static_cast<std::ptrdiff_t>(before);
+}
+
 const CDataGatherer& CAnomalyDetectorModel::dataGatherer() const {
     return *m_DataGatherer;
 }
@@ -371,6 +429,10 @@ double CAnomalyDetectorModel::personFrequency(std::size_t pid) const {
     return m_BucketCount <= 0.0 ? 0.5 : m_PersonBucketCounts[pid] / m_BucketCount;
 }
 
+bool CAnomalyDetectorModel::canReuseInterimResults() const {
+    return false;
+}
+
 bool CAnomalyDetectorModel::isTimeUnset(core_t::TTime time) {
     return time == TIME_UNSET;
 }
@@ -540,7 +602,26 @@ void CAnomalyDetectorModel::SFeatureModels::debugMemoryUsage(
 }
 
 std::size_t CAnomalyDetectorModel::SFeatureModels::memoryUsage() const {
-    return core::memory::dynamicSize(s_NewModel) + core::memory::dynamicSize(s_Models);
+    // Models shared with a copy made for persistence are counted in full
+    // because the copy is transient and they're copied if they're modified.
+    std::size_t result{core::memory::dynamicSize(s_NewModel) +
+                       sizeof(TMathsModelSPtr) * s_Models.capacity()};
+    for (const auto& model : s_Models) {
+        if (model != nullptr) {
+            result += sizeof(long) + core::memory::staticSize(*model) +
+                      core::memory::dynamicSize(*model);
+        }
+    }
+    return result;
+}
+
+std::size_t CAnomalyDetectorModel::SFeatureModels::newModelMemoryUsage() const {
+    // This is the memory used by an unshared clone of the prototype.
+    return s_NewModel == nullptr
+               ? 0
+               : sizeof(TMathsModelSPtr) + sizeof(long) +
+                     core::memory::staticSize(*s_NewModel) +
+                     core::memory::dynamicSize(*s_NewModel);
 }
 
 bool CAnomalyDetectorModel::SFeatureModels::shouldPersist() const {
@@ -548,6 +629,32 @@ bool CAnomalyDetectorModel::SFeatureModels::shouldPersist() const {
                        [](const auto& model) { return model->shouldPersist(); });
 }
 
+CAnomalyDetectorModel::SFeatureModels
+CAnomalyDetectorModel::SFeatureModels::copyForPersistence(bool correlated) const {
+    SFeatureModels result{s_Feature, s_NewModel};
+    if (correlated) {
+        result.s_Models.reserve(s_Models.size());
+        for (const auto& model : s_Models) {
+            result.s_Models.emplace_back(model->cloneForPersistence());
+        }
+    } else {
+        result.s_Models = s_Models;
+    }
+    return result;
+}
+
+maths::common::CModel* CAnomalyDetectorModel::SFeatureModels::mutableModel(std::size_t id) {
+    TMathsModelSPtr& model{s_Models[id]};
+    if (model.use_count() > 1) {
+        model.reset(model->clone(model->identifier()));
+    } else {
+        // Synchronise with a copy made for persistence releasing the model
+        // on another thread.
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return model.get();
+}
+
 CAnomalyDetectorModel::SFeatureCorrelateModels::SFeatureCorrelateModels(
     model_t::EFeature feature,
     const TMultivariatePriorSPtr& modelPrior,
@@ -433,6 +433,7 @@ namespace {
 const std::string BOUNDS_PERCENTILE_PROPERTY("boundspercentile");
 const std::string TERMS_PROPERTY("terms");
 const std::string ANNOTATIONS_ENABLED_PROPERTY("annotations_enabled");
+const std::string BOUNDS_CADENCE_PROPERTY("boundscadence");
 }
 
 bool CAnomalyDetectorModelConfig::configureModelPlot(const boost::property_tree::ptree& propTree) {
@@ -484,6 +485,16 @@ bool CAnomalyDetectorModelConfig::configureModelPlot(const boost::property_tree:
         return false;
     }
 
+    // The bounds cadence is optional.
+    if (auto valueStr = propTree.get_optional<std::string>(BOUNDS_CADENCE_PROPERTY)) {
+        std::size_t cadence{1};
+        if (core::CStringUtils::stringToType(*valueStr, cadence) == false || cadence == 0) {
+            LOG_ERROR(<< "Invalid value for '" << BOUNDS_CADENCE_PROPERTY << "': " << *valueStr);
+            return false;
+        }
+        m_ModelPlotBoundsCadence = cadence;
+    }
+
     return true;
 }
 
@@ -690,6 +701,18 @@ double CAnomalyDetectorModelConfig::modelPlotBoundsPercentile() const {
     return m_ModelPlotBoundsPercentile;
 }
 
+void CAnomalyDetectorModelConfig::modelPlotBoundsCadence(std::size_t cadence) {
+    if (cadence == 0) {
+        LOG_ERROR(<< "Bad model plot bounds cadence");
+        return;
+    }
+    m_ModelPlotBoundsCadence = cadence;
+}
+
+std::size_t CAnomalyDetectorModelConfig::modelPlotBoundsCadence() const {
+    return m_ModelPlotBoundsCadence;
+}
+
 void CAnomalyDetectorModelConfig::modelPlotTerms(TStrSet terms) {
     m_ModelPlotTerms.swap(terms);
 }
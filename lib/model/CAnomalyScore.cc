@@ -271,8 +271,19 @@ bool CAnomalyScore::CNormalizer::canNormalize() const {
     return m_RawScoreQuantileSummary.n() > 0;
 }
 
+void CAnomalyScore::CNormalizer::CQuantileCache::clear() {
+    m_HaveNoiseTerms = false;
+    m_PercentileScores.clear();
+}
+
 bool CAnomalyScore::CNormalizer::normalize(const CMaximumScoreScope& scope,
                                            double& score) const {
+    return this->normalize(scope, score, m_QuantileCache);
+}
+
+bool CAnomalyScore::CNormalizer::normalize(const CMaximumScoreScope& scope,
+                                           double& score,
+                                           CQuantileCache& cache) const {
     if (score == 0.0) {
         // Nothing to do.
         return true;
@@ -284,6 +295,97 @@ bool CAnomalyScore::CNormalizer::normalize(const CMaximumScoreScope& scope,
 
     LOG_TRACE(<< "Normalising " << score);
 
+    if (cache.m_HaveNoiseTerms == false) {
+        this->noiseTerms(cache.m_NoiseScore, cache.m_NoiseKnotPointScore, cache.m_ZeroCdf);
+        cache.m_HaveNoiseTerms = true;
+    }
+    std::uint32_t discreteScore{this->discreteScore(score)};
+    auto& percentileScores = cache.m_PercentileScores;
+    auto percentileScore = std::lower_bound(
+        percentileScores.begin(), percentileScores.end(), discreteScore,
+        [](const auto& lhs, std::uint32_t rhs) { return lhs.first < rhs; });
+    double ceiling;
+    if (percentileScore != percentileScores.end() && percentileScore->first == discreteScore) {
+        ceiling = percentileScore->second;
+    } else {
+        ceiling = this->percentileScore(score);
+        if (percentileScores.size() < CQuantileCache::MAXIMUM_NUMBER_PERCENTILE_SCORES) {
+            percentileScores.emplace(percentileScore, discreteScore, ceiling);
+        }
+    }
+    this->normalize(scope, cache.m_NoiseScore, cache.m_NoiseKnotPointScore,
+                    cache.m_ZeroCdf, ceiling, score);
+    return true;
+}
+
+void CAnomalyScore::CNormalizer::noiseTerms(std::uint32_t& noiseScore,
+                                            double& noiseKnotPointScore,
+                                            double& zeroCdf) const {
+    m_RawScoreQuantileSummary.quantile(m_NoisePercentile / 100.0, noiseScore);
+    auto knotPoint = std::lower_bound(m_NormalizedScoreKnotPoints.begin(),
+                                      m_NormalizedScoreKnotPoints.end(),
+                                      TDoubleDoublePr(m_NoisePercentile, 0.0));
+    noiseKnotPointScore = knotPoint->second;
+    double l0;
+    double u0;
+    m_RawScoreQuantileSummary.cdf(0, 0.0, l0, u0);
+    zeroCdf = l0 + u0;
+}
+
+double CAnomalyScore::CNormalizer::percentileScore(double score) const {
+    double lowerPercentile;
+    double upperPercentile;
+    this->quantile(score, 70.0 /*confidence interval*/, lowerPercentile, upperPercentile);
+    lowerPercentile *= 100.0;
+    upperPercentile *= 100.0;
+    if (lowerPercentile > upperPercentile) {
+        std::swap(lowerPercentile, upperPercentile);
+    }
+    lowerPercentile = maths::common::CTools::truncate(lowerPercentile, 0.0, 100.0);
+    upperPercentile = maths::common::CTools::truncate(upperPercentile, 0.0, 100.0);
+
+    double result;
+    std::size_t lowerKnotPoint =
+        std::max(std::lower_bound(m_NormalizedScoreKnotPoints.begin(),
+                                  m_NormalizedScoreKnotPoints.end(), lowerPercentile,
+                                  maths::common::COrderings::SFirstLess()) -
+                     m_NormalizedScoreKnotPoints.begin(),
+                 std::ptrdiff_t(1));
+    std::size_t upperKnotPoint =
+        std::max(std::lower_bound(m_NormalizedScoreKnotPoints.begin(),
+                                  m_NormalizedScoreKnotPoints.end(), upperPercentile,
+                                  maths::common::COrderings::SFirstLess()) -
+                     m_NormalizedScoreKnotPoints.begin(),
+                 std::ptrdiff_t(1));
+    if (lowerKnotPoint < m_NormalizedScoreKnotPoints.size()) {
+        const TDoubleDoublePr& left = m_NormalizedScoreKnotPoints[lowerKnotPoint - 1];
+        const TDoubleDoublePr& right = m_NormalizedScoreKnotPoints[lowerKnotPoint];
+        result = maths::common::CTools::linearlyInterpolate(
+            left.first, right.first, left.second, right.second, lowerPercentile);
+    } else {
+        result = m_MaximumNormalizedScore;
+    }
+    if (upperKnotPoint < m_NormalizedScoreKnotPoints.size()) {
+        const TDoubleDoublePr& left = m_NormalizedScoreKnotPoints[upperKnotPoint - 1];
+        const TDoubleDoublePr& right = m_NormalizedScoreKnotPoints[upperKnotPoint];
+        result = (result + maths::common::CTools::linearlyInterpolate(
+                               left.first, right.first, left.second,
+                               right.second, upperPercentile)) /
+                 2.0;
+    } else {
+        result = (result + m_MaximumNormalizedScore) / 2.0;
+    }
+    LOG_TRACE(<< "normalizedScores[1] = " << result << ", lowerPercentile = "
+              << lowerPercentile << ", upperPercentile = " << upperPercentile);
+    return result;
+}
+
+void CAnomalyScore::CNormalizer::normalize(const CMaximumScoreScope& scope,
+                                           std::uint32_t noiseScore,
+                                           double noiseKnotPointScore,
+                                           double zeroCdf,
+                                           double percentileScore,
+                                           double& score) const {
     double normalizedScores[]{m_MaximumNormalizedScore, m_MaximumNormalizedScore,
                               m_MaximumNormalizedScore, m_MaximumNormalizedScore};
 
@@ -326,71 +428,20 @@ bool CAnomalyScore::CNormalizer::normalize(const CMaximumScoreScope& scope,
     // c.d.f. of the score and pn the noise percentile. We achieve
     // this by adding "max score" * min(F(0) / "noise percentile",
     // to the score.
-    std::uint32_t noiseScore;
-    m_RawScoreQuantileSummary.quantile(m_NoisePercentile / 100.0, noiseScore);
-    auto knotPoint = std::lower_bound(m_NormalizedScoreKnotPoints.begin(),
-                                      m_NormalizedScoreKnotPoints.end(),
-                                      TDoubleDoublePr(m_NoisePercentile, 0.0));
     double signalStrength =
         m_NoiseMultiplier * 10.0 / DISCRETIZATION_FACTOR *
         (static_cast<double>(discreteScore) - static_cast<double>(noiseScore));
-    double l0;
-    double u0;
-    m_RawScoreQuantileSummary.cdf(0, 0.0, l0, u0);
     normalizedScores[0] =
-        knotPoint->second * std::max(1.0 + signalStrength, 0.0) +
+        noiseKnotPointScore * std::max(1.0 + signalStrength, 0.0) +
         m_MaximumNormalizedScore *
-            std::max(2.0 * std::min(50.0 * (l0 + u0) / m_NoisePercentile, 1.0) - 1.0, 0.0);
+            std::max(2.0 * std::min(50.0 * zeroCdf / m_NoisePercentile, 1.0) - 1.0, 0.0);
     LOG_TRACE(<< "normalizedScores[0] = " << normalizedScores[0]
-              << ", knotPoint = " << knotPoint->second << ", discreteScore = " << discreteScore
-              << ", noiseScore = " << noiseScore << ", l(0) = " << l0
-              << ", u(0) = " << u0 << ", signalStrength = " << signalStrength);
+              << ", knotPoint = " << noiseKnotPointScore << ", discreteScore = " << discreteScore
+              << ", noiseScore = " << noiseScore << ", cdf(0) = " << zeroCdf
+              << ", signalStrength = " << signalStrength);
 
-    // Compute the raw normalized score percentile compared to historic values.
-    double lowerPercentile;
-    double upperPercentile;
-    this->quantile(score, 70.0 /*confidence interval*/, lowerPercentile, upperPercentile);
-    lowerPercentile *= 100.0;
-    upperPercentile *= 100.0;
-    if (lowerPercentile > upperPercentile) {
-        std::swap(lowerPercentile, upperPercentile);
-    }
-    lowerPercentile = maths::common::CTools::truncate(lowerPercentile, 0.0, 100.0);
-    upperPercentile = maths::common::CTools::truncate(upperPercentile, 0.0, 100.0);
-
-    std::size_t lowerKnotPoint =
-        std::max(std::lower_bound(m_NormalizedScoreKnotPoints.begin(),
-                                  m_NormalizedScoreKnotPoints.end(), lowerPercentile,
-                                  maths::common::COrderings::SFirstLess()) -
-                     m_NormalizedScoreKnotPoints.begin(),
-                 std::ptrdiff_t(1));
-    std::size_t upperKnotPoint =
-        std::max(std::lower_bound(m_NormalizedScoreKnotPoints.begin(),
-                                  m_NormalizedScoreKnotPoints.end(), upperPercentile,
-                                  maths::common::COrderings::SFirstLess()) -
-                     m_NormalizedScoreKnotPoints.begin(),
-                 std::ptrdiff_t(1));
-    if (lowerKnotPoint < m_NormalizedScoreKnotPoints.size()) {
-        const TDoubleDoublePr& left = m_NormalizedScoreKnotPoints[lowerKnotPoint - 1];
-        const TDoubleDoublePr& right = m_NormalizedScoreKnotPoints[lowerKnotPoint];
-        normalizedScores[1] = maths::common::CTools::linearlyInterpolate(
-            left.first, right.first, left.second, right.second, lowerPercentile);
-    } else {
-        normalizedScores[1] = m_MaximumNormalizedScore;
-    }
-    if (upperKnotPoint < m_NormalizedScoreKnotPoints.size()) {
-        const TDoubleDoublePr& left = m_NormalizedScoreKnotPoints[upperKnotPoint - 1];
-        const TDoubleDoublePr& right = m_NormalizedScoreKnotPoints[upperKnotPoint];
-        normalizedScores[1] =
-            (normalizedScores[1] + maths::common::CTools::linearlyInterpolate(
-                                       left.first, right.first, left.second,
-                                       right.second, upperPercentile)) /
-            2.0;
-    } else {
-        normalizedScores[1] = (normalizedScores[1] + m_MaximumNormalizedScore) / 2.0;
-    }
-    LOG_TRACE(<< "normalizedScores[1] = " << normalizedScores[1] << ", lowerPercentile = "
-              << lowerPercentile << ", upperPercentile = " << upperPercentile);
+    // The ceiling from the raw score percentile compared to historic values.
+    normalizedScores[1] = percentileScore;
 
     double maxScore{0.0};
     bool hasValidMaxScore = this->maxScore(scope, maxScore);
@@ -421,8 +472,6 @@ bool CAnomalyScore::CNormalizer::normalize(const CMaximumScoreScope& scope,
     score = std::min(*std::min_element(std::begin(normalizedScores), std::end(normalizedScores)),
                      m_MaximumNormalizedScore);
     LOG_TRACE(<< "normalizedScore = " << score << ", scope = " << scope.print());
-
-    return true;
 }
 
 void CAnomalyScore::CNormalizer::quantile(double score,
@@ -510,6 +559,8 @@ bool CAnomalyScore::CNormalizer::updateQuantiles(const CMaximumScoreScope& scope
     using TUInt32UInt64Pr = std::pair<std::uint32_t, std::uint64_t>;
     using TUInt32UInt64PrVec = std::vector<TUInt32UInt64Pr>;
 
+    m_QuantileCache.clear();
+
     CMaxScore& maxScore = m_MaxScores[scope.key(m_IsForMembersOfPopulation, m_Dictionary)];
     double oldMaxScore{maxScore.score()};
     maxScore.add(score);
@@ -678,6 +729,8 @@ void CAnomalyScore::CNormalizer::propagateForwardByTime(double time) {
         return;
     }
 
+    m_QuantileCache.clear();
+
     double alpha = std::exp(-2.0 * m_DecayRate * time);
     for (auto i = m_MaxScores.begin(); i != m_MaxScores.end();
          i->second.forget(time) ? i = m_MaxScores.erase(i) : ++i) {
@@ -750,6 +803,8 @@ bool CAnomalyScore::CNormalizer::upgrade(const std::string& loadedVersion,
     double highScoreUpgradeFactor = HIGH_SCORE_UPGRADE_FACTOR[i - 1][j - 1];
     double qDigestUpgradeFactor = Q_DIGEST_UPGRADE_FACTOR[i - 1][j - 1];
 
+    m_QuantileCache.clear();
+
     LOG_INFO(<< "Upgrading quantiles from version " << loadedVersion << " to version "
              << currentVersion << " - will scale highest score by " << highScoreUpgradeFactor
              << " and Q digest min/max values by " << qDigestUpgradeFactor);
@@ -781,6 +836,7 @@ void CAnomalyScore::CNormalizer::clear() {
     m_Sample = 0.0;
     m_RawScoreQuantileSummary.clear();
     m_RawScoreHighQuantileSummary.clear();
+    m_QuantileCache.clear();
     m_TimeToQuantileDecay = QUANTILE_DECAY_TIME;
 }
 
@@ -804,6 +860,7 @@ void CAnomalyScore::CNormalizer::acceptPersistInserter(core::CStatePersistInsert
 }
 
 bool CAnomalyScore::CNormalizer::acceptRestoreTraverser(core::CStateRestoreTraverser& traverser) {
+    m_QuantileCache.clear();
     do {
         const std::string& name = traverser.name();
         LOG_TRACE(<< "name: " << name);
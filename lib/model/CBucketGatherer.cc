@@ -126,14 +126,16 @@ bool restoreInfluencerPersonAttributeCounts(core::CStateRestoreTraverser& traver
 
 //! \brief Manages persistence of bucket counts.
 struct SBucketCountsPersister {
-    using TSizeSizePrUInt64UMap = CBucketGatherer::TSizeSizePrUInt64UMap;
+    using TSizeSizePrUInt64FlatMap = CBucketGatherer::TSizeSizePrUInt64FlatMap;
 
-    void operator()(const TSizeSizePrUInt64UMap& bucketCounts,
+    void operator()(const TSizeSizePrUInt64FlatMap& bucketCounts,
                     core::CStatePersistInserter& inserter) {
         CBucketGatherer::TSizeSizePrUInt64PrVec personAttributeCounts;
         personAttributeCounts.reserve(bucketCounts.size());
         personAttributeCounts.assign(bucketCounts.begin(), bucketCounts.end());
-        std::sort(personAttributeCounts.begin(), personAttributeCounts.end());
+        if (bucketCounts.isSorted() == false) {
+            std::sort(personAttributeCounts.begin(), personAttributeCounts.end());
+        }
         for (std::size_t i = 0; i < personAttributeCounts.size(); ++i) {
             inserter.insertLevel(PERSON_ATTRIBUTE_COUNT_TAG,
                                  std::bind(&insertPersonAttributeCounts,
@@ -142,7 +144,7 @@ struct SBucketCountsPersister {
         }
     }
 
-    bool operator()(TSizeSizePrUInt64UMap& bucketCounts,
+    bool operator()(TSizeSizePrUInt64FlatMap& bucketCounts,
                     core::CStateRestoreTraverser& traverser) {
         do {
             TSizeSizePr key;
@@ -206,7 +208,7 @@ CBucketGatherer::CBucketGatherer(CDataGatherer& dataGatherer,
       m_PersonAttributeCounts(dataGatherer.params().s_LatencyBuckets,
                               dataGatherer.params().s_BucketLength,
                               startTime,
-                              TSizeSizePrUInt64UMap(1)),
+                              TSizeSizePrUInt64FlatMap(1)),
       m_PersonAttributeExplicitNulls(dataGatherer.params().s_LatencyBuckets,
                                      dataGatherer.params().s_BucketLength,
                                      startTime,
@@ -271,7 +273,7 @@ bool CBucketGatherer::addEventData(CEventData& data) {
             return true;
         }
 
-        TSizeSizePrUInt64UMap& bucketCounts = m_PersonAttributeCounts.get(time);
+        TSizeSizePrUInt64FlatMap& bucketCounts = m_PersonAttributeCounts.get(time);
         if (count > 0) {
             bucketCounts[pidCid] += count;
         }
@@ -324,10 +326,22 @@ void CBucketGatherer::hiddenTimeNow(core_t::TTime time, bool skipUpdates) {
         // after startNewBucket has been called.
         std::ptrdiff_t numberInfluences{this->endInfluencers() - this->beginInfluencers()};
         this->startNewBucket(newBucketStart, skipUpdates);
-        m_PersonAttributeCounts.push(TSizeSizePrUInt64UMap(1), newBucketStart);
-        m_PersonAttributeExplicitNulls.push(TSizeSizePrUSet(1), newBucketStart);
-        m_InfluencerCounts.push(TSizeSizePrOptionalStrPrUInt64UMapVec(numberInfluences),
-                                newBucketStart);
+        // The latest bucket's counts are sorted once here, so the features
+        // can be read in identifier order, and the earliest bucket's data
+        // are recycled to avoid reallocating their storage.
+        m_PersonAttributeCounts.latest().sort();
+        m_PersonAttributeCounts.recycle(
+            [](TSizeSizePrUInt64FlatMap& counts) { counts.clear(); }, newBucketStart);
+        m_PersonAttributeExplicitNulls.recycle(
+            [](TSizeSizePrUSet& nulls) { nulls.clear(); }, newBucketStart);
+        m_InfluencerCounts.recycle(
+            [numberInfluences](TSizeSizePrOptionalStrPrUInt64UMapVec& counts) {
+                counts.resize(static_cast<std::size_t>(numberInfluences));
+                for (auto& influencerCounts : counts) {
+                    influencerCounts.clear();
+                }
+            },
+            newBucketStart);
         m_BucketStart = newBucketStart;
     }
 }
@@ -475,7 +489,7 @@ std::string CBucketGatherer::printCurrentBucket() const {
     return result.str();
 }
 
-const CBucketGatherer::TSizeSizePrUInt64UMap&
+const CBucketGatherer::TSizeSizePrUInt64FlatMap&
 CBucketGatherer::bucketCounts(core_t::TTime time) const {
     return m_PersonAttributeCounts.get(time);
 }
@@ -490,7 +504,7 @@ bool CBucketGatherer::hasExplicitNullsOnly(core_t::TTime time, std::size_t pid,
     if (bucketExplicitNulls.empty()) {
         return false;
     }
-    const TSizeSizePrUInt64UMap& bucketCounts = m_PersonAttributeCounts.get(time);
+    const TSizeSizePrUInt64FlatMap& bucketCounts = m_PersonAttributeCounts.get(time);
     TSizeSizePr pidCid = std::make_pair(pid, cid);
     return bucketExplicitNulls.find(pidCid) != bucketExplicitNulls.end() &&
            bucketCounts.find(pidCid) == bucketCounts.end();
@@ -560,7 +574,7 @@ std::size_t CBucketGatherer::memoryUsage() const {
 }
 
 void CBucketGatherer::clear() {
-    m_PersonAttributeCounts.clear(TSizeSizePrUInt64UMap(1));
+    m_PersonAttributeCounts.clear(TSizeSizePrUInt64FlatMap(1));
     m_PersonAttributeExplicitNulls.clear(TSizeSizePrUSet(1));
     m_InfluencerCounts.clear(TSizeSizePrOptionalStrPrUInt64UMapVec(
         this->endInfluencers() - this->beginInfluencers()));
@@ -591,7 +605,7 @@ void CBucketGatherer::baseAcceptPersistInserter(core::CStatePersistInserter& ins
     inserter.insertValue(BUCKET_START_TAG, m_BucketStart);
     inserter.insertLevel(
         BUCKET_COUNT_TAG,
-        std::bind<void>(TSizeSizePrUInt64UMapQueue::CSerializer<detail::SBucketCountsPersister>(),
+        std::bind<void>(TSizeSizePrUInt64FlatMapQueue::CSerializer<detail::SBucketCountsPersister>(),
                         std::cref(m_PersonAttributeCounts), std::placeholders::_1));
     // Clear any empty collections before persist these are resized on restore.
     TSizeSizePrOptionalStrPrUInt64UMapVecQueue influencerCounts{m_InfluencerCounts};
@@ -610,12 +624,12 @@ bool CBucketGatherer::baseAcceptRestoreTraverser(core::CStateRestoreTraverser& t
         RESTORE_BUILT_IN(BUCKET_START_TAG, m_BucketStart)
         RESTORE_SETUP_TEARDOWN(
             BUCKET_COUNT_TAG,
-            m_PersonAttributeCounts = TSizeSizePrUInt64UMapQueue(
+            m_PersonAttributeCounts = TSizeSizePrUInt64FlatMapQueue(
                 m_DataGatherer.params().s_LatencyBuckets, this->bucketLength(),
-                m_BucketStart, TSizeSizePrUInt64UMap(1)),
+                m_BucketStart, TSizeSizePrUInt64FlatMap(1)),
             traverser.traverseSubLevel(std::bind<bool>(
-                TSizeSizePrUInt64UMapQueue::CSerializer<detail::SBucketCountsPersister>(
-                    TSizeSizePrUInt64UMap(1)),
+                TSizeSizePrUInt64FlatMapQueue::CSerializer<detail::SBucketCountsPersister>(
+                    TSizeSizePrUInt64FlatMap(1)),
                 std::ref(m_PersonAttributeCounts), std::placeholders::_1)),
             /**/)
         RESTORE_SETUP_TEARDOWN(
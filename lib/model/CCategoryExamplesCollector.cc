@@ -57,7 +57,17 @@ bool CCategoryExamplesCollector::add(CLocalCategoryId categoryId, const std::str
     if (examplesForCategory.size() >= m_MaxExamples) {
         return false;
     }
-    return examplesForCategory.insert(truncateExample(example)).second;
+    if (example.length() > MAX_EXAMPLE_LENGTH) {
+        return examplesForCategory.insert(truncateExample(example)).second;
+    }
+    // Check for a duplicate before copying the example, since most calls
+    // are for an example we already have.
+    auto itr = examplesForCategory.lower_bound(example);
+    if (itr != examplesForCategory.end() && *itr == example) {
+        return false;
+    }
+    examplesForCategory.emplace_hint(itr, example);
+    return true;
 }
 
 std::size_t CCategoryExamplesCollector::numberOfExamplesForCategory(CLocalCategoryId categoryId) const {
@@ -162,21 +172,24 @@ std::size_t CCategoryExamplesCollector::memoryUsage() const {
     return mem;
 }
 
-std::string CCategoryExamplesCollector::truncateExample(std::string example) {
-    if (example.length() > MAX_EXAMPLE_LENGTH) {
-        std::size_t replacePos(MAX_EXAMPLE_LENGTH - ELLIPSIS.length());
+std::string CCategoryExamplesCollector::truncateExample(const std::string& example) {
+    if (example.length() <= MAX_EXAMPLE_LENGTH) {
+        return example;
+    }
 
-        // Ensure truncation doesn't result in a partial UTF-8 character
-        while (replacePos > 0 &&
-               core::CStringUtils::utf8ByteType(example[replacePos]) == -1) {
-            --replacePos;
-        }
-        example.replace(replacePos, example.length() - replacePos, ELLIPSIS);
+    std::size_t replacePos(MAX_EXAMPLE_LENGTH - ELLIPSIS.length());
+
+    // Ensure truncation doesn't result in a partial UTF-8 character
+    while (replacePos > 0 && core::CStringUtils::utf8ByteType(example[replacePos]) == -1) {
+        --replacePos;
     }
 
-    // Shouldn't be as inefficient as it looks in C++11 due to move
-    // semantics on return
-    return example;
+    // Only copy the part of the example we keep.
+    std::string result;
+    result.reserve(replacePos + ELLIPSIS.length());
+    result.assign(example, 0, replacePos);
+    result += ELLIPSIS;
+    return result;
 }
 }
 }
@@ -28,6 +28,7 @@
 #include <model/CSearchKey.h>
 
 #include <algorithm>
+#include <string_view>
 
 namespace ml {
 namespace model {
@@ -134,6 +135,16 @@ bool isPopulation(model_t::EAnalysisCategory gathererType) {
 }
 
 } // detail::
+
+//! Get \p str without leading and trailing whitespace.
+std::string_view trimWhitespace(std::string_view str) {
+    std::size_t first{str.find_first_not_of(core::CStringUtils::WHITESPACE_CHARS)};
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    std::size_t last{str.find_last_not_of(core::CStringUtils::WHITESPACE_CHARS)};
+    return str.substr(first, last - first + 1);
+}
 } // unnamed::
 
 const std::string CDataGatherer::EXPLICIT_NULL("null");
@@ -297,16 +308,23 @@ std::size_t CDataGatherer::numberOverFieldValues() const {
 bool CDataGatherer::processFields(const TStrCPtrVec& fieldValues,
                                   CEventData& result,
                                   CResourceMonitor& resourceMonitor) {
-    return m_BucketGatherer->processFields(fieldValues, result, resourceMonitor);
+    return m_BucketGatherer->processFields(fieldValues, TWordVec{}, result, resourceMonitor);
+}
+
+bool CDataGatherer::addArrival(const TStrCPtrVec& fieldValues,
+                               CEventData& data,
+                               CResourceMonitor& resourceMonitor) {
+    return this->addArrival(fieldValues, TWordVec{}, data, resourceMonitor);
 }
 
 bool CDataGatherer::addArrival(const TStrCPtrVec& fieldValues,
+                               const TWordVec& fieldWords,
                                CEventData& data,
                                CResourceMonitor& resourceMonitor) {
     // We process fields even if we are in the first partial bucket so that
     // we add enough extra memory to the resource monitor in order to control
     // the number of partitions created.
-    m_BucketGatherer->processFields(fieldValues, data, resourceMonitor);
+    m_BucketGatherer->processFields(fieldValues, fieldWords, data, resourceMonitor);
 
     core_t::TTime time = data.time();
     if (time < m_BucketGatherer->earliestBucketStartTime()) {
@@ -316,7 +334,13 @@ bool CDataGatherer::addArrival(const TStrCPtrVec& fieldValues,
         return false;
     }
 
-    return m_BucketGatherer->addEventData(data);
+    if (m_BucketGatherer->addEventData(data) == false) {
+        return false;
+    }
+    if (m_AllPeopleDirty == false && data.personId() != std::nullopt) {
+        m_DirtyPeople.insert(*data.personId());
+    }
+    return true;
 }
 
 void CDataGatherer::sampleNow(core_t::TTime sampleBucketStart) {
@@ -367,6 +391,20 @@ const std::string& CDataGatherer::personName(std::size_t pid, const std::string&
     return m_PeopleRegistry.name(pid, fallback);
 }
 
+bool CDataGatherer::isPersonDirty(std::size_t pid) const {
+    return m_AllPeopleDirty || m_DirtyPeople.count(pid) > 0;
+}
+
+void CDataGatherer::markAllPeopleDirty() {
+    m_DirtyPeople.clear();
+    m_AllPeopleDirty = true;
+}
+
+void CDataGatherer::clearDirtyPeople() {
+    m_DirtyPeople.clear();
+    m_AllPeopleDirty = false;
+}
+
 void CDataGatherer::personNonZeroCounts(core_t::TTime time, TSizeUInt64PrVec& result) const {
     return m_BucketGatherer->personNonZeroCounts(time, result);
 }
@@ -383,6 +421,7 @@ void CDataGatherer::recyclePeople(const TSizeVec& peopleToRemove) {
     }
 
     m_PeopleRegistry.recycleNames(peopleToRemove, DEFAULT_PERSON_NAME);
+    this->markAllPeopleDirty();
     core::CProgramCounters::counter(counter_t::E_TSADNumberPrunedItems) +=
         peopleToRemove.size();
 }
@@ -399,6 +438,7 @@ void CDataGatherer::removePeople(std::size_t lowestPersonToRemove) {
     m_BucketGatherer->removePeople(lowestPersonToRemove);
 
     m_PeopleRegistry.removeNames(lowestPersonToRemove);
+    this->markAllPeopleDirty();
 }
 
 CDataGatherer::TSizeVec& CDataGatherer::recycledPersonIds() {
@@ -416,6 +456,14 @@ std::size_t CDataGatherer::addPerson(const std::string& person,
                                     resourceMonitor, addedPerson);
 }
 
+std::size_t CDataGatherer::addPerson(const std::string& person,
+                                     const TWord& word,
+                                     CResourceMonitor& resourceMonitor,
+                                     bool& addedPerson) {
+    return m_PeopleRegistry.addName(person, word, m_BucketGatherer->currentBucketStartTime(),
+                                    resourceMonitor, addedPerson);
+}
+
 std::size_t CDataGatherer::numberActiveAttributes() const {
     return m_AttributesRegistry.numberActiveNames();
 }
@@ -483,6 +531,15 @@ std::size_t CDataGatherer::addAttribute(const std::string& attribute,
                                         resourceMonitor, addedAttribute);
 }
 
+std::size_t CDataGatherer::addAttribute(const std::string& attribute,
+                                        const TWord& word,
+                                        CResourceMonitor& resourceMonitor,
+                                        bool& addedAttribute) {
+    return m_AttributesRegistry.addName(attribute, word,
+                                        m_BucketGatherer->currentBucketStartTime(),
+                                        resourceMonitor, addedAttribute);
+}
+
 double CDataGatherer::sampleCount(std::size_t id) const {
     if (m_SampleCounts) {
         return static_cast<double>(m_SampleCounts->count(id));
@@ -535,7 +592,7 @@ std::string CDataGatherer::printCurrentBucket() const {
     return m_BucketGatherer->printCurrentBucket();
 }
 
-const CDataGatherer::TSizeSizePrUInt64UMap& CDataGatherer::bucketCounts(core_t::TTime time) const {
+const CDataGatherer::TSizeSizePrUInt64FlatMap& CDataGatherer::bucketCounts(core_t::TTime time) const {
     return m_BucketGatherer->bucketCounts(time);
 }
 
@@ -566,6 +623,7 @@ void CDataGatherer::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr&
     core::memory_debug::dynamicSize("m_AttributesRegistry", m_AttributesRegistry, mem);
     core::memory_debug::dynamicSize("m_SampleCounts", m_SampleCounts, mem);
     core::memory_debug::dynamicSize("m_BucketGatherer", m_BucketGatherer, mem);
+    core::memory_debug::dynamicSize("m_DirtyPeople", m_DirtyPeople, mem);
 }
 
 std::size_t CDataGatherer::memoryUsage() const {
@@ -575,6 +633,7 @@ std::size_t CDataGatherer::memoryUsage() const {
     mem += core::memory::dynamicSize(m_AttributesRegistry);
     mem += core::memory::dynamicSize(m_SampleCounts);
     mem += core::memory::dynamicSize(m_BucketGatherer);
+    mem += core::memory::dynamicSize(m_DirtyPeople);
     return mem;
 }
 
@@ -591,9 +650,11 @@ void CDataGatherer::clear() {
     if (m_BucketGatherer) {
         m_BucketGatherer->clear();
     }
+    this->markAllPeopleDirty();
 }
 
 bool CDataGatherer::resetBucket(core_t::TTime bucketStart) {
+    this->markAllPeopleDirty();
     return m_BucketGatherer->resetBucket(bucketStart);
 }
 
@@ -661,16 +722,15 @@ bool CDataGatherer::extractCountFromField(const std::string& fieldName,
         return true;
     }
 
-    std::string fieldValueCopy(*fieldValue);
-    core::CStringUtils::trimWhitespace(fieldValueCopy);
-    if (fieldValueCopy.empty() || fieldValueCopy == EXPLICIT_NULL) {
+    std::string_view trimmedFieldValue{trimWhitespace(*fieldValue)};
+    if (trimmedFieldValue.empty() || trimmedFieldValue == EXPLICIT_NULL) {
         count = EXPLICIT_NULL_SUMMARY_COUNT;
         return true;
     }
 
     double count_;
-    if (core::CStringUtils::stringToType(fieldValueCopy, count_) == false || count_ < 0.0) {
-        LOG_ERROR(<< "Unable to extract count " << fieldName << " from " << fieldValueCopy);
+    if (core::CStringUtils::stringToType(trimmedFieldValue, count_) == false || count_ < 0.0) {
+        LOG_ERROR(<< "Unable to extract count " << fieldName << " from " << trimmedFieldValue);
         return false;
     }
     count = static_cast<std::size_t>(count_ + 0.5);
@@ -680,11 +740,11 @@ bool CDataGatherer::extractCountFromField(const std::string& fieldName,
 }
 
 bool CDataGatherer::extractMetricFromField(const std::string& fieldName,
-                                           std::string fieldValue,
+                                           const std::string& fieldValue_,
                                            TDouble1Vec& result) const {
     result.clear();
 
-    core::CStringUtils::trimWhitespace(fieldValue);
+    std::string_view fieldValue{trimWhitespace(fieldValue_)};
     if (fieldValue.empty()) {
         LOG_WARN(<< "Configured metric " << fieldName << " not present in event");
         return false;
@@ -697,11 +757,9 @@ bool CDataGatherer::extractMetricFromField(const std::string& fieldName,
     do {
         std::size_t last = fieldValue.find(delimiter, first);
         double value;
-        // Avoid a string duplication in the (common) case of only one value
-        bool convertedOk = (first == 0 && last == std::string::npos)
-                               ? core::CStringUtils::stringToType(fieldValue, value)
-                               : core::CStringUtils::stringToType(
-                                     fieldValue.substr(first, last - first), value);
+        // Parsing a view of each token avoids copying it.
+        bool convertedOk = core::CStringUtils::stringToType(
+            fieldValue.substr(first, last - first), value);
         if (!convertedOk) {
             LOG_ERROR(<< "Unable to extract " << fieldName << " from " << fieldValue);
             result.clear();
@@ -11,6 +11,8 @@
 
 #include <model/CDetectionRule.h>
 
+#include <algorithm>
+
 namespace ml {
 namespace model {
 
@@ -28,6 +30,13 @@ void CDetectionRule::excludeScope(const std::string& field, const core::CPattern
 
 void CDetectionRule::addCondition(const CRuleCondition& condition) {
     m_Conditions.push_back(condition);
+    int cost{CDetectionRule::cost(condition)};
+    auto position = std::upper_bound(
+        m_ConditionOrder.begin(), m_ConditionOrder.end(), cost,
+        [this](int lhs, std::size_t rhs) {
+            return lhs < CDetectionRule::cost(m_Conditions[rhs]);
+        });
+    m_ConditionOrder.insert(position, m_Conditions.size() - 1);
 }
 
 bool CDetectionRule::apply(ERuleAction action,
@@ -45,8 +54,9 @@ bool CDetectionRule::apply(ERuleAction action,
         return false;
     }
 
-    for (const auto& condition : m_Conditions) {
-        if (condition.test(model, feature, resultType, pid, cid, time) == false) {
+    CRuleCondition::CSeriesValues values{model, feature, resultType, pid, cid, time};
+    for (auto i : m_ConditionOrder) {
+        if (m_Conditions[i].test(values) == false) {
             return false;
         }
     }
@@ -84,5 +94,18 @@ std::string CDetectionRule::printAction() const {
     }
     return result;
 }
+
+int CDetectionRule::cost(const CRuleCondition& condition) {
+    switch (condition.appliesTo()) {
+    case CRuleCondition::E_Time:
+        return 0;
+    case CRuleCondition::E_Actual:
+        return 1;
+    case CRuleCondition::E_Typical:
+    case CRuleCondition::E_DiffFromTypical:
+        return 2;
+    }
+    return 2;
+}
 }
 }
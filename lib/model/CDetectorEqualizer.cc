@@ -20,6 +20,7 @@
 #include <maths/common/CTools.h>
 #include <maths/common/Constants.h>
 
+#include <algorithm>
 #include <optional>
 
 namespace ml {
@@ -53,6 +54,7 @@ bool CDetectorEqualizer::acceptRestoreTraverser(core::CStateRestoreTraverser& tr
             if (detector == std::nullopt) {
                 LOG_ABORT(<< "Expected the detector label first");
             }
+            m_Corrections.clear();
             m_Sketches.emplace_back(*detector, maths::common::CQuantileSketch{SKETCH_SIZE});
             if (traverser.traverseSubLevel([& sketch = m_Sketches.back().second](auto& traverser_) {
                     return sketch.acceptRestoreTraverser(traverser_);
@@ -71,6 +73,7 @@ bool CDetectorEqualizer::acceptRestoreTraverser(core::CStateRestoreTraverser& tr
 void CDetectorEqualizer::add(int detector, double probability) {
     double logp = -maths::common::CTools::fastLog(probability);
     this->sketch(detector).add(logp);
+    m_CountSinceCorrections += 1.0;
 }
 
 double CDetectorEqualizer::correct(int detector, double probability) {
@@ -81,10 +84,8 @@ double CDetectorEqualizer::correct(int detector, double probability) {
 
     const maths::common::CQuantileSketch& sketch = this->sketch(detector);
 
-    for (const auto& sketch_ : m_Sketches) {
-        if (sketch_.second.count() < MINIMUM_COUNT_FOR_CORRECTION) {
-            return probability;
-        }
+    if (this->refreshCorrections() == false) {
+        return probability;
     }
 
     static const double A = -maths::common::CTools::fastLog(
@@ -93,25 +94,11 @@ double CDetectorEqualizer::correct(int detector, double probability) {
 
     double logp = -maths::common::CTools::fastLog(probability);
 
-    double percentage;
-    if (sketch.cdf(logp, percentage)) {
-        percentage *= 100.0;
-        LOG_TRACE(<< "log(p) = " << logp << ", c.d.f. = " << percentage);
-
-        std::vector<double> logps;
-        logps.reserve(m_Sketches.size());
-        for (const auto& sketch_ : m_Sketches) {
-            double logpi;
-            if (sketch_.second.quantile(percentage, logpi)) {
-                logps.push_back(logpi);
-            }
-        }
-        std::sort(logps.begin(), logps.end());
-        LOG_TRACE(<< "quantiles = " << logps);
+    double cdf;
+    if (sketch.cdf(logp, cdf)) {
+        LOG_TRACE(<< "log(p) = " << logp << ", c.d.f. = " << cdf);
 
-        std::size_t n = logps.size();
-        double logpc = n % 2 == 0 ? (logps[n / 2 - 1] + logps[n / 2]) / 2.0
-                                  : logps[n / 2];
+        double logpc = this->correction(cdf);
         double alpha = maths::common::CTools::truncate((logp - A) / (B - A), 0.0, 1.0);
         LOG_TRACE(<< "Corrected log(p) = " << -alpha * logpc - (1.0 - alpha) * logp);
 
@@ -123,12 +110,14 @@ double CDetectorEqualizer::correct(int detector, double probability) {
 
 void CDetectorEqualizer::clear() {
     m_Sketches.clear();
+    m_Corrections.clear();
 }
 
 void CDetectorEqualizer::age(double factor) {
     for (auto& sketch : m_Sketches) {
         sketch.second.age(factor);
     }
+    m_Corrections.clear();
 }
 
 std::uint64_t CDetectorEqualizer::checksum() const {
@@ -144,11 +133,67 @@ maths::common::CQuantileSketch& CDetectorEqualizer::sketch(int detector) {
                               maths::common::COrderings::SFirstLess());
     if (i == m_Sketches.end() || i->first != detector) {
         i = m_Sketches.insert(i, {detector, maths::common::CQuantileSketch{SKETCH_SIZE}});
+        m_Corrections.clear();
     }
     return i->second;
 }
 
+bool CDetectorEqualizer::refreshCorrections() {
+    if (m_Corrections.size() > 0 &&
+        m_CountSinceCorrections <= MAXIMUM_COUNT_GROWTH_FOR_CORRECTIONS * m_CountAtCorrections) {
+        return true;
+    }
+
+    m_Corrections.clear();
+
+    double count{0.0};
+    for (const auto& sketch : m_Sketches) {
+        if (sketch.second.count() < MINIMUM_COUNT_FOR_CORRECTION) {
+            return false;
+        }
+        count += sketch.second.count();
+    }
+
+    TDoubleVec logps;
+    logps.reserve(m_Sketches.size());
+    m_Corrections.reserve(NUMBER_CORRECTIONS);
+    for (std::size_t i = 0; i < NUMBER_CORRECTIONS; ++i) {
+        double percentage{100.0 * static_cast<double>(i) /
+                          static_cast<double>(NUMBER_CORRECTIONS - 1)};
+        logps.clear();
+        for (const auto& sketch : m_Sketches) {
+            double logpi;
+            if (sketch.second.quantile(percentage, logpi)) {
+                logps.push_back(logpi);
+            }
+        }
+        if (logps.empty()) {
+            m_Corrections.clear();
+            return false;
+        }
+        std::sort(logps.begin(), logps.end());
+        std::size_t n = logps.size();
+        m_Corrections.push_back(n % 2 == 0 ? (logps[n / 2 - 1] + logps[n / 2]) / 2.0
+                                           : logps[n / 2]);
+    }
+    LOG_TRACE(<< "corrections = " << m_Corrections);
+
+    m_CountAtCorrections = count;
+    m_CountSinceCorrections = 0.0;
+    return true;
+}
+
+double CDetectorEqualizer::correction(double cdf) const {
+    double x{maths::common::CTools::truncate(cdf, 0.0, 1.0) *
+             static_cast<double>(m_Corrections.size() - 1)};
+    std::size_t i{std::min(static_cast<std::size_t>(x), m_Corrections.size() - 2)};
+    double alpha{x - static_cast<double>(i)};
+    return (1.0 - alpha) * m_Corrections[i] + alpha * m_Corrections[i + 1];
+}
+
 const std::size_t CDetectorEqualizer::SKETCH_SIZE(100);
 const double CDetectorEqualizer::MINIMUM_COUNT_FOR_CORRECTION(1.5);
+const std::size_t CDetectorEqualizer::NUMBER_CORRECTIONS(201);
+const double CDetectorEqualizer::MAXIMUM_COUNT_GROWTH_FOR_CORRECTIONS(0.05);
 }
 }
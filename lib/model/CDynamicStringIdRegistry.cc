@@ -30,6 +30,8 @@ namespace {
 const std::string NAMES_TAG("a");
 const std::string FREE_NAMES_TAG("b");
 const std::string RECYCLED_NAMES_TAG("c");
+const std::size_t MINIMUM_NUMBER_SLOTS{16};
+const CDynamicStringIdRegistry::TDictionary DICTIONARY;
 }
 
 CDynamicStringIdRegistry::CDynamicStringIdRegistry(const std::string& nameType,
@@ -38,15 +40,14 @@ CDynamicStringIdRegistry::CDynamicStringIdRegistry(const std::string& nameType,
                                                    counter_t::ECounterTypes recycledCounter)
     : m_NameType(nameType), m_AddedCounter(addedCounter),
       m_AddNotAllowedCounter(addNotAllowedCounter),
-      m_RecycledCounter(recycledCounter), m_Uids(1) {
+      m_RecycledCounter(recycledCounter) {
 }
 
 CDynamicStringIdRegistry::CDynamicStringIdRegistry(bool isForPersistence,
                                                    const CDynamicStringIdRegistry& other)
     : m_NameType(other.m_NameType), m_AddedCounter(other.m_AddedCounter),
       m_AddNotAllowedCounter(other.m_AddNotAllowedCounter),
-      m_RecycledCounter(other.m_RecycledCounter), m_Dictionary(other.m_Dictionary),
-      m_Uids(other.m_Uids), m_Names(other.m_Names),
+      m_RecycledCounter(other.m_RecycledCounter), m_Uids(other.m_Uids), m_Names(other.m_Names),
       m_FreeUids(other.m_FreeUids), m_RecycledUids(other.m_RecycledUids) {
     if (!isForPersistence) {
         LOG_ABORT(<< "This constructor only creates clones for persistence");
@@ -59,23 +60,17 @@ const std::string& CDynamicStringIdRegistry::name(std::size_t id,
 }
 
 bool CDynamicStringIdRegistry::id(const std::string& name, std::size_t& result) const {
-    TWordSizeUMapCItr itr = m_Uids.find(m_Dictionary.word(name));
-    if (itr == m_Uids.end()) {
-        result = INVALID_ID;
-        return false;
-    }
-    result = itr->second;
-    return true;
+    return this->id(word(name), result);
+}
+
+bool CDynamicStringIdRegistry::id(const TWord& word, std::size_t& result) const {
+    result = m_Uids.find(word);
+    return result != INVALID_ID;
 }
 
 bool CDynamicStringIdRegistry::anyId(std::size_t& result) const {
-    TWordSizeUMapCItr itr = m_Uids.begin();
-    if (itr == m_Uids.end()) {
-        result = INVALID_ID;
-        return false;
-    }
-    result = itr->second;
-    return true;
+    result = m_Uids.any();
+    return result != INVALID_ID;
 }
 
 std::size_t CDynamicStringIdRegistry::numberActiveNames() const {
@@ -95,6 +90,14 @@ std::size_t CDynamicStringIdRegistry::addName(const std::string& name,
                                               core_t::TTime time,
                                               CResourceMonitor& resourceMonitor,
                                               bool& addedPerson) {
+    return this->addName(name, word(name), time, resourceMonitor, addedPerson);
+}
+
+std::size_t CDynamicStringIdRegistry::addName(const std::string& name,
+                                              const TWord& word,
+                                              core_t::TTime time,
+                                              CResourceMonitor& resourceMonitor,
+                                              bool& addedPerson) {
     // Get the identifier or create one if this is the
     // first time we've seen them. (Use emplace to avoid copying
     // the string if it is already in the collection.)
@@ -105,17 +108,16 @@ std::size_t CDynamicStringIdRegistry::addName(const std::string& name,
 
     // Is there any space in the system for us to expand the models?
     if (resourceMonitor.areAllocationsAllowed()) {
-        id = m_Uids.emplace(m_Dictionary.word(name), newId).first->second;
+        id = m_Uids.emplace(word, newId);
     } else {
         // In this case we can only deal with existing people
-        TWordSizeUMapCItr itr = m_Uids.find(m_Dictionary.word(name));
-        if (itr == m_Uids.end()) {
+        id = m_Uids.find(word);
+        if (id == INVALID_ID) {
             LOG_TRACE(<< "Can't add new " << m_NameType << " - allocations not allowed");
             resourceMonitor.acceptAllocationFailureResult(time);
             ++core::CProgramCounters::counter(m_AddNotAllowedCounter);
             return INVALID_ID;
         }
-        id = itr->second;
     }
 
     if (id >= m_Names.size()) {
@@ -144,7 +146,7 @@ void CDynamicStringIdRegistry::removeNames(std::size_t lowestNameToRemove) {
     }
 
     for (std::size_t id = lowestNameToRemove; id < numberNames; ++id) {
-        m_Uids.erase(m_Dictionary.word(m_Names[id]));
+        m_Uids.erase(word(m_Names[id]));
     }
     m_Names.erase(m_Names.begin() + lowestNameToRemove, m_Names.end());
 }
@@ -158,7 +160,7 @@ void CDynamicStringIdRegistry::recycleNames(const TSizeVec& namesToRemove,
             continue;
         }
         m_FreeUids.push_back(id);
-        m_Uids.erase(m_Dictionary.word(m_Names[id]));
+        m_Uids.erase(word(m_Names[id]));
         m_Names[id] = defaultName;
     }
     std::sort(m_FreeUids.begin(), m_FreeUids.end(), std::greater<>());
@@ -181,14 +183,14 @@ bool CDynamicStringIdRegistry::checkInvariants() const {
     }
 
     TSizeUSet uniqueIds;
-    for (TWordSizeUMapCItr i = m_Uids.begin(); i != m_Uids.end(); ++i) {
-        if (!uniqueIds.insert(i->second).second) {
-            LOG_ERROR(<< "Duplicate id " << i->second);
+    for (auto id : m_Uids.ids()) {
+        if (!uniqueIds.insert(id).second) {
+            LOG_ERROR(<< "Duplicate id " << id);
             result = false;
         }
-        if (i->second > m_Names.size()) {
-            LOG_ERROR(<< m_NameType << " id " << i->second
-                      << " out of range [0, " << m_Names.size() << ")");
+        if (id > m_Names.size()) {
+            LOG_ERROR(<< m_NameType << " id " << id << " out of range [0, "
+                      << m_Names.size() << ")");
             result = false;
         }
     }
@@ -271,13 +273,117 @@ bool CDynamicStringIdRegistry::acceptRestoreTraverser(core::CStateRestoreTravers
             LOG_TRACE(<< "Restore ignoring free " << m_NameType << " name "
                       << m_Names[id] << " = id " << id);
         } else {
-            m_Uids[m_Dictionary.word(m_Names[id])] = id;
+            m_Uids.emplace(word(m_Names[id]), id);
         }
     }
 
     return true;
 }
 
+CDynamicStringIdRegistry::TWord CDynamicStringIdRegistry::word(const std::string& name) {
+    return DICTIONARY.word(name);
+}
+
+std::size_t CDynamicStringIdRegistry::CUidMap::find(const TWord& word) const {
+    return m_Slots.empty() ? INVALID_ID : m_Slots[this->slot(word)].s_Id;
+}
+
+std::size_t CDynamicStringIdRegistry::CUidMap::emplace(const TWord& word, std::size_t id) {
+    if (4 * (m_Size + 1) > 3 * m_Slots.size()) {
+        this->grow();
+    }
+    SSlot& slot{m_Slots[this->slot(word)]};
+    if (slot.s_Id == INVALID_ID) {
+        slot.s_Word = word;
+        slot.s_Id = id;
+        ++m_Size;
+    }
+    return slot.s_Id;
+}
+
+void CDynamicStringIdRegistry::CUidMap::erase(const TWord& word) {
+    if (m_Slots.empty()) {
+        return;
+    }
+    std::size_t mask{m_Slots.size() - 1};
+    std::size_t hole{this->slot(word)};
+    if (m_Slots[hole].s_Id == INVALID_ID) {
+        return;
+    }
+    m_Slots[hole].s_Id = INVALID_ID;
+    --m_Size;
+
+    // Shift back any following entries which can't otherwise be reached
+    // from their home slots.
+    for (std::size_t next = (hole + 1) & mask; m_Slots[next].s_Id != INVALID_ID;
+         next = (next + 1) & mask) {
+        std::size_t home{m_Slots[next].s_Word.hash() & mask};
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            m_Slots[hole] = m_Slots[next];
+            m_Slots[next].s_Id = INVALID_ID;
+            hole = next;
+        }
+    }
+}
+
+std::size_t CDynamicStringIdRegistry::CUidMap::any() const {
+    for (const auto& slot : m_Slots) {
+        if (slot.s_Id != INVALID_ID) {
+            return slot.s_Id;
+        }
+    }
+    return INVALID_ID;
+}
+
+CDynamicStringIdRegistry::TSizeVec CDynamicStringIdRegistry::CUidMap::ids() const {
+    TSizeVec result;
+    result.reserve(m_Size);
+    for (const auto& slot : m_Slots) {
+        if (slot.s_Id != INVALID_ID) {
+            result.push_back(slot.s_Id);
+        }
+    }
+    return result;
+}
+
+std::size_t CDynamicStringIdRegistry::CUidMap::size() const {
+    return m_Size;
+}
+
+void CDynamicStringIdRegistry::CUidMap::clear() {
+    m_Slots.clear();
+    m_Size = 0;
+}
+
+void CDynamicStringIdRegistry::CUidMap::debugMemoryUsage(
+    const core::CMemoryUsage::TMemoryUsagePtr& mem) const {
+    mem->setName("CUidMap");
+    core::memory_debug::dynamicSize("m_Slots", m_Slots, mem);
+}
+
+std::size_t CDynamicStringIdRegistry::CUidMap::memoryUsage() const {
+    return core::memory::dynamicSize(m_Slots);
+}
+
+std::size_t CDynamicStringIdRegistry::CUidMap::slot(const TWord& word) const {
+    std::size_t mask{m_Slots.size() - 1};
+    std::size_t result{word.hash() & mask};
+    while (m_Slots[result].s_Id != INVALID_ID && !(m_Slots[result].s_Word == word)) {
+        result = (result + 1) & mask;
+    }
+    return result;
+}
+
+void CDynamicStringIdRegistry::CUidMap::grow() {
+    TSlotVec slots(std::max(2 * m_Slots.size(), MINIMUM_NUMBER_SLOTS));
+    std::swap(slots, m_Slots);
+    for (const auto& slot : slots) {
+        if (slot.s_Id != INVALID_ID) {
+            m_Slots[this->slot(slot.s_Word)] = slot;
+        }
+    }
+}
+
 const std::size_t
     CDynamicStringIdRegistry::INVALID_ID(std::numeric_limits<std::size_t>::max());
 }
@@ -603,7 +603,8 @@ struct SNewBucket {
     void operator()(TSizeSizePrStrDataUMapQueue& personAttributeUniqueCounts,
                     core_t::TTime time) const {
         if (time > personAttributeUniqueCounts.latestBucketEnd()) {
-            personAttributeUniqueCounts.push(TSizeSizePrStrDataUMap(1), time);
+            personAttributeUniqueCounts.recycle(
+                [](TSizeSizePrStrDataUMap& counts) { counts.clear(); }, time);
         } else {
             personAttributeUniqueCounts.get(time).clear();
         }
@@ -611,7 +612,8 @@ struct SNewBucket {
     void operator()(TSizeSizePrMeanAccumulatorUMapQueue& arrivalTimes,
                     core_t::TTime time) const {
         if (time > arrivalTimes.latestBucketEnd()) {
-            arrivalTimes.push(TSizeSizePrMeanAccumulatorUMap(1), time);
+            arrivalTimes.recycle(
+                [](TSizeSizePrMeanAccumulatorUMap& times) { times.clear(); }, time);
         } else {
             arrivalTimes.get(time).clear();
         }
@@ -839,6 +841,7 @@ std::string CEventRateBucketGatherer::description() const {
 }
 
 bool CEventRateBucketGatherer::processFields(const TStrCPtrVec& fieldValues,
+                                             const TWordVec& fieldWords,
                                              CEventData& result,
                                              CResourceMonitor& resourceMonitor) {
     using TOptionalSize = std::optional<std::size_t>;
@@ -849,6 +852,11 @@ bool CEventRateBucketGatherer::processFields(const TStrCPtrVec& fieldValues,
                   << ", for field names: " << m_FieldNames);
         return false;
     }
+    if (fieldWords.size() > 0 && fieldWords.size() != fieldValues.size()) {
+        LOG_ERROR(<< "Unexpected field words: " << fieldWords.size()
+                  << ", for field values: " << fieldValues);
+        return false;
+    }
 
     const std::string* person = (fieldValues[0] == nullptr && m_DataGatherer.useNull())
                                     ? &EMPTY_STRING
@@ -902,8 +910,10 @@ bool CEventRateBucketGatherer::processFields(const TStrCPtrVec& fieldValues,
     std::size_t personId = CDynamicStringIdRegistry::INVALID_ID;
     if (result.isExplicitNull()) {
         m_DataGatherer.personId(*person, personId);
-    } else {
+    } else if (fieldWords.empty() || fieldValues[0] == nullptr) {
         personId = m_DataGatherer.addPerson(*person, resourceMonitor, addedPerson);
+    } else {
+        personId = m_DataGatherer.addPerson(*person, fieldWords[0], resourceMonitor, addedPerson);
     }
 
     if (personId == CDynamicStringIdRegistry::INVALID_ID) {
@@ -945,9 +955,12 @@ bool CEventRateBucketGatherer::processFields(const TStrCPtrVec& fieldValues,
         std::size_t newAttribute = CDynamicStringIdRegistry::INVALID_ID;
         if (result.isExplicitNull()) {
             m_DataGatherer.attributeId(*attribute, newAttribute);
-        } else {
+        } else if (fieldWords.empty() || fieldValues[1] == nullptr) {
             newAttribute = m_DataGatherer.addAttribute(*attribute, resourceMonitor,
                                                        addedAttribute);
+        } else {
+            newAttribute = m_DataGatherer.addAttribute(*attribute, fieldWords[1],
+                                                       resourceMonitor, addedAttribute);
         }
         result.addAttribute(TOptionalSize(newAttribute));
 
@@ -1178,13 +1191,15 @@ void CEventRateBucketGatherer::nonZeroPersonCounts(model_t::EFeature feature,
     result_.emplace_back(feature, TSizeFeatureDataPrVec());
     auto& result = *std::any_cast<TSizeFeatureDataPrVec>(&result_.back().second);
 
-    const TSizeSizePrUInt64UMap& personAttributeCounts = this->bucketCounts(time);
+    const TSizeSizePrUInt64FlatMap& personAttributeCounts = this->bucketCounts(time);
     result.reserve(personAttributeCounts.size());
     for (const auto& count : personAttributeCounts) {
         result.emplace_back(CDataGatherer::extractPersonId(count),
                             CDataGatherer::extractData(count));
     }
-    std::sort(result.begin(), result.end(), maths::common::COrderings::SFirstLess());
+    if (personAttributeCounts.isSorted() == false) {
+        std::sort(result.begin(), result.end(), maths::common::COrderings::SFirstLess());
+    }
 
     this->addInfluencerCounts(time, result);
 }
@@ -1195,12 +1210,14 @@ void CEventRateBucketGatherer::personIndicator(model_t::EFeature feature,
     result_.emplace_back(feature, TSizeFeatureDataPrVec());
     auto& result = *std::any_cast<TSizeFeatureDataPrVec>(&result_.back().second);
 
-    const TSizeSizePrUInt64UMap& personAttributeCounts = this->bucketCounts(time);
+    const TSizeSizePrUInt64FlatMap& personAttributeCounts = this->bucketCounts(time);
     result.reserve(personAttributeCounts.size());
     for (const auto& count : personAttributeCounts) {
         result.emplace_back(CDataGatherer::extractPersonId(count), 1);
     }
-    std::sort(result.begin(), result.end(), maths::common::COrderings::SFirstLess());
+    if (personAttributeCounts.isSorted() == false) {
+        std::sort(result.begin(), result.end(), maths::common::COrderings::SFirstLess());
+    }
 
     this->addInfluencerCounts(time, result);
 }
@@ -1218,14 +1235,16 @@ void CEventRateBucketGatherer::nonZeroAttributeCounts(model_t::EFeature feature,
     result_.emplace_back(feature, TSizeSizePrFeatureDataPrVec());
     auto& result = *std::any_cast<TSizeSizePrFeatureDataPrVec>(&result_.back().second);
 
-    const TSizeSizePrUInt64UMap& personAttributeCounts = this->bucketCounts(time);
+    const TSizeSizePrUInt64FlatMap& personAttributeCounts = this->bucketCounts(time);
     result.reserve(personAttributeCounts.size());
     for (const auto& count : personAttributeCounts) {
         if (CDataGatherer::extractData(count) > 0) {
             result.emplace_back(count.first, CDataGatherer::extractData(count));
         }
     }
-    std::sort(result.begin(), result.end(), maths::common::COrderings::SFirstLess());
+    if (personAttributeCounts.isSorted() == false) {
+        std::sort(result.begin(), result.end(), maths::common::COrderings::SFirstLess());
+    }
 
     this->addInfluencerCounts(time, result);
 }
@@ -1261,14 +1280,16 @@ void CEventRateBucketGatherer::attributeIndicator(model_t::EFeature feature,
     result_.emplace_back(feature, TSizeSizePrFeatureDataPrVec());
     auto& result = *std::any_cast<TSizeSizePrFeatureDataPrVec>(&result_.back().second);
 
-    const TSizeSizePrUInt64UMap& counts = this->bucketCounts(time);
+    const TSizeSizePrUInt64FlatMap& counts = this->bucketCounts(time);
     result.reserve(counts.size());
     for (const auto& count : counts) {
         if (CDataGatherer::extractData(count) > 0) {
             result.emplace_back(count.first, 1);
         }
     }
-    std::sort(result.begin(), result.end(), maths::common::COrderings::SFirstLess());
+    if (counts.isSorted() == false) {
+        std::sort(result.begin(), result.end(), maths::common::COrderings::SFirstLess());
+    }
 
     this->addInfluencerCounts(time, result);
     for (std::size_t i = 0; i < result.size(); ++i) {
@@ -229,28 +229,25 @@ void CEventRateModel::sample(core_t::TTime startTime,
     this->currentBucketInterimCorrections().clear();
     m_CurrentBucketStats.s_Annotations.clear();
 
+    // Declared outside the loop to minimize the number of times they are created.
+    TSizeTimePrVec preSampleLastBucketTimes;
+    maths::common::CModel::TTimeDouble2VecSizeTrVec values;
+    maths::common::CModelAddSamplesParams::TDouble2VecWeightsAryVec trendWeights;
+    maths::common::CModelAddSamplesParams::TDouble2VecWeightsAryVec priorWeights;
+    CMemoryCircuitBreaker circuitBreaker{resourceMonitor};
+    bool annotationsEnabled{this->params().s_AnnotationsEnabled};
+
     for (core_t::TTime time = startTime; time < endTime; time += bucketLength) {
         LOG_TRACE(<< "Sampling [" << time << "," << time + bucketLength << ")");
 
         gatherer.sampleNow(time);
         gatherer.featureData(time, bucketLength, m_CurrentBucketStats.s_FeatureData);
 
-        const CIndividualModel::TTimeVec& preSampleLastBucketTimes = this->lastBucketTimes();
-        CIndividualModel::TSizeTimeUMap lastBucketTimesMap;
-        for (const auto& featureData : m_CurrentBucketStats.s_FeatureData) {
-            for (const auto& data : featureData.second) {
-                std::size_t pid = data.first;
-                lastBucketTimesMap[pid] = preSampleLastBucketTimes[pid];
-            }
-        }
+        this->lastBucketTimesBeforeSampling(m_CurrentBucketStats.s_FeatureData,
+                                            preSampleLastBucketTimes);
 
         this->CIndividualModel::sample(time, time + bucketLength, resourceMonitor);
 
-        // Declared outside the loop to minimize the number of times they are created.
-        maths::common::CModel::TTimeDouble2VecSizeTrVec values;
-        maths::common::CModelAddSamplesParams::TDouble2VecWeightsAryVec trendWeights;
-        maths::common::CModelAddSamplesParams::TDouble2VecWeightsAryVec priorWeights;
-
         for (auto& featureData : m_CurrentBucketStats.s_FeatureData) {
             model_t::EFeature feature = featureData.first;
             TSizeFeatureDataPrVec& data = featureData.second;
@@ -276,6 +273,11 @@ void CEventRateModel::sample(core_t::TTime startTime,
 
             this->applyFilter(model_t::E_XF_By, true, this->personFilter(), data);
 
+            // These are the same for every person so are computed once per feature.
+            core_t::TTime sampleTime = model_t::sampleTime(feature, time, bucketLength);
+            double learnRate{this->learnRate(feature)};
+            bool includeEmptyBuckets{model_t::includeEmptyBuckets(feature)};
+
             for (const auto& data_ : data) {
                 std::size_t pid = data_.first;
 
@@ -296,11 +298,10 @@ void CEventRateModel::sample(core_t::TTime startTime,
                 // https://github.com/elastic/ml-cpp/issues/1272, Namely
                 // 1. If you apply it from the start of the modelling it can stop the model learning anything at all.
                 // 2. It can stop the model ever adapting to some change in data characteristics
-                core_t::TTime sampleTime = model_t::sampleTime(feature, time, bucketLength);
                 double initialCountWeight = this->initialCountWeight(
                     feature, pid, model_t::INDIVIDUAL_ANALYSIS_ATTRIBUTE_ID, sampleTime);
                 if (initialCountWeight == 0.0) {
-                    model->skipTime(sampleTime - lastBucketTimesMap[pid]);
+                    model->skipTime(sampleTime - lastBucketTime(pid, preSampleLastBucketTimes));
                     continue;
                 }
 
@@ -316,7 +317,7 @@ void CEventRateModel::sample(core_t::TTime startTime,
                     feature, static_cast<double>(data_.second.s_Count));
                 TDouble2Vec value{count};
                 double outlierWeightDerate = this->derate(pid, sampleTime);
-                double countWeight = initialCountWeight * this->learnRate(feature);
+                double countWeight = initialCountWeight * learnRate;
                 // Note we need to scale the amount of data we'll "age out" of the residual
                 // model in one bucket by the empty bucket weight so the posterior doesn't
                 // end up too flat.
@@ -338,33 +339,27 @@ void CEventRateModel::sample(core_t::TTime startTime,
                                     outlierWeightDerate, 1.0, // count variance scale
                                     trendWeights[0], priorWeights[0]);
 
-                auto annotationCallback = [&](const std::string& annotation) {
-                    if (this->params().s_AnnotationsEnabled) {
-                        m_CurrentBucketStats.s_Annotations.emplace_back(
-                            time, CAnnotation::E_ModelChange, annotation,
-                            gatherer.searchKey().detectorIndex(),
-                            gatherer.searchKey().partitionFieldName(),
-                            gatherer.partitionFieldValue(),
-                            gatherer.searchKey().overFieldName(), EMPTY_STRING,
-                            gatherer.searchKey().byFieldName(), gatherer.personName(pid));
-                    }
-                };
-
                 maths::common::CModelAddSamplesParams params;
-                auto circuitBreaker = CMemoryCircuitBreaker(resourceMonitor);
                 params.isInteger(true)
                     .isNonNegative(true)
                     .propagationInterval(scaledInterval)
                     .trendWeights(trendWeights)
                     .priorWeights(priorWeights)
-                    .bucketOccupancy(model_t::includeEmptyBuckets(feature)
-                                         ? this->personFrequency(pid)
-                                         : 1.0)
+                    .bucketOccupancy(includeEmptyBuckets ? this->personFrequency(pid) : 1.0)
                     .firstValueTime(pid < this->firstBucketTimes().size()
                                         ? this->firstBucketTimes()[pid]
                                         : std::numeric_limits<core_t::TTime>::min())
                     .annotationCallback([&](const std::string& annotation) {
-                        annotationCallback(annotation);
+                        if (annotationsEnabled) {
+                            m_CurrentBucketStats.s_Annotations.emplace_back(
+                                time, CAnnotation::E_ModelChange, annotation,
+                                gatherer.searchKey().detectorIndex(),
+                                gatherer.searchKey().partitionFieldName(),
+                                gatherer.partitionFieldValue(),
+                                gatherer.searchKey().overFieldName(), EMPTY_STRING,
+                                gatherer.searchKey().byFieldName(),
+                                gatherer.personName(pid));
+                        }
                     })
                     .memoryCircuitBreaker(circuitBreaker);
 
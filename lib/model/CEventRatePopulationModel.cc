@@ -144,6 +144,8 @@ void CEventRatePopulationModel::initialize(
                       return lhs.s_Feature < rhs.s_Feature;
                   });
     }
+
+    m_MemoryEstimator.marginalCosts(this->marginalMemoryCosts(m_FeatureModels));
 }
 
 CEventRatePopulationModel::CEventRatePopulationModel(bool isForPersistence,
@@ -160,11 +162,10 @@ CEventRatePopulationModel::CEventRatePopulationModel(bool isForPersistence,
 
     m_FeatureModels.reserve(m_FeatureModels.size());
     for (const auto& feature : other.m_FeatureModels) {
-        m_FeatureModels.emplace_back(feature.s_Feature, feature.s_NewModel);
-        m_FeatureModels.back().s_Models.reserve(feature.s_Models.size());
-        for (const auto& model : feature.s_Models) {
-            m_FeatureModels.back().s_Models.emplace_back(model->cloneForPersistence());
-        }
+        bool correlated{std::any_of(
+            other.m_FeatureCorrelatesModels.begin(), other.m_FeatureCorrelatesModels.end(),
+            [&](const auto& correlates) { return correlates.s_Feature == feature.s_Feature; })};
+        m_FeatureModels.push_back(feature.copyForPersistence(correlated));
     }
 
     m_FeatureCorrelatesModels.reserve(other.m_FeatureCorrelatesModels.size());
@@ -1029,8 +1030,8 @@ const CInterimBucketCorrector& CEventRatePopulationModel::interimValueCorrector(
 void CEventRatePopulationModel::doSkipSampling(core_t::TTime startTime, core_t::TTime endTime) {
     core_t::TTime gap = endTime - startTime;
     for (auto& feature : m_FeatureModels) {
-        for (auto& model : feature.s_Models) {
-            model->skipTime(gap);
+        for (std::size_t id = 0; id < feature.s_Models.size(); ++id) {
+            feature.mutableModel(id)->skipTime(gap);
         }
     }
     this->CPopulationModel::doSkipSampling(startTime, endTime);
@@ -1038,7 +1039,13 @@ void CEventRatePopulationModel::doSkipSampling(core_t::TTime startTime, core_t::
 
 const maths::common::CModel*
 CEventRatePopulationModel::model(model_t::EFeature feature, std::size_t cid) const {
-    return const_cast<CEventRatePopulationModel*>(this)->model(feature, cid);
+    auto i = std::find_if(m_FeatureModels.begin(), m_FeatureModels.end(),
+                          [feature](const SFeatureModels& model) {
+                              return model.s_Feature == feature;
+                          });
+    return i != m_FeatureModels.end() && cid < i->s_Models.size()
+               ? i->s_Models[cid].get()
+               : nullptr;
 }
 
 maths::common::CModel* CEventRatePopulationModel::model(model_t::EFeature feature,
@@ -1048,7 +1055,7 @@ maths::common::CModel* CEventRatePopulationModel::model(model_t::EFeature featur
                               return model.s_Feature == feature;
                           });
     return i != m_FeatureModels.end() && cid < i->s_Models.size()
-               ? i->s_Models[cid].get()
+               ? i->mutableModel(cid)
                : nullptr;
 }
 
@@ -78,13 +78,8 @@ bool CForecastDataSink::CForecastModelWrapper::forecast(const SForecastResultSer
                                                         double boundsPercentile,
                                                         CForecastDataSink& sink,
                                                         std::string& message) const {
-    core_t::TTime bucketLength{m_ForecastModel->params().bucketLength()};
-    startTime = model_t::sampleTime(m_Feature, startTime, bucketLength);
-    endTime = model_t::sampleTime(m_Feature, endTime, bucketLength);
-    model_t::TDouble1VecDouble1VecPr support{model_t::support(m_Feature)};
-    return m_ForecastModel->forecast(
-        m_FirstDataTime, m_LastDataTime, startTime, endTime, boundsPercentile,
-        support.first, support.second,
+    return this->doForecast(
+        startTime, endTime, boundsPercentile,
         std::bind(static_cast<void (CForecastDataSink::*)(
                       const maths::common::SErrorBar, const std::string&, const std::string&,
                       const std::string&, const std::string&, const std::string&, int)>(
@@ -95,6 +90,46 @@ bool CForecastDataSink::CForecastModelWrapper::forecast(const SForecastResultSer
         message);
 }
 
+bool CForecastDataSink::CForecastModelWrapper::forecast(core_t::TTime startTime,
+                                                        core_t::TTime endTime,
+                                                        double boundsPercentile,
+                                                        TErrorBarVec& errorBars,
+                                                        std::string& message) const {
+    errorBars.clear();
+    return this->doForecast(
+        startTime, endTime, boundsPercentile,
+        [&errorBars](maths::common::SErrorBar errorBar) {
+            errorBars.push_back(errorBar);
+        },
+        message);
+}
+
+void CForecastDataSink::CForecastModelWrapper::write(const SForecastResultSeries& series,
+                                                     const TErrorBarVec& errorBars,
+                                                     CForecastDataSink& sink) const {
+    std::string feature{model_t::print(m_Feature)};
+    for (const auto& errorBar : errorBars) {
+        sink.push(errorBar, feature, series.s_PartitionFieldName,
+                  series.s_PartitionFieldValue, series.s_ByFieldName,
+                  m_ByFieldValue, series.s_DetectorIndex);
+    }
+}
+
+bool CForecastDataSink::CForecastModelWrapper::doForecast(
+    core_t::TTime startTime,
+    core_t::TTime endTime,
+    double boundsPercentile,
+    const std::function<void(maths::common::SErrorBar)>& push,
+    std::string& message) const {
+    core_t::TTime bucketLength{m_ForecastModel->params().bucketLength()};
+    startTime = model_t::sampleTime(m_Feature, startTime, bucketLength);
+    endTime = model_t::sampleTime(m_Feature, endTime, bucketLength);
+    model_t::TDouble1VecDouble1VecPr support{model_t::support(m_Feature)};
+    return m_ForecastModel->forecast(m_FirstDataTime, m_LastDataTime, startTime,
+                                     endTime, boundsPercentile, support.first,
+                                     support.second, push, message);
+}
+
 CForecastDataSink::SForecastResultSeries::SForecastResultSeries(const SModelParams& modelParams)
     : s_ModelParams(modelParams), s_DetectorIndex(), s_ToForecastPersisted(),
       s_ByFieldName(), s_MinimumSeasonalVarianceScale(0.0) {
@@ -221,9 +221,10 @@ void CGathererTools::CSumGatherer::startNewBucket(core_t::TTime time) {
     if (!sum.empty()) {
         m_Classifier.add(model_t::E_IndividualSumByBucketAndPerson, sum[0].value(), 1);
     }
-    m_BucketSums.push(TSampleVec(), time);
+    m_BucketSums.recycle([](TSampleVec& sums) { sums.clear(); }, time);
     for (std::size_t i = 0; i < m_InfluencerBucketSums.size(); ++i) {
-        m_InfluencerBucketSums[i].push(TOptionalStrDoubleUMap(1), time);
+        m_InfluencerBucketSums[i].recycle(
+            [](TOptionalStrDoubleUMap& sums) { sums.clear(); }, time);
     }
 }
 
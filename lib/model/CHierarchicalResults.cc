@@ -34,6 +34,10 @@ using TNodeCPtr = SNode::TNodeCPtr;
 
 const std::string COUNT("count");
 
+//! The size of the first block of node storage. This is enough for the
+//! nodes of a few tens of results before the arena needs to grow.
+const std::size_t NODE_ARENA_INITIAL_BLOCK_SIZE{16384};
+
 //! True if the node is a leaf.
 bool isLeaf(const SNode& node) {
     return node.s_Children.empty();
@@ -281,7 +285,11 @@ void swap(SNode& node1, SNode& node2) noexcept {
 using namespace hierarchical_results_detail;
 
 CHierarchicalResults::CHierarchicalResults()
-    : m_ResultType(model_t::CResultType::E_Final) {
+    : m_Arena{NODE_ARENA_INITIAL_BLOCK_SIZE},
+      m_Nodes{TNodeDeque::allocator_type{m_Arena}},
+      m_PivotNodes{TOptionalStrOptionalStrPrNodeMap::allocator_type{m_Arena}},
+      m_PivotRootNodes{TOptionalStrNodeMap::allocator_type{m_Arena}},
+      m_ResultType(model_t::CResultType::E_Final) {
 }
 
 void CHierarchicalResults::addSimpleCountResult(SAnnotatedProbability& annotatedProbability,
@@ -344,6 +352,21 @@ void CHierarchicalResults::addInfluencer(const std::string& name) {
     this->newPivotRoot(name);
 }
 
+void CHierarchicalResults::append(CHierarchicalResults&& other) {
+    for (auto& node : other.m_Nodes) {
+        m_Nodes.push_back(std::move(node));
+    }
+    for (auto& pivot : other.m_PivotNodes) {
+        m_PivotNodes.emplace(pivot.first, std::move(pivot.second));
+    }
+    for (auto& pivotRoot : other.m_PivotRootNodes) {
+        m_PivotRootNodes.emplace(pivotRoot.first, std::move(pivotRoot.second));
+    }
+    other.m_Nodes.clear();
+    other.m_PivotNodes.clear();
+    other.m_PivotRootNodes.clear();
+}
+
 void CHierarchicalResults::buildHierarchy() {
     using TNodePtrVec = std::vector<SNode*>;
 
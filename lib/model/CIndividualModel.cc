@@ -98,12 +98,15 @@ CIndividualModel::CIndividualModel(const SModelParams& params,
                       return lhs.s_Feature < rhs.s_Feature;
                   });
     }
+
+    this->initializeMarginalMemoryCosts();
 }
 
 CIndividualModel::CIndividualModel(bool isForPersistence, const CIndividualModel& other)
     : CAnomalyDetectorModel(isForPersistence, other),
       m_FirstBucketTimes(other.m_FirstBucketTimes),
       m_LastBucketTimes(other.m_LastBucketTimes),
+      m_LastBucketTimeIndex(other.m_LastBucketTimeIndex),
       m_MemoryEstimator(other.m_MemoryEstimator) {
     if (!isForPersistence) {
         LOG_ABORT(<< "This constructor only creates clones for persistence");
@@ -111,11 +114,10 @@ CIndividualModel::CIndividualModel(bool isForPersistence, const CIndividualModel
 
     m_FeatureModels.reserve(m_FeatureModels.size());
     for (const auto& feature : other.m_FeatureModels) {
-        m_FeatureModels.emplace_back(feature.s_Feature, feature.s_NewModel);
-        m_FeatureModels.back().s_Models.reserve(feature.s_Models.size());
-        for (const auto& model : feature.s_Models) {
-            m_FeatureModels.back().s_Models.emplace_back(model->cloneForPersistence());
-        }
+        bool correlated{std::any_of(
+            other.m_FeatureCorrelatesModels.begin(), other.m_FeatureCorrelatesModels.end(),
+            [&](const auto& correlates) { return correlates.s_Feature == feature.s_Feature; })};
+        m_FeatureModels.push_back(feature.copyForPersistence(correlated));
     }
 
     m_FeatureCorrelatesModels.reserve(other.m_FeatureCorrelatesModels.size());
@@ -190,7 +192,10 @@ void CIndividualModel::sample(core_t::TTime startTime,
             if (CAnomalyDetectorModel::isTimeUnset(m_FirstBucketTimes[pid])) {
                 m_FirstBucketTimes[pid] = time;
             }
-            m_LastBucketTimes[pid] = time;
+            if (m_LastBucketTimes[pid] != time) {
+                m_LastBucketTimes[pid] = time;
+                m_LastBucketTimeIndex.add(pid, time);
+            }
         }
         this->applyFilter(model_t::E_XF_By, true, this->personFilter(), personCounts);
     }
@@ -205,25 +210,18 @@ void CIndividualModel::prune(std::size_t maximumAge) {
 
     CDataGatherer& gatherer = this->dataGatherer();
 
+    // Only people whose last bucket time has expired since the last prune
+    // are visited.
     TSizeVec peopleToRemove;
-    for (std::size_t pid = 0; pid < m_LastBucketTimes.size(); ++pid) {
-        if (gatherer.isPersonActive(pid) &&
-            !CAnomalyDetectorModel::isTimeUnset(m_LastBucketTimes[pid])) {
-            std::size_t bucketsSinceLastEvent = static_cast<std::size_t>(
-                (time - m_LastBucketTimes[pid]) / gatherer.bucketLength());
-            if (bucketsSinceLastEvent > maximumAge) {
-                LOG_TRACE(<< gatherer.personName(pid) << ", bucketsSinceLastEvent = " << bucketsSinceLastEvent
-                          << ", maximumAge = " << maximumAge);
-                peopleToRemove.push_back(pid);
-            }
-        }
-    }
+    m_LastBucketTimeIndex.removeExpired(
+        time, gatherer.bucketLength(), maximumAge, m_LastBucketTimes,
+        [&gatherer](std::size_t pid) { return gatherer.isPersonActive(pid); },
+        peopleToRemove);
 
     if (peopleToRemove.empty()) {
         return;
     }
 
-    std::sort(peopleToRemove.begin(), peopleToRemove.end());
     LOG_DEBUG(<< "Removing people {" << this->printPeople(peopleToRemove, 20) << '}');
 
     // We clear large state objects from removed people's model
@@ -287,6 +285,7 @@ void CIndividualModel::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePt
     this->CAnomalyDetectorModel::debugMemoryUsage(mem->addChild());
     core::memory_debug::dynamicSize("m_FirstBucketTimes", m_FirstBucketTimes, mem);
     core::memory_debug::dynamicSize("m_LastBucketTimes", m_LastBucketTimes, mem);
+    core::memory_debug::dynamicSize("m_LastBucketTimeIndex", m_LastBucketTimeIndex, mem);
     core::memory_debug::dynamicSize("m_FeatureModels", m_FeatureModels, mem);
     core::memory_debug::dynamicSize("m_FeatureCorrelatesModels",
                                     m_FeatureCorrelatesModels, mem);
@@ -305,6 +304,7 @@ std::size_t CIndividualModel::computeMemoryUsage() const {
     std::size_t mem = this->CAnomalyDetectorModel::memoryUsage();
     mem += core::memory::dynamicSize(m_FirstBucketTimes);
     mem += core::memory::dynamicSize(m_LastBucketTimes);
+    mem += core::memory::dynamicSize(m_LastBucketTimeIndex);
     mem += core::memory::dynamicSize(m_FeatureModels);
     mem += core::memory::dynamicSize(m_FeatureCorrelatesModels);
     mem += core::memory::dynamicSize(m_MemoryEstimator);
@@ -393,6 +393,8 @@ bool CIndividualModel::doAcceptRestoreTraverser(core::CStateRestoreTraverser& tr
         return false;
     }
 
+    m_LastBucketTimeIndex.invalidate();
+
     const double DEFAULT_CUTOFF_TO_MODEL_EMPTY_BUCKETS{0.2};
 
     for (auto& feature : m_FeatureModels) {
@@ -443,6 +445,8 @@ void CIndividualModel::createUpdateNewModels(core_t::TTime time,
         0, // # attributes
         numberCorrelations);
     std::size_t ourUsage = usageEstimate ? *usageEstimate : this->computeMemoryUsage();
+    std::size_t initialUsage = ourUsage;
+    std::size_t initialNumberPeople = numberExistingPeople;
     std::size_t resourceLimit = ourUsage + resourceMonitor.allocationLimit();
     std::size_t numberNewPeople = gatherer.numberPeople();
     numberNewPeople = numberNewPeople > numberExistingPeople ? numberNewPeople - numberExistingPeople
@@ -464,7 +468,11 @@ void CIndividualModel::createUpdateNewModels(core_t::TTime time,
                 numberExistingPeople, 0, numberCorrelations);
         }
     }
-    this->estimateMemoryUsageOrComputeAndUpdate(numberExistingPeople, 0, numberCorrelations);
+    ourUsage = this->estimateMemoryUsageOrComputeAndUpdate(numberExistingPeople, 0,
+                                                           numberCorrelations);
+    if (numberExistingPeople > initialNumberPeople) {
+        this->recordMemoryUsageChange(initialUsage, ourUsage);
+    }
 
     if (numberNewPeople > 0) {
         resourceMonitor.acceptAllocationFailureResult(time);
@@ -500,6 +508,20 @@ void CIndividualModel::createNewModels(std::size_t n, std::size_t m) {
     this->CAnomalyDetectorModel::createNewModels(n, m);
 }
 
+void CIndividualModel::initializeMarginalMemoryCosts() {
+    // Each person has a model per feature, first and last bucket times and
+    // a bucket count. The cost of correlations depends on the data so is
+    // left to the regression.
+    std::size_t personCost{2 * sizeof(core_t::TTime) + sizeof(double)};
+    for (const auto& feature : m_FeatureModels) {
+        personCost += feature.newModelMemoryUsage();
+    }
+    CMemoryUsageEstimator::TOptionalSizeArray costs;
+    costs[CMemoryUsageEstimator::E_People] = personCost;
+    costs[CMemoryUsageEstimator::E_Attributes] = 0;
+    m_MemoryEstimator.marginalCosts(costs);
+}
+
 void CIndividualModel::updateRecycledModels() {
     for (auto pid : this->dataGatherer().recycledPersonIds()) {
         if (pid < m_FirstBucketTimes.size()) {
@@ -560,7 +582,13 @@ double CIndividualModel::emptyBucketWeight(model_t::EFeature feature,
 
 const maths::common::CModel* CIndividualModel::model(model_t::EFeature feature,
                                                      std::size_t pid) const {
-    return const_cast<CIndividualModel*>(this)->model(feature, pid);
+    auto i = std::find_if(m_FeatureModels.begin(), m_FeatureModels.end(),
+                          [feature](const SFeatureModels& model) {
+                              return model.s_Feature == feature;
+                          });
+    return i != m_FeatureModels.end() && pid < i->s_Models.size()
+               ? i->s_Models[pid].get()
+               : nullptr;
 }
 
 maths::common::CModel* CIndividualModel::model(model_t::EFeature feature, std::size_t pid) {
@@ -569,7 +597,7 @@ maths::common::CModel* CIndividualModel::model(model_t::EFeature feature, std::s
                               return model.s_Feature == feature;
                           });
     return i != m_FeatureModels.end() && pid < i->s_Models.size()
-               ? i->s_Models[pid].get()
+               ? i->mutableModel(pid)
                : nullptr;
 }
 
@@ -603,6 +631,15 @@ void CIndividualModel::correctBaselineForInterim(model_t::EFeature feature,
     }
 }
 
+core_t::TTime CIndividualModel::lastBucketTime(std::size_t pid,
+                                               const TSizeTimePrVec& lastBucketTimes) {
+    auto i = std::lower_bound(lastBucketTimes.begin(), lastBucketTimes.end(), pid,
+                              [](const TSizeTimePr& lhs, std::size_t rhs) {
+                                  return lhs.first < rhs;
+                              });
+    return i != lastBucketTimes.end() && i->first == pid ? i->second : 0;
+}
+
 double CIndividualModel::derate(std::size_t pid, core_t::TTime time) const {
     return std::max(1.0 - static_cast<double>(time - m_FirstBucketTimes[pid]) /
                               static_cast<double>(3 * core::constants::WEEK),
@@ -624,6 +661,11 @@ std::size_t CIndividualModel::numberCorrelations() const {
     return result;
 }
 
+bool CIndividualModel::canReuseInterimResults() const {
+    // A person's probability depends on their correlates' values otherwise.
+    return this->numberCorrelations() == 0;
+}
+
 double CIndividualModel::attributeFrequency(std::size_t /*cid*/) const {
     return 1.0;
 }
@@ -636,10 +678,11 @@ void CIndividualModel::doSkipSampling(core_t::TTime startTime, core_t::TTime end
             time = time + gap;
         }
     }
+    m_LastBucketTimeIndex.invalidate();
 
     for (auto& feature : m_FeatureModels) {
-        for (auto& model : feature.s_Models) {
-            model->skipTime(gap);
+        for (std::size_t id = 0; id < feature.s_Models.size(); ++id) {
+            feature.mutableModel(id)->skipTime(gap);
         }
     }
 }
@@ -0,0 +1,67 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#include <model/CInterimResultsCache.h>
+
+#include <core/CMemoryDef.h>
+
+namespace ml {
+namespace model {
+
+void CInterimResultsCache::bucket(core_t::TTime time, double completeness) {
+    if (time != m_Time || completeness != m_Completeness) {
+        m_Time = time;
+        m_Completeness = completeness;
+        m_Results.clear();
+    }
+}
+
+bool CInterimResultsCache::find(std::size_t pid, bool& computed, SAnnotatedProbability& result) const {
+    auto i = m_Results.find(pid);
+    if (i == m_Results.end()) {
+        return false;
+    }
+    computed = i->second.s_Computed;
+    if (computed) {
+        result = i->second.s_Probability;
+    }
+    return true;
+}
+
+void CInterimResultsCache::add(std::size_t pid, bool computed, const SAnnotatedProbability& result) {
+    SResult& entry{m_Results[pid]};
+    entry.s_Computed = computed;
+    entry.s_Probability = computed ? result : SAnnotatedProbability{};
+}
+
+void CInterimResultsCache::clear() {
+    m_Results.clear();
+}
+
+std::size_t CInterimResultsCache::size() const {
+    return m_Results.size();
+}
+
+void CInterimResultsCache::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const {
+    mem->setName("CInterimResultsCache");
+    mem->addItem("m_Results", this->memoryUsage());
+}
+
+std::size_t CInterimResultsCache::memoryUsage() const {
+    return core::memory::dynamicSize(m_Results);
+}
+
+std::size_t CInterimResultsCache::SResult::memoryUsage() const {
+    return core::memory::dynamicSize(s_Probability.s_AttributeProbabilities) +
+           core::memory::dynamicSize(s_Probability.s_Influences);
+}
+}
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#include <model/CLastBucketTimeIndex.h>
+
+#include <core/CMemoryDef.h>
+
+#include <model/CAnomalyDetectorModel.h>
+
+namespace ml {
+namespace model {
+
+const std::size_t CLastBucketTimeIndex::MINIMUM_SIZE_TO_PURGE{64};
+
+void CLastBucketTimeIndex::add(std::size_t id, core_t::TTime time) {
+    if (m_Valid == false) {
+        return;
+    }
+    if (m_Front < m_Entries.size() && time < m_Entries.back().first) {
+        this->invalidate();
+        return;
+    }
+    m_IdBound = std::max(m_IdBound, id + 1);
+    if (this->size() > std::max(2 * m_IdBound, MINIMUM_SIZE_TO_PURGE)) {
+        // Most entries are out-of-date so it's cheaper to rebuild.
+        this->invalidate();
+        return;
+    }
+    m_Entries.emplace_back(time, id);
+}
+
+void CLastBucketTimeIndex::invalidate() {
+    m_Entries.clear();
+    m_Front = 0;
+    m_IdBound = 0;
+    m_Valid = false;
+}
+
+std::size_t CLastBucketTimeIndex::size() const {
+    return m_Entries.size() - m_Front;
+}
+
+void CLastBucketTimeIndex::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const {
+    mem->setName("CLastBucketTimeIndex");
+    core::memory_debug::dynamicSize("m_Entries", m_Entries, mem);
+}
+
+std::size_t CLastBucketTimeIndex::memoryUsage() const {
+    return core::memory::dynamicSize(m_Entries);
+}
+
+void CLastBucketTimeIndex::rebuild(const TTimeVec& lastBucketTimes) {
+    m_Entries.clear();
+    m_Front = 0;
+    for (std::size_t id = 0; id < lastBucketTimes.size(); ++id) {
+        if (CAnomalyDetectorModel::isTimeUnset(lastBucketTimes[id]) == false) {
+            m_Entries.emplace_back(lastBucketTimes[id], id);
+        }
+    }
+    std::sort(m_Entries.begin(), m_Entries.end());
+    m_IdBound = lastBucketTimes.size();
+    m_Valid = true;
+}
+
+void CLastBucketTimeIndex::purgeFront() {
+    if (m_Front > MINIMUM_SIZE_TO_PURGE && 2 * m_Front > m_Entries.size()) {
+        m_Entries.erase(m_Entries.begin(), m_Entries.begin() + m_Front);
+        m_Front = 0;
+    }
+}
+}
+}
@@ -40,12 +40,17 @@ CMemoryUsageEstimator::TOptionalSize
 CMemoryUsageEstimator::estimate(const TSizeArray& predictors) {
     using TDoubleArray = std::array<double, E_NumberPredictors>;
 
-    if (m_Values.size() < E_NumberPredictors) {
+    if (m_NumEstimatesSinceValue >= MAXIMUM_ESTIMATES_BEFORE_NEW_VALUE) {
         return TOptionalSize();
     }
 
-    if (m_NumEstimatesSinceValue >= MAXIMUM_ESTIMATES_BEFORE_NEW_VALUE) {
-        return TOptionalSize();
+    if (m_Values.size() < E_NumberPredictors) {
+        TOptionalSize mem{this->estimateFromMarginalCosts(predictors)};
+        if (mem) {
+            ++m_NumEstimatesSinceValue;
+            ++core::CProgramCounters::counter(counter_t::E_TSADNumberMemoryUsageEstimates);
+        }
+        return mem;
     }
 
     std::size_t last = m_Values.size() - 1;
@@ -122,6 +127,10 @@ void CMemoryUsageEstimator::addValue(const TSizeArray& predictors, std::size_t m
     ++core::CProgramCounters::counter(counter_t::E_TSADNumberMemoryUsageChecks);
 }
 
+void CMemoryUsageEstimator::marginalCosts(const TOptionalSizeArray& costs) {
+    m_MarginalCosts = costs;
+}
+
 void CMemoryUsageEstimator::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const {
     mem->setName("CMemoryUsageEstimator");
     core::memory_debug::dynamicSize("m_Values", m_Values, mem);
@@ -159,5 +168,26 @@ std::size_t CMemoryUsageEstimator::maximumExtrapolation(EComponent component) co
     return 2 * (max - min);
 }
 
+CMemoryUsageEstimator::TOptionalSize
+CMemoryUsageEstimator::estimateFromMarginalCosts(const TSizeArray& predictors) const {
+    if (m_Values.empty()) {
+        return TOptionalSize();
+    }
+
+    const TSizeArraySizePr& last = m_Values.back();
+    double predicted{static_cast<double>(last.second)};
+    for (std::size_t i = 0; i < predictors.size(); ++i) {
+        if (predictors[i] == last.first[i]) {
+            continue;
+        }
+        if (m_MarginalCosts[i] == std::nullopt) {
+            return TOptionalSize();
+        }
+        predicted += static_cast<double>(*m_MarginalCosts[i]) *
+                     (static_cast<double>(predictors[i]) - static_cast<double>(last.first[i]));
+    }
+    return TOptionalSize(static_cast<std::size_t>(std::max(predicted, 0.0) + 0.5));
+}
+
 } // model
 } // ml
@@ -81,7 +81,7 @@ using TSizeFeatureDataPr = std::pair<std::size_t, SMetricFeatureData>;
 using TSizeFeatureDataPrVec = std::vector<TSizeFeatureDataPr>;
 using TSizeSizePrFeatureDataPr = std::pair<TSizeSizePr, SMetricFeatureData>;
 using TSizeSizePrFeatureDataPrVec = std::vector<TSizeSizePrFeatureDataPr>;
-using TSizeSizePrUInt64UMap = CMetricBucketGatherer::TSizeSizePrUInt64UMap;
+using TSizeSizePrUInt64FlatMap = CMetricBucketGatherer::TSizeSizePrUInt64FlatMap;
 using TCategorySizePr = CMetricBucketGatherer::TCategorySizePr;
 using TCategorySizePrAnyMap = CMetricBucketGatherer::TCategorySizePrAnyMap;
 using TCategorySizePrAnyMapItr = CMetricBucketGatherer::TCategorySizePrAnyMapItr;
@@ -753,6 +753,7 @@ private:
                      bool isSum,
                      U& result) const {
         result.clear();
+        bool sorted{false};
         if (isSum) {
             if (data.empty() == false) {
                 auto& pidMap = data.begin()->second;
@@ -768,7 +769,8 @@ private:
                 }
             }
         } else {
-            const TSizeSizePrUInt64UMap& counts = gatherer.bucketCounts(time);
+            const TSizeSizePrUInt64FlatMap& counts = gatherer.bucketCounts(time);
+            sorted = counts.isSorted();
             result.reserve(counts.size());
             for (const auto& count : counts) {
                 std::size_t cid = CDataGatherer::extractAttributeId(count);
@@ -790,7 +792,9 @@ private:
                                   bucketLength, result);
             }
         }
-        std::sort(result.begin(), result.end(), maths::common::COrderings::SFirstLess());
+        if (sorted == false) {
+            std::sort(result.begin(), result.end(), maths::common::COrderings::SFirstLess());
+        }
     }
 
     //! Individual model specialization
@@ -1127,6 +1131,7 @@ std::string CMetricBucketGatherer::description() const {
 }
 
 bool CMetricBucketGatherer::processFields(const TStrCPtrVec& fieldValues,
+                                          const TWordVec& fieldWords,
                                           CEventData& result,
                                           CResourceMonitor& resourceMonitor) {
     using TOptionalStr = std::optional<std::string>;
@@ -1136,6 +1141,11 @@ bool CMetricBucketGatherer::processFields(const TStrCPtrVec& fieldValues,
                   << ", for field names: " << m_FieldNames);
         return false;
     }
+    if (fieldWords.size() > 0 && fieldWords.size() != fieldValues.size()) {
+        LOG_ERROR(<< "Unexpected field words: " << fieldWords.size()
+                  << ", for field values: " << fieldValues);
+        return false;
+    }
 
     const std::string* person = (fieldValues[0] == nullptr && m_DataGatherer.useNull())
                                     ? &EMPTY_STRING
@@ -1211,8 +1221,10 @@ bool CMetricBucketGatherer::processFields(const TStrCPtrVec& fieldValues,
     std::size_t pid = CDynamicStringIdRegistry::INVALID_ID;
     if (result.isExplicitNull()) {
         m_DataGatherer.personId(*person, pid);
-    } else {
+    } else if (fieldWords.empty() || fieldValues[0] == nullptr) {
         pid = m_DataGatherer.addPerson(*person, resourceMonitor, addedPerson);
+    } else {
+        pid = m_DataGatherer.addPerson(*person, fieldWords[0], resourceMonitor, addedPerson);
     }
 
     if (pid == CDynamicStringIdRegistry::INVALID_ID) {
@@ -1256,8 +1268,11 @@ bool CMetricBucketGatherer::processFields(const TStrCPtrVec& fieldValues,
         std::size_t cid = CDynamicStringIdRegistry::INVALID_ID;
         if (result.isExplicitNull()) {
             m_DataGatherer.attributeId(*attribute, cid);
-        } else {
+        } else if (fieldWords.empty() || fieldValues[1] == nullptr) {
             cid = m_DataGatherer.addAttribute(*attribute, resourceMonitor, addedAttribute);
+        } else {
+            cid = m_DataGatherer.addAttribute(*attribute, fieldWords[1],
+                                              resourceMonitor, addedAttribute);
         }
         result.addAttribute(cid);
 
@@ -1472,7 +1487,7 @@ void CMetricBucketGatherer::startNewBucket(core_t::TTime time, bool skipUpdates)
         core_t::TTime earliestAvailableBucketStartTime = this->earliestBucketStartTime();
         if (this->dataAvailable(earliestAvailableBucketStartTime)) {
             TSizeUInt64VecUMap counts;
-            const TSizeSizePrUInt64UMap& counts_ =
+            const TSizeSizePrUInt64FlatMap& counts_ =
                 this->bucketCounts(earliestAvailableBucketStartTime);
             for (const auto& count : counts_) {
                 if (m_DataGatherer.isPopulation()) {
@@ -202,28 +202,26 @@ void CMetricModel::sample(core_t::TTime startTime,
         return;
     }
 
+    // Declared outside the loop to minimize the number of times they are created.
+    TSizeTimePrVec preSampleLastBucketTimes;
+    maths::common::CModel::TTimeDouble2VecSizeTrVec values;
+    maths::common::CModelAddSamplesParams::TDouble2VecWeightsAryVec trendWeights;
+    maths::common::CModelAddSamplesParams::TDouble2VecWeightsAryVec priorWeights;
+    CMemoryCircuitBreaker circuitBreaker{resourceMonitor};
+    double maximumUpdatesPerBucket{this->params().s_MaximumUpdatesPerBucket};
+    bool annotationsEnabled{this->params().s_AnnotationsEnabled};
+
     for (core_t::TTime time = startTime; time < endTime; time += bucketLength) {
         LOG_TRACE(<< "Sampling [" << time << "," << time + bucketLength << ")");
 
         gatherer.sampleNow(time);
         gatherer.featureData(time, bucketLength, m_CurrentBucketStats.s_FeatureData);
 
-        const TTimeVec& preSampleLastBucketTimes = this->lastBucketTimes();
-        TSizeTimeUMap lastBucketTimesMap;
-        for (const auto& featureData : m_CurrentBucketStats.s_FeatureData) {
-            for (const auto& data : featureData.second) {
-                std::size_t pid = data.first;
-                lastBucketTimesMap[pid] = preSampleLastBucketTimes[pid];
-            }
-        }
+        this->lastBucketTimesBeforeSampling(m_CurrentBucketStats.s_FeatureData,
+                                            preSampleLastBucketTimes);
 
         this->CIndividualModel::sample(time, time + bucketLength, resourceMonitor);
 
-        // Declared outside the loop to minimize the number of times they are created.
-        maths::common::CModel::TTimeDouble2VecSizeTrVec values;
-        maths::common::CModelAddSamplesParams::TDouble2VecWeightsAryVec trendWeights;
-        maths::common::CModelAddSamplesParams::TDouble2VecWeightsAryVec priorWeights;
-
         for (auto& featureData : m_CurrentBucketStats.s_FeatureData) {
             model_t::EFeature feature = featureData.first;
             TSizeFeatureDataPrVec& data = featureData.second;
@@ -231,6 +229,11 @@ void CMetricModel::sample(core_t::TTime startTime,
             LOG_TRACE(<< model_t::print(feature) << " data = " << data);
             this->applyFilter(model_t::E_XF_By, true, this->personFilter(), data);
 
+            // These are the same for every person so are computed once per feature.
+            core_t::TTime sampleTime = model_t::sampleTime(feature, time, bucketLength);
+            double learnRate{this->learnRate(feature)};
+            bool includeEmptyBuckets{model_t::includeEmptyBuckets(feature)};
+
             for (const auto& data_ : data) {
                 std::size_t pid = data_.first;
                 const CGathererTools::TSampleVec& samples = data_.second.s_Samples;
@@ -253,11 +256,10 @@ void CMetricModel::sample(core_t::TTime startTime,
                 // 1. If you apply it from the start of the modelling it can stop the model learning anything at all.
                 // 2. It can stop the model ever adapting to some change in data characteristics
 
-                core_t::TTime sampleTime = model_t::sampleTime(feature, time, bucketLength);
                 double initialCountWeight{this->initialCountWeight(
                     feature, pid, model_t::INDIVIDUAL_ANALYSIS_ATTRIBUTE_ID, sampleTime)};
                 if (initialCountWeight == 0.0) {
-                    model->skipTime(time - lastBucketTimesMap[pid]);
+                    model->skipTime(time - lastBucketTime(pid, preSampleLastBucketTimes));
                     continue;
                 }
 
@@ -279,10 +281,10 @@ void CMetricModel::sample(core_t::TTime startTime,
 
                 std::size_t n = samples.size();
                 double countWeight =
-                    (this->params().s_MaximumUpdatesPerBucket > 0.0 && n > 0
-                         ? this->params().s_MaximumUpdatesPerBucket / static_cast<double>(n)
+                    (maximumUpdatesPerBucket > 0.0 && n > 0
+                         ? maximumUpdatesPerBucket / static_cast<double>(n)
                          : 1.0) *
-                    this->learnRate(feature) * initialCountWeight;
+                    learnRate * initialCountWeight;
                 double outlierWeightDerate = this->derate(pid, sampleTime);
                 // Note we need to scale the amount of data we'll "age out" of the residual
                 // model in one bucket by the empty bucket weight so the posterior doesn't
@@ -314,33 +316,27 @@ void CMetricModel::sample(core_t::TTime startTime,
                                         trendWeights[i], priorWeights[i]);
                 }
 
-                auto annotationCallback = [&](const std::string& annotation) {
-                    if (this->params().s_AnnotationsEnabled) {
-                        m_CurrentBucketStats.s_Annotations.emplace_back(
-                            time, CAnnotation::E_ModelChange, annotation,
-                            gatherer.searchKey().detectorIndex(),
-                            gatherer.searchKey().partitionFieldName(),
-                            gatherer.partitionFieldValue(),
-                            gatherer.searchKey().overFieldName(), EMPTY_STRING,
-                            gatherer.searchKey().byFieldName(), gatherer.personName(pid));
-                    }
-                };
-
                 maths::common::CModelAddSamplesParams params;
-                auto circuitBreaker = CMemoryCircuitBreaker(resourceMonitor);
                 params.isInteger(data_.second.s_IsInteger)
                     .isNonNegative(data_.second.s_IsNonNegative)
                     .propagationInterval(scaledInterval)
                     .trendWeights(trendWeights)
                     .priorWeights(priorWeights)
-                    .bucketOccupancy(model_t::includeEmptyBuckets(feature)
-                                         ? this->personFrequency(pid)
-                                         : 1.0)
+                    .bucketOccupancy(includeEmptyBuckets ? this->personFrequency(pid) : 1.0)
                     .firstValueTime(pid < this->firstBucketTimes().size()
                                         ? this->firstBucketTimes()[pid]
                                         : std::numeric_limits<core_t::TTime>::min())
                     .annotationCallback([&](const std::string& annotation) {
-                        annotationCallback(annotation);
+                        if (annotationsEnabled) {
+                            m_CurrentBucketStats.s_Annotations.emplace_back(
+                                time, CAnnotation::E_ModelChange, annotation,
+                                gatherer.searchKey().detectorIndex(),
+                                gatherer.searchKey().partitionFieldName(),
+                                gatherer.partitionFieldValue(),
+                                gatherer.searchKey().overFieldName(), EMPTY_STRING,
+                                gatherer.searchKey().byFieldName(),
+                                gatherer.personName(pid));
+                        }
                     })
                     .memoryCircuitBreaker(circuitBreaker);
 
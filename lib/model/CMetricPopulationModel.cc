@@ -39,6 +39,7 @@
 
 #include <boost/unordered_map.hpp>
 
+#include <algorithm>
 #include <map>
 #include <optional>
 
@@ -138,6 +139,8 @@ void CMetricPopulationModel::initialize(const TFeatureMathsModelSPtrPrVec& newFe
                       return lhs.s_Feature < rhs.s_Feature;
                   });
     }
+
+    m_MemoryEstimator.marginalCosts(this->marginalMemoryCosts(m_FeatureModels));
 }
 
 CMetricPopulationModel::CMetricPopulationModel(bool isForPersistence,
@@ -152,11 +155,10 @@ CMetricPopulationModel::CMetricPopulationModel(bool isForPersistence,
 
     m_FeatureModels.reserve(m_FeatureModels.size());
     for (const auto& feature : other.m_FeatureModels) {
-        m_FeatureModels.emplace_back(feature.s_Feature, feature.s_NewModel);
-        m_FeatureModels.back().s_Models.reserve(feature.s_Models.size());
-        for (const auto& model : feature.s_Models) {
-            m_FeatureModels.back().s_Models.emplace_back(model->cloneForPersistence());
-        }
+        bool correlated{std::any_of(
+            other.m_FeatureCorrelatesModels.begin(), other.m_FeatureCorrelatesModels.end(),
+            [&](const auto& correlates) { return correlates.s_Feature == feature.s_Feature; })};
+        m_FeatureModels.push_back(feature.copyForPersistence(correlated));
     }
 
     m_FeatureCorrelatesModels.reserve(other.m_FeatureCorrelatesModels.size());
@@ -927,8 +929,8 @@ const CInterimBucketCorrector& CMetricPopulationModel::interimValueCorrector() c
 void CMetricPopulationModel::doSkipSampling(core_t::TTime startTime, core_t::TTime endTime) {
     core_t::TTime gap = endTime - startTime;
     for (auto& feature : m_FeatureModels) {
-        for (auto& model : feature.s_Models) {
-            model->skipTime(gap);
+        for (std::size_t id = 0; id < feature.s_Models.size(); ++id) {
+            feature.mutableModel(id)->skipTime(gap);
         }
     }
     this->CPopulationModel::doSkipSampling(startTime, endTime);
@@ -936,7 +938,13 @@ void CMetricPopulationModel::doSkipSampling(core_t::TTime startTime, core_t::TTi
 
 const maths::common::CModel*
 CMetricPopulationModel::model(model_t::EFeature feature, std::size_t cid) const {
-    return const_cast<CMetricPopulationModel*>(this)->model(feature, cid);
+    auto i = std::find_if(m_FeatureModels.begin(), m_FeatureModels.end(),
+                          [feature](const SFeatureModels& model) {
+                              return model.s_Feature == feature;
+                          });
+    return i != m_FeatureModels.end() && cid < i->s_Models.size()
+               ? i->s_Models[cid].get()
+               : nullptr;
 }
 
 maths::common::CModel* CMetricPopulationModel::model(model_t::EFeature feature,
@@ -946,7 +954,7 @@ maths::common::CModel* CMetricPopulationModel::model(model_t::EFeature feature,
                               return model.s_Feature == feature;
                           });
     return i != m_FeatureModels.end() && cid < i->s_Models.size()
-               ? i->s_Models[cid].get()
+               ? i->mutableModel(cid)
                : nullptr;
 }
 
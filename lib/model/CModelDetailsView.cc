@@ -51,19 +51,35 @@ void CModelDetailsView::modelPlot(core_t::TTime time,
                                   double boundsPercentile,
                                   const TStrSet& terms,
                                   CModelPlotData& modelPlotData) const {
+    this->modelPlot(time, boundsPercentile, terms, nullptr, modelPlotData);
+}
+
+void CModelDetailsView::modelPlot(core_t::TTime time,
+                                  double boundsPercentile,
+                                  const TStrSet& terms,
+                                  CModelPlotBoundsCache& boundsCache,
+                                  CModelPlotData& modelPlotData) const {
+    this->modelPlot(time, boundsPercentile, terms, &boundsCache, modelPlotData);
+}
+
+void CModelDetailsView::modelPlot(core_t::TTime time,
+                                  double boundsPercentile,
+                                  const TStrSet& terms,
+                                  CModelPlotBoundsCache* boundsCache,
+                                  CModelPlotData& modelPlotData) const {
     for (auto feature : this->features()) {
         if (!model_t::isConstant(feature) && !model_t::isCategorical(feature)) {
             if (terms.empty() || !this->hasByField()) {
                 for (std::size_t byFieldId = 0; byFieldId < this->maxByFieldId(); ++byFieldId) {
-                    this->modelPlotForByFieldId(time, boundsPercentile, feature,
-                                                byFieldId, modelPlotData);
+                    this->modelPlotForByFieldId(time, boundsPercentile, feature, byFieldId,
+                                                boundsCache, modelPlotData);
                 }
             } else {
                 for (const auto& term : terms) {
                     std::size_t byFieldId(0);
                     if (this->byFieldId(term, byFieldId)) {
-                        this->modelPlotForByFieldId(time, boundsPercentile, feature,
-                                                    byFieldId, modelPlotData);
+                        this->modelPlotForByFieldId(time, boundsPercentile, feature, byFieldId,
+                                                    boundsCache, modelPlotData);
                     }
                 }
             }
@@ -76,6 +92,7 @@ void CModelDetailsView::modelPlotForByFieldId(core_t::TTime time,
                                               double boundsPercentile,
                                               model_t::EFeature feature,
                                               std::size_t byFieldId,
+                                              CModelPlotBoundsCache* boundsCache,
                                               CModelPlotData& modelPlotData) const {
     using TDouble1VecDouble1VecPr = std::pair<TDouble1Vec, TDouble1Vec>;
     using TDouble2Vec = core::CSmallVector<double, 2>;
@@ -87,7 +104,16 @@ void CModelDetailsView::modelPlotForByFieldId(core_t::TTime time,
             return;
         }
 
+        const std::string& byFieldValue = this->byFieldValue(byFieldId);
+        CModelPlotData::SByFieldData bounds;
+        if (boundsCache != nullptr &&
+            boundsCache->bounds(feature, byFieldId, byFieldValue, time, bounds)) {
+            modelPlotData.get(feature, byFieldValue) = std::move(bounds);
+            return;
+        }
+
         std::size_t dimension = model_t::dimension(feature);
+        core_t::TTime bucketTime{time};
         time = model_t::sampleTime(feature, time, model->params().bucketLength());
 
         maths_t::TDouble2VecWeightsAry weights{
@@ -112,8 +138,11 @@ void CModelDetailsView::modelPlotForByFieldId(core_t::TTime time,
             TDouble2Vec median = maths::common::CTools::truncate(interval[1], lower, upper);
 
             // TODO This data structure should support multivariate features.
-            modelPlotData.get(feature, this->byFieldValue(byFieldId)) =
-                CModelPlotData::SByFieldData(lower[0], upper[0], median[0]);
+            bounds = CModelPlotData::SByFieldData(lower[0], upper[0], median[0]);
+            if (boundsCache != nullptr) {
+                boundsCache->add(feature, byFieldId, byFieldValue, bucketTime, bounds);
+            }
+            modelPlotData.get(feature, byFieldValue) = std::move(bounds);
         }
     }
 }
@@ -10,6 +10,10 @@
  */
 #include <model/CModelPlotData.h>
 
+#include <core/CMemoryDef.h>
+
+#include <algorithm>
+
 namespace ml {
 namespace model {
 
@@ -88,5 +92,92 @@ CModelPlotData::SByFieldData& CModelPlotData::get(const model_t::EFeature& featu
 std::string CModelPlotData::print() const {
     return "nothing";
 }
+
+CModelPlotBoundsCache::CModelPlotBoundsCache(core_t::TTime bucketLength)
+    : m_BucketLength{bucketLength} {
+}
+
+void CModelPlotBoundsCache::cadence(std::size_t cadence) {
+    cadence = std::max(cadence, std::size_t{1});
+    if (cadence != m_Cadence) {
+        m_Cadence = cadence;
+        m_Bounds.clear();
+    }
+}
+
+std::size_t CModelPlotBoundsCache::cadence() const {
+    return m_Cadence;
+}
+
+bool CModelPlotBoundsCache::bounds(model_t::EFeature feature,
+                                   std::size_t byFieldId,
+                                   const std::string& byFieldValue,
+                                   core_t::TTime time,
+                                   SByFieldData& result) const {
+    if (m_Cadence == 1) {
+        return false;
+    }
+    // Each series is recomputed in every cadence'th bucket offset by its
+    // identifier.
+    std::size_t bucket{static_cast<std::size_t>(time / m_BucketLength)};
+    if ((bucket + byFieldId) % m_Cadence == 0) {
+        return false;
+    }
+    auto entry = m_Bounds.find(TFeatureSizePr{feature, byFieldId});
+    if (entry == m_Bounds.end() || entry->second.s_ByFieldValue != byFieldValue ||
+        time < entry->second.s_Time || this->stale(entry->second.s_Time, time)) {
+        return false;
+    }
+    result = SByFieldData{entry->second.s_LowerBound, entry->second.s_UpperBound,
+                          entry->second.s_Median};
+    return true;
+}
+
+void CModelPlotBoundsCache::add(model_t::EFeature feature,
+                                std::size_t byFieldId,
+                                const std::string& byFieldValue,
+                                core_t::TTime time,
+                                const SByFieldData& bounds) {
+    if (m_Cadence == 1) {
+        return;
+    }
+    m_Bounds[TFeatureSizePr{feature, byFieldId}] =
+        SBounds{byFieldValue, time, bounds.s_LowerBound, bounds.s_UpperBound, bounds.s_Median};
+}
+
+void CModelPlotBoundsCache::prune(core_t::TTime time) {
+    for (auto i = m_Bounds.begin(); i != m_Bounds.end(); /**/) {
+        if (this->stale(i->second.s_Time, time)) {
+            i = m_Bounds.erase(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void CModelPlotBoundsCache::clear() {
+    m_Bounds.clear();
+}
+
+std::size_t CModelPlotBoundsCache::size() const {
+    return m_Bounds.size();
+}
+
+void CModelPlotBoundsCache::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePtr& mem) const {
+    mem->setName("CModelPlotBoundsCache");
+    mem->addItem("m_Bounds", this->memoryUsage());
+}
+
+std::size_t CModelPlotBoundsCache::memoryUsage() const {
+    return core::memory::dynamicSize(m_Bounds);
+}
+
+bool CModelPlotBoundsCache::stale(core_t::TTime computed, core_t::TTime time) const {
+    return time - computed >= static_cast<core_t::TTime>(m_Cadence) * m_BucketLength;
+}
+
+std::size_t CModelPlotBoundsCache::SBounds::memoryUsage() const {
+    return core::memory::dynamicSize(s_ByFieldValue);
+}
 }
 }
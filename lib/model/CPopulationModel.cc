@@ -116,6 +116,8 @@ CPopulationModel::CPopulationModel(bool isForPersistence, const CPopulationModel
       m_PersonLastBucketTimes(other.m_PersonLastBucketTimes),
       m_AttributeFirstBucketTimes(other.m_AttributeFirstBucketTimes),
       m_AttributeLastBucketTimes(other.m_AttributeLastBucketTimes),
+      m_PersonLastBucketTimeIndex(other.m_PersonLastBucketTimeIndex),
+      m_AttributeLastBucketTimeIndex(other.m_AttributeLastBucketTimeIndex),
       m_NewDistinctPersonCounts(BJKST_HASHES, BJKST_MAX_SIZE),
       m_DistinctPersonCounts(other.m_DistinctPersonCounts),
       m_PersonAttributeBucketCounts(other.m_PersonAttributeBucketCounts) {
@@ -166,15 +168,21 @@ void CPopulationModel::sample(core_t::TTime startTime,
     this->CAnomalyDetectorModel::sample(startTime, endTime, resourceMonitor);
 
     const CDataGatherer& gatherer = this->dataGatherer();
-    const CDataGatherer::TSizeSizePrUInt64UMap& counts = gatherer.bucketCounts(startTime);
+    const CDataGatherer::TSizeSizePrUInt64FlatMap& counts = gatherer.bucketCounts(startTime);
     for (const auto& count : counts) {
         std::size_t pid = CDataGatherer::extractPersonId(count);
         std::size_t cid = CDataGatherer::extractAttributeId(count);
-        m_PersonLastBucketTimes[pid] = startTime;
+        if (m_PersonLastBucketTimes[pid] != startTime) {
+            m_PersonLastBucketTimes[pid] = startTime;
+            m_PersonLastBucketTimeIndex.add(pid, startTime);
+        }
         if (CAnomalyDetectorModel::isTimeUnset(m_AttributeFirstBucketTimes[cid])) {
             m_AttributeFirstBucketTimes[cid] = startTime;
         }
-        m_AttributeLastBucketTimes[cid] = startTime;
+        if (m_AttributeLastBucketTimes[cid] != startTime) {
+            m_AttributeLastBucketTimes[cid] = startTime;
+            m_AttributeLastBucketTimeIndex.add(cid, startTime);
+        }
         m_DistinctPersonCounts[cid].add(static_cast<std::int32_t>(pid));
         if (cid < m_PersonAttributeBucketCounts.size()) {
             m_PersonAttributeBucketCounts[cid].add(static_cast<std::int32_t>(pid), 1.0);
@@ -210,6 +218,10 @@ void CPopulationModel::debugMemoryUsage(const core::CMemoryUsage::TMemoryUsagePt
                                     m_AttributeFirstBucketTimes, mem);
     core::memory_debug::dynamicSize("m_AttributeLastBucketTimes",
                                     m_AttributeLastBucketTimes, mem);
+    core::memory_debug::dynamicSize("m_PersonLastBucketTimeIndex",
+                                    m_PersonLastBucketTimeIndex, mem);
+    core::memory_debug::dynamicSize("m_AttributeLastBucketTimeIndex",
+                                    m_AttributeLastBucketTimeIndex, mem);
     core::memory_debug::dynamicSize("m_NewDistinctPersonCounts",
                                     m_NewDistinctPersonCounts, mem);
     core::memory_debug::dynamicSize("m_DistinctPersonCounts", m_DistinctPersonCounts, mem);
@@ -223,6 +235,8 @@ std::size_t CPopulationModel::memoryUsage() const {
     mem += core::memory::dynamicSize(m_PersonLastBucketTimes);
     mem += core::memory::dynamicSize(m_AttributeFirstBucketTimes);
     mem += core::memory::dynamicSize(m_AttributeLastBucketTimes);
+    mem += core::memory::dynamicSize(m_PersonLastBucketTimeIndex);
+    mem += core::memory::dynamicSize(m_AttributeLastBucketTimeIndex);
     mem += core::memory::dynamicSize(m_NewDistinctPersonCounts);
     mem += core::memory::dynamicSize(m_DistinctPersonCounts);
     mem += core::memory::dynamicSize(m_NewPersonBucketCounts);
@@ -328,6 +342,9 @@ bool CPopulationModel::doAcceptRestoreTraverser(core::CStateRestoreTraverser& tr
     VIOLATES_INVARIANT(m_AttributeFirstBucketTimes.size(), !=,
                        m_AttributeLastBucketTimes.size());
 
+    m_PersonLastBucketTimeIndex.invalidate();
+    m_AttributeLastBucketTimeIndex.invalidate();
+
     return true;
 }
 
@@ -344,6 +361,9 @@ void CPopulationModel::createUpdateNewModels(core_t::TTime time,
         std::min(numberExistingAttributes, gatherer.numberActiveAttributes()),
         0); // # correlations
     std::size_t ourUsage = usageEstimate ? *usageEstimate : this->computeMemoryUsage();
+    std::size_t initialUsage = ourUsage;
+    std::size_t initialNumberPeople = numberExistingPeople;
+    std::size_t initialNumberAttributes = numberExistingAttributes;
     std::size_t resourceLimit = ourUsage + resourceMonitor.allocationLimit();
     std::size_t numberNewPeople = gatherer.numberPeople();
     numberNewPeople = numberNewPeople > numberExistingPeople ? numberNewPeople - numberExistingPeople
@@ -388,8 +408,12 @@ void CPopulationModel::createUpdateNewModels(core_t::TTime time,
         }
     }
 
-    this->estimateMemoryUsageOrComputeAndUpdate(numberExistingPeople,
-                                                numberExistingAttributes, 0);
+    ourUsage = this->estimateMemoryUsageOrComputeAndUpdate(numberExistingPeople,
+                                                           numberExistingAttributes, 0);
+    if (numberExistingPeople > initialNumberPeople ||
+        numberExistingAttributes > initialNumberAttributes) {
+        this->recordMemoryUsageChange(initialUsage, ourUsage);
+    }
 
     if (numberNewPeople > 0) {
         resourceMonitor.acceptAllocationFailureResult(time);
@@ -434,6 +458,28 @@ void CPopulationModel::createNewModels(std::size_t n, std::size_t m) {
     this->CAnomalyDetectorModel::createNewModels(n, m);
 }
 
+CMemoryUsageEstimator::TOptionalSizeArray
+CPopulationModel::marginalMemoryCosts(const TFeatureModelsVec& featureModels) const {
+    // Each person has a last bucket time and a bucket count. Each attribute
+    // has a model per feature, first and last bucket times and sketches of
+    // the people who have it. The cost of correlations depends on the data
+    // so is left to the regression.
+    std::size_t attributeCost{2 * sizeof(core_t::TTime) +
+                              sizeof(maths::common::CBjkstUniqueValues) +
+                              core::memory::dynamicSize(m_NewDistinctPersonCounts)};
+    if (m_NewPersonBucketCounts) {
+        attributeCost += sizeof(maths::time_series::CCountMinSketch) +
+                         core::memory::dynamicSize(*m_NewPersonBucketCounts);
+    }
+    for (const auto& feature : featureModels) {
+        attributeCost += feature.newModelMemoryUsage();
+    }
+    CMemoryUsageEstimator::TOptionalSizeArray costs;
+    costs[CMemoryUsageEstimator::E_People] = sizeof(core_t::TTime) + sizeof(double);
+    costs[CMemoryUsageEstimator::E_Attributes] = attributeCost;
+    return costs;
+}
+
 void CPopulationModel::updateRecycledModels() {
     CDataGatherer& gatherer = this->dataGatherer();
     for (auto pid : gatherer.recycledPersonIds()) {
@@ -497,39 +543,26 @@ double CPopulationModel::propagationTime(std::size_t cid, core_t::TTime time) co
 void CPopulationModel::peopleAndAttributesToRemove(core_t::TTime time,
                                                    std::size_t maximumAge,
                                                    TSizeVec& peopleToRemove,
-                                                   TSizeVec& attributesToRemove) const {
+                                                   TSizeVec& attributesToRemove) {
     if (time <= 0) {
         return;
     }
 
     const CDataGatherer& gatherer = this->dataGatherer();
 
-    for (std::size_t pid = 0; pid < m_PersonLastBucketTimes.size(); ++pid) {
-        if ((gatherer.isPersonActive(pid)) &&
-            (!CAnomalyDetectorModel::isTimeUnset(m_PersonLastBucketTimes[pid]))) {
-            std::size_t bucketsSinceLastEvent = static_cast<std::size_t>(
-                (time - m_PersonLastBucketTimes[pid]) / gatherer.bucketLength());
-            if (bucketsSinceLastEvent > maximumAge) {
-                LOG_TRACE(<< gatherer.personName(pid) << ", bucketsSinceLastEvent = " << bucketsSinceLastEvent
-                          << ", maximumAge = " << maximumAge);
-                peopleToRemove.push_back(pid);
-            }
-        }
-    }
-
-    for (std::size_t cid = 0; cid < m_AttributeLastBucketTimes.size(); ++cid) {
-        if ((gatherer.isAttributeActive(cid)) &&
-            (!CAnomalyDetectorModel::isTimeUnset(m_AttributeLastBucketTimes[cid]))) {
-            std::size_t bucketsSinceLastEvent = static_cast<std::size_t>(
-                (time - m_AttributeLastBucketTimes[cid]) / gatherer.bucketLength());
-            if (bucketsSinceLastEvent > maximumAge) {
-                LOG_TRACE(<< gatherer.attributeName(cid)
-                          << ", bucketsSinceLastEvent = " << bucketsSinceLastEvent
-                          << ", maximumAge = " << maximumAge);
-                attributesToRemove.push_back(cid);
-            }
-        }
-    }
+    // Only people and attributes whose last bucket time has expired since
+    // the last prune are visited.
+    m_PersonLastBucketTimeIndex.removeExpired(
+        time, gatherer.bucketLength(), maximumAge, m_PersonLastBucketTimes,
+        [&gatherer](std::size_t pid) { return gatherer.isPersonActive(pid); },
+        peopleToRemove);
+    m_AttributeLastBucketTimeIndex.removeExpired(
+        time, gatherer.bucketLength(), maximumAge, m_AttributeLastBucketTimes,
+        [&gatherer](std::size_t cid) { return gatherer.isAttributeActive(cid); },
+        attributesToRemove);
+    LOG_TRACE(<< "# people to remove = " << peopleToRemove.size()
+              << ", # attributes to remove = " << attributesToRemove.size()
+              << ", maximumAge = " << maximumAge);
 }
 
 void CPopulationModel::removePeople(const TSizeVec& peopleToRemove) {
@@ -561,6 +594,9 @@ void CPopulationModel::doSkipSampling(core_t::TTime startTime, core_t::TTime end
             m_AttributeLastBucketTimes[cid] = m_AttributeLastBucketTimes[cid] + gapDuration;
         }
     }
+
+    m_PersonLastBucketTimeIndex.invalidate();
+    m_AttributeLastBucketTimeIndex.invalidate();
 }
 
 CPopulationModel::CCorrectionKey::CCorrectionKey(model_t::EFeature feature,
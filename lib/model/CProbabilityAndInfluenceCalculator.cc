@@ -51,6 +51,7 @@ using TTail2Vec = core::CSmallVector<maths_t::ETail, 2>;
 using TProbabilityCalculation2Vec = core::CSmallVector<maths_t::EProbabilityCalculation, 2>;
 using TSizeDoublePr = std::pair<std::size_t, double>;
 using TSizeDoublePr1Vec = core::CSmallVector<TSizeDoublePr, 1>;
+using CInfluenceProbabilityCache = CProbabilityAndInfluenceCalculator::CInfluenceProbabilityCache;
 
 //! \brief Orders two value influences by decreasing influence.
 class CDecreasingValueInfluence {
@@ -322,6 +323,33 @@ public:
     }
 };
 
+//! Compute the probability of \p value at \p time used to find influences
+//! looking it up in \p cache if it has already been computed.
+//!
+//! \return False if the probability couldn't be computed in which case
+//! \p result is set to the probability of a default result.
+bool computeInfluenceProbability(model_t::EFeature feature,
+                                 core_t::TTime elapsedTime,
+                                 const maths::common::CModel& model,
+                                 const maths::common::CModelProbabilityParams& params,
+                                 const TTime2Vec1Vec& time,
+                                 const TDouble2Vec1Vec& value,
+                                 CInfluenceProbabilityCache& cache,
+                                 double& result) {
+    if (cache.lookup(params, time, value, result)) {
+        return true;
+    }
+    maths::common::SModelProbabilityResult probability;
+    bool computed{model.probability(params, time, value, probability)};
+    result = maths::common::CTools::truncate(
+        probability.s_Probability, maths::common::CTools::smallestProbability(), 1.0);
+    result = model_t::adjustProbability(feature, elapsedTime, result);
+    if (computed) {
+        cache.add(params, time, value, result);
+    }
+    return computed;
+}
+
 //! Sets all influences to one.
 //!
 //! \param[in] influencerName The name of the influencer field.
@@ -358,6 +386,7 @@ void doComputeIndicatorInfluences(const TOptionalStr& influencerName,
 //! \param[in] cutoff The value at which there is no influence.
 //! \param[in] includeCutoff If true then add in values for influences
 //! less than the cutoff with estimated influence.
+//! \param[in,out] cache The probabilities already computed for \p value.
 //! \param[out] result Filled in with the influences of \p value.
 template<typename COMPUTE_INFLUENCED_VALUE, typename COMPUTE_INFLUENCE>
 void doComputeInfluences(model_t::EFeature feature,
@@ -373,6 +402,7 @@ void doComputeInfluences(model_t::EFeature feature,
                          const TStrCRefDouble1VecDoublePrPrVec& influencerValues,
                          double cutoff,
                          bool includeCutoff,
+                         CInfluenceProbabilityCache& cache,
                          TOptionalStrOptionalStrPrDoublePrVec& result) {
     auto description = [&influencerName](const std::string& v) {
         return std::make_pair(influencerName, v);
@@ -383,19 +413,12 @@ void doComputeInfluences(model_t::EFeature feature,
         return;
     }
 
-    auto probability = [feature, elapsedTime](const maths::common::SModelProbabilityResult& r) {
-        double p{r.s_Probability};
-        p = maths::common::CTools::truncate(
-            p, maths::common::CTools::smallestProbability(), 1.0);
-        return model_t::adjustProbability(feature, elapsedTime, p);
-    };
-
     maths_t::TDouble2VecWeightsAry1Vec weights(computeProbabilityParams.weights());
     computeProbabilityParams.weights(weights).useMultibucketFeatures(false).useAnomalyModel(false);
-    maths::common::SModelProbabilityResult overallResult;
-    model.probability(computeProbabilityParams, time,
-                      model_t::stripExtraStatistics(feature, {value}), overallResult);
-    double overallProbability{probability(overallResult)};
+    double overallProbability;
+    computeInfluenceProbability(feature, elapsedTime, model, computeProbabilityParams,
+                                time, model_t::stripExtraStatistics(feature, {value}),
+                                cache, overallProbability);
 
     if (overallProbability == 1.0) {
         doComputeIndicatorInfluences(influencerName, influencerValues, result);
@@ -409,7 +432,7 @@ void doComputeInfluences(model_t::EFeature feature,
     // Declared outside the loop to minimize the number of times they are created.
     std::size_t dimension = model_t::dimension(feature);
     TDouble2Vec1Vec influencedValue{TDouble2Vec(dimension)};
-    maths::common::SModelProbabilityResult influenceResult;
+    double influenceProbability;
 
     for (auto i = influencerValues.begin(); i != influencerValues.end(); ++i) {
         const auto& influenceValue = i->second.first;
@@ -425,14 +448,14 @@ void doComputeInfluences(model_t::EFeature feature,
             continue;
         }
 
-        if (model.probability(computeProbabilityParams, time, influencedValue,
-                              influenceResult) == false) {
+        if (computeInfluenceProbability(feature, elapsedTime, model,
+                                        computeProbabilityParams, time, influencedValue,
+                                        cache, influenceProbability) == false) {
             LOG_ERROR(<< "Failed to compute P(" << influencedValue[0]
                       << " | influencer = " << *i << ")");
             continue;
         }
 
-        double influenceProbability{probability(influenceResult)};
         double logInfluenceProbability{maths::common::CTools::fastLog(influenceProbability)};
         double influence{computeInfluence(logOverallProbability, logInfluenceProbability)};
 
@@ -477,16 +500,11 @@ void doComputeCorrelateInfluences(model_t::EFeature feature,
                                   const TStrCRefDouble1VecDouble1VecPrPrVec& influencerValues,
                                   double cutoff,
                                   bool includeCutoff,
+                                  CInfluenceProbabilityCache& cache,
                                   TOptionalStrOptionalStrPrDoublePrVec& result) {
     auto description = [&influencerName](const std::string& v) {
         return std::make_pair(influencerName, v);
     };
-    auto probability = [feature, elapsedTime](const maths::common::SModelProbabilityResult& r) {
-        double p{r.s_Probability};
-        p = maths::common::CTools::truncate(
-            p, maths::common::CTools::smallestProbability(), 1.0);
-        return model_t::adjustProbability(feature, elapsedTime, p);
-    };
 
     if (influencerValues.size() == 1) {
         result.emplace_back(description(influencerValues[0].first), 1.0);
@@ -495,10 +513,10 @@ void doComputeCorrelateInfluences(model_t::EFeature feature,
 
     maths_t::TDouble2VecWeightsAry1Vec weights(computeProbabilityParams.weights());
     computeProbabilityParams.weights(weights).useMultibucketFeatures(false).useAnomalyModel(false);
-    maths::common::SModelProbabilityResult overallResult;
-    model.probability(computeProbabilityParams, {time},
-                      model_t::stripExtraStatistics(feature, {value}), overallResult);
-    double overallProbability{probability(overallResult)};
+    double overallProbability;
+    computeInfluenceProbability(feature, elapsedTime, model, computeProbabilityParams,
+                                {time}, model_t::stripExtraStatistics(feature, {value}),
+                                cache, overallProbability);
 
     if (overallProbability == 1.0) {
         doComputeIndicatorInfluences(influencerName, influencerValues, result);
@@ -511,7 +529,7 @@ void doComputeCorrelateInfluences(model_t::EFeature feature,
 
     // Declared outside the loop to minimize the number of times they are created.
     TDouble2Vec1Vec influencedValue{TDouble2Vec(2)};
-    maths::common::SModelProbabilityResult influenceResult;
+    double influenceProbability;
 
     for (const auto& i : influencerValues) {
         const auto& influenceValue = i.second.first;
@@ -520,14 +538,14 @@ void doComputeCorrelateInfluences(model_t::EFeature feature,
         computeInfluencedValue(value, count, influenceValue, influenceCount,
                                computeProbabilityParams, influencedValue[0]);
 
-        if (model.probability(computeProbabilityParams, {time}, influencedValue,
-                              influenceResult) == false) {
+        if (computeInfluenceProbability(feature, elapsedTime, model,
+                                        computeProbabilityParams, {time}, influencedValue,
+                                        cache, influenceProbability) == false) {
             LOG_ERROR(<< "Failed to compute P(" << influencedValue
                       << " | influencer = " << i << ")");
             continue;
         }
 
-        double influenceProbability{probability(influenceResult)};
         double logInfluenceProbability{maths::common::CTools::fastLog(influenceProbability)};
         double influence{computeInfluence(logOverallProbability, logInfluenceProbability)};
 
@@ -939,6 +957,81 @@ void CProbabilityAndInfluenceCalculator::commitInfluences(model_t::EFeature feat
     }
 }
 
+bool CProbabilityAndInfluenceCalculator::CInfluenceProbabilityCache::lookup(
+    const maths::common::CModelProbabilityParams& params,
+    const TTime2Vec1Vec& time,
+    const TDouble2Vec1Vec& value,
+    double& probability) {
+    this->key(params, time, value);
+    auto i = m_Probabilities.find(m_Key);
+    if (i == m_Probabilities.end()) {
+        return false;
+    }
+    probability = i->second;
+    return true;
+}
+
+void CProbabilityAndInfluenceCalculator::CInfluenceProbabilityCache::add(
+    const maths::common::CModelProbabilityParams& params,
+    const TTime2Vec1Vec& time,
+    const TDouble2Vec1Vec& value,
+    double probability) {
+    this->key(params, time, value);
+    m_Probabilities.emplace(m_Key, probability);
+}
+
+std::size_t CProbabilityAndInfluenceCalculator::CInfluenceProbabilityCache::size() const {
+    return m_Probabilities.size();
+}
+
+void CProbabilityAndInfluenceCalculator::CInfluenceProbabilityCache::clear() {
+    m_Probabilities.clear();
+}
+
+void CProbabilityAndInfluenceCalculator::CInfluenceProbabilityCache::key(
+    const maths::common::CModelProbabilityParams& params,
+    const TTime2Vec1Vec& time,
+    const TDouble2Vec1Vec& value) {
+    // Each variable length collection is preceded by its size so distinct
+    // parameters can't flatten to the same key.
+    m_Key.clear();
+    m_Key.push_back(static_cast<double>(params.calculations()));
+    for (std::size_t i = 0; i < params.calculations(); ++i) {
+        m_Key.push_back(static_cast<double>(params.calculation(i)));
+    }
+    m_Key.push_back(static_cast<double>(params.coordinates().size()));
+    for (auto coordinate : params.coordinates()) {
+        m_Key.push_back(static_cast<double>(coordinate));
+    }
+    auto mostAnomalousCorrelate = params.mostAnomalousCorrelate();
+    m_Key.push_back(mostAnomalousCorrelate != std::nullopt
+                        ? static_cast<double>(*mostAnomalousCorrelate)
+                        : -1.0);
+    m_Key.push_back(params.seasonalConfidenceInterval());
+    m_Key.push_back(params.useMultibucketFeatures() ? 1.0 : 0.0);
+    m_Key.push_back(params.useAnomalyModel() ? 1.0 : 0.0);
+    m_Key.push_back(params.initialCountWeight());
+    m_Key.push_back(static_cast<double>(params.weights().size()));
+    for (const auto& weights : params.weights()) {
+        for (const auto& weight : weights) {
+            m_Key.push_back(static_cast<double>(weight.size()));
+            m_Key.insert(m_Key.end(), weight.begin(), weight.end());
+        }
+    }
+    m_Key.push_back(static_cast<double>(time.size()));
+    for (const auto& time_ : time) {
+        m_Key.push_back(static_cast<double>(time_.size()));
+        for (auto t : time_) {
+            m_Key.push_back(static_cast<double>(t));
+        }
+    }
+    m_Key.push_back(static_cast<double>(value.size()));
+    for (const auto& value_ : value) {
+        m_Key.push_back(static_cast<double>(value_.size()));
+        m_Key.insert(m_Key.end(), value_.begin(), value_.end());
+    }
+}
+
 CProbabilityAndInfluenceCalculator::SParams::SParams(const CPartitioningFields& partitioningFields)
     : s_Feature(), s_Model(nullptr), s_ElapsedTime(0), s_Count(0.0),
       s_Probability(1.0), s_PartitioningFields(partitioningFields),
@@ -1030,7 +1123,8 @@ void CLogProbabilityComplementInfluenceCalculator::computeInfluences(TParams& pa
                             *params.s_Model, params.s_ElapsedTime, computeProbabilityParams,
                             params.s_Time, params.s_Value[0], params.s_Count,
                             params.s_InfluencerName, params.s_InfluencerValues,
-                            params.s_Cutoff, params.s_IncludeCutoff, params.s_Influences);
+                            params.s_Cutoff, params.s_IncludeCutoff,
+                            params.s_InfluenceProbabilities, params.s_Influences);
     }
 }
 
@@ -1051,7 +1145,8 @@ void CLogProbabilityComplementInfluenceCalculator::computeInfluences(TCorrelateP
             *params.s_Model, params.s_ElapsedTime, computeProbabilityParams,
             params.s_Times[correlate], params.s_Values[correlate],
             params.s_Counts[correlate], params.s_InfluencerName, params.s_InfluencerValues,
-            params.s_Cutoff, params.s_IncludeCutoff, params.s_Influences);
+            params.s_Cutoff, params.s_IncludeCutoff,
+            params.s_InfluenceProbabilities, params.s_Influences);
     }
 }
 
@@ -1105,7 +1200,8 @@ void CLogProbabilityInfluenceCalculator::computeInfluences(TParams& params) cons
                             params.s_ElapsedTime, computeProbabilityParams,
                             params.s_Time, params.s_Value[0], params.s_Count,
                             params.s_InfluencerName, params.s_InfluencerValues,
-                            params.s_Cutoff, params.s_IncludeCutoff, params.s_Influences);
+                            params.s_Cutoff, params.s_IncludeCutoff,
+                            params.s_InfluenceProbabilities, params.s_Influences);
     }
 }
 
@@ -1128,7 +1224,8 @@ void CLogProbabilityInfluenceCalculator::computeInfluences(TCorrelateParams& par
             *params.s_Model, params.s_ElapsedTime, computeProbabilityParams,
             params.s_Times[correlate], params.s_Values[correlate],
             params.s_Counts[correlate], params.s_InfluencerName, params.s_InfluencerValues,
-            params.s_Cutoff, params.s_IncludeCutoff, params.s_Influences);
+            params.s_Cutoff, params.s_IncludeCutoff,
+            params.s_InfluenceProbabilities, params.s_Influences);
     }
 }
 
@@ -1159,7 +1256,8 @@ void CMeanInfluenceCalculator::computeInfluences(TParams& params) const {
                             *params.s_Model, params.s_ElapsedTime, computeProbabilityParams,
                             params.s_Time, params.s_Value[0], params.s_Count,
                             params.s_InfluencerName, params.s_InfluencerValues,
-                            params.s_Cutoff, params.s_IncludeCutoff, params.s_Influences);
+                            params.s_Cutoff, params.s_IncludeCutoff,
+                            params.s_InfluenceProbabilities, params.s_Influences);
     }
 }
 
@@ -1182,7 +1280,8 @@ void CMeanInfluenceCalculator::computeInfluences(TCorrelateParams& params) const
             *params.s_Model, params.s_ElapsedTime, computeProbabilityParams,
             params.s_Times[correlate], params.s_Values[correlate],
             params.s_Counts[correlate], params.s_InfluencerName, params.s_InfluencerValues,
-            params.s_Cutoff, params.s_IncludeCutoff, params.s_Influences);
+            params.s_Cutoff, params.s_IncludeCutoff,
+            params.s_InfluenceProbabilities, params.s_Influences);
     }
 }
 
@@ -1214,7 +1313,8 @@ void CVarianceInfluenceCalculator::computeInfluences(TParams& params) const {
                             *params.s_Model, params.s_ElapsedTime, computeProbabilityParams,
                             params.s_Time, params.s_Value[0], params.s_Count,
                             params.s_InfluencerName, params.s_InfluencerValues,
-                            params.s_Cutoff, params.s_IncludeCutoff, params.s_Influences);
+                            params.s_Cutoff, params.s_IncludeCutoff,
+                            params.s_InfluenceProbabilities, params.s_Influences);
     }
 }
 
@@ -1237,7 +1337,8 @@ void CVarianceInfluenceCalculator::computeInfluences(TCorrelateParams& params) c
             *params.s_Model, params.s_ElapsedTime, computeProbabilityParams,
             params.s_Times[correlate], params.s_Values[correlate],
             params.s_Counts[correlate], params.s_InfluencerName, params.s_InfluencerValues,
-            params.s_Cutoff, params.s_IncludeCutoff, params.s_Influences);
+            params.s_Cutoff, params.s_IncludeCutoff,
+            params.s_InfluenceProbabilities, params.s_Influences);
     }
 }
 }
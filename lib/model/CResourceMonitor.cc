@@ -38,6 +38,7 @@ const core_t::TTime CResourceMonitor::MINIMUM_PRUNE_FREQUENCY{60 * 60};
 const std::size_t CResourceMonitor::DEFAULT_MEMORY_LIMIT_MB{4096};
 const double CResourceMonitor::DEFAULT_BYTE_LIMIT_MARGIN{0.7};
 const core_t::TTime CResourceMonitor::MAXIMUM_BYTE_LIMIT_MARGIN_PERIOD{2 * core::constants::HOUR};
+const std::size_t CResourceMonitor::REFRESHES_PER_MEMORY_CALCULATION{10};
 
 CResourceMonitor::CResourceMonitor(bool persistenceInForeground, double byteLimitMargin)
     : m_ByteLimitMargin{byteLimitMargin}, m_PreviousTotal{this->totalMemory()},
@@ -54,7 +55,7 @@ void CResourceMonitor::memoryUsageReporter(const TMemoryUsageReporterFunc& repor
 
 void CResourceMonitor::registerComponent(CMonitoredResource& resource) {
     LOG_TRACE(<< "Registering component: " << &resource);
-    m_Resources.emplace(&resource, 0);
+    m_Resources.emplace(&resource, SResourceUsage{});
 }
 
 void CResourceMonitor::unRegisterComponent(CMonitoredResource& resource) {
@@ -65,7 +66,7 @@ void CResourceMonitor::unRegisterComponent(CMonitoredResource& resource) {
         return;
     }
 
-    m_MonitoredResourceCurrentMemory -= itr->second;
+    m_MonitoredResourceCurrentMemory -= itr->second.s_Usage;
     m_Resources.erase(itr);
     std::size_t total{this->totalMemory()};
     core::CProgramCounters::counter(counter_t::E_TSADMemoryUsage) = total;
@@ -122,6 +123,16 @@ void CResourceMonitor::refresh(CMonitoredResource& resource) {
     if (m_NoLimit) {
         return;
     }
+
+    auto itr = m_Resources.find(&resource);
+    if (itr == m_Resources.end()) {
+        LOG_ERROR(<< "Inconsistency - component has not been registered: " << &resource);
+        return;
+    }
+    if (++itr->second.s_RefreshesSinceCalculated < REFRESHES_PER_MEMORY_CALCULATION) {
+        this->updateAllowAllocations();
+        return;
+    }
     this->forceRefresh(resource);
 }
 
@@ -131,6 +142,24 @@ void CResourceMonitor::forceRefresh(CMonitoredResource& resource) {
     this->updateAllowAllocations();
 }
 
+void CResourceMonitor::addMemoryUsageDelta(CMonitoredResource& resource,
+                                           std::ptrdiff_t delta) {
+    if (delta == 0) {
+        return;
+    }
+    auto itr = m_Resources.find(&resource);
+    if (itr == m_Resources.end()) {
+        LOG_ERROR(<< "Inconsistency - component has not been registered: " << &resource);
+        return;
+    }
+    std::size_t previousUsage{itr->second.s_Usage};
+    itr->second.s_Usage = delta < 0 ? previousUsage - std::min(previousUsage,
+                                                               static_cast<std::size_t>(-delta))
+                                    : previousUsage + static_cast<std::size_t>(delta);
+    m_MonitoredResourceCurrentMemory += itr->second.s_Usage - previousUsage;
+    this->updateAllowAllocations();
+}
+
 void CResourceMonitor::forceRefreshAll() {
     for (auto& resource : m_Resources) {
         this->memUsage(resource.first);
@@ -201,9 +230,10 @@ bool CResourceMonitor::pruneIfRequired(core_t::TTime endTime) {
         for (auto& resource : m_Resources) {
             if (resource.first->supportsPruning()) {
                 resource.first->prune(m_PruneWindow);
-                resource.second = core::memory::dynamicSize(resource.first);
+                resource.second.s_Usage = core::memory::dynamicSize(resource.first);
+                resource.second.s_RefreshesSinceCalculated = 0;
             }
-            usageAfter += resource.second;
+            usageAfter += resource.second.s_Usage;
         }
         m_MonitoredResourceCurrentMemory = usageAfter;
         total = this->totalMemory();
@@ -257,9 +287,10 @@ void CResourceMonitor::memUsage(CMonitoredResource* resource) {
         LOG_ERROR(<< "Inconsistency - component has not been registered: " << resource);
         return;
     }
-    std::size_t modelPreviousUsage = itr->second;
+    std::size_t modelPreviousUsage = itr->second.s_Usage;
     std::size_t modelCurrentUsage = core::memory::dynamicSize(itr->first);
-    itr->second = modelCurrentUsage;
+    itr->second.s_Usage = modelCurrentUsage;
+    itr->second.s_RefreshesSinceCalculated = 0;
     m_MonitoredResourceCurrentMemory += (modelCurrentUsage - modelPreviousUsage);
 }
 
@@ -20,9 +20,48 @@ namespace model {
 
 namespace {
 const CAnomalyDetectorModel::TSizeDoublePr1Vec EMPTY_CORRELATED;
+
+using TDouble1Vec = CRuleCondition::TDouble1Vec;
+
+//! Extract the value to compare from \p value.
+bool univariateValue(const TDouble1Vec& value, double& result) {
+    if (value.empty()) {
+        LOG_ERROR(<< "Value for rule comparison could not be calculated");
+        return false;
+    }
+    if (value.size() > 1) {
+        LOG_ERROR(<< "Numerical rules do not support multivariate analysis");
+        return false;
+    }
+    result = value[0];
+    return true;
+}
 }
 
-using TDouble1Vec = CAnomalyDetectorModel::TDouble1Vec;
+CRuleCondition::CSeriesValues::CSeriesValues(const CAnomalyDetectorModel& model,
+                                             model_t::EFeature feature,
+                                             const model_t::CResultType& resultType,
+                                             std::size_t pid,
+                                             std::size_t cid,
+                                             core_t::TTime time)
+    : m_Model{model}, m_Feature{feature}, m_ResultType{resultType}, m_Pid{pid},
+      m_Cid{cid}, m_Time{time} {
+}
+
+const TDouble1Vec& CRuleCondition::CSeriesValues::actual() {
+    if (m_Actual == std::nullopt) {
+        m_Actual = m_Model.currentBucketValue(m_Feature, m_Pid, m_Cid, m_Time);
+    }
+    return *m_Actual;
+}
+
+const TDouble1Vec& CRuleCondition::CSeriesValues::typical() {
+    if (m_Typical == std::nullopt) {
+        m_Typical = m_Model.baselineBucketMean(m_Feature, m_Pid, m_Cid, m_ResultType,
+                                               EMPTY_CORRELATED, m_Time);
+    }
+    return *m_Typical;
+}
 
 CRuleCondition::CRuleCondition()
     : m_AppliesTo(E_Actual), m_Operator(E_LT), m_Value(0.0) {
@@ -40,61 +79,66 @@ void CRuleCondition::value(double value) {
     m_Value = value;
 }
 
+CRuleCondition::ERuleConditionAppliesTo CRuleCondition::appliesTo() const {
+    return m_AppliesTo;
+}
+
 bool CRuleCondition::test(const CAnomalyDetectorModel& model,
                           model_t::EFeature feature,
                           const model_t::CResultType& resultType,
                           std::size_t pid,
                           std::size_t cid,
                           core_t::TTime time) const {
+    CSeriesValues values{model, feature, resultType, pid, cid, time};
+    return this->test(values);
+}
 
-    TDouble1Vec value;
+bool CRuleCondition::test(CSeriesValues& values) const {
+
+    double value{0.0};
     switch (m_AppliesTo) {
     case E_Actual: {
-        value = model.currentBucketValue(feature, pid, cid, time);
+        if (univariateValue(values.actual(), value) == false) {
+            return false;
+        }
         break;
     }
     case E_Typical: {
-        value = model.baselineBucketMean(feature, pid, cid, resultType,
-                                         EMPTY_CORRELATED, time);
-        if (value.empty()) {
+        const TDouble1Vec& typical = values.typical();
+        if (typical.empty()) {
             // Means prior is non-informative
             return false;
         }
+        if (univariateValue(typical, value) == false) {
+            return false;
+        }
         break;
     }
     case E_DiffFromTypical: {
-        value = model.currentBucketValue(feature, pid, cid, time);
-        TDouble1Vec typical = model.baselineBucketMean(feature, pid, cid, resultType,
-                                                       EMPTY_CORRELATED, time);
+        const TDouble1Vec& typical = values.typical();
         if (typical.empty()) {
             // Means prior is non-informative
             return false;
         }
-        if (value.size() != typical.size()) {
+        const TDouble1Vec& actual = values.actual();
+        if (actual.size() != typical.size()) {
             LOG_ERROR(<< "Cannot apply rule condition: cannot calculate difference between "
                       << "actual and typical values due to different dimensions.");
             return false;
         }
-        for (std::size_t i = 0; i < value.size(); ++i) {
-            value[i] = std::fabs(value[i] - typical[i]);
+        if (univariateValue(actual, value) == false) {
+            return false;
         }
+        value = std::fabs(value - typical[0]);
         break;
     }
     case E_Time: {
-        value.push_back(static_cast<double>(time));
+        value = static_cast<double>(values.time());
         break;
     }
     }
-    if (value.empty()) {
-        LOG_ERROR(<< "Value for rule comparison could not be calculated");
-        return false;
-    }
-    if (value.size() > 1) {
-        LOG_ERROR(<< "Numerical rules do not support multivariate analysis");
-        return false;
-    }
 
-    return this->testValue(value[0]);
+    return this->testValue(value);
 }
 
 bool CRuleCondition::testValue(double value) const {
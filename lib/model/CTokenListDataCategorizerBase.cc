@@ -91,10 +91,15 @@ CTokenListDataCategorizerBase::computeCategory(bool isDryRun,
         maxReweightedWorkWeight, m_LowerThreshold)};
 
     // We search previous categories in descending order of the number of matches
-    // we've seen for them
+    // we've seen for them, skipping those which can't match if possible
+    bool useCandidates{this->findCandidateCategories(workWeight)};
+    std::size_t numberToSearch{useCandidates ? m_WorkCandidateRanks.size()
+                                             : m_CategoriesByCount.size()};
     auto bestSoFarIter = m_CategoriesByCount.end();
     double bestSoFarSimilarity{m_LowerThreshold};
-    for (auto iter = m_CategoriesByCount.begin(); iter != m_CategoriesByCount.end(); ++iter) {
+    for (std::size_t i = 0; i < numberToSearch; ++i) {
+        auto iter = m_CategoriesByCount.begin() +
+                    static_cast<std::ptrdiff_t>(useCandidates ? m_WorkCandidateRanks[i] : i);
         const CTokenListCategory& compCategory{m_Categories[iter->second]};
         const TSizeSizePrVec& baseTokenIds{compCategory.baseTokenIds()};
         std::size_t baseWeight{compCategory.baseWeight()};
@@ -129,7 +134,10 @@ CTokenListDataCategorizerBase::computeCategory(bool isDryRun,
             }
         }
 
-        double similarity{this->similarity(m_WorkTokenIds, workWeight, baseTokenIds, baseWeight)};
+        // Unless this is a reverse search match we only care about the
+        // similarity if it beats the best we've seen so far
+        double similarity{this->similarity(m_WorkTokenIds, workWeight, baseTokenIds, baseWeight,
+                                           matchesSearch ? 0.0 : bestSoFarSimilarity)};
 
         LOG_TRACE(<< similarity << '-' << compCategory.baseString() << '|' << str);
 
@@ -192,6 +200,8 @@ CTokenListDataCategorizerBase::computeCategory(bool isDryRun,
     }
     m_Categories.emplace_back(isDryRun, str, rawStringLen, m_WorkTokenIds,
                               workWeight, m_WorkTokenUniqueIds);
+    m_CategoryRanks.push_back(m_CategoriesByCount.size() - 1);
+    this->indexCategory(m_Categories.size() - 1);
 
     // Increment the counts of categories that use a given token
     for (const auto& workTokenId : m_WorkTokenIds) {
@@ -330,6 +340,11 @@ bool CTokenListDataCategorizerBase::cacheReverseSearch(CLocalCategoryId category
 bool CTokenListDataCategorizerBase::acceptRestoreTraverser(core::CStateRestoreTraverser& traverser) {
     m_Categories.clear();
     m_CategoriesByCount.clear();
+    m_CategoryRanks.clear();
+    m_TokenCategories.clear();
+    m_UnindexedCategories.clear();
+    m_CategoryLastCandidateSearch.clear();
+    m_CandidateSearch = 0;
     m_TotalCount = 0;
     m_NumRareCategories = 0;
     m_TokenIdLookup.clear();
@@ -383,6 +398,9 @@ bool CTokenListDataCategorizerBase::acceptRestoreTraverser(core::CStateRestoreTr
     std::stable_sort(m_CategoriesByCount.begin(), m_CategoriesByCount.end(),
                      maths::common::COrderings::SFirstGreater{});
 
+    // The token index isn't persisted because it's cheap to rebuild
+    this->reindexCategories();
+
     this->updateCategorizerStats(m_LastCategorizerStats);
 
     return true;
@@ -437,7 +455,12 @@ void CTokenListDataCategorizerBase::addCategoryMatch(bool isDryRun,
                                                      const TSizeSizePrVec& tokenIds,
                                                      const TSizeSizeMap& tokenUniqueIds,
                                                      TSizeSizePrVecItr iter) {
-    m_Categories[iter->second].addString(isDryRun, str, rawStringLen, tokenIds, tokenUniqueIds);
+    CTokenListCategory& category{m_Categories[iter->second]};
+    bool wasIndexed{category.commonUniqueTokenWeight() > 0};
+    category.addString(isDryRun, str, rawStringLen, tokenIds, tokenUniqueIds);
+    if (wasIndexed && category.commonUniqueTokenWeight() == 0) {
+        m_UnindexedCategories.push_back(iter->second);
+    }
 
     std::size_t& count{iter->first};
     bool wasCountRare{this->isCategoryCountRare(count)};
@@ -469,6 +492,73 @@ void CTokenListDataCategorizerBase::addCategoryMatch(bool isDryRun,
     // deserves this
     if (swapIter != iter) {
         std::iter_swap(swapIter, iter);
+        m_CategoryRanks[swapIter->second] =
+            static_cast<std::size_t>(swapIter - m_CategoriesByCount.begin());
+        m_CategoryRanks[iter->second] =
+            static_cast<std::size_t>(iter - m_CategoriesByCount.begin());
+    }
+}
+
+bool CTokenListDataCategorizerBase::findCandidateCategories(std::size_t workWeight) {
+    // Strings with zero weight can have similarity one to categories with
+    // which they share no tokens and the pruning is only valid if neither
+    // threshold is negative.
+    if (workWeight == 0 || m_LowerThreshold < 0.0 || m_UpperThreshold < 0.0) {
+        return false;
+    }
+
+    m_CategoryLastCandidateSearch.resize(m_Categories.size(), 0);
+    ++m_CandidateSearch;
+    m_WorkCandidateRanks.clear();
+    auto addCandidate = [this](std::size_t index) {
+        if (m_CategoryLastCandidateSearch[index] != m_CandidateSearch) {
+            m_CategoryLastCandidateSearch[index] = m_CandidateSearch;
+            m_WorkCandidateRanks.push_back(m_CategoryRanks[index]);
+        }
+    };
+
+    for (const auto& tokenId : m_WorkTokenUniqueIds) {
+        if (tokenId.first < m_TokenCategories.size()) {
+            const TSizeVec& categories{m_TokenCategories[tokenId.first]};
+            if (m_WorkCandidateRanks.size() + categories.size() > m_Categories.size() / 2) {
+                // Sorting the candidates would cost more than it saves.
+                return false;
+            }
+            std::for_each(categories.begin(), categories.end(), addCandidate);
+        }
+    }
+    std::for_each(m_UnindexedCategories.begin(), m_UnindexedCategories.end(), addCandidate);
+    std::sort(m_WorkCandidateRanks.begin(), m_WorkCandidateRanks.end());
+
+    return true;
+}
+
+void CTokenListDataCategorizerBase::indexCategory(std::size_t index) {
+    const CTokenListCategory& category{m_Categories[index]};
+    for (const auto& tokenId : category.baseTokenIds()) {
+        if (tokenId.first >= m_TokenCategories.size()) {
+            m_TokenCategories.resize(tokenId.first + 1);
+        }
+        TSizeVec& categories{m_TokenCategories[tokenId.first]};
+        // Base tokens can repeat but a category is only added once per token
+        if (categories.empty() || categories.back() != index) {
+            categories.push_back(index);
+        }
+    }
+    if (category.commonUniqueTokenWeight() == 0) {
+        m_UnindexedCategories.push_back(index);
+    }
+}
+
+void CTokenListDataCategorizerBase::reindexCategories() {
+    m_CategoryRanks.resize(m_Categories.size());
+    for (std::size_t i = 0; i < m_CategoriesByCount.size(); ++i) {
+        m_CategoryRanks[m_CategoriesByCount[i].second] = i;
+    }
+    m_TokenCategories.clear();
+    m_UnindexedCategories.clear();
+    for (std::size_t i = 0; i < m_Categories.size(); ++i) {
+        this->indexCategory(i);
     }
 }
 
@@ -565,6 +655,12 @@ void CTokenListDataCategorizerBase::debugMemoryUsage(const core::CMemoryUsage::T
     core::memory_debug::dynamicSize("m_ReverseSearchCreator", m_ReverseSearchCreator, mem);
     core::memory_debug::dynamicSize("m_Categories", m_Categories, mem);
     core::memory_debug::dynamicSize("m_CategoriesByCount", m_CategoriesByCount, mem);
+    core::memory_debug::dynamicSize("m_CategoryRanks", m_CategoryRanks, mem);
+    core::memory_debug::dynamicSize("m_TokenCategories", m_TokenCategories, mem);
+    core::memory_debug::dynamicSize("m_UnindexedCategories", m_UnindexedCategories, mem);
+    core::memory_debug::dynamicSize("m_CategoryLastCandidateSearch",
+                                    m_CategoryLastCandidateSearch, mem);
+    core::memory_debug::dynamicSize("m_WorkCandidateRanks", m_WorkCandidateRanks, mem);
     core::memory_debug::dynamicSize("m_TokenIdLookup", m_TokenIdLookup, mem);
     core::memory_debug::dynamicSize("m_WorkTokenIds", m_WorkTokenIds, mem);
     core::memory_debug::dynamicSize("m_WorkTokenUniqueIds", m_WorkTokenUniqueIds, mem);
@@ -576,6 +672,11 @@ std::size_t CTokenListDataCategorizerBase::memoryUsage() const {
     mem += core::memory::dynamicSize(m_ReverseSearchCreator);
     mem += core::memory::dynamicSize(m_Categories);
     mem += core::memory::dynamicSize(m_CategoriesByCount);
+    mem += core::memory::dynamicSize(m_CategoryRanks);
+    mem += core::memory::dynamicSize(m_TokenCategories);
+    mem += core::memory::dynamicSize(m_UnindexedCategories);
+    mem += core::memory::dynamicSize(m_CategoryLastCandidateSearch);
+    mem += core::memory::dynamicSize(m_WorkCandidateRanks);
     mem += core::memory::dynamicSize(m_TokenIdLookup);
     mem += core::memory::dynamicSize(m_WorkTokenIds);
     mem += core::memory::dynamicSize(m_WorkTokenUniqueIds);
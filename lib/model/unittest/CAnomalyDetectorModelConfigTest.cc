@@ -303,6 +303,14 @@ BOOST_AUTO_TEST_CASE(testConfigureModelPlot) {
         BOOST_REQUIRE_EQUAL(false, config.modelPlotAnnotationsEnabled());
         BOOST_TEST_REQUIRE(termSet == config.modelPlotTerms());
     }
+    {
+        CAnomalyDetectorModelConfig config = CAnomalyDetectorModelConfig::defaultConfig();
+        BOOST_REQUIRE_EQUAL(1, config.modelPlotBoundsCadence());
+        config.modelPlotBoundsCadence(4);
+        BOOST_REQUIRE_EQUAL(4, config.modelPlotBoundsCadence());
+        config.modelPlotBoundsCadence(0);
+        BOOST_REQUIRE_EQUAL(4, config.modelPlotBoundsCadence());
+    }
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -623,6 +623,81 @@ BOOST_AUTO_TEST_CASE(testNormalizeScoresOrdering) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testNormalizeWithQuantileCache) {
+    // Test that normalizing with a quantile cache gives the same scores
+    // and that clearing the cache picks up changes to the quantiles.
+
+    test::CRandomNumbers rng;
+
+    TOptionalStr personFieldName = "bucket_time";
+    TDoubleVec samples;
+    rng.generateGammaSamples(1.0, 2.0, 2000, samples);
+
+    model::CAnomalyDetectorModelConfig config =
+        model::CAnomalyDetectorModelConfig::defaultConfig(300);
+    model::CAnomalyScore::CNormalizer normalizer(config);
+    normalizer.isForMembersOfPopulation(false);
+    model::CAnomalyScore::CNormalizer::CQuantileCache cache;
+
+    for (std::size_t i = 0; i < 2; ++i) {
+        for (std::size_t j = 0; j < 1000; ++j) {
+            normalizer.updateQuantiles({EMPTY, EMPTY, EMPTY, EMPTY},
+                                       samples[1000 * i + j]);
+        }
+        cache.clear();
+
+        for (std::size_t j = 0; j < samples.size(); ++j) {
+            // Include repeated scores so some are read from the cache.
+            double expected{samples[j % 1500]};
+            double actual{expected};
+            BOOST_TEST_REQUIRE(normalizer.normalize(
+                {EMPTY, EMPTY, personFieldName, EMPTY}, expected));
+            BOOST_TEST_REQUIRE(normalizer.normalize(
+                {EMPTY, EMPTY, personFieldName, EMPTY}, actual, cache));
+            BOOST_REQUIRE_EQUAL(expected, actual);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testNormalizeCacheInvalidation) {
+    // Test that normalizing between updates, which fills the normalizer's
+    // own cache, doesn't change the scores after the quantiles change.
+
+    test::CRandomNumbers rng;
+
+    TDoubleVec samples;
+    rng.generateGammaSamples(1.0, 2.0, 3000, samples);
+
+    model::CAnomalyDetectorModelConfig config =
+        model::CAnomalyDetectorModelConfig::defaultConfig(300);
+    model::CAnomalyScore::CNormalizer cached(config);
+    model::CAnomalyScore::CNormalizer uncached(config);
+    cached.isForMembersOfPopulation(false);
+    uncached.isForMembersOfPopulation(false);
+
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        cached.updateQuantiles({EMPTY, EMPTY, EMPTY, EMPTY}, samples[i]);
+        uncached.updateQuantiles({EMPTY, EMPTY, EMPTY, EMPTY}, samples[i]);
+        if (i % 100 == 99) {
+            cached.propagateForwardByTime(1.0);
+            uncached.propagateForwardByTime(1.0);
+            for (std::size_t j = 0; j < 50; ++j) {
+                double score{samples[j]};
+                BOOST_TEST_REQUIRE(cached.normalize({EMPTY, EMPTY, EMPTY, EMPTY}, score));
+            }
+        }
+    }
+
+    for (std::size_t j = 0; j < samples.size(); ++j) {
+        double expected{samples[j]};
+        model::CAnomalyScore::CNormalizer::CQuantileCache cache;
+        BOOST_TEST_REQUIRE(uncached.normalize({EMPTY, EMPTY, EMPTY, EMPTY}, expected, cache));
+        double actual{samples[j]};
+        BOOST_TEST_REQUIRE(cached.normalize({EMPTY, EMPTY, EMPTY, EMPTY}, actual));
+        BOOST_REQUIRE_EQUAL(expected, actual);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testNormalizerGetMaxScore) {
     test::CRandomNumbers rng;
 
@@ -81,6 +81,39 @@ BOOST_AUTO_TEST_CASE(testGetGivenFullQueueAfterPop) {
     BOOST_REQUIRE_EQUAL(std::string("c"), queue.get(19));
 }
 
+BOOST_AUTO_TEST_CASE(testRecycle) {
+    CBucketQueue<std::vector<int>> queue(2, 5, 0);
+    queue.push({1, 2, 3}, 5);
+    queue.push({4, 5}, 10);
+    queue.push({6}, 15);
+    BOOST_REQUIRE_EQUAL(3, queue.size());
+
+    // The earliest bucket should be reused for the latest bucket.
+    const int* earliest{queue.earliest().data()};
+    auto reset = [](std::vector<int>& values) { values.clear(); };
+    queue.recycle(reset, 20);
+
+    BOOST_REQUIRE_EQUAL(3, queue.size());
+    BOOST_REQUIRE_EQUAL(24, queue.latestBucketEnd());
+    BOOST_TEST_REQUIRE(queue.latest().empty());
+    BOOST_TEST_REQUIRE(queue.latest().capacity() >= 3);
+    BOOST_REQUIRE_EQUAL(earliest, queue.latest().data());
+    BOOST_REQUIRE_EQUAL(std::string("[6]"), core::CContainerPrinter::print(queue.get(15)));
+    BOOST_REQUIRE_EQUAL(std::string("[4, 5]"),
+                        core::CContainerPrinter::print(queue.get(10)));
+
+    // Recycling with an earlier time is ignored.
+    queue.get(20).push_back(7);
+    queue.recycle(reset, 12);
+    BOOST_REQUIRE_EQUAL(24, queue.latestBucketEnd());
+    BOOST_REQUIRE_EQUAL(std::string("[7]"), core::CContainerPrinter::print(queue.get(20)));
+
+    queue.recycle(reset, 25);
+    queue.recycle(reset, 30);
+    BOOST_REQUIRE_EQUAL(std::string("[7]"), core::CContainerPrinter::print(queue.earliest()));
+    BOOST_TEST_REQUIRE(queue.latest().empty());
+}
+
 BOOST_AUTO_TEST_CASE(testClear) {
     CBucketQueue<int> queue(2, 5, 0);
     BOOST_REQUIRE_EQUAL(3, queue.size());
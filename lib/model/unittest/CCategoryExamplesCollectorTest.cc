@@ -40,6 +40,17 @@ BOOST_AUTO_TEST_CASE(testAddGivenSameCategoryExamplePairAddedTwice) {
     BOOST_TEST_REQUIRE(examplesCollector.add(CLocalCategoryId{1}, "foo") == false);
 }
 
+BOOST_AUTO_TEST_CASE(testAddGivenLongExamplesWhichAreTheSameWhenTruncated) {
+    const std::string baseExample(CCategoryExamplesCollector::MAX_EXAMPLE_LENGTH, 'a');
+    CCategoryExamplesCollector examplesCollector(4);
+    BOOST_TEST_REQUIRE(examplesCollector.add(CLocalCategoryId{1}, baseExample + "b") == true);
+    BOOST_TEST_REQUIRE(examplesCollector.add(CLocalCategoryId{1}, baseExample + "c") == false);
+    BOOST_TEST_REQUIRE(examplesCollector.add(CLocalCategoryId{1}, baseExample) == true);
+    BOOST_TEST_REQUIRE(examplesCollector.add(CLocalCategoryId{1}, baseExample) == false);
+    BOOST_TEST_REQUIRE(
+        examplesCollector.numberOfExamplesForCategory(CLocalCategoryId{1}) == 2);
+}
+
 BOOST_AUTO_TEST_CASE(testAddGivenMoreThanMaxExamplesAreAddedForSameCategory) {
     CCategoryExamplesCollector examplesCollector(3);
     BOOST_TEST_REQUIRE(examplesCollector.add(CLocalCategoryId{1}, "foo1") == true);
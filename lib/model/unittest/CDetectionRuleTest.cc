@@ -892,6 +892,78 @@ BOOST_FIXTURE_TEST_CASE(testApplyGivenTimeCondition, CTestFixture) {
                                   resultType, 0, 0, 200) == false);
 }
 
+BOOST_FIXTURE_TEST_CASE(testApplyReadsSeriesValuesOnce, CTestFixture) {
+    core_t::TTime bucketLength = 100;
+    core_t::TTime startTime = 100;
+    CSearchKey key;
+    SModelParams params(bucketLength);
+    CAnomalyDetectorModel::TFeatureInfluenceCalculatorCPtrPrVecVec influenceCalculators;
+
+    TFeatureVec features;
+    features.push_back(model_t::E_IndividualMeanByPerson);
+    std::string personFieldName("series");
+    CAnomalyDetectorModel::TDataGathererPtr gathererPtr(std::make_shared<CDataGatherer>(
+        model_t::E_Metric, model_t::E_None, params, EMPTY_STRING, EMPTY_STRING, personFieldName,
+        EMPTY_STRING, EMPTY_STRING, TStrVec{}, key, features, startTime, 0));
+
+    std::string person1("p1");
+    bool addedPerson = false;
+    gathererPtr->addPerson(person1, m_ResourceMonitor, addedPerson);
+
+    CMockModel model(params, gathererPtr, influenceCalculators);
+    CAnomalyDetectorModel::TDouble1Vec actual(1, 10.0);
+    CAnomalyDetectorModel::TDouble1Vec typical(1, 8.0);
+    model.mockAddBucketValue(model_t::E_IndividualMeanByPerson, 0, 0, 100, actual);
+    model.mockAddBucketBaselineMean(model_t::E_IndividualMeanByPerson, 0, 0, 100, typical);
+
+    CRuleCondition diffCondition;
+    diffCondition.appliesTo(CRuleCondition::E_DiffFromTypical);
+    diffCondition.op(CRuleCondition::E_LT);
+    diffCondition.value(3.0);
+    CRuleCondition typicalCondition;
+    typicalCondition.appliesTo(CRuleCondition::E_Typical);
+    typicalCondition.op(CRuleCondition::E_GT);
+    typicalCondition.value(5.0);
+    CRuleCondition actualCondition;
+    actualCondition.appliesTo(CRuleCondition::E_Actual);
+    actualCondition.op(CRuleCondition::E_LT);
+    actualCondition.value(11.0);
+    CRuleCondition timeCondition;
+    timeCondition.appliesTo(CRuleCondition::E_Time);
+    timeCondition.op(CRuleCondition::E_GTE);
+    timeCondition.value(100);
+
+    CDetectionRule rule;
+    rule.addCondition(diffCondition);
+    rule.addCondition(typicalCondition);
+    rule.addCondition(actualCondition);
+    rule.addCondition(actualCondition);
+    rule.addCondition(timeCondition);
+
+    model_t::CResultType resultType(model_t::CResultType::E_Final);
+
+    // Each value is read once however many conditions use it.
+    BOOST_TEST_REQUIRE(rule.apply(CDetectionRule::E_SkipResult, model,
+                                  model_t::E_IndividualMeanByPerson, resultType, 0, 0, 100));
+    BOOST_REQUIRE_EQUAL(1, model.numberBucketValueReads());
+    BOOST_REQUIRE_EQUAL(1, model.numberBucketBaselineMeanReads());
+
+    // The time condition is tested first so a failing time condition
+    // doesn't read any values.
+    BOOST_TEST_REQUIRE(rule.apply(CDetectionRule::E_SkipResult, model,
+                                  model_t::E_IndividualMeanByPerson, resultType, 0, 0, 99) == false);
+    BOOST_REQUIRE_EQUAL(1, model.numberBucketValueReads());
+    BOOST_REQUIRE_EQUAL(1, model.numberBucketBaselineMeanReads());
+
+    // The conditions print in the order they were added.
+    CDetectionRule printed;
+    printed.addCondition(actualCondition);
+    printed.addCondition(timeCondition);
+    BOOST_REQUIRE_EQUAL("SKIP_RESULT IF " + actualCondition.print() + " AND " +
+                            timeCondition.print(),
+                        printed.print());
+}
+
 BOOST_FIXTURE_TEST_CASE(testRuleActions, CTestFixture) {
     core_t::TTime bucketLength = 100;
     core_t::TTime startTime = 100;
@@ -129,6 +129,44 @@ BOOST_AUTO_TEST_CASE(testAge) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testCorrectionsTrackNewData) {
+    // Test that the corrections are recomputed when the sketches change a
+    // lot even if they are never aged.
+
+    model::CDetectorEqualizer equalizer;
+
+    test::CRandomNumbers rng;
+
+    auto addSamples = [&](int detector, double scale) {
+        TDoubleVec logp;
+        rng.generateGammaSamples(1.0, scale, 1000, logp);
+        for (double logpj : logp) {
+            if (-logpj <= THRESHOLD) {
+                equalizer.add(detector, std::exp(-logpj));
+            }
+        }
+    };
+
+    addSamples(0, 1.0);
+    addSamples(1, 1.0);
+    double before{equalizer.correct(0, 1e-4)};
+
+    for (std::size_t i = 0; i < 10; ++i) {
+        addSamples(1, 5.0);
+    }
+    double after{equalizer.correct(0, 1e-4)};
+    LOG_DEBUG(<< "before = " << before << ", after = " << after);
+
+    // Detector 1 now produces much smaller probabilities so the correction
+    // for detector 0 should make its probabilities smaller.
+    BOOST_TEST_REQUIRE(after < 0.1 * before);
+
+    // Aging forces the corrections to be recomputed but shouldn't change
+    // them since it scales all the counts.
+    equalizer.age(0.9);
+    BOOST_REQUIRE_CLOSE_FRACTION(after, equalizer.correct(0, 1e-4), 1e-3);
+}
+
 BOOST_AUTO_TEST_CASE(testPersist) {
     TDoubleVec scales{1.0, 2.1, 3.2};
 
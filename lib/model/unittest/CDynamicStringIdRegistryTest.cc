@@ -75,6 +75,73 @@ BOOST_AUTO_TEST_CASE(testAddName) {
     BOOST_TEST_REQUIRE(registry.isIdActive(2));
 }
 
+BOOST_AUTO_TEST_CASE(testAddNameWithWord) {
+    // Test that names added and looked up by their precomputed words are
+    // consistent with names added and looked up by value and that lookups
+    // remain correct after many names are recycled and removed.
+
+    CResourceMonitor resourceMonitor;
+    CDynamicStringIdRegistry registry("person", counter_t::E_TSADNumberNewPeople,
+                                      counter_t::E_TSADNumberNewPeopleNotAllowed,
+                                      counter_t::E_TSADNumberNewPeopleRecycled);
+
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        names.push_back("person" + std::to_string(i));
+    }
+
+    bool personAdded = false;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        personAdded = false;
+        std::size_t id = i % 2 == 0
+                             ? registry.addName(names[i], 100, resourceMonitor, personAdded)
+                             : registry.addName(names[i], CDynamicStringIdRegistry::word(names[i]),
+                                                100, resourceMonitor, personAdded);
+        BOOST_REQUIRE_EQUAL(i, id);
+        BOOST_TEST_REQUIRE(personAdded);
+    }
+    BOOST_TEST_REQUIRE(registry.checkInvariants());
+
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        std::size_t id;
+        BOOST_TEST_REQUIRE(registry.id(CDynamicStringIdRegistry::word(names[i]), id));
+        BOOST_REQUIRE_EQUAL(i, id);
+        personAdded = false;
+        BOOST_REQUIRE_EQUAL(i, registry.addName(names[i], CDynamicStringIdRegistry::word(names[i]),
+                                                200, resourceMonitor, personAdded));
+        BOOST_TEST_REQUIRE(personAdded == false);
+    }
+
+    CDynamicStringIdRegistry::TSizeVec toRecycle;
+    for (std::size_t i = 0; i < names.size(); i += 3) {
+        toRecycle.push_back(i);
+    }
+    registry.recycleNames(toRecycle, "-");
+    BOOST_TEST_REQUIRE(registry.checkInvariants());
+
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        std::size_t id;
+        bool found = registry.id(names[i], id);
+        BOOST_REQUIRE_EQUAL(i % 3 != 0, found);
+        if (found) {
+            BOOST_REQUIRE_EQUAL(i, id);
+        }
+    }
+
+    registry.removeNames(500);
+    BOOST_TEST_REQUIRE(registry.checkInvariants());
+    BOOST_REQUIRE_EQUAL(500, registry.numberNames());
+
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        std::size_t id;
+        bool found = registry.id(names[i], id);
+        BOOST_REQUIRE_EQUAL(i < 500 && i % 3 != 0, found);
+        if (found) {
+            BOOST_REQUIRE_EQUAL(i, id);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testPersist) {
     CResourceMonitor resourceMonitor;
     CDynamicStringIdRegistry registry("person", counter_t::E_TSADNumberNewPeople,
@@ -302,6 +302,54 @@ BOOST_FIXTURE_TEST_CASE(testCountSample, CTestFixture) {
     BOOST_REQUIRE_EQUAL(origXml, newXml);
 }
 
+BOOST_FIXTURE_TEST_CASE(testPersistenceCopyIsUnaffectedByUpdates, CTestFixture) {
+
+    // Check that sampling the model after copying it for persistence doesn't
+    // change the copy, whose models are shared until they're modified.
+
+    const core_t::TTime startTime{1346968800};
+    const core_t::TTime bucketLength{3600};
+    SModelParams params(bucketLength);
+    this->makeModel(params, {model_t::E_IndividualCountByBucketAndPerson}, startTime, 2);
+    auto* model = dynamic_cast<CEventRateModel*>(m_Model.get());
+    BOOST_TEST_REQUIRE(model);
+
+    TTimeVec eventTimes;
+    TUInt64Vec eventCounts(rawEventCounts());
+    generateEvents(startTime, bucketLength, eventCounts, eventTimes);
+    core_t::TTime endTime = (eventTimes.back() / bucketLength + 1) * bucketLength;
+    core_t::TTime copyTime{startTime + (endTime - startTime) / bucketLength / 2 * bucketLength};
+
+    auto persist = [](const CAnomalyDetectorModel& model_) {
+        std::string result;
+        core::CRapidXmlStatePersistInserter inserter("root");
+        model_.acceptPersistInserter(inserter);
+        inserter.toXml(result);
+        return result;
+    };
+
+    CModelFactory::TModelPtr copy;
+    std::string copyXml;
+    std::size_t i{0};
+    for (core_t::TTime bucketStartTime = startTime; bucketStartTime < endTime;
+         bucketStartTime += bucketLength) {
+        core_t::TTime bucketEndTime = bucketStartTime + bucketLength;
+        if (bucketStartTime == copyTime) {
+            copy.reset(model->cloneForPersistence());
+            copyXml = persist(*copy);
+            BOOST_REQUIRE_EQUAL(persist(*model), copyXml);
+        }
+        for (/**/; i < eventTimes.size() && eventTimes[i] < bucketEndTime; ++i) {
+            this->addArrival(SMessage(eventTimes[i], "p1", TOptionalDouble()), m_Gatherer);
+        }
+        model->sample(bucketStartTime, bucketEndTime, m_ResourceMonitor);
+    }
+
+    BOOST_TEST_REQUIRE(copy != nullptr);
+    BOOST_TEST_REQUIRE(persist(*model) != copyXml);
+    BOOST_REQUIRE_EQUAL(copyXml, persist(*copy));
+}
+
 BOOST_FIXTURE_TEST_CASE(testNonZeroCountSample, CTestFixture) {
     const core_t::TTime startTime{1346968800};
     const core_t::TTime bucketLength{3600};
@@ -0,0 +1,164 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#include <core/CContainerPrinter.h>
+#include <core/CoreTypes.h>
+
+#include <model/CAnomalyDetectorModel.h>
+#include <model/CLastBucketTimeIndex.h>
+
+#include <test/CRandomNumbers.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(CLastBucketTimeIndexTest)
+
+using namespace ml;
+
+namespace {
+using TSizeVec = std::vector<std::size_t>;
+using TTimeVec = std::vector<core_t::TTime>;
+
+const core_t::TTime BUCKET_LENGTH{600};
+
+auto allActive() {
+    return [](std::size_t) { return true; };
+}
+
+TSizeVec expired(const TTimeVec& lastBucketTimes, core_t::TTime time, std::size_t maximumAge) {
+    TSizeVec result;
+    for (std::size_t id = 0; id < lastBucketTimes.size(); ++id) {
+        if (!model::CAnomalyDetectorModel::isTimeUnset(lastBucketTimes[id]) &&
+            static_cast<std::size_t>((time - lastBucketTimes[id]) / BUCKET_LENGTH) > maximumAge) {
+            result.push_back(id);
+        }
+    }
+    return result;
+}
+}
+
+BOOST_AUTO_TEST_CASE(testRemoveExpired) {
+    // Check that we find exactly the expired identifiers.
+
+    TTimeVec lastBucketTimes(5, model::CAnomalyDetectorModel::TIME_UNSET);
+    model::CLastBucketTimeIndex index;
+
+    auto seen = [&](std::size_t id, core_t::TTime time) {
+        lastBucketTimes[id] = time;
+        index.add(id, time);
+    };
+
+    TSizeVec result;
+    index.removeExpired(0, BUCKET_LENGTH, 2, lastBucketTimes, allActive(), result);
+    BOOST_TEST_REQUIRE(result.empty());
+
+    seen(0, 0);
+    seen(1, 0);
+    seen(2, 2 * BUCKET_LENGTH);
+    seen(3, 2 * BUCKET_LENGTH);
+    seen(1, 3 * BUCKET_LENGTH);
+    seen(4, 3 * BUCKET_LENGTH);
+    BOOST_REQUIRE_EQUAL(6, index.size());
+
+    index.removeExpired(4 * BUCKET_LENGTH, BUCKET_LENGTH, 2, lastBucketTimes,
+                        allActive(), result);
+    BOOST_REQUIRE_EQUAL(
+        core::CContainerPrinter::print(expired(lastBucketTimes, 4 * BUCKET_LENGTH, 2)),
+        core::CContainerPrinter::print(result));
+    BOOST_REQUIRE_EQUAL("[0]", core::CContainerPrinter::print(result));
+
+    // The out-of-date entry for 1 was discarded.
+    BOOST_REQUIRE_EQUAL(4, index.size());
+
+    // Inactive identifiers are dropped.
+    result.clear();
+    index.removeExpired(5 * BUCKET_LENGTH, BUCKET_LENGTH, 2, lastBucketTimes,
+                        [](std::size_t id) { return id != 3; }, result);
+    BOOST_REQUIRE_EQUAL("[2]", core::CContainerPrinter::print(result));
+    BOOST_REQUIRE_EQUAL(2, index.size());
+
+    result.clear();
+    index.removeExpired(7 * BUCKET_LENGTH, BUCKET_LENGTH, 2, lastBucketTimes,
+                        allActive(), result);
+    BOOST_REQUIRE_EQUAL("[1, 4]", core::CContainerPrinter::print(result));
+    BOOST_REQUIRE_EQUAL(0, index.size());
+}
+
+BOOST_AUTO_TEST_CASE(testInvalidate) {
+    // Check the index is rebuilt from the last bucket times when times are
+    // added out of order or it's invalidated.
+
+    TTimeVec lastBucketTimes{0, 5 * BUCKET_LENGTH, model::CAnomalyDetectorModel::TIME_UNSET};
+    model::CLastBucketTimeIndex index;
+
+    TSizeVec result;
+    index.removeExpired(4 * BUCKET_LENGTH, BUCKET_LENGTH, 2, lastBucketTimes,
+                        allActive(), result);
+    BOOST_REQUIRE_EQUAL("[0]", core::CContainerPrinter::print(result));
+    BOOST_REQUIRE_EQUAL(1, index.size());
+
+    lastBucketTimes[2] = 4 * BUCKET_LENGTH;
+    index.add(2, 4 * BUCKET_LENGTH);
+    BOOST_REQUIRE_EQUAL(0, index.size());
+
+    result.clear();
+    index.removeExpired(7 * BUCKET_LENGTH, BUCKET_LENGTH, 2, lastBucketTimes,
+                        allActive(), result);
+    BOOST_REQUIRE_EQUAL("[0, 2]", core::CContainerPrinter::print(result));
+
+    for (auto& time : lastBucketTimes) {
+        time += 10 * BUCKET_LENGTH;
+    }
+    index.invalidate();
+    result.clear();
+    index.removeExpired(17 * BUCKET_LENGTH, BUCKET_LENGTH, 2, lastBucketTimes,
+                        allActive(), result);
+    BOOST_REQUIRE_EQUAL("[0, 2]", core::CContainerPrinter::print(result));
+}
+
+BOOST_AUTO_TEST_CASE(testRandom) {
+    // Compare against a brute force scan and check the index doesn't grow
+    // without bound.
+
+    test::CRandomNumbers rng;
+
+    std::size_t n{200};
+    TTimeVec lastBucketTimes(n, model::CAnomalyDetectorModel::TIME_UNSET);
+    model::CLastBucketTimeIndex index;
+
+    TSizeVec seen;
+    TSizeVec result;
+    for (core_t::TTime time = 0; time < 500 * BUCKET_LENGTH; time += BUCKET_LENGTH) {
+        rng.generateUniformSamples(0, n, 20, seen);
+        for (auto id : seen) {
+            if (lastBucketTimes[id] != time) {
+                lastBucketTimes[id] = time;
+                index.add(id, time);
+            }
+        }
+        BOOST_TEST_REQUIRE(index.size() <= 2 * n + 1);
+
+        if (time % (10 * BUCKET_LENGTH) == 0) {
+            TSizeVec expected{expired(lastBucketTimes, time, 8)};
+            result.clear();
+            index.removeExpired(time, BUCKET_LENGTH, 8, lastBucketTimes, allActive(), result);
+            BOOST_REQUIRE_EQUAL(core::CContainerPrinter::print(expected),
+                                core::CContainerPrinter::print(result));
+            for (auto id : result) {
+                lastBucketTimes[id] = model::CAnomalyDetectorModel::TIME_UNSET;
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -156,6 +156,52 @@ BOOST_AUTO_TEST_CASE(testEstimateNonlinear) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testEstimateFromMarginalCosts) {
+    CMemoryUsageEstimator estimator;
+
+    CMemoryUsageEstimator::TOptionalSizeArray costs;
+    costs[CMemoryUsageEstimator::E_People] = 54;
+    costs[CMemoryUsageEstimator::E_Attributes] = 556;
+    estimator.marginalCosts(costs);
+
+    // We still need one real value to estimate from.
+    auto mem = estimate(estimator, 1, 1);
+    BOOST_TEST_REQUIRE(!mem);
+
+    addValue(estimator, 610, 1, 1);
+    mem = estimate(estimator, 2, 1);
+    BOOST_TEST_REQUIRE(mem.has_value());
+    BOOST_REQUIRE_EQUAL(664, *mem);
+    mem = estimate(estimator, 10, 3);
+    BOOST_TEST_REQUIRE(mem.has_value());
+    BOOST_REQUIRE_EQUAL(610 + 9 * 54 + 2 * 556, *mem);
+    mem = estimate(estimator, 0, 1);
+    BOOST_TEST_REQUIRE(mem.has_value());
+    BOOST_REQUIRE_EQUAL(556, *mem);
+
+    // The cost of correlations is unknown so changing them needs a real value.
+    mem = estimate(estimator, 2, 1, 1);
+    BOOST_TEST_REQUIRE(!mem);
+
+    // Test that after 10 estimates we need to add some more real values.
+    for (std::size_t i = 0; i < 10; ++i) {
+        mem = estimate(estimator, 4, 1);
+    }
+    BOOST_TEST_REQUIRE(!mem);
+
+    // The estimate is made from the last value added.
+    addValue(estimator, 900, 5, 1);
+    mem = estimate(estimator, 6, 1);
+    BOOST_TEST_REQUIRE(mem.has_value());
+    BOOST_REQUIRE_EQUAL(954, *mem);
+
+    // Once there are enough values the regression is used.
+    addValue(estimator, 954, 6, 1);
+    addValue(estimator, 1008, 7, 1);
+    mem = estimate(estimator, 8, 1);
+    BOOST_TEST_REQUIRE(mem.has_value());
+}
+
 BOOST_AUTO_TEST_CASE(testPersist) {
     CMemoryUsageEstimator origEstimator;
     {
@@ -27,8 +27,10 @@
 #include <model/CDataGatherer.h>
 #include <model/CDetectionRule.h>
 #include <model/CEventData.h>
+#include <model/CHierarchicalResults.h>
 #include <model/CIndividualModel.h>
 #include <model/CInterimBucketCorrector.h>
+#include <model/CInterimResultsCache.h>
 #include <model/CMetricModel.h>
 #include <model/CMetricModelFactory.h>
 #include <model/CModelDetailsView.h>
@@ -1660,6 +1662,89 @@ BOOST_FIXTURE_TEST_CASE(testInterimCorrections, CTestFixture) {
     BOOST_TEST_REQUIRE(p3Baseline[0] < 61.0);
 }
 
+BOOST_FIXTURE_TEST_CASE(testInterimResultsCache, CTestFixture) {
+    // Check that reusing cached interim results for people who haven't
+    // received data gives the same results as recomputing them.
+
+    core_t::TTime startTime{3600};
+    core_t::TTime bucketLength{3600};
+    SModelParams params(bucketLength);
+    auto interimBucketCorrector = std::make_shared<CInterimBucketCorrector>(bucketLength);
+    CMetricModelFactory factory(params, interimBucketCorrector);
+    factory.features({model_t::E_IndividualMeanByPerson});
+    factory.fieldNames("", "", "P", "V", TStrVec(1, "I"));
+
+    CModelFactory::TDataGathererPtr gatherer(factory.makeDataGatherer(startTime));
+    CModelFactory::TModelPtr model_(factory.makeModel(gatherer));
+    BOOST_TEST_REQUIRE(model_);
+    auto& model = static_cast<CMetricModel&>(*model_.get());
+
+    TStrVec people{"p1", "p2", "p3"};
+    for (const auto& person : people) {
+        this->addPerson(person, gatherer);
+    }
+
+    test::CRandomNumbers rng;
+    TDoubleVec values;
+    core_t::TTime now{startTime};
+    for (/**/; now < startTime + 48 * bucketLength; now += bucketLength) {
+        for (const auto& person : people) {
+            rng.generateNormalSamples(10.0, 4.0, 5, values);
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                this->addArrival(SMessage(now + static_cast<core_t::TTime>(100 * i),
+                                          person, values[i], {}, "i"),
+                                 gatherer);
+            }
+        }
+        model.sample(now, now + bucketLength, m_ResourceMonitor);
+    }
+
+    CInterimResultsCache cache;
+    auto checkResults = [&] {
+        model.sampleBucketStatistics(now, now + bucketLength, m_ResourceMonitor);
+        CHierarchicalResults expected;
+        expected.setInterim();
+        BOOST_TEST_REQUIRE(model.addResults(now, now + bucketLength, 1, expected));
+        CHierarchicalResults actual;
+        actual.setInterim();
+        BOOST_TEST_REQUIRE(model.addResults(now, now + bucketLength, 1, cache, actual));
+        BOOST_REQUIRE_EQUAL(expected.print(), actual.print());
+        gatherer->clearDirtyPeople();
+    };
+
+    this->addArrival(SMessage(now, "p1", 10.0, {}, "i"), gatherer);
+    this->addArrival(SMessage(now, "p2", 11.0, {}, "i"), gatherer);
+    this->addArrival(SMessage(now, "p3", 9.0, {}, "i"), gatherer);
+    checkResults();
+    BOOST_REQUIRE_EQUAL(3, cache.size());
+    for (std::size_t pid = 0; pid < people.size(); ++pid) {
+        BOOST_TEST_REQUIRE(gatherer->isPersonDirty(pid) == false);
+    }
+
+    // Only the person who receives data should be dirty.
+    this->addArrival(SMessage(now + 600, "p2", 40.0, {}, "i"), gatherer);
+    BOOST_TEST_REQUIRE(gatherer->isPersonDirty(0) == false);
+    BOOST_TEST_REQUIRE(gatherer->isPersonDirty(1));
+    BOOST_TEST_REQUIRE(gatherer->isPersonDirty(2) == false);
+    checkResults();
+
+    this->addArrival(SMessage(now + 1200, "p1", 10.0, {}, "i"), gatherer);
+    this->addArrival(SMessage(now + 1200, "p3", -30.0, {}, "i"), gatherer);
+    checkResults();
+    BOOST_REQUIRE_EQUAL(3, cache.size());
+
+    // Final results don't use the cache.
+    this->addArrival(SMessage(now + 1800, "p1", 12.0, {}, "i"), gatherer);
+    model.sampleBucketStatistics(now, now + bucketLength, m_ResourceMonitor);
+    CHierarchicalResults results;
+    BOOST_TEST_REQUIRE(model.addResults(now, now + bucketLength, 1, cache, results));
+    BOOST_REQUIRE_EQUAL(3, cache.size());
+
+    // Results for a different bucket aren't reused.
+    cache.bucket(now + bucketLength, 1.0);
+    BOOST_REQUIRE_EQUAL(0, cache.size());
+}
+
 BOOST_FIXTURE_TEST_CASE(testInterimCorrectionsWithCorrelations, CTestFixture) {
     core_t::TTime startTime{3600};
     core_t::TTime bucketLength{3600};
@@ -146,4 +146,88 @@ BOOST_FIXTURE_TEST_CASE(testModelPlot, CTestFixture) {
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(testModelPlotBoundsCadence, CTestFixture) {
+    // Check that cached bounds are reused between the buckets in which
+    // each series is recomputed and are recomputed otherwise.
+
+    using TStrVec = std::vector<std::string>;
+
+    core_t::TTime bucketLength{600};
+    model::CSearchKey key;
+    model::SModelParams params{bucketLength};
+    model_t::TFeatureVec features{model_t::E_IndividualSumByBucketAndPerson};
+    model_t::EFeature feature{features[0]};
+
+    auto gatherer = std::make_shared<model::CDataGatherer>(
+        model_t::analysisCategory(feature), model_t::E_None, params, EMPTY_STRING,
+        EMPTY_STRING, "p", EMPTY_STRING, EMPTY_STRING, TStrVec{}, key, features, 0, 0);
+    TStrVec people{"p1", "p2", "p3", "p4"};
+    for (const auto& person : people) {
+        bool addedPerson{false};
+        gatherer->addPerson(person, m_ResourceMonitor, addedPerson);
+    }
+
+    model::CMockModel model{params, gatherer, {/*we don't care about influence*/}};
+    maths::time_series::CTimeSeriesDecomposition trend;
+    maths::common::CNormalMeanPrecConjugate prior{
+        maths::common::CNormalMeanPrecConjugate::nonInformativePrior(maths_t::E_ContinuousData)};
+    prior.addSamples({1.0, 2.0, 3.0, 2.0, 1.0},
+                     maths_t::TDoubleWeightsAry1Vec(5, maths_t::CUnitWeights::UNIT));
+    maths::common::CModelParams timeSeriesModelParams{
+        bucketLength, 1.0, 0.001, 0.2, 6 * core::constants::HOUR, 24 * core::constants::HOUR};
+    maths::time_series::CUnivariateTimeSeriesModel timeSeriesModel{
+        timeSeriesModelParams, 0, trend, prior};
+    model::CMockModel::TMathsModelUPtrVec models;
+    for (std::size_t pid = 0; pid < people.size(); ++pid) {
+        models.emplace_back(timeSeriesModel.clone(pid));
+    }
+    model.mockTimeSeriesModels(std::move(models));
+
+    const model::CModelPlotData::SByFieldData fake{-100.0, 100.0, 0.0};
+
+    // A cadence of one caches nothing.
+    {
+        model::CModelPlotBoundsCache cache{bucketLength};
+        model::CModelPlotData plotData;
+        model.details()->modelPlot(0, 90.0, {}, cache, plotData);
+        BOOST_REQUIRE_EQUAL(0, cache.size());
+    }
+
+    model::CModelPlotBoundsCache cache{bucketLength};
+    cache.cadence(3);
+    {
+        model::CModelPlotData plotData;
+        model.details()->modelPlot(0, 90.0, {}, cache, plotData);
+        BOOST_REQUIRE_EQUAL(people.size(), cache.size());
+    }
+
+    // Replace the cached bounds so we can tell when they are reused. The
+    // second person's identifier is recycled with a different name.
+    for (std::size_t pid = 0; pid < people.size(); ++pid) {
+        cache.add(feature, pid, pid == 1 ? "recycled" : people[pid], 0, fake);
+    }
+
+    model::CModelPlotData plotData;
+    model.details()->modelPlot(bucketLength, 90.0, {}, cache, plotData);
+    for (const auto& featureByFieldData : plotData) {
+        BOOST_REQUIRE_EQUAL(people.size(), featureByFieldData.second.size());
+        for (const auto& byFieldData : featureByFieldData.second) {
+            std::size_t pid;
+            BOOST_TEST_REQUIRE(gatherer->personId(byFieldData.first, pid));
+            // The third person is recomputed in bucket 1 and the second
+            // person's entry is for a different by field value.
+            bool reused{pid != 1 && pid != 2};
+            LOG_DEBUG(<< byFieldData.first << " lower = " << byFieldData.second.s_LowerBound);
+            BOOST_REQUIRE_EQUAL(reused, byFieldData.second.s_LowerBound == fake.s_LowerBound);
+            BOOST_REQUIRE_EQUAL(reused, byFieldData.second.s_UpperBound == fake.s_UpperBound);
+        }
+    }
+
+    // Bounds aren't reused once they're older than the cadence.
+    cache.prune(2 * bucketLength);
+    BOOST_REQUIRE_EQUAL(people.size(), cache.size());
+    cache.prune(3 * bucketLength);
+    BOOST_REQUIRE_EQUAL(2, cache.size());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,151 @@
+/*
+ * Copyright Elasticsearch B.V. and/or licensed to Elasticsearch B.V. under one
+ * or more contributor license agreements. Licensed under the Elastic License
+ * 2.0 and the following additional limitation. Functionality enabled by the
+ * files subject to the Elastic License 2.0 may only be used in production when
+ * invoked by an Elasticsearch process with a license key installed that permits
+ * use of machine learning features. You may not use this file except in
+ * compliance with the Elastic License 2.0 and the foregoing additional
+ * limitation.
+ */
+
+#include <core/CLogger.h>
+
+#include <model/CPersonAttributeFlatMap.h>
+
+#include <test/CRandomNumbers.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(CPersonAttributeFlatMapTest)
+
+using namespace ml;
+
+namespace {
+using TSizeVec = std::vector<std::size_t>;
+using TSizeSizePr = std::pair<std::size_t, std::size_t>;
+using TSizeSizePrUInt64Map = std::map<TSizeSizePr, std::uint64_t>;
+using TSizeSizePrUInt64FlatMap = model::CPersonAttributeFlatMap<std::uint64_t>;
+
+void checkEqual(const TSizeSizePrUInt64Map& expected, const TSizeSizePrUInt64FlatMap& map) {
+    BOOST_REQUIRE_EQUAL(expected.size(), map.size());
+    for (const auto& entry : expected) {
+        auto i = map.find(entry.first);
+        BOOST_REQUIRE(i != map.end());
+        BOOST_REQUIRE_EQUAL(entry.second, i->second);
+    }
+    for (const auto& entry : map) {
+        BOOST_REQUIRE_EQUAL(1, expected.count(entry.first));
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(testInsertAndFind) {
+
+    // Compare against a std::map for random keys with plenty of collisions.
+
+    test::CRandomNumbers rng;
+
+    TSizeSizePrUInt64Map expected;
+    TSizeSizePrUInt64FlatMap map;
+
+    TSizeVec people;
+    TSizeVec attributes;
+    rng.generateUniformSamples(0, 1000, 20000, people);
+    rng.generateUniformSamples(0, 20, 20000, attributes);
+
+    for (std::size_t i = 0; i < people.size(); ++i) {
+        TSizeSizePr key{people[i], attributes[i]};
+        expected[key] += i;
+        map[key] += i;
+    }
+    checkEqual(expected, map);
+
+    BOOST_REQUIRE(map.find({1001, 0}) == map.end());
+    BOOST_REQUIRE_EQUAL(0, map.count({0, 21}));
+}
+
+BOOST_AUTO_TEST_CASE(testSorted) {
+
+    TSizeSizePrUInt64FlatMap map;
+    BOOST_REQUIRE(map.isSorted());
+
+    map[{0, 1}] = 1;
+    map[{1, 0}] = 2;
+    map[{3, 2}] = 3;
+    map[{1, 0}] += 1;
+    BOOST_REQUIRE(map.isSorted());
+
+    map[{2, 5}] = 4;
+    map[{0, 0}] = 5;
+    BOOST_REQUIRE(map.isSorted() == false);
+
+    TSizeSizePrUInt64Map expected(map.begin(), map.end());
+    map.sort();
+    BOOST_REQUIRE(map.isSorted());
+    BOOST_REQUIRE(std::equal(expected.begin(), expected.end(), map.begin(),
+                             map.end(), [](const auto& lhs, const auto& rhs) {
+                                 return lhs.first == rhs.first && lhs.second == rhs.second;
+                             }));
+
+    // Check the index is still valid after sorting.
+    checkEqual(expected, map);
+
+    map.clear();
+    BOOST_REQUIRE(map.isSorted());
+}
+
+BOOST_AUTO_TEST_CASE(testRemoveIf) {
+
+    test::CRandomNumbers rng;
+
+    TSizeVec people;
+    rng.generateUniformSamples(0, 200, 1000, people);
+
+    TSizeSizePrUInt64Map expected;
+    TSizeSizePrUInt64FlatMap map;
+    for (std::size_t i = 0; i < people.size(); ++i) {
+        expected[{people[i], i % 3}] = i;
+        map[{people[i], i % 3}] = i;
+    }
+
+    auto isOdd = [](const auto& entry) { return entry.first.first % 2 == 1; };
+
+    TSizeSizePrUInt64Map::value_type previous{*map.begin()};
+    map.removeIf(isOdd);
+    for (auto i = expected.begin(); i != expected.end(); /**/) {
+        i = isOdd(*i) ? expected.erase(i) : std::next(i);
+    }
+    checkEqual(expected, map);
+
+    // The order of the remaining entries is preserved.
+    BOOST_REQUIRE(isOdd(previous) || previous.first == map.begin()->first);
+}
+
+BOOST_AUTO_TEST_CASE(testClearRetainsStorage) {
+
+    TSizeSizePrUInt64FlatMap map;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        map[{i, 0}] = i;
+    }
+    std::size_t memory{map.memoryUsage()};
+    LOG_DEBUG(<< "memory = " << memory);
+
+    map.clear();
+    BOOST_REQUIRE(map.empty());
+    BOOST_REQUIRE(map.find({0, 0}) == map.end());
+    BOOST_REQUIRE_EQUAL(memory, map.memoryUsage());
+
+    for (std::size_t i = 0; i < 1000; ++i) {
+        map[{999 - i, 1}] = i;
+    }
+    BOOST_REQUIRE_EQUAL(memory, map.memoryUsage());
+    BOOST_REQUIRE_EQUAL(1000, map.size());
+    BOOST_REQUIRE_EQUAL(999, map.find({0, 1})->second);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1627,4 +1627,125 @@ BOOST_AUTO_TEST_CASE(testProbabilityAndInfluenceCalculator) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testInfluenceProbabilityCache) {
+    // Check the probabilities shared between calculating the influences for
+    // different influencer fields are only computed once and that caching
+    // doesn't change the influences.
+
+    test::CRandomNumbers rng;
+
+    core_t::TTime bucketLength{600};
+
+    {
+        LOG_DEBUG(<< "Test keys");
+
+        model::CProbabilityAndInfluenceCalculator::CInfluenceProbabilityCache cache;
+
+        maths::common::CModelProbabilityParams params;
+        params.addCalculation(maths_t::E_TwoSided)
+            .addWeights(maths_t::CUnitWeights::unit<TDouble2Vec>(1));
+        TTime2Vec1Vec time{TTime2Vec{bucketLength}};
+        TDouble2Vec1Vec value{TDouble2Vec{5.0}};
+
+        double probability{0.0};
+        BOOST_TEST_REQUIRE(cache.lookup(params, time, value, probability) == false);
+        cache.add(params, time, value, 0.1);
+        BOOST_TEST_REQUIRE(cache.lookup(params, time, value, probability));
+        BOOST_REQUIRE_EQUAL(0.1, probability);
+
+        BOOST_TEST_REQUIRE(cache.lookup(params, time, {TDouble2Vec{6.0}}, probability) == false);
+        BOOST_TEST_REQUIRE(cache.lookup(params, {TTime2Vec{0}}, value, probability) == false);
+
+        maths::common::CModelProbabilityParams otherParams;
+        otherParams.addCalculation(maths_t::E_OneSidedAbove)
+            .addWeights(maths_t::CUnitWeights::unit<TDouble2Vec>(1));
+        BOOST_TEST_REQUIRE(cache.lookup(otherParams, time, value, probability) == false);
+
+        maths_t::TDouble2VecWeightsAry weight(maths_t::CUnitWeights::unit<TDouble2Vec>(1));
+        maths_t::setCountVarianceScale(TDouble2Vec{2.0}, weight);
+        otherParams = maths::common::CModelProbabilityParams{};
+        otherParams.addCalculation(maths_t::E_TwoSided).addWeights(weight);
+        BOOST_TEST_REQUIRE(cache.lookup(otherParams, time, value, probability) == false);
+
+        BOOST_REQUIRE_EQUAL(1, cache.size());
+        cache.clear();
+        BOOST_REQUIRE_EQUAL(0, cache.size());
+        BOOST_TEST_REQUIRE(cache.lookup(params, time, value, probability) == false);
+    }
+
+    {
+        LOG_DEBUG(<< "Test correlated influencer fields");
+
+        model::CMeanInfluenceCalculator calculator;
+
+        maths::time_series::CTimeSeriesDecomposition trend{0.0, bucketLength};
+        maths::common::CNormalMeanPrecConjugate prior =
+            maths::common::CNormalMeanPrecConjugate::nonInformativePrior(
+                maths_t::E_ContinuousData);
+        maths::time_series::CUnivariateTimeSeriesModel model(params(bucketLength),
+                                                             0, trend, prior);
+
+        TDoubleVec samples;
+        rng.generateNormalSamples(10.0, 1.0, 50, samples);
+        core_t::TTime now{addSamples(bucketLength, samples, model)};
+
+        double p;
+        TTail2Vec tail;
+        computeProbability(now, maths_t::E_TwoSided, TDouble1Vec{12.5}, model, p, tail);
+
+        const std::string J("J");
+        TStrCRefDouble1VecDoublePrPrVec influencerValues{
+            {TStrCRef(i1), make_pair(20.0, 5.0)},
+            {TStrCRef(i2), make_pair(10.0, 7.0)},
+            {TStrCRef(i3), make_pair(10.0, 8.0)}};
+
+        TOptionalStrOptionalStrPrDoublePrVec influences;
+        computeInfluences(calculator, model_t::E_IndividualMeanByPerson, model,
+                          now, 12.5 /*value*/, 20.0 /*count*/, p, tail, I,
+                          influencerValues, influences);
+        LOG_DEBUG(<< "  influences = " << influences);
+
+        model::CPartitioningFields partitioningFields(EMPTY_STRING, EMPTY_STRING);
+        model::CProbabilityAndInfluenceCalculator::SParams params_(partitioningFields);
+        TDouble2Vec varianceScale;
+        model.seasonalWeight(0.0, now, varianceScale);
+        maths_t::TDouble2VecWeightsAry weight(maths_t::CUnitWeights::unit<TDouble2Vec>(1));
+        maths_t::setSeasonalVarianceScale(varianceScale, weight);
+        params_.s_Feature = model_t::E_IndividualMeanByPerson;
+        params_.s_Model = &model;
+        params_.s_Time = TTime2Vec1Vec{TTimeVec{now}};
+        params_.s_Value = TDouble2Vec1Vec{TDoubleVec{12.5}};
+        params_.s_Count = 20.0;
+        params_.s_ComputeProbabilityParams.addWeights(weight);
+        params_.s_Probability = p;
+        params_.s_Tail = tail;
+        params_.s_Cutoff = 0.5;
+
+        std::size_t cached{0};
+        for (const auto& name : {I, J}) {
+            params_.s_InfluencerName = name;
+            params_.s_InfluencerValues = influencerValues;
+            calculator.computeInfluences(params_);
+            LOG_DEBUG(<< "  influences = " << params_.s_Influences);
+
+            BOOST_REQUIRE_EQUAL(influences.size(), params_.s_Influences.size());
+            for (std::size_t i = 0; i < influences.size(); ++i) {
+                BOOST_REQUIRE_EQUAL(name, *params_.s_Influences[i].first.first);
+                BOOST_REQUIRE_EQUAL(*influences[i].first.second,
+                                    *params_.s_Influences[i].first.second);
+                BOOST_REQUIRE_EQUAL(influences[i].second, params_.s_Influences[i].second);
+            }
+
+            // The second field has the same values so should hit the cache
+            // for every probability.
+            if (cached == 0) {
+                cached = params_.s_InfluenceProbabilities.size();
+                BOOST_TEST_REQUIRE(cached > 1);
+            } else {
+                BOOST_REQUIRE_EQUAL(cached, params_.s_InfluenceProbabilities.size());
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -539,6 +539,66 @@ BOOST_FIXTURE_TEST_CASE(testExtraMemory, CTestFixture) {
     BOOST_REQUIRE_EQUAL(allocationLimit, monitor.allocationLimit());
 }
 
+BOOST_FIXTURE_TEST_CASE(testIncrementalRefresh, CTestFixture) {
+    // Test that refresh uses the reported changes in memory usage and only
+    // periodically recalculates the memory used by a resource.
+
+    static const std::string EMPTY_STRING;
+    static const core_t::TTime FIRST_TIME{358556400};
+    static const core_t::TTime BUCKET_LENGTH{3600};
+
+    CAnomalyDetectorModelConfig modelConfig =
+        CAnomalyDetectorModelConfig::defaultConfig(BUCKET_LENGTH);
+    CLimits limits;
+
+    CSearchKey key(1, // detectorIndex
+                   function_t::E_IndividualMetric, false, model_t::E_XF_None,
+                   "value", "colour");
+
+    CAnomalyDetector detector(limits, modelConfig, EMPTY_STRING, FIRST_TIME,
+                              modelConfig.factory(key));
+    std::size_t mem{core::memory::dynamicSize(&detector)};
+
+    CResourceMonitor& monitor = limits.resourceMonitor();
+    std::size_t baseTotalMemory{monitor.totalMemory()};
+
+    // The first refresh always calculates the memory usage.
+    monitor.refresh(detector);
+    BOOST_REQUIRE_EQUAL(baseTotalMemory + mem, monitor.totalMemory());
+
+    monitor.addMemoryUsageDelta(detector, 1000);
+    BOOST_REQUIRE_EQUAL(baseTotalMemory + mem + 1000, monitor.totalMemory());
+    monitor.addMemoryUsageDelta(detector, -400);
+    BOOST_REQUIRE_EQUAL(baseTotalMemory + mem + 600, monitor.totalMemory());
+
+    // The estimate is used until the memory is recalculated.
+    for (std::size_t i = 1; i < CResourceMonitor::REFRESHES_PER_MEMORY_CALCULATION; ++i) {
+        monitor.refresh(detector);
+        BOOST_REQUIRE_EQUAL(baseTotalMemory + mem + 600, monitor.totalMemory());
+    }
+    monitor.refresh(detector);
+    BOOST_REQUIRE_EQUAL(baseTotalMemory + mem, monitor.totalMemory());
+
+    // A forced refresh always recalculates the memory usage.
+    monitor.addMemoryUsageDelta(detector, 1000);
+    monitor.forceRefresh(detector);
+    BOOST_REQUIRE_EQUAL(baseTotalMemory + mem, monitor.totalMemory());
+
+    // The usage can't be reduced below zero.
+    monitor.addMemoryUsageDelta(detector, -static_cast<std::ptrdiff_t>(mem + 1000));
+    BOOST_REQUIRE_EQUAL(baseTotalMemory, monitor.totalMemory());
+
+    // Limits are checked against the estimate.
+    monitor.forceRefresh(detector);
+    monitor.m_ByteLimitHigh = baseTotalMemory + mem + 100;
+    monitor.m_ByteLimitLow = baseTotalMemory + mem + 50;
+    monitor.m_ByteLimitMargin = 1.0;
+    monitor.refresh(detector);
+    BOOST_TEST_REQUIRE(monitor.areAllocationsAllowed());
+    monitor.addMemoryUsageDelta(detector, 200);
+    BOOST_TEST_REQUIRE(monitor.areAllocationsAllowed() == false);
+}
+
 BOOST_FIXTURE_TEST_CASE(testPeakUsage, CTestFixture) {
     // Clear the counter so that other test cases do not interfere.
     core::CProgramCounters::counter(counter_t::E_TSADPeakMemoryUsage) = 0;
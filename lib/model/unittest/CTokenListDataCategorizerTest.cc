@@ -817,6 +817,70 @@ BOOST_FIXTURE_TEST_CASE(testManyUniqueTokens, CTestFixture) {
     BOOST_TEST_REQUIRE(ml::core::memory::dynamicSize(&categorizer) < 20000);
 }
 
+BOOST_FIXTURE_TEST_CASE(testManyDistinctCategories, CTestFixture) {
+
+    // Check that strings match the right category when there are many
+    // categories which share no tokens with them, both before and after
+    // restoring the categorizer.
+
+    TTokenListDataCategorizerKeepsFields origCategorizer{
+        m_Limits, NO_REVERSE_SEARCH_CREATOR, 0.7, "whatever"};
+
+    std::vector<std::string> messages;
+    for (int id = 1; id <= 500; ++id) {
+        messages.push_back(makeUniqueMessage(20));
+        BOOST_REQUIRE_EQUAL(id, origCategorizer
+                                    .computeCategory(false, messages.back(),
+                                                     messages.back().length())
+                                    .id());
+    }
+    for (int id = 500; id >= 1; id -= 7) {
+        const std::string& message{messages[id - 1]};
+        BOOST_REQUIRE_EQUAL(id, origCategorizer
+                                    .computeCategory(false, message, message.length())
+                                    .id());
+    }
+
+    std::string origXml;
+    {
+        ml::core::CRapidXmlStatePersistInserter inserter{"root"};
+        origCategorizer.acceptPersistInserter(inserter);
+        inserter.toXml(origXml);
+    }
+
+    TTokenListDataCategorizerKeepsFields restoredCategorizer{
+        m_Limits, NO_REVERSE_SEARCH_CREATOR, 0.7, "whatever"};
+    {
+        ml::core::CRapidXmlParser parser;
+        BOOST_TEST_REQUIRE(parser.parseStringIgnoreCdata(origXml));
+        ml::core::CRapidXmlStateRestoreTraverser traverser{parser};
+        BOOST_TEST_REQUIRE(traverser.traverseSubLevel(
+            std::bind(&TTokenListDataCategorizerKeepsFields::acceptRestoreTraverser,
+                      &restoredCategorizer, std::placeholders::_1)));
+    }
+
+    for (int id = 3; id <= 500; id += 11) {
+        std::string message{messages[id - 1] + ' ' + makeUniqueToken()};
+        BOOST_REQUIRE_EQUAL(id, origCategorizer
+                                    .computeCategory(false, message, message.length())
+                                    .id());
+        BOOST_REQUIRE_EQUAL(id, restoredCategorizer
+                                    .computeCategory(false, message, message.length())
+                                    .id());
+    }
+
+    std::string newMessage{makeUniqueMessage(20)};
+    BOOST_REQUIRE_EQUAL(501, origCategorizer
+                                 .computeCategory(false, newMessage, newMessage.length())
+                                 .id());
+    BOOST_REQUIRE_EQUAL(501, restoredCategorizer
+                                 .computeCategory(false, newMessage, newMessage.length())
+                                 .id());
+
+    checkMemoryUsageInstrumentation(origCategorizer);
+    checkMemoryUsageInstrumentation(restoredCategorizer);
+}
+
 BOOST_FIXTURE_TEST_CASE(testStatsWriteUrgentDueToRareCategories, CTestFixture) {
 
     TTokenListDataCategorizerKeepsFields categorizer{
@@ -72,6 +72,7 @@ CMockModel::TDouble1Vec CMockModel::currentBucketValue(model_t::EFeature feature
                                                        std::size_t pid,
                                                        std::size_t cid,
                                                        core_t::TTime time) const {
+    ++m_NumberBucketValueReads;
     auto i = m_BucketValues.find({feature, core::make_triple(pid, cid, time)});
     return i != m_BucketValues.end() ? i->second : TDouble1Vec();
 }
@@ -82,6 +83,7 @@ CMockModel::TDouble1Vec CMockModel::baselineBucketMean(model_t::EFeature feature
                                                        model_t::CResultType /*type*/,
                                                        const TSizeDoublePr1Vec& /*correlated*/,
                                                        core_t::TTime time) const {
+    ++m_NumberBucketBaselineMeanReads;
     auto i = m_BucketBaselineMeans.find({feature, core::make_triple(pid, cid, time)});
     return i != m_BucketBaselineMeans.end() ? i->second : TDouble1Vec();
 }
@@ -205,6 +207,14 @@ void CMockModel::mockTimeSeriesModels(TMathsModelUPtrVec&& models) {
     m_Models = std::move(models);
 }
 
+std::size_t CMockModel::numberBucketValueReads() const {
+    return m_NumberBucketValueReads;
+}
+
+std::size_t CMockModel::numberBucketBaselineMeanReads() const {
+    return m_NumberBucketBaselineMeanReads;
+}
+
 CMemoryUsageEstimator* CMockModel::memoryUsageEstimator() const {
     return nullptr;
 }
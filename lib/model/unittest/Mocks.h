@@ -127,6 +127,12 @@ public:
 
     void mockTimeSeriesModels(TMathsModelUPtrVec&& model);
 
+    //! Get the number of times the current bucket value has been read.
+    std::size_t numberBucketValueReads() const;
+
+    //! Get the number of times the baseline bucket mean has been read.
+    std::size_t numberBucketBaselineMeanReads() const;
+
 private:
     using TDouble1Vec = CAnomalyDetectorModel::TDouble1Vec;
     using TSizeSizeTimeTriple = core::CTriple<std::size_t, std::size_t, core_t::TTime>;
@@ -148,6 +154,8 @@ private:
     bool m_IsPopulation;
     TFeatureSizeSizeTimeTriplePrDouble1VecUMap m_BucketValues;
     TFeatureSizeSizeTimeTriplePrDouble1VecUMap m_BucketBaselineMeans;
+    mutable std::size_t m_NumberBucketValueReads{0};
+    mutable std::size_t m_NumberBucketBaselineMeanReads{0};
     TMathsModelUPtrVec m_Models;
     model::CInterimBucketCorrector m_InterimBucketCorrector;
     TAnnotationVec m_Annotations;
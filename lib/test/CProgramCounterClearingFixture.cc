@@ -24,6 +24,11 @@ CProgramCounterClearingFixture::CProgramCounterClearingFixture() {
         counters.counter(i) = 0;
     }
 
+    // Clear all histograms
+    for (std::size_t i = 0; i < counter_t::NUM_HISTOGRAMS; ++i) {
+        counters.histogram(static_cast<counter_t::EHistogramTypes>(i)).clear();
+    }
+
     // Clear the cache
     counters.m_Cache.clear();
 }